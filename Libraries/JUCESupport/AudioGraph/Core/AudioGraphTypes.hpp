@@ -14,6 +14,8 @@
 #include <vector>
 #include <functional>
 #include <unordered_map>
+#include <array>
+#include <cstdint>
 
 namespace WindsynthVST::AudioGraph {
 
@@ -73,6 +75,8 @@ struct NodeInfo {
     bool acceptsMidi = false;
     bool producesMidi = false;
     double latencyInSamples = 0.0;
+    bool sleepWhenSilent = false;   // 启用静音休眠
+    bool sleeping = false;          // 当前处于休眠状态（跳过插件处理）
     
     NodeInfo() = default;
     
@@ -103,6 +107,20 @@ struct ConnectionInfo {
 // 性能统计结构
 //==============================================================================
 
+/**
+ * 回调耗时百分位统计
+ */
+struct LatencyPercentiles {
+    double p50Ms = 0.0;
+    double p95Ms = 0.0;
+    double p99Ms = 0.0;
+    double p999Ms = 0.0;
+    double maxMs = 0.0;
+    uint64_t blocks = 0;                // 统计的块数
+    uint64_t deadlineMisses = 0;        // 处理耗时超过块时长的次数
+    uint64_t nearMisses = 0;            // 处理耗时超过块时长 80% 的次数（含超时）
+};
+
 /**
  * 音频图的性能统计信息
  */
@@ -113,6 +131,17 @@ struct GraphPerformanceStats {
     int totalProcessedBlocks = 0;
     double cpuUsagePercent = 0.0;
     size_t memoryUsageBytes = 0;
+    uint64_t droppedStatsSamples = 0;   // 统计队列已满时丢弃的样本数
+    uint64_t realtimeViolations = 0;    // 音频回调中的内存分配/加锁次数
+    
+    // 尾延迟统计（点击声来自尾部，而非平均值）
+    LatencyPercentiles overall;         // 自上次重置以来
+    LatencyPercentiles currentWindow;   // 当前统计窗口（进行中）
+    LatencyPercentiles lastWindow;      // 上一个完整的统计窗口
+    uint64_t completedWindows = 0;
+    double windowSeconds = 10.0;        // 统计窗口长度（按音频时长计）
+    double bufferDurationMs = 0.0;      // 最近一块的时长（截止时间）
+    int64_t deviceXruns = 0;            // 设备报告的xrun次数（设备不支持时为0）
     
     void reset() {
         averageProcessingTimeMs = 0.0;
@@ -121,9 +150,92 @@ struct GraphPerformanceStats {
         totalProcessedBlocks = 0;
         cpuUsagePercent = 0.0;
         memoryUsageBytes = 0;
+        droppedStatsSamples = 0;
+        realtimeViolations = 0;
+        overall = {};
+        currentWindow = {};
+        lastWindow = {};
+        completedWindows = 0;
+        bufferDurationMs = 0.0;
+        deviceXruns = 0;
+    }
+};
+
+/**
+ * 单个插件节点的处理耗时统计
+ */
+struct NodeProfile {
+    NodeID nodeID;
+    std::string name;
+    double averageTimeMs = 0.0;
+    double peakTimeMs = 0.0;
+    double lastTimeMs = 0.0;
+    double budgetPercent = 0.0;         // 平均耗时占块时长的百分比
+    double peakBudgetPercent = 0.0;     // 峰值耗时占块时长的百分比
+    uint64_t blocks = 0;
+};
+
+/**
+ * 延迟报告（采样数）
+ */
+struct GraphLatencyReport {
+    int graphLatencySamples = 0;        // 音频输入到音频输出，沿最长路径
+    int compensationSamples = 0;        // 较短路径上插入的补偿延迟总长度
+    int inputDeviceLatencySamples = 0;
+    int outputDeviceLatencySamples = 0;
+    int roundTripLatencySamples = 0;    // 设备输入 + 图 + 设备输出，用于对齐录制的输入
+    double sampleRate = 0.0;
+};
+
+/**
+ * 参数自动化事件
+ */
+struct ParameterEvent {
+    int parameterIndex = -1;
+    float value = 0.0f;         // 归一化值（0.0-1.0）
+    int sampleOffset = 0;       // 相对于节点下一个处理块起点的采样偏移
+    int rampSamples = 0;        // 大于0时从当前值线性过渡到目标值
+};
+
+//==============================================================================
+// 图快照结构
+//==============================================================================
+
+/**
+ * 图快照：描述图中的插件节点及连接，可用于在另一个处理器中重建相同的图
+ */
+struct GraphSnapshot {
+    /**
+     * 插件节点快照
+     */
+    struct NodeSnapshot {
+        juce::uint32 nodeUID = 0;
+        std::string name;
+        juce::PluginDescription description;
+        juce::MemoryBlock state;
+        bool bypassed = false;
+        bool sleepWhenSilent = false;
+    };
+    
+    GraphConfig config;
+    NodeID audioInputNodeID;
+    NodeID audioOutputNodeID;
+    NodeID midiInputNodeID;
+    NodeID midiOutputNodeID;
+    std::vector<NodeSnapshot> nodes;
+    std::vector<Connection> connections;
+    
+    bool hasPlugins() const {
+        return !nodes.empty();
     }
 };
 
+/**
+ * 插件实例工厂（用于从快照重建图）
+ */
+using PluginInstanceFactory = std::function<std::unique_ptr<juce::AudioPluginInstance>(
+    const juce::PluginDescription& description, double sampleRate, int blockSize, juce::String& error)>;
+
 //==============================================================================
 // 回调函数类型
 //==============================================================================
@@ -143,6 +255,34 @@ using GraphErrorCallback = std::function<void(const std::string& error)>;
  */
 using PerformanceCallback = std::function<void(const GraphPerformanceStats& stats)>;
 
+//==============================================================================
+// 音频采集接口
+//==============================================================================
+
+/**
+ * 采集点
+ */
+enum class CapturePoint {
+    PreGraph = 0,   // 设备输入（音频图处理前）
+    PostGraph = 1   // 设备输出（音频图处理后）
+};
+
+/**
+ * 音频采集接收器
+ *
+ * 由设备回调在音频线程中调用，每个回调先调用 PreGraph 再调用 PostGraph，
+ * 两次调用的采样数相同。实现必须实时安全（不分配内存、不加锁、不做磁盘I/O）。
+ */
+class AudioCaptureSink {
+public:
+    virtual ~AudioCaptureSink() = default;
+
+    virtual void captureAudio(CapturePoint point,
+                              const float* const* channelData,
+                              int numChannels,
+                              int numSamples) noexcept = 0;
+};
+
 //==============================================================================
 // 枚举类型
 //==============================================================================
@@ -185,8 +325,50 @@ namespace Constants {
     static constexpr int DEFAULT_BUFFER_SIZE = 512;
     static constexpr double DEFAULT_SAMPLE_RATE = 44100.0;
     static constexpr int PERFORMANCE_STATS_HISTORY_SIZE = 100;
+    static constexpr int PERFORMANCE_STATS_QUEUE_SIZE = 1024;
+    static constexpr int MIDI_BUFFER_RESERVE_BYTES = 4096;
+    static constexpr double DEFAULT_TOPOLOGY_FADE_MS = 5.0;
+    static constexpr int TOPOLOGY_SWAP_TIMEOUT_MS = 250;
+    static constexpr int PARAMETER_QUEUE_SIZE = 1024;
+    static constexpr int PARAMETER_MAX_RAMPS = 64;
+    static constexpr int PARAMETER_MIN_SUBBLOCK_SAMPLES = 16;
+    static constexpr int PARAMETER_RAMP_STEP_SAMPLES = 32;
+    static constexpr int PARAMETER_IDLE_TIMEOUT_MS = 100;
 }
 
+//==============================================================================
+// 实时监控快照
+//==============================================================================
+
+/**
+ * 最近一个音频块的实时统计
+ * 由音频线程写入，采集接收器可在同一设备回调中读取
+ */
+struct RealtimeBlockStats {
+    double processingTimeMs = 0.0;      // 本块处理耗时
+    double cpuUsagePercent = 0.0;       // 平滑后的CPU负载（处理耗时 / 块时长）
+    int numSamples = 0;
+    int64_t xrunCount = 0;              // 设备报告的xrun次数（设备不支持时为0）
+    uint64_t blockCount = 0;            // 已处理的块数
+};
+
+/**
+ * 电平和性能快照
+ * 每个音频块由音频线程完整发布一次，读取端通过三缓冲无锁获取
+ */
+struct MeterSnapshot {
+    int numInputChannels = 0;
+    int numOutputChannels = 0;
+    std::array<float, Constants::MAX_AUDIO_CHANNELS> inputLevels{};     // 平滑后的RMS电平（线性）
+    std::array<float, Constants::MAX_AUDIO_CHANNELS> inputPeaks{};      // 自上次重置以来的峰值（线性）
+    std::array<float, Constants::MAX_AUDIO_CHANNELS> outputLevels{};
+    std::array<float, Constants::MAX_AUDIO_CHANNELS> outputPeaks{};
+    bool inputClipping = false;
+    bool outputClipping = false;
+    RealtimeBlockStats block;
+    double timestamp = 0.0;             // 发布时间（毫秒，高精度计时器）
+};
+
 //==============================================================================
 // 实用工具函数
 //==============================================================================
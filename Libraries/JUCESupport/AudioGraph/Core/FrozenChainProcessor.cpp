@@ -0,0 +1,99 @@
+//
+//  FrozenChainProcessor.cpp
+//  WindsynthRecorder
+//
+//  Created by AI Assistant
+//  冻结播放节点实现
+//
+
+#include "FrozenChainProcessor.hpp"
+#include "Logger.hpp"
+
+namespace WindsynthVST::AudioGraph {
+
+namespace {
+
+constexpr juce::int64 prefaultStrideSamples = 1024;
+
+juce::AudioProcessor::BusesProperties makeBusesProperties(const juce::AudioFormatReader& reader) {
+    return juce::AudioProcessor::BusesProperties()
+        .withOutput("Output", juce::AudioChannelSet::canonicalChannelSet(static_cast<int>(reader.numChannels)), true);
+}
+
+} // namespace
+
+//==============================================================================
+// 构造函数和析构函数
+//==============================================================================
+
+FrozenChainProcessor::FrozenChainProcessor(std::unique_ptr<juce::MemoryMappedAudioFormatReader> readerToUse,
+                                           const std::atomic<juce::int64>& timelinePosition,
+                                           int latencySamples,
+                                           const juce::String& name)
+    : juce::AudioProcessor(makeBusesProperties(*readerToUse)),
+      reader(std::move(readerToUse)),
+      timelinePosition(timelinePosition),
+      name(name)
+{
+    setLatencySamples(latencySamples);
+}
+
+FrozenChainProcessor::~FrozenChainProcessor() = default;
+
+std::unique_ptr<juce::MemoryMappedAudioFormatReader> FrozenChainProcessor::openRenderFile(const juce::File& file,
+                                                                                          juce::String& error) {
+    std::unique_ptr<juce::MemoryMappedAudioFormatReader> mappedReader(
+        juce::WavAudioFormat().createMemoryMappedReader(file));
+
+    if (!mappedReader) {
+        error = "无法打开冻结渲染文件: " + file.getFullPathName();
+        return nullptr;
+    }
+
+    // 音频线程直接把采样拷贝到浮点缓冲区，只接受32位浮点数据
+    if (!mappedReader->usesFloatingPointData || mappedReader->bitsPerSample != 32) {
+        error = "冻结渲染文件不是32位浮点格式";
+        return nullptr;
+    }
+
+    if (!mappedReader->mapEntireFile()) {
+        error = "无法映射冻结渲染文件";
+        return nullptr;
+    }
+
+    // 预先触碰所有页面，避免音频线程中发生缺页
+    for (juce::int64 sample = 0; sample < mappedReader->lengthInSamples; sample += prefaultStrideSamples) {
+        mappedReader->touchSample(sample);
+    }
+
+    WSLOG_INFO("FrozenChainProcessor", "已映射冻结渲染文件: " << file.getFileName()
+            << ", 采样数: " << mappedReader->lengthInSamples);
+    return mappedReader;
+}
+
+//==============================================================================
+// 音频处理
+//==============================================================================
+
+void FrozenChainProcessor::prepareToPlay(double, int) {
+}
+
+void FrozenChainProcessor::processBlock(juce::AudioBuffer<float>& buffer, juce::MidiBuffer& midiMessages) {
+    buffer.clear();
+    midiMessages.clear();
+
+    const auto position = timelinePosition.load(std::memory_order_relaxed);
+    if (position < 0 || position >= reader->lengthInSamples) {
+        return;
+    }
+
+    const int numSamples = static_cast<int>(juce::jmin(static_cast<juce::int64>(buffer.getNumSamples()),
+                                                       reader->lengthInSamples - position));
+    const int numChannels = juce::jmin(buffer.getNumChannels(), static_cast<int>(reader->numChannels));
+
+    // 浮点读取器把采样原样写入目标通道（以 int* 传递），读取范围已限制在文件内
+    reader->readSamples(reinterpret_cast<int* const*>(buffer.getArrayOfWritePointers()),
+                        numChannels, 0, position, numSamples);
+}
+
+} // namespace WindsynthVST::AudioGraph
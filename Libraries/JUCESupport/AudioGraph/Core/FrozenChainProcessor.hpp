@@ -0,0 +1,91 @@
+//
+//  FrozenChainProcessor.hpp
+//  WindsynthRecorder
+//
+//  Created by AI Assistant
+//  冻结播放节点 - 按文件播放位置回放预渲染的子图输出
+//
+
+#pragma once
+
+#include <JuceHeader.h>
+#include <memory>
+#include <atomic>
+
+namespace WindsynthVST::AudioGraph {
+
+/**
+ * 冻结播放节点
+ *
+ * 子图冻结后由它替换原来的插件节点：输出预先离线渲染好的32位浮点WAV，
+ * 读取位置取自所属音频图记录的文件播放位置，未播放时输出静音。
+ * 渲染文件整个映射到内存并在创建时预先读入，音频线程只做内存拷贝。
+ * 报告的延迟与被冻结的子图相同，图的延迟补偿保持不变。
+ */
+class FrozenChainProcessor : public juce::AudioProcessor {
+public:
+    /**
+     * 构造函数
+     * @param reader 已映射整个文件的读取器（32位浮点）
+     * @param timelinePosition 播放位置（采样，由所属音频图持有，生命周期长于本对象）
+     * @param latencySamples 被冻结子图的延迟
+     * @param name 节点名称
+     */
+    FrozenChainProcessor(std::unique_ptr<juce::MemoryMappedAudioFormatReader> reader,
+                         const std::atomic<juce::int64>& timelinePosition,
+                         int latencySamples,
+                         const juce::String& name);
+    ~FrozenChainProcessor() override;
+
+    /**
+     * 打开渲染文件并映射到内存
+     * @return 文件无效或不是32位浮点WAV时返回nullptr
+     */
+    static std::unique_ptr<juce::MemoryMappedAudioFormatReader> openRenderFile(const juce::File& file,
+                                                                                juce::String& error);
+
+    /**
+     * 渲染文件
+     */
+    juce::File getRenderFile() const { return reader->getFile(); }
+
+    /**
+     * 渲染文件长度（采样）
+     */
+    juce::int64 getLengthInSamples() const noexcept { return reader->lengthInSamples; }
+
+    //==============================================================================
+    // AudioProcessor
+    //==============================================================================
+
+    const juce::String getName() const override { return name; }
+
+    void prepareToPlay(double sampleRate, int samplesPerBlock) override;
+    void releaseResources() override {}
+    void processBlock(juce::AudioBuffer<float>& buffer, juce::MidiBuffer& midiMessages) override;
+
+    double getTailLengthSeconds() const override { return 0.0; }
+    bool acceptsMidi() const override { return false; }
+    bool producesMidi() const override { return false; }
+
+    bool hasEditor() const override { return false; }
+    juce::AudioProcessorEditor* createEditor() override { return nullptr; }
+
+    int getNumPrograms() override { return 1; }
+    int getCurrentProgram() override { return 0; }
+    void setCurrentProgram(int) override {}
+    const juce::String getProgramName(int) override { return {}; }
+    void changeProgramName(int, const juce::String&) override {}
+
+    void getStateInformation(juce::MemoryBlock&) override {}
+    void setStateInformation(const void*, int) override {}
+
+private:
+    std::unique_ptr<juce::MemoryMappedAudioFormatReader> reader;
+    const std::atomic<juce::int64>& timelinePosition;
+    const juce::String name;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(FrozenChainProcessor)
+};
+
+} // namespace WindsynthVST::AudioGraph
@@ -7,8 +7,9 @@
 //
 
 #include "GraphAudioProcessor.hpp"
-#include <iostream>
+#include "Logger.hpp"
 #include <algorithm>
+#include <set>
 
 namespace WindsynthVST::AudioGraph {
 
@@ -21,10 +22,7 @@ GraphAudioProcessor::GraphAudioProcessor()
                     .withInput("Input", juce::AudioChannelSet::stereo(), true)
                     .withOutput("Output", juce::AudioChannelSet::stereo(), true))
 {
-    std::cout << "[GraphAudioProcessor] 构造函数：初始化音频图处理器" << std::endl;
-
-    // 预分配性能统计历史记录空间
-    processingTimeHistory.reserve(Constants::PERFORMANCE_STATS_HISTORY_SIZE);
+    WSLOG_INFO("GraphAudioProcessor", "构造函数：初始化音频图处理器");
 
     // 初始化I/O节点
     initializeIONodes();
@@ -32,11 +30,19 @@ GraphAudioProcessor::GraphAudioProcessor()
     // 设置初始的I/O节点父图引用
     updateIONodesParentGraph();
 
-    std::cout << "[GraphAudioProcessor] 构造完成" << std::endl;
+    WSLOG_INFO("GraphAudioProcessor", "构造完成");
 }
 
 GraphAudioProcessor::~GraphAudioProcessor() {
-    std::cout << "[GraphAudioProcessor] 析构函数：清理资源" << std::endl;
+    WSLOG_INFO("GraphAudioProcessor", "析构函数：清理资源");
+
+    setNotificationDispatcher(nullptr);
+    
+    // 被移除的节点可能比本处理器存活更久（例如在实例池中）
+    cancelPendingUpdate();
+    for (auto* node : audioGraph.getNodes()) {
+        unwatchNodeLatency(node);
+    }
     
     if (isGraphReady()) {
         releaseResources();
@@ -52,10 +58,10 @@ const juce::String GraphAudioProcessor::getName() const {
 }
 
 void GraphAudioProcessor::prepareToPlay(double sampleRate, int samplesPerBlock) {
-    std::cout << "[GraphAudioProcessor] prepareToPlay: " << sampleRate << "Hz, " 
-              << samplesPerBlock << " samples" << std::endl;
+    WSLOG_INFO("GraphAudioProcessor", "prepareToPlay: " << sampleRate << "Hz, " 
+            << samplesPerBlock << " samples");
     
-    std::lock_guard<std::mutex> lock(configMutex);
+    std::lock_guard<RealtimeCheckedMutex> lock(configMutex);
     
     // 更新配置
     currentConfig.sampleRate = sampleRate;
@@ -63,10 +69,21 @@ void GraphAudioProcessor::prepareToPlay(double sampleRate, int samplesPerBlock)
     
     // 准备内部音频图
     audioGraph.prepareToPlay(sampleRate, samplesPerBlock);
+    parallelScheduler.prepare(sampleRate, samplesPerBlock);
+
+    // 一次性分配音频线程使用的缓冲区
+    int numChannels = std::max({ currentConfig.numInputChannels, currentConfig.numOutputChannels,
+                                 getTotalNumInputChannels(), getTotalNumOutputChannels(), 2 });
+    allocateProcessingBuffers(numChannels, samplesPerBlock);
+    updateTopologyFadeLength();
 
     // 准备传输源（如果存在）
-    if (transportSource) {
-        transportSource->prepareToPlay(samplesPerBlock, sampleRate);
+    if (auto* source = transportSource.load()) {
+        source->prepareToPlay(samplesPerBlock, sampleRate);
+    }
+
+    if (auto* collector = midiInputCollector.load()) {
+        collector->prepare(sampleRate);
     }
 
     // 重置性能统计
@@ -75,19 +92,24 @@ void GraphAudioProcessor::prepareToPlay(double sampleRate, int samplesPerBlock)
     graphReady.store(true);
     isConfigured.store(true);
 
+    // 节点已由音频图准备好，插件报告的延迟可能随采样率和块大小变化
+    updateLatencyModel();
+    rebuildParallelPlan();
+
     notifyStateChange("音频图已准备就绪");
-    std::cout << "[GraphAudioProcessor] prepareToPlay 完成" << std::endl;
+    WSLOG_INFO("GraphAudioProcessor", "prepareToPlay 完成");
 }
 
 void GraphAudioProcessor::releaseResources() {
-    std::cout << "[GraphAudioProcessor] releaseResources" << std::endl;
+    WSLOG_INFO("GraphAudioProcessor", "releaseResources");
 
     graphReady.store(false);
+    parallelScheduler.clearPlan();
     audioGraph.releaseResources();
 
     // 释放传输源资源
-    if (transportSource) {
-        transportSource->releaseResources();
+    if (auto* source = transportSource.load()) {
+        source->releaseResources();
     }
 
     notifyStateChange("音频图资源已释放");
@@ -104,33 +126,20 @@ void GraphAudioProcessor::processBlock(juce::AudioBuffer<float>& buffer,
     auto startTime = juce::Time::getHighResolutionTicks();
 
     // 如果有音频文件播放，先处理transportSource
-    if (transportSource != nullptr) {
-        // 确保缓冲区大小匹配
-        if (transportBuffer.getNumChannels() != buffer.getNumChannels() ||
-            transportBuffer.getNumSamples() != buffer.getNumSamples()) {
-            transportBuffer.setSize(buffer.getNumChannels(), buffer.getNumSamples());
-        }
+    auto* source = transportSource.load();
+    timelinePosition.store(source != nullptr && source->isPlaying() ? source->getNextReadPosition() : -1,
+                           std::memory_order_relaxed);
+
+    if (source != nullptr) {
+        // 使用预分配的缓冲区，容量足够时不会重新分配
+        resizeProcessingBuffer(transportBuffer, buffer.getNumChannels(), buffer.getNumSamples());
 
         // 清空传输缓冲区
         transportBuffer.clear();
 
         // 从transportSource获取音频数据
         juce::AudioSourceChannelInfo channelInfo(&transportBuffer, 0, buffer.getNumSamples());
-        transportSource->getNextAudioBlock(channelInfo);
-
-        // 检查是否有音频数据
-        float maxLevel = 0.0f;
-        for (int channel = 0; channel < transportBuffer.getNumChannels(); ++channel) {
-            auto* channelData = transportBuffer.getReadPointer(channel);
-            for (int sample = 0; sample < transportBuffer.getNumSamples(); ++sample) {
-                maxLevel = std::max(maxLevel, std::abs(channelData[sample]));
-            }
-        }
-
-        // static int debugCounter = 0;
-        // if (++debugCounter % 1000 == 0 && maxLevel > 0.001f) { // 每1000个块输出一次，且有信号时
-        //     // std::cout << "[GraphAudioProcessor] 音频文件信号电平: " << maxLevel << std::endl;
-        // }
+        source->getNextAudioBlock(channelInfo);
 
         // 将传输音频添加到主缓冲区
         for (int channel = 0; channel < buffer.getNumChannels(); ++channel) {
@@ -140,13 +149,16 @@ void GraphAudioProcessor::processBlock(juce::AudioBuffer<float>& buffer,
         }
     }
 
-    // 处理音频图
-    audioGraph.processBlock(buffer, midiMessages);
+    // 处理音频图（并行计划不可用时串行处理）
+    if (!parallelScheduler.process(buffer, midiMessages)) {
+        audioGraph.processBlock(buffer, midiMessages);
+    }
+    applyTopologyFade(buffer);
 
     // 计算处理时间并更新统计
     auto endTime = juce::Time::getHighResolutionTicks();
     double processingTimeMs = juce::Time::highResolutionTicksToSeconds(endTime - startTime) * 1000.0;
-    updatePerformanceStats(processingTimeMs);
+    updatePerformanceStats(processingTimeMs, buffer.getNumSamples());
 }
 
 void GraphAudioProcessor::processBlock(juce::AudioBuffer<double>& buffer,
@@ -161,11 +173,12 @@ void GraphAudioProcessor::processBlock(juce::AudioBuffer<double>& buffer,
 
     // 处理音频图
     audioGraph.processBlock(buffer, midiMessages);
+    applyTopologyFade(buffer);
 
     // 计算处理时间并更新统计
     auto endTime = juce::Time::getHighResolutionTicks();
     double processingTimeMs = juce::Time::highResolutionTicksToSeconds(endTime - startTime) * 1000.0;
-    updatePerformanceStats(processingTimeMs);
+    updatePerformanceStats(processingTimeMs, buffer.getNumSamples());
 }
 
 void GraphAudioProcessor::processBlockWithInput(const juce::AudioBuffer<float>& inputBuffer,
@@ -179,30 +192,36 @@ void GraphAudioProcessor::processBlockWithInput(const juce::AudioBuffer<float>&
     // 记录处理开始时间
     auto startTime = juce::Time::getHighResolutionTicks();
 
-    // 创建一个临时缓冲区来处理音频图
+    // 使用预分配的处理缓冲区
     // 音频图需要一个可读写的缓冲区，但我们不希望直接修改输入
-    juce::AudioBuffer<float> processingBuffer;
+    juce::AudioBuffer<float>& processingBuffer = scratchBuffer;
 
-    // 设置处理缓冲区的大小以匹配输出
-    processingBuffer.setSize(outputBuffer.getNumChannels(), outputBuffer.getNumSamples());
+    // 设置处理缓冲区的大小以匹配输出（容量足够时不会重新分配）
+    resizeProcessingBuffer(processingBuffer, outputBuffer.getNumChannels(), outputBuffer.getNumSamples());
     processingBuffer.clear();
 
     // 将输入数据复制到处理缓冲区（仅用于音频图内部处理）
     int channelsToCopy = std::min(inputBuffer.getNumChannels(), processingBuffer.getNumChannels());
+    int samplesToCopy = std::min(inputBuffer.getNumSamples(), processingBuffer.getNumSamples());
     for (int ch = 0; ch < channelsToCopy; ++ch) {
-        processingBuffer.copyFrom(ch, 0, inputBuffer, ch, 0, inputBuffer.getNumSamples());
+        processingBuffer.copyFrom(ch, 0, inputBuffer, ch, 0, samplesToCopy);
     }
 
     // 处理音频图
-    audioGraph.processBlock(processingBuffer, midiMessages);
+    if (!parallelScheduler.process(processingBuffer, midiMessages)) {
+        audioGraph.processBlock(processingBuffer, midiMessages);
+    }
+    applyTopologyFade(processingBuffer);
 
-    // 将处理结果复制到输出缓冲区
-    outputBuffer.makeCopyOf(processingBuffer);
+    // 将处理结果复制到输出缓冲区（逐通道复制，避免makeCopyOf重新分配）
+    for (int ch = 0; ch < outputBuffer.getNumChannels(); ++ch) {
+        outputBuffer.copyFrom(ch, 0, processingBuffer, ch, 0, outputBuffer.getNumSamples());
+    }
 
     // 计算处理时间并更新统计
     auto endTime = juce::Time::getHighResolutionTicks();
     double processingTimeMs = juce::Time::highResolutionTicksToSeconds(endTime - startTime) * 1000.0;
-    updatePerformanceStats(processingTimeMs);
+    updatePerformanceStats(processingTimeMs, outputBuffer.getNumSamples());
 }
 
 bool GraphAudioProcessor::supportsDoublePrecisionProcessing() const {
@@ -215,8 +234,8 @@ void GraphAudioProcessor::reset() {
 }
 
 void GraphAudioProcessor::setTransportSource(juce::AudioTransportSource* source) {
-    std::cout << "[GraphAudioProcessor] 设置传输源: " << (source ? "有效" : "空") << std::endl;
-    transportSource = source;
+    WSLOG_INFO("GraphAudioProcessor", "设置传输源: " << (source ? "有效" : "空"));
+    transportSource.store(source);
 
     if (source && isConfigured.load()) {
         // 如果已经配置过，需要准备传输源
@@ -224,6 +243,38 @@ void GraphAudioProcessor::setTransportSource(juce::AudioTransportSource* source)
     }
 }
 
+void GraphAudioProcessor::setMidiInputCollector(MidiInputCollector* collector) {
+    WSLOG_INFO("GraphAudioProcessor", "设置MIDI输入收集器: " << (collector ? "有效" : "空"));
+
+    if (collector && isConfigured.load()) {
+        collector->prepare(currentConfig.sampleRate);
+    }
+    midiInputCollector.store(collector);
+}
+
+bool GraphAudioProcessor::addCaptureSink(AudioCaptureSink* sink) {
+    if (sink == nullptr) {
+        return false;
+    }
+
+    for (auto& slot : captureSinks) {
+        AudioCaptureSink* expected = nullptr;
+        if (slot.compare_exchange_strong(expected, sink)) {
+            return true;
+        }
+    }
+
+    WSLOG_INFO("GraphAudioProcessor", "音频采集接收器槽位已满");
+    return false;
+}
+
+void GraphAudioProcessor::removeCaptureSink(AudioCaptureSink* sink) {
+    for (auto& slot : captureSinks) {
+        AudioCaptureSink* expected = sink;
+        slot.compare_exchange_strong(expected, nullptr);
+    }
+}
+
 //==============================================================================
 // AudioIODeviceCallback 接口实现
 //==============================================================================
@@ -234,36 +285,98 @@ void GraphAudioProcessor::audioDeviceIOCallbackWithContext(const float* const* i
                                                           int numOutputChannels,
                                                           int numSamples,
                                                           const juce::AudioIODeviceCallbackContext& context) {
-    // 创建输入和输出缓冲区
-    juce::AudioBuffer<float> inputBuffer;
-    juce::AudioBuffer<float> outputBuffer(outputChannelData, numOutputChannels, numSamples);
-    juce::MidiBuffer midiBuffer;
-
-    // 清空输出缓冲区
-    outputBuffer.clear();
-
-    // 如果有输入，创建输入缓冲区（只读）
-    if (inputChannelData != nullptr && numInputChannels > 0) {
-        // 创建输入缓冲区的只读视图
-        inputBuffer = juce::AudioBuffer<float>(const_cast<float**>(inputChannelData), numInputChannels, numSamples);
-
-        // 将输入数据提供给音频图处理
-        // 注意：这里不直接复制到输出，而是让音频图决定如何处理
-        processBlockWithInput(inputBuffer, outputBuffer, midiBuffer);
-    } else {
-        // 没有输入时，只处理输出
-        processBlock(outputBuffer, midiBuffer);
+    juce::ignoreUnused(context);
+
+    // 标记实时上下文，调试时检测内存分配和加锁
+    RealtimeSafety::ScopedAudioCallback realtimeScope;
+
+    juce::MidiBuffer& midiBuffer = callbackMidiBuffer;
+    midiBuffer.clear();
+
+    // MIDI设备输入按采样偏移写入预分配的缓冲区，由MIDI输入节点送入音频图
+    if (auto* collector = midiInputCollector.load()) {
+        collector->removeNextBlockOfMessages(midiBuffer, numSamples);
+    }
+
+    // 直接在设备输出指针上原地处理：
+    // - 前 numOutputChannels 个通道直接引用设备输出内存
+    // - 音频图需要更多通道时（输入多于输出），额外通道使用预分配的暂存缓冲区
+    const int numInputsToUse = inputChannelData != nullptr ? numInputChannels : 0;
+
+    // 设备报告的xrun计数（不支持时返回-1）
+    if (auto* device = activeDevice.load(std::memory_order_relaxed)) {
+        const int xruns = device->getXRunCount();
+        if (xruns >= 0) {
+            realtimeBlockStats.xrunCount = xruns;
+        }
+    }
+
+    // 采集处理前的设备输入（输入可能与输出共用内存，必须在处理前采集）
+    std::array<AudioCaptureSink*, maxCaptureSinks> sinks;
+    for (int i = 0; i < maxCaptureSinks; ++i) {
+        sinks[i] = captureSinks[i].load();
+        if (sinks[i] != nullptr) {
+            sinks[i]->captureAudio(CapturePoint::PreGraph, inputChannelData, numInputsToUse, numSamples);
+        }
+    }
+    const int numGraphChannels = std::max(audioGraph.getTotalNumInputChannels(),
+                                          audioGraph.getTotalNumOutputChannels());
+    const int numProcessingChannels = juce::jmin(Constants::MAX_AUDIO_CHANNELS,
+                                                 std::max({ numOutputChannels, numInputsToUse, numGraphChannels }));
+
+    const int numExtraChannels = numProcessingChannels - numOutputChannels;
+    if (numExtraChannels > 0) {
+        resizeProcessingBuffer(scratchBuffer, numExtraChannels, numSamples);
+    }
+
+    for (int ch = 0; ch < numProcessingChannels; ++ch) {
+        callbackChannelPointers[static_cast<size_t>(ch)] =
+            ch < numOutputChannels ? outputChannelData[ch] : scratchBuffer.getWritePointer(ch - numOutputChannels);
+    }
+
+    // 超出最大处理通道数的设备输出保持静音
+    for (int ch = numProcessingChannels; ch < numOutputChannels; ++ch) {
+        juce::FloatVectorOperations::clear(outputChannelData[ch], numSamples);
+    }
+
+    // 输入数据只复制一次；驱动复用同一块内存作为输入输出时直接挂接，无需复制
+    for (int ch = 0; ch < numProcessingChannels; ++ch) {
+        float* destination = callbackChannelPointers[static_cast<size_t>(ch)];
+        const float* source = ch < numInputsToUse ? inputChannelData[ch] : nullptr;
+
+        if (source == nullptr) {
+            juce::FloatVectorOperations::clear(destination, numSamples);
+        } else if (source != destination) {
+            juce::FloatVectorOperations::copy(destination, source, numSamples);
+        }
+    }
+
+    // 引用设备/暂存内存的缓冲区视图（不分配内存）
+    juce::AudioBuffer<float> processingBuffer(callbackChannelPointers.data(), numProcessingChannels, numSamples);
+    processBlock(processingBuffer, midiBuffer);
+
+    // 采集处理后的设备输出
+    for (auto* sink : sinks) {
+        if (sink != nullptr) {
+            sink->captureAudio(CapturePoint::PostGraph, callbackChannelPointers.data(),
+                               std::min(numOutputChannels, numProcessingChannels), numSamples);
+        }
     }
 }
 
 void GraphAudioProcessor::audioDeviceAboutToStart(juce::AudioIODevice* device) {
-    std::cout << "[GraphAudioProcessor] 音频设备即将启动" << std::endl;
+    WSLOG_INFO("GraphAudioProcessor", "音频设备即将启动");
+    activeDevice.store(device);
+    realtimeLoad.store(0.0f, std::memory_order_relaxed);
 
     if (device) {
+        // macOS 上并行工作线程加入设备的音频工作组
+        parallelScheduler.setAudioWorkgroup(device->getWorkgroup());
+
         double sampleRate = device->getCurrentSampleRate();
         int bufferSize = device->getCurrentBufferSizeSamples();
 
-        std::cout << "[GraphAudioProcessor] 设备参数: " << sampleRate << "Hz, " << bufferSize << " samples" << std::endl;
+        WSLOG_INFO("GraphAudioProcessor", "设备参数: " << sampleRate << "Hz, " << bufferSize << " samples");
 
         // 不要在这里调用prepareToPlay，因为设备管理器已经在准备过程中
         // prepareToPlay应该由AudioIOManager在适当的时候调用
@@ -271,7 +384,8 @@ void GraphAudioProcessor::audioDeviceAboutToStart(juce::AudioIODevice* device) {
 }
 
 void GraphAudioProcessor::audioDeviceStopped() {
-    std::cout << "[GraphAudioProcessor] 音频设备已停止" << std::endl;
+    WSLOG_INFO("GraphAudioProcessor", "音频设备已停止");
+    activeDevice.store(nullptr);
     // 不要在这里调用releaseResources，因为可能导致资源管理冲突
     // releaseResources应该由AudioIOManager在适当的时候调用
 }
@@ -282,7 +396,15 @@ void GraphAudioProcessor::setNonRealtime(bool isNonRealtime) noexcept {
 }
 
 double GraphAudioProcessor::getTailLengthSeconds() const {
-    return audioGraph.getTailLengthSeconds();
+    // AudioProcessorGraph 本身总是返回0，这里累加各节点的尾音长度，
+    // 对串联链是准确值，对并联分支是上界
+    double tailSeconds = 0.0;
+    for (auto* node : audioGraph.getNodes()) {
+        if (node && node->getProcessor() && !node->isBypassed()) {
+            tailSeconds += node->getProcessor()->getTailLengthSeconds();
+        }
+    }
+    return tailSeconds;
 }
 
 bool GraphAudioProcessor::acceptsMidi() const {
@@ -388,18 +510,22 @@ void GraphAudioProcessor::setStateInformation(const void* data, int sizeInBytes)
 //==============================================================================
 
 void GraphAudioProcessor::configure(const GraphConfig& config) {
-    std::cout << "[GraphAudioProcessor] 配置音频图：" << config.sampleRate << "Hz, "
-              << config.samplesPerBlock << " samples, " << config.numInputChannels
-              << " inputs, " << config.numOutputChannels << " outputs" << std::endl;
+    WSLOG_INFO("GraphAudioProcessor", "配置音频图：" << config.sampleRate << "Hz, "
+            << config.samplesPerBlock << " samples, " << config.numInputChannels
+            << " inputs, " << config.numOutputChannels << " outputs");
 
-    std::lock_guard<std::mutex> lock(configMutex);
+    bool needsReinitialization = false;
+    {
+        std::lock_guard<RealtimeCheckedMutex> lock(configMutex);
 
-    bool needsReinitialization = (currentConfig != config);
-    currentConfig = config;
+        needsReinitialization = (currentConfig != config);
+        currentConfig = config;
 
-    // 更新AudioProcessorGraph的通道配置
-    updateGraphChannelConfiguration(config);
+        // 更新AudioProcessorGraph的通道配置
+        updateGraphChannelConfiguration(config);
+    }
 
+    // prepareToPlay 自己持有 configMutex，重新初始化前必须先释放
     if (needsReinitialization && isConfigured.load()) {
         // 如果已经配置过，需要重新初始化
         releaseResources();
@@ -417,33 +543,35 @@ void GraphAudioProcessor::configure(const GraphConfig& config) {
 //==============================================================================
 
 void GraphAudioProcessor::initializeIONodes() {
-    std::cout << "[GraphAudioProcessor] 初始化I/O节点" << std::endl;
+    WSLOG_INFO("GraphAudioProcessor", "初始化I/O节点");
+    ScopedTopologyChange topologyChange(*this);
+    markTopologyChanged();
 
     // 创建音频输入节点（不立即设置父图）
     auto audioInputProcessor = std::make_unique<juce::AudioProcessorGraph::AudioGraphIOProcessor>(
         juce::AudioProcessorGraph::AudioGraphIOProcessor::audioInputNode);
-    audioInputNodeID = audioGraph.addNode(std::move(audioInputProcessor))->nodeID;
+    audioInputNodeID = audioGraph.addNode(std::move(audioInputProcessor), {}, deferredUpdate)->nodeID;
 
     // 创建音频输出节点（不立即设置父图）
     auto audioOutputProcessor = std::make_unique<juce::AudioProcessorGraph::AudioGraphIOProcessor>(
         juce::AudioProcessorGraph::AudioGraphIOProcessor::audioOutputNode);
-    audioOutputNodeID = audioGraph.addNode(std::move(audioOutputProcessor))->nodeID;
+    audioOutputNodeID = audioGraph.addNode(std::move(audioOutputProcessor), {}, deferredUpdate)->nodeID;
 
     // 创建MIDI输入节点
     auto midiInputProcessor = std::make_unique<juce::AudioProcessorGraph::AudioGraphIOProcessor>(
         juce::AudioProcessorGraph::AudioGraphIOProcessor::midiInputNode);
-    midiInputNodeID = audioGraph.addNode(std::move(midiInputProcessor))->nodeID;
+    midiInputNodeID = audioGraph.addNode(std::move(midiInputProcessor), {}, deferredUpdate)->nodeID;
 
     // 创建MIDI输出节点
     auto midiOutputProcessor = std::make_unique<juce::AudioProcessorGraph::AudioGraphIOProcessor>(
         juce::AudioProcessorGraph::AudioGraphIOProcessor::midiOutputNode);
-    midiOutputNodeID = audioGraph.addNode(std::move(midiOutputProcessor))->nodeID;
+    midiOutputNodeID = audioGraph.addNode(std::move(midiOutputProcessor), {}, deferredUpdate)->nodeID;
 
-    std::cout << "[GraphAudioProcessor] I/O节点初始化完成" << std::endl;
+    WSLOG_INFO("GraphAudioProcessor", "I/O节点初始化完成");
 }
 
 void GraphAudioProcessor::updateIONodesParentGraph() {
-    std::cout << "[GraphAudioProcessor] 更新I/O节点父图引用" << std::endl;
+    WSLOG_INFO("GraphAudioProcessor", "更新I/O节点父图引用");
 
     // 更新I/O节点的父图引用，这会触发它们重新配置通道数
     auto* inputNode = audioGraph.getNodeForId(audioInputNodeID);
@@ -475,13 +603,14 @@ void GraphAudioProcessor::updateIONodesParentGraph() {
         }
     }
 
-    std::cout << "[GraphAudioProcessor] I/O节点父图引用更新完成" << std::endl;
+    WSLOG_INFO("GraphAudioProcessor", "I/O节点父图引用更新完成");
 }
 
 void GraphAudioProcessor::createDefaultPassthroughConnections() {
-    std::cout << "[GraphAudioProcessor] 创建默认直通连接" << std::endl;
-    std::cout << "[GraphAudioProcessor] 音频输入节点ID: " << audioInputNodeID.uid << std::endl;
-    std::cout << "[GraphAudioProcessor] 音频输出节点ID: " << audioOutputNodeID.uid << std::endl;
+    WSLOG_INFO("GraphAudioProcessor", "创建默认直通连接");
+    ScopedTopologyChange topologyChange(*this);
+    WSLOG_INFO("GraphAudioProcessor", "音频输入节点ID: " << audioInputNodeID.uid);
+    WSLOG_INFO("GraphAudioProcessor", "音频输出节点ID: " << audioOutputNodeID.uid);
 
     // 检查I/O节点的通道配置
     auto* inputNode = audioGraph.getNodeForId(audioInputNodeID);
@@ -489,94 +618,98 @@ void GraphAudioProcessor::createDefaultPassthroughConnections() {
 
     if (inputNode && inputNode->getProcessor()) {
         auto* inputProcessor = inputNode->getProcessor();
-        std::cout << "[GraphAudioProcessor] 输入节点通道数: 输入=" << inputProcessor->getTotalNumInputChannels()
-                  << ", 输出=" << inputProcessor->getTotalNumOutputChannels() << std::endl;
+        WSLOG_INFO("GraphAudioProcessor", "输入节点通道数: 输入=" << inputProcessor->getTotalNumInputChannels()
+                << ", 输出=" << inputProcessor->getTotalNumOutputChannels());
     }
 
     if (outputNode && outputNode->getProcessor()) {
         auto* outputProcessor = outputNode->getProcessor();
-        std::cout << "[GraphAudioProcessor] 输出节点通道数: 输入=" << outputProcessor->getTotalNumInputChannels()
-                  << ", 输出=" << outputProcessor->getTotalNumOutputChannels() << std::endl;
+        WSLOG_INFO("GraphAudioProcessor", "输出节点通道数: 输入=" << outputProcessor->getTotalNumInputChannels()
+                << ", 输出=" << outputProcessor->getTotalNumOutputChannels());
     }
 
     // 首先检查 audioGraph 的总线配置
-    std::cout << "[GraphAudioProcessor] audioGraph 总线配置 - 输入通道: " << audioGraph.getTotalNumInputChannels()
-              << ", 输出通道: " << audioGraph.getTotalNumOutputChannels() << std::endl;
+    WSLOG_INFO("GraphAudioProcessor", "audioGraph 总线配置 - 输入通道: " << audioGraph.getTotalNumInputChannels()
+            << ", 输出通道: " << audioGraph.getTotalNumOutputChannels());
 
     // 创建立体声直通连接（左声道和右声道）
     Connection leftConnection = makeAudioConnection(audioInputNodeID, 0, audioOutputNodeID, 0);
     Connection rightConnection = makeAudioConnection(audioInputNodeID, 1, audioOutputNodeID, 1);
 
-    std::cout << "[GraphAudioProcessor] 检查左声道连接合法性..." << std::endl;
-    std::cout << "[GraphAudioProcessor] 左声道连接: 输入节点" << audioInputNodeID.uid << "[通道0] -> 输出节点" << audioOutputNodeID.uid << "[通道0]" << std::endl;
+    WSLOG_INFO("GraphAudioProcessor", "检查左声道连接合法性...");
+    WSLOG_INFO("GraphAudioProcessor", "左声道连接: 输入节点" << audioInputNodeID.uid << "[通道0] -> 输出节点" << audioOutputNodeID.uid << "[通道0]");
 
     // 详细检查连接合法性的各个条件
     auto* sourceNode = audioGraph.getNodeForId(audioInputNodeID);
     auto* destNode = audioGraph.getNodeForId(audioOutputNodeID);
 
     if (!sourceNode) {
-        std::cout << "[GraphAudioProcessor] 错误: 源节点不存在" << std::endl;
+        WSLOG_INFO("GraphAudioProcessor", "错误: 源节点不存在");
     } else {
         auto* sourceProcessor = sourceNode->getProcessor();
-        std::cout << "[GraphAudioProcessor] 源节点输出通道数: " << sourceProcessor->getTotalNumOutputChannels() << std::endl;
+        WSLOG_INFO("GraphAudioProcessor", "源节点输出通道数: " << sourceProcessor->getTotalNumOutputChannels());
     }
 
     if (!destNode) {
-        std::cout << "[GraphAudioProcessor] 错误: 目标节点不存在" << std::endl;
+        WSLOG_INFO("GraphAudioProcessor", "错误: 目标节点不存在");
     } else {
         auto* destProcessor = destNode->getProcessor();
-        std::cout << "[GraphAudioProcessor] 目标节点输入通道数: " << destProcessor->getTotalNumInputChannels() << std::endl;
+        WSLOG_INFO("GraphAudioProcessor", "目标节点输入通道数: " << destProcessor->getTotalNumInputChannels());
     }
 
     if (audioGraph.isConnectionLegal(leftConnection)) {
-        bool leftSuccess = audioGraph.addConnection(leftConnection);
-        std::cout << "[GraphAudioProcessor] 左声道直通连接: " << (leftSuccess ? "成功" : "失败") << std::endl;
+        bool leftSuccess = audioGraph.addConnection(leftConnection, deferredUpdate);
+        if (leftSuccess) markTopologyChanged();
+        WSLOG_INFO("GraphAudioProcessor", "左声道直通连接: " << (leftSuccess ? "成功" : "失败"));
     } else {
-        std::cout << "[GraphAudioProcessor] 左声道连接不合法" << std::endl;
+        WSLOG_INFO("GraphAudioProcessor", "左声道连接不合法");
     }
 
-    std::cout << "[GraphAudioProcessor] 检查右声道连接合法性..." << std::endl;
+    WSLOG_INFO("GraphAudioProcessor", "检查右声道连接合法性...");
     if (audioGraph.isConnectionLegal(rightConnection)) {
-        bool rightSuccess = audioGraph.addConnection(rightConnection);
-        std::cout << "[GraphAudioProcessor] 右声道直通连接: " << (rightSuccess ? "成功" : "失败") << std::endl;
+        bool rightSuccess = audioGraph.addConnection(rightConnection, deferredUpdate);
+        if (rightSuccess) markTopologyChanged();
+        WSLOG_INFO("GraphAudioProcessor", "右声道直通连接: " << (rightSuccess ? "成功" : "失败"));
     } else {
-        std::cout << "[GraphAudioProcessor] 右声道连接不合法" << std::endl;
+        WSLOG_INFO("GraphAudioProcessor", "右声道连接不合法");
     }
 
     // 创建MIDI直通连接
     Connection midiConnection = makeMidiConnection(midiInputNodeID, midiOutputNodeID);
-    std::cout << "[GraphAudioProcessor] 检查MIDI连接合法性..." << std::endl;
+    WSLOG_INFO("GraphAudioProcessor", "检查MIDI连接合法性...");
     if (audioGraph.isConnectionLegal(midiConnection)) {
-        bool midiSuccess = audioGraph.addConnection(midiConnection);
-        std::cout << "[GraphAudioProcessor] MIDI直通连接: " << (midiSuccess ? "成功" : "失败") << std::endl;
+        bool midiSuccess = audioGraph.addConnection(midiConnection, deferredUpdate);
+        if (midiSuccess) markTopologyChanged();
+        WSLOG_INFO("GraphAudioProcessor", "MIDI直通连接: " << (midiSuccess ? "成功" : "失败"));
     } else {
-        std::cout << "[GraphAudioProcessor] MIDI连接不合法" << std::endl;
+        WSLOG_INFO("GraphAudioProcessor", "MIDI连接不合法");
     }
 
     // 输出当前连接状态
     auto connections = audioGraph.getConnections();
-    std::cout << "[GraphAudioProcessor] 当前连接数量: " << connections.size() << std::endl;
+    WSLOG_INFO("GraphAudioProcessor", "当前连接数量: " << connections.size());
 
-    std::cout << "[GraphAudioProcessor] 默认直通连接创建完成" << std::endl;
+    WSLOG_INFO("GraphAudioProcessor", "默认直通连接创建完成");
 }
 
 void GraphAudioProcessor::autoConnectPluginToAudioPath(NodeID pluginNodeID) {
-    std::cout << "[GraphAudioProcessor] 自动连接插件到音频路径：" << pluginNodeID.uid << std::endl;
+    WSLOG_INFO("GraphAudioProcessor", "自动连接插件到音频路径：" << pluginNodeID.uid);
+    ScopedTopologyChange topologyChange(*this);
 
     // 获取插件信息
     auto pluginInfo = getNodeInfo(pluginNodeID);
     if (pluginInfo.nodeID.uid == 0) {
-        std::cout << "[GraphAudioProcessor] 插件节点无效" << std::endl;
+        WSLOG_INFO("GraphAudioProcessor", "插件节点无效");
         return;
     }
 
-    std::cout << "[GraphAudioProcessor] 插件信息 - 输入通道: " << pluginInfo.numInputChannels
-              << ", 输出通道: " << pluginInfo.numOutputChannels << std::endl;
+    WSLOG_INFO("GraphAudioProcessor", "插件信息 - 输入通道: " << pluginInfo.numInputChannels
+            << ", 输出通道: " << pluginInfo.numOutputChannels);
 
     // 如果插件有音频输入输出，将其插入到音频路径中
     if (pluginInfo.numInputChannels > 0 && pluginInfo.numOutputChannels > 0) {
         // 断开现有的直通连接
-        std::cout << "[GraphAudioProcessor] 断开现有的直通连接" << std::endl;
+        WSLOG_INFO("GraphAudioProcessor", "断开现有的直通连接");
         auto connections = getAllConnections();
         for (const auto& connInfo : connections) {
             const auto& conn = connInfo.connection;
@@ -584,8 +717,8 @@ void GraphAudioProcessor::autoConnectPluginToAudioPath(NodeID pluginNodeID) {
             if (conn.source.nodeID == audioInputNodeID &&
                 conn.destination.nodeID == audioOutputNodeID &&
                 conn.source.channelIndex != juce::AudioProcessorGraph::midiChannelIndex) {
-                audioGraph.removeConnection(conn);
-                std::cout << "[GraphAudioProcessor] 已断开直通连接：通道 " << conn.source.channelIndex << std::endl;
+                if (audioGraph.removeConnection(conn, deferredUpdate)) markTopologyChanged();
+                WSLOG_DEBUG("GraphAudioProcessor", "已断开直通连接：通道 " << conn.source.channelIndex);
             }
         }
 
@@ -593,28 +726,36 @@ void GraphAudioProcessor::autoConnectPluginToAudioPath(NodeID pluginNodeID) {
         int maxInputChannels = std::min(2, pluginInfo.numInputChannels);  // 最多连接立体声
         int maxOutputChannels = std::min(2, pluginInfo.numOutputChannels);
 
-        std::cout << "[GraphAudioProcessor] 连接音频输入到插件" << std::endl;
+        WSLOG_INFO("GraphAudioProcessor", "连接音频输入到插件");
         for (int ch = 0; ch < maxInputChannels; ++ch) {
             if (connectAudio(audioInputNodeID, ch, pluginNodeID, ch)) {
-                std::cout << "[GraphAudioProcessor] 已连接输入通道 " << ch << " 到插件" << std::endl;
+                WSLOG_DEBUG("GraphAudioProcessor", "已连接输入通道 " << ch << " 到插件");
             }
         }
 
-        std::cout << "[GraphAudioProcessor] 连接插件到音频输出" << std::endl;
+        WSLOG_INFO("GraphAudioProcessor", "连接插件到音频输出");
         for (int ch = 0; ch < maxOutputChannels; ++ch) {
             if (connectAudio(pluginNodeID, ch, audioOutputNodeID, ch)) {
-                std::cout << "[GraphAudioProcessor] 已连接插件通道 " << ch << " 到输出" << std::endl;
+                WSLOG_DEBUG("GraphAudioProcessor", "已连接插件通道 " << ch << " 到输出");
             }
         }
 
-        std::cout << "[GraphAudioProcessor] 插件已成功插入音频路径" << std::endl;
+        WSLOG_INFO("GraphAudioProcessor", "插件已成功插入音频路径");
     } else {
-        std::cout << "[GraphAudioProcessor] 插件没有音频输入输出，跳过音频连接" << std::endl;
+        WSLOG_INFO("GraphAudioProcessor", "插件没有音频输入输出，跳过音频连接");
+    }
+
+    // 接收MIDI的插件（乐器、呼吸控制器驱动的效果器）接到MIDI输入节点
+    auto* node = audioGraph.getNodeForId(pluginNodeID);
+    if (node != nullptr && node->getProcessor()->acceptsMidi() && currentConfig.enableMidi) {
+        if (connectMidi(midiInputNodeID, pluginNodeID)) {
+            WSLOG_DEBUG("GraphAudioProcessor", "已连接MIDI输入到插件");
+        }
     }
 }
 
 void GraphAudioProcessor::updateGraphChannelConfiguration(const GraphConfig& config) {
-    std::cout << "[GraphAudioProcessor] 更新音频图通道配置" << std::endl;
+    WSLOG_INFO("GraphAudioProcessor", "更新音频图通道配置");
 
     // 设置AudioProcessorGraph的通道配置
     // 这会影响AudioGraphIOProcessor的通道数
@@ -632,67 +773,181 @@ void GraphAudioProcessor::updateGraphChannelConfiguration(const GraphConfig& con
     // 强制更新缓存的通道数
     setBusesLayout(getBusesLayout());
 
-    std::cout << "[GraphAudioProcessor] 当前总线配置 - 输入通道: " << getTotalNumInputChannels()
-              << ", 输出通道: " << getTotalNumOutputChannels() << std::endl;
+    WSLOG_INFO("GraphAudioProcessor", "当前总线配置 - 输入通道: " << getTotalNumInputChannels()
+            << ", 输出通道: " << getTotalNumOutputChannels());
 
     // 关键：为内部的 audioGraph 设置相同的总线配置
     juce::AudioProcessor::BusesLayout graphLayout;
     graphLayout.inputBuses.add(inputChannelSet);
     graphLayout.outputBuses.add(outputChannelSet);
 
-    std::cout << "[GraphAudioProcessor] 设置 audioGraph 总线配置..." << std::endl;
+    WSLOG_INFO("GraphAudioProcessor", "设置 audioGraph 总线配置...");
     bool layoutSuccess = audioGraph.setBusesLayout(graphLayout);
-    std::cout << "[GraphAudioProcessor] audioGraph 总线配置设置" << (layoutSuccess ? "成功" : "失败") << std::endl;
-    std::cout << "[GraphAudioProcessor] audioGraph 总线配置 - 输入通道: " << audioGraph.getTotalNumInputChannels()
-              << ", 输出通道: " << audioGraph.getTotalNumOutputChannels() << std::endl;
+    WSLOG_INFO("GraphAudioProcessor", "audioGraph 总线配置设置" << (layoutSuccess ? "成功" : "失败"));
+    WSLOG_INFO("GraphAudioProcessor", "audioGraph 总线配置 - 输入通道: " << audioGraph.getTotalNumInputChannels()
+            << ", 输出通道: " << audioGraph.getTotalNumOutputChannels());
 
     // 更新I/O节点的父图引用，这会触发它们重新配置通道数
     updateIONodesParentGraph();
 
-    std::cout << "[GraphAudioProcessor] 音频图通道配置更新完成" << std::endl;
+    WSLOG_INFO("GraphAudioProcessor", "音频图通道配置更新完成");
 }
 
-void GraphAudioProcessor::updatePerformanceStats(double processingTimeMs) {
-    std::lock_guard<std::mutex> lock(statsMutex);
-    
-    performanceStats.totalProcessedBlocks++;
-    
-    // 更新处理时间统计
-    if (performanceStats.totalProcessedBlocks == 1) {
-        performanceStats.minProcessingTimeMs = processingTimeMs;
-        performanceStats.maxProcessingTimeMs = processingTimeMs;
-        performanceStats.averageProcessingTimeMs = processingTimeMs;
-    } else {
-        performanceStats.minProcessingTimeMs = std::min(performanceStats.minProcessingTimeMs, processingTimeMs);
-        performanceStats.maxProcessingTimeMs = std::max(performanceStats.maxProcessingTimeMs, processingTimeMs);
-        
-        // 计算移动平均值
-        double alpha = 0.1; // 平滑因子
-        performanceStats.averageProcessingTimeMs = 
-            alpha * processingTimeMs + (1.0 - alpha) * performanceStats.averageProcessingTimeMs;
+void GraphAudioProcessor::allocateProcessingBuffers(int numChannels, int samplesPerBlock) {
+    numChannels = juce::jlimit(1, Constants::MAX_AUDIO_CHANNELS, numChannels);
+    samplesPerBlock = std::max(1, samplesPerBlock);
+
+    transportBuffer.setSize(numChannels, samplesPerBlock, false, true, false);
+    scratchBuffer.setSize(numChannels, samplesPerBlock, false, true, false);
+
+    // 预留足够的MIDI事件空间，避免音频线程中扩容
+    callbackMidiBuffer.ensureSize(static_cast<size_t>(Constants::MIDI_BUFFER_RESERVE_BYTES));
+
+    preparedNumChannels = numChannels;
+    preparedBlockSize = samplesPerBlock;
+}
+
+void GraphAudioProcessor::resizeProcessingBuffer(juce::AudioBuffer<float>& buffer,
+                                                 int numChannels, int numSamples) noexcept {
+    if (numChannels > preparedNumChannels || numSamples > preparedBlockSize) {
+        // 设备给出的块大于prepareToPlay时的预期，只能重新分配
+        RealtimeSafety::reportViolation("音频回调中的缓冲区超出预分配容量");
+        preparedNumChannels = std::max(preparedNumChannels, numChannels);
+        preparedBlockSize = std::max(preparedBlockSize, numSamples);
     }
-    
-    // 维护处理时间历史记录
-    processingTimeHistory.push_back(processingTimeMs);
-    if (processingTimeHistory.size() > Constants::PERFORMANCE_STATS_HISTORY_SIZE) {
-        processingTimeHistory.erase(processingTimeHistory.begin());
+
+    // avoidReallocating=true：容量足够时只调整视图大小
+    buffer.setSize(numChannels, numSamples, false, false, true);
+}
+
+void GraphAudioProcessor::updatePerformanceStats(double processingTimeMs, int numSamples) noexcept {
+    // 音频线程只写入无锁队列，队列已满时丢弃样本
+    processingTimeQueue.push({ processingTimeMs, numSamples });
+
+    // 本块的实时统计，供同一回调中的采集接收器发布
+    const double sampleRate = currentConfig.sampleRate > 0.0 ? currentConfig.sampleRate
+                                                             : Constants::DEFAULT_SAMPLE_RATE;
+    const double bufferDurationMs = (numSamples / sampleRate) * 1000.0;
+    if (bufferDurationMs > 0.0) {
+        const double blockCpu = (processingTimeMs / bufferDurationMs) * 100.0;
+        realtimeBlockStats.cpuUsagePercent = realtimeBlockStats.blockCount == 0
+            ? blockCpu
+            : 0.1 * blockCpu + 0.9 * realtimeBlockStats.cpuUsagePercent;
+        realtimeLoad.store(static_cast<float>(realtimeBlockStats.cpuUsagePercent / 100.0), std::memory_order_relaxed);
     }
-    
-    // 计算CPU使用率（基于处理时间和缓冲区大小）
-    double bufferDurationMs = (currentConfig.samplesPerBlock / currentConfig.sampleRate) * 1000.0;
-    performanceStats.cpuUsagePercent = (processingTimeMs / bufferDurationMs) * 100.0;
-    
-    // 定期调用性能回调
-    if (performanceCallback && (performanceStats.totalProcessedBlocks % 100 == 0)) {
-        performanceCallback(performanceStats);
+    realtimeBlockStats.processingTimeMs = processingTimeMs;
+    realtimeBlockStats.numSamples = numSamples;
+    realtimeBlockStats.blockCount++;
+
+    // 性能回调在分发线程中汇总后触发
+    if (realtimeBlockStats.blockCount % 100 == 0) {
+        if (auto* dispatcher = notificationDispatcher.load(std::memory_order_acquire)) {
+            dispatcher->post(NotificationType::PerformanceChanged, notificationSourceID);
+        }
     }
 }
 
+bool GraphAudioProcessor::drainPerformanceQueueLocked() const {
+    bool shouldNotify = false;
+    const double sampleRate = currentConfig.sampleRate > 0.0 ? currentConfig.sampleRate
+                                                             : Constants::DEFAULT_SAMPLE_RATE;
+
+    processingTimeQueue.drain([&](const ProcessingTimeSample& sample) {
+        const double processingTimeMs = sample.processingTimeMs;
+        performanceStats.totalProcessedBlocks++;
+        
+        // 更新处理时间统计
+        if (performanceStats.totalProcessedBlocks == 1) {
+            performanceStats.minProcessingTimeMs = processingTimeMs;
+            performanceStats.maxProcessingTimeMs = processingTimeMs;
+            performanceStats.averageProcessingTimeMs = processingTimeMs;
+        } else {
+            performanceStats.minProcessingTimeMs = std::min(performanceStats.minProcessingTimeMs, processingTimeMs);
+            performanceStats.maxProcessingTimeMs = std::max(performanceStats.maxProcessingTimeMs, processingTimeMs);
+            
+            // 计算移动平均值
+            double alpha = 0.1; // 平滑因子
+            performanceStats.averageProcessingTimeMs = 
+                alpha * processingTimeMs + (1.0 - alpha) * performanceStats.averageProcessingTimeMs;
+        }
+        
+        // 计算CPU使用率（基于处理时间和实际块长度）
+        double bufferDurationMs = (sample.numSamples / sampleRate) * 1000.0;
+        if (bufferDurationMs > 0.0) {
+            performanceStats.cpuUsagePercent = (processingTimeMs / bufferDurationMs) * 100.0;
+        }
+        performanceStats.bufferDurationMs = bufferDurationMs;
+        
+        // 百分位直方图和截止时间检测
+        overallLatencyHistogram.add(processingTimeMs);
+        windowLatencyHistogram.add(processingTimeMs);
+        
+        const bool missedDeadline = bufferDurationMs > 0.0 && processingTimeMs > bufferDurationMs;
+        const bool nearMiss = bufferDurationMs > 0.0 && processingTimeMs > bufferDurationMs * 0.8;
+        for (auto* percentiles : { &performanceStats.overall, &performanceStats.currentWindow }) {
+            percentiles->blocks++;
+            percentiles->deadlineMisses += missedDeadline ? 1 : 0;
+            percentiles->nearMisses += nearMiss ? 1 : 0;
+        }
+        
+        // 按音频时长滚动统计窗口
+        windowElapsedSeconds += bufferDurationMs / 1000.0;
+        if (performanceStats.windowSeconds > 0.0 && windowElapsedSeconds >= performanceStats.windowSeconds) {
+            finishPerformanceWindowLocked();
+        }
+        
+        // 定期调用性能回调
+        if (performanceStats.totalProcessedBlocks % 100 == 0) {
+            shouldNotify = true;
+        }
+    });
+
+    performanceStats.droppedStatsSamples = processingTimeQueue.getDroppedCount();
+    performanceStats.realtimeViolations = RealtimeSafety::getViolationCount();
+
+    // 更新百分位
+    auto fillPercentiles = [](LatencyPercentiles& percentiles, const LatencyHistogram& histogram) {
+        percentiles.p50Ms = histogram.getPercentile(0.50);
+        percentiles.p95Ms = histogram.getPercentile(0.95);
+        percentiles.p99Ms = histogram.getPercentile(0.99);
+        percentiles.p999Ms = histogram.getPercentile(0.999);
+        percentiles.maxMs = histogram.getMax();
+    };
+    fillPercentiles(performanceStats.overall, overallLatencyHistogram);
+    fillPercentiles(performanceStats.currentWindow, windowLatencyHistogram);
+
+    // 设备报告的xrun
+    if (auto* device = activeDevice.load()) {
+        const int xruns = device->getXRunCount();
+        if (xruns >= 0) {
+            performanceStats.deviceXruns = xruns;
+        }
+    }
+
+    return shouldNotify;
+}
+
+void GraphAudioProcessor::finishPerformanceWindowLocked() const {
+    auto& window = performanceStats.currentWindow;
+    window.p50Ms = windowLatencyHistogram.getPercentile(0.50);
+    window.p95Ms = windowLatencyHistogram.getPercentile(0.95);
+    window.p99Ms = windowLatencyHistogram.getPercentile(0.99);
+    window.p999Ms = windowLatencyHistogram.getPercentile(0.999);
+    window.maxMs = windowLatencyHistogram.getMax();
+
+    performanceStats.lastWindow = window;
+    performanceStats.completedWindows++;
+
+    window = {};
+    windowLatencyHistogram.clear();
+    windowElapsedSeconds = 0.0;
+}
+
 void GraphAudioProcessor::handleError(const std::string& error) {
-    std::lock_guard<std::mutex> lock(errorMutex);
+    std::lock_guard<RealtimeCheckedMutex> lock(errorMutex);
     lastError = error;
     
-    std::cout << "[GraphAudioProcessor] 错误：" << error << std::endl;
+    WSLOG_INFO("GraphAudioProcessor", "错误：" << error);
     
     if (errorCallback) {
         errorCallback(error);
@@ -700,7 +955,7 @@ void GraphAudioProcessor::handleError(const std::string& error) {
 }
 
 void GraphAudioProcessor::notifyStateChange(const std::string& message) {
-    std::cout << "[GraphAudioProcessor] 状态变化：" << message << std::endl;
+    WSLOG_INFO("GraphAudioProcessor", "状态变化：" << message);
     
     if (stateCallback) {
         stateCallback(message);
@@ -727,15 +982,22 @@ NodeID GraphAudioProcessor::addPlugin(std::unique_ptr<juce::AudioPluginInstance>
     }
 
     std::string pluginName = name.empty() ? plugin->getName().toStdString() : name;
-    std::cout << "[GraphAudioProcessor] 添加插件：" << pluginName << std::endl;
+    WSLOG_INFO("GraphAudioProcessor", "添加插件：" << pluginName);
 
     try {
-        // 直接添加到AudioProcessorGraph - 这就是JUCE的设计！
-        auto node = audioGraph.addNode(std::move(plugin));
+        // 插件节点和自动连接作为一次拓扑切换提交
+        ScopedTopologyChange topologyChange(*this);
+
+        // 包装后添加到AudioProcessorGraph，以便统计每个节点的处理耗时
+        auto node = audioGraph.addNode(std::make_unique<ProfiledPluginProcessor>(std::move(plugin),
+                                                                                nodeProfilingEnabled),
+                                       {}, deferredUpdate);
         if (!node) {
             handleError("无法添加插件到音频图");
             return NodeID{0};
         }
+        watchNodeLatency(node.get());
+        markTopologyChanged();
 
         // 如果图已经准备就绪，需要准备新节点
         if (isGraphReady()) {
@@ -756,32 +1018,38 @@ NodeID GraphAudioProcessor::addPlugin(std::unique_ptr<juce::AudioPluginInstance>
 }
 
 bool GraphAudioProcessor::removeNode(NodeID nodeID) {
+    return detachNode(nodeID) != nullptr;
+}
+
+juce::AudioProcessorGraph::Node::Ptr GraphAudioProcessor::detachNode(NodeID nodeID) {
     if (!isValidNodeID(nodeID)) {
         handleError("尝试删除无效的节点ID");
-        return false;
+        return nullptr;
     }
 
     // 不允许删除I/O节点
     if (nodeID == audioInputNodeID || nodeID == audioOutputNodeID ||
         nodeID == midiInputNodeID || nodeID == midiOutputNodeID) {
         handleError("不能删除I/O节点");
-        return false;
+        return nullptr;
     }
 
-    std::cout << "[GraphAudioProcessor] 删除节点：" << nodeID.uid << std::endl;
+    WSLOG_INFO("GraphAudioProcessor", "删除节点：" << nodeID.uid);
 
     try {
-        auto removedNode = audioGraph.removeNode(nodeID);
+        ScopedTopologyChange topologyChange(*this);
+        auto removedNode = audioGraph.removeNode(nodeID, deferredUpdate);
         if (removedNode) {
+            unwatchNodeLatency(removedNode.get());
+            markTopologyChanged();
             notifyStateChange("节点已删除");
-            return true;
         } else {
             handleError("无法删除节点");
-            return false;
         }
+        return removedNode;
     } catch (const std::exception& e) {
         handleError("删除节点时发生异常：" + std::string(e.what()));
-        return false;
+        return nullptr;
     }
 }
 
@@ -801,6 +1069,10 @@ std::vector<NodeInfo> GraphAudioProcessor::getAllNodes() const {
             info.producesMidi = node->getProcessor()->producesMidi();
             info.latencyInSamples = node->getProcessor()->getLatencySamples();
             info.bypassed = node->isBypassed();
+            if (auto* profiled = dynamic_cast<ProfiledPluginProcessor*>(node->getProcessor())) {
+                info.sleepWhenSilent = profiled->isSleepWhenSilentEnabled();
+                info.sleeping = profiled->isSleeping();
+            }
 
             nodeInfos.push_back(info);
         }
@@ -826,6 +1098,10 @@ NodeInfo GraphAudioProcessor::getNodeInfo(NodeID nodeID) const {
     info.producesMidi = node->getProcessor()->producesMidi();
     info.latencyInSamples = node->getProcessor()->getLatencySamples();
     info.bypassed = node->isBypassed();
+    if (auto* profiled = dynamic_cast<ProfiledPluginProcessor*>(node->getProcessor())) {
+        info.sleepWhenSilent = profiled->isSleepWhenSilentEnabled();
+        info.sleeping = profiled->isSleeping();
+    }
 
     return info;
 }
@@ -842,6 +1118,19 @@ bool GraphAudioProcessor::setNodeBypassed(NodeID nodeID, bool bypassed) {
     return true;
 }
 
+bool GraphAudioProcessor::setNodeSleepWhenSilent(NodeID nodeID, bool sleepWhenSilent) {
+    auto* node = audioGraph.getNodeForId(nodeID);
+    auto* profiled = node != nullptr ? dynamic_cast<ProfiledPluginProcessor*>(node->getProcessor()) : nullptr;
+    if (!profiled) {
+        handleError("无法找到指定的插件节点");
+        return false;
+    }
+
+    profiled->setSleepWhenSilent(sleepWhenSilent);
+    notifyStateChange("节点静音休眠已更新");
+    return true;
+}
+
 bool GraphAudioProcessor::setNodeEnabled(NodeID nodeID, bool enabled) {
     // JUCE AudioProcessorGraph没有直接的enabled概念，
     // 我们可以通过旁路来模拟
@@ -866,8 +1155,10 @@ bool GraphAudioProcessor::connectAudio(NodeID sourceNode, int sourceChannel,
         return false;
     }
 
-    bool success = audioGraph.addConnection(connection);
+    ScopedTopologyChange topologyChange(*this);
+    bool success = audioGraph.addConnection(connection, deferredUpdate);
     if (success) {
+        markTopologyChanged();
         notifyStateChange("音频连接已创建");
     } else {
         handleError("无法创建音频连接");
@@ -889,8 +1180,10 @@ bool GraphAudioProcessor::connectMidi(NodeID sourceNode, NodeID destNode) {
         return false;
     }
 
-    bool success = audioGraph.addConnection(connection);
+    ScopedTopologyChange topologyChange(*this);
+    bool success = audioGraph.addConnection(connection, deferredUpdate);
     if (success) {
+        markTopologyChanged();
         notifyStateChange("MIDI连接已创建");
     } else {
         handleError("无法创建MIDI连接");
@@ -900,8 +1193,10 @@ bool GraphAudioProcessor::connectMidi(NodeID sourceNode, NodeID destNode) {
 }
 
 bool GraphAudioProcessor::disconnect(const Connection& connection) {
-    bool success = audioGraph.removeConnection(connection);
+    ScopedTopologyChange topologyChange(*this);
+    bool success = audioGraph.removeConnection(connection, deferredUpdate);
     if (success) {
+        markTopologyChanged();
         notifyStateChange("连接已断开");
     } else {
         handleError("无法断开连接");
@@ -916,8 +1211,10 @@ bool GraphAudioProcessor::disconnectNode(NodeID nodeID) {
         return false;
     }
 
-    bool success = audioGraph.disconnectNode(nodeID);
+    ScopedTopologyChange topologyChange(*this);
+    bool success = audioGraph.disconnectNode(nodeID, deferredUpdate);
     if (success) {
+        markTopologyChanged();
         notifyStateChange("节点的所有连接已断开");
     } else {
         handleError("无法断开节点连接");
@@ -952,25 +1249,825 @@ std::vector<ConnectionInfo> GraphAudioProcessor::getAllConnections() const {
     return connectionInfos;
 }
 
+//==============================================================================
+// 图快照实现
+//==============================================================================
+
+GraphSnapshot GraphAudioProcessor::createGraphSnapshot() const {
+    GraphSnapshot snapshot;
+    snapshot.config = currentConfig;
+    snapshot.audioInputNodeID = audioInputNodeID;
+    snapshot.audioOutputNodeID = audioOutputNodeID;
+    snapshot.midiInputNodeID = midiInputNodeID;
+    snapshot.midiOutputNodeID = midiOutputNodeID;
+
+    for (auto* node : audioGraph.getNodes()) {
+        if (!node) {
+            continue;
+        }
+
+        // 只记录插件节点，I/O节点由目标处理器自行创建
+        GraphSnapshot::NodeSnapshot nodeSnapshot;
+        if (captureNodeSnapshot(*node, nodeSnapshot)) {
+            snapshot.nodes.push_back(std::move(nodeSnapshot));
+        }
+    }
+
+    for (const auto& connection : audioGraph.getConnections()) {
+        snapshot.connections.push_back(connection);
+    }
+
+    return snapshot;
+}
+
+bool GraphAudioProcessor::restoreGraphSnapshot(const GraphSnapshot& snapshot,
+                                               const PluginInstanceFactory& pluginFactory,
+                                               std::string& error) {
+    if (!pluginFactory && snapshot.hasPlugins()) {
+        error = "未提供插件实例工厂";
+        return false;
+    }
+
+    WSLOG_INFO("GraphAudioProcessor", "从快照重建图，插件数量: " << snapshot.nodes.size());
+
+    // 整个重建过程作为一次拓扑切换提交
+    ScopedTopologyChange topologyChange(*this);
+    markTopologyChanged();
+
+    // 移除现有插件节点和所有连接
+    std::vector<NodeID> nodesToRemove;
+    for (auto* node : audioGraph.getNodes()) {
+        if (node && node->nodeID != audioInputNodeID && node->nodeID != audioOutputNodeID &&
+            node->nodeID != midiInputNodeID && node->nodeID != midiOutputNodeID) {
+            nodesToRemove.push_back(node->nodeID);
+        }
+    }
+    for (auto nodeID : nodesToRemove) {
+        if (auto removedNode = audioGraph.removeNode(nodeID, deferredUpdate)) {
+            unwatchNodeLatency(removedNode.get());
+        }
+    }
+    for (const auto& connection : audioGraph.getConnections()) {
+        audioGraph.removeConnection(connection, deferredUpdate);
+    }
+
+    // 重建插件节点（保持原有节点ID，以便连接可以直接恢复）
+    for (const auto& nodeSnapshot : snapshot.nodes) {
+        juce::String pluginError;
+        auto instance = pluginFactory(nodeSnapshot.description, currentConfig.sampleRate,
+                                      currentConfig.samplesPerBlock, pluginError);
+        if (!instance) {
+            error = "无法创建插件实例：" + nodeSnapshot.name + " - " + pluginError.toStdString();
+            return false;
+        }
+
+        if (nodeSnapshot.state.getSize() > 0) {
+            instance->setStateInformation(nodeSnapshot.state.getData(),
+                                          static_cast<int>(nodeSnapshot.state.getSize()));
+        }
+
+        if (!addSnapshotNode(std::move(instance), nodeSnapshot)) {
+            error = "无法添加插件到音频图：" + nodeSnapshot.name;
+            return false;
+        }
+    }
+
+    // 恢复连接，I/O节点ID映射到本处理器的I/O节点
+    auto mapNodeID = [&](NodeID nodeID) {
+        if (nodeID == snapshot.audioInputNodeID) return audioInputNodeID;
+        if (nodeID == snapshot.audioOutputNodeID) return audioOutputNodeID;
+        if (nodeID == snapshot.midiInputNodeID) return midiInputNodeID;
+        if (nodeID == snapshot.midiOutputNodeID) return midiOutputNodeID;
+        return nodeID;
+    };
+
+    for (const auto& connection : snapshot.connections) {
+        Connection mapped = connection;
+        mapped.source.nodeID = mapNodeID(connection.source.nodeID);
+        mapped.destination.nodeID = mapNodeID(connection.destination.nodeID);
+
+        if (!audioGraph.addConnection(mapped, deferredUpdate)) {
+            WSLOG_WARNING("GraphAudioProcessor", "警告：无法恢复连接 " << mapped.source.nodeID.uid
+                    << " -> " << mapped.destination.nodeID.uid);
+        }
+    }
+
+    notifyStateChange("音频图已从快照重建");
+    return true;
+}
+
+std::map<juce::uint32, NodeID> GraphAudioProcessor::recallGraph(std::vector<RecallNode>& nodes,
+                                                               const std::vector<Connection>& connections,
+                                                               const std::array<NodeID, 4>& sourceIONodes,
+                                                               std::vector<juce::AudioProcessorGraph::Node::Ptr>& removedNodes) {
+    WSLOG_INFO("GraphAudioProcessor", "召回图，插件数量: " << nodes.size());
+
+    std::map<juce::uint32, NodeID> resolvedIDs;
+    resolvedIDs[sourceIONodes[0].uid] = audioInputNodeID;
+    resolvedIDs[sourceIONodes[1].uid] = audioOutputNodeID;
+    resolvedIDs[sourceIONodes[2].uid] = midiInputNodeID;
+    resolvedIDs[sourceIONodes[3].uid] = midiOutputNodeID;
+
+    std::set<juce::uint32> reusedUIDs;
+    for (const auto& node : nodes) {
+        if (!node.instance && node.existingNodeID.uid != 0) {
+            reusedUIDs.insert(node.existingNodeID.uid);
+        }
+    }
+
+    // 整个替换过程作为一次拓扑切换提交
+    ScopedTopologyChange topologyChange(*this);
+    markTopologyChanged();
+
+    // 移除没有被复用的插件节点和所有连接
+    std::vector<NodeID> nodesToRemove;
+    for (auto* node : audioGraph.getNodes()) {
+        if (node && node->nodeID != audioInputNodeID && node->nodeID != audioOutputNodeID &&
+            node->nodeID != midiInputNodeID && node->nodeID != midiOutputNodeID &&
+            reusedUIDs.count(node->nodeID.uid) == 0) {
+            nodesToRemove.push_back(node->nodeID);
+        }
+    }
+    for (auto nodeID : nodesToRemove) {
+        if (auto removedNode = audioGraph.removeNode(nodeID, deferredUpdate)) {
+            unwatchNodeLatency(removedNode.get());
+            removedNodes.push_back(std::move(removedNode));
+        }
+    }
+    for (const auto& connection : audioGraph.getConnections()) {
+        audioGraph.removeConnection(connection, deferredUpdate);
+    }
+
+    // 复用的节点保持原有ID，新实例使用自动分配的ID，避免与复用的节点冲突
+    for (auto& recallNode : nodes) {
+        juce::AudioProcessorGraph::Node* node = nullptr;
+
+        if (recallNode.instance) {
+            auto added = audioGraph.addNode(std::make_unique<ProfiledPluginProcessor>(std::move(recallNode.instance),
+                                                                                     nodeProfilingEnabled),
+                                            {}, deferredUpdate);
+            if (!added) {
+                WSLOG_WARNING("GraphAudioProcessor", "警告：无法添加插件到音频图：" << recallNode.name);
+                continue;
+            }
+
+            node = added.get();
+            watchNodeLatency(node);
+            if (isGraphReady()) {
+                node->getProcessor()->prepareToPlay(currentConfig.sampleRate, currentConfig.samplesPerBlock);
+            }
+        } else {
+            node = audioGraph.getNodeForId(recallNode.existingNodeID);
+            if (node == nullptr) {
+                continue;
+            }
+        }
+
+        node->setBypassed(recallNode.bypassed);
+        resolvedIDs[recallNode.sourceUID] = node->nodeID;
+    }
+
+    for (const auto& connection : connections) {
+        auto source = resolvedIDs.find(connection.source.nodeID.uid);
+        auto destination = resolvedIDs.find(connection.destination.nodeID.uid);
+        if (source == resolvedIDs.end() || destination == resolvedIDs.end()) {
+            continue;
+        }
+
+        Connection mapped = connection;
+        mapped.source.nodeID = source->second;
+        mapped.destination.nodeID = destination->second;
+
+        if (!audioGraph.addConnection(mapped, deferredUpdate)) {
+            WSLOG_WARNING("GraphAudioProcessor", "警告：无法恢复连接 " << mapped.source.nodeID.uid
+                    << " -> " << mapped.destination.nodeID.uid);
+        }
+    }
+
+    // I/O节点只用于映射连接，不返回给调用方
+    for (const auto& ioNode : sourceIONodes) {
+        resolvedIDs.erase(ioNode.uid);
+    }
+
+    notifyStateChange("音频图已召回");
+    return resolvedIDs;
+}
+
+//==============================================================================
+// 子图替换实现
+//==============================================================================
+
+GraphSnapshot GraphAudioProcessor::createSubgraphSnapshot(const std::vector<NodeID>& nodeIDs) const {
+    GraphSnapshot snapshot;
+    snapshot.config = currentConfig;
+    snapshot.audioInputNodeID = audioInputNodeID;
+    snapshot.audioOutputNodeID = audioOutputNodeID;
+    snapshot.midiInputNodeID = midiInputNodeID;
+    snapshot.midiOutputNodeID = midiOutputNodeID;
+
+    std::set<juce::uint32> capturedUIDs;
+    for (auto nodeID : nodeIDs) {
+        auto* node = audioGraph.getNodeForId(nodeID);
+        if (node == nullptr || capturedUIDs.count(nodeID.uid) > 0) {
+            continue;
+        }
+
+        GraphSnapshot::NodeSnapshot nodeSnapshot;
+        if (captureNodeSnapshot(*node, nodeSnapshot)) {
+            capturedUIDs.insert(nodeID.uid);
+            snapshot.nodes.push_back(std::move(nodeSnapshot));
+        }
+    }
+
+    for (const auto& connection : audioGraph.getConnections()) {
+        if (capturedUIDs.count(connection.source.nodeID.uid) > 0 ||
+            capturedUIDs.count(connection.destination.nodeID.uid) > 0) {
+            snapshot.connections.push_back(connection);
+        }
+    }
+
+    return snapshot;
+}
+
+NodeID GraphAudioProcessor::replaceNodes(const std::vector<NodeID>& nodeIDs,
+                                         std::unique_ptr<juce::AudioProcessor> replacement,
+                                         std::vector<juce::AudioProcessorGraph::Node::Ptr>& removedNodes) {
+    if (!replacement || nodeIDs.empty()) {
+        handleError("替换节点参数无效");
+        return NodeID{0};
+    }
+
+    std::set<juce::uint32> replacedUIDs;
+    for (auto nodeID : nodeIDs) {
+        if (!isValidNodeID(nodeID) || nodeID == audioInputNodeID || nodeID == audioOutputNodeID ||
+            nodeID == midiInputNodeID || nodeID == midiOutputNodeID) {
+            handleError("只能替换插件节点：" + std::to_string(nodeID.uid));
+            return NodeID{0};
+        }
+        replacedUIDs.insert(nodeID.uid);
+    }
+
+    // 被替换节点向外的音频连接，之后由替换节点接上
+    std::vector<Connection> outgoingConnections;
+    for (const auto& connection : audioGraph.getConnections()) {
+        if (replacedUIDs.count(connection.source.nodeID.uid) > 0 &&
+            replacedUIDs.count(connection.destination.nodeID.uid) == 0 &&
+            !connection.source.isMIDI()) {
+            outgoingConnections.push_back(connection);
+        }
+    }
+
+    WSLOG_INFO("GraphAudioProcessor", "替换节点，数量: " << replacedUIDs.size());
+
+    try {
+        ScopedTopologyChange topologyChange(*this);
+        markTopologyChanged();
+
+        auto node = audioGraph.addNode(std::move(replacement), {}, deferredUpdate);
+        if (!node) {
+            handleError("无法添加替换节点到音频图");
+            return NodeID{0};
+        }
+        watchNodeLatency(node.get());
+
+        if (isGraphReady()) {
+            node->getProcessor()->prepareToPlay(currentConfig.sampleRate, currentConfig.samplesPerBlock);
+        }
+
+        for (auto uid : replacedUIDs) {
+            if (auto removedNode = audioGraph.removeNode(NodeID{uid}, deferredUpdate)) {
+                unwatchNodeLatency(removedNode.get());
+                removedNodes.push_back(std::move(removedNode));
+            }
+        }
+
+        for (const auto& connection : outgoingConnections) {
+            Connection mapped = connection;
+            mapped.source.nodeID = node->nodeID;
+
+            if (!audioGraph.addConnection(mapped, deferredUpdate)) {
+                WSLOG_WARNING("GraphAudioProcessor", "警告：无法连接替换节点 " << mapped.source.channelIndex
+                        << " -> " << mapped.destination.nodeID.uid);
+            }
+        }
+
+        notifyStateChange("节点已替换：" + node->getProcessor()->getName().toStdString());
+        return node->nodeID;
+
+    } catch (const std::exception& e) {
+        handleError("替换节点时发生异常：" + std::string(e.what()));
+        return NodeID{0};
+    }
+}
+
+bool GraphAudioProcessor::restoreReplacedNodes(NodeID replacementNodeID,
+                                               const GraphSnapshot& subgraph,
+                                               std::vector<juce::AudioProcessorGraph::Node::Ptr>& retainedNodes,
+                                               const PluginInstanceFactory& pluginFactory,
+                                               std::string& error) {
+    if (audioGraph.getNodeForId(replacementNodeID) == nullptr) {
+        error = "替换节点不存在";
+        return false;
+    }
+
+    // 先准备好所有插件实例，任何一个失败时不修改图
+    std::vector<std::unique_ptr<juce::AudioPluginInstance>> instances;
+    for (const auto& nodeSnapshot : subgraph.nodes) {
+        if (audioGraph.getNodeForId(NodeID{nodeSnapshot.nodeUID}) != nullptr) {
+            error = "节点ID已被占用：" + std::to_string(nodeSnapshot.nodeUID);
+            return false;
+        }
+
+        std::unique_ptr<juce::AudioPluginInstance> instance;
+        auto retained = std::find_if(retainedNodes.begin(), retainedNodes.end(),
+                                     [&nodeSnapshot](const juce::AudioProcessorGraph::Node::Ptr& node) {
+                                         return node != nullptr && node->nodeID.uid == nodeSnapshot.nodeUID;
+                                     });
+
+        // 保留的节点不再被渲染序列引用时才能取出插件实例
+        if (retained != retainedNodes.end() && (*retained)->getReferenceCount() <= 1) {
+            if (auto* profiled = dynamic_cast<ProfiledPluginProcessor*>((*retained)->getProcessor())) {
+                instance = profiled->releasePluginInstance();
+            }
+        }
+
+        if (!instance) {
+            if (!pluginFactory) {
+                error = "未提供插件实例工厂";
+                return false;
+            }
+
+            juce::String pluginError;
+            instance = pluginFactory(nodeSnapshot.description, currentConfig.sampleRate,
+                                     currentConfig.samplesPerBlock, pluginError);
+            if (!instance) {
+                error = "无法创建插件实例：" + nodeSnapshot.name + " - " + pluginError.toStdString();
+                return false;
+            }
+
+            if (nodeSnapshot.state.getSize() > 0) {
+                instance->setStateInformation(nodeSnapshot.state.getData(),
+                                              static_cast<int>(nodeSnapshot.state.getSize()));
+            }
+        }
+
+        instances.push_back(std::move(instance));
+    }
+
+    WSLOG_INFO("GraphAudioProcessor", "恢复被替换的节点，数量: " << subgraph.nodes.size());
+
+    ScopedTopologyChange topologyChange(*this);
+    markTopologyChanged();
+
+    if (auto removedNode = audioGraph.removeNode(replacementNodeID, deferredUpdate)) {
+        unwatchNodeLatency(removedNode.get());
+    }
+
+    for (size_t i = 0; i < subgraph.nodes.size(); ++i) {
+        if (!addSnapshotNode(std::move(instances[i]), subgraph.nodes[i])) {
+            WSLOG_WARNING("GraphAudioProcessor", "警告：无法添加插件到音频图：" << subgraph.nodes[i].name);
+        }
+    }
+
+    // 快照中的连接使用本图的节点ID，另一端的节点可能已被删除
+    for (const auto& connection : subgraph.connections) {
+        if (!audioGraph.addConnection(connection, deferredUpdate)) {
+            WSLOG_WARNING("GraphAudioProcessor", "警告：无法恢复连接 " << connection.source.nodeID.uid
+                    << " -> " << connection.destination.nodeID.uid);
+        }
+    }
+
+    retainedNodes.clear();
+    notifyStateChange("被替换的节点已恢复");
+    return true;
+}
+
+bool GraphAudioProcessor::captureNodeSnapshot(const juce::AudioProcessorGraph::Node& node,
+                                              GraphSnapshot::NodeSnapshot& nodeSnapshot) const {
+    auto* instance = getHostedPluginInstance(node.getProcessor());
+    if (!instance) {
+        return false;
+    }
+
+    nodeSnapshot.nodeUID = node.nodeID.uid;
+    nodeSnapshot.name = instance->getName().toStdString();
+    nodeSnapshot.description = instance->getPluginDescription();
+    nodeSnapshot.bypassed = node.isBypassed();
+    if (auto* profiled = dynamic_cast<ProfiledPluginProcessor*>(node.getProcessor())) {
+        nodeSnapshot.sleepWhenSilent = profiled->isSleepWhenSilentEnabled();
+    }
+    instance->getStateInformation(nodeSnapshot.state);
+    return true;
+}
+
+juce::AudioProcessorGraph::Node::Ptr GraphAudioProcessor::addSnapshotNode(std::unique_ptr<juce::AudioPluginInstance> instance,
+                                                                          const GraphSnapshot::NodeSnapshot& nodeSnapshot) {
+    auto node = audioGraph.addNode(std::make_unique<ProfiledPluginProcessor>(std::move(instance),
+                                                                            nodeProfilingEnabled),
+                                   NodeID{nodeSnapshot.nodeUID}, deferredUpdate);
+    if (!node) {
+        return nullptr;
+    }
+    watchNodeLatency(node.get());
+
+    if (isGraphReady()) {
+        node->getProcessor()->prepareToPlay(currentConfig.sampleRate,
+                                           currentConfig.samplesPerBlock);
+    }
+    node->setBypassed(nodeSnapshot.bypassed);
+    if (auto* profiled = dynamic_cast<ProfiledPluginProcessor*>(node->getProcessor())) {
+        profiled->setSleepWhenSilent(nodeSnapshot.sleepWhenSilent);
+    }
+    return node;
+}
+
+//==============================================================================
+// 拓扑更新实现
+//==============================================================================
+
+void GraphAudioProcessor::beginTopologyChange() {
+    topologyChangeDepth.fetch_add(1);
+}
+
+void GraphAudioProcessor::endTopologyChange() {
+    const int depth = topologyChangeDepth.fetch_sub(1) - 1;
+    if (depth < 0) {
+        WSLOG_WARNING("GraphAudioProcessor", "警告：endTopologyChange 调用次数多于 beginTopologyChange");
+        topologyChangeDepth.store(0);
+        return;
+    }
+
+    if (depth == 0 && topologyDirty.exchange(false)) {
+        commitTopology();
+    }
+}
+
+void GraphAudioProcessor::markTopologyChanged() {
+    topologyDirty.store(true);
+
+    // 不在批量修改中时立即提交
+    if (topologyChangeDepth.load() == 0 && topologyDirty.exchange(false)) {
+        commitTopology();
+    }
+}
+
+void GraphAudioProcessor::setTopologyFadeMs(double milliseconds) {
+    topologyFadeMs.store(juce::jlimit(0.0, 100.0, milliseconds));
+    updateTopologyFadeLength();
+}
+
+void GraphAudioProcessor::setParallelProcessingEnabled(bool enabled, int numWorkers) {
+    parallelScheduler.setNumWorkers(numWorkers);
+    parallelScheduler.setEnabled(enabled);
+
+    if (isGraphReady()) {
+        parallelScheduler.prepare(currentConfig.sampleRate, currentConfig.samplesPerBlock);
+        rebuildParallelPlan();
+    }
+}
+
+void GraphAudioProcessor::rebuildParallelPlan() {
+    if (!parallelScheduler.isEnabled()) {
+        return;
+    }
+
+    // 其他线程上的 rebuild() 是异步的，节点可能还没准备好，交给串行处理
+    if (!juce::MessageManager::existsAndIsCurrentThread() || !isGraphReady()) {
+        parallelScheduler.clearPlan();
+        return;
+    }
+
+    std::lock_guard<RealtimeCheckedMutex> lock(latencyMutex);
+    parallelScheduler.rebuildPlan(audioGraph, { audioInputNodeID, audioOutputNodeID,
+                                                midiInputNodeID, midiOutputNodeID },
+                                  latencyModel);
+}
+
+//==============================================================================
+// 延迟补偿实现
+//==============================================================================
+
+void GraphAudioProcessor::updateLatencyModel() {
+    int graphLatency = 0;
+    {
+        std::lock_guard<RealtimeCheckedMutex> lock(latencyMutex);
+        latencyModel.rebuild(audioGraph, audioOutputNodeID);
+        graphLatency = latencyModel.getGraphLatencySamples();
+    }
+
+    if (graphLatency != getLatencySamples()) {
+        WSLOG_INFO("GraphAudioProcessor", "图延迟: " << graphLatency << " samples");
+        setLatencySamples(graphLatency);
+    }
+}
+
+void GraphAudioProcessor::watchNodeLatency(juce::AudioProcessorGraph::Node* node) {
+    if (auto* profiled = node != nullptr ? dynamic_cast<ProfiledPluginProcessor*>(node->getProcessor()) : nullptr) {
+        profiled->addListener(this);
+    }
+}
+
+void GraphAudioProcessor::unwatchNodeLatency(juce::AudioProcessorGraph::Node* node) {
+    if (auto* profiled = node != nullptr ? dynamic_cast<ProfiledPluginProcessor*>(node->getProcessor()) : nullptr) {
+        profiled->removeListener(this);
+    }
+}
+
+void GraphAudioProcessor::audioProcessorChanged(juce::AudioProcessor*, const ChangeDetails& details) {
+    if (details.latencyChanged) {
+        triggerAsyncUpdate();
+    }
+}
+
+void GraphAudioProcessor::handleAsyncUpdate() {
+    bool changed = false;
+    int graphLatency = 0;
+    {
+        std::lock_guard<RealtimeCheckedMutex> lock(latencyMutex);
+        for (auto* node : audioGraph.getNodes()) {
+            if (node != nullptr && node->getProcessor() != nullptr) {
+                changed |= latencyModel.setNodeLatency(node->nodeID, node->getProcessor()->getLatencySamples());
+            }
+        }
+        graphLatency = latencyModel.getGraphLatencySamples();
+    }
+
+    if (!changed) {
+        return;
+    }
+
+    WSLOG_INFO("GraphAudioProcessor", "插件延迟变化，图延迟: " << graphLatency << " samples");
+    setLatencySamples(graphLatency);
+
+    // 渲染序列和并行计划的补偿延迟线都在重建时按新延迟分配
+    markTopologyChanged();
+}
+
+int GraphAudioProcessor::getGraphLatencySamples() const {
+    std::lock_guard<RealtimeCheckedMutex> lock(latencyMutex);
+    return latencyModel.getGraphLatencySamples();
+}
+
+GraphLatencyModel::NodeLatency GraphAudioProcessor::getNodeLatency(NodeID nodeID) const {
+    std::lock_guard<RealtimeCheckedMutex> lock(latencyMutex);
+    return latencyModel.getNodeLatency(nodeID);
+}
+
+GraphLatencyReport GraphAudioProcessor::getLatencyReport() const {
+    GraphLatencyReport report;
+    {
+        std::lock_guard<RealtimeCheckedMutex> lock(latencyMutex);
+        report.graphLatencySamples = latencyModel.getGraphLatencySamples();
+        report.compensationSamples = latencyModel.getTotalCompensationSamples();
+    }
+
+    if (auto* device = activeDevice.load()) {
+        report.inputDeviceLatencySamples = device->getInputLatencyInSamples();
+        report.outputDeviceLatencySamples = device->getOutputLatencyInSamples();
+    }
+
+    report.roundTripLatencySamples = report.inputDeviceLatencySamples
+                                   + report.graphLatencySamples
+                                   + report.outputDeviceLatencySamples;
+    report.sampleRate = currentConfig.sampleRate;
+    return report;
+}
+
+void GraphAudioProcessor::updateTopologyFadeLength() {
+    const double sampleRate = currentConfig.sampleRate > 0.0 ? currentConfig.sampleRate
+                                                             : Constants::DEFAULT_SAMPLE_RATE;
+    topologyFadeSamples.store(juce::roundToInt(topologyFadeMs.load() * sampleRate / 1000.0));
+}
+
+void GraphAudioProcessor::commitTopology() {
+    std::lock_guard<std::mutex> lock(topologyCommitMutex);
+
+    // 只有设备正在回调且能在本线程同步重建时才做淡入淡出，
+    // 其他线程调用 rebuild() 会转为异步更新，无法确定切换时机
+    const bool shouldFade = isGraphReady()
+                         && activeDevice.load() != nullptr
+                         && !isNonRealtime()
+                         && topologyFadeSamples.load() > 0
+                         && juce::MessageManager::existsAndIsCurrentThread();
+
+    if (!shouldFade) {
+        audioGraph.rebuild();
+        updateLatencyModel();
+        rebuildParallelPlan();
+        topologySwapCount.fetch_add(1);
+        return;
+    }
+
+    auto waitFor = [this](auto&& condition) {
+        const auto deadline = juce::Time::getMillisecondCounter()
+                            + static_cast<juce::uint32>(Constants::TOPOLOGY_SWAP_TIMEOUT_MS);
+        while (!condition()) {
+            // 设备停止后不会再有回调推进状态
+            if (activeDevice.load() == nullptr || juce::Time::getMillisecondCounter() > deadline) {
+                return false;
+            }
+            juce::Thread::sleep(1);
+        }
+        return true;
+    };
+
+    // 旧渲染序列淡出到静音，期间音频线程继续按旧拓扑处理
+    topologyFadeState.store(topologyFadeOut);
+    if (!waitFor([this] { return topologyFadeState.load() == topologyFadeSilent; })) {
+        WSLOG_WARNING("GraphAudioProcessor", "警告：等待淡出超时，直接切换拓扑");
+    }
+
+    // 在消息线程中构建并准备新渲染序列，音频线程在下一个块开始时切换
+    const double startTime = juce::Time::getMillisecondCounterHiRes();
+    audioGraph.rebuild();
+    updateLatencyModel();
+    rebuildParallelPlan();
+    const double rebuildTimeMs = juce::Time::getMillisecondCounterHiRes() - startTime;
+
+    // 等待至少一个完整的静音块在切换之后开始，确保淡入作用在新渲染序列上
+    const auto silentBlocks = topologySilentBlocks.load();
+    waitFor([this, silentBlocks] { return topologySilentBlocks.load() - silentBlocks >= 2; });
+
+    topologyFadeState.store(topologyFadeIn);
+    topologySwapCount.fetch_add(1);
+
+    WSLOG_INFO("GraphAudioProcessor", "拓扑已切换，重建耗时 " << juce::String(rebuildTimeMs, 2)
+            << " ms");
+}
+
+template <typename SampleType>
+void GraphAudioProcessor::applyTopologyFade(juce::AudioBuffer<SampleType>& buffer) noexcept {
+    const int state = topologyFadeState.load(std::memory_order_acquire);
+    if (state == topologyFadeIdle && lastTopologyFadeState == topologyFadeIdle) {
+        return;
+    }
+
+    const int fadeLength = std::max(1, topologyFadeSamples.load(std::memory_order_relaxed));
+    if (state != lastTopologyFadeState) {
+        // 淡入中途再次淡出（或反之）时从镜像位置开始，增益保持连续
+        const bool reversing = (state == topologyFadeOut && lastTopologyFadeState == topologyFadeIn)
+                            || (state == topologyFadeIn && lastTopologyFadeState == topologyFadeOut);
+        topologyFadePosition = reversing ? std::max(0, fadeLength - topologyFadePosition) : 0;
+        lastTopologyFadeState = state;
+    }
+
+    const int numSamples = buffer.getNumSamples();
+    const int numChannels = buffer.getNumChannels();
+
+    if (state == topologyFadeSilent) {
+        buffer.clear();
+        topologySilentBlocks.fetch_add(1, std::memory_order_release);
+        return;
+    }
+
+    if (state != topologyFadeOut && state != topologyFadeIn) {
+        return;
+    }
+
+    // 等功率曲线：淡出 cos，淡入 sin
+    const bool fadingOut = state == topologyFadeOut;
+    const int rampSamples = juce::jlimit(0, numSamples, fadeLength - topologyFadePosition);
+    for (int i = 0; i < rampSamples; ++i) {
+        const double phase = static_cast<double>(topologyFadePosition + i) / fadeLength
+                           * juce::MathConstants<double>::halfPi;
+        const auto gain = static_cast<SampleType>(fadingOut ? std::cos(phase) : std::sin(phase));
+        for (int ch = 0; ch < numChannels; ++ch) {
+            buffer.getWritePointer(ch)[i] *= gain;
+        }
+    }
+    topologyFadePosition += rampSamples;
+
+    if (topologyFadePosition < fadeLength) {
+        return;
+    }
+
+    int expected = state;
+    if (fadingOut) {
+        // 淡出结束后的剩余样本保持静音
+        for (int ch = 0; ch < numChannels; ++ch) {
+            juce::FloatVectorOperations::clear(buffer.getWritePointer(ch) + rampSamples, numSamples - rampSamples);
+        }
+        topologyFadeState.compare_exchange_strong(expected, topologyFadeSilent);
+    } else {
+        topologyFadeState.compare_exchange_strong(expected, topologyFadeIdle);
+    }
+}
+
 //==============================================================================
 // 性能监控实现
 //==============================================================================
 
 GraphPerformanceStats GraphAudioProcessor::getPerformanceStats() const {
-    std::lock_guard<std::mutex> lock(statsMutex);
-    return performanceStats;
+    GraphPerformanceStats stats;
+    bool shouldNotify = false;
+
+    {
+        std::lock_guard<RealtimeCheckedMutex> lock(statsMutex);
+        shouldNotify = drainPerformanceQueueLocked();
+        stats = performanceStats;
+    }
+
+    // 在锁外触发回调，回调中可以再次查询统计
+    if (shouldNotify && performanceCallback) {
+        performanceCallback(stats);
+    }
+
+    return stats;
+}
+
+void GraphAudioProcessor::drainPerformanceStats() {
+    getPerformanceStats();
 }
 
 void GraphAudioProcessor::resetPerformanceStats() {
-    std::lock_guard<std::mutex> lock(statsMutex);
+    std::lock_guard<RealtimeCheckedMutex> lock(statsMutex);
+    processingTimeQueue.clear();
     performanceStats.reset();
-    processingTimeHistory.clear();
+    overallLatencyHistogram.clear();
+    windowLatencyHistogram.clear();
+    windowElapsedSeconds = 0.0;
+}
+
+void GraphAudioProcessor::setPerformanceWindowSeconds(double seconds) {
+    std::lock_guard<RealtimeCheckedMutex> lock(statsMutex);
+    performanceStats.windowSeconds = std::max(0.0, seconds);
+}
+
+void GraphAudioProcessor::resetPerformanceWindow() {
+    std::lock_guard<RealtimeCheckedMutex> lock(statsMutex);
+    drainPerformanceQueueLocked();
+    finishPerformanceWindowLocked();
+}
+
+void GraphAudioProcessor::setNodeProfilingEnabled(bool enabled) {
+    if (nodeProfilingEnabled.exchange(enabled) != enabled) {
+        WSLOG_INFO("GraphAudioProcessor", "节点耗时统计已" << (enabled ? "启用" : "禁用"));
+    }
+}
+
+std::vector<NodeProfile> GraphAudioProcessor::getNodeProfiles() const {
+    std::vector<NodeProfile> profiles;
+
+    // 块时长按实际处理的平均块大小计算，设备块大小可能与配置不同
+    const double sampleRate = currentConfig.sampleRate > 0.0 ? currentConfig.sampleRate : Constants::DEFAULT_SAMPLE_RATE;
+
+    for (auto* node : audioGraph.getNodes()) {
+        auto* profiled = node != nullptr ? dynamic_cast<ProfiledPluginProcessor*>(node->getProcessor()) : nullptr;
+        if (!profiled) {
+            continue;
+        }
+
+        const auto profile = profiled->getProfile();
+
+        NodeProfile nodeProfile;
+        nodeProfile.nodeID = node->nodeID;
+        nodeProfile.name = profiled->getName().toStdString();
+        nodeProfile.averageTimeMs = profile.averageTimeMs;
+        nodeProfile.peakTimeMs = profile.peakTimeMs;
+        nodeProfile.lastTimeMs = profile.lastTimeMs;
+        nodeProfile.blocks = profile.blocks;
+
+        const double blockDurationMs = profile.averageBlockSamples * 1000.0 / sampleRate;
+        if (blockDurationMs > 0.0) {
+            nodeProfile.budgetPercent = profile.averageTimeMs / blockDurationMs * 100.0;
+            nodeProfile.peakBudgetPercent = profile.peakTimeMs / blockDurationMs * 100.0;
+        }
+
+        profiles.push_back(std::move(nodeProfile));
+    }
+
+    return profiles;
+}
+
+void GraphAudioProcessor::resetNodeProfiles() {
+    for (auto* node : audioGraph.getNodes()) {
+        if (auto* profiled = node != nullptr ? dynamic_cast<ProfiledPluginProcessor*>(node->getProcessor()) : nullptr) {
+            profiled->resetProfile();
+        }
+    }
 }
 
 void GraphAudioProcessor::setPerformanceCallback(PerformanceCallback callback) {
     performanceCallback = std::move(callback);
 }
 
+void GraphAudioProcessor::setNotificationDispatcher(NotificationDispatcher* dispatcher) {
+    auto* previous = notificationDispatcher.exchange(nullptr);
+    if (previous != nullptr && performanceSubscriptionID != 0) {
+        previous->unsubscribe(performanceSubscriptionID);
+        performanceSubscriptionID = 0;
+    }
+
+    if (dispatcher == nullptr) {
+        return;
+    }
+
+    notificationSourceID = dispatcher->allocateSourceID();
+    performanceSubscriptionID = dispatcher->subscribe(NotificationType::PerformanceChanged, notificationSourceID,
+        [this](const Notification&) { drainPerformanceStats(); });
+    notificationDispatcher.store(dispatcher);
+}
+
 //==============================================================================
 // 错误处理和状态
 //==============================================================================
@@ -984,7 +2081,7 @@ void GraphAudioProcessor::setStateCallback(GraphStateCallback callback) {
 }
 
 std::string GraphAudioProcessor::getLastError() const {
-    std::lock_guard<std::mutex> lock(errorMutex);
+    std::lock_guard<RealtimeCheckedMutex> lock(errorMutex);
     return lastError;
 }
 
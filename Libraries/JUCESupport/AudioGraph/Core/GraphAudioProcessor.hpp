@@ -13,7 +13,17 @@
 #include <vector>
 #include <atomic>
 #include <mutex>
+#include <array>
+#include <map>
 #include "AudioGraphTypes.hpp"
+#include "LockFreeRingBuffer.hpp"
+#include "LatencyHistogram.hpp"
+#include "ProfiledPluginProcessor.hpp"
+#include "ParallelGraphScheduler.hpp"
+#include "GraphLatencyModel.hpp"
+#include "RealtimeSafety.hpp"
+#include "NotificationDispatcher.hpp"
+#include "MidiInputCollector.hpp"
 
 namespace WindsynthVST::AudioGraph {
 
@@ -32,7 +42,10 @@ class PresetManager;
  * - 内置并行处理能力
  * - 高效的内存管理
  */
-class GraphAudioProcessor : public juce::AudioProcessor, public juce::AudioIODeviceCallback {
+class GraphAudioProcessor : public juce::AudioProcessor,
+                            public juce::AudioIODeviceCallback,
+                            private juce::AudioProcessorListener,
+                            private juce::AsyncUpdater {
 public:
     //==============================================================================
     // 构造函数和析构函数
@@ -91,6 +104,37 @@ public:
      * 设置音频传输源（用于音频文件播放）
      */
     void setTransportSource(juce::AudioTransportSource* source);
+
+    /**
+     * 当前块开始时的文件播放位置（采样，未播放时为-1），冻结播放节点在音频线程读取
+     */
+    const std::atomic<juce::int64>& getTimelinePosition() const noexcept { return timelinePosition; }
+
+    //==============================================================================
+    // MIDI输入支持
+    //==============================================================================
+
+    /**
+     * 设置MIDI输入收集器（设备回调中取出的事件经MIDI输入节点送入音频图）
+     * 收集器的生命周期必须长于设备回调，移除前应先停止音频设备
+     */
+    void setMidiInputCollector(MidiInputCollector* collector);
+
+    //==============================================================================
+    // 音频采集支持
+    //==============================================================================
+
+    /**
+     * 添加音频采集接收器（用于录音和电平监控）
+     * 接收器的生命周期必须长于设备回调，移除前应先停止音频设备
+     * @return 没有空闲槽位时返回false
+     */
+    bool addCaptureSink(AudioCaptureSink* sink);
+
+    /**
+     * 移除音频采集接收器
+     */
+    void removeCaptureSink(AudioCaptureSink* sink);
     
     double getTailLengthSeconds() const override;
     bool acceptsMidi() const override;
@@ -144,6 +188,12 @@ public:
      */
     bool removeNode(NodeID nodeID);
     
+    /**
+     * 从图中移除节点并返回节点引用（插件实例池用它回收插件实例）
+     * @return 失败时返回nullptr
+     */
+    juce::AudioProcessorGraph::Node::Ptr detachNode(NodeID nodeID);
+    
     /**
      * 获取所有节点信息
      */
@@ -159,6 +209,11 @@ public:
      */
     bool setNodeBypassed(NodeID nodeID, bool bypassed);
     
+    /**
+     * 设置插件节点的静音休眠（输入和输出静音超过尾音长度后跳过处理，默认关闭）
+     */
+    bool setNodeSleepWhenSilent(NodeID nodeID, bool sleepWhenSilent);
+    
     /**
      * 设置节点启用状态
      */
@@ -194,6 +249,182 @@ public:
      */
     std::vector<ConnectionInfo> getAllConnections() const;
     
+    //==============================================================================
+    // 图快照（用于克隆图）
+    //==============================================================================
+    
+    /**
+     * 捕获当前图的快照（插件描述、状态、旁路和连接）
+     * 应在消息线程或后台线程调用
+     */
+    GraphSnapshot createGraphSnapshot() const;
+    
+    /**
+     * 从快照重建图（替换当前所有插件节点和连接）
+     * @param snapshot 图快照
+     * @param pluginFactory 插件实例工厂
+     * @param error 失败时的错误信息
+     * @return 成功返回true
+     */
+    bool restoreGraphSnapshot(const GraphSnapshot& snapshot,
+                              const PluginInstanceFactory& pluginFactory,
+                              std::string& error);
+    
+    /**
+     * 图召回中的插件节点
+     */
+    struct RecallNode {
+        juce::uint32 sourceUID = 0;                             // 连接中引用的节点ID
+        std::unique_ptr<juce::AudioPluginInstance> instance;    // 新实例（状态已恢复）
+        NodeID existingNodeID;                                  // instance 为空时复用的现有节点
+        std::string name;
+        bool bypassed = false;
+    };
+    
+    /**
+     * 用准备好的插件实例替换图中所有插件节点和连接（一次拓扑切换）
+     * 没有被复用的现有插件节点会被移除
+     * @param nodes 新图的插件节点（新实例被取走）
+     * @param connections 新图的连接，节点ID按 sourceUID 和 sourceIONodes 映射
+     * @param sourceIONodes 连接中使用的I/O节点ID（音频输入、音频输出、MIDI输入、MIDI输出）
+     * @param removedNodes 输出被移除的节点
+     * @return sourceUID 到图中节点ID的映射（添加失败的节点不在其中）
+     */
+    std::map<juce::uint32, NodeID> recallGraph(std::vector<RecallNode>& nodes,
+                                               const std::vector<Connection>& connections,
+                                               const std::array<NodeID, 4>& sourceIONodes,
+                                               std::vector<juce::AudioProcessorGraph::Node::Ptr>& removedNodes);
+    
+    //==============================================================================
+    // 子图替换（用于冻结）
+    //==============================================================================
+    
+    /**
+     * 捕获部分插件节点的快照，连接包含所有至少一端在这些节点上的连接
+     * 非插件节点不会出现在快照中
+     */
+    GraphSnapshot createSubgraphSnapshot(const std::vector<NodeID>& nodeIDs) const;
+    
+    /**
+     * 用一个处理器替换若干插件节点（一次拓扑切换）
+     * 替换节点的输出通道按原通道号接到这些节点向外的音频连接上
+     * @param nodeIDs 被替换的节点
+     * @param replacement 替换处理器
+     * @param removedNodes 输出被移除的节点
+     * @return 替换节点ID，失败时返回0且图保持不变
+     */
+    NodeID replaceNodes(const std::vector<NodeID>& nodeIDs,
+                        std::unique_ptr<juce::AudioProcessor> replacement,
+                        std::vector<juce::AudioProcessorGraph::Node::Ptr>& removedNodes);
+    
+    /**
+     * 移除替换节点，按子图快照恢复原节点（保持原节点ID）和连接（一次拓扑切换）
+     * @param replacementNodeID 替换节点
+     * @param subgraph createSubgraphSnapshot 得到的快照
+     * @param retainedNodes 之前移除的节点：不再被渲染序列引用时复用其插件实例，否则用工厂重建
+     * @param pluginFactory 插件实例工厂
+     * @param error 失败时的错误信息（失败时图保持不变）
+     */
+    bool restoreReplacedNodes(NodeID replacementNodeID,
+                              const GraphSnapshot& subgraph,
+                              std::vector<juce::AudioProcessorGraph::Node::Ptr>& retainedNodes,
+                              const PluginInstanceFactory& pluginFactory,
+                              std::string& error);
+    
+    //==============================================================================
+    // 拓扑更新（批量提交和无缝切换）
+    //==============================================================================
+    
+    /**
+     * 拓扑批量修改作用域：作用域内的所有节点和连接修改在退出时一次性提交
+     */
+    class ScopedTopologyChange {
+    public:
+        explicit ScopedTopologyChange(GraphAudioProcessor& processor) : processor(processor) {
+            processor.beginTopologyChange();
+        }
+        ~ScopedTopologyChange() { processor.endTopologyChange(); }
+        
+    private:
+        GraphAudioProcessor& processor;
+        
+        JUCE_DECLARE_NON_COPYABLE(ScopedTopologyChange)
+    };
+    
+    /**
+     * 开始拓扑批量修改（可嵌套）
+     * 修改只记录在图中，渲染序列保持不变，音频继续按旧拓扑处理
+     */
+    void beginTopologyChange();
+    
+    /**
+     * 结束拓扑批量修改，最外层结束时提交：
+     * 旧拓扑淡出到静音 → 构建并切换到新渲染序列 → 新拓扑淡入
+     * 应在消息线程调用，其他线程提交时不做淡入淡出
+     */
+    void endTopologyChange();
+    
+    /**
+     * 是否处于拓扑批量修改中
+     */
+    bool isTopologyChangeActive() const { return topologyChangeDepth.load() > 0; }
+    
+    /**
+     * 通过 getGraph() 直接修改拓扑后调用（修改时应使用 UpdateKind::none）
+     */
+    void markTopologyChanged();
+    
+    /**
+     * 设置切换时淡出和淡入各自的长度（0表示直接切换）
+     */
+    void setTopologyFadeMs(double milliseconds);
+    double getTopologyFadeMs() const { return topologyFadeMs.load(); }
+    
+    /**
+     * 已提交的拓扑切换次数
+     */
+    uint64_t getTopologySwapCount() const { return topologySwapCount.load(); }
+    
+    //==============================================================================
+    // 并行处理
+    //==============================================================================
+    
+    /**
+     * 启用或禁用独立分支的并行处理（默认禁用）
+     * @param enabled 是否启用
+     * @param numWorkers 工作线程数量（0表示按CPU核心数自动选择）
+     */
+    void setParallelProcessingEnabled(bool enabled, int numWorkers = 0);
+    
+    /**
+     * 检查并行处理是否启用
+     */
+    bool isParallelProcessingEnabled() const { return parallelScheduler.isEnabled(); }
+    
+    /**
+     * 获取并行调度统计
+     */
+    ParallelGraphScheduler::Statistics getParallelProcessingStats() const { return parallelScheduler.getStatistics(); }
+    
+    //==============================================================================
+    // 延迟补偿
+    //==============================================================================
+    
+    /**
+     * 整个图的延迟（沿最长路径，采样数）
+     */
+    int getGraphLatencySamples() const;
+    
+    /**
+     * 获取节点在图中的延迟（插件延迟、补偿后的输入延迟和输出延迟）
+     */
+    GraphLatencyModel::NodeLatency getNodeLatency(NodeID nodeID) const;
+    
+    /**
+     * 获取延迟报告（包括设备延迟和往返延迟）
+     */
+    GraphLatencyReport getLatencyReport() const;
+    
     //==============================================================================
     // 音频I/O管理
     //==============================================================================
@@ -224,18 +455,77 @@ public:
     
     /**
      * 获取性能统计信息
+     * 会先汇总音频线程写入统计队列的数据，不能在音频线程中调用
      */
     GraphPerformanceStats getPerformanceStats() const;
     
+    /**
+     * 获取最近一个音频块的实时统计
+     * 只能在音频线程中调用（例如采集接收器的回调中）
+     */
+    const RealtimeBlockStats& getRealtimeBlockStats() const noexcept { return realtimeBlockStats; }
+    
+    /**
+     * 获取音频设备回调的平滑负载（处理耗时 / 块时长，1.0 表示用满截止时间）
+     * 任意线程可调用，没有运行中的音频设备时返回0
+     */
+    float getRealtimeLoad() const noexcept {
+        return activeDevice.load(std::memory_order_relaxed) != nullptr
+            ? realtimeLoad.load(std::memory_order_relaxed)
+            : 0.0f;
+    }
+    
+    /**
+     * 汇总音频线程写入的处理时间样本
+     * 应由UI或后台线程定期调用，性能回调也在此处触发
+     */
+    void drainPerformanceStats();
+    
     /**
      * 重置性能统计
      */
     void resetPerformanceStats();
     
+    /**
+     * 设置百分位统计窗口长度（按音频时长计，窗口结束时结果转入 lastWindow）
+     */
+    void setPerformanceWindowSeconds(double seconds);
+    
+    /**
+     * 立即结束当前统计窗口并开始新窗口
+     */
+    void resetPerformanceWindow();
+
+    /**
+     * 启用或禁用每个插件节点的处理耗时统计（默认禁用，禁用时没有计时开销）
+     */
+    void setNodeProfilingEnabled(bool enabled);
+
+    /**
+     * 检查节点耗时统计是否启用
+     */
+    bool isNodeProfilingEnabled() const { return nodeProfilingEnabled.load(); }
+
+    /**
+     * 获取所有插件节点的处理耗时统计
+     */
+    std::vector<NodeProfile> getNodeProfiles() const;
+
+    /**
+     * 清零所有插件节点的处理耗时统计
+     */
+    void resetNodeProfiles();
+
     /**
      * 设置性能监控回调
      */
     void setPerformanceCallback(PerformanceCallback callback);
+
+    /**
+     * 设置通知分发器：音频线程每100块投递一次性能事件，分发线程汇总统计并触发性能回调
+     * 分发器必须比本对象存活更久，传入nullptr时取消
+     */
+    void setNotificationDispatcher(NotificationDispatcher* dispatcher);
     
     //==============================================================================
     // 错误处理和状态
@@ -269,6 +559,13 @@ private:
     // 核心音频图
     juce::AudioProcessorGraph audioGraph;
     
+    // 独立分支的并行调度（单精度处理路径）
+    ParallelGraphScheduler parallelScheduler;
+    
+    // 按路径计算的延迟模型（拓扑提交和插件延迟变化时更新）
+    GraphLatencyModel latencyModel;
+    mutable RealtimeCheckedMutex latencyMutex;
+    
     // 配置信息
     GraphConfig currentConfig;
     
@@ -281,26 +578,79 @@ private:
     // 状态管理
     std::atomic<bool> graphReady{false};
     std::atomic<bool> isConfigured{false};
-    mutable std::mutex configMutex;
-    
-    // 性能监控
-    mutable std::mutex statsMutex;
-    GraphPerformanceStats performanceStats;
-    std::vector<double> processingTimeHistory;
+    mutable RealtimeCheckedMutex configMutex;
+    
+    // 性能监控（音频线程只写入无锁队列，汇总在消费线程完成）
+    struct ProcessingTimeSample {
+        double processingTimeMs = 0.0;
+        int numSamples = 0;
+    };
+    
+    mutable RealtimeCheckedMutex statsMutex;
+    mutable GraphPerformanceStats performanceStats;
+    mutable LatencyHistogram overallLatencyHistogram;
+    mutable LatencyHistogram windowLatencyHistogram;
+    mutable double windowElapsedSeconds = 0.0;
+    mutable LockFreeRingBuffer<ProcessingTimeSample> processingTimeQueue{Constants::PERFORMANCE_STATS_QUEUE_SIZE};
     juce::Time lastProcessTime;
+    RealtimeBlockStats realtimeBlockStats;                      // 仅音频线程访问
+    std::atomic<juce::AudioIODevice*> activeDevice{nullptr};    // 用于读取设备xrun计数
+    std::atomic<float> realtimeLoad{0.0f};                      // 平滑负载，供后台任务让出CPU
+    std::atomic<bool> nodeProfilingEnabled{false};              // 由插件包装处理器读取
     
     // 回调函数
     GraphErrorCallback errorCallback;
     GraphStateCallback stateCallback;
     PerformanceCallback performanceCallback;
+
+    // 通知分发
+    std::atomic<NotificationDispatcher*> notificationDispatcher{nullptr};
+    NotificationDispatcher::SubscriptionID performanceSubscriptionID = 0;
+    uint32_t notificationSourceID = 0;
     
     // 错误信息
-    mutable std::mutex errorMutex;
+    mutable RealtimeCheckedMutex errorMutex;
     std::string lastError;
 
     // 音频文件播放
-    juce::AudioTransportSource* transportSource = nullptr;
+    std::atomic<juce::AudioTransportSource*> transportSource{nullptr};
     juce::AudioBuffer<float> transportBuffer;
+    std::atomic<juce::int64> timelinePosition{-1};
+
+    // MIDI输入
+    std::atomic<MidiInputCollector*> midiInputCollector{nullptr};
+
+    // 音频采集（固定槽位，音频线程无锁读取）
+    static constexpr int maxCaptureSinks = 4;
+    std::array<std::atomic<AudioCaptureSink*>, maxCaptureSinks> captureSinks{};
+    
+    // 预分配的音频线程缓冲区（在prepareToPlay中分配）
+    juce::AudioBuffer<float> scratchBuffer;
+    juce::MidiBuffer callbackMidiBuffer;
+    std::array<float*, Constants::MAX_AUDIO_CHANNELS> callbackChannelPointers{};
+    int preparedNumChannels = 0;
+    int preparedBlockSize = 0;
+    
+    // 拓扑切换：图修改使用 UpdateKind::none，提交时统一重建渲染序列
+    static constexpr auto deferredUpdate = juce::AudioProcessorGraph::UpdateKind::none;
+    
+    enum TopologyFadeState : int {
+        topologyFadeIdle = 0,
+        topologyFadeOut,        // 旧渲染序列淡出
+        topologyFadeSilent,     // 已静音，等待切换
+        topologyFadeIn          // 新渲染序列淡入
+    };
+    
+    std::atomic<int> topologyChangeDepth{0};
+    std::atomic<bool> topologyDirty{false};
+    std::atomic<int> topologyFadeState{topologyFadeIdle};
+    std::atomic<int> topologyFadeSamples{0};
+    std::atomic<double> topologyFadeMs{Constants::DEFAULT_TOPOLOGY_FADE_MS};
+    std::atomic<uint64_t> topologySwapCount{0};
+    std::atomic<uint32_t> topologySilentBlocks{0};
+    std::mutex topologyCommitMutex;
+    int topologyFadePosition = 0;               // 仅音频线程访问
+    int lastTopologyFadeState = topologyFadeIdle; // 仅音频线程访问
     
     //==============================================================================
     // 内部方法
@@ -332,9 +682,81 @@ private:
     void updateGraphChannelConfiguration(const GraphConfig& config);
     
     /**
-     * 更新性能统计
+     * 提交拓扑修改（最外层 endTopologyChange 时调用）
+     */
+    void commitTopology();
+    
+    /**
+     * 根据当前拓扑重建并行渲染计划
+     */
+    void rebuildParallelPlan();
+    
+    /**
+     * 根据当前拓扑重新计算延迟模型并更新本处理器报告的延迟
+     */
+    void updateLatencyModel();
+    
+    /**
+     * 记录插件节点的快照（非插件节点返回false）
+     */
+    bool captureNodeSnapshot(const juce::AudioProcessorGraph::Node& node,
+                             GraphSnapshot::NodeSnapshot& nodeSnapshot) const;
+    
+    /**
+     * 按节点快照添加插件节点（保持快照中的节点ID，需在拓扑批量修改中调用）
+     */
+    juce::AudioProcessorGraph::Node::Ptr addSnapshotNode(std::unique_ptr<juce::AudioPluginInstance> instance,
+                                                         const GraphSnapshot::NodeSnapshot& nodeSnapshot);
+    
+    /**
+     * 监听插件节点的延迟变化
+     */
+    void watchNodeLatency(juce::AudioProcessorGraph::Node* node);
+    void unwatchNodeLatency(juce::AudioProcessorGraph::Node* node);
+    
+    // AudioProcessorListener：插件延迟变化（可能在任意线程调用）
+    void audioProcessorParameterChanged(juce::AudioProcessor*, int, float) override {}
+    void audioProcessorChanged(juce::AudioProcessor* processor, const ChangeDetails& details) override;
+    
+    // AsyncUpdater：在消息线程增量更新延迟模型
+    void handleAsyncUpdate() override;
+    
+    /**
+     * 根据采样率更新淡入淡出长度
+     */
+    void updateTopologyFadeLength();
+    
+    /**
+     * 在音频线程中对输出应用切换淡入淡出
+     */
+    template <typename SampleType>
+    void applyTopologyFade(juce::AudioBuffer<SampleType>& buffer) noexcept;
+    
+    /**
+     * 预分配音频线程使用的缓冲区
+     */
+    void allocateProcessingBuffers(int numChannels, int samplesPerBlock);
+    
+    /**
+     * 在音频线程中调整预分配缓冲区的大小（容量不足时记录实时违规）
+     */
+    void resizeProcessingBuffer(juce::AudioBuffer<float>& buffer, int numChannels, int numSamples) noexcept;
+    
+    /**
+     * 记录处理时间（音频线程，无锁）
+     */
+    void updatePerformanceStats(double processingTimeMs, int numSamples) noexcept;
+    
+    /**
+     * 汇总统计队列（调用者需持有statsMutex）
+     * @return 需要触发性能回调时返回true
+     */
+    bool drainPerformanceQueueLocked() const;
+    
+    /**
+     * 结束当前统计窗口（调用者需持有statsMutex）
      */
-    void updatePerformanceStats(double processingTimeMs);
+    void finishPerformanceWindowLocked() const;
     
     /**
      * 处理错误
@@ -0,0 +1,196 @@
+//
+//  GraphLatencyModel.cpp
+//  WindsynthRecorder
+//
+//  Created by AI Assistant
+//  音频图延迟模型实现
+//
+
+#include "GraphLatencyModel.hpp"
+#include <algorithm>
+#include <queue>
+
+namespace WindsynthVST::AudioGraph {
+
+//==============================================================================
+// 计算
+//==============================================================================
+
+void GraphLatencyModel::rebuild(const juce::AudioProcessorGraph& graph, NodeID audioOutputNodeID) {
+    std::vector<ModelNode> unsortedNodes;
+    std::map<juce::uint32, int> unsortedIndices;
+
+    for (auto* node : graph.getNodes()) {
+        if (node == nullptr || node->getProcessor() == nullptr) {
+            continue;
+        }
+
+        ModelNode modelNode;
+        modelNode.nodeID = node->nodeID;
+        // 旁路节点由渲染序列按插件延迟补偿，延迟保持不变
+        modelNode.pluginLatency = node->getProcessor()->getLatencySamples();
+
+        unsortedIndices[node->nodeID.uid] = static_cast<int>(unsortedNodes.size());
+        unsortedNodes.push_back(std::move(modelNode));
+    }
+
+    for (const auto& connection : graph.getConnections()) {
+        if (connection.source.channelIndex == juce::AudioProcessorGraph::midiChannelIndex) {
+            continue;
+        }
+
+        auto source = unsortedIndices.find(connection.source.nodeID.uid);
+        auto destination = unsortedIndices.find(connection.destination.nodeID.uid);
+        if (source == unsortedIndices.end() || destination == unsortedIndices.end()) {
+            continue;
+        }
+
+        unsortedNodes[static_cast<size_t>(destination->second)].upstream.push_back(source->second);
+        unsortedNodes[static_cast<size_t>(source->second)].downstream.push_back(destination->second);
+    }
+
+    // 拓扑排序，下游节点总在上游节点之后
+    std::vector<int> inDegree(unsortedNodes.size());
+    for (auto& node : unsortedNodes) {
+        for (auto* links : { &node.upstream, &node.downstream }) {
+            std::sort(links->begin(), links->end());
+            links->erase(std::unique(links->begin(), links->end()), links->end());
+        }
+    }
+    for (size_t i = 0; i < unsortedNodes.size(); ++i) {
+        inDegree[i] = static_cast<int>(unsortedNodes[i].upstream.size());
+    }
+
+    std::queue<int> ready;
+    for (size_t i = 0; i < unsortedNodes.size(); ++i) {
+        if (inDegree[i] == 0) {
+            ready.push(static_cast<int>(i));
+        }
+    }
+
+    std::vector<int> order;
+    while (!ready.empty()) {
+        const int index = ready.front();
+        ready.pop();
+        order.push_back(index);
+
+        for (int downstream : unsortedNodes[static_cast<size_t>(index)].downstream) {
+            if (--inDegree[static_cast<size_t>(downstream)] == 0) {
+                ready.push(downstream);
+            }
+        }
+    }
+
+    // AudioProcessorGraph 不允许环路，这里只是防御
+    for (size_t i = 0; i < unsortedNodes.size(); ++i) {
+        if (inDegree[i] > 0) {
+            order.push_back(static_cast<int>(i));
+        }
+    }
+
+    std::vector<int> sortedPosition(unsortedNodes.size());
+    for (size_t position = 0; position < order.size(); ++position) {
+        sortedPosition[static_cast<size_t>(order[position])] = static_cast<int>(position);
+    }
+
+    nodes.clear();
+    nodeIndices.clear();
+    nodes.reserve(order.size());
+    for (int index : order) {
+        auto node = std::move(unsortedNodes[static_cast<size_t>(index)]);
+        for (auto* links : { &node.upstream, &node.downstream }) {
+            for (auto& link : *links) {
+                link = sortedPosition[static_cast<size_t>(link)];
+            }
+        }
+        nodeIndices[node.nodeID.uid] = static_cast<int>(nodes.size());
+        nodes.push_back(std::move(node));
+    }
+
+    auto output = nodeIndices.find(audioOutputNodeID.uid);
+    audioOutputIndex = output != nodeIndices.end() ? output->second : -1;
+
+    recalculateFrom(0);
+}
+
+bool GraphLatencyModel::setNodeLatency(NodeID nodeID, int latencySamples) {
+    auto it = nodeIndices.find(nodeID.uid);
+    if (it == nodeIndices.end()) {
+        return false;
+    }
+
+    auto& node = nodes[static_cast<size_t>(it->second)];
+    if (node.pluginLatency == latencySamples) {
+        return false;
+    }
+
+    node.pluginLatency = latencySamples;
+    return recalculateFrom(it->second) > 0;
+}
+
+int GraphLatencyModel::recalculateFrom(int firstIndex) {
+    // 按拓扑顺序推进：前面的节点不受影响
+    int numChanged = 0;
+
+    for (size_t i = static_cast<size_t>(std::max(0, firstIndex)); i < nodes.size(); ++i) {
+        auto& node = nodes[i];
+
+        int inputLatency = 0;
+        for (int upstream : node.upstream) {
+            inputLatency = std::max(inputLatency, nodes[static_cast<size_t>(upstream)].outputLatency);
+        }
+
+        const int outputLatency = inputLatency + node.pluginLatency;
+        if (inputLatency != node.inputLatency || outputLatency != node.outputLatency ||
+            static_cast<int>(i) == firstIndex) {
+            numChanged++;
+        }
+
+        node.inputLatency = inputLatency;
+        node.outputLatency = outputLatency;
+    }
+
+    graphLatencySamples = audioOutputIndex >= 0 ? nodes[static_cast<size_t>(audioOutputIndex)].inputLatency : 0;
+    return numChanged;
+}
+
+//==============================================================================
+// 查询
+//==============================================================================
+
+int GraphLatencyModel::getCompensationSamples(const Connection& connection) const {
+    if (connection.source.channelIndex == juce::AudioProcessorGraph::midiChannelIndex) {
+        return 0;
+    }
+
+    auto source = nodeIndices.find(connection.source.nodeID.uid);
+    auto destination = nodeIndices.find(connection.destination.nodeID.uid);
+    if (source == nodeIndices.end() || destination == nodeIndices.end()) {
+        return 0;
+    }
+
+    return std::max(0, nodes[static_cast<size_t>(destination->second)].inputLatency
+                     - nodes[static_cast<size_t>(source->second)].outputLatency);
+}
+
+int GraphLatencyModel::getTotalCompensationSamples() const {
+    int total = 0;
+    for (const auto& node : nodes) {
+        for (int upstream : node.upstream) {
+            total += node.inputLatency - nodes[static_cast<size_t>(upstream)].outputLatency;
+        }
+    }
+    return total;
+}
+
+GraphLatencyModel::NodeLatency GraphLatencyModel::getNodeLatency(NodeID nodeID) const {
+    auto it = nodeIndices.find(nodeID.uid);
+    if (it == nodeIndices.end()) {
+        return {};
+    }
+
+    const auto& node = nodes[static_cast<size_t>(it->second)];
+    return { node.pluginLatency, node.inputLatency, node.outputLatency };
+}
+
+} // namespace WindsynthVST::AudioGraph
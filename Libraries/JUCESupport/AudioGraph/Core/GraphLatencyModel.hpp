@@ -0,0 +1,89 @@
+//
+//  GraphLatencyModel.hpp
+//  WindsynthRecorder
+//
+//  Created by AI Assistant
+//  音频图延迟模型 - 按路径计算延迟和补偿量
+//
+
+#pragma once
+
+#include <JuceHeader.h>
+#include <map>
+#include <vector>
+#include "AudioGraphTypes.hpp"
+
+namespace WindsynthVST::AudioGraph {
+
+/**
+ * 音频图延迟模型
+ *
+ * 沿连接计算每个节点的输入延迟（所有上游路径中最长的那条）和输出延迟
+ * （输入延迟 + 插件自身延迟）。较短的路径在汇入节点时需要补偿差值：
+ *   补偿量(src → dst) = 输入延迟(dst) - 输出延迟(src)
+ * 整个图的延迟是音频输出节点的输入延迟，只包含实际到达输出的路径。
+ *
+ * 插件延迟变化时只重新计算下游节点。应在消息线程使用。
+ */
+class GraphLatencyModel {
+public:
+    struct NodeLatency {
+        int pluginLatency = 0;      // 插件自身报告的延迟
+        int inputLatency = 0;       // 补偿后输入端的延迟
+        int outputLatency = 0;      // 输出端的延迟
+    };
+
+    GraphLatencyModel() = default;
+
+    /**
+     * 根据图的当前拓扑重新计算
+     * @param graph 音频图
+     * @param audioOutputNodeID 音频输出节点
+     */
+    void rebuild(const juce::AudioProcessorGraph& graph, NodeID audioOutputNodeID);
+
+    /**
+     * 更新节点的插件延迟并重新计算下游节点
+     * @return 图延迟或任何补偿量发生变化时返回true
+     */
+    bool setNodeLatency(NodeID nodeID, int latencySamples);
+
+    /**
+     * 整个图的延迟（音频输入到音频输出，采样数）
+     */
+    int getGraphLatencySamples() const { return graphLatencySamples; }
+
+    /**
+     * 获取连接的补偿延迟（采样数），MIDI连接和未知连接返回0
+     */
+    int getCompensationSamples(const Connection& connection) const;
+
+    /**
+     * 所有补偿延迟之和（需要的延迟线总长度）
+     */
+    int getTotalCompensationSamples() const;
+
+    /**
+     * 获取节点延迟
+     */
+    NodeLatency getNodeLatency(NodeID nodeID) const;
+
+private:
+    struct ModelNode {
+        NodeID nodeID;
+        int pluginLatency = 0;
+        int inputLatency = 0;
+        int outputLatency = 0;
+        std::vector<int> upstream;      // 音频上游节点索引
+        std::vector<int> downstream;    // 音频下游节点索引
+    };
+
+    std::vector<ModelNode> nodes;                   // 按拓扑顺序
+    std::map<juce::uint32, int> nodeIndices;
+    int audioOutputIndex = -1;
+    int graphLatencySamples = 0;
+
+    int recalculateFrom(int firstIndex);
+};
+
+} // namespace WindsynthVST::AudioGraph
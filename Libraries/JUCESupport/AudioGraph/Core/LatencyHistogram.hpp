@@ -0,0 +1,97 @@
+//
+//  LatencyHistogram.hpp
+//  WindsynthRecorder
+//
+//  Created by AI Assistant
+//  固定桶对数直方图（用于回调耗时百分位统计）
+//
+
+#pragma once
+
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <algorithm>
+#include <limits>
+
+namespace WindsynthVST::AudioGraph {
+
+/**
+ * 回调耗时直方图
+ *
+ * 对数分桶（每倍频程 8 个桶，相对误差约 9%），覆盖 1µs 到约 1s，
+ * 存储空间固定，添加样本和查询百分位都不分配内存。
+ * 不是线程安全的，由统计汇总线程独占使用。
+ */
+class LatencyHistogram {
+public:
+    static constexpr int bucketsPerOctave = 8;
+    static constexpr int numOctaves = 20;
+    static constexpr double minValueMs = 0.001;
+    static constexpr int numBuckets = bucketsPerOctave * numOctaves + 2;   // 含下溢桶和溢出桶
+
+    /**
+     * 添加一个样本（毫秒）
+     */
+    void add(double valueMs) noexcept {
+        buckets[static_cast<size_t>(getBucketIndex(valueMs))]++;
+        count++;
+        maxValueMs = std::max(maxValueMs, valueMs);
+    }
+
+    /**
+     * 清空所有样本
+     */
+    void clear() noexcept {
+        buckets.fill(0);
+        count = 0;
+        maxValueMs = 0.0;
+    }
+
+    uint64_t getCount() const noexcept { return count; }
+    double getMax() const noexcept { return maxValueMs; }
+
+    /**
+     * 获取百分位（fraction 取 0-1，例如 0.99）
+     * 返回样本所在桶的上界，不超过实际最大值
+     */
+    double getPercentile(double fraction) const noexcept {
+        if (count == 0) {
+            return 0.0;
+        }
+
+        const auto target = static_cast<uint64_t>(
+            std::ceil(std::clamp(fraction, 0.0, 1.0) * static_cast<double>(count)));
+        uint64_t cumulative = 0;
+
+        for (int i = 0; i < numBuckets; ++i) {
+            cumulative += buckets[static_cast<size_t>(i)];
+            if (cumulative >= std::max<uint64_t>(1, target)) {
+                return std::min(getBucketUpperBound(i), maxValueMs);
+            }
+        }
+        return maxValueMs;
+    }
+
+private:
+    std::array<uint64_t, numBuckets> buckets{};
+    uint64_t count = 0;
+    double maxValueMs = 0.0;
+
+    static int getBucketIndex(double valueMs) noexcept {
+        if (!(valueMs > minValueMs)) {
+            return 0;
+        }
+        const int index = 1 + static_cast<int>(std::log2(valueMs / minValueMs) * bucketsPerOctave);
+        return std::min(index, numBuckets - 1);
+    }
+
+    static double getBucketUpperBound(int index) noexcept {
+        if (index >= numBuckets - 1) {
+            return std::numeric_limits<double>::max();
+        }
+        return minValueMs * std::exp2(static_cast<double>(index) / bucketsPerOctave);
+    }
+};
+
+} // namespace WindsynthVST::AudioGraph
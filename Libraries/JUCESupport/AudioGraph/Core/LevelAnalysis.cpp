@@ -0,0 +1,76 @@
+//
+//  LevelAnalysis.cpp
+//  WindsynthRecorder
+//
+//  Created by AI Assistant
+//  向量化电平分析实现
+//
+
+#include "LevelAnalysis.hpp"
+#include <cmath>
+#include <cstdint>
+#include <algorithm>
+
+namespace WindsynthVST::AudioGraph::LevelAnalysis {
+
+ChannelLevels analyseChannel(const float* data, int numSamples) noexcept {
+    ChannelLevels result;
+    if (data == nullptr || numSamples <= 0) {
+        return result;
+    }
+
+    float peak = 0.0f;
+    double sumOfSquares = 0.0;
+    int i = 0;
+
+#if JUCE_USE_SIMD
+    using Register = juce::dsp::SIMDRegister<float>;
+    constexpr int lanes = static_cast<int>(Register::SIMDNumElements);
+
+    // 标量处理到寄存器对齐位置
+    const auto misalignment = reinterpret_cast<std::uintptr_t>(data) % Register::SIMDRegisterSize;
+    const int head = misalignment == 0 ? 0
+        : std::min(numSamples, static_cast<int>((Register::SIMDRegisterSize - misalignment) / sizeof(float)));
+
+    for (; i < head; ++i) {
+        const float sample = data[i];
+        peak = std::max(peak, std::abs(sample));
+        sumOfSquares += static_cast<double>(sample) * sample;
+    }
+
+    // 对齐部分：两组寄存器交替累加，隐藏乘加延迟
+    if (numSamples - i >= 2 * lanes) {
+        auto peak0 = Register::expand(0.0f), peak1 = Register::expand(0.0f);
+        auto sum0 = Register::expand(0.0f), sum1 = Register::expand(0.0f);
+
+        for (; i + 2 * lanes <= numSamples; i += 2 * lanes) {
+            const auto x0 = Register::fromRawArray(data + i);
+            const auto x1 = Register::fromRawArray(data + i + lanes);
+            peak0 = Register::max(peak0, Register::abs(x0));
+            peak1 = Register::max(peak1, Register::abs(x1));
+            sum0 += x0 * x0;
+            sum1 += x1 * x1;
+        }
+
+        const auto peakVector = Register::max(peak0, peak1);
+        for (size_t lane = 0; lane < Register::SIMDNumElements; ++lane) {
+            peak = std::max(peak, peakVector.get(lane));
+        }
+        sumOfSquares += static_cast<double>((sum0 + sum1).sum());
+    }
+#endif
+
+    // 剩余采样
+    for (; i < numSamples; ++i) {
+        const float sample = data[i];
+        peak = std::max(peak, std::abs(sample));
+        sumOfSquares += static_cast<double>(sample) * sample;
+    }
+
+    result.peak = peak;
+    result.rms = static_cast<float>(std::sqrt(sumOfSquares / numSamples));
+    result.clipped = peak >= clipThreshold;
+    return result;
+}
+
+} // namespace WindsynthVST::AudioGraph::LevelAnalysis
@@ -0,0 +1,46 @@
+//
+//  LevelAnalysis.hpp
+//  WindsynthRecorder
+//
+//  Created by AI Assistant
+//  向量化电平分析（峰值/RMS/削波）
+//
+
+#pragma once
+
+#include <JuceHeader.h>
+
+namespace WindsynthVST::AudioGraph {
+
+/**
+ * 电平分析
+ *
+ * 单次遍历同时计算峰值、平方和与削波，使用 SIMD 寄存器（SSE/AVX/NEON）处理对齐部分，
+ * 首尾未对齐的采样按标量处理。不分配内存，可在音频线程中调用。
+ */
+namespace LevelAnalysis {
+
+    /**
+     * 削波门限（线性）
+     */
+    constexpr float clipThreshold = 0.99f;
+
+    /**
+     * 单通道电平
+     */
+    struct ChannelLevels {
+        float peak = 0.0f;      // 最大绝对值
+        float rms = 0.0f;       // 均方根
+        bool clipped = false;   // 峰值达到削波门限
+    };
+
+    /**
+     * 分析一个通道的采样
+     * @param data 采样数据（可为nullptr，视为静音）
+     * @param numSamples 采样数
+     */
+    ChannelLevels analyseChannel(const float* data, int numSamples) noexcept;
+
+} // namespace LevelAnalysis
+
+} // namespace WindsynthVST::AudioGraph
@@ -0,0 +1,139 @@
+//
+//  LockFreeMpscQueue.hpp
+//  WindsynthRecorder
+//
+//  Created by AI Assistant
+//  多生产者单消费者无锁有界队列
+//
+
+#pragma once
+
+#include <JuceHeader.h>
+#include <atomic>
+#include <memory>
+#include <limits>
+#include <cstddef>
+#include <cstdint>
+
+namespace WindsynthVST::AudioGraph {
+
+/**
+ * 多生产者单消费者（MPSC）无锁有界队列
+ *
+ * 每个槽带一个序号：等于写入位置时可写，等于写入位置 + 1 时可读。
+ * 生产者用 CAS 抢占写入位置，消费者读完后把序号推进一圈，槽重新变为可写：
+ * - 任意线程（包括音频线程、MIDI设备线程）调用 push，不分配内存、不加锁
+ * - 唯一的消费者线程调用 pop、consume 或 drain
+ * - 队列满时丢弃新元素并累加 droppedCount，绝不阻塞生产者
+ *
+ * @tparam T 元素类型（应可廉价复制，构造时按容量一次性分配）
+ * @tparam Capacity 容量，必须是2的幂
+ */
+template <typename T, size_t Capacity>
+class LockFreeMpscQueue {
+public:
+    static_assert(Capacity >= 2 && (Capacity & (Capacity - 1)) == 0, "队列容量必须是2的幂");
+
+    LockFreeMpscQueue()
+        : cells(new Cell[Capacity])
+    {
+        for (size_t i = 0; i < Capacity; ++i) {
+            cells[i].sequence.store(i, std::memory_order_relaxed);
+        }
+    }
+
+    /**
+     * 写入一个元素（任意线程，实时安全）
+     * @return 成功返回true，队列已满返回false
+     */
+    bool push(const T& item) noexcept {
+        size_t position = enqueuePosition.load(std::memory_order_relaxed);
+        Cell* cell = nullptr;
+
+        for (;;) {
+            cell = &cells[position & (Capacity - 1)];
+            const size_t sequence = cell->sequence.load(std::memory_order_acquire);
+            const auto difference = static_cast<std::ptrdiff_t>(sequence) - static_cast<std::ptrdiff_t>(position);
+
+            if (difference == 0) {
+                if (enqueuePosition.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) {
+                    break;
+                }
+            } else if (difference < 0) {
+                // 该槽还没被消费者读走，队列已满
+                droppedCount.fetch_add(1, std::memory_order_relaxed);
+                return false;
+            } else {
+                // 其他生产者已经抢占该位置
+                position = enqueuePosition.load(std::memory_order_relaxed);
+            }
+        }
+
+        cell->item = item;
+        cell->sequence.store(position + 1, std::memory_order_release);
+        return true;
+    }
+
+    /**
+     * 在槽内原地处理下一个元素，处理完后才释放该槽（仅消费者线程调用）
+     * @param consumer 以 const T& 调用的函数
+     * @return 队列为空返回false
+     */
+    template <typename Consumer>
+    bool consume(Consumer&& consumer) {
+        Cell& cell = cells[dequeuePosition & (Capacity - 1)];
+        if (cell.sequence.load(std::memory_order_acquire) != dequeuePosition + 1) {
+            return false;
+        }
+
+        consumer(static_cast<const T&>(cell.item));
+        cell.sequence.store(dequeuePosition + Capacity, std::memory_order_release);
+        ++dequeuePosition;
+        return true;
+    }
+
+    /**
+     * 读取一个元素（仅消费者线程调用）
+     * @return 成功返回true，队列为空返回false
+     */
+    bool pop(T& item) noexcept {
+        return consume([&item](const T& next) { item = next; });
+    }
+
+    /**
+     * 取出可用元素（仅消费者线程调用）
+     * @param consumer 对每个元素调用的函数（在槽内原地调用）
+     * @param maxItems 最多取出的元素数量
+     * @return 取出的元素数量
+     */
+    template <typename Consumer>
+    int drain(Consumer&& consumer, int maxItems = std::numeric_limits<int>::max()) {
+        int count = 0;
+        while (count < maxItems && consume(consumer)) {
+            ++count;
+        }
+        return count;
+    }
+
+    static constexpr int getCapacity() noexcept { return static_cast<int>(Capacity); }
+
+    /**
+     * 因队列已满而丢弃的元素数量
+     */
+    uint64_t getDroppedCount() const noexcept { return droppedCount.load(std::memory_order_relaxed); }
+
+private:
+    struct Cell {
+        std::atomic<size_t> sequence{0};
+        T item;
+    };
+
+    std::unique_ptr<Cell[]> cells;
+    alignas(64) std::atomic<size_t> enqueuePosition{0};
+    alignas(64) size_t dequeuePosition = 0;
+    std::atomic<uint64_t> droppedCount{0};
+
+    JUCE_DECLARE_NON_COPYABLE(LockFreeMpscQueue)
+};
+
+} // namespace WindsynthVST::AudioGraph
@@ -0,0 +1,113 @@
+//
+//  LockFreeRingBuffer.hpp
+//  WindsynthRecorder
+//
+//  Created by AI Assistant
+//  单生产者单消费者无锁环形缓冲区
+//
+
+#pragma once
+
+#include <JuceHeader.h>
+#include <vector>
+#include <atomic>
+#include <cstdint>
+
+namespace WindsynthVST::AudioGraph {
+
+/**
+ * 单生产者单消费者（SPSC）无锁环形缓冲区
+ *
+ * 基于 juce::AbstractFifo 实现，存储空间在构造时一次性分配：
+ * - 生产者（通常是音频线程）调用 push，不分配内存、不加锁
+ * - 消费者（UI/后台线程）调用 pop 或 drain 取出数据
+ * - 缓冲区满时丢弃新数据并累加 droppedCount，绝不阻塞生产者
+ */
+template <typename T>
+class LockFreeRingBuffer {
+public:
+    /**
+     * 构造函数
+     * @param capacity 可容纳的元素数量
+     */
+    explicit LockFreeRingBuffer(int capacity)
+        : fifo(capacity + 1), storage(static_cast<size_t>(capacity + 1))
+    {
+    }
+
+    /**
+     * 写入一个元素（仅生产者线程调用）
+     * @return 成功返回true，缓冲区已满返回false
+     */
+    bool push(const T& item) noexcept {
+        const auto scope = fifo.write(1);
+        if (scope.blockSize1 > 0) {
+            storage[static_cast<size_t>(scope.startIndex1)] = item;
+            return true;
+        }
+        if (scope.blockSize2 > 0) {
+            storage[static_cast<size_t>(scope.startIndex2)] = item;
+            return true;
+        }
+
+        droppedCount.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+
+    /**
+     * 读取一个元素（仅消费者线程调用）
+     * @return 成功返回true，缓冲区为空返回false
+     */
+    bool pop(T& item) noexcept {
+        const auto scope = fifo.read(1);
+        if (scope.blockSize1 > 0) {
+            item = storage[static_cast<size_t>(scope.startIndex1)];
+            return true;
+        }
+        if (scope.blockSize2 > 0) {
+            item = storage[static_cast<size_t>(scope.startIndex2)];
+            return true;
+        }
+        return false;
+    }
+
+    /**
+     * 取出所有可用元素（仅消费者线程调用）
+     * @param consumer 对每个元素调用的函数
+     * @return 取出的元素数量
+     */
+    template <typename Consumer>
+    int drain(Consumer&& consumer) {
+        int count = 0;
+        T item;
+        while (pop(item)) {
+            consumer(item);
+            ++count;
+        }
+        return count;
+    }
+
+    /**
+     * 丢弃所有未读元素（仅消费者线程调用）
+     */
+    void clear() noexcept {
+        fifo.read(fifo.getNumReady());
+    }
+
+    int getNumReady() const noexcept { return fifo.getNumReady(); }
+    int getCapacity() const noexcept { return fifo.getTotalSize() - 1; }
+
+    /**
+     * 因缓冲区已满而丢弃的元素数量
+     */
+    uint64_t getDroppedCount() const noexcept { return droppedCount.load(std::memory_order_relaxed); }
+
+private:
+    juce::AbstractFifo fifo;
+    std::vector<T> storage;
+    std::atomic<uint64_t> droppedCount{0};
+
+    JUCE_DECLARE_NON_COPYABLE(LockFreeRingBuffer)
+};
+
+} // namespace WindsynthVST::AudioGraph
@@ -0,0 +1,180 @@
+//
+//  Logger.cpp
+//  WindsynthRecorder
+//
+//  Created by AI Assistant
+//  异步日志实现
+//
+
+#include "Logger.hpp"
+#include <iostream>
+
+namespace WindsynthVST::AudioGraph {
+
+//==============================================================================
+// 构造函数和析构函数
+//==============================================================================
+
+Logger& Logger::getInstance() {
+    static Logger instance;
+    return instance;
+}
+
+Logger::Logger()
+    : juce::Thread("WindsynthLogger")
+{
+    startThread(juce::Thread::Priority::low);
+}
+
+Logger::~Logger() {
+    signalThreadShouldExit();
+    wakeEvent.signal();
+    stopThread(2000);
+
+    // 输出线程退出后剩余的记录
+    drainQueue();
+}
+
+//==============================================================================
+// 级别
+//==============================================================================
+
+bool Logger::setCategoryLevel(const char* tag, LogLevel level) {
+    const uint64_t hash = hashTag(tag);
+
+    for (auto& category : categoryLevels) {
+        if (category.tagHash.load(std::memory_order_acquire) == hash) {
+            category.level.store(static_cast<uint8_t>(level), std::memory_order_release);
+            return true;
+        }
+
+        // 占用第一个空槽（槽按顺序占用，查找时遇到空槽即可停止）
+        uint64_t expected = 0;
+        if (category.tagHash.compare_exchange_strong(expected, hash, std::memory_order_acq_rel)) {
+            category.level.store(static_cast<uint8_t>(level), std::memory_order_release);
+            numCategoryLevels.fetch_add(1, std::memory_order_release);
+            return true;
+        }
+        if (expected == hash) {
+            category.level.store(static_cast<uint8_t>(level), std::memory_order_release);
+            return true;
+        }
+    }
+
+    return false;
+}
+
+void Logger::clearCategoryLevels() {
+    numCategoryLevels.store(0, std::memory_order_release);
+    for (auto& category : categoryLevels) {
+        category.tagHash.store(0, std::memory_order_release);
+    }
+}
+
+bool Logger::shouldLog(LogLevel level, const char* tag) const noexcept {
+    // 没有标签级别时只比较全局级别，不计算哈希
+    if (numCategoryLevels.load(std::memory_order_acquire) > 0) {
+        const uint64_t hash = hashTag(tag);
+        for (const auto& category : categoryLevels) {
+            const uint64_t slotHash = category.tagHash.load(std::memory_order_acquire);
+            if (slotHash == 0) {
+                break;
+            }
+            if (slotHash == hash) {
+                return static_cast<uint8_t>(level) >= category.level.load(std::memory_order_acquire);
+            }
+        }
+    }
+
+    return level >= minimumLevel.load(std::memory_order_relaxed);
+}
+
+uint64_t Logger::hashTag(const char* tag) noexcept {
+    // FNV-1a，0 保留给空槽
+    uint64_t hash = 0xcbf29ce484222325ull;
+    for (const char* c = tag; c != nullptr && *c != '\0'; ++c) {
+        hash ^= static_cast<uint8_t>(*c);
+        hash *= 0x100000001b3ull;
+    }
+    return hash != 0 ? hash : 1;
+}
+
+//==============================================================================
+// 写入
+//==============================================================================
+
+bool Logger::submit(const LogRecord& record, bool wakeWriter) noexcept {
+    if (!queue.push(record)) {
+        return false;
+    }
+    submittedCount.fetch_add(1, std::memory_order_release);
+
+    if (wakeWriter) {
+        wakeEvent.signal();
+    }
+    return true;
+}
+
+void Logger::flush(int timeoutMs) {
+    const uint64_t target = submittedCount.load(std::memory_order_acquire);
+    const auto deadline = juce::Time::getMillisecondCounter() + static_cast<juce::uint32>(juce::jmax(0, timeoutMs));
+
+    while (writtenCount.load(std::memory_order_acquire) < target) {
+        if (!isThreadRunning() || juce::Time::getMillisecondCounter() >= deadline) {
+            return;
+        }
+        wakeEvent.signal();
+        drainedEvent.wait(pollIntervalMs);
+    }
+}
+
+//==============================================================================
+// 输出线程
+//==============================================================================
+
+void Logger::run() {
+    while (!threadShouldExit()) {
+        wakeEvent.wait(pollIntervalMs);
+        drainQueue();
+        drainedEvent.signal();
+    }
+}
+
+int Logger::drainQueue() {
+    bool wroteErrors = false;
+
+    // 记录在队列槽内直接输出，不复制
+    const int numWritten = queue.drain([&wroteErrors](const LogRecord& record) {
+        const bool isError = record.level >= LogLevel::Warning;
+        auto& stream = isError ? std::cerr : std::cout;
+
+        stream << '[' << record.tag << "] ";
+        stream.write(record.text, record.textLength);
+        if (record.truncated) {
+            stream << "...";
+        }
+        stream << '\n';
+
+        wroteErrors = wroteErrors || isError;
+    });
+
+    const uint64_t dropped = queue.getDroppedCount();
+    if (dropped != reportedDropCount) {
+        std::cerr << "[Logger] 日志队列已满，丢弃 " << (dropped - reportedDropCount) << " 条日志\n";
+        reportedDropCount = dropped;
+        wroteErrors = true;
+    }
+
+    // 每批只刷新一次
+    if (numWritten > 0) {
+        std::cout.flush();
+        if (wroteErrors) {
+            std::cerr.flush();
+        }
+        writtenCount.fetch_add(static_cast<uint64_t>(numWritten), std::memory_order_release);
+    }
+
+    return numWritten;
+}
+
+} // namespace WindsynthVST::AudioGraph
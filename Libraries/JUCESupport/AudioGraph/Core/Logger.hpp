@@ -0,0 +1,411 @@
+//
+//  Logger.hpp
+//  WindsynthRecorder
+//
+//  Created by AI Assistant
+//  异步日志 - 调用线程只写入无锁队列，格式化输出在后台线程完成
+//
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "LockFreeMpscQueue.hpp"
+#include <atomic>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <type_traits>
+#include <cstdint>
+#include <cstring>
+#include <cmath>
+
+/**
+ * 编译期最低日志级别（0=Debug，1=Info，2=Warning，3=Error），低于该级别的日志语句不生成代码
+ */
+#ifndef WINDSYNTH_LOG_MIN_LEVEL
+ #if JUCE_DEBUG
+  #define WINDSYNTH_LOG_MIN_LEVEL 0
+ #else
+  #define WINDSYNTH_LOG_MIN_LEVEL 1
+ #endif
+#endif
+
+namespace WindsynthVST::AudioGraph {
+
+/**
+ * 日志级别
+ */
+enum class LogLevel {
+    Debug = 0,
+    Info,
+    Warning,
+    Error,
+    Off
+};
+
+/**
+ * 指定级别的日志是否编译进代码
+ */
+constexpr bool isLogLevelCompiledIn(LogLevel level) noexcept {
+    return static_cast<int>(level) >= WINDSYNTH_LOG_MIN_LEVEL;
+}
+
+/**
+ * 日志记录（定长，写入队列时不分配内存）
+ */
+struct LogRecord {
+    static constexpr size_t maxTagLength = 31;
+    static constexpr size_t maxTextLength = 463;
+
+    juce::int64 timeMs = 0;
+    LogLevel level = LogLevel::Info;
+    bool truncated = false;
+    uint16_t textLength = 0;
+    char tag[maxTagLength + 1] = {};
+    char text[maxTextLength + 1] = {};
+};
+
+/**
+ * 异步日志
+ *
+ * 任意线程（包括音频线程）都可以写日志：消息写入定长记录，放入多生产者单消费者的
+ * 无锁有界队列，队列满时丢弃并计数，从不阻塞。后台线程取出记录，加上 "[标签] " 前缀
+ * 输出到 std::cout（Warning 及以上输出到 std::cerr），每批只刷新一次。
+ *
+ * 标签就是子系统名称（通常是类名），可以单独设置每个标签的运行时级别。
+ * 使用 WSLOG_* 宏写日志；音频线程使用 WSLOG_RT_* 宏（不唤醒后台线程，只接受不分配内存的参数类型）。
+ */
+class Logger : private juce::Thread {
+public:
+    /**
+     * 获取全局日志实例（第一次调用时启动后台线程）
+     */
+    static Logger& getInstance();
+
+    ~Logger() override;
+
+    //==============================================================================
+    // 级别
+    //==============================================================================
+
+    /**
+     * 设置运行时最低级别（编译期级别之下的日志仍然不会输出）
+     */
+    void setMinimumLevel(LogLevel level) noexcept { minimumLevel.store(level, std::memory_order_relaxed); }
+    LogLevel getMinimumLevel() const noexcept { return minimumLevel.load(std::memory_order_relaxed); }
+
+    /**
+     * 设置单个标签（子系统）的最低级别，覆盖全局级别
+     * @return 标签表已满时返回false
+     */
+    bool setCategoryLevel(const char* tag, LogLevel level);
+
+    /**
+     * 清除所有标签级别
+     */
+    void clearCategoryLevels();
+
+    /**
+     * 检查指定级别和标签的日志是否需要输出（任意线程，实时安全）
+     */
+    bool shouldLog(LogLevel level, const char* tag) const noexcept;
+
+    //==============================================================================
+    // 写入
+    //==============================================================================
+
+    /**
+     * 提交一条记录（任意线程，实时安全）
+     * @param wakeWriter 是否立即唤醒后台线程，音频线程应传false（后台线程定时轮询）
+     * @return 队列已满时返回false
+     */
+    bool submit(const LogRecord& record, bool wakeWriter) noexcept;
+
+    /**
+     * 等待后台线程输出已提交的所有记录（非音频线程）
+     */
+    void flush(int timeoutMs = 1000);
+
+    /**
+     * 因队列已满而丢弃的记录数
+     */
+    uint64_t getDroppedCount() const noexcept { return queue.getDroppedCount(); }
+
+private:
+    Logger();
+
+    struct CategoryLevel {
+        std::atomic<uint64_t> tagHash{0};
+        std::atomic<uint8_t> level{static_cast<uint8_t>(LogLevel::Debug)};
+    };
+
+    static constexpr int maxCategories = 64;
+    static constexpr int pollIntervalMs = 20;
+
+    LockFreeMpscQueue<LogRecord, 1024> queue;
+
+    std::atomic<LogLevel> minimumLevel{LogLevel::Debug};
+    CategoryLevel categoryLevels[maxCategories];
+    std::atomic<int> numCategoryLevels{0};
+
+    std::atomic<uint64_t> submittedCount{0};
+    std::atomic<uint64_t> writtenCount{0};
+    uint64_t reportedDropCount = 0;
+
+    juce::WaitableEvent wakeEvent;
+    juce::WaitableEvent drainedEvent;
+
+    void run() override;
+    int drainQueue();
+
+    static uint64_t hashTag(const char* tag) noexcept;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(Logger)
+};
+
+//==============================================================================
+// 消息构造
+//==============================================================================
+
+/**
+ * 把 << 连接的参数直接写入定长记录
+ * 实时模式只接受字符串、数字、布尔值、枚举和指针；其他类型通过 std::ostringstream 转换（会分配内存）
+ */
+template <bool realtime>
+class BasicLogStream {
+public:
+    BasicLogStream(LogLevel level, const char* tag) noexcept {
+        record.level = level;
+        record.timeMs = juce::Time::currentTimeMillis();
+        copyTag(tag);
+    }
+
+    template <typename T>
+    BasicLogStream& operator<<(const T& value) {
+        using Type = std::decay_t<T>;
+
+        if constexpr (std::is_same_v<Type, bool>) {
+            appendChar(value ? '1' : '0');
+        } else if constexpr (std::is_same_v<Type, char>) {
+            appendChar(value);
+        } else if constexpr (std::is_integral_v<Type>) {
+            if constexpr (std::is_signed_v<Type>) {
+                appendSigned(static_cast<long long>(value));
+            } else {
+                appendUnsigned(static_cast<unsigned long long>(value));
+            }
+        } else if constexpr (std::is_floating_point_v<Type>) {
+            appendFloat(static_cast<double>(value));
+        } else if constexpr (std::is_enum_v<Type>) {
+            appendSigned(static_cast<long long>(value));
+        } else if constexpr (std::is_convertible_v<const T&, const char*>) {
+            const char* text = value;
+            append(text != nullptr ? text : "(null)");
+        } else if constexpr (std::is_same_v<Type, std::string>) {
+            append(value.data(), value.size());
+        } else if constexpr (std::is_same_v<Type, juce::String>) {
+            append(value.toRawUTF8(), value.getNumBytesAsUTF8());
+        } else if constexpr (std::is_pointer_v<Type>) {
+            append("0x");
+            appendHex(reinterpret_cast<uintptr_t>(value));
+        } else {
+            static_assert(!realtime && sizeof(T) > 0, "实时日志不支持需要分配内存的参数类型");
+            std::ostringstream stream;
+            stream << value;
+            const auto text = stream.str();
+            append(text.data(), text.size());
+        }
+        return *this;
+    }
+
+    /**
+     * 提交到全局日志
+     */
+    void submit() noexcept {
+        record.text[record.textLength] = '\0';
+        Logger::getInstance().submit(record, !realtime);
+    }
+
+private:
+    LogRecord record;
+
+    void copyTag(const char* tag) noexcept {
+        size_t length = 0;
+        if (tag != nullptr) {
+            while (tag[length] != '\0' && length < LogRecord::maxTagLength) {
+                record.tag[length] = tag[length];
+                ++length;
+            }
+        }
+        record.tag[length] = '\0';
+    }
+
+    void append(const char* text) noexcept { append(text, std::strlen(text)); }
+
+    void append(const char* text, size_t length) noexcept {
+        const size_t available = LogRecord::maxTextLength - record.textLength;
+        if (length > available) {
+            length = available;
+            record.truncated = true;
+        }
+        std::memcpy(record.text + record.textLength, text, length);
+        record.textLength = static_cast<uint16_t>(record.textLength + length);
+    }
+
+    void appendChar(char c) noexcept { append(&c, 1); }
+
+    void appendUnsigned(unsigned long long value) noexcept {
+        char digits[24];
+        int count = 0;
+        do {
+            digits[count++] = static_cast<char>('0' + value % 10);
+            value /= 10;
+        } while (value != 0);
+
+        char buffer[24];
+        for (int i = 0; i < count; ++i) {
+            buffer[i] = digits[count - 1 - i];
+        }
+        append(buffer, static_cast<size_t>(count));
+    }
+
+    void appendSigned(long long value) noexcept {
+        if (value < 0) {
+            appendChar('-');
+            appendUnsigned(0ull - static_cast<unsigned long long>(value));
+        } else {
+            appendUnsigned(static_cast<unsigned long long>(value));
+        }
+    }
+
+    void appendHex(uintptr_t value) noexcept {
+        char buffer[2 * sizeof(uintptr_t)];
+        int count = 0;
+        do {
+            buffer[count++] = "0123456789abcdef"[value & 0xf];
+            value >>= 4;
+        } while (value != 0);
+
+        for (int i = count - 1; i >= 0; --i) {
+            appendChar(buffer[i]);
+        }
+    }
+
+    // 6位有效数字（与 %g 相同：1e-4 <= |x| < 1e6 用定点格式，否则用指数格式，去掉末尾的0），不依赖 locale
+    void appendFloat(double value) noexcept {
+        if (std::isnan(value)) {
+            append("nan");
+            return;
+        }
+        if (std::signbit(value)) {
+            appendChar('-');
+            value = -value;
+        }
+        if (std::isinf(value)) {
+            append("inf");
+            return;
+        }
+        if (value == 0.0) {
+            appendChar('0');
+            return;
+        }
+
+        // 有效数字 mantissa 在 [100000, 999999] 内，value ≈ mantissa * 10^(exponent - 5)
+        constexpr int significantDigits = 6;
+        constexpr long long minMantissa = 100000;
+        constexpr long long maxMantissa = 1000000;
+
+        int exponent = static_cast<int>(std::floor(std::log10(value)));
+        long long mantissa = 0;
+        for (int attempt = 0; attempt < 3; ++attempt) {
+            mantissa = std::llround(scaleByPowerOfTen(value, significantDigits - 1 - exponent));
+            if (mantissa >= maxMantissa) {
+                ++exponent;
+            } else if (mantissa < minMantissa) {
+                --exponent;
+            } else {
+                break;
+            }
+        }
+        mantissa = juce::jlimit(minMantissa, maxMantissa - 1, mantissa);
+
+        char digits[significantDigits];
+        for (int i = significantDigits - 1; i >= 0; --i) {
+            digits[i] = static_cast<char>('0' + mantissa % 10);
+            mantissa /= 10;
+        }
+
+        int numDigits = significantDigits;
+        while (numDigits > 1 && digits[numDigits - 1] == '0') {
+            --numDigits;
+        }
+
+        if (exponent < -4 || exponent >= significantDigits) {
+            appendChar(digits[0]);
+            if (numDigits > 1) {
+                appendChar('.');
+                append(digits + 1, static_cast<size_t>(numDigits - 1));
+            }
+            appendChar('e');
+            appendChar(exponent < 0 ? '-' : '+');
+            const int magnitude = exponent < 0 ? -exponent : exponent;
+            if (magnitude < 10) {
+                appendChar('0');
+            }
+            appendUnsigned(static_cast<unsigned long long>(magnitude));
+        } else if (exponent >= 0) {
+            const int numIntegerDigits = exponent + 1;
+            append(digits, static_cast<size_t>(numIntegerDigits));
+            if (numDigits > numIntegerDigits) {
+                appendChar('.');
+                append(digits + numIntegerDigits, static_cast<size_t>(numDigits - numIntegerDigits));
+            }
+        } else {
+            append("0.");
+            for (int i = exponent + 1; i < 0; ++i) {
+                appendChar('0');
+            }
+            append(digits, static_cast<size_t>(numDigits));
+        }
+    }
+
+    // 分两步缩放，避免次正规数需要的 10^n 溢出
+    static double scaleByPowerOfTen(double value, int power) noexcept {
+        if (power > 300) {
+            value *= 1.0e300;
+            power -= 300;
+        }
+        return value * std::pow(10.0, power);
+    }
+};
+
+using LogStream = BasicLogStream<false>;
+using RealtimeLogStream = BasicLogStream<true>;
+
+} // namespace WindsynthVST::AudioGraph
+
+//==============================================================================
+// 日志宏
+//==============================================================================
+
+#define WSLOG_WRITE(streamType, logLevel, tag, message)                                                          \
+    do {                                                                                                        \
+        if constexpr (::WindsynthVST::AudioGraph::isLogLevelCompiledIn(logLevel)) {                               \
+            if (::WindsynthVST::AudioGraph::Logger::getInstance().shouldLog(logLevel, tag)) {                   \
+                ::WindsynthVST::AudioGraph::streamType logStream_(logLevel, tag);                               \
+                logStream_ << message;                                                                          \
+                logStream_.submit();                                                                            \
+            }                                                                                                   \
+        }                                                                                                       \
+    } while (false)
+
+#define WSLOG_DEBUG(tag, message)    WSLOG_WRITE(LogStream, ::WindsynthVST::AudioGraph::LogLevel::Debug, tag, message)
+#define WSLOG_INFO(tag, message)     WSLOG_WRITE(LogStream, ::WindsynthVST::AudioGraph::LogLevel::Info, tag, message)
+#define WSLOG_WARNING(tag, message)  WSLOG_WRITE(LogStream, ::WindsynthVST::AudioGraph::LogLevel::Warning, tag, message)
+#define WSLOG_ERROR(tag, message)    WSLOG_WRITE(LogStream, ::WindsynthVST::AudioGraph::LogLevel::Error, tag, message)
+
+// 音频线程使用：不分配内存、不加锁、不唤醒后台线程
+#define WSLOG_RT_DEBUG(tag, message)    WSLOG_WRITE(RealtimeLogStream, ::WindsynthVST::AudioGraph::LogLevel::Debug, tag, message)
+#define WSLOG_RT_INFO(tag, message)     WSLOG_WRITE(RealtimeLogStream, ::WindsynthVST::AudioGraph::LogLevel::Info, tag, message)
+#define WSLOG_RT_WARNING(tag, message)  WSLOG_WRITE(RealtimeLogStream, ::WindsynthVST::AudioGraph::LogLevel::Warning, tag, message)
+#define WSLOG_RT_ERROR(tag, message)    WSLOG_WRITE(RealtimeLogStream, ::WindsynthVST::AudioGraph::LogLevel::Error, tag, message)
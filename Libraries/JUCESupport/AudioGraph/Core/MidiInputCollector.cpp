@@ -0,0 +1,93 @@
+//
+//  MidiInputCollector.cpp
+//  WindsynthRecorder
+//
+//  Created by AI Assistant
+//  MIDI输入收集器实现
+//
+
+#include "MidiInputCollector.hpp"
+#include <cstring>
+
+namespace WindsynthVST::AudioGraph {
+
+//==============================================================================
+// 构造函数和析构函数
+//==============================================================================
+
+MidiInputCollector::MidiInputCollector() = default;
+
+MidiInputCollector::~MidiInputCollector() = default;
+
+void MidiInputCollector::prepare(double newSampleRate) noexcept {
+    if (newSampleRate > 0.0) {
+        sampleRate.store(newSampleRate, std::memory_order_relaxed);
+    }
+    discardPending.store(true, std::memory_order_release);
+}
+
+//==============================================================================
+// 生产者
+//==============================================================================
+
+void MidiInputCollector::handleIncomingMidiMessage(juce::MidiInput*, const juce::MidiMessage& message) {
+    addMessage(message);
+}
+
+bool MidiInputCollector::addMessage(const juce::MidiMessage& message) noexcept {
+    const int size = message.getRawDataSize();
+
+    // 系统独占和主动感知不进入实时路径
+    if (size <= 0 || size > 3 || message.isSysEx() || message.isActiveSense()) {
+        ignoredCount.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+
+    // MIDI设备回调的时间戳与 getMillisecondCounterHiRes 同源（秒）
+    const double timestamp = message.getTimeStamp();
+    Event event;
+    event.timestampSeconds = timestamp > 0.0 ? timestamp : juce::Time::getMillisecondCounterHiRes() * 0.001;
+    event.size = static_cast<uint8_t>(size);
+    std::memcpy(event.data, message.getRawData(), static_cast<size_t>(size));
+
+    if (!eventQueue.push(event)) {
+        return false;
+    }
+    receivedCount.fetch_add(1, std::memory_order_relaxed);
+    return true;
+}
+
+//==============================================================================
+// 消费者（音频线程）
+//==============================================================================
+
+int MidiInputCollector::removeNextBlockOfMessages(juce::MidiBuffer& destination, int numSamples) noexcept {
+    if (numSamples <= 0) {
+        return 0;
+    }
+
+    // 采样率变化或设备重启后，之前积压的事件已经失去时间意义
+    const bool discard = discardPending.exchange(false, std::memory_order_acquire);
+
+    const double rate = sampleRate.load(std::memory_order_relaxed);
+    const double now = juce::Time::getMillisecondCounterHiRes() * 0.001;
+    const double blockStart = now - static_cast<double>(numSamples) / rate;
+
+    int numEvents = 0;
+    Event event;
+    while ((discard || numEvents < maxEventsPerBlock) && eventQueue.pop(event)) {
+        if (discard) {
+            continue;
+        }
+
+        // 上一个块时长内到达的事件保持相对间隔，更早的事件放在块首
+        const int sampleOffset = juce::jlimit(0, numSamples - 1,
+                                              juce::roundToInt((event.timestampSeconds - blockStart) * rate));
+        destination.addEvent(event.data, static_cast<int>(event.size), sampleOffset);
+        ++numEvents;
+    }
+
+    return numEvents;
+}
+
+} // namespace WindsynthVST::AudioGraph
@@ -0,0 +1,84 @@
+//
+//  MidiInputCollector.hpp
+//  WindsynthRecorder
+//
+//  Created by AI Assistant
+//  MIDI输入收集器 - 设备回调写入无锁队列，音频线程按采样偏移取出
+//
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "LockFreeMpscQueue.hpp"
+#include <atomic>
+#include <cstdint>
+
+namespace WindsynthVST::AudioGraph {
+
+/**
+ * MIDI输入收集器
+ *
+ * MIDI设备回调（可能来自多个设备线程）把短消息连同到达时间写入多生产者单消费者的
+ * 无锁有界队列，队列满时丢弃并计数，从不阻塞。音频线程每块取出一次：上一个块时长内
+ * 到达的事件按到达时间映射到当前块的采样偏移（固定一个块的延迟，事件间隔保持不变），
+ * 更早的事件放在块首。目标 MidiBuffer 应预先分配空间，取出过程不分配内存。
+ *
+ * 只收集不超过3字节的通道消息（音符、CC、弯音等），系统独占消息被忽略。
+ */
+class MidiInputCollector : public juce::MidiInputCallback {
+public:
+    MidiInputCollector();
+    ~MidiInputCollector() override;
+
+    /**
+     * 设置采样率并丢弃尚未取出的事件（音频线程下一块生效）
+     */
+    void prepare(double sampleRate) noexcept;
+
+    /**
+     * 手动投递消息（任意线程，实时安全；时间戳为0时使用当前时间）
+     * @return 队列已满或消息过长时返回false
+     */
+    bool addMessage(const juce::MidiMessage& message) noexcept;
+
+    /**
+     * 取出事件并按采样偏移写入目标缓冲区（仅音频线程）
+     * @param destination 目标缓冲区（应预先 ensureSize）
+     * @param numSamples 当前块长度
+     * @return 写入的事件数
+     */
+    int removeNextBlockOfMessages(juce::MidiBuffer& destination, int numSamples) noexcept;
+
+    //==============================================================================
+    // 统计
+    //==============================================================================
+
+    uint64_t getReceivedCount() const noexcept { return receivedCount.load(std::memory_order_relaxed); }
+    uint64_t getDroppedCount() const noexcept { return eventQueue.getDroppedCount(); }
+    uint64_t getIgnoredCount() const noexcept { return ignoredCount.load(std::memory_order_relaxed); }
+
+private:
+    struct Event {
+        double timestampSeconds = 0.0;  // juce::Time::getMillisecondCounterHiRes() * 0.001
+        uint8_t size = 0;
+        uint8_t data[3] = {};
+    };
+
+    static constexpr size_t queueCapacity = 2048;
+    static constexpr int maxEventsPerBlock = 256;       // 单块最多取出的事件数（剩余的留到下一块）
+
+    // MidiInputCallback（MIDI设备线程）
+    void handleIncomingMidiMessage(juce::MidiInput* source, const juce::MidiMessage& message) override;
+
+    LockFreeMpscQueue<Event, queueCapacity> eventQueue;
+
+    std::atomic<double> sampleRate{44100.0};
+    std::atomic<bool> discardPending{false};
+
+    std::atomic<uint64_t> receivedCount{0};
+    std::atomic<uint64_t> ignoredCount{0};
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(MidiInputCollector)
+};
+
+} // namespace WindsynthVST::AudioGraph
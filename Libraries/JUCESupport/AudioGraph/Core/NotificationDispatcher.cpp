@@ -0,0 +1,164 @@
+//
+//  NotificationDispatcher.cpp
+//  WindsynthRecorder
+//
+//  Created by AI Assistant
+//  通知分发器实现
+//
+
+#include "NotificationDispatcher.hpp"
+#include "Logger.hpp"
+#include <algorithm>
+
+namespace WindsynthVST::AudioGraph {
+
+//==============================================================================
+// 构造函数和析构函数
+//==============================================================================
+
+NotificationDispatcher::NotificationDispatcher(int intervalMs)
+    : juce::Thread("Notification Dispatcher"),
+      intervalMs(juce::jmax(1, intervalMs))
+{
+    for (auto& flag : coalescing) {
+        flag.store(false, std::memory_order_relaxed);
+    }
+    setCoalescing(NotificationType::LevelsChanged, true);
+    setCoalescing(NotificationType::PerformanceChanged, true);
+    setCoalescing(NotificationType::LatencyChanged, true);
+
+    ordered.reserve(queueCapacity);
+    latest.reserve(64);
+
+    startThread(juce::Thread::Priority::low);
+}
+
+NotificationDispatcher::~NotificationDispatcher() {
+    stopThread(2000);
+
+    if (getDroppedCount() > 0) {
+        WSLOG_WARNING("NotificationDispatcher", "通知队列已满，共丢弃 " << getDroppedCount() << " 个事件");
+    }
+}
+
+//==============================================================================
+// 生产者
+//==============================================================================
+
+bool NotificationDispatcher::post(const Notification& notification) noexcept {
+    return queue.push(notification);
+}
+
+bool NotificationDispatcher::post(NotificationType type, uint32_t sourceID) noexcept {
+    Notification notification;
+    notification.type = type;
+    notification.sourceID = sourceID;
+    notification.timestampMs = juce::Time::getMillisecondCounterHiRes();
+    return post(notification);
+}
+
+//==============================================================================
+// 订阅者
+//==============================================================================
+
+NotificationDispatcher::SubscriptionID NotificationDispatcher::subscribe(NotificationType type,
+                                                                         uint32_t sourceID,
+                                                                         Handler handler) {
+    std::lock_guard<std::mutex> lock(subscriptionMutex);
+
+    Subscription subscription;
+    subscription.subscriptionID = nextSubscriptionID++;
+    subscription.type = type;
+    subscription.sourceID = sourceID;
+    subscription.handler = std::move(handler);
+    subscriptions.push_back(std::move(subscription));
+
+    return subscriptions.back().subscriptionID;
+}
+
+void NotificationDispatcher::unsubscribe(SubscriptionID subscriptionID) {
+    jassert(juce::Thread::getCurrentThreadId() != getThreadId());
+
+    std::lock_guard<std::mutex> lock(subscriptionMutex);
+    subscriptions.erase(std::remove_if(subscriptions.begin(), subscriptions.end(),
+                                       [subscriptionID](const Subscription& subscription) {
+                                           return subscription.subscriptionID == subscriptionID;
+                                       }),
+                        subscriptions.end());
+}
+
+void NotificationDispatcher::setCoalescing(NotificationType type, bool shouldCoalesce) noexcept {
+    const auto index = static_cast<size_t>(type);
+    if (index < numTypes) {
+        coalescing[index].store(shouldCoalesce, std::memory_order_relaxed);
+    }
+}
+
+//==============================================================================
+// 分发线程
+//==============================================================================
+
+void NotificationDispatcher::run() {
+    while (!threadShouldExit()) {
+        wait(intervalMs);
+        dispatchPending();
+    }
+}
+
+void NotificationDispatcher::dispatchPending() {
+    ordered.clear();
+    latest.clear();
+
+    Notification notification;
+    while (queue.pop(notification)) {
+        const auto index = static_cast<size_t>(notification.type);
+        if (index >= numTypes || !coalescing[index].load(std::memory_order_relaxed)) {
+            ordered.push_back(notification);
+            continue;
+        }
+
+        // 同类型、同生产者只保留最新一条
+        auto existing = std::find_if(latest.begin(), latest.end(), [&notification](const Notification& other) {
+            return other.type == notification.type && other.sourceID == notification.sourceID;
+        });
+        if (existing != latest.end()) {
+            *existing = notification;
+            coalescedCount.fetch_add(1, std::memory_order_relaxed);
+        } else {
+            latest.push_back(notification);
+        }
+    }
+
+    if (ordered.empty() && latest.empty()) {
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(subscriptionMutex);
+    for (const auto& notification : ordered) {
+        deliver(notification);
+    }
+    for (const auto& notification : latest) {
+        deliver(notification);
+    }
+}
+
+void NotificationDispatcher::deliver(const Notification& notification) {
+    for (const auto& subscription : subscriptions) {
+        if (subscription.type != notification.type) {
+            continue;
+        }
+        if (subscription.sourceID != 0 && subscription.sourceID != notification.sourceID) {
+            continue;
+        }
+
+        try {
+            subscription.handler(notification);
+        } catch (const std::exception& e) {
+            WSLOG_ERROR("NotificationDispatcher", "通知处理异常: " << e.what());
+        }
+    }
+
+    dispatchedCount.fetch_add(1, std::memory_order_relaxed);
+}
+
+} // namespace WindsynthVST::AudioGraph
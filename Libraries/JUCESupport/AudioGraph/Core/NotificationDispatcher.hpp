@@ -0,0 +1,156 @@
+//
+//  NotificationDispatcher.hpp
+//  WindsynthRecorder
+//
+//  Created by AI Assistant
+//  通知分发器 - 音频线程只投递事件，回调在分发线程中执行
+//
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "LockFreeMpscQueue.hpp"
+#include <atomic>
+#include <array>
+#include <memory>
+#include <mutex>
+#include <vector>
+#include <functional>
+#include <cstdint>
+
+namespace WindsynthVST::AudioGraph {
+
+/**
+ * 通知类型
+ */
+enum class NotificationType : uint8_t {
+    LevelsChanged = 0,      // 电平已更新（处理函数从生产者读取最新电平）
+    PerformanceChanged,     // 性能统计已更新
+    LatencyChanged,         // 图延迟发生变化
+    Custom,                 // 其他事件（按 data/values 自行解释）
+    NumTypes
+};
+
+/**
+ * 通知事件（POD，投递时不分配内存）
+ */
+struct Notification {
+    NotificationType type = NotificationType::Custom;
+    uint32_t sourceID = 0;          // 生产者ID（allocateSourceID 分配）
+    double timestampMs = 0.0;       // juce::Time::getMillisecondCounterHiRes()
+    int64_t data = 0;
+    float values[4] = {};
+};
+
+/**
+ * 通知分发器
+ *
+ * 生产者（包括音频线程）调用 post 把事件写入多生产者单消费者的无锁有界队列，
+ * 队列满时丢弃并计数，从不阻塞。分发线程定时取出事件：同类型、同生产者的可合并事件
+ * 只保留最新一条（电平、性能统计默认合并），再分发给订阅者。
+ * 订阅者回调因此不会在音频线程中执行，可以自由加锁、分配内存或调用到 Swift。
+ */
+class NotificationDispatcher : private juce::Thread {
+public:
+    using SubscriptionID = int;
+    using Handler = std::function<void(const Notification& notification)>;
+
+    /**
+     * 构造函数（启动分发线程）
+     * @param intervalMs 分发间隔
+     */
+    explicit NotificationDispatcher(int intervalMs = 15);
+
+    /**
+     * 析构函数（停止分发线程，未分发的事件被丢弃）
+     */
+    ~NotificationDispatcher() override;
+
+    //==============================================================================
+    // 生产者
+    //==============================================================================
+
+    /**
+     * 分配一个生产者ID（大于0）
+     */
+    uint32_t allocateSourceID() noexcept { return nextSourceID.fetch_add(1, std::memory_order_relaxed); }
+
+    /**
+     * 投递事件（任意线程，实时安全）
+     * @return 队列已满时返回false
+     */
+    bool post(const Notification& notification) noexcept;
+
+    /**
+     * 投递只带类型和生产者的事件（任意线程，实时安全）
+     */
+    bool post(NotificationType type, uint32_t sourceID) noexcept;
+
+    //==============================================================================
+    // 订阅者
+    //==============================================================================
+
+    /**
+     * 订阅事件（处理函数在分发线程中调用）
+     * @param type 事件类型
+     * @param sourceID 只接收该生产者的事件，0 表示全部
+     * @return 订阅ID
+     */
+    SubscriptionID subscribe(NotificationType type, uint32_t sourceID, Handler handler);
+
+    /**
+     * 取消订阅，返回后处理函数不会再被调用（不能在处理函数中调用）
+     */
+    void unsubscribe(SubscriptionID subscriptionID);
+
+    /**
+     * 设置事件类型是否合并（只保留每个生产者的最新一条）
+     */
+    void setCoalescing(NotificationType type, bool shouldCoalesce) noexcept;
+
+    //==============================================================================
+    // 统计
+    //==============================================================================
+
+    uint64_t getDroppedCount() const noexcept { return queue.getDroppedCount(); }
+    uint64_t getDispatchedCount() const noexcept { return dispatchedCount.load(std::memory_order_relaxed); }
+    uint64_t getCoalescedCount() const noexcept { return coalescedCount.load(std::memory_order_relaxed); }
+
+private:
+    struct Subscription {
+        SubscriptionID subscriptionID = 0;
+        NotificationType type = NotificationType::Custom;
+        uint32_t sourceID = 0;
+        Handler handler;
+    };
+
+    static constexpr size_t queueCapacity = 1024;
+    static constexpr size_t numTypes = static_cast<size_t>(NotificationType::NumTypes);
+
+    const int intervalMs;
+
+    LockFreeMpscQueue<Notification, queueCapacity> queue;
+
+    std::array<std::atomic<bool>, numTypes> coalescing;
+    std::atomic<uint32_t> nextSourceID{1};
+
+    std::atomic<uint64_t> dispatchedCount{0};
+    std::atomic<uint64_t> coalescedCount{0};
+
+    // 订阅表（分发期间持有，unsubscribe 借此等待正在执行的回调结束）
+    std::mutex subscriptionMutex;
+    std::vector<Subscription> subscriptions;
+    SubscriptionID nextSubscriptionID = 1;
+
+    // 分发线程使用的预分配缓冲
+    std::vector<Notification> ordered;
+    std::vector<Notification> latest;
+
+    void run() override;
+    void dispatchPending();
+    void deliver(const Notification& notification);
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(NotificationDispatcher)
+};
+
+} // namespace WindsynthVST::AudioGraph
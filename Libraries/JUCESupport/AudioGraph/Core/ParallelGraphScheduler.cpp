@@ -0,0 +1,786 @@
+//
+//  ParallelGraphScheduler.cpp
+//  WindsynthRecorder
+//
+//  Created by AI Assistant
+//  并行图调度器实现
+//
+
+#include "ParallelGraphScheduler.hpp"
+#include "RealtimeSafety.hpp"
+#include "Logger.hpp"
+#include <algorithm>
+#include <map>
+#include <queue>
+#include <thread>
+
+namespace WindsynthVST::AudioGraph {
+
+//==============================================================================
+// 渲染计划
+//==============================================================================
+
+namespace {
+
+/**
+ * 单个参与线程的任务队列：所有者从尾部取，其他线程从头部窃取
+ * 每个节点每块只入队一次，容量等于节点数即可，每块开始时重置
+ */
+struct TaskQueue {
+    std::vector<int> items;
+    int head = 0;
+    int tail = 0;
+    juce::SpinLock lock;
+
+    void reset() noexcept {
+        head = 0;
+        tail = 0;
+    }
+
+    void push(int task) noexcept {
+        const juce::SpinLock::ScopedLockType scopedLock(lock);
+        items[static_cast<size_t>(tail++)] = task;
+    }
+
+    bool popBack(int& task) noexcept {
+        const juce::SpinLock::ScopedLockType scopedLock(lock);
+        if (tail == head) {
+            return false;
+        }
+        task = items[static_cast<size_t>(--tail)];
+        return true;
+    }
+
+    bool popFront(int& task) noexcept {
+        const juce::SpinLock::ScopedLockType scopedLock(lock);
+        if (tail == head) {
+            return false;
+        }
+        task = items[static_cast<size_t>(head++)];
+        return true;
+    }
+};
+
+} // namespace
+
+struct ParallelGraphScheduler::RenderPlan {
+    enum class Kind {
+        Processor,
+        AudioInput,
+        AudioOutput,
+        MidiInput,
+        MidiOutput
+    };
+
+    struct AudioSource {
+        int task = 0;
+        int channel = 0;
+
+        // 延迟补偿（环形缓冲区长度等于补偿量，构建计划时分配）
+        int delaySamples = 0;
+        int delayPosition = 0;
+        std::vector<float> delayLine;
+
+        const float* read(const juce::AudioBuffer<float>& sourceBuffer, float* scratch, int numSamples) noexcept {
+            const float* input = sourceBuffer.getReadPointer(channel);
+            if (delaySamples == 0) {
+                return input;
+            }
+
+            for (int i = 0; i < numSamples; ++i) {
+                scratch[i] = delayLine[static_cast<size_t>(delayPosition)];
+                delayLine[static_cast<size_t>(delayPosition)] = input[i];
+                if (++delayPosition == delaySamples) {
+                    delayPosition = 0;
+                }
+            }
+            return scratch;
+        }
+    };
+
+    struct Task {
+        Kind kind = Kind::Processor;
+        juce::AudioProcessorGraph::Node::Ptr node;
+        juce::AudioProcessor* processor = nullptr;
+        int numChannels = 0;                                // 缓冲区通道数
+        int numInputChannels = 0;                           // 需要从上游汇总的通道数
+        juce::AudioBuffer<float> buffer;
+        juce::AudioBuffer<float> delayScratch;              // 有补偿延迟的输入使用
+        juce::MidiBuffer midi;
+        std::vector<std::vector<AudioSource>> channelSources;
+        std::vector<int> midiSources;
+        std::vector<int> dependents;
+        int numDependencies = 0;
+        int depth = 0;
+    };
+
+    std::vector<Task> tasks;
+    std::unique_ptr<std::atomic<int>[]> pendingDependencies;
+    std::unique_ptr<TaskQueue[]> queues;
+    std::vector<int> roots;
+
+    int audioOutputTask = -1;
+    int midiOutputTask = -1;
+    int numProcessorTasks = 0;
+    int maxParallelWidth = 0;
+    int blockSize = 0;
+    bool parallel = false;
+
+    // 当前块的状态（由音频线程在开始处理前设置）
+    std::atomic<int> remainingTasks{0};
+    int numParticipants = 1;
+    const juce::AudioBuffer<float>* blockInput = nullptr;
+    const juce::MidiBuffer* blockMidi = nullptr;
+    int blockNumSamples = 0;
+
+    void execute(int index) noexcept {
+        auto& task = tasks[static_cast<size_t>(index)];
+        const int numSamples = blockNumSamples;
+
+        if (task.kind == Kind::AudioInput) {
+            for (int ch = 0; ch < task.numChannels; ++ch) {
+                if (ch < blockInput->getNumChannels()) {
+                    task.buffer.copyFrom(ch, 0, *blockInput, ch, 0, numSamples);
+                } else {
+                    task.buffer.clear(ch, 0, numSamples);
+                }
+            }
+            return;
+        }
+
+        if (task.kind == Kind::MidiInput) {
+            task.midi.clear();
+            task.midi.addEvents(*blockMidi, 0, numSamples, 0);
+            return;
+        }
+
+        // 汇总上游节点的输出（上游节点都已完成），较短路径先经过补偿延迟线
+        float* scratch = task.delayScratch.getWritePointer(0);
+        for (int ch = 0; ch < task.numChannels; ++ch) {
+            auto* sources = ch < task.numInputChannels ? &task.channelSources[static_cast<size_t>(ch)] : nullptr;
+            if (sources == nullptr || sources->empty()) {
+                task.buffer.clear(ch, 0, numSamples);
+                continue;
+            }
+
+            float* destination = task.buffer.getWritePointer(ch);
+            for (size_t i = 0; i < sources->size(); ++i) {
+                auto& source = (*sources)[i];
+                const float* input = source.read(tasks[static_cast<size_t>(source.task)].buffer, scratch, numSamples);
+                if (i == 0) {
+                    juce::FloatVectorOperations::copy(destination, input, numSamples);
+                } else {
+                    juce::FloatVectorOperations::add(destination, input, numSamples);
+                }
+            }
+        }
+
+        task.midi.clear();
+        for (int source : task.midiSources) {
+            task.midi.addEvents(tasks[static_cast<size_t>(source)].midi, 0, numSamples, 0);
+        }
+
+        if (task.kind != Kind::Processor) {
+            return;
+        }
+
+        juce::AudioBuffer<float> view(task.buffer.getArrayOfWritePointers(), task.numChannels, numSamples);
+
+        const juce::ScopedLock callbackLock(task.processor->getCallbackLock());
+        if (task.processor->isSuspended()) {
+            view.clear();
+        } else if (task.node->isBypassed()) {
+            task.processor->processBlockBypassed(view, task.midi);
+        } else {
+            task.processor->processBlock(view, task.midi);
+        }
+    }
+};
+
+//==============================================================================
+// 工作线程
+//==============================================================================
+
+class ParallelGraphScheduler::Worker : public juce::Thread {
+public:
+    Worker(ParallelGraphScheduler& scheduler, int participantIndex)
+        : juce::Thread("Windsynth Graph Worker " + juce::String(participantIndex)),
+          owner(scheduler),
+          index(participantIndex) {}
+
+    ~Worker() override {
+        signalThreadShouldExit();
+        wake.signal();
+        stopThread(1000);
+    }
+
+    void wakeUp() noexcept {
+        wake.signal();
+    }
+
+    void run() override {
+        juce::WorkgroupToken token;
+        int joinedVersion = -1;
+
+        while (!threadShouldExit()) {
+            if (!wake.wait(100.0) || threadShouldExit()) {
+                continue;
+            }
+
+            owner.joinWorkgroup(token, joinedVersion);
+
+            RealtimeSafety::ScopedAudioCallback realtimeScope;
+            owner.runWorker(index);
+        }
+    }
+
+private:
+    ParallelGraphScheduler& owner;
+    const int index;
+    juce::WaitableEvent wake;
+};
+
+//==============================================================================
+// 构造函数和析构函数
+//==============================================================================
+
+ParallelGraphScheduler::ParallelGraphScheduler() = default;
+
+ParallelGraphScheduler::~ParallelGraphScheduler() {
+    stopTimer();
+
+    // 析构时不再有音频回调
+    {
+        std::lock_guard<std::mutex> lock(workerMutex);
+        workers.clear();
+    }
+
+    delete pendingPlan.exchange(nullptr);
+    delete retiredPlan.exchange(nullptr);
+    delete activePlan;
+}
+
+//==============================================================================
+// 配置
+//==============================================================================
+
+void ParallelGraphScheduler::setEnabled(bool shouldBeEnabled) {
+    if (enabled.exchange(shouldBeEnabled) == shouldBeEnabled) {
+        return;
+    }
+
+    WSLOG_INFO("ParallelGraphScheduler", "并行处理：" << (shouldBeEnabled ? "启用" : "禁用"));
+
+    if (shouldBeEnabled) {
+        restartWorkers(resolveNumWorkers());
+    } else {
+        clearPlan();
+        restartWorkers(0);
+    }
+}
+
+void ParallelGraphScheduler::setNumWorkers(int numWorkers) {
+    {
+        std::lock_guard<std::mutex> lock(workerMutex);
+        requestedWorkers = juce::jlimit(0, maxWorkers, numWorkers);
+    }
+
+    if (enabled.load()) {
+        restartWorkers(resolveNumWorkers());
+    }
+}
+
+int ParallelGraphScheduler::getNumWorkers() const {
+    std::lock_guard<std::mutex> lock(workerMutex);
+    return static_cast<int>(workers.size());
+}
+
+void ParallelGraphScheduler::setMinParallelNodes(int minNodes) {
+    minParallelNodes.store(std::max(2, minNodes));
+}
+
+void ParallelGraphScheduler::setAudioWorkgroup(const juce::AudioWorkgroup& workgroup) {
+    {
+        std::lock_guard<std::mutex> lock(workgroupMutex);
+        audioWorkgroup = workgroup;
+    }
+
+    // 工作线程在下次被唤醒时重新加入
+    workgroupVersion.fetch_add(1);
+}
+
+int ParallelGraphScheduler::resolveNumWorkers() const {
+    int requested = 0;
+    {
+        std::lock_guard<std::mutex> lock(workerMutex);
+        requested = requestedWorkers;
+    }
+
+    if (requested > 0) {
+        return requested;
+    }
+
+    // 留一个核心给设备线程（它本身也参与处理）
+    return juce::jlimit(1, maxWorkers, juce::SystemStats::getNumPhysicalCpus() - 1);
+}
+
+//==============================================================================
+// 渲染计划
+//==============================================================================
+
+void ParallelGraphScheduler::prepare(double sampleRate, int maximumBlockSize) {
+    bool restart = false;
+
+    {
+        std::lock_guard<std::mutex> lock(workerMutex);
+        restart = preparedSampleRate != sampleRate || preparedBlockSize != maximumBlockSize || workers.empty();
+        preparedSampleRate = sampleRate;
+        preparedBlockSize = std::max(1, maximumBlockSize);
+    }
+
+    // 工作线程的实时周期取决于块长度
+    if (restart && enabled.load()) {
+        restartWorkers(resolveNumWorkers());
+    }
+}
+
+void ParallelGraphScheduler::rebuildPlan(const juce::AudioProcessorGraph& graph, const IONodes& ioNodes,
+                                         const GraphLatencyModel& latencyModel) {
+    if (!enabled.load()) {
+        return;
+    }
+
+    publishPlan(buildPlan(graph, ioNodes, latencyModel));
+}
+
+void ParallelGraphScheduler::clearPlan() {
+    if (!acquirePlan(1000)) {
+        // 音频线程一直占用时交给定时器稍后切换
+        publishPlan(nullptr);
+        return;
+    }
+
+    delete pendingPlan.exchange(nullptr);
+    delete retiredPlan.exchange(nullptr);
+    delete activePlan;
+    activePlan = nullptr;
+    releasePlan();
+
+    planIsParallel.store(false);
+    planNumNodes.store(0);
+    planMaxParallelWidth.store(0);
+}
+
+std::unique_ptr<ParallelGraphScheduler::RenderPlan>
+ParallelGraphScheduler::buildPlan(const juce::AudioProcessorGraph& graph, const IONodes& ioNodes,
+                                  const GraphLatencyModel& latencyModel) const {
+    auto plan = std::make_unique<RenderPlan>();
+
+    int blockSize = 0;
+    {
+        std::lock_guard<std::mutex> lock(workerMutex);
+        blockSize = preparedBlockSize;
+    }
+    plan->blockSize = blockSize;
+
+    // 节点
+    std::map<juce::uint32, int> taskIndices;
+
+    for (auto* node : graph.getNodes()) {
+        if (node == nullptr || node->getProcessor() == nullptr) {
+            continue;
+        }
+
+        RenderPlan::Task task;
+        task.node = node;
+        task.processor = node->getProcessor();
+
+        if (node->nodeID == ioNodes.audioInput) {
+            task.kind = RenderPlan::Kind::AudioInput;
+            task.numChannels = task.processor->getTotalNumOutputChannels();
+        } else if (node->nodeID == ioNodes.audioOutput) {
+            task.kind = RenderPlan::Kind::AudioOutput;
+            task.numChannels = task.processor->getTotalNumInputChannels();
+            task.numInputChannels = task.numChannels;
+        } else if (node->nodeID == ioNodes.midiInput) {
+            task.kind = RenderPlan::Kind::MidiInput;
+        } else if (node->nodeID == ioNodes.midiOutput) {
+            task.kind = RenderPlan::Kind::MidiOutput;
+        } else {
+            task.kind = RenderPlan::Kind::Processor;
+            task.numInputChannels = task.processor->getTotalNumInputChannels();
+            task.numChannels = std::max(task.numInputChannels, task.processor->getTotalNumOutputChannels());
+            plan->numProcessorTasks++;
+        }
+
+        task.buffer.setSize(std::max(1, task.numChannels), blockSize);
+        task.delayScratch.setSize(1, blockSize);
+        task.midi.ensureSize(static_cast<size_t>(Constants::MIDI_BUFFER_RESERVE_BYTES));
+        task.channelSources.resize(static_cast<size_t>(task.numInputChannels));
+
+        taskIndices[node->nodeID.uid] = static_cast<int>(plan->tasks.size());
+        plan->tasks.push_back(std::move(task));
+    }
+
+    const int numTasks = static_cast<int>(plan->tasks.size());
+
+    // 连接和依赖
+    std::vector<std::vector<int>> upstream(static_cast<size_t>(numTasks));
+    for (const auto& connection : graph.getConnections()) {
+        auto source = taskIndices.find(connection.source.nodeID.uid);
+        auto destination = taskIndices.find(connection.destination.nodeID.uid);
+        if (source == taskIndices.end() || destination == taskIndices.end()) {
+            continue;
+        }
+
+        auto& sourceTask = plan->tasks[static_cast<size_t>(source->second)];
+        auto& destinationTask = plan->tasks[static_cast<size_t>(destination->second)];
+
+        if (connection.source.channelIndex == juce::AudioProcessorGraph::midiChannelIndex) {
+            destinationTask.midiSources.push_back(source->second);
+        } else if (connection.destination.channelIndex < destinationTask.numInputChannels &&
+                   connection.source.channelIndex < sourceTask.numChannels) {
+            RenderPlan::AudioSource audioSource;
+            audioSource.task = source->second;
+            audioSource.channel = connection.source.channelIndex;
+            audioSource.delaySamples = latencyModel.getCompensationSamples(connection);
+            audioSource.delayLine.assign(static_cast<size_t>(audioSource.delaySamples), 0.0f);
+
+            destinationTask.channelSources[static_cast<size_t>(connection.destination.channelIndex)]
+                .push_back(std::move(audioSource));
+        } else {
+            continue;
+        }
+
+        upstream[static_cast<size_t>(destination->second)].push_back(source->second);
+    }
+
+    for (int i = 0; i < numTasks; ++i) {
+        auto& sources = upstream[static_cast<size_t>(i)];
+        std::sort(sources.begin(), sources.end());
+        sources.erase(std::unique(sources.begin(), sources.end()), sources.end());
+
+        plan->tasks[static_cast<size_t>(i)].numDependencies = static_cast<int>(sources.size());
+        for (int source : sources) {
+            plan->tasks[static_cast<size_t>(source)].dependents.push_back(i);
+        }
+        if (sources.empty()) {
+            plan->roots.push_back(i);
+        }
+    }
+
+    // 拓扑排序计算深度（节点深度 = 最长上游路径）
+    std::vector<int> inDegree(static_cast<size_t>(numTasks));
+    std::queue<int> ready;
+    for (int i = 0; i < numTasks; ++i) {
+        inDegree[static_cast<size_t>(i)] = plan->tasks[static_cast<size_t>(i)].numDependencies;
+        if (inDegree[static_cast<size_t>(i)] == 0) {
+            ready.push(i);
+        }
+    }
+
+    int numSorted = 0;
+    std::map<int, int> processorsPerDepth;
+    while (!ready.empty()) {
+        const int index = ready.front();
+        ready.pop();
+        numSorted++;
+
+        const auto& task = plan->tasks[static_cast<size_t>(index)];
+        if (task.kind == RenderPlan::Kind::Processor) {
+            plan->maxParallelWidth = std::max(plan->maxParallelWidth, ++processorsPerDepth[task.depth]);
+        }
+
+        for (int dependent : task.dependents) {
+            auto& dependentTask = plan->tasks[static_cast<size_t>(dependent)];
+            dependentTask.depth = std::max(dependentTask.depth, task.depth + 1);
+            if (--inDegree[static_cast<size_t>(dependent)] == 0) {
+                ready.push(dependent);
+            }
+        }
+    }
+
+    for (int i = 0; i < numTasks; ++i) {
+        const auto kind = plan->tasks[static_cast<size_t>(i)].kind;
+        if (kind == RenderPlan::Kind::AudioOutput) plan->audioOutputTask = i;
+        if (kind == RenderPlan::Kind::MidiOutput) plan->midiOutputTask = i;
+    }
+
+    // 任务队列和依赖计数
+    plan->pendingDependencies = std::make_unique<std::atomic<int>[]>(static_cast<size_t>(std::max(1, numTasks)));
+    plan->queues = std::make_unique<TaskQueue[]>(static_cast<size_t>(maxWorkers + 1));
+    for (int q = 0; q <= maxWorkers; ++q) {
+        plan->queues[static_cast<size_t>(q)].items.resize(static_cast<size_t>(std::max(1, numTasks)));
+    }
+
+    const bool acyclic = numSorted == numTasks;
+    plan->parallel = acyclic
+                  && plan->numProcessorTasks >= minParallelNodes.load()
+                  && plan->maxParallelWidth >= 2;
+
+    WSLOG_INFO("ParallelGraphScheduler", "渲染计划：" << numTasks << " 个节点，最大并行宽度 "
+            << plan->maxParallelWidth << "，补偿延迟 " << latencyModel.getTotalCompensationSamples()
+            << " 采样，" << (plan->parallel ? "并行" : "串行"));
+
+    return plan;
+}
+
+void ParallelGraphScheduler::publishPlan(std::unique_ptr<RenderPlan> plan) {
+    planIsParallel.store(plan != nullptr && plan->parallel);
+    planNumNodes.store(plan != nullptr ? static_cast<int>(plan->tasks.size()) : 0);
+    planMaxParallelWidth.store(plan != nullptr ? plan->maxParallelWidth : 0);
+
+    // 替换还没被音频线程取走的计划
+    delete pendingPlan.exchange(plan != nullptr ? plan.release() : new RenderPlan());
+
+    collectRetiredPlans();
+    startTimer(50);
+}
+
+bool ParallelGraphScheduler::acquirePlan(int timeoutMs) {
+    const auto deadline = juce::Time::getMillisecondCounter() + static_cast<juce::uint32>(timeoutMs);
+
+    while (planInUse.exchange(true, std::memory_order_acquire)) {
+        if (juce::Time::getMillisecondCounter() > deadline) {
+            return false;
+        }
+        juce::Thread::sleep(1);
+    }
+    return true;
+}
+
+void ParallelGraphScheduler::releasePlan() {
+    planInUse.store(false, std::memory_order_release);
+}
+
+void ParallelGraphScheduler::collectRetiredPlans() {
+    delete retiredPlan.exchange(nullptr);
+
+    // 音频线程没有在处理时由消息线程完成切换（例如设备已停止）
+    if (pendingPlan.load() != nullptr && !planInUse.exchange(true, std::memory_order_acquire)) {
+        if (auto* next = pendingPlan.exchange(nullptr)) {
+            delete activePlan;
+            activePlan = next;
+        }
+        releasePlan();
+    }
+}
+
+void ParallelGraphScheduler::restartWorkers(int numWorkers) {
+    std::lock_guard<std::mutex> lock(workerMutex);
+
+    if (static_cast<int>(workers.size()) == numWorkers && numWorkers > 0) {
+        return;
+    }
+
+    // 持有计划锁时音频线程不会使用工作线程
+    if (!acquirePlan(1000)) {
+        WSLOG_WARNING("ParallelGraphScheduler", "警告：无法暂停音频线程，保留现有工作线程");
+        return;
+    }
+
+    workers.clear();
+
+    const double periodMs = preparedSampleRate > 0.0 ? preparedBlockSize * 1000.0 / preparedSampleRate : 10.0;
+    for (int i = 0; i < numWorkers; ++i) {
+        auto worker = std::make_unique<Worker>(*this, i + 1);
+        if (!worker->startRealtimeThread(juce::Thread::RealtimeOptions{}.withPeriodMs(periodMs))) {
+            worker->startThread(juce::Thread::Priority::highest);
+        }
+        workers.push_back(std::move(worker));
+    }
+
+    releasePlan();
+
+    WSLOG_INFO("ParallelGraphScheduler", "工作线程数量：" << numWorkers);
+}
+
+//==============================================================================
+// 音频线程
+//==============================================================================
+
+bool ParallelGraphScheduler::process(juce::AudioBuffer<float>& buffer, juce::MidiBuffer& midiMessages) noexcept {
+    if (!enabled.load(std::memory_order_relaxed)) {
+        return false;
+    }
+
+    if (planInUse.exchange(true, std::memory_order_acquire)) {
+        serialBlocks.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+
+    // 切换到新计划（上一个被替换的计划还没释放时暂时保留当前计划）
+    if (pendingPlan.load(std::memory_order_acquire) != nullptr &&
+        retiredPlan.load(std::memory_order_acquire) == nullptr) {
+        if (auto* next = pendingPlan.exchange(nullptr, std::memory_order_acq_rel)) {
+            retiredPlan.store(activePlan, std::memory_order_release);
+            activePlan = next;
+        }
+    }
+
+    auto* plan = activePlan;
+    const bool canRun = plan != nullptr
+                     && plan->parallel
+                     && !workers.empty()
+                     && buffer.getNumSamples() <= plan->blockSize;
+
+    if (canRun) {
+        runPlan(*plan, buffer, midiMessages);
+    }
+
+    releasePlan();
+
+    (canRun ? parallelBlocks : serialBlocks).fetch_add(1, std::memory_order_relaxed);
+    return canRun;
+}
+
+void ParallelGraphScheduler::runPlan(RenderPlan& plan, juce::AudioBuffer<float>& buffer,
+                                     juce::MidiBuffer& midiMessages) noexcept {
+    const int numSamples = buffer.getNumSamples();
+    const int numTasks = static_cast<int>(plan.tasks.size());
+
+    plan.blockInput = &buffer;
+    plan.blockMidi = &midiMessages;
+    plan.blockNumSamples = numSamples;
+
+    for (int i = 0; i < numTasks; ++i) {
+        plan.pendingDependencies[static_cast<size_t>(i)].store(plan.tasks[static_cast<size_t>(i)].numDependencies,
+                                                               std::memory_order_relaxed);
+    }
+
+    // 参与线程数不超过可并行的宽度
+    const int numParticipants = 1 + std::min(static_cast<int>(workers.size()), plan.maxParallelWidth - 1);
+    plan.numParticipants = numParticipants;
+    for (int q = 0; q < numParticipants; ++q) {
+        plan.queues[static_cast<size_t>(q)].reset();
+    }
+
+    // 根节点轮流分给各个参与线程
+    int next = 0;
+    for (int root : plan.roots) {
+        plan.queues[static_cast<size_t>(next++ % numParticipants)].push(root);
+    }
+
+    plan.remainingTasks.store(numTasks);
+    currentRun.store(&plan);
+
+    for (int i = 0; i < numParticipants - 1; ++i) {
+        workers[static_cast<size_t>(i)]->wakeUp();
+    }
+
+    // 设备线程自己也处理节点
+    participate(plan, 0);
+
+    // 等待仍在访问计划的工作线程退出
+    currentRun.store(nullptr);
+    while (activeWorkers.load() != 0) {
+        std::this_thread::yield();
+    }
+
+    // 输出节点汇总的结果写回设备缓冲区
+    if (plan.audioOutputTask >= 0) {
+        const auto& output = plan.tasks[static_cast<size_t>(plan.audioOutputTask)];
+        for (int ch = 0; ch < buffer.getNumChannels(); ++ch) {
+            if (ch < output.numChannels) {
+                buffer.copyFrom(ch, 0, output.buffer, ch, 0, numSamples);
+            } else {
+                buffer.clear(ch, 0, numSamples);
+            }
+        }
+    } else {
+        buffer.clear();
+    }
+
+    midiMessages.clear();
+    if (plan.midiOutputTask >= 0) {
+        midiMessages.addEvents(plan.tasks[static_cast<size_t>(plan.midiOutputTask)].midi, 0, numSamples, 0);
+    }
+}
+
+void ParallelGraphScheduler::participate(RenderPlan& plan, int participantIndex) noexcept {
+    auto& ownQueue = plan.queues[static_cast<size_t>(participantIndex)];
+    const int numParticipants = plan.numParticipants;
+
+    while (plan.remainingTasks.load(std::memory_order_acquire) > 0) {
+        int task = -1;
+        bool found = ownQueue.popBack(task);
+
+        // 自己的队列为空时从其他线程窃取
+        for (int offset = 1; !found && offset < numParticipants; ++offset) {
+            found = plan.queues[static_cast<size_t>((participantIndex + offset) % numParticipants)].popFront(task);
+            if (found) {
+                stolenTasks.fetch_add(1, std::memory_order_relaxed);
+            }
+        }
+
+        if (!found) {
+            std::this_thread::yield();
+            continue;
+        }
+
+        plan.execute(task);
+
+        // 依赖全部满足的下游节点放入自己的队列
+        for (int dependent : plan.tasks[static_cast<size_t>(task)].dependents) {
+            if (plan.pendingDependencies[static_cast<size_t>(dependent)].fetch_sub(1, std::memory_order_acq_rel) == 1) {
+                ownQueue.push(dependent);
+            }
+        }
+
+        plan.remainingTasks.fetch_sub(1, std::memory_order_acq_rel);
+    }
+}
+
+void ParallelGraphScheduler::runWorker(int participantIndex) noexcept {
+    activeWorkers.fetch_add(1);
+
+    if (auto* plan = currentRun.load()) {
+        // 本块没有分配给这个线程的队列
+        if (participantIndex < plan->numParticipants) {
+            participate(*plan, participantIndex);
+        }
+    }
+
+    activeWorkers.fetch_sub(1);
+}
+
+void ParallelGraphScheduler::joinWorkgroup(juce::WorkgroupToken& token, int& joinedVersion) {
+    const int version = workgroupVersion.load();
+    if (version == joinedVersion) {
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(workgroupMutex);
+    token.reset();
+    if (audioWorkgroup) {
+        audioWorkgroup.join(token);
+    }
+    joinedVersion = version;
+}
+
+//==============================================================================
+// 统计
+//==============================================================================
+
+ParallelGraphScheduler::Statistics ParallelGraphScheduler::getStatistics() const {
+    Statistics stats;
+    stats.enabled = enabled.load();
+    stats.planIsParallel = planIsParallel.load();
+    stats.numWorkers = getNumWorkers();
+    stats.numNodes = planNumNodes.load();
+    stats.maxParallelWidth = planMaxParallelWidth.load();
+    stats.parallelBlocks = parallelBlocks.load();
+    stats.serialBlocks = serialBlocks.load();
+    stats.stolenTasks = stolenTasks.load();
+    return stats;
+}
+
+void ParallelGraphScheduler::timerCallback() {
+    collectRetiredPlans();
+
+    if (pendingPlan.load() == nullptr && retiredPlan.load() == nullptr) {
+        stopTimer();
+    }
+}
+
+} // namespace WindsynthVST::AudioGraph
@@ -0,0 +1,184 @@
+//
+//  ParallelGraphScheduler.hpp
+//  WindsynthRecorder
+//
+//  Created by AI Assistant
+//  并行图调度器 - 在多个实时工作线程上处理相互独立的分支
+//
+
+#pragma once
+
+#include <JuceHeader.h>
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <vector>
+#include <cstdint>
+#include "AudioGraphTypes.hpp"
+#include "GraphLatencyModel.hpp"
+
+namespace WindsynthVST::AudioGraph {
+
+/**
+ * 并行图调度器
+ *
+ * AudioProcessorGraph 在设备线程上串行处理所有节点。调度器根据连接关系
+ * 构建渲染计划（每个节点的依赖数和深度，与 GraphManager::calculateNodeDepth 的定义一致），
+ * 在音频回调中把依赖已满足的节点分发给实时工作线程：
+ * - 每个线程有自己的任务队列，完成节点后把就绪的下游节点放入自己的队列，空闲时从其他队列窃取
+ * - macOS 上工作线程加入设备的音频工作组，由系统按音频线程调度
+ * - 按延迟模型在较短的路径上插入预分配的补偿延迟线（MIDI连接不补偿）
+ * - 节点数量太少或没有可并行的分支时回退到 AudioProcessorGraph 的串行处理
+ *
+ * 渲染计划在消息线程构建，通过原子指针交给音频线程；被替换的计划由定时器在消息线程释放。
+ * 只支持单精度处理，双精度处理总是回退到串行。
+ */
+class ParallelGraphScheduler : private juce::Timer {
+public:
+    /**
+     * 调度统计
+     */
+    struct Statistics {
+        bool enabled = false;
+        bool planIsParallel = false;    // 当前渲染计划是否并行执行
+        int numWorkers = 0;             // 工作线程数量（不含音频线程）
+        int numNodes = 0;               // 渲染计划中的节点数量
+        int maxParallelWidth = 0;       // 同一深度上的最大插件节点数
+        uint64_t parallelBlocks = 0;    // 并行处理的音频块数
+        uint64_t serialBlocks = 0;      // 回退到串行处理的音频块数
+        uint64_t stolenTasks = 0;       // 从其他线程窃取的节点数
+    };
+
+    /**
+     * 构建渲染计划需要的I/O节点ID
+     */
+    struct IONodes {
+        NodeID audioInput;
+        NodeID audioOutput;
+        NodeID midiInput;
+        NodeID midiOutput;
+    };
+
+    static constexpr int maxWorkers = 15;
+    static constexpr int defaultMinParallelNodes = 3;
+
+    ParallelGraphScheduler();
+    ~ParallelGraphScheduler() override;
+
+    //==============================================================================
+    // 配置
+    //==============================================================================
+
+    /**
+     * 启用或禁用并行处理（禁用时渲染计划始终为串行）
+     * 修改后需要重新调用 rebuildPlan()
+     */
+    void setEnabled(bool shouldBeEnabled);
+    bool isEnabled() const { return enabled.load(); }
+
+    /**
+     * 设置工作线程数量（0表示按CPU核心数自动选择）
+     */
+    void setNumWorkers(int numWorkers);
+    int getNumWorkers() const;
+
+    /**
+     * 设置启用并行处理所需的最少插件节点数
+     */
+    void setMinParallelNodes(int minNodes);
+
+    /**
+     * 设置工作线程要加入的音频工作组（在设备启动时调用）
+     */
+    void setAudioWorkgroup(const juce::AudioWorkgroup& workgroup);
+
+    //==============================================================================
+    // 渲染计划
+    //==============================================================================
+
+    /**
+     * 准备处理（分配工作线程使用的块大小）
+     */
+    void prepare(double sampleRate, int maximumBlockSize);
+
+    /**
+     * 根据图的当前拓扑构建新的渲染计划（消息线程，图的渲染序列已重建之后调用）
+     * @param latencyModel 已按当前拓扑计算的延迟模型，用于设置补偿延迟线
+     */
+    void rebuildPlan(const juce::AudioProcessorGraph& graph, const IONodes& ioNodes,
+                     const GraphLatencyModel& latencyModel);
+
+    /**
+     * 丢弃渲染计划，释放计划持有的节点引用
+     */
+    void clearPlan();
+
+    //==============================================================================
+    // 音频线程
+    //==============================================================================
+
+    /**
+     * 按渲染计划处理一个音频块
+     * @return 计划不可用或应串行处理时返回false，调用方应使用 AudioProcessorGraph 处理
+     */
+    bool process(juce::AudioBuffer<float>& buffer, juce::MidiBuffer& midiMessages) noexcept;
+
+    /**
+     * 获取统计信息
+     */
+    Statistics getStatistics() const;
+
+private:
+    struct RenderPlan;
+    class Worker;
+
+    std::atomic<bool> enabled{false};
+    std::atomic<int> minParallelNodes{defaultMinParallelNodes};
+    double preparedSampleRate = Constants::DEFAULT_SAMPLE_RATE;
+    int preparedBlockSize = Constants::DEFAULT_BUFFER_SIZE;
+
+    // 渲染计划交接：持有 planInUse 的线程可以切换计划，音频线程抢不到时本块回退为串行
+    std::atomic<bool> planInUse{false};
+    std::atomic<RenderPlan*> pendingPlan{nullptr};
+    std::atomic<RenderPlan*> retiredPlan{nullptr};
+    RenderPlan* activePlan = nullptr;
+
+    // 工作线程（修改时持有 planInUse，音频线程不会同时使用）
+    mutable std::mutex workerMutex;
+    std::vector<std::unique_ptr<Worker>> workers;
+    int requestedWorkers = 0;
+    std::atomic<RenderPlan*> currentRun{nullptr};
+    std::atomic<int> activeWorkers{0};
+
+    std::mutex workgroupMutex;
+    juce::AudioWorkgroup audioWorkgroup;
+    std::atomic<int> workgroupVersion{0};
+
+    // 统计（计划摘要在发布时更新）
+    std::atomic<bool> planIsParallel{false};
+    std::atomic<int> planNumNodes{0};
+    std::atomic<int> planMaxParallelWidth{0};
+    std::atomic<uint64_t> parallelBlocks{0};
+    std::atomic<uint64_t> serialBlocks{0};
+    std::atomic<uint64_t> stolenTasks{0};
+
+    int resolveNumWorkers() const;
+    std::unique_ptr<RenderPlan> buildPlan(const juce::AudioProcessorGraph& graph, const IONodes& ioNodes,
+                                          const GraphLatencyModel& latencyModel) const;
+    void publishPlan(std::unique_ptr<RenderPlan> plan);
+    bool acquirePlan(int timeoutMs);
+    void releasePlan();
+    void collectRetiredPlans();
+    void restartWorkers(int numWorkers);
+
+    void runPlan(RenderPlan& plan, juce::AudioBuffer<float>& buffer, juce::MidiBuffer& midiMessages) noexcept;
+    void participate(RenderPlan& plan, int participantIndex) noexcept;
+    void runWorker(int participantIndex) noexcept;
+    void joinWorkgroup(juce::WorkgroupToken& token, int& joinedVersion);
+
+    void timerCallback() override;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(ParallelGraphScheduler)
+};
+
+} // namespace WindsynthVST::AudioGraph
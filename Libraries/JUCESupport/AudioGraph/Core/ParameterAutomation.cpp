@@ -0,0 +1,216 @@
+//
+//  ParameterAutomation.cpp
+//  WindsynthRecorder
+//
+//  Created by AI Assistant
+//  参数自动化队列实现
+//
+
+#include "ParameterAutomation.hpp"
+#include <algorithm>
+
+namespace WindsynthVST::AudioGraph {
+
+ParameterAutomation::ParameterAutomation(int queueCapacity)
+    : queue(queueCapacity)
+{
+    pending.reserve(static_cast<size_t>(queueCapacity));
+    ramps.reserve(static_cast<size_t>(Constants::PARAMETER_MAX_RAMPS));
+}
+
+//==============================================================================
+// 写入端
+//==============================================================================
+
+int ParameterAutomation::push(const std::vector<ParameterEvent>& events) {
+    const juce::SpinLock::ScopedLockType lock(producerLock);
+
+    int numPushed = 0;
+    for (const auto& event : events) {
+        if (queue.push(event)) {
+            numPushed++;
+        }
+    }
+
+    queuedEvents.fetch_add(static_cast<uint64_t>(numPushed), std::memory_order_relaxed);
+    return numPushed;
+}
+
+//==============================================================================
+// 音频线程
+//==============================================================================
+
+void ParameterAutomation::drainQueue() noexcept {
+    // 待处理列表已满时剩余事件留在队列中，下一个块再取
+    ParameterEvent event;
+    while (pending.size() < pending.capacity() && queue.pop(event)) {
+        event.sampleOffset = std::max(0, event.sampleOffset);
+
+        // 插入到相同偏移的事件之后，保持写入顺序
+        auto position = std::upper_bound(pending.begin() + static_cast<std::ptrdiff_t>(nextPending), pending.end(), event,
+                                         [](const ParameterEvent& a, const ParameterEvent& b) {
+                                             return a.sampleOffset < b.sampleOffset;
+                                         });
+        const auto index = position - pending.begin();
+        pending.push_back(event);
+        std::rotate(pending.begin() + index, pending.end() - 1, pending.end());
+    }
+}
+
+bool ParameterAutomation::beginBlock(int numSamples) noexcept {
+    blockLength = numSamples;
+    nextPending = 0;
+
+    if (queue.getNumReady() > 0) {
+        drainQueue();
+    }
+
+    const bool hasEventsInBlock = !pending.empty() && pending.front().sampleOffset < numSamples;
+    if (hasEventsInBlock || !ramps.empty()) {
+        return true;
+    }
+
+    // 本块没有需要应用的事件，直接推进后续事件的偏移
+    shiftPending(numSamples);
+    return false;
+}
+
+int ParameterAutomation::applyEvents(juce::AudioProcessor& processor, int position) noexcept {
+    while (nextPending < pending.size() && pending[nextPending].sampleOffset <= position) {
+        startEvent(processor, pending[nextPending]);
+        nextPending++;
+        appliedEvents.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    for (size_t i = 0; i < ramps.size();) {
+        auto& ramp = ramps[i];
+        const int elapsed = position - ramp.startPosition;
+
+        if (elapsed >= ramp.length) {
+            setParameter(processor, ramp.parameterIndex, ramp.targetValue);
+            ramps[i] = ramps.back();
+            ramps.pop_back();
+            continue;
+        }
+
+        const float proportion = static_cast<float>(elapsed) / static_cast<float>(ramp.length);
+        setParameter(processor, ramp.parameterIndex,
+                     ramp.startValue + (ramp.targetValue - ramp.startValue) * proportion);
+        ++i;
+    }
+
+    int end = blockLength;
+    if (nextPending < pending.size()) {
+        end = std::min(end, pending[nextPending].sampleOffset);
+    }
+    if (!ramps.empty()) {
+        end = std::min(end, position + Constants::PARAMETER_RAMP_STEP_SAMPLES);
+    }
+    end = std::min(blockLength, std::max(end, position + Constants::PARAMETER_MIN_SUBBLOCK_SAMPLES));
+
+    if (position > 0 || end < blockLength) {
+        subBlocks.fetch_add(1, std::memory_order_relaxed);
+    }
+    return end;
+}
+
+void ParameterAutomation::endBlock(int numSamples) noexcept {
+    pending.erase(pending.begin(), pending.begin() + static_cast<std::ptrdiff_t>(nextPending));
+    nextPending = 0;
+    shiftPending(numSamples);
+
+    for (auto& ramp : ramps) {
+        ramp.startPosition -= numSamples;
+    }
+}
+
+void ParameterAutomation::flush(juce::AudioProcessor& processor) noexcept {
+    drainQueue();
+
+    for (size_t i = nextPending; i < pending.size(); ++i) {
+        removeRamp(pending[i].parameterIndex);
+        setParameter(processor, pending[i].parameterIndex, pending[i].value);
+        appliedEvents.fetch_add(1, std::memory_order_relaxed);
+    }
+    for (const auto& ramp : ramps) {
+        setParameter(processor, ramp.parameterIndex, ramp.targetValue);
+    }
+
+    pending.clear();
+    nextPending = 0;
+    ramps.clear();
+}
+
+void ParameterAutomation::reset() noexcept {
+    queue.clear();
+    pending.clear();
+    nextPending = 0;
+    ramps.clear();
+}
+
+void ParameterAutomation::startEvent(juce::AudioProcessor& processor, const ParameterEvent& event) noexcept {
+    removeRamp(event.parameterIndex);
+
+    if (event.rampSamples <= 0 || ramps.size() >= ramps.capacity()) {
+        setParameter(processor, event.parameterIndex, event.value);
+        return;
+    }
+
+    Ramp ramp;
+    ramp.parameterIndex = event.parameterIndex;
+    ramp.startValue = getParameter(processor, event.parameterIndex);
+    ramp.targetValue = event.value;
+    ramp.startPosition = event.sampleOffset;
+    ramp.length = event.rampSamples;
+    ramps.push_back(ramp);
+}
+
+void ParameterAutomation::removeRamp(int parameterIndex) noexcept {
+    for (size_t i = 0; i < ramps.size(); ++i) {
+        if (ramps[i].parameterIndex == parameterIndex) {
+            ramps[i] = ramps.back();
+            ramps.pop_back();
+            return;
+        }
+    }
+}
+
+void ParameterAutomation::shiftPending(int numSamples) noexcept {
+    for (auto& event : pending) {
+        event.sampleOffset = std::max(0, event.sampleOffset - numSamples);
+    }
+}
+
+void ParameterAutomation::setParameter(juce::AudioProcessor& processor, int parameterIndex, float value) noexcept {
+    const auto& parameters = processor.getParameters();
+    if (parameterIndex >= 0 && parameterIndex < parameters.size()) {
+        if (auto* parameter = parameters[parameterIndex]) {
+            parameter->setValue(juce::jlimit(0.0f, 1.0f, value));
+        }
+    }
+}
+
+float ParameterAutomation::getParameter(juce::AudioProcessor& processor, int parameterIndex) noexcept {
+    const auto& parameters = processor.getParameters();
+    if (parameterIndex >= 0 && parameterIndex < parameters.size()) {
+        if (auto* parameter = parameters[parameterIndex]) {
+            return parameter->getValue();
+        }
+    }
+    return 0.0f;
+}
+
+//==============================================================================
+// 统计
+//==============================================================================
+
+ParameterAutomation::Statistics ParameterAutomation::getStatistics() const noexcept {
+    Statistics stats;
+    stats.queuedEvents = queuedEvents.load(std::memory_order_relaxed);
+    stats.appliedEvents = appliedEvents.load(std::memory_order_relaxed);
+    stats.droppedEvents = queue.getDroppedCount();
+    stats.subBlocks = subBlocks.load(std::memory_order_relaxed);
+    return stats;
+}
+
+} // namespace WindsynthVST::AudioGraph
@@ -0,0 +1,124 @@
+//
+//  ParameterAutomation.hpp
+//  WindsynthRecorder
+//
+//  Created by AI Assistant
+//  参数自动化队列 - 在音频线程中按采样偏移应用参数变化
+//
+
+#pragma once
+
+#include <JuceHeader.h>
+#include <atomic>
+#include <vector>
+#include <cstdint>
+#include "AudioGraphTypes.hpp"
+#include "LockFreeRingBuffer.hpp"
+
+namespace WindsynthVST::AudioGraph {
+
+/**
+ * 单个节点的参数自动化队列
+ *
+ * 任意线程写入参数事件（写入端之间用自旋锁串行化，音频线程从不加锁），
+ * 音频线程在每个块开始时取出事件，按采样偏移把块切分成子块：
+ * - 每个子块开始前应用偏移已到达的事件，然后推进进行中的线性过渡
+ * - 子块不短于 PARAMETER_MIN_SUBBLOCK_SAMPLES，更近的事件推迟到下一个子块
+ * - 过渡期间每 PARAMETER_RAMP_STEP_SAMPLES 个采样更新一次参数值
+ * - 偏移超出当前块的事件保留到后续块
+ *
+ * 音频线程使用的存储在构造时一次性分配。
+ */
+class ParameterAutomation {
+public:
+    /**
+     * 自动化统计
+     */
+    struct Statistics {
+        uint64_t queuedEvents = 0;      // 写入队列的事件数
+        uint64_t appliedEvents = 0;     // 已应用的事件数
+        uint64_t droppedEvents = 0;     // 队列已满而丢弃的事件数
+        uint64_t subBlocks = 0;         // 因参数变化切分出的子块数
+    };
+
+    explicit ParameterAutomation(int queueCapacity = Constants::PARAMETER_QUEUE_SIZE);
+
+    //==============================================================================
+    // 写入端（任意线程）
+    //==============================================================================
+
+    /**
+     * 写入参数事件
+     * @return 成功写入的事件数量
+     */
+    int push(const std::vector<ParameterEvent>& events);
+
+    //==============================================================================
+    // 音频线程
+    //==============================================================================
+
+    /**
+     * 开始处理一个块，取出队列中的事件
+     * @return 本块需要应用事件或有进行中的过渡时返回true，此时必须在块结束时调用 endBlock()
+     */
+    bool beginBlock(int numSamples) noexcept;
+
+    /**
+     * 应用到达 position 的事件和过渡，返回下一个子块的结束位置
+     */
+    int applyEvents(juce::AudioProcessor& processor, int position) noexcept;
+
+    /**
+     * 结束处理当前块
+     */
+    void endBlock(int numSamples) noexcept;
+
+    /**
+     * 立即应用所有事件并完成所有过渡（旁路处理时使用，音频线程）
+     */
+    void flush(juce::AudioProcessor& processor) noexcept;
+
+    /**
+     * 丢弃所有事件和过渡（不能与音频线程同时调用）
+     */
+    void reset() noexcept;
+
+    /**
+     * 获取统计信息
+     */
+    Statistics getStatistics() const noexcept;
+
+private:
+    struct Ramp {
+        int parameterIndex = -1;
+        float startValue = 0.0f;
+        float targetValue = 0.0f;
+        int startPosition = 0;      // 相对于当前块起点，可以为负
+        int length = 0;
+    };
+
+    LockFreeRingBuffer<ParameterEvent> queue;
+    juce::SpinLock producerLock;
+
+    // 以下只在音频线程访问
+    std::vector<ParameterEvent> pending;    // 按采样偏移排序
+    size_t nextPending = 0;
+    std::vector<Ramp> ramps;
+    int blockLength = 0;
+
+    std::atomic<uint64_t> queuedEvents{0};
+    std::atomic<uint64_t> appliedEvents{0};
+    std::atomic<uint64_t> subBlocks{0};
+
+    void drainQueue() noexcept;
+    void startEvent(juce::AudioProcessor& processor, const ParameterEvent& event) noexcept;
+    void removeRamp(int parameterIndex) noexcept;
+    void shiftPending(int numSamples) noexcept;
+
+    static void setParameter(juce::AudioProcessor& processor, int parameterIndex, float value) noexcept;
+    static float getParameter(juce::AudioProcessor& processor, int parameterIndex) noexcept;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(ParameterAutomation)
+};
+
+} // namespace WindsynthVST::AudioGraph
@@ -0,0 +1,128 @@
+//
+//  ParameterCache.cpp
+//  WindsynthRecorder
+//
+//  Created by AI Assistant
+//  插件参数缓存实现
+//
+
+#include "ParameterCache.hpp"
+#include <algorithm>
+#include <cstring>
+
+namespace WindsynthVST::AudioGraph {
+
+//==============================================================================
+// 更新
+//==============================================================================
+
+void ParameterCache::update(juce::AudioProcessor& processor) {
+    if (metadataDirty.exchange(false)) {
+        rebuildMetadata(processor);
+        return;
+    }
+
+    if (valuesDirty.exchange(false)) {
+        refreshValues(processor);
+    }
+}
+
+void ParameterCache::rebuildMetadata(juce::AudioProcessor& processor) {
+    const auto& parameters = processor.getParameters();
+
+    auto newMetadata = std::make_shared<MetadataList>();
+    newMetadata->reserve(static_cast<size_t>(parameters.size()));
+    std::vector<float> newValues;
+    newValues.reserve(static_cast<size_t>(parameters.size()));
+
+    for (auto* parameter : parameters) {
+        ParameterMetadata entry;
+        if (parameter != nullptr) {
+            entry.name = parameter->getName(256).toStdString();
+            entry.label = parameter->getLabel().toStdString();
+            entry.defaultValue = parameter->getDefaultValue();
+            entry.isAutomatable = parameter->isAutomatable();
+            entry.isDiscrete = parameter->isDiscrete();
+            entry.numSteps = parameter->getNumSteps();
+        }
+        newValues.push_back(parameter != nullptr ? parameter->getValue() : 0.0f);
+        newMetadata->push_back(std::move(entry));
+    }
+
+    {
+        const juce::SpinLock::ScopedLockType lock(valuesLock);
+        values.swap(newValues);
+    }
+    {
+        std::lock_guard<std::mutex> lock(metadataMutex);
+        metadata = std::move(newMetadata);
+    }
+
+    numParameters.store(parameters.size());
+    metadataVersion.fetch_add(1);
+    valuesDirty.store(false);
+}
+
+void ParameterCache::refreshValues(juce::AudioProcessor& processor) {
+    const auto& parameters = processor.getParameters();
+
+    // 先在锁外读取插件，避免持有自旋锁时调用插件
+    std::vector<float> newValues(static_cast<size_t>(parameters.size()));
+    for (int i = 0; i < parameters.size(); ++i) {
+        newValues[static_cast<size_t>(i)] = parameters[i] != nullptr ? parameters[i]->getValue() : 0.0f;
+    }
+
+    const juce::SpinLock::ScopedLockType lock(valuesLock);
+    if (newValues.size() == values.size()) {
+        std::memcpy(values.data(), newValues.data(), values.size() * sizeof(float));
+    } else {
+        // 参数数量变了但插件没有报告参数信息变化
+        metadataDirty.store(true);
+    }
+}
+
+//==============================================================================
+// 参数值
+//==============================================================================
+
+void ParameterCache::setValue(int parameterIndex, float value) noexcept {
+    const juce::SpinLock::ScopedTryLockType lock(valuesLock);
+    if (!lock.isLocked()) {
+        valuesDirty.store(true);
+        return;
+    }
+
+    if (parameterIndex >= 0 && parameterIndex < static_cast<int>(values.size())) {
+        values[static_cast<size_t>(parameterIndex)] = value;
+    }
+}
+
+float ParameterCache::getValue(int parameterIndex) const noexcept {
+    const juce::SpinLock::ScopedLockType lock(valuesLock);
+    if (parameterIndex >= 0 && parameterIndex < static_cast<int>(values.size())) {
+        return values[static_cast<size_t>(parameterIndex)];
+    }
+    return 0.0f;
+}
+
+int ParameterCache::copyValues(float* destination, int maxCount) const noexcept {
+    if (destination == nullptr || maxCount <= 0) {
+        return 0;
+    }
+
+    const juce::SpinLock::ScopedLockType lock(valuesLock);
+    const int count = std::min(maxCount, static_cast<int>(values.size()));
+    std::memcpy(destination, values.data(), static_cast<size_t>(count) * sizeof(float));
+    return count;
+}
+
+//==============================================================================
+// 元数据
+//==============================================================================
+
+std::shared_ptr<const ParameterCache::MetadataList> ParameterCache::getMetadata() const {
+    std::lock_guard<std::mutex> lock(metadataMutex);
+    return metadata;
+}
+
+} // namespace WindsynthVST::AudioGraph
@@ -0,0 +1,115 @@
+//
+//  ParameterCache.hpp
+//  WindsynthRecorder
+//
+//  Created by AI Assistant
+//  插件参数缓存 - 参数元数据和连续存放的参数值镜像
+//
+
+#pragma once
+
+#include <JuceHeader.h>
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+#include <cstdint>
+
+namespace WindsynthVST::AudioGraph {
+
+/**
+ * 参数元数据（加载插件后基本不变）
+ */
+struct ParameterMetadata {
+    std::string name;
+    std::string label;
+    float defaultValue = 0.0f;
+    bool isAutomatable = true;
+    bool isDiscrete = false;
+    int numSteps = 0;
+};
+
+/**
+ * 插件参数缓存
+ *
+ * 查询插件的参数名称、单位等需要调用插件并构造字符串，参数很多时代价很高。
+ * 缓存在插件加载时构建一次，插件报告参数信息变化时标记失效，下次查询时重建：
+ * - 元数据以不可变快照共享，读取不需要复制字符串
+ * - 参数值保存为连续的float数组，由宿主写入的值和插件通知的变化保持同步，
+ *   读取全部参数值只需要一次内存复制
+ *
+ * update() 和元数据读取应在非音频线程调用；setValue() 可在任意线程调用。
+ */
+class ParameterCache {
+public:
+    using MetadataList = std::vector<ParameterMetadata>;
+
+    ParameterCache() = default;
+
+    /**
+     * 按需重建元数据或刷新参数值（非音频线程）
+     */
+    void update(juce::AudioProcessor& processor);
+
+    /**
+     * 参数信息变化（任意线程），下次 update() 时重建元数据和参数值
+     */
+    void invalidateMetadata() noexcept { metadataDirty.store(true); }
+
+    /**
+     * 参数值整体变化（任意线程，例如切换预置、恢复状态），下次 update() 时重新读取参数值
+     */
+    void invalidateValues() noexcept { valuesDirty.store(true); }
+
+    /**
+     * 更新参数值镜像（任意线程，不阻塞，与重建冲突时放弃本次写入并标记需要刷新）
+     */
+    void setValue(int parameterIndex, float value) noexcept;
+
+    /**
+     * 获取元数据快照
+     */
+    std::shared_ptr<const MetadataList> getMetadata() const;
+
+    /**
+     * 参数数量
+     */
+    int getNumParameters() const noexcept { return numParameters.load(); }
+
+    /**
+     * 获取单个参数值
+     */
+    float getValue(int parameterIndex) const noexcept;
+
+    /**
+     * 复制参数值
+     * @return 复制的参数数量
+     */
+    int copyValues(float* destination, int maxCount) const noexcept;
+
+    /**
+     * 元数据版本（每次重建递增，调用方可据此判断是否需要重新读取元数据）
+     */
+    uint32_t getMetadataVersion() const noexcept { return metadataVersion.load(); }
+
+private:
+    mutable std::mutex metadataMutex;
+    std::shared_ptr<const MetadataList> metadata = std::make_shared<MetadataList>();
+
+    // 参数值镜像（数组只在重建时重新分配，写入和复制持有自旋锁）
+    mutable juce::SpinLock valuesLock;
+    std::vector<float> values;
+
+    std::atomic<int> numParameters{0};
+    std::atomic<uint32_t> metadataVersion{0};
+    std::atomic<bool> metadataDirty{true};
+    std::atomic<bool> valuesDirty{false};
+
+    void rebuildMetadata(juce::AudioProcessor& processor);
+    void refreshValues(juce::AudioProcessor& processor);
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(ParameterCache)
+};
+
+} // namespace WindsynthVST::AudioGraph
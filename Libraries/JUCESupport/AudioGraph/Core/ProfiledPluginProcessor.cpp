@@ -0,0 +1,464 @@
+//
+//  ProfiledPluginProcessor.cpp
+//  WindsynthRecorder
+//
+//  Created by AI Assistant
+//  带处理耗时统计的插件包装处理器实现
+//
+
+#include "ProfiledPluginProcessor.hpp"
+
+namespace WindsynthVST::AudioGraph {
+
+namespace {
+
+constexpr float silenceThreshold = 1.0e-6f;        // 约 -120 dBFS，低于该幅度视为数字静音
+constexpr double maxSleepTailSeconds = 60.0;        // 尾音更长的插件不休眠
+
+} // namespace
+
+//==============================================================================
+// 构造函数和析构函数
+//==============================================================================
+
+ProfiledPluginProcessor::ProfiledPluginProcessor(std::unique_ptr<juce::AudioPluginInstance> pluginToWrap,
+                                                 const std::atomic<bool>& enabled)
+    : AudioProcessor(getBusesPropertiesFor(*pluginToWrap)),
+      plugin(std::move(pluginToWrap)),
+      profilingEnabled(enabled)
+{
+    setLatencySamples(plugin->getLatencySamples());
+    parameterCache.update(*plugin);
+    plugin->addListener(this);
+}
+
+ProfiledPluginProcessor::~ProfiledPluginProcessor() {
+    if (plugin) {
+        plugin->removeListener(this);
+    }
+}
+
+std::unique_ptr<juce::AudioPluginInstance> ProfiledPluginProcessor::releasePluginInstance() {
+    if (plugin) {
+        plugin->removeListener(this);
+    }
+    return std::move(plugin);
+}
+
+juce::AudioProcessor::BusesProperties ProfiledPluginProcessor::getBusesPropertiesFor(const juce::AudioPluginInstance& instance) {
+    BusesProperties properties;
+
+    for (int i = 0; i < instance.getBusCount(true); ++i) {
+        if (auto* bus = instance.getBus(true, i)) {
+            properties.addBus(true, bus->getName(), bus->getCurrentLayout(), bus->isEnabled());
+        }
+    }
+    for (int i = 0; i < instance.getBusCount(false); ++i) {
+        if (auto* bus = instance.getBus(false, i)) {
+            properties.addBus(false, bus->getName(), bus->getCurrentLayout(), bus->isEnabled());
+        }
+    }
+
+    return properties;
+}
+
+//==============================================================================
+// 统计
+//==============================================================================
+
+ProfiledPluginProcessor::Profile ProfiledPluginProcessor::getProfile() const noexcept {
+    Profile profile;
+
+    const auto blocks = blockCount.load(std::memory_order_relaxed);
+    const double ticksToMs = 1000.0 / static_cast<double>(juce::Time::getHighResolutionTicksPerSecond());
+
+    profile.blocks = blocks;
+    profile.peakTimeMs = static_cast<double>(peakTicks.load(std::memory_order_relaxed)) * ticksToMs;
+    profile.lastTimeMs = static_cast<double>(lastTicks.load(std::memory_order_relaxed)) * ticksToMs;
+
+    if (blocks > 0) {
+        profile.averageTimeMs = static_cast<double>(totalTicks.load(std::memory_order_relaxed)) * ticksToMs
+                                / static_cast<double>(blocks);
+        profile.averageBlockSamples = static_cast<double>(totalSamples.load(std::memory_order_relaxed))
+                                      / static_cast<double>(blocks);
+    }
+
+    return profile;
+}
+
+void ProfiledPluginProcessor::resetProfile() noexcept {
+    totalTicks.store(0, std::memory_order_relaxed);
+    peakTicks.store(0, std::memory_order_relaxed);
+    lastTicks.store(0, std::memory_order_relaxed);
+    totalSamples.store(0, std::memory_order_relaxed);
+    blockCount.store(0, std::memory_order_relaxed);
+}
+
+template <typename SampleType>
+void ProfiledPluginProcessor::processProfiled(juce::AudioBuffer<SampleType>& buffer, juce::MidiBuffer& midiMessages) {
+    lastProcessTime.store(juce::Time::getMillisecondCounter(), std::memory_order_relaxed);
+
+    // 输入要在插件原地处理之前检查
+    const bool trackSilence = sleepWhenSilent.load(std::memory_order_relaxed);
+    bool inputSilent = false;
+    if (trackSilence) {
+        if (processSleeping(buffer, midiMessages)) {
+            return;
+        }
+        inputSilent = midiMessages.isEmpty() && isSilent(buffer, 0, getTotalNumInputChannels());
+    } else {
+        silentSamples = 0;
+    }
+
+    if (!profilingEnabled.load(std::memory_order_relaxed)) {
+        processAutomated(buffer, midiMessages);
+    } else {
+        const auto start = juce::Time::getHighResolutionTicks();
+        processAutomated(buffer, midiMessages);
+        const auto elapsed = static_cast<uint64_t>(std::max<juce::int64>(0, juce::Time::getHighResolutionTicks() - start));
+
+        totalTicks.fetch_add(elapsed, std::memory_order_relaxed);
+        totalSamples.fetch_add(static_cast<uint64_t>(buffer.getNumSamples()), std::memory_order_relaxed);
+        blockCount.fetch_add(1, std::memory_order_relaxed);
+        lastTicks.store(elapsed, std::memory_order_relaxed);
+
+        // 只有音频线程写入，读-比较-写即可
+        if (elapsed > peakTicks.load(std::memory_order_relaxed)) {
+            peakTicks.store(elapsed, std::memory_order_relaxed);
+        }
+    }
+
+    if (trackSilence) {
+        updateSilence(buffer, inputSilent && midiMessages.isEmpty());
+    }
+}
+
+//==============================================================================
+// 静音休眠
+//==============================================================================
+
+void ProfiledPluginProcessor::setSleepWhenSilent(bool shouldSleep) noexcept {
+    sleepWhenSilent.store(shouldSleep, std::memory_order_relaxed);
+    if (!shouldSleep) {
+        sleeping.store(false, std::memory_order_relaxed);
+    }
+}
+
+template <typename SampleType>
+bool ProfiledPluginProcessor::processSleeping(juce::AudioBuffer<SampleType>& buffer, const juce::MidiBuffer& midiMessages) {
+    if (!sleeping.load(std::memory_order_relaxed)) {
+        return false;
+    }
+
+    if (!midiMessages.isEmpty() || !isSilent(buffer, 0, getTotalNumInputChannels())) {
+        // 输入恢复信号，从本块开始重新处理
+        sleeping.store(false, std::memory_order_relaxed);
+        silentSamples = 0;
+        return false;
+    }
+
+    // 插件不处理，排队的参数变化直接应用，输出保持静音
+    automation.flush(*plugin);
+    buffer.clear();
+    sleptBlocks.fetch_add(1, std::memory_order_relaxed);
+    return true;
+}
+
+template <typename SampleType>
+void ProfiledPluginProcessor::updateSilence(const juce::AudioBuffer<SampleType>& buffer, bool inputSilent) noexcept {
+    const auto threshold = sleepThresholdSamples.load(std::memory_order_relaxed);
+    if (threshold < 0 || !inputSilent || !isSilent(buffer, 0, getTotalNumOutputChannels())) {
+        silentSamples = 0;
+        return;
+    }
+
+    // 输入和输出都保持静音超过尾音长度后进入休眠
+    silentSamples += buffer.getNumSamples();
+    if (silentSamples >= threshold) {
+        sleeping.store(true, std::memory_order_relaxed);
+    }
+}
+
+void ProfiledPluginProcessor::updateSleepThreshold(double sampleRate) {
+    const double tailSeconds = plugin->getTailLengthSeconds();
+
+    // 尾音无限长、会自行产生MIDI或没有任何输入（无法被唤醒）的插件不休眠
+    const bool canSleep = std::isfinite(tailSeconds)
+                       && tailSeconds <= maxSleepTailSeconds
+                       && !plugin->producesMidi()
+                       && (getTotalNumInputChannels() > 0 || plugin->acceptsMidi())
+                       && sampleRate > 0.0;
+
+    if (!canSleep) {
+        sleepThresholdSamples.store(-1, std::memory_order_relaxed);
+        return;
+    }
+
+    // 至少一个完整块，再加上尾音和延迟
+    const auto tailSamples = static_cast<juce::int64>(std::ceil(std::max(0.0, tailSeconds) * sampleRate));
+    const auto threshold = tailSamples + plugin->getLatencySamples() + std::max(1, getBlockSize());
+    sleepThresholdSamples.store(threshold, std::memory_order_relaxed);
+}
+
+template <typename SampleType>
+bool ProfiledPluginProcessor::isSilent(const juce::AudioBuffer<SampleType>& buffer, int firstChannel, int numChannels) noexcept {
+    const int numSamples = buffer.getNumSamples();
+    const int endChannel = std::min(buffer.getNumChannels(), firstChannel + numChannels);
+
+    for (int channel = firstChannel; channel < endChannel; ++channel) {
+        // 向量化的最小/最大值查找
+        const auto range = juce::FloatVectorOperations::findMinAndMax(buffer.getReadPointer(channel), numSamples);
+        if (range.getStart() < -silenceThreshold || range.getEnd() > silenceThreshold) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+//==============================================================================
+// 参数自动化
+//==============================================================================
+
+int ProfiledPluginProcessor::queueParameterChanges(const std::vector<ParameterEvent>& events) {
+    markStateChanged();
+
+    // 镜像立即反映宿主设置的目标值
+    for (const auto& event : events) {
+        parameterCache.setValue(event.parameterIndex, juce::jlimit(0.0f, 1.0f, event.value));
+    }
+
+    if (isBeingProcessed()) {
+        return automation.push(events);
+    }
+
+    // 没有音频线程消费队列，在调用线程上按顺序直接设置（过渡直接跳到目标值）
+    const auto& parameters = plugin->getParameters();
+    int numApplied = 0;
+    for (const auto& event : events) {
+        if (event.parameterIndex >= 0 && event.parameterIndex < parameters.size()) {
+            if (auto* parameter = parameters[event.parameterIndex]) {
+                parameter->setValue(juce::jlimit(0.0f, 1.0f, event.value));
+                numApplied++;
+            }
+        }
+    }
+    return numApplied;
+}
+
+const ParameterCache& ProfiledPluginProcessor::getParameterCache() {
+    parameterCache.update(*plugin);
+    return parameterCache;
+}
+
+bool ProfiledPluginProcessor::isBeingProcessed() const noexcept {
+    if (!prepared.load(std::memory_order_relaxed)) {
+        return false;
+    }
+
+    const auto elapsed = juce::Time::getMillisecondCounter() - lastProcessTime.load(std::memory_order_relaxed);
+    return elapsed < static_cast<juce::uint32>(Constants::PARAMETER_IDLE_TIMEOUT_MS);
+}
+
+template <typename SampleType>
+void ProfiledPluginProcessor::processAutomated(juce::AudioBuffer<SampleType>& buffer, juce::MidiBuffer& midiMessages) {
+    const int numSamples = buffer.getNumSamples();
+
+    if (!automation.beginBlock(numSamples)) {
+        plugin->processBlock(buffer, midiMessages);
+        return;
+    }
+
+    // 所有事件都在块起点时不需要切分
+    int end = automation.applyEvents(*plugin, 0);
+    if (end >= numSamples) {
+        plugin->processBlock(buffer, midiMessages);
+        automation.endBlock(numSamples);
+        return;
+    }
+
+    // 按参数变化的位置切分成子块，MIDI事件按子块重新定位
+    automatedMidiOutput.clear();
+    int position = 0;
+    while (position < numSamples) {
+        if (position > 0) {
+            end = automation.applyEvents(*plugin, position);
+        }
+
+        const int length = end - position;
+        juce::AudioBuffer<SampleType> subBuffer(buffer.getArrayOfWritePointers(), buffer.getNumChannels(),
+                                                position, length);
+
+        subBlockMidi.clear();
+        for (auto it = midiMessages.findNextSamplePosition(position); it != midiMessages.cend(); ++it) {
+            const auto metadata = *it;
+            if (metadata.samplePosition >= end) {
+                break;
+            }
+            subBlockMidi.addEvent(metadata.data, metadata.numBytes, metadata.samplePosition - position);
+        }
+
+        plugin->processBlock(subBuffer, subBlockMidi);
+        automatedMidiOutput.addEvents(subBlockMidi, 0, -1, position);
+        position = end;
+    }
+
+    midiMessages.swapWith(automatedMidiOutput);
+    automation.endBlock(numSamples);
+}
+
+//==============================================================================
+// AudioProcessor 接口实现
+//==============================================================================
+
+const juce::String ProfiledPluginProcessor::getName() const {
+    return plugin->getName();
+}
+
+void ProfiledPluginProcessor::prepareToPlay(double sampleRate, int samplesPerBlock) {
+    plugin->setRateAndBufferSizeDetails(sampleRate, samplesPerBlock);
+    plugin->setProcessingPrecision(getProcessingPrecision());
+    plugin->prepareToPlay(sampleRate, samplesPerBlock);
+    setLatencySamples(plugin->getLatencySamples());
+
+    subBlockMidi.ensureSize(static_cast<size_t>(Constants::MIDI_BUFFER_RESERVE_BYTES));
+    automatedMidiOutput.ensureSize(static_cast<size_t>(Constants::MIDI_BUFFER_RESERVE_BYTES));
+
+    silentSamples = 0;
+    sleeping.store(false, std::memory_order_relaxed);
+    updateSleepThreshold(sampleRate);
+    prepared.store(true);
+}
+
+void ProfiledPluginProcessor::releaseResources() {
+    prepared.store(false);
+    automation.reset();
+    plugin->releaseResources();
+}
+
+void ProfiledPluginProcessor::processBlock(juce::AudioBuffer<float>& buffer, juce::MidiBuffer& midiMessages) {
+    processProfiled(buffer, midiMessages);
+}
+
+void ProfiledPluginProcessor::processBlock(juce::AudioBuffer<double>& buffer, juce::MidiBuffer& midiMessages) {
+    processProfiled(buffer, midiMessages);
+}
+
+void ProfiledPluginProcessor::processBlockBypassed(juce::AudioBuffer<float>& buffer, juce::MidiBuffer& midiMessages) {
+    // 旁路时不需要采样精度，排队的参数变化直接应用
+    lastProcessTime.store(juce::Time::getMillisecondCounter(), std::memory_order_relaxed);
+    automation.flush(*plugin);
+    plugin->processBlockBypassed(buffer, midiMessages);
+}
+
+void ProfiledPluginProcessor::processBlockBypassed(juce::AudioBuffer<double>& buffer, juce::MidiBuffer& midiMessages) {
+    lastProcessTime.store(juce::Time::getMillisecondCounter(), std::memory_order_relaxed);
+    automation.flush(*plugin);
+    plugin->processBlockBypassed(buffer, midiMessages);
+}
+
+bool ProfiledPluginProcessor::supportsDoublePrecisionProcessing() const {
+    return plugin->supportsDoublePrecisionProcessing();
+}
+
+void ProfiledPluginProcessor::reset() {
+    plugin->reset();
+}
+
+void ProfiledPluginProcessor::setNonRealtime(bool isNonRealtime) noexcept {
+    AudioProcessor::setNonRealtime(isNonRealtime);
+    plugin->setNonRealtime(isNonRealtime);
+}
+
+double ProfiledPluginProcessor::getTailLengthSeconds() const {
+    return plugin->getTailLengthSeconds();
+}
+
+bool ProfiledPluginProcessor::acceptsMidi() const {
+    return plugin->acceptsMidi();
+}
+
+bool ProfiledPluginProcessor::producesMidi() const {
+    return plugin->producesMidi();
+}
+
+bool ProfiledPluginProcessor::isMidiEffect() const {
+    return plugin->isMidiEffect();
+}
+
+juce::AudioProcessorParameter* ProfiledPluginProcessor::getBypassParameter() const {
+    return plugin->getBypassParameter();
+}
+
+int ProfiledPluginProcessor::getNumPrograms() {
+    return plugin->getNumPrograms();
+}
+
+int ProfiledPluginProcessor::getCurrentProgram() {
+    return plugin->getCurrentProgram();
+}
+
+void ProfiledPluginProcessor::setCurrentProgram(int index) {
+    plugin->setCurrentProgram(index);
+    invalidateParameterValues();
+}
+
+const juce::String ProfiledPluginProcessor::getProgramName(int index) {
+    return plugin->getProgramName(index);
+}
+
+void ProfiledPluginProcessor::changeProgramName(int index, const juce::String& newName) {
+    plugin->changeProgramName(index, newName);
+    markStateChanged();
+}
+
+void ProfiledPluginProcessor::getStateInformation(juce::MemoryBlock& destData) {
+    plugin->getStateInformation(destData);
+}
+
+void ProfiledPluginProcessor::setStateInformation(const void* data, int sizeInBytes) {
+    plugin->setStateInformation(data, sizeInBytes);
+    invalidateParameterValues();
+}
+
+bool ProfiledPluginProcessor::isBusesLayoutSupported(const BusesLayout& layouts) const {
+    return plugin->checkBusesLayoutSupported(layouts);
+}
+
+void ProfiledPluginProcessor::processorLayoutsChanged() {
+    plugin->setBusesLayout(getBusesLayout());
+}
+
+void ProfiledPluginProcessor::audioProcessorChanged(juce::AudioProcessor*, const ChangeDetails& details) {
+    // 内部插件的延迟变化需要反映到包装处理器，音频图据此计算延迟补偿
+    if (details.latencyChanged) {
+        setLatencySamples(plugin->getLatencySamples());
+        updateSleepThreshold(getSampleRate());
+    }
+    if (details.parameterInfoChanged) {
+        parameterCache.invalidateMetadata();
+    }
+    if (details.programChanged || details.nonParameterStateChanged) {
+        invalidateParameterValues();
+    }
+    updateHostDisplay(details);
+}
+
+void ProfiledPluginProcessor::audioProcessorParameterChanged(juce::AudioProcessor*, int parameterIndex, float newValue) {
+    // 插件自身发出的参数变化（编辑器、内部调制等），可能来自音频线程
+    parameterCache.setValue(parameterIndex, newValue);
+    markStateChanged();
+}
+
+//==============================================================================
+// 辅助函数
+//==============================================================================
+
+juce::AudioPluginInstance* getHostedPluginInstance(juce::AudioProcessor* processor) noexcept {
+    if (auto* profiled = dynamic_cast<ProfiledPluginProcessor*>(processor)) {
+        return &profiled->getPluginInstance();
+    }
+    return dynamic_cast<juce::AudioPluginInstance*>(processor);
+}
+
+} // namespace WindsynthVST::AudioGraph
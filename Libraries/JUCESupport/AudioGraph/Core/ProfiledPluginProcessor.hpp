@@ -0,0 +1,238 @@
+//
+//  ProfiledPluginProcessor.hpp
+//  WindsynthRecorder
+//
+//  Created by AI Assistant
+//  带处理耗时统计的插件包装处理器
+//
+
+#pragma once
+
+#include <JuceHeader.h>
+#include <memory>
+#include <atomic>
+#include <cstdint>
+#include <vector>
+#include <cmath>
+#include "ParameterAutomation.hpp"
+#include "ParameterCache.hpp"
+
+namespace WindsynthVST::AudioGraph {
+
+/**
+ * 插件包装处理器
+ *
+ * 音频图中的每个插件节点都由它包装：所有调用原样转发给内部插件，
+ * 启用统计时在 processBlock 前后计时并写入无锁计数器（只有音频线程写入）。
+ * 参数变化通过自动化队列在音频线程中按采样偏移应用，需要时把块切分成子块。
+ * 参数元数据和参数值缓存在 ParameterCache 中，查询参数不需要调用插件。
+ * 参数、编辑器等需要插件实例的操作应通过 getHostedPluginInstance 取得内部插件。
+ *
+ * 可选的静音休眠：输入和输出都保持数字静音超过插件尾音（和延迟）长度后跳过插件处理、
+ * 直接输出静音；输入出现信号或收到MIDI时立即恢复处理。尾音长度为无限的插件不会休眠。
+ */
+class ProfiledPluginProcessor : public juce::AudioProcessor,
+                                private juce::AudioProcessorListener {
+public:
+    /**
+     * 处理耗时统计
+     */
+    struct Profile {
+        double averageTimeMs = 0.0;
+        double peakTimeMs = 0.0;
+        double lastTimeMs = 0.0;
+        double averageBlockSamples = 0.0;
+        uint64_t blocks = 0;
+    };
+
+    /**
+     * 构造函数
+     * @param plugin 被包装的插件实例
+     * @param profilingEnabled 统计开关（由所属音频图持有，生命周期长于本对象）
+     */
+    ProfiledPluginProcessor(std::unique_ptr<juce::AudioPluginInstance> plugin,
+                            const std::atomic<bool>& profilingEnabled);
+    ~ProfiledPluginProcessor() override;
+
+    /**
+     * 获取内部插件实例
+     */
+    juce::AudioPluginInstance& getPluginInstance() const noexcept { return *plugin; }
+
+    /**
+     * 取出内部插件实例（用于实例池复用）
+     * 只能在节点已从图中移除、且不再被任何渲染序列引用之后调用，之后本对象不能再使用
+     */
+    std::unique_ptr<juce::AudioPluginInstance> releasePluginInstance();
+
+    /**
+     * 获取处理耗时统计（任意线程）
+     */
+    Profile getProfile() const noexcept;
+
+    /**
+     * 清零统计（任意线程）
+     */
+    void resetProfile() noexcept;
+    
+    /**
+     * 排队参数变化（任意线程），节点下一次处理时按采样偏移应用
+     * 节点当前没有被处理（设备停止、尚未准备等）时直接设置参数
+     * @return 成功排队或设置的事件数量
+     */
+    int queueParameterChanges(const std::vector<ParameterEvent>& events);
+    
+    /**
+     * 节点最近是否被音频线程处理过
+     */
+    bool isBeingProcessed() const noexcept;
+    
+    /**
+     * 获取参数自动化统计（任意线程）
+     */
+    ParameterAutomation::Statistics getAutomationStatistics() const noexcept { return automation.getStatistics(); }
+    
+    /**
+     * 获取参数缓存（非音频线程，返回前按需重建）
+     */
+    const ParameterCache& getParameterCache();
+    
+    /**
+     * 直接修改了内部插件的状态后调用（任意线程），下次查询时重新读取参数值
+     */
+    void invalidateParameterValues() noexcept {
+        parameterCache.invalidateValues();
+        markStateChanged();
+    }
+    
+    /**
+     * 插件状态版本（任意线程）
+     *
+     * 宿主设置参数、切换程序、恢复状态以及插件报告参数或状态变化时递增。
+     * 版本不变时可以复用上次保存的状态，不需要重新调用 getStateInformation()。
+     */
+    uint32_t getStateGeneration() const noexcept { return stateGeneration.load(std::memory_order_acquire); }
+
+    //==============================================================================
+    // 静音休眠
+    //==============================================================================
+
+    /**
+     * 启用或禁用静音休眠（任意线程，默认禁用）
+     */
+    void setSleepWhenSilent(bool shouldSleep) noexcept;
+    bool isSleepWhenSilentEnabled() const noexcept { return sleepWhenSilent.load(std::memory_order_relaxed); }
+
+    /**
+     * 节点当前是否处于休眠状态（任意线程）
+     */
+    bool isSleeping() const noexcept { return sleeping.load(std::memory_order_relaxed); }
+
+    /**
+     * 休眠期间跳过的块数（任意线程）
+     */
+    uint64_t getSleptBlocks() const noexcept { return sleptBlocks.load(std::memory_order_relaxed); }
+
+    //==============================================================================
+    // AudioProcessor 接口（转发给内部插件）
+    //==============================================================================
+
+    const juce::String getName() const override;
+    void prepareToPlay(double sampleRate, int samplesPerBlock) override;
+    void releaseResources() override;
+    void processBlock(juce::AudioBuffer<float>& buffer, juce::MidiBuffer& midiMessages) override;
+    void processBlock(juce::AudioBuffer<double>& buffer, juce::MidiBuffer& midiMessages) override;
+    void processBlockBypassed(juce::AudioBuffer<float>& buffer, juce::MidiBuffer& midiMessages) override;
+    void processBlockBypassed(juce::AudioBuffer<double>& buffer, juce::MidiBuffer& midiMessages) override;
+    bool supportsDoublePrecisionProcessing() const override;
+    void reset() override;
+    void setNonRealtime(bool isNonRealtime) noexcept override;
+
+    double getTailLengthSeconds() const override;
+    bool acceptsMidi() const override;
+    bool producesMidi() const override;
+    bool isMidiEffect() const override;
+    juce::AudioProcessorParameter* getBypassParameter() const override;
+
+    // 编辑器通过内部插件实例打开（参见 PluginManager::showPluginEditor）
+    bool hasEditor() const override { return false; }
+    juce::AudioProcessorEditor* createEditor() override { return nullptr; }
+
+    int getNumPrograms() override;
+    int getCurrentProgram() override;
+    void setCurrentProgram(int index) override;
+    const juce::String getProgramName(int index) override;
+    void changeProgramName(int index, const juce::String& newName) override;
+
+    void getStateInformation(juce::MemoryBlock& destData) override;
+    void setStateInformation(const void* data, int sizeInBytes) override;
+
+protected:
+    bool isBusesLayoutSupported(const BusesLayout& layouts) const override;
+    void processorLayoutsChanged() override;
+
+private:
+    std::unique_ptr<juce::AudioPluginInstance> plugin;
+    const std::atomic<bool>& profilingEnabled;
+
+    // 无锁计数器（音频线程写入，任意线程读取）
+    std::atomic<uint64_t> totalTicks{0};
+    std::atomic<uint64_t> peakTicks{0};
+    std::atomic<uint64_t> lastTicks{0};
+    std::atomic<uint64_t> totalSamples{0};
+    std::atomic<uint64_t> blockCount{0};
+
+    // 参数自动化（子块处理使用的MIDI缓冲区在 prepareToPlay 中预分配）
+    ParameterAutomation automation;
+    juce::MidiBuffer subBlockMidi;
+    juce::MidiBuffer automatedMidiOutput;
+    std::atomic<juce::uint32> lastProcessTime{0};
+    std::atomic<bool> prepared{false};
+
+    ParameterCache parameterCache;
+    std::atomic<uint32_t> stateGeneration{1};
+
+    // 静音休眠
+    std::atomic<bool> sleepWhenSilent{false};
+    std::atomic<bool> sleeping{false};
+    std::atomic<uint64_t> sleptBlocks{0};
+    juce::int64 silentSamples = 0;                          // 仅音频线程访问
+    std::atomic<juce::int64> sleepThresholdSamples{-1};     // 小于0表示不能休眠（例如尾音无限长）
+
+    void markStateChanged() noexcept { stateGeneration.fetch_add(1, std::memory_order_acq_rel); }
+
+    static BusesProperties getBusesPropertiesFor(const juce::AudioPluginInstance& instance);
+
+    template <typename SampleType>
+    void processProfiled(juce::AudioBuffer<SampleType>& buffer, juce::MidiBuffer& midiMessages);
+
+    template <typename SampleType>
+    void processAutomated(juce::AudioBuffer<SampleType>& buffer, juce::MidiBuffer& midiMessages);
+
+    /**
+     * 静音休眠检查，返回true时本块已输出静音，不需要调用插件
+     */
+    template <typename SampleType>
+    bool processSleeping(juce::AudioBuffer<SampleType>& buffer, const juce::MidiBuffer& midiMessages);
+
+    template <typename SampleType>
+    void updateSilence(const juce::AudioBuffer<SampleType>& buffer, bool inputSilent) noexcept;
+
+    void updateSleepThreshold(double sampleRate);
+
+    template <typename SampleType>
+    static bool isSilent(const juce::AudioBuffer<SampleType>& buffer, int firstChannel, int numChannels) noexcept;
+
+    void audioProcessorParameterChanged(juce::AudioProcessor*, int parameterIndex, float newValue) override;
+    void audioProcessorChanged(juce::AudioProcessor* processor, const ChangeDetails& details) override;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(ProfiledPluginProcessor)
+};
+
+/**
+ * 取得节点处理器对应的插件实例（自动解开包装）
+ * @return 不是插件节点时返回nullptr
+ */
+juce::AudioPluginInstance* getHostedPluginInstance(juce::AudioProcessor* processor) noexcept;
+
+} // namespace WindsynthVST::AudioGraph
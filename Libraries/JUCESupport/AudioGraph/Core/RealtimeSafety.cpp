@@ -0,0 +1,146 @@
+//
+//  RealtimeSafety.cpp
+//  WindsynthRecorder
+//
+//  Created by AI Assistant
+//  音频回调实时安全检查工具实现
+//
+
+#include "RealtimeSafety.hpp"
+#include <cstdlib>
+#include <new>
+
+#ifndef WINDSYNTH_REALTIME_ALLOCATION_CHECKS
+ #define WINDSYNTH_REALTIME_ALLOCATION_CHECKS 0
+#endif
+
+namespace WindsynthVST::AudioGraph {
+
+namespace RealtimeSafety {
+
+//==============================================================================
+// 内部状态
+//==============================================================================
+
+namespace {
+    thread_local int audioCallbackDepth = 0;
+    thread_local int nonRealtimeAllowedDepth = 0;
+    thread_local bool isReporting = false;
+
+    std::atomic<uint64_t> violationCount{0};
+    std::atomic<const char*> lastViolation{nullptr};
+    std::atomic<bool> assertOnViolation{true};
+}
+
+//==============================================================================
+// 作用域标记实现
+//==============================================================================
+
+ScopedAudioCallback::ScopedAudioCallback() noexcept {
+    ++audioCallbackDepth;
+}
+
+ScopedAudioCallback::~ScopedAudioCallback() noexcept {
+    --audioCallbackDepth;
+}
+
+ScopedNonRealtimeAllowed::ScopedNonRealtimeAllowed() noexcept {
+    ++nonRealtimeAllowedDepth;
+}
+
+ScopedNonRealtimeAllowed::~ScopedNonRealtimeAllowed() noexcept {
+    --nonRealtimeAllowedDepth;
+}
+
+//==============================================================================
+// 违规记录实现
+//==============================================================================
+
+bool isInAudioCallback() noexcept {
+    return audioCallbackDepth > 0 && nonRealtimeAllowedDepth == 0;
+}
+
+void reportViolation(const char* what) noexcept {
+    // 断言本身可能分配内存，避免递归
+    if (isReporting) {
+        return;
+    }
+
+    isReporting = true;
+    violationCount.fetch_add(1, std::memory_order_relaxed);
+    lastViolation.store(what, std::memory_order_relaxed);
+
+    if (assertOnViolation.load(std::memory_order_relaxed)) {
+        jassertfalse;
+    }
+
+    isReporting = false;
+}
+
+uint64_t getViolationCount() noexcept {
+    return violationCount.load(std::memory_order_relaxed);
+}
+
+const char* getLastViolation() noexcept {
+    auto* what = lastViolation.load(std::memory_order_relaxed);
+    return what != nullptr ? what : "";
+}
+
+void resetViolationCount() noexcept {
+    violationCount.store(0, std::memory_order_relaxed);
+    lastViolation.store(nullptr, std::memory_order_relaxed);
+}
+
+void setAssertOnViolation(bool shouldAssert) noexcept {
+    assertOnViolation.store(shouldAssert, std::memory_order_relaxed);
+}
+
+} // namespace RealtimeSafety
+
+} // namespace WindsynthVST::AudioGraph
+
+//==============================================================================
+// 全局分配钩子（可选）
+//==============================================================================
+
+#if WINDSYNTH_REALTIME_ALLOCATION_CHECKS
+
+namespace {
+    inline void checkAllocation() noexcept {
+        WindsynthVST::AudioGraph::RealtimeSafety::checkNotInAudioCallback("在音频回调中分配或释放堆内存");
+    }
+
+    inline void* checkedAllocate(std::size_t size) {
+        checkAllocation();
+        if (auto* ptr = std::malloc(size == 0 ? 1 : size)) {
+            return ptr;
+        }
+        throw std::bad_alloc();
+    }
+
+    inline void* checkedAllocateNoThrow(std::size_t size) noexcept {
+        checkAllocation();
+        return std::malloc(size == 0 ? 1 : size);
+    }
+
+    inline void checkedFree(void* ptr) noexcept {
+        if (ptr != nullptr) {
+            checkAllocation();
+            std::free(ptr);
+        }
+    }
+}
+
+void* operator new(std::size_t size) { return checkedAllocate(size); }
+void* operator new[](std::size_t size) { return checkedAllocate(size); }
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept { return checkedAllocateNoThrow(size); }
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept { return checkedAllocateNoThrow(size); }
+
+void operator delete(void* ptr) noexcept { checkedFree(ptr); }
+void operator delete[](void* ptr) noexcept { checkedFree(ptr); }
+void operator delete(void* ptr, std::size_t) noexcept { checkedFree(ptr); }
+void operator delete[](void* ptr, std::size_t) noexcept { checkedFree(ptr); }
+void operator delete(void* ptr, const std::nothrow_t&) noexcept { checkedFree(ptr); }
+void operator delete[](void* ptr, const std::nothrow_t&) noexcept { checkedFree(ptr); }
+
+#endif
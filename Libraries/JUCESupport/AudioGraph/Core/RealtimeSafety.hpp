@@ -0,0 +1,124 @@
+//
+//  RealtimeSafety.hpp
+//  WindsynthRecorder
+//
+//  Created by AI Assistant
+//  音频回调实时安全检查工具
+//
+
+#pragma once
+
+#include <JuceHeader.h>
+#include <atomic>
+#include <mutex>
+#include <cstdint>
+
+namespace WindsynthVST::AudioGraph {
+
+/**
+ * 实时安全检查
+ *
+ * 音频回调中禁止分配内存和获取互斥锁。这里提供：
+ * - ScopedAudioCallback：标记当前线程正处于音频回调中
+ * - RealtimeCheckedMutex：在音频回调中被加锁时记录违规
+ * - 可选的全局 operator new/delete 钩子（定义 WINDSYNTH_REALTIME_ALLOCATION_CHECKS=1 时启用）
+ *
+ * 违规会累加全局计数器，调试构建下还会触发断言。
+ */
+namespace RealtimeSafety {
+
+    /**
+     * 标记当前线程进入音频回调（RAII）
+     */
+    class ScopedAudioCallback {
+    public:
+        ScopedAudioCallback() noexcept;
+        ~ScopedAudioCallback() noexcept;
+
+        JUCE_DECLARE_NON_COPYABLE(ScopedAudioCallback)
+    };
+
+    /**
+     * 临时允许非实时操作（用于已知且可接受的例外，如首次分配）
+     */
+    class ScopedNonRealtimeAllowed {
+    public:
+        ScopedNonRealtimeAllowed() noexcept;
+        ~ScopedNonRealtimeAllowed() noexcept;
+
+        JUCE_DECLARE_NON_COPYABLE(ScopedNonRealtimeAllowed)
+    };
+
+    /**
+     * 当前线程是否处于音频回调中
+     */
+    bool isInAudioCallback() noexcept;
+
+    /**
+     * 记录一次实时违规
+     * @param what 违规描述（必须是静态字符串）
+     */
+    void reportViolation(const char* what) noexcept;
+
+    /**
+     * 获取累计违规次数
+     */
+    uint64_t getViolationCount() noexcept;
+
+    /**
+     * 获取最近一次违规描述
+     */
+    const char* getLastViolation() noexcept;
+
+    /**
+     * 重置违规计数
+     */
+    void resetViolationCount() noexcept;
+
+    /**
+     * 设置违规时是否触发断言（默认启用，仅调试构建有效）
+     */
+    void setAssertOnViolation(bool shouldAssert) noexcept;
+
+    /**
+     * 在音频回调中调用时记录违规
+     */
+    inline void checkNotInAudioCallback(const char* what) noexcept {
+        if (isInAudioCallback()) {
+            reportViolation(what);
+        }
+    }
+
+} // namespace RealtimeSafety
+
+/**
+ * 带实时检查的互斥锁
+ *
+ * 接口与 std::mutex 相同，可直接用于 std::lock_guard。
+ * 在音频回调中加锁时记录违规。
+ */
+class RealtimeCheckedMutex {
+public:
+    RealtimeCheckedMutex() = default;
+
+    void lock() {
+        RealtimeSafety::checkNotInAudioCallback("在音频回调中获取互斥锁");
+        mutex.lock();
+    }
+
+    bool try_lock() {
+        RealtimeSafety::checkNotInAudioCallback("在音频回调中尝试获取互斥锁");
+        return mutex.try_lock();
+    }
+
+    void unlock() {
+        mutex.unlock();
+    }
+
+private:
+    std::mutex mutex;
+
+    JUCE_DECLARE_NON_COPYABLE(RealtimeCheckedMutex)
+};
+
+} // namespace WindsynthVST::AudioGraph
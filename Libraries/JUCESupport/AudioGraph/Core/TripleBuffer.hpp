@@ -0,0 +1,79 @@
+//
+//  TripleBuffer.hpp
+//  WindsynthRecorder
+//
+//  Created by AI Assistant
+//  单写者单读者无等待三缓冲
+//
+
+#pragma once
+
+#include <array>
+#include <atomic>
+
+namespace WindsynthVST::AudioGraph {
+
+/**
+ * 三缓冲快照通道（单写者、单读者，双方都无等待）
+ *
+ * 写者在后缓冲区中填写完整的新值后调用 publish，把后缓冲区与中间缓冲区交换；
+ * 读者调用 read 时，如果中间缓冲区有新值就与前缓冲区交换。
+ * 双方都只做一次原子交换，不会互相等待，读者总能拿到最近一次完整发布的值。
+ *
+ * 注意：publish 后拿到的后缓冲区内容是旧数据，写者每次都必须写完整个对象。
+ */
+template <typename T>
+class TripleBuffer {
+public:
+    TripleBuffer() = default;
+
+    //==============================================================================
+    // 写者接口
+    //==============================================================================
+
+    /**
+     * 获取后缓冲区（仅写者线程调用）
+     */
+    T& getWriteBuffer() noexcept {
+        return buffers[static_cast<size_t>(backIndex)];
+    }
+
+    /**
+     * 发布后缓冲区中的新值（仅写者线程调用）
+     */
+    void publish() noexcept {
+        const int previous = middle.exchange(backIndex | freshFlag, std::memory_order_acq_rel);
+        backIndex = previous & indexMask;
+    }
+
+    //==============================================================================
+    // 读者接口
+    //==============================================================================
+
+    /**
+     * 取得最近发布的值（仅读者线程调用）
+     * @param isNew 可选，返回自上次读取以来是否有新值
+     */
+    const T& read(bool* isNew = nullptr) noexcept {
+        const bool fresh = (middle.load(std::memory_order_relaxed) & freshFlag) != 0;
+        if (fresh) {
+            const int previous = middle.exchange(frontIndex, std::memory_order_acq_rel);
+            frontIndex = previous & indexMask;
+        }
+        if (isNew != nullptr) {
+            *isNew = fresh;
+        }
+        return buffers[static_cast<size_t>(frontIndex)];
+    }
+
+private:
+    static constexpr int indexMask = 3;
+    static constexpr int freshFlag = 4;
+
+    std::array<T, 3> buffers{};
+    alignas(64) int backIndex = 0;              // 仅写者访问
+    alignas(64) std::atomic<int> middle{1};     // 中间缓冲区索引 + 新值标记
+    alignas(64) int frontIndex = 2;             // 仅读者访问
+};
+
+} // namespace WindsynthVST::AudioGraph
@@ -0,0 +1,222 @@
+//
+//  AudioDeviceRegistry.cpp
+//  WindsynthRecorder
+//
+//  Created by AI Assistant
+//  音频设备注册表实现
+//
+
+#include "AudioDeviceRegistry.hpp"
+#include "../Core/Logger.hpp"
+#include <algorithm>
+
+namespace WindsynthVST::AudioGraph {
+
+namespace {
+
+bool isSameDevice(const AudioDeviceRegistry::DeviceInfo& a, const AudioDeviceRegistry::DeviceInfo& b) {
+    return a.name == b.name && a.type == b.type;
+}
+
+} // namespace
+
+//==============================================================================
+// 构造函数和析构函数
+//==============================================================================
+
+AudioDeviceRegistry::AudioDeviceRegistry(juce::AudioDeviceManager& deviceManager)
+    : juce::Thread("Audio Device Registry"),
+      deviceManager(deviceManager)
+{
+    deviceManager.addChangeListener(this);
+    startThread(juce::Thread::Priority::low);
+}
+
+AudioDeviceRegistry::~AudioDeviceRegistry() {
+    deviceManager.removeChangeListener(this);
+    stopThread(4000);
+}
+
+//==============================================================================
+// 查询
+//==============================================================================
+
+std::vector<AudioDeviceRegistry::DeviceInfo> AudioDeviceRegistry::getDevices() const {
+    std::lock_guard<std::mutex> lock(devicesMutex);
+    return devices;
+}
+
+bool AudioDeviceRegistry::findDevice(const std::string& name, DeviceInfo& info) const {
+    std::lock_guard<std::mutex> lock(devicesMutex);
+    auto it = std::find_if(devices.begin(), devices.end(), [&name](const DeviceInfo& device) {
+        return device.name == name;
+    });
+    if (it == devices.end()) {
+        return false;
+    }
+
+    info = *it;
+    return true;
+}
+
+bool AudioDeviceRegistry::isDeviceAvailable(const std::string& name) const {
+    DeviceInfo info;
+    return findDevice(name, info) && info.isAvailable;
+}
+
+bool AudioDeviceRegistry::waitForInitialScan(int timeoutMs) const {
+    return initialScanCompleted.load() || initialScanEvent.wait(static_cast<double>(timeoutMs));
+}
+
+//==============================================================================
+// 控制
+//==============================================================================
+
+void AudioDeviceRegistry::requestRescan() {
+    rescanPending.store(true);
+    notify();
+}
+
+void AudioDeviceRegistry::setChangeCallback(ChangeCallback callback) {
+    std::lock_guard<std::mutex> lock(callbackMutex);
+    changeCallback = std::move(callback);
+}
+
+void AudioDeviceRegistry::changeListenerCallback(juce::ChangeBroadcaster*) {
+    // 设备管理器在设备列表和当前设备设置变化时都会广播，是否真的有设备变化由扫描结果决定
+    requestRescan();
+}
+
+//==============================================================================
+// 扫描线程
+//==============================================================================
+
+void AudioDeviceRegistry::run() {
+    // 设备类型实例只在扫描线程中创建和使用
+    juce::OwnedArray<juce::AudioIODeviceType> deviceTypes;
+    deviceManager.createAudioDeviceTypes(deviceTypes);
+
+    while (!threadShouldExit()) {
+        if (rescanPending.exchange(false)) {
+            rescan(deviceTypes);
+
+            if (!initialScanCompleted.exchange(true)) {
+                initialScanEvent.signal();
+            }
+            continue;
+        }
+
+        wait(-1);
+    }
+}
+
+void AudioDeviceRegistry::rescan(juce::OwnedArray<juce::AudioIODeviceType>& deviceTypes) {
+    const auto startTime = juce::Time::getMillisecondCounterHiRes();
+    const auto previous = getDevices();
+
+    std::vector<DeviceInfo> scanned;
+    int numDescribed = 0;
+
+    for (auto* deviceType : deviceTypes) {
+        if (threadShouldExit()) {
+            return;
+        }
+
+        deviceType->scanForDevices();
+
+        const auto outputNames = deviceType->getDeviceNames(false);
+        const auto inputNames = deviceType->getDeviceNames(true);
+        const int defaultOutputIndex = deviceType->getDefaultDeviceIndex(false);
+
+        auto allNames = outputNames;
+        allNames.addArray(inputNames);
+        allNames.removeDuplicates(false);
+
+        for (const auto& name : allNames) {
+            DeviceInfo info;
+            info.name = name.toStdString();
+            info.type = deviceType->getTypeName().toStdString();
+
+            // 已知设备沿用缓存的详细信息，只有新设备才需要创建设备对象
+            auto known = std::find_if(previous.begin(), previous.end(), [&info](const DeviceInfo& device) {
+                return isSameDevice(device, info);
+            });
+            if (known != previous.end()) {
+                info = *known;
+            } else {
+                info = describeDevice(*deviceType, name, inputNames.contains(name), outputNames.contains(name));
+                ++numDescribed;
+            }
+
+            info.isDefault = defaultOutputIndex >= 0 && outputNames.indexOf(name) == defaultOutputIndex;
+            scanned.push_back(std::move(info));
+        }
+    }
+
+    std::vector<std::pair<DeviceInfo, bool>> changes;
+    for (const auto& device : scanned) {
+        if (std::none_of(previous.begin(), previous.end(), [&device](const DeviceInfo& old) { return isSameDevice(old, device); })) {
+            changes.emplace_back(device, true);
+        }
+    }
+    for (const auto& device : previous) {
+        if (std::none_of(scanned.begin(), scanned.end(), [&device](const DeviceInfo& now) { return isSameDevice(now, device); })) {
+            changes.emplace_back(device, false);
+        }
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(devicesMutex);
+        devices = std::move(scanned);
+    }
+
+    const bool initialScan = scanCount.fetch_add(1) == 0;
+    WSLOG_INFO("AudioDeviceRegistry", (initialScan ? "首次扫描" : "重新扫描") << "音频设备完成，新设备: " << numDescribed
+            << "，变化: " << (initialScan ? 0 : changes.size())
+            << "，耗时: " << juce::roundToInt(juce::Time::getMillisecondCounterHiRes() - startTime) << "ms");
+
+    // 首次扫描建立基准，不算设备变化
+    if (initialScan || changes.empty()) {
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(callbackMutex);
+    if (!changeCallback) {
+        return;
+    }
+    for (const auto& [device, connected] : changes) {
+        WSLOG_INFO("AudioDeviceRegistry", "音频设备" << (connected ? "连接" : "断开") << ": " << device.name);
+        changeCallback(device, connected);
+    }
+}
+
+AudioDeviceRegistry::DeviceInfo AudioDeviceRegistry::describeDevice(juce::AudioIODeviceType& deviceType,
+                                                                    const juce::String& name,
+                                                                    bool hasInput, bool hasOutput) {
+    DeviceInfo info;
+    info.name = name.toStdString();
+    info.type = deviceType.getTypeName().toStdString();
+
+    std::unique_ptr<juce::AudioIODevice> device(deviceType.createDevice(hasOutput ? name : juce::String(),
+                                                                        hasInput ? name : juce::String()));
+    if (!device) {
+        info.isAvailable = false;
+        return info;
+    }
+
+    // 设备对象未打开，通道数取设备提供的全部通道
+    info.numInputChannels = device->getInputChannelNames().size();
+    info.numOutputChannels = device->getOutputChannelNames().size();
+
+    for (double rate : device->getAvailableSampleRates()) {
+        info.supportedSampleRates.push_back(rate);
+    }
+    for (int size : device->getAvailableBufferSizes()) {
+        info.supportedBufferSizes.push_back(size);
+    }
+
+    info.isAvailable = true;
+    return info;
+}
+
+} // namespace WindsynthVST::AudioGraph
@@ -0,0 +1,143 @@
+//
+//  AudioDeviceRegistry.hpp
+//  WindsynthRecorder
+//
+//  Created by AI Assistant
+//  音频设备注册表 - 后台扫描设备并缓存，热插拔时增量更新
+//
+
+#pragma once
+
+#include <JuceHeader.h>
+#include <memory>
+#include <vector>
+#include <functional>
+#include <string>
+#include <atomic>
+#include <mutex>
+
+namespace WindsynthVST::AudioGraph {
+
+/**
+ * 音频设备注册表
+ *
+ * 扫描线程使用自己的设备类型实例（与设备管理器正在使用的实例互不干扰）：
+ * 构造后立即完成首次扫描，之后设备管理器广播变化（设备热插拔、默认设备切换等）时重新扫描。
+ * 重新扫描只为新出现的设备创建设备对象读取采样率和缓冲区大小，已知设备沿用缓存的信息。
+ * 比较前后两次结果，只有设备真正出现或消失时才调用变化回调。
+ *
+ * 查询直接返回缓存，不会阻塞在设备扫描上。
+ */
+class AudioDeviceRegistry : private juce::Thread,
+                            private juce::ChangeListener {
+public:
+    //==============================================================================
+    // 类型定义
+    //==============================================================================
+
+    /**
+     * 音频设备信息
+     */
+    struct DeviceInfo {
+        std::string name;
+        std::string type;
+        int numInputChannels = 0;
+        int numOutputChannels = 0;
+        std::vector<double> supportedSampleRates;
+        std::vector<int> supportedBufferSizes;
+        bool isDefault = false;
+        bool isAvailable = true;
+    };
+
+    /**
+     * 设备变化回调（在扫描线程中调用）
+     */
+    using ChangeCallback = std::function<void(const DeviceInfo& device, bool connected)>;
+
+    //==============================================================================
+    // 构造函数和析构函数
+    //==============================================================================
+
+    /**
+     * 构造函数（启动扫描线程并开始首次扫描）
+     * @param deviceManager 设备管理器（必须比本对象存活更久，用于创建设备类型和接收变化广播）
+     */
+    explicit AudioDeviceRegistry(juce::AudioDeviceManager& deviceManager);
+
+    ~AudioDeviceRegistry() override;
+
+    //==============================================================================
+    // 查询
+    //==============================================================================
+
+    /**
+     * 获取缓存的设备列表
+     */
+    std::vector<DeviceInfo> getDevices() const;
+
+    /**
+     * 按名称查找设备
+     * @return 设备不存在时返回false
+     */
+    bool findDevice(const std::string& name, DeviceInfo& info) const;
+
+    bool isDeviceAvailable(const std::string& name) const;
+
+    /**
+     * 等待首次扫描完成
+     * @return 超时返回false
+     */
+    bool waitForInitialScan(int timeoutMs) const;
+
+    bool hasCompletedInitialScan() const { return initialScanCompleted.load(); }
+
+    //==============================================================================
+    // 控制
+    //==============================================================================
+
+    /**
+     * 请求在后台重新扫描（多次请求合并为一次）
+     */
+    void requestRescan();
+
+    void setChangeCallback(ChangeCallback callback);
+
+    uint64_t getScanCount() const { return scanCount.load(); }
+
+private:
+    //==============================================================================
+    // 内部方法
+    //==============================================================================
+
+    // juce::Thread
+    void run() override;
+
+    // juce::ChangeListener（消息线程）
+    void changeListenerCallback(juce::ChangeBroadcaster* source) override;
+
+    void rescan(juce::OwnedArray<juce::AudioIODeviceType>& deviceTypes);
+
+    static DeviceInfo describeDevice(juce::AudioIODeviceType& deviceType, const juce::String& name,
+                                     bool hasInput, bool hasOutput);
+
+    //==============================================================================
+    // 内部成员变量
+    //==============================================================================
+
+    juce::AudioDeviceManager& deviceManager;
+
+    mutable std::mutex devicesMutex;
+    std::vector<DeviceInfo> devices;
+
+    std::atomic<bool> rescanPending{true};
+    std::atomic<bool> initialScanCompleted{false};
+    std::atomic<uint64_t> scanCount{0};
+    mutable juce::WaitableEvent initialScanEvent{true};
+
+    std::mutex callbackMutex;
+    ChangeCallback changeCallback;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(AudioDeviceRegistry)
+};
+
+} // namespace WindsynthVST::AudioGraph
@@ -7,7 +7,8 @@
 //
 
 #include "AudioIOManager.hpp"
-#include <iostream>
+#include "../Core/LevelAnalysis.hpp"
+#include "../Core/Logger.hpp"
 #include <algorithm>
 #include <cmath>
 
@@ -20,29 +21,40 @@ namespace WindsynthVST::AudioGraph {
 AudioIOManager::AudioIOManager(GraphAudioProcessor& graphProcessor)
     : graphProcessor(graphProcessor)
 {
-    std::cout << "[AudioIOManager] 初始化音频I/O管理器" << std::endl;
+    WSLOG_INFO("AudioIOManager", "初始化音频I/O管理器");
     
     initializeDeviceManager();
     createDefaultMappings();
     
-    // 初始化电平监控数组
-    currentLevels.inputLevels.resize(currentConfig.numInputChannels, 0.0f);
-    currentLevels.outputLevels.resize(currentConfig.numOutputChannels, 0.0f);
-    currentLevels.inputPeaks.resize(currentConfig.numInputChannels, 0.0f);
-    currentLevels.outputPeaks.resize(currentConfig.numOutputChannels, 0.0f);
+    // 初始化电平监控（回调使用的电平信息预留最大通道数，回调中不再分配）
+    resizeMeters(currentConfig.numInputChannels, currentConfig.numOutputChannels);
+    callbackLevels.inputLevels.reserve(Constants::MAX_AUDIO_CHANNELS);
+    callbackLevels.outputLevels.reserve(Constants::MAX_AUDIO_CHANNELS);
+    callbackLevels.inputPeaks.reserve(Constants::MAX_AUDIO_CHANNELS);
+    callbackLevels.outputPeaks.reserve(Constants::MAX_AUDIO_CHANNELS);
     
-    inputLevelSmoothers.resize(currentConfig.numInputChannels, 0.0f);
-    outputLevelSmoothers.resize(currentConfig.numOutputChannels, 0.0f);
+    // 电平回调总是经过分发线程，外部分发器设置前使用内部分发器
+    setNotificationDispatcher(nullptr);
+    
+    graphProcessor.addCaptureSink(this);
 }
 
 AudioIOManager::~AudioIOManager() {
-    std::cout << "[AudioIOManager] 析构音频I/O管理器" << std::endl;
+    WSLOG_INFO("AudioIOManager", "析构音频I/O管理器");
+
+    detachNotificationDispatcher();
+
+    deviceRegistry.reset();
 
     if (deviceManager) {
         // 移除音频回调
         deviceManager->removeAudioCallback(&graphProcessor);
+        deviceManager->removeMidiInputDeviceCallback({}, &midiInputCollector);
         deviceManager->closeAudioDevice();
     }
+    graphProcessor.setMidiInputCollector(nullptr);
+    
+    graphProcessor.removeCaptureSink(this);
 }
 
 //==============================================================================
@@ -50,62 +62,33 @@ AudioIOManager::~AudioIOManager() {
 //==============================================================================
 
 std::vector<AudioIOManager::AudioDeviceInfo> AudioIOManager::scanAudioDevices() {
-    std::cout << "[AudioIOManager] 扫描音频设备" << std::endl;
-    
-    std::vector<AudioDeviceInfo> devices;
-    
-    if (!deviceManager) {
-        std::cout << "[AudioIOManager] 设备管理器未初始化" << std::endl;
-        return devices;
+    if (!deviceRegistry) {
+        WSLOG_INFO("AudioIOManager", "设备管理器未初始化");
+        return {};
     }
     
-    // 获取音频设备类型
-    auto& deviceTypes = deviceManager->getAvailableDeviceTypes();
-    
-    for (auto* deviceType : deviceTypes) {
-        deviceType->scanForDevices();
-        
-        auto deviceNames = deviceType->getDeviceNames();
-        for (const auto& deviceName : deviceNames) {
-            AudioDeviceInfo info;
-            info.name = deviceName.toStdString();
-            info.type = deviceType->getTypeName().toStdString();
-            
-            // 获取设备详细信息
-            auto device = deviceType->createDevice(deviceName, deviceName);
-            if (device) {
-                info.numInputChannels = device->getActiveInputChannels().countNumberOfSetBits();
-                info.numOutputChannels = device->getActiveOutputChannels().countNumberOfSetBits();
-                
-                auto sampleRates = device->getAvailableSampleRates();
-                for (double rate : sampleRates) {
-                    info.supportedSampleRates.push_back(rate);
-                }
-                
-                auto bufferSizes = device->getAvailableBufferSizes();
-                for (int size : bufferSizes) {
-                    info.supportedBufferSizes.push_back(size);
-                }
-                
-                info.isAvailable = true;
-            }
-            
-            devices.push_back(info);
-        }
+    // 设备在注册表的后台线程中扫描，这里只在启动后的首次扫描完成前等待
+    if (!deviceRegistry->waitForInitialScan(initialScanTimeoutMs)) {
+        WSLOG_WARNING("AudioIOManager", "首次设备扫描尚未完成，返回当前缓存");
     }
     
-    std::cout << "[AudioIOManager] 找到 " << devices.size() << " 个音频设备" << std::endl;
-    return devices;
+    return deviceRegistry->getDevices();
+}
+
+void AudioIOManager::refreshAudioDevices() {
+    if (deviceRegistry) {
+        deviceRegistry->requestRescan();
+    }
 }
 
 bool AudioIOManager::setAudioDevice(const std::string& deviceName, 
                                    double sampleRate, 
                                    int bufferSize) {
-    std::cout << "[AudioIOManager] 设置音频设备：" << deviceName 
-              << "，采样率：" << sampleRate << "，缓冲区：" << bufferSize << std::endl;
+    WSLOG_INFO("AudioIOManager", "设置音频设备：" << deviceName 
+            << "，采样率：" << sampleRate << "，缓冲区：" << bufferSize);
     
     if (!deviceManager) {
-        std::cout << "[AudioIOManager] 设备管理器未初始化" << std::endl;
+        WSLOG_INFO("AudioIOManager", "设备管理器未初始化");
         return false;
     }
     
@@ -121,8 +104,11 @@ bool AudioIOManager::setAudioDevice(const std::string& deviceName,
     juce::String error = deviceManager->setAudioDeviceSetup(setup, true);
     
     if (error.isEmpty()) {
-        // 更新当前设备信息
-        currentDevice.name = deviceName;
+        // 更新当前设备信息（详细信息来自设备注册表缓存）
+        const bool deviceChanged = currentDevice.name != deviceName;
+        if (!deviceRegistry || !deviceRegistry->findDevice(deviceName, currentDevice)) {
+            currentDevice.name = deviceName;
+        }
         currentDevice.isAvailable = true;
         
         // 更新配置
@@ -140,12 +126,14 @@ bool AudioIOManager::setAudioDevice(const std::string& deviceName,
         });
         
         notifyConfigChange();
-        notifyDeviceChange(currentDevice, true);
+        if (deviceChanged) {
+            notifyDeviceChange(currentDevice, true);
+        }
         
-        std::cout << "[AudioIOManager] 音频设备设置成功" << std::endl;
+        WSLOG_INFO("AudioIOManager", "音频设备设置成功");
         return true;
     } else {
-        std::cout << "[AudioIOManager] 音频设备设置失败：" << error.toStdString() << std::endl;
+        WSLOG_WARNING("AudioIOManager", "音频设备设置失败：" << error.toStdString());
         return false;
     }
 }
@@ -155,13 +143,12 @@ AudioIOManager::AudioDeviceInfo AudioIOManager::getCurrentDevice() const {
 }
 
 bool AudioIOManager::isDeviceAvailable(const std::string& deviceName) const {
-    auto devices = const_cast<AudioIOManager*>(this)->scanAudioDevices();
-    for (const auto& device : devices) {
-        if (device.name == deviceName) {
-            return device.isAvailable;
-        }
+    if (!deviceRegistry) {
+        return false;
     }
-    return false;
+    
+    deviceRegistry->waitForInitialScan(initialScanTimeoutMs);
+    return deviceRegistry->isDeviceAvailable(deviceName);
 }
 
 //==============================================================================
@@ -169,34 +156,28 @@ bool AudioIOManager::isDeviceAvailable(const std::string& deviceName) const {
 //==============================================================================
 
 bool AudioIOManager::configureIO(const IOConfiguration& config) {
-    std::cout << "[AudioIOManager] 配置音频I/O：输入=" << config.numInputChannels 
-              << "，输出=" << config.numOutputChannels << std::endl;
+    WSLOG_INFO("AudioIOManager", "配置音频I/O：输入=" << config.numInputChannels 
+            << "，输出=" << config.numOutputChannels);
     
     std::lock_guard<std::mutex> lock(configMutex);
     
     // 验证配置
     if (config.numInputChannels < 0 || config.numInputChannels > Constants::MAX_AUDIO_CHANNELS ||
         config.numOutputChannels < 0 || config.numOutputChannels > Constants::MAX_AUDIO_CHANNELS) {
-        std::cout << "[AudioIOManager] 无效的通道配置" << std::endl;
+        WSLOG_INFO("AudioIOManager", "无效的通道配置");
         return false;
     }
     
     if (config.sampleRate <= 0 || config.bufferSize <= 0) {
-        std::cout << "[AudioIOManager] 无效的采样率或缓冲区大小" << std::endl;
+        WSLOG_INFO("AudioIOManager", "无效的采样率或缓冲区大小");
         return false;
     }
     
     // 更新配置
     currentConfig = config;
     
-    // 调整电平监控数组大小
-    currentLevels.inputLevels.resize(config.numInputChannels, 0.0f);
-    currentLevels.outputLevels.resize(config.numOutputChannels, 0.0f);
-    currentLevels.inputPeaks.resize(config.numInputChannels, 0.0f);
-    currentLevels.outputPeaks.resize(config.numOutputChannels, 0.0f);
-    
-    inputLevelSmoothers.resize(config.numInputChannels, 0.0f);
-    outputLevelSmoothers.resize(config.numOutputChannels, 0.0f);
+    // 调整电平监控通道数
+    resizeMeters(config.numInputChannels, config.numOutputChannels);
     
     // 更新图处理器配置
     GraphConfig graphConfig{
@@ -216,7 +197,7 @@ bool AudioIOManager::configureIO(const IOConfiguration& config) {
     configured = true;
     notifyConfigChange();
     
-    std::cout << "[AudioIOManager] I/O配置完成" << std::endl;
+    WSLOG_INFO("AudioIOManager", "I/O配置完成");
     return true;
 }
 
@@ -265,8 +246,8 @@ bool AudioIOManager::setBufferSize(int bufferSize) {
 //==============================================================================
 
 bool AudioIOManager::addInputMapping(const ChannelMapping& mapping) {
-    std::cout << "[AudioIOManager] 添加输入通道映射：" << mapping.sourceChannel 
-              << " -> " << mapping.destinationChannel << std::endl;
+    WSLOG_INFO("AudioIOManager", "添加输入通道映射：" << mapping.sourceChannel 
+            << " -> " << mapping.destinationChannel);
     
     if (mapping.sourceChannel < 0 || mapping.sourceChannel >= currentConfig.numInputChannels ||
         mapping.destinationChannel < 0) {
@@ -293,8 +274,8 @@ bool AudioIOManager::addInputMapping(const ChannelMapping& mapping) {
 }
 
 bool AudioIOManager::addOutputMapping(const ChannelMapping& mapping) {
-    std::cout << "[AudioIOManager] 添加输出通道映射：" << mapping.sourceChannel 
-              << " -> " << mapping.destinationChannel << std::endl;
+    WSLOG_INFO("AudioIOManager", "添加输出通道映射：" << mapping.sourceChannel 
+            << " -> " << mapping.destinationChannel);
     
     if (mapping.destinationChannel < 0 || mapping.destinationChannel >= currentConfig.numOutputChannels ||
         mapping.sourceChannel < 0) {
@@ -321,7 +302,7 @@ bool AudioIOManager::addOutputMapping(const ChannelMapping& mapping) {
 }
 
 bool AudioIOManager::removeInputMapping(int sourceChannel) {
-    std::cout << "[AudioIOManager] 移除输入通道映射：" << sourceChannel << std::endl;
+    WSLOG_INFO("AudioIOManager", "移除输入通道映射：" << sourceChannel);
     
     std::lock_guard<std::mutex> lock(configMutex);
     
@@ -342,7 +323,7 @@ bool AudioIOManager::removeInputMapping(int sourceChannel) {
 }
 
 bool AudioIOManager::removeOutputMapping(int destinationChannel) {
-    std::cout << "[AudioIOManager] 移除输出通道映射：" << destinationChannel << std::endl;
+    WSLOG_INFO("AudioIOManager", "移除输出通道映射：" << destinationChannel);
     
     std::lock_guard<std::mutex> lock(configMutex);
     
@@ -363,7 +344,7 @@ bool AudioIOManager::removeOutputMapping(int destinationChannel) {
 }
 
 void AudioIOManager::clearAllMappings() {
-    std::cout << "[AudioIOManager] 清除所有通道映射" << std::endl;
+    WSLOG_INFO("AudioIOManager", "清除所有通道映射");
     
     std::lock_guard<std::mutex> lock(configMutex);
     
@@ -375,7 +356,7 @@ void AudioIOManager::clearAllMappings() {
 }
 
 void AudioIOManager::createDefaultMappings() {
-    std::cout << "[AudioIOManager] 创建默认通道映射" << std::endl;
+    WSLOG_INFO("AudioIOManager", "创建默认通道映射");
     
     std::lock_guard<std::mutex> lock(configMutex);
     
@@ -400,12 +381,12 @@ void AudioIOManager::createDefaultMappings() {
 //==============================================================================
 
 int AudioIOManager::autoConnectToInput(NodeID nodeID, int channelOffset) {
-    std::cout << "[AudioIOManager] 自动连接节点到输入：" << nodeID.uid
-              << "，通道偏移：" << channelOffset << std::endl;
+    WSLOG_INFO("AudioIOManager", "自动连接节点到输入：" << nodeID.uid
+            << "，通道偏移：" << channelOffset);
 
     auto nodeInfo = graphProcessor.getNodeInfo(nodeID);
     if (nodeInfo.nodeID.uid == 0) {
-        std::cout << "[AudioIOManager] 无效的节点ID" << std::endl;
+        WSLOG_INFO("AudioIOManager", "无效的节点ID");
         return 0;
     }
 
@@ -422,17 +403,17 @@ int AudioIOManager::autoConnectToInput(NodeID nodeID, int channelOffset) {
         }
     }
 
-    std::cout << "[AudioIOManager] 创建了 " << connectionsCreated << " 个输入连接" << std::endl;
+    WSLOG_INFO("AudioIOManager", "创建了 " << connectionsCreated << " 个输入连接");
     return connectionsCreated;
 }
 
 int AudioIOManager::autoConnectToOutput(NodeID nodeID, int channelOffset) {
-    std::cout << "[AudioIOManager] 自动连接节点到输出：" << nodeID.uid
-              << "，通道偏移：" << channelOffset << std::endl;
+    WSLOG_INFO("AudioIOManager", "自动连接节点到输出：" << nodeID.uid
+            << "，通道偏移：" << channelOffset);
 
     auto nodeInfo = graphProcessor.getNodeInfo(nodeID);
     if (nodeInfo.nodeID.uid == 0) {
-        std::cout << "[AudioIOManager] 无效的节点ID" << std::endl;
+        WSLOG_INFO("AudioIOManager", "无效的节点ID");
         return 0;
     }
 
@@ -449,16 +430,16 @@ int AudioIOManager::autoConnectToOutput(NodeID nodeID, int channelOffset) {
         }
     }
 
-    std::cout << "[AudioIOManager] 创建了 " << connectionsCreated << " 个输出连接" << std::endl;
+    WSLOG_INFO("AudioIOManager", "创建了 " << connectionsCreated << " 个输出连接");
     return connectionsCreated;
 }
 
 bool AudioIOManager::connectMidiInput(NodeID nodeID) {
-    std::cout << "[AudioIOManager] 连接MIDI输入到节点：" << nodeID.uid << std::endl;
+    WSLOG_INFO("AudioIOManager", "连接MIDI输入到节点：" << nodeID.uid);
 
     auto nodeInfo = graphProcessor.getNodeInfo(nodeID);
     if (nodeInfo.nodeID.uid == 0 || !nodeInfo.acceptsMidi) {
-        std::cout << "[AudioIOManager] 节点不接受MIDI或无效" << std::endl;
+        WSLOG_INFO("AudioIOManager", "节点不接受MIDI或无效");
         return false;
     }
 
@@ -467,11 +448,11 @@ bool AudioIOManager::connectMidiInput(NodeID nodeID) {
 }
 
 bool AudioIOManager::connectMidiOutput(NodeID nodeID) {
-    std::cout << "[AudioIOManager] 连接节点到MIDI输出：" << nodeID.uid << std::endl;
+    WSLOG_INFO("AudioIOManager", "连接节点到MIDI输出：" << nodeID.uid);
 
     auto nodeInfo = graphProcessor.getNodeInfo(nodeID);
     if (nodeInfo.nodeID.uid == 0 || !nodeInfo.producesMidi) {
-        std::cout << "[AudioIOManager] 节点不产生MIDI或无效" << std::endl;
+        WSLOG_INFO("AudioIOManager", "节点不产生MIDI或无效");
         return false;
     }
 
@@ -480,7 +461,7 @@ bool AudioIOManager::connectMidiOutput(NodeID nodeID) {
 }
 
 bool AudioIOManager::disconnectAllIO(NodeID nodeID) {
-    std::cout << "[AudioIOManager] 断开节点的所有I/O连接：" << nodeID.uid << std::endl;
+    WSLOG_INFO("AudioIOManager", "断开节点的所有I/O连接：" << nodeID.uid);
 
     return graphProcessor.disconnectNode(nodeID);
 }
@@ -490,36 +471,43 @@ bool AudioIOManager::disconnectAllIO(NodeID nodeID) {
 //==============================================================================
 
 void AudioIOManager::enableLevelMonitoring(bool enable) {
-    std::cout << "[AudioIOManager] " << (enable ? "启用" : "禁用") << "电平监控" << std::endl;
-
-    std::lock_guard<std::mutex> lock(levelMutex);
-    levelMonitoringEnabled = enable;
+    WSLOG_INFO("AudioIOManager", (enable ? "启用" : "禁用") << "电平监控");
 
     if (enable) {
         resetPeakLevels();
     }
+
+    levelMonitoringEnabled.store(enable);
 }
 
 AudioIOManager::AudioLevelInfo AudioIOManager::getCurrentLevels() const {
-    std::lock_guard<std::mutex> lock(levelMutex);
-    return currentLevels;
+    AudioLevelInfo info;
+    fillLevelInfo(info);
+    return info;
 }
 
-void AudioIOManager::resetPeakLevels() {
-    std::cout << "[AudioIOManager] 重置峰值电平" << std::endl;
+MeterSnapshot AudioIOManager::getMeterSnapshot() const {
+    std::lock_guard<std::mutex> lock(snapshotReadMutex);
+    return meterSnapshots.read();
+}
 
-    std::lock_guard<std::mutex> lock(levelMutex);
+void AudioIOManager::resetPeakLevels() {
+    WSLOG_INFO("AudioIOManager", "重置峰值电平");
 
-    std::fill(currentLevels.inputPeaks.begin(), currentLevels.inputPeaks.end(), 0.0f);
-    std::fill(currentLevels.outputPeaks.begin(), currentLevels.outputPeaks.end(), 0.0f);
-    currentLevels.inputClipping = false;
-    currentLevels.outputClipping = false;
+    // 立即清零供读取端使用，同时请求音频线程在下一个块丢弃正在累积的峰值
+    for (auto* meters : { &inputMeters, &outputMeters }) {
+        for (auto& meter : meters->channels) {
+            meter.peak.store(0.0f, std::memory_order_relaxed);
+        }
+        meters->clipping.store(false);
+        meters->resetPending.store(true);
+    }
 }
 
 void AudioIOManager::setLevelUpdateInterval(int intervalMs) {
     if (intervalMs > 0) {
-        levelUpdateIntervalMs = intervalMs;
-        std::cout << "[AudioIOManager] 设置电平更新间隔：" << intervalMs << "ms" << std::endl;
+        levelUpdateIntervalMs.store(intervalMs);
+        WSLOG_INFO("AudioIOManager", "设置电平更新间隔：" << intervalMs << "ms");
     }
 }
 
@@ -528,7 +516,7 @@ void AudioIOManager::setLevelUpdateInterval(int intervalMs) {
 //==============================================================================
 
 void AudioIOManager::setInputGain(float gain) {
-    std::cout << "[AudioIOManager] 设置输入增益：" << gain << std::endl;
+    WSLOG_INFO("AudioIOManager", "设置输入增益：" << gain);
 
     std::lock_guard<std::mutex> lock(configMutex);
     currentConfig.inputGain = std::max(0.0f, gain);
@@ -536,7 +524,7 @@ void AudioIOManager::setInputGain(float gain) {
 }
 
 void AudioIOManager::setOutputGain(float gain) {
-    std::cout << "[AudioIOManager] 设置输出增益：" << gain << std::endl;
+    WSLOG_INFO("AudioIOManager", "设置输出增益：" << gain);
 
     std::lock_guard<std::mutex> lock(configMutex);
     currentConfig.outputGain = std::max(0.0f, gain);
@@ -544,21 +532,21 @@ void AudioIOManager::setOutputGain(float gain) {
 }
 
 void AudioIOManager::setInputMuted(bool muted) {
-    std::cout << "[AudioIOManager] 设置输入静音：" << (muted ? "是" : "否") << std::endl;
+    WSLOG_INFO("AudioIOManager", "设置输入静音：" << (muted ? "是" : "否"));
 
     inputMuted = muted;
     notifyConfigChange();
 }
 
 void AudioIOManager::setOutputMuted(bool muted) {
-    std::cout << "[AudioIOManager] 设置输出静音：" << (muted ? "是" : "否") << std::endl;
+    WSLOG_INFO("AudioIOManager", "设置输出静音：" << (muted ? "是" : "否"));
 
     outputMuted = muted;
     notifyConfigChange();
 }
 
 void AudioIOManager::enableInputMonitoring(bool enable) {
-    std::cout << "[AudioIOManager] " << (enable ? "启用" : "禁用") << "输入监听" << std::endl;
+    WSLOG_INFO("AudioIOManager", (enable ? "启用" : "禁用") << "输入监听");
 
     std::lock_guard<std::mutex> lock(configMutex);
     currentConfig.enableInputMonitoring = enable;
@@ -567,7 +555,7 @@ void AudioIOManager::enableInputMonitoring(bool enable) {
 }
 
 void AudioIOManager::enableOutputLimiting(bool enable) {
-    std::cout << "[AudioIOManager] " << (enable ? "启用" : "禁用") << "输出限制器" << std::endl;
+    WSLOG_INFO("AudioIOManager", (enable ? "启用" : "禁用") << "输出限制器");
 
     std::lock_guard<std::mutex> lock(configMutex);
     currentConfig.enableOutputLimiting = enable;
@@ -580,13 +568,43 @@ void AudioIOManager::enableOutputLimiting(bool enable) {
 //==============================================================================
 
 void AudioIOManager::setDeviceChangeCallback(DeviceChangeCallback callback) {
+    std::lock_guard<std::mutex> lock(deviceCallbackMutex);
     deviceChangeCallback = std::move(callback);
 }
 
 void AudioIOManager::setLevelUpdateCallback(LevelUpdateCallback callback) {
+    std::lock_guard<std::mutex> lock(levelCallbackMutex);
     levelUpdateCallback = std::move(callback);
 }
 
+void AudioIOManager::setNotificationDispatcher(NotificationDispatcher* dispatcher) {
+    detachNotificationDispatcher();
+
+    if (dispatcher == nullptr) {
+        // 内部分发器保留到析构，音频线程可能仍持有旧指针
+        if (!ownedDispatcher) {
+            ownedDispatcher = std::make_unique<NotificationDispatcher>();
+        }
+        dispatcher = ownedDispatcher.get();
+    }
+
+    notificationSourceID = dispatcher->allocateSourceID();
+    levelSubscriptionID = dispatcher->subscribe(NotificationType::LevelsChanged, notificationSourceID,
+        [this](const Notification&) {
+            std::lock_guard<std::mutex> lock(levelCallbackMutex);
+            notifyLevelUpdate();
+        });
+    notificationDispatcher.store(dispatcher);
+}
+
+void AudioIOManager::detachNotificationDispatcher() {
+    auto* previous = notificationDispatcher.exchange(nullptr);
+    if (previous != nullptr && levelSubscriptionID != 0) {
+        previous->unsubscribe(levelSubscriptionID);
+        levelSubscriptionID = 0;
+    }
+}
+
 void AudioIOManager::setConfigChangeCallback(ConfigChangeCallback callback) {
     configChangeCallback = std::move(callback);
 }
@@ -611,12 +629,49 @@ NodeID AudioIOManager::getMidiOutputNodeID() const {
     return graphProcessor.getMidiOutputNodeID();
 }
 
+//==============================================================================
+// MIDI输入设备实现
+//==============================================================================
+
+std::vector<AudioIOManager::MidiInputDeviceInfo> AudioIOManager::getMidiInputDevices() const {
+    std::vector<MidiInputDeviceInfo> devices;
+
+    for (const auto& midiDevice : juce::MidiInput::getAvailableDevices()) {
+        MidiInputDeviceInfo info;
+        info.name = midiDevice.name.toStdString();
+        info.identifier = midiDevice.identifier.toStdString();
+        info.enabled = deviceManager && deviceManager->isMidiInputDeviceEnabled(midiDevice.identifier);
+        devices.push_back(std::move(info));
+    }
+
+    return devices;
+}
+
+bool AudioIOManager::setMidiInputDeviceEnabled(const std::string& identifier, bool enabled) {
+    if (!deviceManager) {
+        return false;
+    }
+
+    const auto available = juce::MidiInput::getAvailableDevices();
+    const bool exists = std::any_of(available.begin(), available.end(), [&identifier](const juce::MidiDeviceInfo& info) {
+        return info.identifier.toStdString() == identifier;
+    });
+    if (!exists) {
+        WSLOG_WARNING("AudioIOManager", "MIDI输入设备不存在: " << identifier);
+        return false;
+    }
+
+    deviceManager->setMidiInputDeviceEnabled(identifier, enabled);
+    WSLOG_INFO("AudioIOManager", (enabled ? "启用" : "禁用") << "MIDI输入设备: " << identifier);
+    return true;
+}
+
 //==============================================================================
 // 内部方法实现
 //==============================================================================
 
 void AudioIOManager::initializeDeviceManager() {
-    std::cout << "[AudioIOManager] 初始化设备管理器" << std::endl;
+    WSLOG_INFO("AudioIOManager", "初始化设备管理器");
 
     deviceManager = std::make_unique<juce::AudioDeviceManager>();
     // deviceManager->initialiseWithDefaultDevices(2, 2);
@@ -624,7 +679,21 @@ void AudioIOManager::initializeDeviceManager() {
 
     // 关键：连接GraphAudioProcessor到音频设备管理器
     deviceManager->addAudioCallback(&graphProcessor);
-    std::cout << "[AudioIOManager] GraphAudioProcessor已连接到音频设备" << std::endl;
+    WSLOG_INFO("AudioIOManager", "GraphAudioProcessor已连接到音频设备");
+
+    // 设备列表在后台扫描并缓存，热插拔时只报告真正出现或消失的设备
+    deviceRegistry = std::make_unique<AudioDeviceRegistry>(*deviceManager);
+    deviceRegistry->setChangeCallback([this](const AudioDeviceInfo& device, bool connected) {
+        notifyDeviceChange(device, connected);
+    });
+
+    // MIDI输入：所有已启用设备的消息进入收集器，由设备回调按采样偏移取出
+    graphProcessor.setMidiInputCollector(&midiInputCollector);
+    deviceManager->addMidiInputDeviceCallback({}, &midiInputCollector);
+    for (const auto& midiDevice : juce::MidiInput::getAvailableDevices()) {
+        deviceManager->setMidiInputDeviceEnabled(midiDevice.identifier, true);
+        WSLOG_INFO("AudioIOManager", "启用MIDI输入设备: " << midiDevice.name);
+    }
 
     // 设置默认设备信息
     auto* currentAudioDevice = deviceManager->getCurrentAudioDevice();
@@ -638,55 +707,130 @@ void AudioIOManager::initializeDeviceManager() {
 }
 
 void AudioIOManager::updateChannelMappings() {
-    std::cout << "[AudioIOManager] 更新通道映射" << std::endl;
+    WSLOG_INFO("AudioIOManager", "更新通道映射");
 
     // 这里可以实现具体的通道映射逻辑
     // 例如更新内部的音频路由矩阵
 }
 
-void AudioIOManager::updateAudioLevels(const juce::AudioBuffer<float>& buffer, bool isInput) {
-    if (!levelMonitoringEnabled) {
+void AudioIOManager::captureAudio(CapturePoint point,
+                                  const float* const* channelData,
+                                  int numChannels,
+                                  int numSamples) noexcept {
+    if (numSamples <= 0) {
         return;
     }
 
-    std::lock_guard<std::mutex> lock(levelMutex);
+    const bool monitoring = levelMonitoringEnabled.load(std::memory_order_relaxed);
 
-    auto& levels = isInput ? currentLevels.inputLevels : currentLevels.outputLevels;
-    auto& peaks = isInput ? currentLevels.inputPeaks : currentLevels.outputPeaks;
-    auto& smoothers = isInput ? inputLevelSmoothers : outputLevelSmoothers;
-    bool& clipping = isInput ? currentLevels.inputClipping : currentLevels.outputClipping;
+    if (point == CapturePoint::PreGraph) {
+        if (monitoring) {
+            updateAudioLevels(inputMeters, channelData, numChannels, numSamples);
+        }
+        return;
+    }
 
-    int numChannels = std::min(buffer.getNumChannels(), static_cast<int>(levels.size()));
+    if (monitoring) {
+        updateAudioLevels(outputMeters, channelData, numChannels, numSamples);
+    }
 
-    for (int ch = 0; ch < numChannels; ++ch) {
-        const float* channelData = buffer.getReadPointer(ch);
-        int numSamples = buffer.getNumSamples();
+    // 每块发布一次快照（未启用电平监控时仍发布性能数据）
+    const double now = juce::Time::getMillisecondCounterHiRes();
+    publishMeterSnapshot(now);
 
-        // 计算RMS电平
-        float rmsLevel = calculateRMSLevel(channelData, numSamples);
-        levels[ch] = smoothLevel(smoothers[ch], rmsLevel);
-        smoothers[ch] = levels[ch];
+    if (!monitoring) {
+        return;
+    }
 
-        // 计算峰值电平
-        float peakLevel = calculatePeakLevel(channelData, numSamples);
-        peaks[ch] = std::max(peaks[ch], peakLevel);
+    levelTimestamp.store(now, std::memory_order_relaxed);
 
-        // 检测削波
-        if (peakLevel >= 0.99f) {
-            clipping = true;
+    // 检查是否需要更新回调（只投递事件，回调在分发线程中执行；切换分发器期间的更新被跳过）
+    if (now - lastLevelNotifyMs >= levelUpdateIntervalMs.load(std::memory_order_relaxed)) {
+        lastLevelNotifyMs = now;
+        if (auto* dispatcher = notificationDispatcher.load(std::memory_order_acquire)) {
+            dispatcher->post(NotificationType::LevelsChanged, notificationSourceID);
         }
     }
+}
+
+void AudioIOManager::updateAudioLevels(MeterBank& meters,
+                                       const float* const* channelData,
+                                       int numChannels,
+                                       int numSamples) noexcept {
+    const bool resetPeaks = meters.resetPending.exchange(false);
+    const int channelsToMeter = std::min(numChannels, meters.numChannels.load(std::memory_order_relaxed));
+    bool clipped = false;
+
+    for (int ch = 0; ch < channelsToMeter; ++ch) {
+        auto& meter = meters.channels[static_cast<size_t>(ch)];
+
+        // 单次遍历计算峰值/RMS/削波
+        const auto levels = LevelAnalysis::analyseChannel(channelData != nullptr ? channelData[ch] : nullptr,
+                                                          numSamples);
 
-    currentLevels.timestamp = juce::Time::getMillisecondCounterHiRes();
+        meter.smoother = smoothLevel(meter.smoother, levels.rms);
+        meter.level.store(meter.smoother, std::memory_order_relaxed);
 
-    // 检查是否需要更新回调
-    auto now = juce::Time::getCurrentTime();
-    if (now.toMilliseconds() - lastLevelUpdate.toMilliseconds() >= levelUpdateIntervalMs) {
-        lastLevelUpdate = now;
-        notifyLevelUpdate();
+        const float heldPeak = resetPeaks ? 0.0f : meter.peak.load(std::memory_order_relaxed);
+        meter.peak.store(std::max(heldPeak, levels.peak), std::memory_order_relaxed);
+
+        clipped = clipped || levels.clipped;
+    }
+
+    if (resetPeaks) {
+        meters.clipping.store(false, std::memory_order_relaxed);
+    }
+    if (clipped) {
+        meters.clipping.store(true, std::memory_order_relaxed);
     }
 }
 
+void AudioIOManager::publishMeterSnapshot(double timestamp) noexcept {
+    auto& snapshot = meterSnapshots.getWriteBuffer();
+
+    auto copyBank = [](const MeterBank& meters, int& numChannels,
+                       std::array<float, Constants::MAX_AUDIO_CHANNELS>& levels,
+                       std::array<float, Constants::MAX_AUDIO_CHANNELS>& peaks,
+                       bool& clipping) {
+        numChannels = meters.numChannels.load(std::memory_order_relaxed);
+        for (int ch = 0; ch < numChannels; ++ch) {
+            levels[static_cast<size_t>(ch)] = meters.channels[static_cast<size_t>(ch)].level.load(std::memory_order_relaxed);
+            peaks[static_cast<size_t>(ch)] = meters.channels[static_cast<size_t>(ch)].peak.load(std::memory_order_relaxed);
+        }
+        clipping = meters.clipping.load(std::memory_order_relaxed);
+    };
+
+    copyBank(inputMeters, snapshot.numInputChannels, snapshot.inputLevels, snapshot.inputPeaks, snapshot.inputClipping);
+    copyBank(outputMeters, snapshot.numOutputChannels, snapshot.outputLevels, snapshot.outputPeaks, snapshot.outputClipping);
+    snapshot.block = graphProcessor.getRealtimeBlockStats();
+    snapshot.timestamp = timestamp;
+
+    meterSnapshots.publish();
+}
+
+void AudioIOManager::resizeMeters(int numInputChannels, int numOutputChannels) {
+    inputMeters.numChannels.store(juce::jlimit(0, Constants::MAX_AUDIO_CHANNELS, numInputChannels));
+    outputMeters.numChannels.store(juce::jlimit(0, Constants::MAX_AUDIO_CHANNELS, numOutputChannels));
+}
+
+void AudioIOManager::fillLevelInfo(AudioLevelInfo& info) const {
+    auto fillBank = [](const MeterBank& meters, std::vector<float>& levels, std::vector<float>& peaks) {
+        const auto numChannels = static_cast<size_t>(meters.numChannels.load(std::memory_order_relaxed));
+        levels.resize(numChannels);
+        peaks.resize(numChannels);
+        for (size_t ch = 0; ch < numChannels; ++ch) {
+            levels[ch] = meters.channels[ch].level.load(std::memory_order_relaxed);
+            peaks[ch] = meters.channels[ch].peak.load(std::memory_order_relaxed);
+        }
+    };
+
+    fillBank(inputMeters, info.inputLevels, info.inputPeaks);
+    fillBank(outputMeters, info.outputLevels, info.outputPeaks);
+    info.inputClipping = inputMeters.clipping.load(std::memory_order_relaxed);
+    info.outputClipping = outputMeters.clipping.load(std::memory_order_relaxed);
+    info.timestamp = levelTimestamp.load(std::memory_order_relaxed);
+}
+
 void AudioIOManager::notifyConfigChange() {
     if (configChangeCallback) {
         configChangeCallback(currentConfig);
@@ -694,6 +838,7 @@ void AudioIOManager::notifyConfigChange() {
 }
 
 void AudioIOManager::notifyDeviceChange(const AudioDeviceInfo& device, bool connected) {
+    std::lock_guard<std::mutex> lock(deviceCallbackMutex);
     if (deviceChangeCallback) {
         deviceChangeCallback(device, connected);
     }
@@ -701,7 +846,8 @@ void AudioIOManager::notifyDeviceChange(const AudioDeviceInfo& device, bool conn
 
 void AudioIOManager::notifyLevelUpdate() {
     if (levelUpdateCallback) {
-        levelUpdateCallback(currentLevels);
+        fillLevelInfo(callbackLevels);
+        levelUpdateCallback(callbackLevels);
     }
 }
 
@@ -709,34 +855,7 @@ void AudioIOManager::notifyLevelUpdate() {
 // 电平计算辅助方法实现
 //==============================================================================
 
-float AudioIOManager::calculateRMSLevel(const float* channelData, int numSamples) {
-    if (numSamples == 0) {
-        return 0.0f;
-    }
-
-    float sum = 0.0f;
-    for (int i = 0; i < numSamples; ++i) {
-        float sample = channelData[i];
-        sum += sample * sample;
-    }
-
-    return std::sqrt(sum / numSamples);
-}
-
-float AudioIOManager::calculatePeakLevel(const float* channelData, int numSamples) {
-    if (numSamples == 0) {
-        return 0.0f;
-    }
-
-    float peak = 0.0f;
-    for (int i = 0; i < numSamples; ++i) {
-        peak = std::max(peak, std::abs(channelData[i]));
-    }
-
-    return peak;
-}
-
-float AudioIOManager::smoothLevel(float currentLevel, float newLevel, float smoothingFactor) {
+float AudioIOManager::smoothLevel(float currentLevel, float newLevel, float smoothingFactor) noexcept {
     return currentLevel + smoothingFactor * (newLevel - currentLevel);
 }
 
@@ -13,8 +13,15 @@
 #include <vector>
 #include <functional>
 #include <string>
+#include <array>
+#include <atomic>
+#include <mutex>
 #include "../Core/GraphAudioProcessor.hpp"
 #include "../Core/AudioGraphTypes.hpp"
+#include "../Core/TripleBuffer.hpp"
+#include "../Core/NotificationDispatcher.hpp"
+#include "../Core/MidiInputCollector.hpp"
+#include "AudioDeviceRegistry.hpp"
 
 namespace WindsynthVST::AudioGraph {
 
@@ -27,8 +34,11 @@ namespace WindsynthVST::AudioGraph {
  * - 输入输出节点的智能连接
  * - 音频格式转换和适配
  * - 实时监控和电平检测
+ *
+ * 电平检测作为音频采集接收器在设备回调中运行：每个块每个通道只做一次向量化分析，
+ * 结果通过原子变量发布，读取端不与音频线程竞争锁。
  */
-class AudioIOManager {
+class AudioIOManager : public AudioCaptureSink {
 public:
     //==============================================================================
     // 类型定义
@@ -37,15 +47,15 @@ public:
     /**
      * 音频设备信息
      */
-    struct AudioDeviceInfo {
+    using AudioDeviceInfo = AudioDeviceRegistry::DeviceInfo;
+    
+    /**
+     * MIDI输入设备信息
+     */
+    struct MidiInputDeviceInfo {
         std::string name;
-        std::string type;
-        int numInputChannels = 0;
-        int numOutputChannels = 0;
-        std::vector<double> supportedSampleRates;
-        std::vector<int> supportedBufferSizes;
-        bool isDefault = false;
-        bool isAvailable = true;
+        std::string identifier;
+        bool enabled = false;
     };
     
     /**
@@ -121,11 +131,16 @@ public:
     //==============================================================================
     
     /**
-     * 扫描可用的音频设备
+     * 获取可用的音频设备（从设备注册表缓存返回，首次后台扫描完成前最多等待 initialScanTimeoutMs）
      * @return 可用设备列表
      */
     std::vector<AudioDeviceInfo> scanAudioDevices();
     
+    /**
+     * 请求在后台重新扫描音频设备（热插拔会自动触发，通常不需要调用）
+     */
+    void refreshAudioDevices();
+    
     /**
      * 设置音频设备
      * @param deviceName 设备名称
@@ -149,12 +164,33 @@ public:
     juce::AudioDeviceManager* getDeviceManager() const { return deviceManager.get(); }
     
     /**
-     * 检查设备是否可用
+     * 检查设备是否可用（查询设备注册表缓存）
      * @param deviceName 设备名称
      * @return 可用返回true
      */
     bool isDeviceAvailable(const std::string& deviceName) const;
     
+    //==============================================================================
+    // MIDI输入设备
+    //==============================================================================
+    
+    /**
+     * 获取可用的MIDI输入设备（默认全部启用）
+     */
+    std::vector<MidiInputDeviceInfo> getMidiInputDevices() const;
+    
+    /**
+     * 启用或禁用MIDI输入设备，启用的设备消息送入音频图的MIDI输入节点
+     * @param identifier 设备标识（MidiInputDeviceInfo::identifier）
+     * @return 设备不存在时返回false
+     */
+    bool setMidiInputDeviceEnabled(const std::string& identifier, bool enabled);
+    
+    /**
+     * 获取MIDI输入收集器（用于统计或手动注入消息）
+     */
+    MidiInputCollector& getMidiInputCollector() { return midiInputCollector; }
+    
     //==============================================================================
     // I/O配置管理
     //==============================================================================
@@ -299,6 +335,12 @@ public:
      */
     AudioLevelInfo getCurrentLevels() const;
     
+    /**
+     * 获取最近一个音频块发布的电平和性能快照
+     * 音频线程每块通过三缓冲发布一次，读取不与音频线程竞争
+     */
+    MeterSnapshot getMeterSnapshot() const;
+    
     /**
      * 重置峰值电平
      */
@@ -355,14 +397,20 @@ public:
     //==============================================================================
     
     /**
-     * 设置设备变化回调
+     * 设置设备变化回调（只在设备真正连接、断开或切换时调用；热插拔变化在设备扫描线程中回调）
      */
     void setDeviceChangeCallback(DeviceChangeCallback callback);
     
     /**
-     * 设置电平更新回调
+     * 设置电平更新回调（在通知分发线程中调用，从不在音频线程中调用）
      */
     void setLevelUpdateCallback(LevelUpdateCallback callback);
+
+    /**
+     * 设置通知分发器（音频线程只投递电平事件，电平回调在分发线程中执行）
+     * 分发器必须比本对象存活更久；传入nullptr时恢复使用内部分发器。应在启动音频设备前调用
+     */
+    void setNotificationDispatcher(NotificationDispatcher* dispatcher);
     
     /**
      * 设置配置变化回调
@@ -383,7 +431,7 @@ public:
      * 检查是否正在监控电平
      * @return 正在监控返回true
      */
-    bool isLevelMonitoringEnabled() const { return levelMonitoringEnabled; }
+    bool isLevelMonitoringEnabled() const { return levelMonitoringEnabled.load(); }
     
     /**
      * 获取输入节点ID
@@ -408,8 +456,40 @@ public:
      * @return MIDI输出节点ID
      */
     NodeID getMidiOutputNodeID() const;
+    
+    //==============================================================================
+    // AudioCaptureSink 接口（音频线程）
+    //==============================================================================
+    
+    void captureAudio(CapturePoint point,
+                      const float* const* channelData,
+                      int numChannels,
+                      int numSamples) noexcept override;
 
 private:
+    //==============================================================================
+    // 内部类型
+    //==============================================================================
+    
+    /**
+     * 单通道电平（音频线程写入，任意线程读取）
+     */
+    struct ChannelMeter {
+        std::atomic<float> level{0.0f};     // 平滑后的RMS电平
+        std::atomic<float> peak{0.0f};      // 自上次重置以来的峰值
+        float smoother = 0.0f;              // 平滑状态（仅音频线程访问）
+    };
+    
+    /**
+     * 一组通道的电平（输入或输出）
+     */
+    struct MeterBank {
+        std::array<ChannelMeter, Constants::MAX_AUDIO_CHANNELS> channels;
+        std::atomic<int> numChannels{0};    // 显示的通道数（按I/O配置）
+        std::atomic<bool> clipping{false};
+        std::atomic<bool> resetPending{false};
+    };
+
     //==============================================================================
     // 内部成员变量
     //==============================================================================
@@ -420,17 +500,33 @@ private:
     IOConfiguration currentConfig;
     bool configured = false;
     
-    // 设备管理
+    // MIDI输入（必须比设备管理器活得更久）
+    MidiInputCollector midiInputCollector;
+    
+    // 设备管理（注册表监听设备管理器的变化广播，必须先于设备管理器销毁）
     std::unique_ptr<juce::AudioDeviceManager> deviceManager;
+    std::unique_ptr<AudioDeviceRegistry> deviceRegistry;
     AudioDeviceInfo currentDevice;
     
     // 电平监控
-    bool levelMonitoringEnabled = false;
-    AudioLevelInfo currentLevels;
-    std::vector<float> inputLevelSmoothers;
-    std::vector<float> outputLevelSmoothers;
-    juce::Time lastLevelUpdate;
-    int levelUpdateIntervalMs = 50;
+    std::atomic<bool> levelMonitoringEnabled{false};
+    MeterBank inputMeters;
+    MeterBank outputMeters;
+    std::atomic<double> levelTimestamp{0.0};
+    std::atomic<int> levelUpdateIntervalMs{50};
+    double lastLevelNotifyMs = 0.0;         // 仅音频线程访问
+    AudioLevelInfo callbackLevels;          // 回调使用的预分配电平信息（仅回调线程访问）
+
+    // 通知分发
+    std::atomic<NotificationDispatcher*> notificationDispatcher{nullptr};
+    std::unique_ptr<NotificationDispatcher> ownedDispatcher;   // 未设置外部分发器时使用
+    NotificationDispatcher::SubscriptionID levelSubscriptionID = 0;
+    uint32_t notificationSourceID = 0;
+    std::mutex levelCallbackMutex;          // 分发线程回调与 setLevelUpdateCallback 之间
+    
+    // 电平/性能快照：音频线程为唯一写者，snapshotReadMutex 只在读取线程之间串行
+    mutable TripleBuffer<MeterSnapshot> meterSnapshots;
+    mutable std::mutex snapshotReadMutex;
     
     // 音频处理状态
     bool inputMuted = false;
@@ -440,12 +536,12 @@ private:
     
     // 回调函数
     DeviceChangeCallback deviceChangeCallback;
+    std::mutex deviceCallbackMutex;         // 扫描线程回调与 setDeviceChangeCallback 之间
     LevelUpdateCallback levelUpdateCallback;
     ConfigChangeCallback configChangeCallback;
     
     // 线程安全
     mutable std::mutex configMutex;
-    mutable std::mutex levelMutex;
     
     //==============================================================================
     // 内部方法
@@ -453,15 +549,20 @@ private:
     
     void initializeDeviceManager();
     void updateChannelMappings();
-    void updateAudioLevels(const juce::AudioBuffer<float>& buffer, bool isInput);
+    void updateAudioLevels(MeterBank& meters, const float* const* channelData, int numChannels, int numSamples) noexcept;
+    void resizeMeters(int numInputChannels, int numOutputChannels);
+    void fillLevelInfo(AudioLevelInfo& info) const;
+    void publishMeterSnapshot(double timestamp) noexcept;
     void notifyConfigChange();
     void notifyDeviceChange(const AudioDeviceInfo& device, bool connected);
     void notifyLevelUpdate();
+    void detachNotificationDispatcher();
+    
+    // 首次设备扫描的最长等待时间
+    static constexpr int initialScanTimeoutMs = 3000;
     
     // 电平计算辅助方法
-    float calculateRMSLevel(const float* channelData, int numSamples);
-    float calculatePeakLevel(const float* channelData, int numSamples);
-    float smoothLevel(float currentLevel, float newLevel, float smoothingFactor = 0.3f);
+    static float smoothLevel(float currentLevel, float newLevel, float smoothingFactor = 0.3f) noexcept;
     
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(AudioIOManager)
 };
@@ -7,7 +7,7 @@
 //
 
 #include "GraphManager.hpp"
-#include <iostream>
+#include "../Core/Logger.hpp"
 #include <algorithm>
 #include <unordered_set>
 #include <queue>
@@ -21,11 +21,11 @@ namespace WindsynthVST::AudioGraph {
 GraphManager::GraphManager(GraphAudioProcessor& graphProcessor)
     : graphProcessor(graphProcessor)
 {
-    std::cout << "[GraphManager] 初始化图管理器" << std::endl;
+    WSLOG_INFO("GraphManager", "初始化图管理器");
 }
 
 GraphManager::~GraphManager() {
-    std::cout << "[GraphManager] 析构图管理器" << std::endl;
+    WSLOG_INFO("GraphManager", "析构图管理器");
 }
 
 //==============================================================================
@@ -34,9 +34,10 @@ GraphManager::~GraphManager() {
 
 std::vector<NodeID> GraphManager::addNodeGroup(std::vector<std::unique_ptr<juce::AudioProcessor>> processors,
                                               const std::vector<std::string>& names) {
-    std::cout << "[GraphManager] 添加节点组，数量：" << processors.size() << std::endl;
+    WSLOG_INFO("GraphManager", "添加节点组，数量：" << processors.size());
     
     std::lock_guard<std::mutex> lock(operationMutex);
+    GraphAudioProcessor::ScopedTopologyChange topologyChange(graphProcessor);
     
     if (batchOperationActive) {
         beginBatchOperation("添加节点组");
@@ -50,8 +51,10 @@ std::vector<NodeID> GraphManager::addNodeGroup(std::vector<std::unique_ptr<juce:
         
         // 这里需要适配不同类型的处理器
         // 暂时直接添加到图中
-        auto node = graphProcessor.getGraph().addNode(std::move(processors[i]));
+        auto node = graphProcessor.getGraph().addNode(std::move(processors[i]), {},
+                                                      juce::AudioProcessorGraph::UpdateKind::none);
         if (node) {
+            graphProcessor.markTopologyChanged();
             nodeIDs.push_back(node->nodeID);
             
             // 记录操作
@@ -65,12 +68,12 @@ std::vector<NodeID> GraphManager::addNodeGroup(std::vector<std::unique_ptr<juce:
         endBatchOperation();
     }
     
-    std::cout << "[GraphManager] 成功添加 " << nodeIDs.size() << " 个节点" << std::endl;
+    WSLOG_INFO("GraphManager", "成功添加 " << nodeIDs.size() << " 个节点");
     return nodeIDs;
 }
 
 int GraphManager::removeNodeGroup(const std::vector<NodeID>& nodeIDs) {
-    std::cout << "[GraphManager] 移除节点组，数量：" << nodeIDs.size() << std::endl;
+    WSLOG_INFO("GraphManager", "移除节点组，数量：" << nodeIDs.size());
     
     std::lock_guard<std::mutex> lock(operationMutex);
     
@@ -90,16 +93,16 @@ int GraphManager::removeNodeGroup(const std::vector<NodeID>& nodeIDs) {
     
     endBatchOperation();
     
-    std::cout << "[GraphManager] 成功移除 " << removedCount << " 个节点" << std::endl;
+    WSLOG_INFO("GraphManager", "成功移除 " << removedCount << " 个节点");
     return removedCount;
 }
 
 NodeID GraphManager::duplicateNode(NodeID sourceNodeID, const std::string& newName) {
-    std::cout << "[GraphManager] 复制节点：" << sourceNodeID.uid << std::endl;
+    WSLOG_INFO("GraphManager", "复制节点：" << sourceNodeID.uid);
     
     auto* sourceNode = graphProcessor.getGraph().getNodeForId(sourceNodeID);
     if (!sourceNode) {
-        std::cout << "[GraphManager] 源节点不存在" << std::endl;
+        WSLOG_INFO("GraphManager", "源节点不存在");
         return NodeID{0};
     }
     
@@ -111,17 +114,17 @@ NodeID GraphManager::duplicateNode(NodeID sourceNodeID, const std::string& newNa
     // 由于无法直接复制AudioProcessor，这里返回失败
     // 在实际实现中，需要根据处理器类型进行特殊处理
     
-    std::cout << "[GraphManager] 节点复制功能需要特定实现" << std::endl;
+    WSLOG_INFO("GraphManager", "节点复制功能需要特定实现");
     return NodeID{0};
 }
 
 bool GraphManager::moveNode(NodeID nodeID, int newPosition) {
-    std::cout << "[GraphManager] 移动节点：" << nodeID.uid << " 到位置：" << newPosition << std::endl;
+    WSLOG_INFO("GraphManager", "移动节点：" << nodeID.uid << " 到位置：" << newPosition);
     
     // JUCE AudioProcessorGraph没有直接的节点重排序功能
     // 这里可以通过重新连接来实现逻辑上的重排序
     
-    std::cout << "[GraphManager] 节点移动功能需要特定实现" << std::endl;
+    WSLOG_INFO("GraphManager", "节点移动功能需要特定实现");
     return false;
 }
 
@@ -131,17 +134,18 @@ bool GraphManager::moveNode(NodeID nodeID, int newPosition) {
 
 int GraphManager::autoConnectNodes(NodeID sourceNodeID, NodeID destNodeID, 
                                   bool connectAudio, bool connectMidi) {
-    std::cout << "[GraphManager] 自动连接节点：" << sourceNodeID.uid 
-              << " -> " << destNodeID.uid << std::endl;
+    WSLOG_INFO("GraphManager", "自动连接节点：" << sourceNodeID.uid 
+            << " -> " << destNodeID.uid);
     
     auto sourceInfo = graphProcessor.getNodeInfo(sourceNodeID);
     auto destInfo = graphProcessor.getNodeInfo(destNodeID);
     
     if (sourceInfo.nodeID.uid == 0 || destInfo.nodeID.uid == 0) {
-        std::cout << "[GraphManager] 无效的节点ID" << std::endl;
+        WSLOG_INFO("GraphManager", "无效的节点ID");
         return 0;
     }
     
+    GraphAudioProcessor::ScopedTopologyChange topologyChange(graphProcessor);
     int connectionsCreated = 0;
     
     // 连接音频通道
@@ -171,15 +175,15 @@ int GraphManager::autoConnectNodes(NodeID sourceNodeID, NodeID destNodeID,
         }
     }
     
-    std::cout << "[GraphManager] 创建了 " << connectionsCreated << " 个连接" << std::endl;
+    WSLOG_INFO("GraphManager", "创建了 " << connectionsCreated << " 个连接");
     return connectionsCreated;
 }
 
 int GraphManager::createProcessingChain(const std::vector<NodeID>& nodeIDs, bool connectToIO) {
-    std::cout << "[GraphManager] 创建处理链，节点数量：" << nodeIDs.size() << std::endl;
+    WSLOG_INFO("GraphManager", "创建处理链，节点数量：" << nodeIDs.size());
     
     if (nodeIDs.size() < 2) {
-        std::cout << "[GraphManager] 处理链至少需要2个节点" << std::endl;
+        WSLOG_INFO("GraphManager", "处理链至少需要2个节点");
         return 0;
     }
     
@@ -207,13 +211,13 @@ int GraphManager::createProcessingChain(const std::vector<NodeID>& nodeIDs, bool
     
     endBatchOperation();
     
-    std::cout << "[GraphManager] 处理链创建完成，总连接数：" << connectionsCreated << std::endl;
+    WSLOG_INFO("GraphManager", "处理链创建完成，总连接数：" << connectionsCreated);
     return connectionsCreated;
 }
 
 int GraphManager::createParallelBranches(NodeID inputNodeID, NodeID outputNodeID, 
                                         const std::vector<NodeID>& branchNodeIDs) {
-    std::cout << "[GraphManager] 创建并行分支，分支数量：" << branchNodeIDs.size() << std::endl;
+    WSLOG_INFO("GraphManager", "创建并行分支，分支数量：" << branchNodeIDs.size());
     
     std::lock_guard<std::mutex> lock(operationMutex);
     beginBatchOperation("创建并行分支");
@@ -232,13 +236,16 @@ int GraphManager::createParallelBranches(NodeID inputNodeID, NodeID outputNodeID
     
     endBatchOperation();
     
-    std::cout << "[GraphManager] 并行分支创建完成，总连接数：" << connectionsCreated << std::endl;
+    WSLOG_INFO("GraphManager", "并行分支创建完成，总连接数：" << connectionsCreated);
     return connectionsCreated;
 }
 
 bool GraphManager::reorganizeNodes(const std::vector<NodeID>& nodeIDs, 
                                   const std::string& organizationType) {
-    std::cout << "[GraphManager] 重新组织节点，类型：" << organizationType << std::endl;
+    WSLOG_INFO("GraphManager", "重新组织节点，类型：" << organizationType);
+    
+    // 断开和重新连接作为一次拓扑切换提交
+    GraphAudioProcessor::ScopedTopologyChange topologyChange(graphProcessor);
     
     // 首先断开所有相关连接
     for (NodeID nodeID : nodeIDs) {
@@ -255,7 +262,7 @@ bool GraphManager::reorganizeNodes(const std::vector<NodeID>& nodeIDs,
         }
     }
     
-    std::cout << "[GraphManager] 不支持的组织类型：" << organizationType << std::endl;
+    WSLOG_INFO("GraphManager", "不支持的组织类型：" << organizationType);
     return false;
 }
 
@@ -264,7 +271,7 @@ bool GraphManager::reorganizeNodes(const std::vector<NodeID>& nodeIDs,
 //==============================================================================
 
 GraphManager::ValidationResult GraphManager::validateGraph() {
-    std::cout << "[GraphManager] 验证图的有效性" << std::endl;
+    WSLOG_DEBUG("GraphManager", "验证图的有效性");
     
     ValidationResult result;
     
@@ -326,8 +333,8 @@ GraphManager::ValidationResult GraphManager::validateGraph() {
         validationCallback(result);
     }
     
-    std::cout << "[GraphManager] 图验证完成，错误：" << result.errors.size() 
-              << "，警告：" << result.warnings.size() << std::endl;
+    WSLOG_DEBUG("GraphManager", "图验证完成，错误：" << result.errors.size() 
+            << "，警告：" << result.warnings.size());
     
     return result;
 }
@@ -371,7 +378,7 @@ GraphManager::ValidationResult GraphManager::validateConnection(const Connection
 }
 
 bool GraphManager::detectLoops() {
-    std::cout << "[GraphManager] 检测图中的环路" << std::endl;
+    WSLOG_DEBUG("GraphManager", "检测图中的环路");
     
     auto nodes = graphProcessor.getAllNodes();
     std::unordered_set<NodeID> visited;
@@ -387,12 +394,12 @@ bool GraphManager::detectLoops() {
         }
     }
     
-    std::cout << "[GraphManager] 环路检测完成，结果：" << (hasLoop ? "存在环路" : "无环路") << std::endl;
+    WSLOG_DEBUG("GraphManager", "环路检测完成，结果：" << (hasLoop ? "存在环路" : "无环路"));
     return hasLoop;
 }
 
 int GraphManager::calculateGraphDepth() {
-    std::cout << "[GraphManager] 计算图的处理深度" << std::endl;
+    WSLOG_DEBUG("GraphManager", "计算图的处理深度");
     
     auto nodes = graphProcessor.getAllNodes();
     std::unordered_map<NodeID, int> depthCache;
@@ -403,26 +410,22 @@ int GraphManager::calculateGraphDepth() {
         maxDepth = std::max(maxDepth, depth);
     }
     
-    std::cout << "[GraphManager] 图的最大深度：" << maxDepth << std::endl;
+    WSLOG_DEBUG("GraphManager", "图的最大深度：" << maxDepth);
     return maxDepth;
 }
 
 double GraphManager::estimateGraphLatency() {
-    std::cout << "[GraphManager] 估算图的总延迟" << std::endl;
-    
-    auto nodes = graphProcessor.getAllNodes();
-    double totalLatency = 0.0;
+    WSLOG_DEBUG("GraphManager", "估算图的总延迟");
     
-    for (const auto& nodeInfo : nodes) {
-        totalLatency += nodeInfo.latencyInSamples;
-    }
+    // 按最长路径计算，并联分支的延迟不会累加
+    double totalLatency = graphProcessor.getGraphLatencySamples();
     
-    std::cout << "[GraphManager] 估算的总延迟：" << totalLatency << " 采样" << std::endl;
+    WSLOG_DEBUG("GraphManager", "估算的总延迟：" << totalLatency << " 采样");
     return totalLatency;
 }
 
 GraphManager::GraphStatistics GraphManager::getGraphStatistics() {
-    std::cout << "[GraphManager] 获取图统计信息" << std::endl;
+    WSLOG_DEBUG("GraphManager", "获取图统计信息");
     
     GraphStatistics stats;
     
@@ -458,9 +461,14 @@ GraphManager::GraphStatistics GraphManager::getGraphStatistics() {
     stats.hasLoops = detectLoops();
     stats.estimatedLatency = estimateGraphLatency();
     
-    std::cout << "[GraphManager] 统计信息：节点=" << stats.totalNodes 
-              << "，连接=" << stats.totalConnections 
-              << "，深度=" << stats.maxDepth << std::endl;
+    stats.nodeProfiles = graphProcessor.getNodeProfiles();
+    for (const auto& profile : stats.nodeProfiles) {
+        stats.totalNodeTimeMs += profile.averageTimeMs;
+    }
+    
+    WSLOG_DEBUG("GraphManager", "统计信息：节点=" << stats.totalNodes 
+            << "，连接=" << stats.totalConnections 
+            << "，深度=" << stats.maxDepth);
     
     return stats;
 }
@@ -470,7 +478,7 @@ GraphManager::GraphStatistics GraphManager::getGraphStatistics() {
 //==============================================================================
 
 std::string GraphManager::createSnapshot(const std::string& name) {
-    std::cout << "[GraphManager] 创建图状态快照：" << name << std::endl;
+    WSLOG_INFO("GraphManager", "创建图状态快照：" << name);
 
     // 生成唯一的快照ID
     std::string snapshotId = "snapshot_" + std::to_string(juce::Time::currentTimeMillis());
@@ -480,41 +488,43 @@ std::string GraphManager::createSnapshot(const std::string& name) {
     graphProcessor.getStateInformation(stateData);
 
     // 保存快照
-    snapshots[snapshotId] = stateData;
+    SnapshotStore::Streams streams;
+    streams.push_back(std::move(stateData));
+    snapshotStore.add(snapshotId, "graph", name, std::move(streams));
     snapshotNames[snapshotId] = name;
 
-    std::cout << "[GraphManager] 快照创建完成，ID：" << snapshotId << std::endl;
+    WSLOG_INFO("GraphManager", "快照创建完成，ID：" << snapshotId);
     return snapshotId;
 }
 
 bool GraphManager::restoreSnapshot(const std::string& snapshotId) {
-    std::cout << "[GraphManager] 恢复图状态快照：" << snapshotId << std::endl;
+    WSLOG_INFO("GraphManager", "恢复图状态快照：" << snapshotId);
 
-    auto it = snapshots.find(snapshotId);
-    if (it == snapshots.end()) {
-        std::cout << "[GraphManager] 快照不存在：" << snapshotId << std::endl;
+    SnapshotStore::Streams streams;
+    if (!snapshotStore.get(snapshotId, streams) || streams.empty()) {
+        WSLOG_INFO("GraphManager", "快照不存在：" << snapshotId);
         return false;
     }
 
     try {
-        graphProcessor.setStateInformation(it->second.getData(),
-                                         static_cast<int>(it->second.getSize()));
-        std::cout << "[GraphManager] 快照恢复成功" << std::endl;
+        graphProcessor.setStateInformation(streams[0].getData(),
+                                         static_cast<int>(streams[0].getSize()));
+        WSLOG_INFO("GraphManager", "快照恢复成功");
         return true;
     } catch (const std::exception& e) {
-        std::cout << "[GraphManager] 快照恢复失败：" << e.what() << std::endl;
+        WSLOG_WARNING("GraphManager", "快照恢复失败：" << e.what());
         return false;
     }
 }
 
 bool GraphManager::deleteSnapshot(const std::string& snapshotId) {
-    std::cout << "[GraphManager] 删除快照：" << snapshotId << std::endl;
+    WSLOG_INFO("GraphManager", "删除快照：" << snapshotId);
 
-    auto removed1 = snapshots.erase(snapshotId);
-    auto removed2 = snapshotNames.erase(snapshotId);
+    bool removed = snapshotStore.remove(snapshotId);
+    auto removedName = snapshotNames.erase(snapshotId);
 
-    bool success = (removed1 > 0 && removed2 > 0);
-    std::cout << "[GraphManager] 快照删除" << (success ? "成功" : "失败") << std::endl;
+    bool success = (removed && removedName > 0);
+    WSLOG_INFO("GraphManager", "快照删除" << (success ? "成功" : "失败"));
     return success;
 }
 
@@ -527,57 +537,90 @@ std::unordered_map<std::string, std::string> GraphManager::getSnapshots() {
 //==============================================================================
 
 bool GraphManager::undo() {
-    std::cout << "[GraphManager] 撤销操作" << std::endl;
+    WSLOG_DEBUG("GraphManager", "撤销操作");
 
     std::lock_guard<std::mutex> lock(operationMutex);
 
     if (undoStack.empty()) {
-        std::cout << "[GraphManager] 没有可撤销的操作" << std::endl;
+        WSLOG_INFO("GraphManager", "没有可撤销的操作");
         return false;
     }
 
-    GraphOperation operation = undoStack.back();
+    GraphOperation operation = std::move(undoStack.back());
     undoStack.pop_back();
 
-    // 执行撤销操作
-    executeOperation(operation, true);
+    const size_t operationSize = estimateOperationSize(operation);
+    undoBytes -= std::min(undoBytes, operationSize);
+
+    // 执行撤销操作，其中的拓扑修改作为一次切换提交
+    {
+        GraphAudioProcessor::ScopedTopologyChange topologyChange(graphProcessor);
+        executeOperation(operation, true);
+    }
 
     // 添加到重做栈
-    redoStack.push_back(operation);
+    redoBytes += operationSize;
+    redoStack.push_back(std::move(operation));
 
-    std::cout << "[GraphManager] 撤销操作完成" << std::endl;
+    WSLOG_DEBUG("GraphManager", "撤销操作完成");
     return true;
 }
 
 bool GraphManager::redo() {
-    std::cout << "[GraphManager] 重做操作" << std::endl;
+    WSLOG_DEBUG("GraphManager", "重做操作");
 
     std::lock_guard<std::mutex> lock(operationMutex);
 
     if (redoStack.empty()) {
-        std::cout << "[GraphManager] 没有可重做的操作" << std::endl;
+        WSLOG_INFO("GraphManager", "没有可重做的操作");
         return false;
     }
 
-    GraphOperation operation = redoStack.back();
+    GraphOperation operation = std::move(redoStack.back());
     redoStack.pop_back();
 
-    // 执行重做操作
-    executeOperation(operation, false);
+    const size_t operationSize = estimateOperationSize(operation);
+    redoBytes -= std::min(redoBytes, operationSize);
+
+    // 执行重做操作，其中的拓扑修改作为一次切换提交
+    {
+        GraphAudioProcessor::ScopedTopologyChange topologyChange(graphProcessor);
+        executeOperation(operation, false);
+    }
 
     // 添加到撤销栈
-    undoStack.push_back(operation);
+    undoBytes += operationSize;
+    undoStack.push_back(std::move(operation));
 
-    std::cout << "[GraphManager] 重做操作完成" << std::endl;
+    WSLOG_DEBUG("GraphManager", "重做操作完成");
     return true;
 }
 
 void GraphManager::clearUndoHistory() {
-    std::cout << "[GraphManager] 清除撤销历史" << std::endl;
+    WSLOG_INFO("GraphManager", "清除撤销历史");
 
     std::lock_guard<std::mutex> lock(operationMutex);
     undoStack.clear();
     redoStack.clear();
+    undoBytes = 0;
+    redoBytes = 0;
+}
+
+void GraphManager::recordPropertyChange(NodeID nodeID, const std::string& propertyName,
+                                        const juce::var& oldValue, const juce::var& newValue) {
+    std::lock_guard<std::mutex> lock(operationMutex);
+
+    GraphOperation operation(OperationType::SetNodeProperty);
+    operation.nodeID = nodeID;
+    operation.propertyName = propertyName;
+    operation.oldValue = oldValue;
+    operation.newValue = newValue;
+    recordOperation(operation);
+}
+
+size_t GraphManager::getUndoHistoryBytes() const {
+    std::lock_guard<std::mutex> lock(operationMutex);
+    return undoBytes + redoBytes;
 }
 
 //==============================================================================
@@ -585,56 +628,54 @@ void GraphManager::clearUndoHistory() {
 //==============================================================================
 
 void GraphManager::beginBatchOperation(const std::string& operationName) {
-    std::cout << "[GraphManager] 开始批量操作：" << operationName << std::endl;
+    WSLOG_INFO("GraphManager", "开始批量操作：" << operationName);
 
     if (batchOperationActive) {
-        std::cout << "[GraphManager] 警告：已有活动的批量操作" << std::endl;
+        WSLOG_WARNING("GraphManager", "警告：已有活动的批量操作");
         return;
     }
 
     batchOperationActive = true;
     currentBatchName = operationName;
     currentBatchOperations.clear();
+
+    // 批量操作中的所有拓扑修改在结束时作为一次切换提交
+    graphProcessor.beginTopologyChange();
 }
 
 void GraphManager::endBatchOperation() {
-    std::cout << "[GraphManager] 结束批量操作：" << currentBatchName << std::endl;
+    WSLOG_INFO("GraphManager", "结束批量操作：" << currentBatchName);
 
     if (!batchOperationActive) {
-        std::cout << "[GraphManager] 警告：没有活动的批量操作" << std::endl;
+        WSLOG_WARNING("GraphManager", "警告：没有活动的批量操作");
         return;
     }
 
     if (!currentBatchOperations.empty()) {
         // 创建批量操作记录
         GraphOperation batchOperation(OperationType::BatchOperation);
-        batchOperation.batchOperations = currentBatchOperations;
-
-        // 添加到撤销栈
-        undoStack.push_back(batchOperation);
-
-        // 限制撤销栈大小
-        if (undoStack.size() > MAX_UNDO_LEVELS) {
-            undoStack.erase(undoStack.begin());
-        }
-
-        // 清除重做栈
-        redoStack.clear();
+        batchOperation.batchOperations = std::move(currentBatchOperations);
+        batchOperation.timestamp = juce::Time::currentTimeMillis();
 
         // 通知变化
         notifyGraphChange(batchOperation);
+
+        // 添加到撤销栈
+        pushUndoOperation(std::move(batchOperation));
     }
 
     batchOperationActive = false;
     currentBatchOperations.clear();
     currentBatchName.clear();
+
+    graphProcessor.endTopologyChange();
 }
 
 void GraphManager::cancelBatchOperation() {
-    std::cout << "[GraphManager] 取消批量操作：" << currentBatchName << std::endl;
+    WSLOG_INFO("GraphManager", "取消批量操作：" << currentBatchName);
 
     if (!batchOperationActive) {
-        std::cout << "[GraphManager] 警告：没有活动的批量操作" << std::endl;
+        WSLOG_WARNING("GraphManager", "警告：没有活动的批量操作");
         return;
     }
 
@@ -646,6 +687,8 @@ void GraphManager::cancelBatchOperation() {
     batchOperationActive = false;
     currentBatchOperations.clear();
     currentBatchName.clear();
+
+    graphProcessor.endTopologyChange();
 }
 
 //==============================================================================
@@ -685,7 +728,7 @@ std::vector<NodeID> GraphManager::getConnectedNodes(NodeID nodeID, bool incoming
 }
 
 std::vector<NodeID> GraphManager::getProcessingOrder() {
-    std::cout << "[GraphManager] 获取节点处理顺序" << std::endl;
+    WSLOG_DEBUG("GraphManager", "获取节点处理顺序");
 
     auto nodes = graphProcessor.getAllNodes();
     std::vector<NodeID> processingOrder;
@@ -719,7 +762,7 @@ std::vector<NodeID> GraphManager::getProcessingOrder() {
         }
     }
 
-    std::cout << "[GraphManager] 处理顺序包含 " << processingOrder.size() << " 个节点" << std::endl;
+    WSLOG_DEBUG("GraphManager", "处理顺序包含 " << processingOrder.size() << " 个节点");
     return processingOrder;
 }
 
@@ -756,29 +799,144 @@ std::vector<NodeID> GraphManager::findNodesByType(NodeType nodeType) {
 //==============================================================================
 
 void GraphManager::recordOperation(const GraphOperation& operation) {
+    GraphOperation timedOperation(operation);
+    if (timedOperation.timestamp == 0) {
+        timedOperation.timestamp = juce::Time::currentTimeMillis();
+    }
+
     if (batchOperationActive) {
-        currentBatchOperations.push_back(operation);
-    } else {
-        undoStack.push_back(operation);
+        if (currentBatchOperations.empty() || !coalesceInto(currentBatchOperations.back(), timedOperation)) {
+            currentBatchOperations.push_back(std::move(timedOperation));
+        }
+        return;
+    }
+
+    // 通知变化
+    notifyGraphChange(timedOperation);
 
-        // 限制撤销栈大小
-        if (undoStack.size() > MAX_UNDO_LEVELS) {
-            undoStack.erase(undoStack.begin());
+    // 连续修改同一属性时合并到上一步（重做栈为空才合并，撤销过的步骤不被改写）
+    if (!undoStack.empty() && redoStack.empty()) {
+        auto& previous = undoStack.back();
+        const size_t previousSize = estimateOperationSize(previous);
+        if (coalesceInto(previous, timedOperation)) {
+            undoBytes = undoBytes - std::min(undoBytes, previousSize) + estimateOperationSize(previous);
+            return;
         }
+    }
 
-        // 清除重做栈
-        redoStack.clear();
+    pushUndoOperation(std::move(timedOperation));
+}
 
-        // 通知变化
-        notifyGraphChange(operation);
+void GraphManager::pushUndoOperation(GraphOperation operation) {
+    undoBytes += estimateOperationSize(operation);
+    undoStack.push_back(std::move(operation));
+
+    // 清除重做栈
+    redoStack.clear();
+    redoBytes = 0;
+
+    // 超出内存预算时丢弃最早的记录（至少保留最新的一步）
+    while (undoBytes > MAX_UNDO_BYTES && undoStack.size() > 1) {
+        undoBytes -= std::min(undoBytes, estimateOperationSize(undoStack.front()));
+        undoStack.pop_front();
     }
 }
 
+bool GraphManager::coalesceInto(GraphOperation& previous, const GraphOperation& operation) {
+    if (operation.type != OperationType::SetNodeProperty
+        || previous.type != OperationType::SetNodeProperty
+        || previous.nodeID != operation.nodeID
+        || previous.propertyName != operation.propertyName
+        || operation.timestamp - previous.timestamp > COALESCE_WINDOW_MS) {
+        return false;
+    }
+
+    // 保留最初的旧值，只更新新值
+    previous.newValue = operation.newValue;
+    previous.timestamp = operation.timestamp;
+    return true;
+}
+
 void GraphManager::executeOperation(const GraphOperation& operation, bool isUndo) {
-    // 这里需要根据操作类型执行相应的撤销/重做操作
-    // 由于JUCE AudioProcessorGraph的限制，某些操作可能无法完全撤销
-    std::cout << "[GraphManager] 执行操作，类型：" << static_cast<int>(operation.type)
-              << "，撤销：" << (isUndo ? "是" : "否") << std::endl;
+    switch (operation.type) {
+        case OperationType::AddConnection:
+        case OperationType::RemoveConnection: {
+            const bool shouldConnect = (operation.type == OperationType::AddConnection) != isUndo;
+            if (!shouldConnect) {
+                graphProcessor.disconnect(operation.connection);
+            } else if (operation.connection.source.isMIDI()) {
+                graphProcessor.connectMidi(operation.connection.source.nodeID,
+                                           operation.connection.destination.nodeID);
+            } else {
+                graphProcessor.connectAudio(operation.connection.source.nodeID,
+                                            operation.connection.source.channelIndex,
+                                            operation.connection.destination.nodeID,
+                                            operation.connection.destination.channelIndex);
+            }
+            break;
+        }
+
+        case OperationType::SetNodeProperty:
+            applyNodeProperty(operation.nodeID, operation.propertyName,
+                              isUndo ? operation.oldValue : operation.newValue);
+            break;
+
+        case OperationType::BatchOperation:
+            // 撤销时按相反顺序执行
+            if (isUndo) {
+                for (auto it = operation.batchOperations.rbegin(); it != operation.batchOperations.rend(); ++it) {
+                    executeOperation(*it, true);
+                }
+            } else {
+                for (const auto& subOperation : operation.batchOperations) {
+                    executeOperation(subOperation, false);
+                }
+            }
+            break;
+
+        case OperationType::AddNode:
+        case OperationType::RemoveNode:
+            // 节点的处理器实例不保存在历史中，无法重建
+            WSLOG_INFO("GraphManager", "节点增删无法撤销/重做，节点：" << operation.nodeID.uid);
+            break;
+    }
+}
+
+void GraphManager::applyNodeProperty(NodeID nodeID, const std::string& propertyName, const juce::var& value) {
+    if (propertyName == "bypassed") {
+        graphProcessor.setNodeBypassed(nodeID, static_cast<bool>(value));
+    } else if (propertyName == "enabled") {
+        graphProcessor.setNodeEnabled(nodeID, static_cast<bool>(value));
+    } else if (juce::String(propertyName).startsWith("parameter:")) {
+        auto* node = graphProcessor.getGraph().getNodeForId(nodeID);
+        auto* wrapper = node ? dynamic_cast<ProfiledPluginProcessor*>(node->getProcessor()) : nullptr;
+        if (wrapper) {
+            ParameterEvent event;
+            event.parameterIndex = juce::String(propertyName).fromFirstOccurrenceOf(":", false, false).getIntValue();
+            event.value = static_cast<float>(value);
+            wrapper->queueParameterChanges({ event });
+        }
+    } else {
+        WSLOG_INFO("GraphManager", "未知的节点属性：" << propertyName);
+    }
+}
+
+size_t GraphManager::estimateOperationSize(const GraphOperation& operation) {
+    auto varSize = [](const juce::var& value) -> size_t {
+        if (auto* block = value.getBinaryData()) {
+            return block->getSize();
+        }
+        return value.isString() ? value.toString().getNumBytesAsUTF8() : sizeof(juce::var);
+    };
+
+    size_t size = sizeof(GraphOperation) + operation.propertyName.size()
+                + varSize(operation.oldValue) + varSize(operation.newValue);
+
+    for (const auto& subOperation : operation.batchOperations) {
+        size += estimateOperationSize(subOperation);
+    }
+
+    return size;
 }
 
 void GraphManager::notifyGraphChange(const GraphOperation& operation) {
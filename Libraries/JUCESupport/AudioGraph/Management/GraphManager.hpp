@@ -11,11 +11,13 @@
 #include <JuceHeader.h>
 #include <memory>
 #include <vector>
+#include <deque>
 #include <unordered_map>
 #include <functional>
 #include <string>
 #include "../Core/GraphAudioProcessor.hpp"
 #include "../Core/AudioGraphTypes.hpp"
+#include "SnapshotStore.hpp"
 
 namespace WindsynthVST::AudioGraph {
 
@@ -59,6 +61,7 @@ public:
         juce::var oldValue;
         juce::var newValue;
         std::vector<GraphOperation> batchOperations;
+        juce::int64 timestamp = 0;          // 记录时间（毫秒），用于合并连续的属性修改
         
         GraphOperation(OperationType t) : type(t) {}
     };
@@ -94,6 +97,8 @@ public:
         int maxDepth = 0;
         bool hasLoops = false;
         double estimatedLatency = 0.0;
+        std::vector<NodeProfile> nodeProfiles;  // 每个插件节点的处理耗时（需启用节点耗时统计）
+        double totalNodeTimeMs = 0.0;           // 所有插件节点平均耗时之和
     };
     
     //==============================================================================
@@ -300,6 +305,19 @@ public:
      */
     bool canRedo() const { return !redoStack.empty(); }
     
+    /**
+     * 记录节点属性修改（不执行修改）
+     * 同一节点同一属性在短时间内的连续修改合并为一步撤销
+     * @param propertyName "bypassed"、"enabled" 或 "parameter:<索引>"（归一化参数值）
+     */
+    void recordPropertyChange(NodeID nodeID, const std::string& propertyName,
+                              const juce::var& oldValue, const juce::var& newValue);
+    
+    /**
+     * 获取撤销/重做历史占用的内存估计（字节）
+     */
+    size_t getUndoHistoryBytes() const;
+    
     //==============================================================================
     // 批量操作
     //==============================================================================
@@ -372,18 +390,21 @@ private:
     
     GraphAudioProcessor& graphProcessor;
     
-    // 撤销/重做栈
-    std::vector<GraphOperation> undoStack;
-    std::vector<GraphOperation> redoStack;
-    static constexpr size_t MAX_UNDO_LEVELS = 50;
+    // 撤销/重做历史（按占用字节数限制，超出时丢弃最早的记录）
+    std::deque<GraphOperation> undoStack;
+    std::deque<GraphOperation> redoStack;
+    size_t undoBytes = 0;
+    size_t redoBytes = 0;
+    static constexpr size_t MAX_UNDO_BYTES = 4 * 1024 * 1024;
+    static constexpr juce::int64 COALESCE_WINDOW_MS = 1000;
     
     // 批量操作状态
     bool batchOperationActive = false;
     std::vector<GraphOperation> currentBatchOperations;
     std::string currentBatchName;
     
-    // 快照管理
-    std::unordered_map<std::string, juce::MemoryBlock> snapshots;
+    // 快照管理（只保存在内存中，相同的数据块在快照之间共享）
+    SnapshotStore snapshotStore;
     std::unordered_map<std::string, std::string> snapshotNames;
     
     // 回调函数
@@ -398,7 +419,11 @@ private:
     //==============================================================================
     
     void recordOperation(const GraphOperation& operation);
+    void pushUndoOperation(GraphOperation operation);
+    static bool coalesceInto(GraphOperation& previous, const GraphOperation& operation);
     void executeOperation(const GraphOperation& operation, bool isUndo = false);
+    void applyNodeProperty(NodeID nodeID, const std::string& propertyName, const juce::var& value);
+    static size_t estimateOperationSize(const GraphOperation& operation);
     void notifyGraphChange(const GraphOperation& operation);
     void notifyValidationResult(const ValidationResult& result);
     
@@ -0,0 +1,651 @@
+//
+//  PresetLibrary.cpp
+//  WindsynthRecorder
+//
+//  Created by AI Assistant
+//  预设库实现
+//
+
+#include "PresetLibrary.hpp"
+#include "../Core/Logger.hpp"
+#include <algorithm>
+#include <iterator>
+
+namespace WindsynthVST::AudioGraph {
+
+//==============================================================================
+// 容器格式
+//==============================================================================
+
+namespace {
+
+constexpr int makeChunkID(char a, char b, char c, char d) {
+    return static_cast<int>(static_cast<juce::uint32>(static_cast<juce::uint8>(a))
+                            | (static_cast<juce::uint32>(static_cast<juce::uint8>(b)) << 8)
+                            | (static_cast<juce::uint32>(static_cast<juce::uint8>(c)) << 16)
+                            | (static_cast<juce::uint32>(static_cast<juce::uint8>(d)) << 24));
+}
+
+constexpr int fileMagic = makeChunkID('W', 'S', 'P', 'L');
+constexpr int fileFormatVersion = 1;
+
+constexpr int chunkInfo = makeChunkID('I', 'N', 'F', 'O');
+constexpr int chunkConfig = makeChunkID('C', 'O', 'N', 'F');
+constexpr int chunkGraph = makeChunkID('G', 'R', 'P', 'H');
+constexpr int chunkPlugins = makeChunkID('P', 'L', 'U', 'G');
+constexpr int chunkConnections = makeChunkID('C', 'O', 'N', 'N');
+constexpr int chunkIOConfig = makeChunkID('I', 'O', 'C', 'F');
+
+constexpr int chunkFlagDeflate = 1 << 0;
+
+constexpr size_t headerSize = 8;                    // 魔数 + 版本
+constexpr size_t chunkHeaderSize = 24;              // ID + 标志 + 存储长度 + 原始长度
+constexpr size_t minCompressedChunkSize = 256;      // 更小的数据块不压缩
+constexpr juce::int64 maxInfoChunkSize = 1 << 20;
+constexpr int maxIndexedTokenLength = 64;
+
+void writeChunk(juce::OutputStream& output, int chunkID, const void* data, size_t size, bool compress) {
+    juce::MemoryBlock compressed;
+    if (compress && size >= minCompressedChunkSize) {
+        juce::MemoryOutputStream compressedStream;
+        {
+            juce::GZIPCompressorOutputStream deflater(compressedStream, 6);
+            deflater.write(data, size);
+        }
+        // 压缩后没有变小的数据原样保存
+        if (compressedStream.getDataSize() < size) {
+            compressed = compressedStream.getMemoryBlock();
+        }
+    }
+
+    const bool useCompressed = compressed.getSize() > 0;
+    output.writeInt(chunkID);
+    output.writeInt(useCompressed ? chunkFlagDeflate : 0);
+    output.writeInt64(static_cast<juce::int64>(useCompressed ? compressed.getSize() : size));
+    output.writeInt64(static_cast<juce::int64>(size));
+    if (useCompressed) {
+        output.write(compressed.getData(), compressed.getSize());
+    } else if (size > 0) {
+        output.write(data, size);
+    }
+}
+
+void writeChunk(juce::OutputStream& output, int chunkID, const juce::MemoryBlock& data, bool compress) {
+    writeChunk(output, chunkID, data.getData(), data.getSize(), compress);
+}
+
+bool readChunkPayload(const void* data, size_t size, int flags, juce::int64 rawSize, juce::MemoryBlock& payload) {
+    if ((flags & chunkFlagDeflate) == 0) {
+        payload.replaceAll(data, size);
+        return true;
+    }
+
+    juce::MemoryInputStream source(data, size, false);
+    juce::GZIPDecompressorInputStream inflater(&source, false,
+                                               juce::GZIPDecompressorInputStream::zlibFormat, rawSize);
+    payload.reset();
+    inflater.readIntoMemoryBlock(payload);
+    return static_cast<juce::int64>(payload.getSize()) == rawSize;
+}
+
+juce::MemoryBlock encodeMetadata(const PresetMetadata& info) {
+    juce::MemoryOutputStream stream;
+    stream.writeString(juce::String::fromUTF8(info.name.c_str()));
+    stream.writeString(juce::String::fromUTF8(info.description.c_str()));
+    stream.writeString(juce::String::fromUTF8(info.category.c_str()));
+    stream.writeString(juce::String::fromUTF8(info.author.c_str()));
+    stream.writeString(info.version);
+    stream.writeInt64(info.createdTime.toMilliseconds());
+    stream.writeInt64(info.modifiedTime.toMilliseconds());
+    stream.writeInt(static_cast<int>(info.tags.size()));
+    for (const auto& tag : info.tags) {
+        stream.writeString(juce::String::fromUTF8(tag.c_str()));
+    }
+    return stream.getMemoryBlock();
+}
+
+bool decodeMetadata(const juce::MemoryBlock& data, PresetMetadata& info) {
+    juce::MemoryInputStream stream(data, false);
+    info.name = stream.readString().toStdString();
+    info.description = stream.readString().toStdString();
+    info.category = stream.readString().toStdString();
+    info.author = stream.readString().toStdString();
+    info.version = stream.readString();
+    info.createdTime = juce::Time(stream.readInt64());
+    info.modifiedTime = juce::Time(stream.readInt64());
+
+    const int numTags = stream.readInt();
+    info.tags.clear();
+    for (int i = 0; i < numTags && !stream.isExhausted(); ++i) {
+        info.tags.push_back(stream.readString().toStdString());
+    }
+    return !info.name.empty();
+}
+
+juce::MemoryBlock encodeConfig(const GraphConfig& config) {
+    juce::MemoryOutputStream stream;
+    stream.writeDouble(config.sampleRate);
+    stream.writeInt(config.samplesPerBlock);
+    stream.writeInt(config.numInputChannels);
+    stream.writeInt(config.numOutputChannels);
+    stream.writeBool(config.enableMidi);
+    stream.writeBool(config.enableLatencyCompensation);
+    return stream.getMemoryBlock();
+}
+
+void decodeConfig(const juce::MemoryBlock& data, GraphConfig& config) {
+    juce::MemoryInputStream stream(data, false);
+    config.sampleRate = stream.readDouble();
+    config.samplesPerBlock = stream.readInt();
+    config.numInputChannels = stream.readInt();
+    config.numOutputChannels = stream.readInt();
+    config.enableMidi = stream.readBool();
+    config.enableLatencyCompensation = stream.readBool();
+}
+
+} // namespace
+
+//==============================================================================
+// 预设文件
+//==============================================================================
+
+bool PresetLibrary::writePresetFile(const juce::File& file, const PresetMetadata& info,
+                                    const PresetGraphState& state, bool compress) {
+    if (!file.getParentDirectory().createDirectory()) {
+        WSLOG_ERROR("PresetLibrary", "无法创建目录：" << file.getParentDirectory().getFullPathName());
+        return false;
+    }
+
+    // 先写入临时文件再替换，写入失败时不会损坏原文件
+    juce::TemporaryFile tempFile(file);
+    {
+        juce::FileOutputStream output(tempFile.getFile());
+        if (!output.openedOk()) {
+            WSLOG_ERROR("PresetLibrary", "无法写入预设文件：" << file.getFullPathName());
+            return false;
+        }
+
+        output.writeInt(fileMagic);
+        output.writeInt(fileFormatVersion);
+
+        // 元数据块必须在最前面且不压缩，扫描目录时只读取这一块
+        writeChunk(output, chunkInfo, encodeMetadata(info), false);
+        writeChunk(output, chunkConfig, encodeConfig(state.config), false);
+        writeChunk(output, chunkGraph, state.graphData, compress);
+        writeChunk(output, chunkPlugins, state.pluginStates, compress);
+        writeChunk(output, chunkConnections, state.connections, compress);
+        writeChunk(output, chunkIOConfig, state.ioConfig, false);
+
+        output.flush();
+        if (output.getStatus().failed()) {
+            WSLOG_ERROR("PresetLibrary", "写入预设文件失败：" << output.getStatus().getErrorMessage());
+            return false;
+        }
+    }
+
+    return tempFile.overwriteTargetFileWithTemporary();
+}
+
+bool PresetLibrary::readPresetMetadata(const juce::File& file, PresetMetadata& info) {
+    juce::FileInputStream input(file);
+    if (!input.openedOk()) {
+        return false;
+    }
+
+    if (input.readInt() != fileMagic || input.readInt() > fileFormatVersion) {
+        return false;
+    }
+
+    const int chunkID = input.readInt();
+    const int flags = input.readInt();
+    const juce::int64 storedSize = input.readInt64();
+    const juce::int64 rawSize = input.readInt64();
+
+    if (chunkID != chunkInfo || flags != 0 || storedSize != rawSize
+        || storedSize <= 0 || storedSize > maxInfoChunkSize) {
+        return false;
+    }
+
+    juce::MemoryBlock payload;
+    if (input.readIntoMemoryBlock(payload, static_cast<ssize_t>(storedSize)) != static_cast<size_t>(storedSize)) {
+        return false;
+    }
+
+    return decodeMetadata(payload, info);
+}
+
+bool PresetLibrary::readPresetFile(const juce::File& file, PresetMetadata& info, PresetGraphState& state) {
+    juce::MemoryMappedFile mapped(file, juce::MemoryMappedFile::readOnly);
+    if (mapped.getData() != nullptr) {
+        return readState(mapped.getData(), mapped.getSize(), &info, &state);
+    }
+
+    juce::MemoryBlock data;
+    if (!file.loadFileAsData(data)) {
+        return false;
+    }
+    return readState(data.getData(), data.getSize(), &info, &state);
+}
+
+bool PresetLibrary::readState(const void* data, size_t size, PresetMetadata* info, PresetGraphState* state) {
+    if (size < headerSize) {
+        return false;
+    }
+
+    juce::MemoryInputStream input(data, size, false);
+    if (input.readInt() != fileMagic || input.readInt() > fileFormatVersion) {
+        return false;
+    }
+
+    const auto* bytes = static_cast<const char*>(data);
+    bool hasInfo = false;
+
+    while (static_cast<size_t>(input.getPosition()) + chunkHeaderSize <= size) {
+        const int chunkID = input.readInt();
+        const int flags = input.readInt();
+        const juce::int64 storedSize = input.readInt64();
+        const juce::int64 rawSize = input.readInt64();
+        const auto position = static_cast<size_t>(input.getPosition());
+
+        if (storedSize < 0 || rawSize < 0 || static_cast<juce::uint64>(storedSize) > size - position) {
+            WSLOG_ERROR("PresetLibrary", "预设文件已损坏");
+            return false;
+        }
+
+        const bool wanted = (chunkID == chunkInfo && info != nullptr) || (chunkID != chunkInfo && state != nullptr);
+        if (wanted) {
+            juce::MemoryBlock payload;
+            if (!readChunkPayload(bytes + position, static_cast<size_t>(storedSize), flags, rawSize, payload)) {
+                WSLOG_ERROR("PresetLibrary", "无法解压预设数据块");
+                return false;
+            }
+
+            if (chunkID == chunkInfo) {
+                hasInfo = decodeMetadata(payload, *info);
+            } else if (chunkID == chunkConfig) {
+                decodeConfig(payload, state->config);
+            } else if (chunkID == chunkGraph) {
+                state->graphData = std::move(payload);
+            } else if (chunkID == chunkPlugins) {
+                state->pluginStates = std::move(payload);
+            } else if (chunkID == chunkConnections) {
+                state->connections = std::move(payload);
+            } else if (chunkID == chunkIOConfig) {
+                state->ioConfig = std::move(payload);
+            }
+            // 未知数据块（更新版本写入的）直接跳过
+        }
+
+        input.setPosition(static_cast<juce::int64>(position) + storedSize);
+    }
+
+    return info == nullptr || hasInfo;
+}
+
+//==============================================================================
+// 库目录
+//==============================================================================
+
+int PresetLibrary::open(const juce::File& newDirectory) {
+    if (!newDirectory.createDirectory()) {
+        WSLOG_ERROR("PresetLibrary", "无法创建预设目录：" << newDirectory.getFullPathName());
+        return -1;
+    }
+
+    directory = newDirectory;
+    entries.clear();
+    nameIndex.clear();
+    nameTokens.clear();
+    descriptionTokens.clear();
+    tagTokens.clear();
+    exactTags.clear();
+
+    const auto startTime = juce::Time::getMillisecondCounterHiRes();
+
+    for (const auto& item : juce::RangedDirectoryIterator(directory, false, juce::String("*") + fileExtension,
+                                                          juce::File::findFiles)) {
+        Entry entry;
+        if (!readPresetMetadata(item.getFile(), entry.info)) {
+            WSLOG_INFO("PresetLibrary", "跳过无效的预设文件：" << item.getFile().getFileName());
+            continue;
+        }
+
+        if (contains(entry.info.name)) {
+            WSLOG_INFO("PresetLibrary", "跳过重名的预设：" << entry.info.name);
+            continue;
+        }
+
+        entry.file = item.getFile();
+        addEntry(std::move(entry));
+    }
+
+    WSLOG_INFO("PresetLibrary", "加载预设索引：" << entries.size() << " 个预设，用时 "
+            << juce::roundToInt(juce::Time::getMillisecondCounterHiRes() - startTime) << "ms");
+    return static_cast<int>(entries.size());
+}
+
+//==============================================================================
+// 预设操作
+//==============================================================================
+
+bool PresetLibrary::store(const PresetMetadata& info, const PresetGraphState& state) {
+    if (info.name.empty()) {
+        return false;
+    }
+
+    Entry entry;
+    entry.info = info;
+
+    auto existing = nameIndex.find(info.name);
+    if (directory != juce::File()) {
+        entry.file = existing != nameIndex.end() ? entries.at(existing->second).file : chooseFileFor(info.name);
+        if (!writePresetFile(entry.file, info, state, compressionEnabled)) {
+            return false;
+        }
+    } else {
+        entry.state = std::make_unique<PresetGraphState>(state);
+    }
+
+    if (existing != nameIndex.end()) {
+        removeEntry(existing->second);
+    }
+    addEntry(std::move(entry));
+    return true;
+}
+
+bool PresetLibrary::loadState(const std::string& name, PresetGraphState& state) const {
+    auto it = nameIndex.find(name);
+    if (it == nameIndex.end()) {
+        return false;
+    }
+
+    const auto& entry = entries.at(it->second);
+    if (entry.state) {
+        state = *entry.state;
+        return true;
+    }
+
+    juce::MemoryMappedFile mapped(entry.file, juce::MemoryMappedFile::readOnly);
+    if (mapped.getData() != nullptr) {
+        return readState(mapped.getData(), mapped.getSize(), nullptr, &state);
+    }
+
+    juce::MemoryBlock data;
+    if (!entry.file.loadFileAsData(data)) {
+        WSLOG_ERROR("PresetLibrary", "无法读取预设文件：" << entry.file.getFullPathName());
+        return false;
+    }
+    return readState(data.getData(), data.getSize(), nullptr, &state);
+}
+
+bool PresetLibrary::updateMetadata(const std::string& name, const PresetMetadata& info) {
+    auto it = nameIndex.find(name);
+    if (it == nameIndex.end() || info.name.empty()) {
+        return false;
+    }
+    if (info.name != name && contains(info.name)) {
+        return false;
+    }
+
+    const PresetID id = it->second;
+    auto& current = entries.at(id);
+
+    Entry entry;
+    entry.info = info;
+    entry.file = current.file;
+
+    if (current.state) {
+        entry.state = std::move(current.state);
+    } else {
+        // 状态数据块原样写回（需要先读出，元数据块长度可能变化）
+        PresetGraphState state;
+        if (!loadState(name, state) || !writePresetFile(entry.file, info, state, compressionEnabled)) {
+            return false;
+        }
+    }
+
+    removeEntry(id);
+    addEntry(std::move(entry));
+    return true;
+}
+
+bool PresetLibrary::remove(const std::string& name) {
+    auto it = nameIndex.find(name);
+    if (it == nameIndex.end()) {
+        return false;
+    }
+
+    const PresetID id = it->second;
+    const auto& file = entries.at(id).file;
+    if (file != juce::File() && file.existsAsFile() && !file.deleteFile()) {
+        WSLOG_ERROR("PresetLibrary", "无法删除预设文件：" << file.getFullPathName());
+        return false;
+    }
+
+    removeEntry(id);
+    return true;
+}
+
+const PresetMetadata* PresetLibrary::getMetadata(const std::string& name) const {
+    auto it = nameIndex.find(name);
+    return it != nameIndex.end() ? &entries.at(it->second).info : nullptr;
+}
+
+std::vector<std::string> PresetLibrary::getAllNames() const {
+    std::vector<std::string> names;
+    names.reserve(nameIndex.size());
+    for (const auto& pair : nameIndex) {
+        names.push_back(pair.first);
+    }
+    std::sort(names.begin(), names.end());
+    return names;
+}
+
+//==============================================================================
+// 查询
+//==============================================================================
+
+std::vector<std::string> PresetLibrary::search(const std::string& text, int fields) const {
+    const auto queryTokens = tokenize(text);
+    if (queryTokens.empty()) {
+        return getAllNames();
+    }
+
+    Postings result;
+    bool first = true;
+
+    for (const auto& token : queryTokens) {
+        Postings matches;
+        if (fields & searchName) {
+            collectPrefix(nameTokens, token, matches);
+        }
+        if (fields & searchDescription) {
+            collectPrefix(descriptionTokens, token, matches);
+        }
+        if (fields & searchTags) {
+            collectPrefix(tagTokens, token, matches);
+        }
+
+        std::sort(matches.begin(), matches.end());
+        matches.erase(std::unique(matches.begin(), matches.end()), matches.end());
+
+        if (first) {
+            result = std::move(matches);
+            first = false;
+        } else {
+            Postings intersection;
+            std::set_intersection(result.begin(), result.end(), matches.begin(), matches.end(),
+                                  std::back_inserter(intersection));
+            result = std::move(intersection);
+        }
+
+        if (result.empty()) {
+            break;
+        }
+    }
+
+    std::vector<std::string> names;
+    names.reserve(result.size());
+    for (auto id : result) {
+        names.push_back(entries.at(id).info.name);
+    }
+    std::sort(names.begin(), names.end());
+    return names;
+}
+
+std::vector<std::string> PresetLibrary::findByTag(const std::string& tag) const {
+    std::vector<std::string> names;
+
+    auto it = exactTags.find(tag);
+    if (it != exactTags.end()) {
+        names.reserve(it->second.size());
+        for (auto id : it->second) {
+            names.push_back(entries.at(id).info.name);
+        }
+        std::sort(names.begin(), names.end());
+    }
+    return names;
+}
+
+//==============================================================================
+// 索引
+//==============================================================================
+
+PresetLibrary::PresetID PresetLibrary::addEntry(Entry entry) {
+    const PresetID id = nextID++;
+    nameIndex[entry.info.name] = id;
+    indexEntry(id, entry.info);
+    entries.emplace(id, std::move(entry));
+    return id;
+}
+
+void PresetLibrary::removeEntry(PresetID id) {
+    auto it = entries.find(id);
+    if (it == entries.end()) {
+        return;
+    }
+
+    unindexEntry(id, it->second.info);
+    nameIndex.erase(it->second.info.name);
+    entries.erase(it);
+}
+
+void PresetLibrary::indexEntry(PresetID id, const PresetMetadata& info) {
+    for (const auto& token : tokenize(info.name)) {
+        addPosting(nameTokens, token, id);
+    }
+    for (const auto& token : tokenize(info.description)) {
+        addPosting(descriptionTokens, token, id);
+    }
+    for (const auto& tag : info.tags) {
+        for (const auto& token : tokenize(tag)) {
+            addPosting(tagTokens, token, id);
+        }
+
+        auto& postings = exactTags[tag];
+        if (postings.empty() || postings.back() != id) {
+            postings.push_back(id);
+        }
+    }
+}
+
+void PresetLibrary::unindexEntry(PresetID id, const PresetMetadata& info) {
+    for (const auto& token : tokenize(info.name)) {
+        removePosting(nameTokens, token, id);
+    }
+    for (const auto& token : tokenize(info.description)) {
+        removePosting(descriptionTokens, token, id);
+    }
+    for (const auto& tag : info.tags) {
+        for (const auto& token : tokenize(tag)) {
+            removePosting(tagTokens, token, id);
+        }
+
+        auto it = exactTags.find(tag);
+        if (it != exactTags.end()) {
+            auto& postings = it->second;
+            postings.erase(std::remove(postings.begin(), postings.end(), id), postings.end());
+            if (postings.empty()) {
+                exactTags.erase(it);
+            }
+        }
+    }
+}
+
+std::vector<std::string> PresetLibrary::tokenize(const std::string& text) {
+    std::vector<std::string> tokens;
+    juce::String current;
+
+    auto flush = [&tokens, &current]() {
+        if (current.isNotEmpty()) {
+            tokens.push_back(current.substring(0, maxIndexedTokenLength).toStdString());
+            current.clear();
+        }
+    };
+
+    const auto lower = juce::String::fromUTF8(text.c_str()).toLowerCase();
+    for (auto ptr = lower.getCharPointer(); !ptr.isEmpty(); ++ptr) {
+        const juce::juce_wchar c = *ptr;
+
+        if (c >= 0x2E80) {
+            // 中日韩文字没有空格分词，每个字单独作为一个词
+            flush();
+            current += c;
+            flush();
+        } else if (juce::CharacterFunctions::isLetterOrDigit(c)) {
+            current += c;
+        } else {
+            flush();
+        }
+    }
+    flush();
+
+    return tokens;
+}
+
+void PresetLibrary::addPosting(TokenIndex& index, const std::string& token, PresetID id) {
+    // 索引词的每个后缀，查询词作为前缀查找时即可匹配词内任意位置
+    const auto text = juce::String::fromUTF8(token.c_str());
+    for (int i = 0; i < text.length(); ++i) {
+        auto& postings = index[text.substring(i).toStdString()];
+        if (postings.empty() || postings.back() != id) {
+            postings.push_back(id);
+        }
+    }
+}
+
+void PresetLibrary::removePosting(TokenIndex& index, const std::string& token, PresetID id) {
+    const auto text = juce::String::fromUTF8(token.c_str());
+    for (int i = 0; i < text.length(); ++i) {
+        auto it = index.find(text.substring(i).toStdString());
+        if (it == index.end()) {
+            continue;
+        }
+
+        auto& postings = it->second;
+        auto position = std::lower_bound(postings.begin(), postings.end(), id);
+        if (position != postings.end() && *position == id) {
+            postings.erase(position);
+        }
+        if (postings.empty()) {
+            index.erase(it);
+        }
+    }
+}
+
+void PresetLibrary::collectPrefix(const TokenIndex& index, const std::string& prefix, Postings& result) {
+    for (auto it = index.lower_bound(prefix);
+         it != index.end() && it->first.compare(0, prefix.size(), prefix) == 0; ++it) {
+        result.insert(result.end(), it->second.begin(), it->second.end());
+    }
+}
+
+juce::File PresetLibrary::chooseFileFor(const std::string& name) const {
+    auto baseName = juce::File::createLegalFileName(juce::String::fromUTF8(name.c_str())).trim();
+    if (baseName.isEmpty()) {
+        baseName = "Preset";
+    }
+    return directory.getNonexistentChildFile(baseName, fileExtension, false);
+}
+
+} // namespace WindsynthVST::AudioGraph
@@ -0,0 +1,231 @@
+//
+//  PresetLibrary.hpp
+//  WindsynthRecorder
+//
+//  Created by AI Assistant
+//  预设库 - 启动时只加载元数据索引，状态数据按需读取
+//
+
+#pragma once
+
+#include <JuceHeader.h>
+#include <map>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include <cstdint>
+#include "../Core/AudioGraphTypes.hpp"
+
+namespace WindsynthVST::AudioGraph {
+
+/**
+ * 预设元数据
+ */
+struct PresetMetadata {
+    std::string name;
+    std::string description;
+    std::string category;
+    std::string author;
+    juce::String version;
+    juce::Time createdTime;
+    juce::Time modifiedTime;
+    std::vector<std::string> tags;
+
+    PresetMetadata() = default;
+    PresetMetadata(const std::string& n, const std::string& desc = "", const std::string& cat = "")
+        : name(n), description(desc), category(cat),
+          createdTime(juce::Time::getCurrentTime()), modifiedTime(juce::Time::getCurrentTime()) {}
+};
+
+/**
+ * 预设的图状态数据
+ */
+struct PresetGraphState {
+    juce::MemoryBlock graphData;        // 图结构数据
+    juce::MemoryBlock pluginStates;    // 所有插件状态
+    juce::MemoryBlock connections;     // 连接信息
+    juce::MemoryBlock ioConfig;        // I/O配置
+    GraphConfig config;                // 图配置
+
+    bool isValid() const {
+        return graphData.getSize() > 0;
+    }
+};
+
+/**
+ * 预设库
+ *
+ * 每个预设保存为一个二进制容器文件（*.wspreset），由长度前缀的数据块组成：
+ * 元数据块在最前面且不压缩，打开库时只读取每个文件开头的元数据块；
+ * 状态数据块可以用 deflate 压缩，只在 loadState() 时通过内存映射读取。
+ *
+ * 名称、描述和标签按词建立倒排索引（索引每个词的所有后缀，前缀查找即可匹配词内子串），
+ * 搜索不需要遍历所有预设。没有设置目录时预设只保存在内存中。
+ *
+ * 不是线程安全的，调用方负责同步。
+ */
+class PresetLibrary {
+public:
+    /**
+     * 搜索范围
+     */
+    enum SearchField {
+        searchName = 1 << 0,
+        searchDescription = 1 << 1,
+        searchTags = 1 << 2,
+        searchAll = searchName | searchDescription | searchTags
+    };
+
+    static constexpr const char* fileExtension = ".wspreset";
+
+    PresetLibrary() = default;
+
+    //==============================================================================
+    // 库目录
+    //==============================================================================
+
+    /**
+     * 打开预设目录，读取所有预设文件的元数据（内存中的预设会被丢弃）
+     * @return 加载的预设数量，目录无法创建时返回-1
+     */
+    int open(const juce::File& directory);
+
+    /**
+     * 获取预设目录（内存库返回空文件）
+     */
+    juce::File getDirectory() const { return directory; }
+
+    /**
+     * 是否压缩状态数据（默认启用）
+     */
+    void setCompressionEnabled(bool enabled) { compressionEnabled = enabled; }
+
+    //==============================================================================
+    // 预设操作
+    //==============================================================================
+
+    /**
+     * 保存预设（同名预设被替换）
+     * @return 成功返回true
+     */
+    bool store(const PresetMetadata& info, const PresetGraphState& state);
+
+    /**
+     * 读取预设的状态数据
+     * @return 成功返回true
+     */
+    bool loadState(const std::string& name, PresetGraphState& state) const;
+
+    /**
+     * 更新预设元数据（info.name 与 name 不同时重命名），状态数据保持不变
+     * @return 成功返回true
+     */
+    bool updateMetadata(const std::string& name, const PresetMetadata& info);
+
+    /**
+     * 删除预设
+     * @return 成功返回true
+     */
+    bool remove(const std::string& name);
+
+    /**
+     * 预设是否存在
+     */
+    bool contains(const std::string& name) const { return nameIndex.count(name) > 0; }
+
+    /**
+     * 获取预设元数据，未找到时返回nullptr
+     */
+    const PresetMetadata* getMetadata(const std::string& name) const;
+
+    /**
+     * 获取所有预设名称（排序后）
+     */
+    std::vector<std::string> getAllNames() const;
+
+    /**
+     * 预设数量
+     */
+    int size() const { return static_cast<int>(entries.size()); }
+
+    //==============================================================================
+    // 查询
+    //==============================================================================
+
+    /**
+     * 搜索预设（不区分大小写，所有查询词都必须出现在选定范围内）
+     * @param text 搜索文本，为空时返回所有预设
+     * @param fields SearchField 的组合
+     * @return 匹配的预设名称（排序后）
+     */
+    std::vector<std::string> search(const std::string& text, int fields = searchAll) const;
+
+    /**
+     * 按完整标签查找预设
+     */
+    std::vector<std::string> findByTag(const std::string& tag) const;
+
+    //==============================================================================
+    // 预设文件
+    //==============================================================================
+
+    /**
+     * 写入预设文件
+     * @return 成功返回true
+     */
+    static bool writePresetFile(const juce::File& file, const PresetMetadata& info,
+                                const PresetGraphState& state, bool compress = true);
+
+    /**
+     * 只读取预设文件的元数据
+     * @return 成功返回true
+     */
+    static bool readPresetMetadata(const juce::File& file, PresetMetadata& info);
+
+    /**
+     * 读取整个预设文件
+     * @return 成功返回true
+     */
+    static bool readPresetFile(const juce::File& file, PresetMetadata& info, PresetGraphState& state);
+
+private:
+    using PresetID = uint32_t;
+    using Postings = std::vector<PresetID>;        // 按ID升序
+    using TokenIndex = std::map<std::string, Postings>;
+
+    struct Entry {
+        PresetMetadata info;
+        juce::File file;                                // 内存库为空
+        std::unique_ptr<PresetGraphState> state;        // 只有内存库保存状态
+    };
+
+    juce::File directory;
+    bool compressionEnabled = true;
+
+    std::unordered_map<PresetID, Entry> entries;
+    std::unordered_map<std::string, PresetID> nameIndex;
+    PresetID nextID = 1;                                // 重新索引时分配新ID，倒排表保持有序
+
+    TokenIndex nameTokens;
+    TokenIndex descriptionTokens;
+    TokenIndex tagTokens;
+    std::unordered_map<std::string, Postings> exactTags;
+
+    PresetID addEntry(Entry entry);
+    void removeEntry(PresetID id);
+    void indexEntry(PresetID id, const PresetMetadata& info);
+    void unindexEntry(PresetID id, const PresetMetadata& info);
+    juce::File chooseFileFor(const std::string& name) const;
+
+    static std::vector<std::string> tokenize(const std::string& text);
+    static void addPosting(TokenIndex& index, const std::string& text, PresetID id);
+    static void removePosting(TokenIndex& index, const std::string& text, PresetID id);
+    static void collectPrefix(const TokenIndex& index, const std::string& prefix, Postings& result);
+
+    static bool readState(const void* data, size_t size, PresetMetadata* info, PresetGraphState* state);
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(PresetLibrary)
+};
+
+} // namespace WindsynthVST::AudioGraph
@@ -7,7 +7,7 @@
 //
 
 #include "PresetManager.hpp"
-#include <iostream>
+#include "../Core/Logger.hpp"
 #include <algorithm>
 #include <sstream>
 
@@ -38,7 +38,7 @@ private:
 PresetManager::PresetManager(GraphAudioProcessor& graphProcessor, PluginManager& pluginManager)
     : graphProcessor(graphProcessor), pluginManager(pluginManager)
 {
-    std::cout << "[PresetManager] 初始化预设管理器" << std::endl;
+    WSLOG_INFO("PresetManager", "初始化预设管理器");
     
     // 创建自动备份定时器
     autoBackupTimer = std::make_unique<AutoBackupTimer>(*this);
@@ -47,50 +47,116 @@ PresetManager::PresetManager(GraphAudioProcessor& graphProcessor, PluginManager&
     createCategory(PresetCategory("Default", "默认类别"));
     createCategory(PresetCategory("User", "用户创建"));
     createCategory(PresetCategory("Factory", "出厂预设"));
+    
+    // 只加载预设元数据，状态数据在加载预设时读取
+    openPresetLibrary(getDefaultPresetLibraryDirectory());
+    
+    // 快照和备份保存在磁盘上，重新加载上次会话的快照列表
+    snapshotStore = std::make_unique<SnapshotStore>(
+        juce::File::getSpecialLocation(juce::File::userApplicationDataDirectory)
+            .getChildFile("WindsynthRecorder")
+            .getChildFile("Snapshots"));
+    
+    for (const auto& info : snapshotStore->getSnapshots("snapshot")) {
+        snapshotNames[info.id] = info.label;
+    }
+    for (const auto& info : snapshotStore->getSnapshots("backup")) {
+        backupTimes[info.id] = info.time;
+    }
 }
 
 PresetManager::~PresetManager() {
-    std::cout << "[PresetManager] 析构预设管理器" << std::endl;
+    WSLOG_INFO("PresetManager", "析构预设管理器");
     
     if (autoBackupTimer) {
         autoBackupTimer->stopTimer();
     }
 }
 
+//==============================================================================
+// 预设库实现
+//==============================================================================
+
+int PresetManager::openPresetLibrary(const juce::File& directory) {
+    WSLOG_INFO("PresetManager", "打开预设库：" << directory.getFullPathName());
+    
+    std::lock_guard<std::mutex> lock(presetsMutex);
+    
+    int numPresets = library.open(directory);
+    if (numPresets < 0) {
+        return numPresets;
+    }
+    
+    // 按元数据重建类别中的预设列表
+    for (auto& pair : categories) {
+        pair.second.presetNames.clear();
+    }
+    for (const auto& name : library.getAllNames()) {
+        const auto* info = library.getMetadata(name);
+        const std::string categoryName = info->category.empty() ? std::string("Default") : info->category;
+        auto& category = categories[categoryName];
+        if (category.name.empty()) {
+            category.name = categoryName;
+        }
+        category.presetNames.push_back(name);
+    }
+    
+    return numPresets;
+}
+
+juce::File PresetManager::getPresetLibraryDirectory() const {
+    std::lock_guard<std::mutex> lock(presetsMutex);
+    return library.getDirectory();
+}
+
+juce::File PresetManager::getDefaultPresetLibraryDirectory() {
+    return juce::File::getSpecialLocation(juce::File::userApplicationDataDirectory)
+        .getChildFile("WindsynthRecorder").getChildFile("Presets");
+}
+
 //==============================================================================
 // 预设管理实现
 //==============================================================================
 
 bool PresetManager::savePreset(const std::string& presetName, const PresetInfo& info) {
-    std::cout << "[PresetManager] 保存预设：" << presetName << std::endl;
+    WSLOG_INFO("PresetManager", "保存预设：" << presetName);
     
     if (presetName.empty()) {
-        std::cout << "[PresetManager] 预设名称不能为空" << std::endl;
+        WSLOG_INFO("PresetManager", "预设名称不能为空");
         return false;
     }
     
     // 捕获当前状态
     GraphState currentState = captureCurrentState();
     if (!currentState.isValid()) {
-        std::cout << "[PresetManager] 无法捕获当前图状态" << std::endl;
+        WSLOG_INFO("PresetManager", "无法捕获当前图状态");
         return false;
     }
     
-    // 创建预设数据
+    // 创建预设数据（预设名称以参数为准，与库中的索引一致）
     PresetInfo finalInfo = info;
-    if (finalInfo.name.empty()) {
-        finalInfo.name = presetName;
-    }
+    finalInfo.name = presetName;
     if (finalInfo.category.empty()) {
         finalInfo.category = "User";
     }
-    
-    PresetData presetData(finalInfo, currentState);
+    finalInfo.modifiedTime = juce::Time::getCurrentTime();
     
     // 存储预设
     {
         std::lock_guard<std::mutex> lock(presetsMutex);
-        presets[presetName] = presetData;
+        
+        if (const auto* existing = library.getMetadata(presetName)) {
+            finalInfo.createdTime = existing->createdTime;
+            removeFromCategory(existing->category, presetName);
+        }
+        
+        if (!library.store(finalInfo, currentState)) {
+            WSLOG_WARNING("PresetManager", "预设写入失败：" << presetName);
+            if (presetSavedCallback) {
+                presetSavedCallback(presetName, false);
+            }
+            return false;
+        }
         
         // 更新类别中的预设列表
         auto& category = categories[finalInfo.category];
@@ -107,159 +173,170 @@ bool PresetManager::savePreset(const std::string& presetName, const PresetInfo&
     
     notifyStateChanged();
     
-    std::cout << "[PresetManager] 预设保存成功：" << presetName << std::endl;
+    WSLOG_INFO("PresetManager", "预设保存成功：" << presetName);
     return true;
 }
 
 bool PresetManager::loadPreset(const std::string& presetName, PresetLoadedCallback callback) {
-    std::cout << "[PresetManager] 加载预设：" << presetName << std::endl;
+    WSLOG_INFO("PresetManager", "加载预设：" << presetName);
     
-    PresetData presetData;
+    GraphState state;
     
-    // 获取预设数据
+    // 按需读取预设的状态数据
     {
         std::lock_guard<std::mutex> lock(presetsMutex);
-        auto it = presets.find(presetName);
-        if (it == presets.end()) {
-            std::cout << "[PresetManager] 预设不存在：" << presetName << std::endl;
+        if (!library.contains(presetName)) {
+            WSLOG_INFO("PresetManager", "预设不存在：" << presetName);
+            if (callback) callback(presetName, false);
+            return false;
+        }
+        if (!library.loadState(presetName, state)) {
+            WSLOG_INFO("PresetManager", "无法读取预设数据：" << presetName);
             if (callback) callback(presetName, false);
             return false;
         }
-        presetData = it->second;
-    }
-    
-    // 应用图状态
-    bool success = applyGraphState(presetData.state);
-    
-    // 通知加载完成
-    if (callback) {
-        callback(presetName, success);
     }
     
-    if (presetLoadedCallback) {
-        presetLoadedCallback(presetName, success);
-    }
+    // 应用图状态（插件加载完成后通知）
+    auto onComplete = [this, presetName, callback](bool success) {
+        if (callback) {
+            callback(presetName, success);
+        }
+        
+        if (presetLoadedCallback) {
+            presetLoadedCallback(presetName, success);
+        }
+        
+        if (success) {
+            notifyStateChanged();
+            WSLOG_INFO("PresetManager", "预设加载成功：" << presetName);
+        } else {
+            WSLOG_WARNING("PresetManager", "预设加载失败：" << presetName);
+        }
+    };
     
-    if (success) {
-        notifyStateChanged();
-        std::cout << "[PresetManager] 预设加载成功：" << presetName << std::endl;
-    } else {
-        std::cout << "[PresetManager] 预设加载失败：" << presetName << std::endl;
+    bool started = applyGraphState(state, onComplete);
+    if (!started) {
+        onComplete(false);
     }
     
-    return success;
+    return started;
 }
 
 bool PresetManager::deletePreset(const std::string& presetName) {
-    std::cout << "[PresetManager] 删除预设：" << presetName << std::endl;
-    
-    std::lock_guard<std::mutex> lock(presetsMutex);
+    WSLOG_INFO("PresetManager", "删除预设：" << presetName);
     
-    auto it = presets.find(presetName);
-    if (it == presets.end()) {
-        return false;
+    {
+        std::lock_guard<std::mutex> lock(presetsMutex);
+        
+        const auto* info = library.getMetadata(presetName);
+        if (info == nullptr) {
+            return false;
+        }
+        
+        // 从类别中移除
+        const std::string category = info->category;
+        if (!library.remove(presetName)) {
+            return false;
+        }
+        removeFromCategory(category, presetName);
     }
     
-    // 从类别中移除
-    std::string category = it->second.info.category;
-    auto& categoryData = categories[category];
-    categoryData.presetNames.erase(
-        std::remove(categoryData.presetNames.begin(), categoryData.presetNames.end(), presetName),
-        categoryData.presetNames.end());
-    
-    // 删除预设
-    presets.erase(it);
-    
     notifyStateChanged();
     
-    std::cout << "[PresetManager] 预设删除成功：" << presetName << std::endl;
+    WSLOG_INFO("PresetManager", "预设删除成功：" << presetName);
     return true;
 }
 
 bool PresetManager::renamePreset(const std::string& oldName, const std::string& newName) {
-    std::cout << "[PresetManager] 重命名预设：" << oldName << " -> " << newName << std::endl;
+    WSLOG_INFO("PresetManager", "重命名预设：" << oldName << " -> " << newName);
     
     if (oldName == newName || newName.empty()) {
         return false;
     }
     
-    std::lock_guard<std::mutex> lock(presetsMutex);
-    
-    auto it = presets.find(oldName);
-    if (it == presets.end()) {
-        return false;
-    }
-    
-    // 检查新名称是否已存在
-    if (presets.find(newName) != presets.end()) {
-        std::cout << "[PresetManager] 新预设名称已存在：" << newName << std::endl;
-        return false;
-    }
-    
-    // 复制预设数据并更新名称
-    PresetData presetData = it->second;
-    presetData.info.name = newName;
-    presetData.info.modifiedTime = juce::Time::getCurrentTime();
-    
-    // 更新类别中的预设列表
-    auto& categoryData = categories[presetData.info.category];
-    auto nameIt = std::find(categoryData.presetNames.begin(), categoryData.presetNames.end(), oldName);
-    if (nameIt != categoryData.presetNames.end()) {
-        *nameIt = newName;
+    {
+        std::lock_guard<std::mutex> lock(presetsMutex);
+        
+        const auto* current = library.getMetadata(oldName);
+        if (current == nullptr) {
+            return false;
+        }
+        
+        // 检查新名称是否已存在
+        if (library.contains(newName)) {
+            WSLOG_INFO("PresetManager", "新预设名称已存在：" << newName);
+            return false;
+        }
+        
+        // 更新名称（状态数据保持不变）
+        PresetInfo info = *current;
+        info.name = newName;
+        info.modifiedTime = juce::Time::getCurrentTime();
+        
+        if (!library.updateMetadata(oldName, info)) {
+            return false;
+        }
+        
+        // 更新类别中的预设列表
+        auto& categoryData = categories[info.category];
+        auto nameIt = std::find(categoryData.presetNames.begin(), categoryData.presetNames.end(), oldName);
+        if (nameIt != categoryData.presetNames.end()) {
+            *nameIt = newName;
+        }
     }
     
-    // 删除旧预设，添加新预设
-    presets.erase(it);
-    presets[newName] = presetData;
-    
     notifyStateChanged();
     
-    std::cout << "[PresetManager] 预设重命名成功" << std::endl;
+    WSLOG_INFO("PresetManager", "预设重命名成功");
     return true;
 }
 
 bool PresetManager::duplicatePreset(const std::string& sourceName, const std::string& targetName) {
-    std::cout << "[PresetManager] 复制预设：" << sourceName << " -> " << targetName << std::endl;
+    WSLOG_INFO("PresetManager", "复制预设：" << sourceName << " -> " << targetName);
     
     if (sourceName == targetName || targetName.empty()) {
         return false;
     }
     
-    std::lock_guard<std::mutex> lock(presetsMutex);
-    
-    auto it = presets.find(sourceName);
-    if (it == presets.end()) {
-        return false;
-    }
-    
-    // 检查目标名称是否已存在
-    if (presets.find(targetName) != presets.end()) {
-        std::cout << "[PresetManager] 目标预设名称已存在：" << targetName << std::endl;
-        return false;
+    {
+        std::lock_guard<std::mutex> lock(presetsMutex);
+        
+        const auto* source = library.getMetadata(sourceName);
+        if (source == nullptr) {
+            return false;
+        }
+        
+        // 检查目标名称是否已存在
+        if (library.contains(targetName)) {
+            WSLOG_INFO("PresetManager", "目标预设名称已存在：" << targetName);
+            return false;
+        }
+        
+        // 复制预设数据并更新信息
+        PresetInfo info = *source;
+        info.name = targetName;
+        info.createdTime = juce::Time::getCurrentTime();
+        info.modifiedTime = juce::Time::getCurrentTime();
+        
+        GraphState state;
+        if (!library.loadState(sourceName, state) || !library.store(info, state)) {
+            return false;
+        }
+        
+        // 添加到类别中
+        categories[info.category].presetNames.push_back(targetName);
     }
     
-    // 复制预设数据并更新信息
-    PresetData presetData = it->second;
-    presetData.info.name = targetName;
-    presetData.info.createdTime = juce::Time::getCurrentTime();
-    presetData.info.modifiedTime = juce::Time::getCurrentTime();
-    
-    // 添加到类别中
-    auto& categoryData = categories[presetData.info.category];
-    categoryData.presetNames.push_back(targetName);
-    
-    // 添加新预设
-    presets[targetName] = presetData;
-    
     notifyStateChanged();
     
-    std::cout << "[PresetManager] 预设复制成功" << std::endl;
+    WSLOG_INFO("PresetManager", "预设复制成功");
     return true;
 }
 
 bool PresetManager::presetExists(const std::string& presetName) const {
     std::lock_guard<std::mutex> lock(presetsMutex);
-    return presets.find(presetName) != presets.end();
+    return library.contains(presetName);
 }
 
 //==============================================================================
@@ -268,23 +345,12 @@ bool PresetManager::presetExists(const std::string& presetName) const {
 
 std::vector<std::string> PresetManager::getAllPresetNames() const {
     std::lock_guard<std::mutex> lock(presetsMutex);
-    
-    std::vector<std::string> names;
-    names.reserve(presets.size());
-    
-    for (const auto& pair : presets) {
-        names.push_back(pair.first);
-    }
-    
-    std::sort(names.begin(), names.end());
-    return names;
+    return library.getAllNames();
 }
 
 const PresetManager::PresetInfo* PresetManager::getPresetInfo(const std::string& presetName) const {
     std::lock_guard<std::mutex> lock(presetsMutex);
-    
-    auto it = presets.find(presetName);
-    return (it != presets.end()) ? &it->second.info : nullptr;
+    return library.getMetadata(presetName);
 }
 
 std::vector<std::string> PresetManager::getPresetsByCategory(const std::string& category) const {
@@ -300,66 +366,25 @@ std::vector<std::string> PresetManager::getPresetsByCategory(const std::string&
 
 std::vector<std::string> PresetManager::getPresetsByTag(const std::string& tag) const {
     std::lock_guard<std::mutex> lock(presetsMutex);
-    
-    std::vector<std::string> result;
-    
-    for (const auto& pair : presets) {
-        const auto& tags = pair.second.info.tags;
-        if (std::find(tags.begin(), tags.end(), tag) != tags.end()) {
-            result.push_back(pair.first);
-        }
-    }
-    
-    return result;
+    return library.findByTag(tag);
 }
 
 std::vector<std::string> PresetManager::searchPresets(const std::string& searchText,
                                                      bool searchInName,
                                                      bool searchInDescription,
                                                      bool searchInTags) const {
-    std::lock_guard<std::mutex> lock(presetsMutex);
-    
-    std::vector<std::string> result;
-    std::string lowerSearchText = searchText;
-    std::transform(lowerSearchText.begin(), lowerSearchText.end(), lowerSearchText.begin(), ::tolower);
+    int fields = 0;
+    if (searchInName) fields |= PresetLibrary::searchName;
+    if (searchInDescription) fields |= PresetLibrary::searchDescription;
+    if (searchInTags) fields |= PresetLibrary::searchTags;
     
-    for (const auto& pair : presets) {
-        const auto& info = pair.second.info;
-        bool matches = false;
-        
-        if (searchInName) {
-            std::string lowerName = info.name;
-            std::transform(lowerName.begin(), lowerName.end(), lowerName.begin(), ::tolower);
-            if (lowerName.find(lowerSearchText) != std::string::npos) {
-                matches = true;
-            }
-        }
-        
-        if (!matches && searchInDescription) {
-            std::string lowerDesc = info.description;
-            std::transform(lowerDesc.begin(), lowerDesc.end(), lowerDesc.begin(), ::tolower);
-            if (lowerDesc.find(lowerSearchText) != std::string::npos) {
-                matches = true;
-            }
-        }
-        
-        if (!matches && searchInTags) {
-            for (const auto& tag : info.tags) {
-                std::string lowerTag = tag;
-                std::transform(lowerTag.begin(), lowerTag.end(), lowerTag.begin(), ::tolower);
-                if (lowerTag.find(lowerSearchText) != std::string::npos) {
-                    matches = true;
-                    break;
-                }
-            }
-        }
-        
-        if (matches) {
-            result.push_back(pair.first);
-        }
+    if (fields == 0) {
+        return {};
     }
     
-    return result;
+    // 使用预设库的倒排索引，不遍历所有预设
+    std::lock_guard<std::mutex> lock(presetsMutex);
+    return library.search(searchText, fields);
 }
 
 //==============================================================================
@@ -367,7 +392,7 @@ std::vector<std::string> PresetManager::searchPresets(const std::string& searchT
 //==============================================================================
 
 bool PresetManager::createCategory(const PresetCategory& category) {
-    std::cout << "[PresetManager] 创建类别：" << category.name << std::endl;
+    WSLOG_INFO("PresetManager", "创建类别：" << category.name);
 
     if (category.name.empty()) {
         return false;
@@ -380,10 +405,10 @@ bool PresetManager::createCategory(const PresetCategory& category) {
 }
 
 bool PresetManager::deleteCategory(const std::string& categoryName) {
-    std::cout << "[PresetManager] 删除类别：" << categoryName << std::endl;
+    WSLOG_INFO("PresetManager", "删除类别：" << categoryName);
 
     if (categoryName == "Default" || categoryName == "User" || categoryName == "Factory") {
-        std::cout << "[PresetManager] 不能删除系统类别：" << categoryName << std::endl;
+        WSLOG_INFO("PresetManager", "不能删除系统类别：" << categoryName);
         return false;
     }
 
@@ -396,14 +421,16 @@ bool PresetManager::deleteCategory(const std::string& categoryName) {
 
     // 将该类别下的预设移动到默认类别
     for (const auto& presetName : it->second.presetNames) {
-        auto presetIt = presets.find(presetName);
-        if (presetIt != presets.end()) {
-            presetIt->second.info.category = "Default";
-            categories["Default"].presetNames.push_back(presetName);
+        if (const auto* current = library.getMetadata(presetName)) {
+            PresetInfo info = *current;
+            info.category = "Default";
+            if (library.updateMetadata(presetName, info)) {
+                categories["Default"].presetNames.push_back(presetName);
+            }
         }
     }
 
-    categories.erase(it);
+    categories.erase(categoryName);
     return true;
 }
 
@@ -421,12 +448,12 @@ std::vector<PresetManager::PresetCategory> PresetManager::getAllCategories() con
 }
 
 bool PresetManager::setPresetCategory(const std::string& presetName, const std::string& categoryName) {
-    std::cout << "[PresetManager] 设置预设类别：" << presetName << " -> " << categoryName << std::endl;
+    WSLOG_INFO("PresetManager", "设置预设类别：" << presetName << " -> " << categoryName);
 
     std::lock_guard<std::mutex> lock(presetsMutex);
 
-    auto presetIt = presets.find(presetName);
-    if (presetIt == presets.end()) {
+    const auto* current = library.getMetadata(presetName);
+    if (current == nullptr) {
         return false;
     }
 
@@ -435,20 +462,103 @@ bool PresetManager::setPresetCategory(const std::string& presetName, const std::
         return false;
     }
 
-    // 从旧类别中移除
-    std::string oldCategory = presetIt->second.info.category;
-    auto& oldCategoryData = categories[oldCategory];
-    oldCategoryData.presetNames.erase(
-        std::remove(oldCategoryData.presetNames.begin(), oldCategoryData.presetNames.end(), presetName),
-        oldCategoryData.presetNames.end());
+    PresetInfo info = *current;
+    const std::string oldCategory = info.category;
+    info.category = categoryName;
+    if (!library.updateMetadata(presetName, info)) {
+        return false;
+    }
 
-    // 添加到新类别
-    presetIt->second.info.category = categoryName;
+    // 从旧类别中移除，添加到新类别
+    removeFromCategory(oldCategory, presetName);
     categoryIt->second.presetNames.push_back(presetName);
 
     return true;
 }
 
+//==============================================================================
+// 文件操作实现
+//==============================================================================
+
+bool PresetManager::exportPreset(const std::string& presetName, const juce::File& file) const {
+    WSLOG_INFO("PresetManager", "导出预设：" << presetName << " -> " << file.getFullPathName());
+
+    PresetInfo info;
+    GraphState state;
+    {
+        std::lock_guard<std::mutex> lock(presetsMutex);
+        const auto* current = library.getMetadata(presetName);
+        if (current == nullptr || !library.loadState(presetName, state)) {
+            return false;
+        }
+        info = *current;
+    }
+
+    return PresetLibrary::writePresetFile(file, info, state);
+}
+
+bool PresetManager::importPreset(const juce::File& file, const std::string& presetName) {
+    WSLOG_INFO("PresetManager", "导入预设：" << file.getFullPathName());
+
+    PresetInfo info;
+    GraphState state;
+    if (!PresetLibrary::readPresetFile(file, info, state) || !state.isValid()) {
+        WSLOG_INFO("PresetManager", "无效的预设文件：" << file.getFullPathName());
+        return false;
+    }
+
+    if (!presetName.empty()) {
+        info.name = presetName;
+    }
+    if (info.category.empty()) {
+        info.category = "User";
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(presetsMutex);
+
+        if (const auto* existing = library.getMetadata(info.name)) {
+            removeFromCategory(existing->category, info.name);
+        }
+        if (!library.store(info, state)) {
+            return false;
+        }
+
+        auto& category = categories[info.category];
+        if (category.name.empty()) {
+            category.name = info.category;
+        }
+        category.presetNames.push_back(info.name);
+    }
+
+    notifyStateChanged();
+    return true;
+}
+
+int PresetManager::exportAllPresets(const juce::File& directory) const {
+    int numExported = 0;
+    for (const auto& name : getAllPresetNames()) {
+        auto file = directory.getNonexistentChildFile(juce::File::createLegalFileName(juce::String::fromUTF8(name.c_str())),
+                                                      PresetLibrary::fileExtension, false);
+        if (exportPreset(name, file)) {
+            numExported++;
+        }
+    }
+    return numExported;
+}
+
+int PresetManager::importPresetsFromDirectory(const juce::File& directory) {
+    int numImported = 0;
+    for (const auto& item : juce::RangedDirectoryIterator(directory, false,
+                                                          juce::String("*") + PresetLibrary::fileExtension,
+                                                          juce::File::findFiles)) {
+        if (importPreset(item.getFile())) {
+            numImported++;
+        }
+    }
+    return numImported;
+}
+
 //==============================================================================
 // 状态管理实现
 //==============================================================================
@@ -465,29 +575,27 @@ std::string PresetManager::createSnapshot(const std::string& name) {
     std::string snapshotId = generateUniqueId();
     std::string finalName = name.empty() ? ("Snapshot_" + snapshotId) : name;
 
-    std::cout << "[PresetManager] 创建快照：" << finalName << std::endl;
+    WSLOG_INFO("PresetManager", "创建快照：" << finalName);
 
-    GraphState currentState = captureCurrentState();
+    GraphState currentState = captureCurrentState(true);
+
+    // 切分、去重和写入在快照存储的后台线程中完成
+    snapshotStore->add(snapshotId, "snapshot", finalName, toStreams(currentState));
 
     std::lock_guard<std::mutex> lock(snapshotsMutex);
-    snapshots[snapshotId] = currentState;
     snapshotNames[snapshotId] = finalName;
 
     return snapshotId;
 }
 
 bool PresetManager::restoreSnapshot(const std::string& snapshotId) {
-    std::cout << "[PresetManager] 恢复快照：" << snapshotId << std::endl;
+    WSLOG_INFO("PresetManager", "恢复快照：" << snapshotId);
 
+    SnapshotStore::Streams streams;
     GraphState state;
 
-    {
-        std::lock_guard<std::mutex> lock(snapshotsMutex);
-        auto it = snapshots.find(snapshotId);
-        if (it == snapshots.end()) {
-            return false;
-        }
-        state = it->second;
+    if (!snapshotStore->get(snapshotId, streams) || !fromStreams(streams, state)) {
+        return false;
     }
 
     return applyGraphState(state);
@@ -503,8 +611,8 @@ std::unordered_map<std::string, std::string> PresetManager::getAllSnapshots() co
 //==============================================================================
 
 void PresetManager::enableAutoBackup(bool enable, int intervalMinutes) {
-    std::cout << "[PresetManager] " << (enable ? "启用" : "禁用") << "自动备份，间隔："
-              << intervalMinutes << "分钟" << std::endl;
+    WSLOG_INFO("PresetManager", (enable ? "启用" : "禁用") << "自动备份，间隔："
+            << intervalMinutes << "分钟");
 
     autoBackupEnabled = enable;
     autoBackupInterval = intervalMinutes;
@@ -519,40 +627,37 @@ void PresetManager::enableAutoBackup(bool enable, int intervalMinutes) {
 std::string PresetManager::createBackup() {
     std::string backupId = generateUniqueId();
 
-    std::cout << "[PresetManager] 创建备份：" << backupId << std::endl;
+    WSLOG_INFO("PresetManager", "创建备份：" << backupId);
 
-    GraphState currentState = captureCurrentState();
+    GraphState currentState = captureCurrentState(true);
+
+    snapshotStore->add(backupId, "backup", backupId, toStreams(currentState));
 
     std::lock_guard<std::mutex> lock(snapshotsMutex);
-    backups[backupId] = currentState;
     backupTimes[backupId] = juce::Time::getCurrentTime();
 
     return backupId;
 }
 
 bool PresetManager::restoreBackup(const std::string& backupId) {
-    std::cout << "[PresetManager] 恢复备份：" << backupId << std::endl;
+    WSLOG_INFO("PresetManager", "恢复备份：" << backupId);
 
+    SnapshotStore::Streams streams;
     GraphState state;
 
-    {
-        std::lock_guard<std::mutex> lock(snapshotsMutex);
-        auto it = backups.find(backupId);
-        if (it == backups.end()) {
-            return false;
-        }
-        state = it->second;
+    if (!snapshotStore->get(backupId, streams) || !fromStreams(streams, state)) {
+        return false;
     }
 
     return applyGraphState(state);
 }
 
 void PresetManager::cleanupOldBackups(int keepCount) {
-    std::cout << "[PresetManager] 清理旧备份，保留：" << keepCount << "个" << std::endl;
+    WSLOG_INFO("PresetManager", "清理旧备份，保留：" << keepCount << "个");
 
     std::lock_guard<std::mutex> lock(snapshotsMutex);
 
-    if (static_cast<int>(backups.size()) <= keepCount) {
+    if (static_cast<int>(backupTimes.size()) <= keepCount) {
         return;
     }
 
@@ -567,7 +672,7 @@ void PresetManager::cleanupOldBackups(int keepCount) {
     // 删除多余的备份
     for (size_t i = keepCount; i < sortedBackups.size(); ++i) {
         const std::string& backupId = sortedBackups[i].second;
-        backups.erase(backupId);
+        snapshotStore->remove(backupId);
         backupTimes.erase(backupId);
     }
 }
@@ -594,7 +699,7 @@ void PresetManager::setStateChangedCallback(StateChangedCallback callback) {
 
 int PresetManager::getNumPresets() const {
     std::lock_guard<std::mutex> lock(presetsMutex);
-    return static_cast<int>(presets.size());
+    return library.size();
 }
 
 int PresetManager::getNumCategories() const {
@@ -604,15 +709,15 @@ int PresetManager::getNumCategories() const {
 
 int PresetManager::getNumBackups() const {
     std::lock_guard<std::mutex> lock(snapshotsMutex);
-    return static_cast<int>(backups.size());
+    return static_cast<int>(backupTimes.size());
 }
 
 //==============================================================================
 // 内部方法实现
 //==============================================================================
 
-PresetManager::GraphState PresetManager::captureCurrentState() const {
-    std::cout << "[PresetManager] 捕获当前图状态" << std::endl;
+PresetManager::GraphState PresetManager::captureCurrentState(bool reuseUnchangedStates) const {
+    WSLOG_INFO("PresetManager", "捕获当前图状态");
 
     GraphState state;
 
@@ -628,6 +733,9 @@ PresetManager::GraphState PresetManager::captureCurrentState() const {
 
     pluginStream.writeInt(static_cast<int>(allPlugins.size()));
 
+    std::lock_guard<std::mutex> cacheLock(stateCacheMutex);
+    int reusedStates = 0;
+
     for (const auto& pluginInfo : allPlugins) {
         // 写入插件基本信息
         pluginStream.writeString(pluginInfo.name);
@@ -643,16 +751,40 @@ PresetManager::GraphState PresetManager::captureCurrentState() const {
             pluginStream.writeString("");
         }
 
-        // 写入插件状态
-        juce::MemoryBlock pluginState;
-        if (pluginManager.getPluginState(pluginInfo.nodeID, pluginState)) {
-            pluginStream.writeInt64(static_cast<juce::int64>(pluginState.getSize()));
-            pluginStream.write(pluginState.getData(), pluginState.getSize());
+        // 写入插件状态（状态代数没有变化时复用上次获取的状态）
+        const uint32_t generation = pluginManager.getPluginStateGeneration(pluginInfo.nodeID);
+        auto& cached = pluginStateCache[pluginInfo.nodeID];
+
+        if (reuseUnchangedStates && generation != 0 && cached.generation == generation
+            && cached.reuseCount < MAX_STATE_REUSE_COUNT) {
+            ++cached.reuseCount;
+            ++reusedStates;
         } else {
-            pluginStream.writeInt64(0);
+            cached.state.reset();
+            cached.generation = pluginManager.getPluginState(pluginInfo.nodeID, cached.state) ? generation : 0;
+            cached.reuseCount = 0;
         }
+
+        pluginStream.writeInt64(static_cast<juce::int64>(cached.state.getSize()));
+        pluginStream.write(cached.state.getData(), cached.state.getSize());
     }
 
+    // 移除已删除插件的缓存
+    for (auto it = pluginStateCache.begin(); it != pluginStateCache.end();) {
+        const bool exists = std::any_of(allPlugins.begin(), allPlugins.end(),
+                                        [&](const auto& info) { return info.nodeID == it->first; });
+        it = exists ? std::next(it) : pluginStateCache.erase(it);
+    }
+
+    // 节点ID和I/O节点ID，召回时按它们映射连接
+    for (const auto& pluginInfo : allPlugins) {
+        pluginStream.writeInt(static_cast<int>(pluginInfo.nodeID.uid));
+    }
+    pluginStream.writeInt(static_cast<int>(graphProcessor.getAudioInputNodeID().uid));
+    pluginStream.writeInt(static_cast<int>(graphProcessor.getAudioOutputNodeID().uid));
+    pluginStream.writeInt(static_cast<int>(graphProcessor.getMidiInputNodeID().uid));
+    pluginStream.writeInt(static_cast<int>(graphProcessor.getMidiOutputNodeID().uid));
+
     state.pluginStates = pluginStream.getMemoryBlock();
 
     // 获取连接信息
@@ -680,85 +812,228 @@ PresetManager::GraphState PresetManager::captureCurrentState() const {
 
     state.ioConfig = ioStream.getMemoryBlock();
 
-    std::cout << "[PresetManager] 状态捕获完成，插件数量：" << allPlugins.size()
-              << "，连接数量：" << allConnections.size() << std::endl;
+    WSLOG_INFO("PresetManager", "状态捕获完成，插件数量：" << allPlugins.size()
+            << "，复用状态：" << reusedStates
+            << "，连接数量：" << allConnections.size());
 
     return state;
 }
 
-bool PresetManager::applyGraphState(const GraphState& state) {
-    std::cout << "[PresetManager] 应用图状态" << std::endl;
+SnapshotStore::Streams PresetManager::toStreams(const GraphState& state) {
+    juce::MemoryOutputStream configStream;
+    configStream.writeDouble(state.config.sampleRate);
+    configStream.writeInt(state.config.samplesPerBlock);
+    configStream.writeInt(state.config.numInputChannels);
+    configStream.writeInt(state.config.numOutputChannels);
+    configStream.writeBool(state.config.enableMidi);
+    configStream.writeBool(state.config.enableLatencyCompensation);
+
+    // 插件状态单独作为一个数据流，未变化的插件状态在快照之间去重
+    SnapshotStore::Streams streams;
+    streams.push_back(state.graphData);
+    streams.push_back(state.pluginStates);
+    streams.push_back(state.connections);
+    streams.push_back(state.ioConfig);
+    streams.push_back(configStream.getMemoryBlock());
+    return streams;
+}
 
-    if (!state.isValid()) {
-        std::cout << "[PresetManager] 无效的图状态" << std::endl;
+bool PresetManager::fromStreams(const SnapshotStore::Streams& streams, GraphState& state) {
+    if (streams.size() != 5) {
         return false;
     }
 
-    try {
-        // 首先清除当前图中的所有插件（保留I/O节点）
-        auto currentPlugins = pluginManager.getAllPlugins();
-        for (const auto& plugin : currentPlugins) {
-            pluginManager.removePlugin(plugin.nodeID);
+    state.graphData = streams[0];
+    state.pluginStates = streams[1];
+    state.connections = streams[2];
+    state.ioConfig = streams[3];
+
+    juce::MemoryInputStream configStream(streams[4], false);
+    state.config.sampleRate = configStream.readDouble();
+    state.config.samplesPerBlock = configStream.readInt();
+    state.config.numInputChannels = configStream.readInt();
+    state.config.numOutputChannels = configStream.readInt();
+    state.config.enableMidi = configStream.readBool();
+    state.config.enableLatencyCompensation = configStream.readBool();
+
+    return state.isValid();
+}
+
+void PresetManager::parseGraphState(const GraphState& state, PluginManager::GraphRecallRequest& request,
+                                    bool& hasNodeIDs) {
+    hasNodeIDs = false;
+
+    // 解析插件记录
+    juce::MemoryInputStream pluginStream(state.pluginStates, false);
+    int numPlugins = pluginStream.readInt();
+
+    WSLOG_INFO("PresetManager", "恢复 " << numPlugins << " 个插件");
+
+    std::vector<bool> validPlugins;
+    for (int i = 0; i < numPlugins && !pluginStream.isExhausted(); ++i) {
+        PluginManager::PluginRecallEntry entry;
+        std::string name = pluginStream.readString().toStdString();
+        entry.displayName = pluginStream.readString().toStdString();
+        entry.enabled = pluginStream.readBool();
+        entry.bypassed = pluginStream.readBool();
+
+        // 读取插件描述
+        std::string descriptionXml = pluginStream.readString().toStdString();
+
+        // 读取插件状态数据
+        juce::int64 stateSize = pluginStream.readInt64();
+        if (stateSize > 0) {
+            entry.state.setSize(static_cast<size_t>(stateSize));
+            pluginStream.read(entry.state.getData(), static_cast<int>(stateSize));
         }
 
-        // 应用图配置
-        graphProcessor.configure(state.config);
+        auto xml = descriptionXml.empty() ? nullptr : juce::XmlDocument::parse(descriptionXml);
+        bool valid = xml != nullptr && entry.description.loadFromXml(*xml);
+        if (!valid) {
+            WSLOG_INFO("PresetManager", "跳过无效的插件描述：" << name);
+        }
+        if (entry.displayName.empty()) {
+            entry.displayName = name;
+        }
 
-        // 恢复插件状态
-        juce::MemoryInputStream pluginStream(state.pluginStates, false);
-        int numPlugins = pluginStream.readInt();
+        validPlugins.push_back(valid);
+        request.plugins.push_back(std::move(entry));
+    }
 
-        std::cout << "[PresetManager] 恢复 " << numPlugins << " 个插件" << std::endl;
+    // 保存时的节点ID（旧格式没有这部分，插件之间的连接无法恢复）
+    if (!pluginStream.isExhausted()) {
+        for (auto& entry : request.plugins) {
+            entry.presetNodeUID = static_cast<juce::uint32>(pluginStream.readInt());
+        }
+        for (auto& ioNode : request.ioNodes) {
+            ioNode = NodeID{static_cast<juce::uint32>(pluginStream.readInt())};
+        }
+        hasNodeIDs = true;
+    } else {
+        for (size_t i = 0; i < request.plugins.size(); ++i) {
+            // 不会与连接中引用的ID重合
+            request.plugins[i].presetNodeUID = 0x80000000u + static_cast<juce::uint32>(i);
+        }
+        WSLOG_INFO("PresetManager", "旧格式预设，插件之间的连接不会恢复");
+    }
 
-        for (int i = 0; i < numPlugins; ++i) {
-            std::string name = pluginStream.readString().toStdString();
-            std::string displayName = pluginStream.readString().toStdString();
-            bool enabled = pluginStream.readBool();
-            bool bypassed = pluginStream.readBool();
+    for (size_t i = validPlugins.size(); i-- > 0;) {
+        if (!validPlugins[i]) {
+            request.plugins.erase(request.plugins.begin() + static_cast<std::ptrdiff_t>(i));
+        }
+    }
 
-            // 读取插件描述
-            std::string descriptionXml = pluginStream.readString().toStdString();
-            if (descriptionXml.empty()) {
-                std::cout << "[PresetManager] 跳过无效的插件描述" << std::endl;
-                continue;
-            }
+    // 解析连接
+    juce::MemoryInputStream connectionStream(state.connections, false);
+    int numConnections = state.connections.getSize() > 0 ? connectionStream.readInt() : 0;
+    for (int i = 0; i < numConnections && !connectionStream.isExhausted(); ++i) {
+        Connection connection;
+        connection.source.nodeID = NodeID{static_cast<juce::uint32>(connectionStream.readInt())};
+        connection.source.channelIndex = connectionStream.readInt();
+        connection.destination.nodeID = NodeID{static_cast<juce::uint32>(connectionStream.readInt())};
+        connection.destination.channelIndex = connectionStream.readInt();
+        connectionStream.readBool();
+        request.connections.push_back(connection);
+    }
+}
 
-            auto xml = juce::XmlDocument::parse(descriptionXml);
-            if (!xml) {
-                std::cout << "[PresetManager] 无法解析插件描述XML" << std::endl;
-                continue;
-            }
+bool PresetManager::createGraphSnapshot(const GraphState& state, GraphSnapshot& snapshot, std::string& error) {
+    if (!state.isValid()) {
+        error = "无效的图状态";
+        return false;
+    }
 
-            juce::PluginDescription description;
-            description.loadFromXml(*xml);
+    try {
+        PluginManager::GraphRecallRequest request;
+        bool hasNodeIDs = false;
+        parseGraphState(state, request, hasNodeIDs);
 
-            // 读取插件状态数据
-            juce::int64 stateSize = pluginStream.readInt64();
-            juce::MemoryBlock pluginState;
-            if (stateSize > 0) {
-                pluginState.setSize(static_cast<size_t>(stateSize));
-                pluginStream.read(pluginState.getData(), static_cast<size_t>(stateSize));
-            }
+        // 旧格式没有I/O节点和连接信息，重建的图没有信号通路
+        if (!hasNodeIDs && !request.plugins.empty()) {
+            error = "旧格式预设没有连接信息，请重新保存后再用于离线渲染";
+            return false;
+        }
+
+        snapshot = GraphSnapshot();
+        snapshot.config = state.config;
+        snapshot.audioInputNodeID = request.ioNodes[0];
+        snapshot.audioOutputNodeID = request.ioNodes[1];
+        snapshot.midiInputNodeID = request.ioNodes[2];
+        snapshot.midiOutputNodeID = request.ioNodes[3];
+        snapshot.connections = std::move(request.connections);
+
+        for (auto& entry : request.plugins) {
+            GraphSnapshot::NodeSnapshot node;
+            node.nodeUID = entry.presetNodeUID;
+            node.name = entry.displayName;
+            node.description = entry.description;
+            node.state = std::move(entry.state);
+            node.bypassed = entry.bypassed || !entry.enabled;
+            snapshot.nodes.push_back(std::move(node));
+        }
+        return true;
+
+    } catch (const std::exception& e) {
+        error = std::string("解析预设失败：") + e.what();
+        return false;
+    }
+}
+
+bool PresetManager::applyGraphState(const GraphState& state, std::function<void(bool success)> onComplete) {
+    WSLOG_INFO("PresetManager", "应用图状态");
+
+    if (!state.isValid()) {
+        WSLOG_INFO("PresetManager", "无效的图状态");
+        return false;
+    }
+
+    try {
+        PluginManager::GraphRecallRequest request;
+        bool hasNodeIDs = false;
+        parseGraphState(state, request, hasNodeIDs);
 
-            // 异步加载插件（这里简化为同步处理）
-            std::cout << "[PresetManager] 恢复插件：" << displayName << std::endl;
+        if (!hasNodeIDs) {
+            request.ioNodes = {graphProcessor.getAudioInputNodeID(), graphProcessor.getAudioOutputNodeID(),
+                               graphProcessor.getMidiInputNodeID(), graphProcessor.getMidiOutputNodeID()};
+        }
 
-            // 注意：这里需要实际的插件加载逻辑
-            // 由于这是状态恢复，我们需要确保插件能够被正确加载
+        // 配置不同时才重新初始化
+        if (graphProcessor.getConfig() != state.config) {
+            graphProcessor.configure(state.config);
         }
 
-        // 恢复连接（在所有插件加载完成后）
-        // 这里需要延迟处理，因为插件是异步加载的
+        // 所有插件同时加载，全部完成后一次性替换图
+        pluginManager.recallGraphAsync(std::move(request),
+            [onComplete](bool success, const std::string& error) {
+                if (success) {
+                    WSLOG_INFO("PresetManager", "图状态应用完成");
+                } else {
+                    WSLOG_WARNING("PresetManager", "图状态部分应用失败：" << error);
+                }
+
+                if (onComplete) {
+                    onComplete(success);
+                }
+            });
 
-        std::cout << "[PresetManager] 图状态应用完成" << std::endl;
         return true;
 
     } catch (const std::exception& e) {
-        std::cout << "[PresetManager] 应用图状态时发生异常：" << e.what() << std::endl;
+        WSLOG_WARNING("PresetManager", "应用图状态时发生异常：" << e.what());
         return false;
     }
 }
 
+void PresetManager::removeFromCategory(const std::string& categoryName, const std::string& presetName) {
+    auto it = categories.find(categoryName);
+    if (it == categories.end()) {
+        return;
+    }
+    
+    auto& names = it->second.presetNames;
+    names.erase(std::remove(names.begin(), names.end(), presetName), names.end());
+}
+
 std::string PresetManager::generateUniqueId() const {
     auto now = juce::Time::getCurrentTime();
     std::stringstream ss;
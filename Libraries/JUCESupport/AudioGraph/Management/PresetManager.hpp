@@ -18,6 +18,8 @@
 #include "../Core/GraphAudioProcessor.hpp"
 #include "../Core/AudioGraphTypes.hpp"
 #include "../Plugins/PluginManager.hpp"
+#include "PresetLibrary.hpp"
+#include "SnapshotStore.hpp"
 
 namespace WindsynthVST::AudioGraph {
 
@@ -30,6 +32,8 @@ namespace WindsynthVST::AudioGraph {
  * - 预设的导入导出
  * - 版本控制和兼容性管理
  * - 自动备份和恢复
+ *
+ * 预设保存在预设库目录中，启动时只加载元数据索引，加载预设时才读取状态数据。
  */
 class PresetManager {
 public:
@@ -40,36 +44,12 @@ public:
     /**
      * 预设信息
      */
-    struct PresetInfo {
-        std::string name;
-        std::string description;
-        std::string category;
-        std::string author;
-        juce::String version;
-        juce::Time createdTime;
-        juce::Time modifiedTime;
-        std::vector<std::string> tags;
-        
-        PresetInfo() = default;
-        PresetInfo(const std::string& n, const std::string& desc = "", const std::string& cat = "")
-            : name(n), description(desc), category(cat), 
-              createdTime(juce::Time::getCurrentTime()), modifiedTime(juce::Time::getCurrentTime()) {}
-    };
+    using PresetInfo = PresetMetadata;
     
     /**
      * 图状态数据
      */
-    struct GraphState {
-        juce::MemoryBlock graphData;        // 图结构数据
-        juce::MemoryBlock pluginStates;    // 所有插件状态
-        juce::MemoryBlock connections;     // 连接信息
-        juce::MemoryBlock ioConfig;        // I/O配置
-        GraphConfig config;                // 图配置
-        
-        bool isValid() const {
-            return graphData.getSize() > 0;
-        }
-    };
+    using GraphState = PresetGraphState;
     
     /**
      * 预设数据
@@ -120,6 +100,27 @@ public:
      */
     ~PresetManager();
     
+    //==============================================================================
+    // 预设库
+    //==============================================================================
+    
+    /**
+     * 打开预设库目录（只读取预设元数据，内存中未保存到目录的预设会被丢弃）
+     * @param directory 预设目录
+     * @return 加载的预设数量，失败时返回-1
+     */
+    int openPresetLibrary(const juce::File& directory);
+    
+    /**
+     * 获取预设库目录
+     */
+    juce::File getPresetLibraryDirectory() const;
+    
+    /**
+     * 默认的预设库目录
+     */
+    static juce::File getDefaultPresetLibraryDirectory();
+    
     //==============================================================================
     // 预设管理
     //==============================================================================
@@ -135,8 +136,8 @@ public:
     /**
      * 加载预设
      * @param presetName 预设名称
-     * @param callback 加载完成回调
-     * @return 成功返回true
+     * @param callback 加载完成回调（所有插件加载完成并替换图之后调用）
+     * @return 开始加载返回true
      */
     bool loadPreset(const std::string& presetName, PresetLoadedCallback callback = nullptr);
     
@@ -297,6 +298,15 @@ public:
      */
     bool setGraphState(const GraphState& state);
     
+    /**
+     * 把图状态转换为图快照（不修改当前图，用于在独立的图实例上离线渲染预设）
+     * @param state 图状态数据（例如 PresetLibrary::loadState 读取的预设）
+     * @param snapshot 输出快照，节点ID和连接与保存时一致
+     * @param error 失败时的错误信息
+     * @return 成功返回true
+     */
+    static bool createGraphSnapshot(const GraphState& state, GraphSnapshot& snapshot, std::string& error);
+    
     /**
      * 创建状态快照
      * @param name 快照名称
@@ -398,16 +408,25 @@ private:
     
     // 预设存储
     mutable std::mutex presetsMutex;
-    std::unordered_map<std::string, PresetData> presets;
+    PresetLibrary library;
     std::unordered_map<std::string, PresetCategory> categories;
     
-    // 快照和备份
+    // 快照和备份（数据保存在快照存储中，这里只保存名称和时间）
     mutable std::mutex snapshotsMutex;
-    std::unordered_map<std::string, GraphState> snapshots;
+    std::unique_ptr<SnapshotStore> snapshotStore;
     std::unordered_map<std::string, std::string> snapshotNames;
-    std::unordered_map<std::string, GraphState> backups;
     std::unordered_map<std::string, juce::Time> backupTimes;
     
+    // 快照时复用没有变化的插件状态，复用一定次数后重新获取一次
+    struct CachedPluginState {
+        uint32_t generation = 0;
+        int reuseCount = 0;
+        juce::MemoryBlock state;
+    };
+    mutable std::mutex stateCacheMutex;
+    mutable std::unordered_map<NodeID, CachedPluginState> pluginStateCache;
+    static constexpr int MAX_STATE_REUSE_COUNT = 12;
+    
     // 自动备份
     std::unique_ptr<juce::Timer> autoBackupTimer;
     bool autoBackupEnabled = false;
@@ -422,14 +441,15 @@ private:
     // 内部方法
     //==============================================================================
     
-    GraphState captureCurrentState() const;
-    bool applyGraphState(const GraphState& state);
+    GraphState captureCurrentState(bool reuseUnchangedStates = false) const;
+    static void parseGraphState(const GraphState& state, PluginManager::GraphRecallRequest& request, bool& hasNodeIDs);
+    bool applyGraphState(const GraphState& state, std::function<void(bool success)> onComplete = nullptr);
+    void removeFromCategory(const std::string& categoryName, const std::string& presetName);
     std::string generateUniqueId() const;
     void notifyStateChanged();
     
-    // 序列化方法
-    std::unique_ptr<juce::XmlElement> serializePresetData(const PresetData& data) const;
-    PresetData deserializePresetData(const juce::XmlElement& xml) const;
+    static SnapshotStore::Streams toStreams(const GraphState& state);
+    static bool fromStreams(const SnapshotStore::Streams& streams, GraphState& state);
     
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(PresetManager)
 };
@@ -0,0 +1,608 @@
+//
+//  SnapshotStore.cpp
+//  WindsynthRecorder
+//
+//  Created by AI Assistant
+//  快照存储实现
+//
+
+#include "SnapshotStore.hpp"
+#include "../Core/Logger.hpp"
+#include <algorithm>
+#include <array>
+#include <cstring>
+
+namespace WindsynthVST::AudioGraph {
+
+//==============================================================================
+// 分块和哈希
+//==============================================================================
+
+namespace {
+
+constexpr size_t minChunkSize = 16 * 1024;
+constexpr size_t maxChunkSize = 256 * 1024;
+constexpr uint64_t chunkBoundaryMask = (1u << 16) - 1;     // 平均块大小约 64KB
+constexpr int compressionLevel = 3;
+
+constexpr int manifestMagic = 0x4E535357;                   // "WSSN"
+constexpr int manifestVersion = 1;
+constexpr juce::uint8 chunkFlagDeflate = 1;
+
+const std::array<uint64_t, 256>& getGearTable() {
+    static const auto table = [] {
+        std::array<uint64_t, 256> values{};
+        uint64_t state = 0x5EED5EED5EED5EEDull;
+        for (auto& value : values) {
+            // splitmix64
+            state += 0x9E3779B97F4A7C15ull;
+            uint64_t z = state;
+            z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+            z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+            value = z ^ (z >> 31);
+        }
+        return values;
+    }();
+    return table;
+}
+
+/**
+ * 按内容切分（gear 滚动哈希），返回每个块的长度
+ */
+std::vector<size_t> splitIntoChunks(const juce::uint8* data, size_t size) {
+    const auto& gear = getGearTable();
+    std::vector<size_t> lengths;
+
+    size_t start = 0;
+    while (start < size) {
+        const size_t remaining = size - start;
+        if (remaining <= minChunkSize) {
+            lengths.push_back(remaining);
+            break;
+        }
+
+        const size_t end = std::min(remaining, maxChunkSize);
+        uint64_t hash = 0;
+        size_t length = minChunkSize;
+        for (; length < end; ++length) {
+            hash = (hash << 1) + gear[data[start + length]];
+            if ((hash & chunkBoundaryMask) == 0) {
+                ++length;
+                break;
+            }
+        }
+
+        lengths.push_back(length);
+        start += length;
+    }
+
+    return lengths;
+}
+
+uint64_t hashFNV1a(const juce::uint8* data, size_t size) {
+    uint64_t hash = 0xCBF29CE484222325ull;
+    for (size_t i = 0; i < size; ++i) {
+        hash ^= data[i];
+        hash *= 0x100000001B3ull;
+    }
+    return hash;
+}
+
+uint64_t hashMix(const juce::uint8* data, size_t size) {
+    uint64_t hash = 0x9E3779B97F4A7C15ull ^ static_cast<uint64_t>(size);
+    size_t i = 0;
+    for (; i + 8 <= size; i += 8) {
+        uint64_t value;
+        std::memcpy(&value, data + i, sizeof(value));
+        hash = (hash ^ value) * 0xFF51AFD7ED558CCDull;
+        hash ^= hash >> 32;
+    }
+    for (; i < size; ++i) {
+        hash = (hash ^ data[i]) * 0xC4CEB9FE1A85EC53ull;
+    }
+    return hash ^ (hash >> 29);
+}
+
+} // namespace
+
+juce::String SnapshotStore::ChunkKey::toString() const {
+    return juce::String::toHexString(static_cast<juce::int64>(hashA)).paddedLeft('0', 16)
+           + juce::String::toHexString(static_cast<juce::int64>(hashB)).paddedLeft('0', 16)
+           + juce::String::toHexString(static_cast<int>(size)).paddedLeft('0', 8);
+}
+
+//==============================================================================
+// 构造函数和析构函数
+//==============================================================================
+
+SnapshotStore::SnapshotStore(const juce::File& storeDirectory)
+    : juce::Thread("SnapshotStore"), directory(storeDirectory)
+{
+    if (directory != juce::File()) {
+        loadFromDisk();
+    }
+    startThread(juce::Thread::Priority::low);
+}
+
+SnapshotStore::~SnapshotStore() {
+    // 后台线程在退出前处理完队列中的快照
+    signalThreadShouldExit();
+    notify();
+    stopThread(30000);
+}
+
+//==============================================================================
+// 快照操作
+//==============================================================================
+
+void SnapshotStore::add(const std::string& id, const std::string& category, const std::string& label, Streams streams) {
+    Manifest manifest;
+    manifest.info.id = id;
+    manifest.info.category = category;
+    manifest.info.label = label;
+    manifest.info.time = juce::Time::getCurrentTime();
+    for (const auto& stream : streams) {
+        manifest.info.logicalSize += static_cast<juce::int64>(stream.getSize());
+    }
+    manifest.pending = std::make_shared<const Streams>(std::move(streams));
+
+    {
+        std::lock_guard<std::mutex> lock(storeMutex);
+
+        auto existing = manifests.find(id);
+        if (existing != manifests.end()) {
+            if (existing->second.pending) {
+                // 旧快照还没有处理，直接替换数据，队列中已有任务
+                existing->second = std::move(manifest);
+                return;
+            }
+            releaseChunksLocked(existing->second);
+            manifests.erase(existing);
+        }
+
+        manifests.emplace(id, std::move(manifest));
+        jobs.push_back(id);
+        idleEvent.reset();
+    }
+
+    notify();
+}
+
+bool SnapshotStore::get(const std::string& id, Streams& streams) const {
+    std::vector<std::vector<ChunkKey>> keys;
+    {
+        std::lock_guard<std::mutex> lock(storeMutex);
+
+        auto it = manifests.find(id);
+        if (it == manifests.end() || it->second.removed) {
+            return false;
+        }
+
+        if (it->second.pending) {
+            streams = *it->second.pending;
+            return true;
+        }
+        keys = it->second.streams;
+    }
+
+    streams.clear();
+    streams.resize(keys.size());
+    for (size_t i = 0; i < keys.size(); ++i) {
+        juce::MemoryOutputStream output(streams[i], false);
+        for (const auto& key : keys[i]) {
+            juce::MemoryBlock chunk;
+            if (!readChunk(key, chunk)) {
+                WSLOG_ERROR("SnapshotStore", "数据块丢失：" << key.toString() << "，快照：" << id);
+                return false;
+            }
+            output.write(chunk.getData(), chunk.getSize());
+        }
+    }
+    return true;
+}
+
+bool SnapshotStore::remove(const std::string& id) {
+    {
+        std::lock_guard<std::mutex> lock(storeMutex);
+
+        auto it = manifests.find(id);
+        if (it == manifests.end() || it->second.removed) {
+            return false;
+        }
+
+        if (it->second.pending) {
+            // 后台线程处理到这个快照时丢弃
+            it->second.removed = true;
+            return true;
+        }
+
+        releaseChunksLocked(it->second);
+        manifests.erase(it);
+    }
+
+    if (directory != juce::File()) {
+        getManifestFile(id).deleteFile();
+    }
+    return true;
+}
+
+bool SnapshotStore::contains(const std::string& id) const {
+    std::lock_guard<std::mutex> lock(storeMutex);
+    auto it = manifests.find(id);
+    return it != manifests.end() && !it->second.removed;
+}
+
+std::vector<SnapshotStore::SnapshotInfo> SnapshotStore::getSnapshots(const std::string& category) const {
+    std::lock_guard<std::mutex> lock(storeMutex);
+
+    std::vector<SnapshotInfo> result;
+    for (const auto& [id, manifest] : manifests) {
+        if (!manifest.removed && (category.empty() || manifest.info.category == category)) {
+            result.push_back(manifest.info);
+        }
+    }
+
+    std::sort(result.begin(), result.end(),
+              [](const SnapshotInfo& a, const SnapshotInfo& b) { return a.time < b.time; });
+    return result;
+}
+
+bool SnapshotStore::waitUntilIdle(int timeoutMs) const {
+    return idleEvent.wait(static_cast<double>(timeoutMs));
+}
+
+SnapshotStore::Statistics SnapshotStore::getStatistics() const {
+    std::lock_guard<std::mutex> lock(storeMutex);
+
+    Statistics stats;
+    for (const auto& [id, manifest] : manifests) {
+        if (manifest.removed) {
+            continue;
+        }
+        stats.numSnapshots++;
+        stats.logicalBytes += manifest.info.logicalSize;
+        if (manifest.pending) {
+            stats.pendingSnapshots++;
+        }
+    }
+
+    stats.numChunks = static_cast<int>(chunks.size());
+    for (const auto& [key, chunk] : chunks) {
+        stats.uniqueBytes += key.size;
+        stats.storedBytes += static_cast<juce::int64>(chunk.storedSize);
+    }
+    return stats;
+}
+
+//==============================================================================
+// 后台处理
+//==============================================================================
+
+void SnapshotStore::run() {
+    for (;;) {
+        std::string id;
+        {
+            std::lock_guard<std::mutex> lock(storeMutex);
+            if (jobs.empty()) {
+                idleEvent.signal();
+            } else {
+                id = jobs.front();
+                jobs.pop_front();
+            }
+        }
+
+        if (id.empty()) {
+            if (threadShouldExit()) {
+                return;
+            }
+            wait(-1);
+            continue;
+        }
+
+        processSnapshot(id);
+    }
+}
+
+void SnapshotStore::processSnapshot(const std::string& id) {
+    std::shared_ptr<const Streams> streams;
+    {
+        std::lock_guard<std::mutex> lock(storeMutex);
+        auto it = manifests.find(id);
+        if (it == manifests.end() || !it->second.pending) {
+            return;
+        }
+        if (it->second.removed) {
+            manifests.erase(it);
+            return;
+        }
+        streams = it->second.pending;
+    }
+
+    const auto startTime = juce::Time::getMillisecondCounterHiRes();
+    std::vector<std::vector<ChunkKey>> keys(streams->size());
+    int newChunks = 0;
+    size_t newBytes = 0;
+
+    for (size_t streamIndex = 0; streamIndex < streams->size(); ++streamIndex) {
+        const auto& stream = (*streams)[streamIndex];
+        const auto* data = static_cast<const juce::uint8*>(stream.getData());
+
+        size_t offset = 0;
+        for (auto length : splitIntoChunks(data, stream.getSize())) {
+            const auto* chunkData = data + offset;
+            offset += length;
+
+            ChunkKey key;
+            key.hashA = hashFNV1a(chunkData, length);
+            key.hashB = hashMix(chunkData, length);
+            key.size = static_cast<uint32_t>(length);
+            keys[streamIndex].push_back(key);
+
+            // 已有的数据块只增加引用（只有这个线程插入数据块，检查和插入之间不会有别的插入）
+            {
+                std::lock_guard<std::mutex> lock(storeMutex);
+                auto existing = chunks.find(key);
+                if (existing != chunks.end()) {
+                    existing->second.refCount++;
+                    continue;
+                }
+            }
+
+            Chunk chunk;
+            chunk.refCount = 1;
+
+            juce::MemoryOutputStream compressedStream;
+            {
+                juce::GZIPCompressorOutputStream deflater(compressedStream, compressionLevel);
+                deflater.write(chunkData, length);
+            }
+            chunk.compressed = compressedStream.getDataSize() < length;
+
+            const void* storedData = chunk.compressed ? compressedStream.getData() : chunkData;
+            chunk.storedSize = chunk.compressed ? compressedStream.getDataSize() : length;
+
+            if (directory != juce::File()) {
+                auto file = getChunkFile(key);
+                juce::FileOutputStream output(file);
+                if (output.openedOk() && output.setPosition(0) && output.truncate().wasOk()) {
+                    output.writeByte(static_cast<char>(chunk.compressed ? chunkFlagDeflate : 0));
+                    output.write(storedData, chunk.storedSize);
+                    output.flush();
+                }
+                if (!output.openedOk() || output.getStatus().failed()) {
+                    WSLOG_ERROR("SnapshotStore", "写入数据块失败：" << file.getFullPathName());
+                    // 写入失败时保留在内存中，不丢失快照
+                    chunk.data.replaceAll(storedData, chunk.storedSize);
+                }
+            } else {
+                chunk.data.replaceAll(storedData, chunk.storedSize);
+            }
+
+            std::lock_guard<std::mutex> lock(storeMutex);
+            chunks.emplace(key, std::move(chunk));
+            newChunks++;
+            newBytes += length;
+        }
+    }
+
+    Manifest written;
+    bool replaced = false;
+    {
+        std::lock_guard<std::mutex> lock(storeMutex);
+        auto it = manifests.find(id);
+
+        // 处理期间快照被替换（数据换了，队列里没有新任务）或删除
+        replaced = it != manifests.end() && it->second.pending != streams;
+
+        Manifest finished;
+        finished.streams = std::move(keys);
+        if (it == manifests.end() || it->second.removed) {
+            releaseChunksLocked(finished);
+            if (it != manifests.end()) {
+                manifests.erase(it);
+            }
+        } else if (replaced) {
+            releaseChunksLocked(finished);
+            jobs.push_front(id);
+        } else {
+            it->second.streams = std::move(finished.streams);
+            it->second.pending.reset();
+            written = it->second;
+        }
+    }
+
+    if (!written.info.id.empty() && directory != juce::File()) {
+        writeManifest(written);
+    }
+
+    WSLOG_INFO("SnapshotStore", "快照已保存：" << id << "，新数据块 " << newChunks << " 个（"
+            << newBytes / 1024 << "KB），用时 "
+            << juce::roundToInt(juce::Time::getMillisecondCounterHiRes() - startTime) << "ms");
+}
+
+//==============================================================================
+// 数据块
+//==============================================================================
+
+void SnapshotStore::releaseChunksLocked(const Manifest& manifest) {
+    // 持有锁时删除文件，避免后台线程在删除前重新写入同一个数据块
+    for (const auto& stream : manifest.streams) {
+        for (const auto& key : stream) {
+            auto it = chunks.find(key);
+            if (it == chunks.end()) {
+                continue;
+            }
+            if (--it->second.refCount <= 0) {
+                if (directory != juce::File() && it->second.data.isEmpty()) {
+                    getChunkFile(key).deleteFile();
+                }
+                chunks.erase(it);
+            }
+        }
+    }
+}
+
+bool SnapshotStore::readChunk(const ChunkKey& key, juce::MemoryBlock& destination) const {
+    juce::MemoryBlock stored;
+    bool compressed = false;
+    {
+        std::lock_guard<std::mutex> lock(storeMutex);
+        auto it = chunks.find(key);
+        if (it == chunks.end()) {
+            return false;
+        }
+        if (!it->second.data.isEmpty()) {
+            stored = it->second.data;
+            compressed = it->second.compressed;
+        }
+    }
+
+    if (stored.isEmpty() && key.size > 0) {
+        juce::MemoryBlock fileData;
+        if (!getChunkFile(key).loadFileAsData(fileData) || fileData.getSize() < 1) {
+            return false;
+        }
+        compressed = (static_cast<juce::uint8>(fileData[0]) & chunkFlagDeflate) != 0;
+        stored.replaceAll(static_cast<const char*>(fileData.getData()) + 1, fileData.getSize() - 1);
+    }
+
+    if (!compressed) {
+        destination = std::move(stored);
+    } else {
+        juce::MemoryInputStream source(stored, false);
+        juce::GZIPDecompressorInputStream inflater(&source, false,
+                                                   juce::GZIPDecompressorInputStream::zlibFormat, key.size);
+        destination.reset();
+        inflater.readIntoMemoryBlock(destination);
+    }
+
+    return destination.getSize() == key.size;
+}
+
+juce::File SnapshotStore::getChunkFile(const ChunkKey& key) const {
+    return directory.getChildFile("chunks").getChildFile(key.toString() + ".chunk");
+}
+
+juce::File SnapshotStore::getManifestFile(const std::string& id) const {
+    return directory.getChildFile("manifests")
+        .getChildFile(juce::File::createLegalFileName(juce::String::fromUTF8(id.c_str())) + ".manifest");
+}
+
+//==============================================================================
+// 持久化
+//==============================================================================
+
+bool SnapshotStore::writeManifest(const Manifest& manifest) const {
+    auto file = getManifestFile(manifest.info.id);
+    if (!file.getParentDirectory().createDirectory()) {
+        return false;
+    }
+
+    juce::MemoryOutputStream stream;
+    stream.writeInt(manifestMagic);
+    stream.writeInt(manifestVersion);
+    stream.writeString(juce::String::fromUTF8(manifest.info.id.c_str()));
+    stream.writeString(juce::String::fromUTF8(manifest.info.category.c_str()));
+    stream.writeString(juce::String::fromUTF8(manifest.info.label.c_str()));
+    stream.writeInt64(manifest.info.time.toMilliseconds());
+    stream.writeInt(static_cast<int>(manifest.streams.size()));
+    for (const auto& keys : manifest.streams) {
+        stream.writeInt(static_cast<int>(keys.size()));
+        for (const auto& key : keys) {
+            stream.writeInt64(static_cast<juce::int64>(key.hashA));
+            stream.writeInt64(static_cast<juce::int64>(key.hashB));
+            stream.writeInt(static_cast<int>(key.size));
+        }
+    }
+
+    // 数据块已经写入，清单最后替换，崩溃时不会出现引用缺失数据块的清单
+    juce::TemporaryFile tempFile(file);
+    if (!tempFile.getFile().replaceWithData(stream.getData(), stream.getDataSize())) {
+        WSLOG_ERROR("SnapshotStore", "写入快照清单失败：" << file.getFullPathName());
+        return false;
+    }
+    return tempFile.overwriteTargetFileWithTemporary();
+}
+
+void SnapshotStore::loadFromDisk() {
+    directory.getChildFile("chunks").createDirectory();
+    directory.getChildFile("manifests").createDirectory();
+
+    std::lock_guard<std::mutex> lock(storeMutex);
+
+    for (const auto& item : juce::RangedDirectoryIterator(directory.getChildFile("manifests"), false,
+                                                          "*.manifest", juce::File::findFiles)) {
+        juce::MemoryBlock data;
+        if (!item.getFile().loadFileAsData(data)) {
+            continue;
+        }
+
+        juce::MemoryInputStream stream(data, false);
+        if (stream.readInt() != manifestMagic || stream.readInt() > manifestVersion) {
+            WSLOG_INFO("SnapshotStore", "跳过无效的快照清单：" << item.getFile().getFileName());
+            continue;
+        }
+
+        Manifest manifest;
+        manifest.info.id = stream.readString().toStdString();
+        manifest.info.category = stream.readString().toStdString();
+        manifest.info.label = stream.readString().toStdString();
+        manifest.info.time = juce::Time(stream.readInt64());
+
+        const int numStreams = stream.readInt();
+        bool complete = !manifest.info.id.empty();
+        for (int i = 0; i < numStreams && complete; ++i) {
+            const int numKeys = stream.readInt();
+            std::vector<ChunkKey> keys;
+            for (int k = 0; k < numKeys && !stream.isExhausted(); ++k) {
+                ChunkKey key;
+                key.hashA = static_cast<uint64_t>(stream.readInt64());
+                key.hashB = static_cast<uint64_t>(stream.readInt64());
+                key.size = static_cast<uint32_t>(stream.readInt());
+                manifest.info.logicalSize += key.size;
+                complete = complete && getChunkFile(key).existsAsFile();
+                keys.push_back(key);
+            }
+            manifest.streams.push_back(std::move(keys));
+        }
+
+        if (!complete) {
+            WSLOG_INFO("SnapshotStore", "快照数据不完整，已忽略：" << manifest.info.id);
+            continue;
+        }
+
+        for (const auto& keys : manifest.streams) {
+            for (const auto& key : keys) {
+                auto& chunk = chunks[key];
+                if (chunk.refCount++ == 0) {
+                    chunk.storedSize = static_cast<size_t>(juce::jmax<juce::int64>(0, getChunkFile(key).getSize() - 1));
+                }
+            }
+        }
+        manifests[manifest.info.id] = std::move(manifest);
+    }
+
+    // 删除没有被任何快照引用的数据块（写入清单前崩溃留下的）
+    int numOrphans = 0;
+    for (const auto& item : juce::RangedDirectoryIterator(directory.getChildFile("chunks"), false,
+                                                          "*.chunk", juce::File::findFiles)) {
+        const auto name = item.getFile().getFileNameWithoutExtension();
+        if (name.length() != 40) {
+            continue;
+        }
+
+        ChunkKey key;
+        key.hashA = static_cast<uint64_t>(name.substring(0, 16).getHexValue64());
+        key.hashB = static_cast<uint64_t>(name.substring(16, 32).getHexValue64());
+        key.size = static_cast<uint32_t>(name.substring(32).getHexValue32());
+        if (chunks.find(key) == chunks.end()) {
+            item.getFile().deleteFile();
+            numOrphans++;
+        }
+    }
+
+    WSLOG_INFO("SnapshotStore", "加载快照 " << manifests.size() << " 个，数据块 " << chunks.size()
+            << " 个，清理未引用的数据块 " << numOrphans << " 个");
+}
+
+} // namespace WindsynthVST::AudioGraph
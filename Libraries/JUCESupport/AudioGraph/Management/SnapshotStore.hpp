@@ -0,0 +1,171 @@
+//
+//  SnapshotStore.hpp
+//  WindsynthRecorder
+//
+//  Created by AI Assistant
+//  快照存储 - 按内容寻址、分块去重的快照和备份
+//
+
+#pragma once
+
+#include <JuceHeader.h>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include <cstdint>
+
+namespace WindsynthVST::AudioGraph {
+
+/**
+ * 快照存储
+ *
+ * 每个快照由若干数据流组成（例如图结构、插件状态、连接）。数据流按内容切分成数据块
+ * （滚动哈希确定边界，数据中间插入或删除内容时后面的块边界不受影响），
+ * 数据块按内容哈希只保存一次并记录引用计数，快照只保存数据块列表。
+ * 连续的快照之间没有变化的插件状态不占用额外的内存和磁盘空间。
+ *
+ * add() 立即返回，切分、哈希、压缩和写入磁盘在后台线程中完成；后台处理完成前
+ * 通过 get() 读取的是原始数据。设置目录时数据块和快照清单保存到磁盘（内存中不保留数据块），
+ * 下次启动时重新加载；否则压缩后的数据块保存在内存中。
+ *
+ * 所有方法都是线程安全的。
+ */
+class SnapshotStore : private juce::Thread {
+public:
+    using Streams = std::vector<juce::MemoryBlock>;
+
+    /**
+     * 快照信息
+     */
+    struct SnapshotInfo {
+        std::string id;
+        std::string category;
+        std::string label;
+        juce::Time time;
+        juce::int64 logicalSize = 0;        // 所有数据流的总大小
+    };
+
+    /**
+     * 存储统计
+     */
+    struct Statistics {
+        int numSnapshots = 0;
+        int pendingSnapshots = 0;           // 等待后台处理的快照数
+        int numChunks = 0;                  // 去重后的数据块数
+        juce::int64 logicalBytes = 0;       // 所有快照的总大小（不去重）
+        juce::int64 uniqueBytes = 0;        // 去重后的数据块总大小
+        juce::int64 storedBytes = 0;        // 压缩后实际占用的大小
+    };
+
+    /**
+     * 构造函数
+     * @param directory 存储目录，为空时只保存在内存中
+     */
+    explicit SnapshotStore(const juce::File& directory = juce::File());
+
+    /**
+     * 析构函数（等待后台处理完已添加的快照）
+     */
+    ~SnapshotStore() override;
+
+    /**
+     * 添加快照（同ID的快照被替换）
+     */
+    void add(const std::string& id, const std::string& category, const std::string& label, Streams streams);
+
+    /**
+     * 读取快照数据
+     * @return 成功返回true
+     */
+    bool get(const std::string& id, Streams& streams) const;
+
+    /**
+     * 删除快照，不再被引用的数据块同时删除
+     * @return 成功返回true
+     */
+    bool remove(const std::string& id);
+
+    /**
+     * 快照是否存在
+     */
+    bool contains(const std::string& id) const;
+
+    /**
+     * 获取快照列表
+     * @param category 类别，为空时返回所有快照
+     */
+    std::vector<SnapshotInfo> getSnapshots(const std::string& category = "") const;
+
+    /**
+     * 等待后台处理完所有快照
+     * @param timeoutMs 超时时间，-1表示一直等待
+     * @return 处理完成返回true
+     */
+    bool waitUntilIdle(int timeoutMs = -1) const;
+
+    /**
+     * 获取存储统计
+     */
+    Statistics getStatistics() const;
+
+    /**
+     * 获取存储目录
+     */
+    juce::File getDirectory() const { return directory; }
+
+private:
+    struct ChunkKey {
+        uint64_t hashA = 0;
+        uint64_t hashB = 0;
+        uint32_t size = 0;
+
+        bool operator==(const ChunkKey& other) const {
+            return hashA == other.hashA && hashB == other.hashB && size == other.size;
+        }
+        juce::String toString() const;
+    };
+
+    struct ChunkKeyHash {
+        size_t operator()(const ChunkKey& key) const noexcept { return static_cast<size_t>(key.hashA ^ key.hashB); }
+    };
+
+    struct Chunk {
+        int refCount = 0;
+        juce::MemoryBlock data;             // 内存存储时保存（可能已压缩）
+        bool compressed = false;
+        size_t storedSize = 0;
+    };
+
+    struct Manifest {
+        SnapshotInfo info;
+        std::vector<std::vector<ChunkKey>> streams;
+        std::shared_ptr<const Streams> pending;     // 后台处理完成前的原始数据
+        bool removed = false;
+    };
+
+    const juce::File directory;
+
+    mutable std::mutex storeMutex;
+    std::unordered_map<std::string, Manifest> manifests;
+    std::unordered_map<ChunkKey, Chunk, ChunkKeyHash> chunks;
+    std::deque<std::string> jobs;
+    mutable juce::WaitableEvent idleEvent{true};    // 队列为空且没有正在处理的快照时触发
+
+    void run() override;
+    void processSnapshot(const std::string& id);
+    void loadFromDisk();
+
+    void releaseChunksLocked(const Manifest& manifest);
+    bool readChunk(const ChunkKey& key, juce::MemoryBlock& destination) const;
+    bool writeManifest(const Manifest& manifest) const;
+
+    juce::File getChunkFile(const ChunkKey& key) const;
+    juce::File getManifestFile(const std::string& id) const;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(SnapshotStore)
+};
+
+} // namespace WindsynthVST::AudioGraph
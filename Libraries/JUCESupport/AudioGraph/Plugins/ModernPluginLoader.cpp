@@ -7,7 +7,7 @@
 //
 
 #include "ModernPluginLoader.hpp"
-#include <iostream>
+#include "../Core/Logger.hpp"
 #include <algorithm>
 
 namespace WindsynthVST::AudioGraph {
@@ -49,7 +49,7 @@ private:
 //==============================================================================
 
 ModernPluginLoader::ModernPluginLoader() {
-    std::cout << "[ModernPluginLoader] 初始化现代插件加载器（基于JUCE最佳实践）" << std::endl;
+    WSLOG_INFO("ModernPluginLoader", "初始化现代插件加载器（基于JUCE最佳实践）");
 
     // 创建线程池用于异步扫描
     scanningThreadPool = std::make_unique<juce::ThreadPool>(getRecommendedThreadCount());
@@ -58,12 +58,21 @@ ModernPluginLoader::ModernPluginLoader() {
     auto appDataDir = juce::File::getSpecialLocation(juce::File::userApplicationDataDirectory);
     deadMansPedalFile = appDataDir.getChildFile("WindsynthRecorder").getChildFile("CrashedPlugins.txt");
 
+    // 多进程扫描器（找不到辅助进程时回退到进程内扫描）
+    outOfProcessScanner = std::make_unique<OutOfProcessPluginScanner>();
+
+    // 增量扫描缓存，第一次访问插件列表时才加载
+    scanCache = std::make_unique<PluginScanCache>(
+        appDataDir.getChildFile("WindsynthRecorder").getChildFile("PluginScanCache.journal"));
+
     // 初始化默认格式
     initializeFormats();
+
+    catalogSnapshot = std::make_shared<const CatalogSnapshot>();
 }
 
 ModernPluginLoader::~ModernPluginLoader() {
-    std::cout << "[ModernPluginLoader] 析构插件加载器" << std::endl;
+    WSLOG_INFO("ModernPluginLoader", "析构插件加载器");
 
     stopScanning();
 
@@ -78,32 +87,46 @@ ModernPluginLoader::~ModernPluginLoader() {
     }
 }
 
+std::shared_ptr<ModernPluginLoader> ModernPluginLoader::getSharedInstance() {
+    static std::mutex sharedMutex;
+    static std::weak_ptr<ModernPluginLoader> sharedInstance;
+
+    std::lock_guard<std::mutex> lock(sharedMutex);
+    auto instance = sharedInstance.lock();
+    if (!instance) {
+        instance = std::make_shared<ModernPluginLoader>();
+        sharedInstance = instance;
+        WSLOG_INFO("ModernPluginLoader", "创建共享插件加载器");
+    }
+    return instance;
+}
+
 //==============================================================================
 // 插件格式管理实现
 //==============================================================================
 
 void ModernPluginLoader::initializeFormats(bool enableVST2, bool enableVST3, bool enableAU) {
-    std::cout << "[ModernPluginLoader] 初始化插件格式：VST2=" << enableVST2 
-              << ", VST3=" << enableVST3 << ", AU=" << enableAU << std::endl;
+    WSLOG_INFO("ModernPluginLoader", "初始化插件格式：VST2=" << enableVST2 
+            << ", VST3=" << enableVST3 << ", AU=" << enableAU);
     
     // 添加默认格式（包括VST3）
     formatManager.addDefaultFormats();
     
 #if JUCE_PLUGINHOST_VST && enableVST2
     // VST2支持（如果启用）
-    std::cout << "[ModernPluginLoader] 添加VST2支持" << std::endl;
+    WSLOG_INFO("ModernPluginLoader", "添加VST2支持");
 #endif
 
 #if JUCE_PLUGINHOST_AU && JUCE_MAC && enableAU
     // macOS上的AU支持
     formatManager.addFormat(new juce::AudioUnitPluginFormat());
-    std::cout << "[ModernPluginLoader] 添加AU支持" << std::endl;
+    WSLOG_INFO("ModernPluginLoader", "添加AU支持");
 #endif
 
     auto formats = formatManager.getFormats();
-    std::cout << "[ModernPluginLoader] 支持的格式数量：" << formats.size() << std::endl;
+    WSLOG_INFO("ModernPluginLoader", "支持的格式数量：" << formats.size());
     for (auto* format : formats) {
-        std::cout << "[ModernPluginLoader] - " << format->getName() << std::endl;
+        WSLOG_INFO("ModernPluginLoader", "- " << format->getName());
     }
 }
 
@@ -135,14 +158,14 @@ bool ModernPluginLoader::isFormatSupported(const juce::String& formatName) const
 //==============================================================================
 
 void ModernPluginLoader::scanDefaultPathsAsync(bool rescanExisting, int numThreads) {
-    std::cout << "[ModernPluginLoader] 开始扫描默认路径（使用JUCE最佳实践）" << std::endl;
+    WSLOG_INFO("ModernPluginLoader", "开始扫描默认路径（使用JUCE最佳实践）");
     scanDefaultPathsFastAsync(rescanExisting, numThreads);
     // if (scanning.load()) {
-    //     std::cout << "[ModernPluginLoader] 已有扫描在进行中" << std::endl;
+    //     WSLOG_INFO("ModernPluginLoader", "已有扫描在进行中");
     //     return;
     // }
 
-    // std::cout << "[ModernPluginLoader] 开始扫描默认路径（使用JUCE最佳实践）" << std::endl;
+    // WSLOG_INFO("ModernPluginLoader", "开始扫描默认路径（使用JUCE最佳实践）");
 
     // scanning.store(true);
     // shouldStopScanning.store(false);
@@ -163,11 +186,11 @@ void ModernPluginLoader::scanDefaultPathsAsync(bool rescanExisting, int numThrea
 
 void ModernPluginLoader::scanDefaultPathsFastAsync(bool rescanExisting, int numThreads) {
     if (scanning.load()) {
-        std::cout << "[ModernPluginLoader] 已有扫描在进行中" << std::endl;
+        WSLOG_INFO("ModernPluginLoader", "已有扫描在进行中");
         return;
     }
 
-    std::cout << "[ModernPluginLoader] 开始快速扫描默认路径（优先 VST3）" << std::endl;
+    WSLOG_INFO("ModernPluginLoader", "开始快速扫描默认路径（优先 VST3）");
 
     scanning.store(true);
     shouldStopScanning.store(false);
@@ -181,7 +204,7 @@ void ModernPluginLoader::scanDefaultPathsFastAsync(bool rescanExisting, int numT
     // 优先扫描 VST3 格式（支持快速扫描）
     for (auto* format : formatManager.getFormats()) {
         if (format->getName().contains("VST3")) {
-            std::cout << "[ModernPluginLoader] 优先快速扫描 VST3 插件" << std::endl;
+            WSLOG_INFO("ModernPluginLoader", "优先快速扫描 VST3 插件");
             scanningThreadPool->addJob([this, format, defaultPaths, rescanExisting, actualThreads]() {
                 performScanWithDirectoryScanner(*format, defaultPaths, true, rescanExisting, actualThreads);
             });
@@ -200,11 +223,11 @@ void ModernPluginLoader::scanDefaultPathsFastAsync(bool rescanExisting, int numT
 
 void ModernPluginLoader::scanFileAsync(const juce::File& fileOrDirectory, bool rescanExisting) {
     if (scanning.load()) {
-        std::cout << "[ModernPluginLoader] 已有扫描在进行中" << std::endl;
+        WSLOG_INFO("ModernPluginLoader", "已有扫描在进行中");
         return;
     }
 
-    std::cout << "[ModernPluginLoader] 开始扫描文件/目录：" << fileOrDirectory.getFullPathName() << std::endl;
+    WSLOG_INFO("ModernPluginLoader", "开始扫描文件/目录：" << fileOrDirectory.getFullPathName());
 
     scanning.store(true);
     shouldStopScanning.store(false);
@@ -222,7 +245,7 @@ void ModernPluginLoader::scanFileAsync(const juce::File& fileOrDirectory, bool r
 
 void ModernPluginLoader::stopScanning() {
     if (scanning.load()) {
-        std::cout << "[ModernPluginLoader] 停止扫描" << std::endl;
+        WSLOG_INFO("ModernPluginLoader", "停止扫描");
         shouldStopScanning.store(true);
 
         // 停止当前扫描器
@@ -255,7 +278,7 @@ bool ModernPluginLoader::isScanning() const {
 
 void ModernPluginLoader::setDeadMansPedalFile(const juce::File& file) {
     deadMansPedalFile = file;
-    std::cout << "[ModernPluginLoader] 设置Dead Man's Pedal文件：" << file.getFullPathName() << std::endl;
+    WSLOG_INFO("ModernPluginLoader", "设置Dead Man's Pedal文件：" << file.getFullPathName());
 }
 
 juce::File ModernPluginLoader::getDeadMansPedalFile() const {
@@ -266,16 +289,20 @@ juce::File ModernPluginLoader::getDeadMansPedalFile() const {
 // 插件查询实现
 //==============================================================================
 
+ModernPluginLoader::CatalogSnapshotPtr ModernPluginLoader::getCatalogSnapshot() const {
+    ensureScanCacheLoaded();
+    return std::atomic_load(&catalogSnapshot);
+}
+
 juce::Array<juce::PluginDescription> ModernPluginLoader::getKnownPlugins() const {
-    std::lock_guard<std::mutex> lock(listMutex);
-    return knownPluginList.getTypes();
+    return getCatalogSnapshot()->plugins;
 }
 
 juce::Array<juce::PluginDescription> ModernPluginLoader::getPluginsByCategory(const juce::String& category) const {
-    std::lock_guard<std::mutex> lock(listMutex);
+    auto snapshot = getCatalogSnapshot();
     juce::Array<juce::PluginDescription> result;
     
-    for (const auto& plugin : knownPluginList.getTypes()) {
+    for (const auto& plugin : snapshot->plugins) {
         if (plugin.category.containsIgnoreCase(category)) {
             result.add(plugin);
         }
@@ -285,10 +312,10 @@ juce::Array<juce::PluginDescription> ModernPluginLoader::getPluginsByCategory(co
 }
 
 juce::Array<juce::PluginDescription> ModernPluginLoader::getPluginsByManufacturer(const juce::String& manufacturer) const {
-    std::lock_guard<std::mutex> lock(listMutex);
+    auto snapshot = getCatalogSnapshot();
     juce::Array<juce::PluginDescription> result;
     
-    for (const auto& plugin : knownPluginList.getTypes()) {
+    for (const auto& plugin : snapshot->plugins) {
         if (plugin.manufacturerName.containsIgnoreCase(manufacturer)) {
             result.add(plugin);
         }
@@ -298,10 +325,10 @@ juce::Array<juce::PluginDescription> ModernPluginLoader::getPluginsByManufacture
 }
 
 juce::Array<juce::PluginDescription> ModernPluginLoader::getPluginsByFormat(const juce::String& formatName) const {
-    std::lock_guard<std::mutex> lock(listMutex);
+    auto snapshot = getCatalogSnapshot();
     juce::Array<juce::PluginDescription> result;
     
-    for (const auto& plugin : knownPluginList.getTypes()) {
+    for (const auto& plugin : snapshot->plugins) {
         if (plugin.pluginFormatName == formatName) {
             result.add(plugin);
         }
@@ -314,10 +341,10 @@ juce::Array<juce::PluginDescription> ModernPluginLoader::searchPlugins(const juc
                                                                        bool searchInName,
                                                                        bool searchInManufacturer,
                                                                        bool searchInCategory) const {
-    std::lock_guard<std::mutex> lock(listMutex);
+    auto snapshot = getCatalogSnapshot();
     juce::Array<juce::PluginDescription> result;
     
-    for (const auto& plugin : knownPluginList.getTypes()) {
+    for (const auto& plugin : snapshot->plugins) {
         bool matches = false;
         
         if (searchInName && plugin.name.containsIgnoreCase(searchText)) {
@@ -340,16 +367,16 @@ juce::Array<juce::PluginDescription> ModernPluginLoader::searchPlugins(const juc
     return result;
 }
 
-const juce::PluginDescription* ModernPluginLoader::findPluginByFile(const juce::String& fileOrIdentifier) const {
-    std::lock_guard<std::mutex> lock(listMutex);
+std::optional<juce::PluginDescription> ModernPluginLoader::findPluginByFile(const juce::String& fileOrIdentifier) const {
+    auto snapshot = getCatalogSnapshot();
 
-    for (const auto& plugin : knownPluginList.getTypes()) {
+    for (const auto& plugin : snapshot->plugins) {
         if (plugin.fileOrIdentifier == fileOrIdentifier) {
-            return &plugin;
+            return plugin;
         }
     }
 
-    return nullptr;
+    return std::nullopt;
 }
 
 //==============================================================================
@@ -360,14 +387,14 @@ void ModernPluginLoader::loadPluginAsync(const juce::PluginDescription& descript
                                         double sampleRate,
                                         int bufferSize,
                                         PluginLoadCallback callback) {
-    std::cout << "[ModernPluginLoader] 异步加载插件：" << description.name << std::endl;
+    WSLOG_INFO("ModernPluginLoader", "异步加载插件：" << description.name);
     
     formatManager.createPluginInstanceAsync(description, sampleRate, bufferSize,
         [callback](std::unique_ptr<juce::AudioPluginInstance> instance, const juce::String& error) {
             if (instance) {
-                std::cout << "[ModernPluginLoader] 插件加载成功：" << instance->getName() << std::endl;
+                WSLOG_INFO("ModernPluginLoader", "插件加载成功：" << instance->getName());
             } else {
-                std::cout << "[ModernPluginLoader] 插件加载失败：" << error << std::endl;
+                WSLOG_WARNING("ModernPluginLoader", "插件加载失败：" << error);
             }
             
             if (callback) {
@@ -380,14 +407,14 @@ std::unique_ptr<juce::AudioPluginInstance> ModernPluginLoader::loadPluginSync(co
                                                                              double sampleRate,
                                                                              int bufferSize,
                                                                              juce::String& errorMessage) {
-    std::cout << "[ModernPluginLoader] 同步加载插件：" << description.name << std::endl;
+    WSLOG_INFO("ModernPluginLoader", "同步加载插件：" << description.name);
     
     auto instance = formatManager.createPluginInstance(description, sampleRate, bufferSize, errorMessage);
     
     if (instance) {
-        std::cout << "[ModernPluginLoader] 插件加载成功：" << instance->getName() << std::endl;
+        WSLOG_INFO("ModernPluginLoader", "插件加载成功：" << instance->getName());
     } else {
-        std::cout << "[ModernPluginLoader] 插件加载失败：" << errorMessage << std::endl;
+        WSLOG_WARNING("ModernPluginLoader", "插件加载失败：" << errorMessage);
     }
     
     return instance;
@@ -402,21 +429,29 @@ bool ModernPluginLoader::doesPluginStillExist(const juce::PluginDescription& des
 //==============================================================================
 
 void ModernPluginLoader::addToBlacklist(const juce::String& pluginId) {
-    std::cout << "[ModernPluginLoader] 添加到黑名单：" << pluginId << std::endl;
+    WSLOG_INFO("ModernPluginLoader", "添加到黑名单：" << pluginId);
     
     std::lock_guard<std::mutex> lock(listMutex);
     knownPluginList.addToBlacklist(pluginId);
 }
 
 void ModernPluginLoader::removeFromBlacklist(const juce::String& pluginId) {
-    std::cout << "[ModernPluginLoader] 从黑名单移除：" << pluginId << std::endl;
+    WSLOG_INFO("ModernPluginLoader", "从黑名单移除：" << pluginId);
     
-    std::lock_guard<std::mutex> lock(listMutex);
-    knownPluginList.removeFromBlacklist(pluginId);
+    {
+        std::lock_guard<std::mutex> lock(listMutex);
+        knownPluginList.removeFromBlacklist(pluginId);
+    }
+
+    // 使缓存中的记录失效，下次扫描时重新扫描该插件
+    for (auto* format : formatManager.getFormats()) {
+        scanCache->remove(pluginId, format->getName());
+    }
+    scanCache->flush();
 }
 
 void ModernPluginLoader::clearBlacklist() {
-    std::cout << "[ModernPluginLoader] 清除黑名单" << std::endl;
+    WSLOG_INFO("ModernPluginLoader", "清除黑名单");
     
     std::lock_guard<std::mutex> lock(listMutex);
     knownPluginList.clearBlacklistedFiles();
@@ -432,7 +467,7 @@ const juce::StringArray& ModernPluginLoader::getBlacklist() const {
 //==============================================================================
 
 bool ModernPluginLoader::savePluginList(const juce::File& file) const {
-    std::cout << "[ModernPluginLoader] 保存插件列表到：" << file.getFullPathName() << std::endl;
+    WSLOG_INFO("ModernPluginLoader", "保存插件列表到：" << file.getFullPathName());
     
     std::lock_guard<std::mutex> lock(listMutex);
     
@@ -444,29 +479,128 @@ bool ModernPluginLoader::savePluginList(const juce::File& file) const {
 }
 
 bool ModernPluginLoader::loadPluginList(const juce::File& file) {
-    std::cout << "[ModernPluginLoader] 从文件加载插件列表：" << file.getFullPathName() << std::endl;
+    WSLOG_INFO("ModernPluginLoader", "从文件加载插件列表：" << file.getFullPathName());
     
     if (!file.existsAsFile()) {
-        std::cout << "[ModernPluginLoader] 插件列表文件不存在" << std::endl;
+        WSLOG_INFO("ModernPluginLoader", "插件列表文件不存在");
         return false;
     }
     
-    std::lock_guard<std::mutex> lock(listMutex);
-    
-    if (auto xml = juce::XmlDocument::parse(file)) {
+    auto xml = juce::XmlDocument::parse(file);
+    if (!xml) {
+        return false;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(listMutex);
         knownPluginList.recreateFromXml(*xml);
-        std::cout << "[ModernPluginLoader] 加载了 " << knownPluginList.getNumTypes() << " 个插件" << std::endl;
-        return true;
+        WSLOG_INFO("ModernPluginLoader", "加载了 " << knownPluginList.getNumTypes() << " 个插件");
     }
-    
-    return false;
+
+    publishCatalogSnapshot();
+    return true;
 }
 
 void ModernPluginLoader::clearPluginList() {
-    std::cout << "[ModernPluginLoader] 清除插件列表" << std::endl;
+    WSLOG_INFO("ModernPluginLoader", "清除插件列表");
+
+    {
+        std::lock_guard<std::mutex> lock(listMutex);
+        knownPluginList.clear();
+    }
+
+    publishCatalogSnapshot();
+}
+
+void ModernPluginLoader::setScanCacheFile(const juce::File& file) {
+    WSLOG_INFO("ModernPluginLoader", "设置扫描缓存文件：" << file.getFullPathName());
+    scanCache->setJournalFile(file);
+}
+
+PluginScanCache::Statistics ModernPluginLoader::getScanCacheStatistics() const {
+    return scanCache->getStatistics();
+}
+
+void ModernPluginLoader::clearScanCache() {
+    WSLOG_INFO("ModernPluginLoader", "清空扫描缓存");
+    scanCache->clear();
+}
+
+void ModernPluginLoader::setOutOfProcessScanningEnabled(bool enabled) {
+    WSLOG_INFO("ModernPluginLoader", "多进程扫描：" << (enabled ? "启用" : "禁用"));
+    outOfProcessScanningEnabled.store(enabled);
+}
 
+bool ModernPluginLoader::isOutOfProcessScanningEnabled() const {
+    return outOfProcessScanningEnabled.load();
+}
+
+void ModernPluginLoader::setScanWorkerExecutable(const juce::File& executable) {
+    WSLOG_INFO("ModernPluginLoader", "设置扫描辅助进程：" << executable.getFullPathName());
+    outOfProcessScanner->setWorkerExecutable(executable);
+}
+
+void ModernPluginLoader::setPluginScanTimeout(int timeoutMs) {
+    outOfProcessScanner->setTimeoutMs(timeoutMs);
+}
+
+void ModernPluginLoader::ensureScanCacheLoaded() const {
+    std::call_once(scanCacheLoadedFlag, [this] {
+        auto cachedTypes = scanCache->getAllTypes();
+
+        {
+            std::lock_guard<std::mutex> lock(listMutex);
+            for (const auto& type : cachedTypes) {
+                if (!knownPluginList.getBlacklistedFiles().contains(type.fileOrIdentifier)) {
+                    knownPluginList.addType(type);
+                }
+            }
+        }
+
+        publishCatalogSnapshot();
+        WSLOG_INFO("ModernPluginLoader", "从扫描缓存恢复 " << cachedTypes.size() << " 个插件");
+    });
+}
+
+void ModernPluginLoader::publishCatalogSnapshot() const {
+    std::lock_guard<std::mutex> publishLock(publishMutex);
+
+    auto snapshot = std::make_shared<CatalogSnapshot>();
+    {
+        std::lock_guard<std::mutex> lock(listMutex);
+        snapshot->plugins = knownPluginList.getTypes();
+    }
+
+    for (const auto& plugin : snapshot->plugins) {
+        snapshot->countByFormat[plugin.pluginFormatName]++;
+    }
+    snapshot->version = ++catalogVersion;
+
+    std::atomic_store(&catalogSnapshot, CatalogSnapshotPtr(std::move(snapshot)));
+}
+
+void ModernPluginLoader::removeTypesForFile(const juce::String& fileOrIdentifier, const juce::String& formatName) {
     std::lock_guard<std::mutex> lock(listMutex);
-    knownPluginList.clear();
+
+    for (const auto& type : knownPluginList.getTypes()) {
+        if (type.fileOrIdentifier == fileOrIdentifier && type.pluginFormatName == formatName) {
+            knownPluginList.removeType(type);
+        }
+    }
+}
+
+juce::Array<juce::PluginDescription> ModernPluginLoader::getTypesForFile(const juce::String& fileOrIdentifier,
+                                                                         const juce::String& formatName) const {
+    std::lock_guard<std::mutex> lock(listMutex);
+    juce::Array<juce::PluginDescription> result;
+
+    for (const auto& type : knownPluginList.getTypes()) {
+        if (type.fileOrIdentifier == fileOrIdentifier && type.pluginFormatName == formatName) {
+            result.add(type);
+        }
+    }
+
+    return result;
 }
 
 //==============================================================================
@@ -474,31 +608,37 @@ void ModernPluginLoader::clearPluginList() {
 //==============================================================================
 
 void ModernPluginLoader::setScanProgressCallback(ScanProgressCallback callback) {
+    std::lock_guard<std::mutex> lock(callbackMutex);
     progressCallback = std::move(callback);
 }
 
 void ModernPluginLoader::setScanCompleteCallback(ScanCompleteCallback callback) {
+    std::lock_guard<std::mutex> lock(callbackMutex);
     completeCallback = std::move(callback);
 }
 
+int ModernPluginLoader::addScanListener(ScanProgressCallback progress, ScanCompleteCallback complete) {
+    std::lock_guard<std::mutex> lock(callbackMutex);
+    const int listenerID = nextScanListenerID++;
+    scanListeners[listenerID] = ScanListener{std::move(progress), std::move(complete)};
+    return listenerID;
+}
+
+void ModernPluginLoader::removeScanListener(int listenerID) {
+    std::lock_guard<std::mutex> lock(callbackMutex);
+    scanListeners.erase(listenerID);
+}
+
 //==============================================================================
 // 统计信息实现
 //==============================================================================
 
 int ModernPluginLoader::getNumKnownPlugins() const {
-    std::lock_guard<std::mutex> lock(listMutex);
-    return knownPluginList.getNumTypes();
+    return getCatalogSnapshot()->plugins.size();
 }
 
 std::map<juce::String, int> ModernPluginLoader::getPluginCountByFormat() const {
-    std::lock_guard<std::mutex> lock(listMutex);
-    std::map<juce::String, int> counts;
-
-    for (const auto& plugin : knownPluginList.getTypes()) {
-        counts[plugin.pluginFormatName]++;
-    }
-
-    return counts;
+    return getCatalogSnapshot()->countByFormat;
 }
 
 //==============================================================================
@@ -518,8 +658,8 @@ bool ModernPluginLoader::hasVST3Manifest(const juce::File& vst3Path) {
     bool hasManifest = manifestFile.existsAsFile();
 
     if (hasManifest) {
-        std::cout << "[ModernPluginLoader] 发现 VST3 清单文件: "
-                  << manifestFile.getFullPathName() << std::endl;
+        WSLOG_INFO("ModernPluginLoader", "发现 VST3 清单文件: "
+                << manifestFile.getFullPathName());
     }
 
     return hasManifest;
@@ -542,14 +682,14 @@ juce::String ModernPluginLoader::getVST3ManifestInfo(const juce::File& vst3Path)
             manifestContent.contains("\"version\"") &&
             manifestContent.contains("\"factory\"")) {
 
-            std::cout << "[ModernPluginLoader] VST3 清单内容有效，支持快速扫描" << std::endl;
+            WSLOG_INFO("ModernPluginLoader", "VST3 清单内容有效，支持快速扫描");
             return manifestContent;
         } else {
-            std::cout << "[ModernPluginLoader] VST3 清单格式无效" << std::endl;
+            WSLOG_INFO("ModernPluginLoader", "VST3 清单格式无效");
             return {};
         }
     } catch (const std::exception& e) {
-        std::cout << "[ModernPluginLoader] 读取 VST3 清单失败: " << e.what() << std::endl;
+        WSLOG_WARNING("ModernPluginLoader", "读取 VST3 清单失败: " << e.what());
         return {};
     }
 }
@@ -563,69 +703,184 @@ void ModernPluginLoader::performScanWithDirectoryScanner(juce::AudioPluginFormat
                                                        bool recursive,
                                                        bool rescanExisting,
                                                        int numThreads) {
-    std::cout << "[ModernPluginLoader] 使用PluginDirectoryScanner扫描格式：" << format.getName() << std::endl;
+    WSLOG_INFO("ModernPluginLoader", "使用PluginDirectoryScanner扫描格式：" << format.getName());
 
     // 检查是否为 VST3 格式，启用快速扫描
     bool isVST3 = format.getName().contains("VST3");
     if (isVST3) {
-        std::cout << "[ModernPluginLoader] 启用 VST3 快速扫描（moduleinfo.json 支持）" << std::endl;
+        WSLOG_INFO("ModernPluginLoader", "启用 VST3 快速扫描（moduleinfo.json 支持）");
     }
 
-    try {
-        // 创建PluginDirectoryScanner，启用异步实例化以支持快速扫描
-        std::lock_guard<std::mutex> lock(scannerMutex);
-        currentScanner = std::make_unique<juce::PluginDirectoryScanner>(
-            knownPluginList, format, paths, recursive, deadMansPedalFile, true);
+    // 先恢复缓存的扫描结果，再只把新增或发生变化的插件包交给扫描器
+    ensureScanCacheLoaded();
+
+    const auto formatName = format.getName();
+    const auto allFiles = format.searchPathsForPlugins(paths, recursive, true);
+
+    juce::StringArray filesToScan;
+    std::map<juce::String, PluginScanCache::Fingerprint> fingerprints;
+    int unchangedBundles = 0;
+    int removedBundles = 0;
+
+    for (const auto& file : allFiles) {
+        const auto fingerprint = PluginScanCache::computeFingerprint(file);
+        juce::Array<juce::PluginDescription> cachedTypes;
 
-        // 启动多个扫描作业
-        for (int i = 0; i < numThreads; ++i) {
-            scanningThreadPool->addJob(new ScanJob(*this, format), true);
+        if (!rescanExisting && scanCache->lookup(file, formatName, fingerprint, cachedTypes)) {
+            std::lock_guard<std::mutex> lock(listMutex);
+            for (const auto& type : cachedTypes) {
+                knownPluginList.addType(type);
+            }
+            unchangedBundles++;
+        } else {
+            // 丢弃旧结果，确保扫描器重新扫描
+            removeTypesForFile(file, formatName);
+            filesToScan.add(file);
+            fingerprints[file] = fingerprint;
         }
+    }
 
-        // 等待扫描完成
-        while (currentScanner && !shouldStopScanning.load()) {
-            juce::String pluginBeingScanned;
+    // 已经不存在的插件包
+    for (const auto& cachedFile : scanCache->getCachedFiles(formatName)) {
+        if (!allFiles.contains(cachedFile)) {
+            removeTypesForFile(cachedFile, formatName);
+            scanCache->remove(cachedFile, formatName);
+            removedBundles++;
+        }
+    }
+
+    WSLOG_INFO("ModernPluginLoader", "增量扫描 " << formatName << "：未变化 " << unchangedBundles
+            << "，需扫描 " << filesToScan.size() << "，已移除 " << removedBundles);
+
+    // 优先在辅助进程中并行扫描，插件崩溃或卡死不会影响主程序
+    juce::StringArray failedFiles;
+    bool scannedOutOfProcess = false;
 
-            // 对于 VST3，尝试使用快速扫描（不加载插件实例）
-            bool useQuickScan = isVST3;
-            bool hasMore = currentScanner->scanNextFile(!useQuickScan, pluginBeingScanned);
+    if (outOfProcessScanningEnabled.load() && !filesToScan.isEmpty() && outOfProcessScanner->isAvailable()) {
+        scannedOutOfProcess = performOutOfProcessScan(format, filesToScan, numThreads, failedFiles);
+    }
+
+    if (!scannedOutOfProcess) {
+        try {
+            // 创建PluginDirectoryScanner，启用异步实例化以支持快速扫描
+            std::lock_guard<std::mutex> lock(scannerMutex);
+            currentScanner = std::make_unique<juce::PluginDirectoryScanner>(
+                knownPluginList, format, paths, recursive, deadMansPedalFile, true);
+            currentScanner->setFilesOrIdentifiersToScan(filesToScan);
 
-            if (!hasMore) {
-                break;
+            // 启动多个扫描作业
+            for (int i = 0; i < numThreads; ++i) {
+                scanningThreadPool->addJob(new ScanJob(*this, format), true);
             }
 
-            if (!pluginBeingScanned.isEmpty()) {
-                float progress = currentScanner->getProgress();
-                if (isVST3) {
-                    notifyProgress(progress, "快速扫描: " + pluginBeingScanned);
-                } else {
-                    notifyProgress(progress, pluginBeingScanned);
+            // 等待扫描完成
+            while (currentScanner && !shouldStopScanning.load()) {
+                juce::String pluginBeingScanned;
+
+                // 对于 VST3，尝试使用快速扫描（不加载插件实例）
+                bool useQuickScan = isVST3;
+                bool hasMore = currentScanner->scanNextFile(!useQuickScan, pluginBeingScanned);
+
+                if (!hasMore) {
+                    break;
+                }
+
+                if (!pluginBeingScanned.isEmpty()) {
+                    float progress = currentScanner->getProgress();
+                    if (isVST3) {
+                        notifyProgress(progress, "快速扫描: " + pluginBeingScanned);
+                    } else {
+                        notifyProgress(progress, pluginBeingScanned);
+                    }
                 }
+
+                // VST3 快速扫描可以更频繁地检查，因为速度更快
+                juce::Thread::sleep(isVST3 ? 5 : 10);
             }
 
-            // VST3 快速扫描可以更频繁地检查，因为速度更快
-            juce::Thread::sleep(isVST3 ? 5 : 10);
+            failedFiles = currentScanner->getFailedFiles();
+
+            // 清理扫描器
+            currentScanner.reset();
+
+        } catch (const std::exception& e) {
+            WSLOG_ERROR("ModernPluginLoader", "扫描异常：" << e.what());
+            // 回退到传统扫描方式
+            performLegacyScan(paths, recursive, rescanExisting);
         }
+    }
 
-        // 清理扫描器
-        currentScanner.reset();
+    // 记录扫描结果；扫描被中断时，尚未扫描到的插件包不记录，失败的插件包下次重试
+    const bool finished = !shouldStopScanning.load();
 
-    } catch (const std::exception& e) {
-        std::cerr << "[ModernPluginLoader] 扫描异常：" << e.what() << std::endl;
-        // 回退到传统扫描方式
-        performLegacyScan(paths, recursive, rescanExisting);
+    for (const auto& file : filesToScan) {
+        auto types = getTypesForFile(file, formatName);
+        if (types.isEmpty() && (!finished || failedFiles.contains(file))) {
+            continue;
+        }
+        scanCache->record(file, formatName, fingerprints[file], types);
     }
 
+    scanCache->setLastScanCounts(unchangedBundles, filesToScan.size(), removedBundles);
+    scanCache->flush();
+
+    publishCatalogSnapshot();
     scanning.store(false);
 
     int totalPlugins = getNumKnownPlugins();
-    std::cout << "[ModernPluginLoader] 格式 " << format.getName() << " 扫描完成，总插件数：" << totalPlugins << std::endl;
+    WSLOG_INFO("ModernPluginLoader", "格式 " << format.getName() << " 扫描完成，总插件数：" << totalPlugins);
 
     notifyComplete(totalPlugins);
 }
 
+bool ModernPluginLoader::performOutOfProcessScan(juce::AudioPluginFormat& format,
+                                                 const juce::StringArray& filesToScan,
+                                                 int numWorkers,
+                                                 juce::StringArray& failedFiles) {
+    const auto formatName = format.getName();
+    int numScanned = 0;
+
+    // 辅助进程数量不受进程内扫描的线程数限制，崩溃不会互相影响
+    numWorkers = std::max(numWorkers, juce::SystemStats::getNumCpus());
+
+    const bool launched = outOfProcessScanner->scan(
+        formatName, filesToScan, numWorkers, shouldStopScanning,
+        [this, &formatName, &failedFiles, &numScanned](const OutOfProcessPluginScanner::FileResult& result,
+                                                         int numCompleted, int numTotal) {
+            using Outcome = OutOfProcessPluginScanner::Outcome;
+
+            if (result.outcome == Outcome::Scanned) {
+                {
+                    std::lock_guard<std::mutex> lock(listMutex);
+                    for (const auto& type : result.types) {
+                        knownPluginList.addType(type);
+                    }
+                }
+                publishCatalogSnapshot();
+                numScanned++;
+            } else if (result.outcome == Outcome::Failed) {
+                failedFiles.add(result.fileOrIdentifier);
+            } else {
+                // 崩溃或卡死的插件加入黑名单，并以空结果记录到缓存，插件更新后才会重新扫描
+                addToBlacklist(result.fileOrIdentifier);
+            }
+
+            notifyProgress(static_cast<float>(numCompleted) / static_cast<float>(numTotal),
+                           result.fileOrIdentifier);
+        });
+
+    if (!launched) {
+        WSLOG_INFO("ModernPluginLoader", "无法启动扫描辅助进程，回退到进程内扫描");
+        return false;
+    }
+
+    WSLOG_INFO("ModernPluginLoader", "辅助进程扫描 " << formatName << " 完成：成功 " << numScanned
+            << "，失败 " << failedFiles.size());
+    return true;
+}
+
 void ModernPluginLoader::performLegacyScan(const juce::FileSearchPath& paths, bool recursive, bool rescanExisting) {
-    std::cout << "[ModernPluginLoader] 使用传统扫描方式" << std::endl;
+    WSLOG_INFO("ModernPluginLoader", "使用传统扫描方式");
 
     int totalFilesFound = 0;
     int filesScanned = 0;
@@ -635,7 +890,7 @@ void ModernPluginLoader::performLegacyScan(const juce::FileSearchPath& paths, bo
     juce::StringArray allFiles;
     for (int i = 0; i < paths.getNumPaths(); ++i) {
         auto path = paths[i];
-        std::cout << "[ModernPluginLoader] 扫描路径：" << path.getFullPathName() << std::endl;
+        WSLOG_INFO("ModernPluginLoader", "扫描路径：" << path.getFullPathName());
 
         for (auto* format : formatManager.getFormats()) {
             juce::FileSearchPath searchPath;
@@ -646,12 +901,12 @@ void ModernPluginLoader::performLegacyScan(const juce::FileSearchPath& paths, bo
     }
 
     totalFilesFound = allFiles.size();
-    std::cout << "[ModernPluginLoader] 找到 " << totalFilesFound << " 个潜在插件文件" << std::endl;
+    WSLOG_INFO("ModernPluginLoader", "找到 " << totalFilesFound << " 个潜在插件文件");
 
     // 扫描每个文件
     for (const auto& file : allFiles) {
         if (shouldStopScanning.load()) {
-            std::cout << "[ModernPluginLoader] 扫描被用户停止" << std::endl;
+            WSLOG_INFO("ModernPluginLoader", "扫描被用户停止");
             break;
         }
 
@@ -670,7 +925,7 @@ void ModernPluginLoader::performLegacyScan(const juce::FileSearchPath& paths, bo
                                          hasVST3Manifest(juce::File(file));
 
                 if (isVST3WithManifest) {
-                    std::cout << "[ModernPluginLoader] VST3 插件支持快速扫描: " << file << std::endl;
+                    WSLOG_INFO("ModernPluginLoader", "VST3 插件支持快速扫描: " << file);
                 }
 
                 std::lock_guard<std::mutex> lock(listMutex);
@@ -678,9 +933,9 @@ void ModernPluginLoader::performLegacyScan(const juce::FileSearchPath& paths, bo
 
                 if (foundNew) {
                     pluginsFound += typesFound.size();
-                    std::cout << "[ModernPluginLoader] 在 " << file << " 中找到 "
-                              << typesFound.size() << " 个插件"
-                              << (isVST3WithManifest ? " (快速扫描)" : "") << std::endl;
+                    WSLOG_INFO("ModernPluginLoader", "在 " << file << " 中找到 "
+                            << typesFound.size() << " 个插件"
+                            << (isVST3WithManifest ? " (快速扫描)" : ""));
                 }
 
                 break; // 找到匹配的格式就停止
@@ -688,18 +943,45 @@ void ModernPluginLoader::performLegacyScan(const juce::FileSearchPath& paths, bo
         }
     }
 
-    std::cout << "[ModernPluginLoader] 传统扫描完成，找到 " << pluginsFound << " 个新插件" << std::endl;
+    WSLOG_INFO("ModernPluginLoader", "传统扫描完成，找到 " << pluginsFound << " 个新插件");
 }
 
 void ModernPluginLoader::notifyProgress(float progress, const juce::String& currentFile) {
-    if (progressCallback) {
-        progressCallback(progress, currentFile);
+    // 复制后在锁外回调，回调中可以增删监听
+    std::vector<ScanProgressCallback> callbacks;
+    {
+        std::lock_guard<std::mutex> lock(callbackMutex);
+        if (progressCallback) {
+            callbacks.push_back(progressCallback);
+        }
+        for (const auto& [listenerID, listener] : scanListeners) {
+            if (listener.progress) {
+                callbacks.push_back(listener.progress);
+            }
+        }
+    }
+
+    for (const auto& callback : callbacks) {
+        callback(progress, currentFile);
     }
 }
 
 void ModernPluginLoader::notifyComplete(int foundPlugins) {
-    if (completeCallback) {
-        completeCallback(foundPlugins);
+    std::vector<ScanCompleteCallback> callbacks;
+    {
+        std::lock_guard<std::mutex> lock(callbackMutex);
+        if (completeCallback) {
+            callbacks.push_back(completeCallback);
+        }
+        for (const auto& [listenerID, listener] : scanListeners) {
+            if (listener.complete) {
+                callbacks.push_back(listener.complete);
+            }
+        }
+    }
+
+    for (const auto& callback : callbacks) {
+        callback(foundPlugins);
     }
 }
 
@@ -736,11 +1018,11 @@ juce::FileSearchPath ModernPluginLoader::getDefaultSearchPaths() const {
     defaultPaths.add(juce::File("/usr/local/lib/vst3"));
 #endif
 
-    std::cout << "[ModernPluginLoader] 默认搜索路径数量：" << defaultPaths.getNumPaths() << std::endl;
+    WSLOG_INFO("ModernPluginLoader", "默认搜索路径数量：" << defaultPaths.getNumPaths());
     for (int i = 0; i < defaultPaths.getNumPaths(); ++i) {
         auto path = defaultPaths[i];
-        std::cout << "[ModernPluginLoader] - " << path.getFullPathName()
-                  << " (存在: " << (path.exists() ? "是" : "否") << ")" << std::endl;
+        WSLOG_INFO("ModernPluginLoader", "- " << path.getFullPathName()
+                << " (存在: " << (path.exists() ? "是" : "否") << ")");
     }
 
     return defaultPaths;
@@ -754,8 +1036,8 @@ int ModernPluginLoader::getRecommendedThreadCount() const {
     // 特别是某些插件可能不是线程安全的
     int recommendedThreads = juce::jmax(1, juce::jmin(4, numCores / 2));
 
-    std::cout << "[ModernPluginLoader] 系统CPU核心数：" << numCores
-              << "，推荐扫描线程数：" << recommendedThreads << std::endl;
+    WSLOG_INFO("ModernPluginLoader", "系统CPU核心数：" << numCores
+            << "，推荐扫描线程数：" << recommendedThreads);
 
     return recommendedThreads;
 }
@@ -15,6 +15,10 @@
 #include <string>
 #include <atomic>
 #include <mutex>
+#include <map>
+#include <optional>
+#include "PluginScanCache.hpp"
+#include "OutOfProcessPluginScanner.hpp"
 
 namespace WindsynthVST::AudioGraph {
 
@@ -26,8 +30,10 @@ namespace WindsynthVST::AudioGraph {
  * - Dead Man's Pedal崩溃保护机制
  * - 多线程并行扫描优化
  * - VST3快速扫描支持
- * - 子进程隔离扫描（可选）
- * - 智能缓存和增量扫描
+ * - 子进程隔离扫描（OutOfProcessPluginScanner，多个辅助进程并行扫描，崩溃和超时的插件自动加入黑名单）
+ * - 智能缓存和增量扫描（PluginScanCache，只重新扫描新增或变化的插件包）
+ * - 进程级共享实例（getSharedInstance），多个引擎共用同一份插件目录和格式管理器，扫描只进行一次
+ * - 插件查询读取不可变的目录快照，列表变化时整体替换，查询不与扫描线程争用 listMutex
  */
 class ModernPluginLoader {
 public:
@@ -55,6 +61,17 @@ public:
      * @param foundPlugins 找到的插件数量
      */
     using ScanCompleteCallback = std::function<void(int foundPlugins)>;
+
+    /**
+     * 插件目录快照（发布后不再修改，可在任意线程中持有和读取）
+     */
+    struct CatalogSnapshot {
+        juce::Array<juce::PluginDescription> plugins;
+        std::map<juce::String, int> countByFormat;
+        uint64_t version = 0;   // 每次发布递增
+    };
+
+    using CatalogSnapshotPtr = std::shared_ptr<const CatalogSnapshot>;
     
     //==============================================================================
     // 构造函数和析构函数
@@ -69,6 +86,14 @@ public:
      * 析构函数
      */
     ~ModernPluginLoader();
+
+    /**
+     * 获取进程级共享实例
+     *
+     * 所有引擎实例共用同一个加载器：插件目录、格式管理器、扫描缓存和扫描任务只有一份。
+     * 按引用计数管理，最后一个持有者释放后销毁，下次调用时重新创建。
+     */
+    static std::shared_ptr<ModernPluginLoader> getSharedInstance();
     
     //==============================================================================
     // 插件格式管理
@@ -132,8 +157,14 @@ public:
     bool isScanning() const;
     
     //==============================================================================
-    // 插件查询
+    // 插件查询（读取目录快照，不加锁）
     //==============================================================================
+
+    /**
+     * 获取当前插件目录快照
+     * @return 不可变快照，持有期间内容不会变化
+     */
+    CatalogSnapshotPtr getCatalogSnapshot() const;
     
     /**
      * 获取所有已知插件
@@ -178,9 +209,9 @@ public:
     /**
      * 根据文件路径查找插件
      * @param fileOrIdentifier 文件路径或标识符
-     * @return 匹配的插件描述，未找到时返回nullptr
+     * @return 匹配的插件描述，未找到时为空
      */
-    const juce::PluginDescription* findPluginByFile(const juce::String& fileOrIdentifier) const;
+    std::optional<juce::PluginDescription> findPluginByFile(const juce::String& fileOrIdentifier) const;
     
     //==============================================================================
     // 插件加载
@@ -280,6 +311,42 @@ public:
      */
     void clearPluginList();
     
+    /**
+     * 设置增量扫描缓存文件（默认位于应用数据目录）
+     * @param file 缓存日志文件
+     */
+    void setScanCacheFile(const juce::File& file);
+    
+    /**
+     * 获取增量扫描缓存统计
+     */
+    PluginScanCache::Statistics getScanCacheStatistics() const;
+    
+    /**
+     * 清空增量扫描缓存（下次扫描时全部重新扫描）
+     */
+    void clearScanCache();
+    
+    /**
+     * 启用或禁用多进程扫描（默认启用，找不到辅助进程时自动使用进程内扫描）
+     */
+    void setOutOfProcessScanningEnabled(bool enabled);
+    
+    /**
+     * 是否启用多进程扫描
+     */
+    bool isOutOfProcessScanningEnabled() const;
+    
+    /**
+     * 设置扫描辅助进程可执行文件
+     */
+    void setScanWorkerExecutable(const juce::File& executable);
+    
+    /**
+     * 设置单个插件的扫描超时时间（多进程扫描，超时的插件加入黑名单）
+     */
+    void setPluginScanTimeout(int timeoutMs);
+    
     //==============================================================================
     // 回调设置
     //==============================================================================
@@ -293,6 +360,17 @@ public:
      * 设置扫描完成回调
      */
     void setScanCompleteCallback(ScanCompleteCallback callback);
+
+    /**
+     * 添加扫描监听（共享实例的各个使用者分别监听同一次扫描）
+     * @return 监听ID，用于 removeScanListener
+     */
+    int addScanListener(ScanProgressCallback progress, ScanCompleteCallback complete);
+
+    /**
+     * 移除扫描监听
+     */
+    void removeScanListener(int listenerID);
     
     //==============================================================================
     // 统计信息
@@ -335,7 +413,11 @@ private:
 
     // JUCE核心组件
     juce::AudioPluginFormatManager formatManager;
-    juce::KnownPluginList knownPluginList;
+    mutable juce::KnownPluginList knownPluginList;   // 第一次查询时从扫描缓存填充
+
+    // 增量扫描缓存（延迟加载）
+    std::unique_ptr<PluginScanCache> scanCache;
+    mutable std::once_flag scanCacheLoadedFlag;
 
     // 扫描器和线程管理
     std::unique_ptr<juce::PluginDirectoryScanner> currentScanner;
@@ -343,12 +425,29 @@ private:
     std::atomic<bool> scanning{false};
     std::atomic<bool> shouldStopScanning{false};
 
+    // 多进程扫描
+    std::unique_ptr<OutOfProcessPluginScanner> outOfProcessScanner;
+    std::atomic<bool> outOfProcessScanningEnabled{true};
+
     // Dead Man's Pedal崩溃保护
     juce::File deadMansPedalFile;
 
     // 回调函数
+    struct ScanListener {
+        ScanProgressCallback progress;
+        ScanCompleteCallback complete;
+    };
+
     ScanProgressCallback progressCallback;
     ScanCompleteCallback completeCallback;
+    std::map<int, ScanListener> scanListeners;
+    int nextScanListenerID = 1;
+    mutable std::mutex callbackMutex;
+
+    // 插件目录快照（std::atomic_load/atomic_store 读写，修改 knownPluginList 后重新发布）
+    mutable CatalogSnapshotPtr catalogSnapshot;
+    mutable uint64_t catalogVersion = 0;
+    mutable std::mutex publishMutex;   // 保证快照按修改顺序发布
 
     // 线程安全
     mutable std::mutex listMutex;
@@ -371,6 +470,17 @@ private:
                                         bool rescanExisting,
                                         int numThreads);
 
+    bool performOutOfProcessScan(juce::AudioPluginFormat& format,
+                                 const juce::StringArray& filesToScan,
+                                 int numWorkers,
+                                 juce::StringArray& failedFiles);
+
+    void ensureScanCacheLoaded() const;
+    void publishCatalogSnapshot() const;
+    void removeTypesForFile(const juce::String& fileOrIdentifier, const juce::String& formatName);
+    juce::Array<juce::PluginDescription> getTypesForFile(const juce::String& fileOrIdentifier,
+                                                         const juce::String& formatName) const;
+
     void performLegacyScan(const juce::FileSearchPath& paths, bool recursive, bool rescanExisting);
     void notifyProgress(float progress, const juce::String& currentFile);
     void notifyComplete(int foundPlugins);
@@ -0,0 +1,317 @@
+//
+//  OutOfProcessPluginScanner.cpp
+//  WindsynthRecorder
+//
+//  Created by AI Assistant
+//  多进程插件扫描实现
+//
+
+#include "OutOfProcessPluginScanner.hpp"
+#include "PluginScanProtocol.hpp"
+#include "../Core/Logger.hpp"
+#include <algorithm>
+#include <vector>
+
+namespace WindsynthVST::AudioGraph {
+
+//==============================================================================
+// 辅助进程连接
+//==============================================================================
+
+/**
+ * 一个辅助进程。连接回调在IPC线程中调用，状态由互斥锁保护，
+ * 由 scan() 所在的线程轮询。
+ */
+class OutOfProcessPluginScanner::WorkerConnection : public juce::ChildProcessCoordinator {
+public:
+    explicit WorkerConnection(juce::WaitableEvent& resultEvent)
+        : resultReady(resultEvent) {}
+
+    ~WorkerConnection() override {
+        // 在派生类销毁前结束进程，避免连接线程回调到已销毁的对象
+        killWorkerProcess();
+    }
+
+    bool launch(const juce::File& executable) {
+        // 不捕获辅助进程的输出，插件的大量日志不会阻塞管道
+        return launchWorkerProcess(executable, PluginScanProtocol::commandLineUID, 0, 0);
+    }
+
+    bool startScan(const juce::String& formatName, const juce::String& fileOrIdentifier) {
+        {
+            std::lock_guard<std::mutex> lock(stateMutex);
+            currentFile = fileOrIdentifier;
+            startTime = juce::Time::getMillisecondCounter();
+            busy = true;
+            hasResult = false;
+        }
+
+        if (!sendMessageToWorker(PluginScanProtocol::createScanRequest(formatName, fileOrIdentifier))) {
+            std::lock_guard<std::mutex> lock(stateMutex);
+            busy = false;
+            return false;
+        }
+        return true;
+    }
+
+    bool takeResult(FileResult& result) {
+        std::lock_guard<std::mutex> lock(stateMutex);
+        if (!hasResult) {
+            return false;
+        }
+
+        result = std::move(pendingResult);
+        pendingResult = {};
+        hasResult = false;
+        busy = false;
+        return true;
+    }
+
+    bool isBusy() const {
+        std::lock_guard<std::mutex> lock(stateMutex);
+        return busy;
+    }
+
+    juce::String getCurrentFile() const {
+        std::lock_guard<std::mutex> lock(stateMutex);
+        return currentFile;
+    }
+
+    juce::uint32 getElapsedMs() const {
+        std::lock_guard<std::mutex> lock(stateMutex);
+        return juce::Time::getMillisecondCounter() - startTime;
+    }
+
+    bool isConnectionLost() const {
+        return connectionLost.load();
+    }
+
+    //==============================================================================
+    // ChildProcessCoordinator 接口实现
+    //==============================================================================
+
+    void handleMessageFromWorker(const juce::MemoryBlock& message) override {
+        FileResult result;
+        bool ok = false;
+
+        if (!PluginScanProtocol::parseScanResult(message, result.fileOrIdentifier, ok, result.types, result.error)) {
+            return;
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(stateMutex);
+
+            // 忽略与当前请求不对应的结果
+            if (!busy || result.fileOrIdentifier != currentFile) {
+                return;
+            }
+
+            result.outcome = ok ? Outcome::Scanned : Outcome::Failed;
+            pendingResult = std::move(result);
+            hasResult = true;
+        }
+
+        resultReady.signal();
+    }
+
+    void handleConnectionLost() override {
+        connectionLost.store(true);
+        resultReady.signal();
+    }
+
+private:
+    juce::WaitableEvent& resultReady;
+
+    mutable std::mutex stateMutex;
+    juce::String currentFile;
+    juce::uint32 startTime = 0;
+    bool busy = false;
+    bool hasResult = false;
+    FileResult pendingResult;
+
+    std::atomic<bool> connectionLost{false};
+};
+
+//==============================================================================
+// 构造函数和析构函数
+//==============================================================================
+
+OutOfProcessPluginScanner::OutOfProcessPluginScanner()
+    : workerExecutable(getDefaultWorkerExecutable())
+{
+}
+
+OutOfProcessPluginScanner::~OutOfProcessPluginScanner() = default;
+
+//==============================================================================
+// 配置
+//==============================================================================
+
+void OutOfProcessPluginScanner::setWorkerExecutable(const juce::File& executable) {
+    std::lock_guard<std::mutex> lock(settingsMutex);
+    workerExecutable = executable;
+}
+
+juce::File OutOfProcessPluginScanner::getWorkerExecutable() const {
+    std::lock_guard<std::mutex> lock(settingsMutex);
+    return workerExecutable;
+}
+
+bool OutOfProcessPluginScanner::isAvailable() const {
+    return getWorkerExecutable().existsAsFile();
+}
+
+void OutOfProcessPluginScanner::setTimeoutMs(int newTimeoutMs) {
+    std::lock_guard<std::mutex> lock(settingsMutex);
+    timeoutMs = std::max(1000, newTimeoutMs);
+}
+
+int OutOfProcessPluginScanner::getTimeoutMs() const {
+    std::lock_guard<std::mutex> lock(settingsMutex);
+    return timeoutMs;
+}
+
+juce::File OutOfProcessPluginScanner::getDefaultWorkerExecutable() {
+    auto bundled = juce::File::getSpecialLocation(juce::File::currentApplicationFile)
+                       .getChildFile("Contents")
+                       .getChildFile("Helpers")
+                       .getChildFile(PluginScanProtocol::workerExecutableName);
+    if (bundled.existsAsFile()) {
+        return bundled;
+    }
+
+    return juce::File::getSpecialLocation(juce::File::currentExecutableFile)
+               .getSiblingFile(PluginScanProtocol::workerExecutableName);
+}
+
+//==============================================================================
+// 扫描
+//==============================================================================
+
+bool OutOfProcessPluginScanner::scan(const juce::String& formatName,
+                                     const juce::StringArray& files,
+                                     int numWorkers,
+                                     const std::atomic<bool>& shouldStop,
+                                     const ResultCallback& onResult) {
+    if (files.isEmpty()) {
+        return true;
+    }
+
+    const auto executable = getWorkerExecutable();
+    const auto timeout = static_cast<juce::uint32>(getTimeoutMs());
+    if (!executable.existsAsFile()) {
+        return false;
+    }
+
+    const int numTotal = files.size();
+    numWorkers = juce::jlimit(1, numTotal, numWorkers);
+
+    // 连续启动失败过多时放弃（可执行文件损坏或系统资源不足）
+    const int maxLaunchFailures = numWorkers * 2 + 2;
+    int launchFailures = 0;
+
+    juce::WaitableEvent resultReady;
+
+    auto launchWorker = [&]() -> std::unique_ptr<WorkerConnection> {
+        auto worker = std::make_unique<WorkerConnection>(resultReady);
+        if (!worker->launch(executable)) {
+            WSLOG_ERROR("OutOfProcessPluginScanner", "无法启动辅助进程：" << executable.getFullPathName());
+            launchFailures++;
+            return nullptr;
+        }
+        return worker;
+    };
+
+    std::vector<std::unique_ptr<WorkerConnection>> workers;
+    for (int i = 0; i < numWorkers; ++i) {
+        workers.push_back(launchWorker());
+    }
+
+    if (std::none_of(workers.begin(), workers.end(), [](const auto& worker) { return worker != nullptr; })) {
+        return false;
+    }
+
+    WSLOG_INFO("OutOfProcessPluginScanner", "使用 " << numWorkers << " 个辅助进程扫描 "
+            << numTotal << " 个 " << formatName << " 文件");
+
+    int nextIndex = 0;
+    int numCompleted = 0;
+
+    auto deliver = [&](const FileResult& result) {
+        numCompleted++;
+        if (onResult) {
+            onResult(result, numCompleted, numTotal);
+        }
+    };
+
+    while (numCompleted < numTotal && !shouldStop.load()) {
+        bool anyWorkerAlive = false;
+
+        for (auto& worker : workers) {
+            if (worker == nullptr) {
+                if (nextIndex >= numTotal || launchFailures >= maxLaunchFailures) {
+                    continue;
+                }
+                worker = launchWorker();
+                if (worker == nullptr) {
+                    continue;
+                }
+            }
+
+            FileResult result;
+            if (worker->takeResult(result)) {
+                deliver(result);
+            } else if (worker->isBusy()) {
+                const bool crashed = worker->isConnectionLost();
+                if (!crashed && worker->getElapsedMs() <= timeout) {
+                    anyWorkerAlive = true;
+                    continue;
+                }
+
+                result.fileOrIdentifier = worker->getCurrentFile();
+                result.outcome = crashed ? Outcome::Crashed : Outcome::TimedOut;
+                result.error = crashed ? "辅助进程崩溃" : "扫描超时";
+                WSLOG_ERROR("OutOfProcessPluginScanner", result.error << "：" << result.fileOrIdentifier);
+
+                // 结束辅助进程，下一轮重新启动
+                worker.reset();
+                deliver(result);
+                continue;
+            } else if (worker->isConnectionLost()) {
+                worker.reset();
+                continue;
+            }
+
+            if (nextIndex < numTotal) {
+                if (!worker->startScan(formatName, files[nextIndex])) {
+                    // 文件还没交给辅助进程，换一个进程重试
+                    worker.reset();
+                    launchFailures++;
+                    continue;
+                }
+                nextIndex++;
+            }
+            anyWorkerAlive = true;
+        }
+
+        if (!anyWorkerAlive && launchFailures >= maxLaunchFailures) {
+            // 剩余文件不算扫描失败的插件，下次扫描时重试
+            while (nextIndex < numTotal) {
+                FileResult result;
+                result.fileOrIdentifier = files[nextIndex++];
+                result.outcome = Outcome::Failed;
+                result.error = "辅助进程无法启动";
+                deliver(result);
+            }
+            break;
+        }
+
+        resultReady.wait(10);
+    }
+
+    // 销毁连接时结束所有辅助进程
+    workers.clear();
+    return true;
+}
+
+} // namespace WindsynthVST::AudioGraph
@@ -0,0 +1,107 @@
+//
+//  OutOfProcessPluginScanner.hpp
+//  WindsynthRecorder
+//
+//  Created by AI Assistant
+//  多进程插件扫描 - 主进程端
+//
+
+#pragma once
+
+#include <JuceHeader.h>
+#include <atomic>
+#include <functional>
+#include <mutex>
+
+namespace WindsynthVST::AudioGraph {
+
+/**
+ * 多进程插件扫描器
+ *
+ * 启动多个 WindsynthPluginScanner 辅助进程并行扫描插件文件。文件按队列逐个
+ * 分发给空闲的辅助进程，结果一产生就通过回调返回。
+ * - 辅助进程崩溃：当前文件记为 Crashed，进程重新启动后继续处理剩余文件
+ * - 单个文件超过超时时间：结束辅助进程，当前文件记为 TimedOut
+ *
+ * 找不到辅助进程可执行文件时 isAvailable() 返回false，调用方应回退到进程内扫描。
+ */
+class OutOfProcessPluginScanner {
+public:
+    /**
+     * 单个文件的扫描结果
+     */
+    enum class Outcome {
+        Scanned,    // 扫描成功
+        Failed,     // 文件中没有可用的插件或无法加载
+        Crashed,    // 辅助进程在扫描时崩溃
+        TimedOut    // 扫描超时
+    };
+
+    struct FileResult {
+        juce::String fileOrIdentifier;
+        Outcome outcome = Outcome::Failed;
+        juce::Array<juce::PluginDescription> types;
+        juce::String error;
+    };
+
+    /**
+     * 结果回调（在调用 scan() 的线程中调用）
+     * @param result 扫描结果
+     * @param numCompleted 已完成的文件数
+     * @param numTotal 文件总数
+     */
+    using ResultCallback = std::function<void(const FileResult& result, int numCompleted, int numTotal)>;
+
+    static constexpr int defaultTimeoutMs = 30000;
+
+    OutOfProcessPluginScanner();
+    ~OutOfProcessPluginScanner();
+
+    /**
+     * 设置辅助进程可执行文件（默认在应用包中查找）
+     */
+    void setWorkerExecutable(const juce::File& executable);
+    juce::File getWorkerExecutable() const;
+
+    /**
+     * 辅助进程可执行文件是否存在
+     */
+    bool isAvailable() const;
+
+    /**
+     * 设置单个文件的扫描超时时间
+     */
+    void setTimeoutMs(int timeoutMs);
+    int getTimeoutMs() const;
+
+    /**
+     * 扫描文件列表（阻塞直到完成或 shouldStop 被设置）
+     * @param formatName 插件格式名称
+     * @param files 要扫描的文件或标识符
+     * @param numWorkers 辅助进程数量
+     * @param shouldStop 停止标志
+     * @param onResult 结果回调
+     * @return 无法启动任何辅助进程时返回false（此时没有文件被扫描）
+     */
+    bool scan(const juce::String& formatName,
+              const juce::StringArray& files,
+              int numWorkers,
+              const std::atomic<bool>& shouldStop,
+              const ResultCallback& onResult);
+
+    /**
+     * 默认的辅助进程可执行文件位置（应用包 Contents/Helpers 或主程序同目录）
+     */
+    static juce::File getDefaultWorkerExecutable();
+
+private:
+    class WorkerConnection;
+
+    mutable std::mutex settingsMutex;
+    juce::File workerExecutable;
+    int timeoutMs = defaultTimeoutMs;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(OutOfProcessPluginScanner)
+};
+
+} // namespace WindsynthVST::AudioGraph
@@ -0,0 +1,388 @@
+//
+//  PluginInstancePool.cpp
+//  WindsynthRecorder
+//
+//  Created by AI Assistant
+//  插件实例池实现
+//
+
+#include "PluginInstancePool.hpp"
+#include "../Core/ProfiledPluginProcessor.hpp"
+#include "../Core/Logger.hpp"
+#include <algorithm>
+
+namespace WindsynthVST::AudioGraph {
+
+//==============================================================================
+// 构造函数和析构函数
+//==============================================================================
+
+PluginInstancePool::PluginInstancePool(ModernPluginLoader& loader)
+    : pluginLoader(loader)
+{
+}
+
+PluginInstancePool::~PluginInstancePool() {
+    aliveFlag->store(false);
+    stopTimer();
+}
+
+//==============================================================================
+// 配置
+//==============================================================================
+
+void PluginInstancePool::setMaxIdleInstances(int maxInstances) {
+    std::vector<std::unique_ptr<juce::AudioPluginInstance>> evicted;
+
+    {
+        std::lock_guard<std::mutex> lock(poolMutex);
+        maxIdleInstances = std::max(0, maxInstances);
+        trimToCapacityLocked(evicted);
+    }
+
+    WSLOG_INFO("PluginInstancePool", "空闲实例上限：" << maxInstances);
+}
+
+int PluginInstancePool::getMaxIdleInstances() const {
+    std::lock_guard<std::mutex> lock(poolMutex);
+    return maxIdleInstances;
+}
+
+void PluginInstancePool::setPrewarmList(const juce::Array<juce::PluginDescription>& descriptions,
+                                        int instancesPerPlugin,
+                                        double sampleRate,
+                                        int blockSize) {
+    juce::StringArray keys;
+
+    {
+        std::lock_guard<std::mutex> lock(poolMutex);
+        prewarmTargets.clear();
+
+        for (const auto& description : descriptions) {
+            PrewarmTarget target;
+            target.description = description;
+            target.count = std::max(1, instancesPerPlugin);
+            target.sampleRate = sampleRate;
+            target.blockSize = blockSize;
+
+            const auto key = makeKey(description);
+            prewarmTargets[key] = target;
+            keys.add(key);
+        }
+    }
+
+    WSLOG_INFO("PluginInstancePool", "设置预热列表，插件数量：" << keys.size());
+
+    for (const auto& key : keys) {
+        refillPrewarmTarget(key);
+    }
+}
+
+void PluginInstancePool::prewarm(const juce::PluginDescription& description, int count,
+                                 double sampleRate, int blockSize) {
+    startLoads(description, count, sampleRate, blockSize);
+}
+
+//==============================================================================
+// 取用和回收
+//==============================================================================
+
+std::unique_ptr<juce::AudioPluginInstance> PluginInstancePool::checkout(const juce::PluginDescription& description,
+                                                                        const juce::MemoryBlock* targetState) {
+    collectRetiredNodes();
+
+    const auto key = makeKey(description);
+    std::unique_ptr<juce::AudioPluginInstance> instance;
+
+    {
+        std::lock_guard<std::mutex> lock(poolMutex);
+
+        // 优先取最近回收的实例
+        for (auto it = idleInstances.rbegin(); it != idleInstances.rend(); ++it) {
+            if (it->key == key) {
+                instance = std::move(it->instance);
+                idleInstances.erase(std::next(it).base());
+                break;
+            }
+        }
+
+        if (instance) {
+            stats.hits++;
+        } else {
+            stats.misses++;
+        }
+    }
+
+    if (!instance) {
+        return nullptr;
+    }
+
+    const double startTime = juce::Time::getMillisecondCounterHiRes();
+    resetInstance(*instance, key, targetState);
+
+    WSLOG_INFO("PluginInstancePool", "复用插件实例：" << description.name << "，耗时 "
+            << juce::String(juce::Time::getMillisecondCounterHiRes() - startTime, 2) << " ms");
+
+    refillPrewarmTarget(key);
+    return instance;
+}
+
+void PluginInstancePool::recycle(juce::AudioProcessorGraph::Node::Ptr removedNode) {
+    if (removedNode == nullptr) {
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(poolMutex);
+        if (maxIdleInstances == 0) {
+            return;
+        }
+        retiringNodes.push_back(std::move(removedNode));
+    }
+
+    // 渲染序列通常在下一次图更新后释放旧节点
+    collectRetiredNodes();
+    startTimer(200);
+}
+
+void PluginInstancePool::recycle(std::unique_ptr<juce::AudioPluginInstance> instance) {
+    if (!instance) {
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(poolMutex);
+        if (maxIdleInstances == 0) {
+            return;
+        }
+        stats.recycled++;
+    }
+
+    const auto key = makeKey(instance->getPluginDescription());
+    addIdleInstance(key, std::move(instance));
+}
+
+void PluginInstancePool::rememberDefaultState(const juce::PluginDescription& description,
+                                              juce::AudioPluginInstance& instance) {
+    const auto key = makeKey(description);
+
+    {
+        std::lock_guard<std::mutex> lock(poolMutex);
+        if (defaultStates.find(key) != defaultStates.end()) {
+            return;
+        }
+    }
+
+    juce::MemoryBlock state;
+    instance.getStateInformation(state);
+
+    std::lock_guard<std::mutex> lock(poolMutex);
+    defaultStates.emplace(key, std::move(state));
+}
+
+void PluginInstancePool::clear() {
+    std::vector<IdleInstance> instancesToDestroy;
+    std::vector<juce::AudioProcessorGraph::Node::Ptr> nodesToRelease;
+
+    {
+        std::lock_guard<std::mutex> lock(poolMutex);
+        instancesToDestroy.swap(idleInstances);
+        nodesToRelease.swap(retiringNodes);
+        stopTimer();
+    }
+
+    WSLOG_INFO("PluginInstancePool", "清空实例池，销毁 " << instancesToDestroy.size() << " 个实例");
+}
+
+PluginInstancePool::Statistics PluginInstancePool::getStatistics() const {
+    std::lock_guard<std::mutex> lock(poolMutex);
+
+    Statistics result = stats;
+    result.idleInstances = static_cast<int>(idleInstances.size());
+    result.retiringInstances = static_cast<int>(retiringNodes.size());
+    for (const auto& [key, count] : pendingLoads) {
+        result.pendingPrewarms += count;
+    }
+    return result;
+}
+
+//==============================================================================
+// 内部方法
+//==============================================================================
+
+juce::String PluginInstancePool::makeKey(const juce::PluginDescription& description) {
+    return description.createIdentifierString();
+}
+
+void PluginInstancePool::startLoads(const juce::PluginDescription& description, int count,
+                                    double sampleRate, int blockSize) {
+    const auto key = makeKey(description);
+
+    for (int i = 0; i < count; ++i) {
+        {
+            std::lock_guard<std::mutex> lock(poolMutex);
+            pendingLoads[key]++;
+        }
+
+        pluginLoader.loadPluginAsync(description, sampleRate, blockSize,
+            [this, alive = aliveFlag, key, description](std::unique_ptr<juce::AudioPluginInstance> instance,
+                                                        const juce::String& error) {
+                if (!alive->load()) {
+                    return;
+                }
+                if (!instance) {
+                    WSLOG_ERROR("PluginInstancePool", "预热插件失败：" << description.name << " - " << error);
+                }
+                handlePrewarmLoaded(key, std::move(instance), description);
+            });
+    }
+}
+
+void PluginInstancePool::handlePrewarmLoaded(const juce::String& key,
+                                             std::unique_ptr<juce::AudioPluginInstance> instance,
+                                             const juce::PluginDescription& description) {
+    {
+        std::lock_guard<std::mutex> lock(poolMutex);
+        auto it = pendingLoads.find(key);
+        if (it != pendingLoads.end() && --it->second <= 0) {
+            pendingLoads.erase(it);
+        }
+
+        if (instance) {
+            stats.prewarmed++;
+        }
+    }
+
+    if (!instance) {
+        return;
+    }
+
+    rememberDefaultState(description, *instance);
+    addIdleInstance(key, std::move(instance));
+}
+
+void PluginInstancePool::refillPrewarmTarget(const juce::String& key) {
+    PrewarmTarget target;
+    int missing = 0;
+
+    {
+        std::lock_guard<std::mutex> lock(poolMutex);
+
+        auto it = prewarmTargets.find(key);
+        if (it == prewarmTargets.end()) {
+            return;
+        }
+        target = it->second;
+
+        const auto idle = std::count_if(idleInstances.begin(), idleInstances.end(),
+                                        [&key](const IdleInstance& entry) { return entry.key == key; });
+        const auto pending = pendingLoads.count(key) > 0 ? pendingLoads[key] : 0;
+        missing = target.count - static_cast<int>(idle) - pending;
+    }
+
+    if (missing > 0) {
+        WSLOG_INFO("PluginInstancePool", "后台预热插件：" << target.description.name << " x" << missing);
+        startLoads(target.description, missing, target.sampleRate, target.blockSize);
+    }
+}
+
+void PluginInstancePool::addIdleInstance(const juce::String& key, std::unique_ptr<juce::AudioPluginInstance> instance) {
+    // 在锁外销毁被淘汰的实例（插件析构可能较慢）
+    std::vector<std::unique_ptr<juce::AudioPluginInstance>> evicted;
+
+    std::lock_guard<std::mutex> lock(poolMutex);
+    idleInstances.push_back({key, std::move(instance)});
+    trimToCapacityLocked(evicted);
+}
+
+void PluginInstancePool::trimToCapacityLocked(std::vector<std::unique_ptr<juce::AudioPluginInstance>>& evicted) {
+    while (static_cast<int>(idleInstances.size()) > maxIdleInstances) {
+        // 优先淘汰不在预热列表中（或超出预热数量）的最旧实例
+        auto victim = idleInstances.begin();
+        std::map<juce::String, int> counts;
+        for (const auto& entry : idleInstances) {
+            counts[entry.key]++;
+        }
+
+        for (auto it = idleInstances.begin(); it != idleInstances.end(); ++it) {
+            auto target = prewarmTargets.find(it->key);
+            if (target == prewarmTargets.end() || counts[it->key] > target->second.count) {
+                victim = it;
+                break;
+            }
+        }
+
+        evicted.push_back(std::move(victim->instance));
+        idleInstances.erase(victim);
+        stats.evictions++;
+    }
+}
+
+void PluginInstancePool::collectRetiredNodes() {
+    std::vector<std::unique_ptr<juce::AudioPluginInstance>> released;
+
+    {
+        std::lock_guard<std::mutex> lock(poolMutex);
+
+        for (auto it = retiringNodes.begin(); it != retiringNodes.end();) {
+            // 仍被渲染序列引用，音频线程可能还在处理它
+            if ((*it)->getReferenceCount() > 1) {
+                ++it;
+                continue;
+            }
+
+            if (auto* profiled = dynamic_cast<ProfiledPluginProcessor*>((*it)->getProcessor())) {
+                if (auto instance = profiled->releasePluginInstance()) {
+                    released.push_back(std::move(instance));
+                }
+            }
+            it = retiringNodes.erase(it);
+        }
+
+        stats.recycled += released.size();
+    }
+
+    for (auto& instance : released) {
+        const auto key = makeKey(instance->getPluginDescription());
+        addIdleInstance(key, std::move(instance));
+    }
+}
+
+void PluginInstancePool::resetInstance(juce::AudioPluginInstance& instance, const juce::String& key,
+                                       const juce::MemoryBlock* targetState) {
+    // 清空延迟线、混响尾音等处理状态
+    instance.reset();
+
+    juce::MemoryBlock defaultState;
+    if (targetState == nullptr) {
+        std::lock_guard<std::mutex> lock(poolMutex);
+        auto it = defaultStates.find(key);
+        if (it != defaultStates.end()) {
+            defaultState = it->second;
+            targetState = &defaultState;
+        }
+    }
+
+    if (targetState != nullptr && targetState->getSize() > 0) {
+        instance.setStateInformation(targetState->getData(), static_cast<int>(targetState->getSize()));
+        return;
+    }
+
+    // 没有记录默认状态时，把参数恢复为默认值
+    for (auto* parameter : instance.getParameters()) {
+        if (parameter != nullptr) {
+            parameter->setValue(parameter->getDefaultValue());
+        }
+    }
+}
+
+void PluginInstancePool::timerCallback() {
+    collectRetiredNodes();
+
+    std::lock_guard<std::mutex> lock(poolMutex);
+    if (retiringNodes.empty()) {
+        stopTimer();
+    }
+}
+
+} // namespace WindsynthVST::AudioGraph
@@ -0,0 +1,163 @@
+//
+//  PluginInstancePool.hpp
+//  WindsynthRecorder
+//
+//  Created by AI Assistant
+//  插件实例池 - 预先实例化和复用插件实例
+//
+
+#pragma once
+
+#include <JuceHeader.h>
+#include <atomic>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <vector>
+#include <cstdint>
+#include "ModernPluginLoader.hpp"
+
+namespace WindsynthVST::AudioGraph {
+
+/**
+ * 插件实例池
+ *
+ * 大型合成器和采样器实例化需要数秒。实例池：
+ * - 在后台为预热列表中的插件预先创建实例，被取走后自动补充
+ * - 回收从图中移除的插件实例，保持已准备状态以便复用
+ * - 取出时清空处理状态，并恢复到默认状态或指定的目标状态
+ *
+ * 空闲实例超过上限时淘汰最久未使用的实例。
+ * 节点移除后可能仍被正在运行的渲染序列引用，回收时等到只剩实例池持有引用才取出插件。
+ */
+class PluginInstancePool : private juce::Timer {
+public:
+    /**
+     * 实例池统计
+     */
+    struct Statistics {
+        int idleInstances = 0;          // 可立即取用的实例
+        int retiringInstances = 0;      // 等待渲染序列释放的节点
+        int pendingPrewarms = 0;        // 正在后台创建的实例
+        uint64_t hits = 0;              // 从池中取用的次数
+        uint64_t misses = 0;            // 池中没有可用实例的次数
+        uint64_t prewarmed = 0;         // 预先创建的实例数
+        uint64_t recycled = 0;          // 回收的实例数
+        uint64_t evictions = 0;         // 因超过上限被销毁的实例数
+    };
+
+    static constexpr int defaultMaxIdleInstances = 8;
+
+    explicit PluginInstancePool(ModernPluginLoader& pluginLoader);
+    ~PluginInstancePool() override;
+
+    //==============================================================================
+    // 配置
+    //==============================================================================
+
+    /**
+     * 设置空闲实例上限（0表示禁用实例池）
+     */
+    void setMaxIdleInstances(int maxInstances);
+    int getMaxIdleInstances() const;
+
+    /**
+     * 设置预热列表：列表中的每个插件始终保持 instancesPerPlugin 个空闲实例
+     * @param descriptions 插件描述
+     * @param instancesPerPlugin 每个插件的实例数
+     * @param sampleRate 创建实例使用的采样率
+     * @param blockSize 创建实例使用的缓冲区大小
+     */
+    void setPrewarmList(const juce::Array<juce::PluginDescription>& descriptions,
+                        int instancesPerPlugin,
+                        double sampleRate,
+                        int blockSize);
+
+    /**
+     * 在后台预先创建插件实例（不加入预热列表，取走后不补充）
+     */
+    void prewarm(const juce::PluginDescription& description, int count, double sampleRate, int blockSize);
+
+    //==============================================================================
+    // 取用和回收
+    //==============================================================================
+
+    /**
+     * 取出一个空闲实例
+     * @param description 插件描述
+     * @param targetState 要恢复的状态（nullptr表示恢复到默认状态）
+     * @return 池中没有该插件的实例时返回nullptr
+     */
+    std::unique_ptr<juce::AudioPluginInstance> checkout(const juce::PluginDescription& description,
+                                                        const juce::MemoryBlock* targetState = nullptr);
+
+    /**
+     * 回收从图中移除的节点（渲染序列释放节点后取出插件实例）
+     */
+    void recycle(juce::AudioProcessorGraph::Node::Ptr removedNode);
+
+    /**
+     * 回收插件实例
+     */
+    void recycle(std::unique_ptr<juce::AudioPluginInstance> instance);
+
+    /**
+     * 记录插件的默认状态（每个插件只记录一次，应在刚创建的实例上调用）
+     */
+    void rememberDefaultState(const juce::PluginDescription& description, juce::AudioPluginInstance& instance);
+
+    /**
+     * 销毁所有空闲实例
+     */
+    void clear();
+
+    /**
+     * 获取统计信息
+     */
+    Statistics getStatistics() const;
+
+private:
+    struct IdleInstance {
+        juce::String key;
+        std::unique_ptr<juce::AudioPluginInstance> instance;
+    };
+
+    struct PrewarmTarget {
+        juce::PluginDescription description;
+        int count = 1;
+        double sampleRate = 44100.0;
+        int blockSize = 512;
+    };
+
+    ModernPluginLoader& pluginLoader;
+
+    mutable std::mutex poolMutex;
+    std::vector<IdleInstance> idleInstances;                        // 最近使用的在后
+    std::vector<juce::AudioProcessorGraph::Node::Ptr> retiringNodes;
+    std::map<juce::String, juce::MemoryBlock> defaultStates;
+    std::map<juce::String, PrewarmTarget> prewarmTargets;
+    std::map<juce::String, int> pendingLoads;
+    int maxIdleInstances = defaultMaxIdleInstances;
+    Statistics stats;
+
+    // 异步加载回调可能晚于实例池销毁
+    std::shared_ptr<std::atomic<bool>> aliveFlag = std::make_shared<std::atomic<bool>>(true);
+
+    static juce::String makeKey(const juce::PluginDescription& description);
+
+    void startLoads(const juce::PluginDescription& description, int count, double sampleRate, int blockSize);
+    void handlePrewarmLoaded(const juce::String& key, std::unique_ptr<juce::AudioPluginInstance> instance,
+                             const juce::PluginDescription& description);
+    void refillPrewarmTarget(const juce::String& key);
+    void addIdleInstance(const juce::String& key, std::unique_ptr<juce::AudioPluginInstance> instance);
+    void trimToCapacityLocked(std::vector<std::unique_ptr<juce::AudioPluginInstance>>& evicted);
+    void collectRetiredNodes();
+    void resetInstance(juce::AudioPluginInstance& instance, const juce::String& key,
+                       const juce::MemoryBlock* targetState);
+
+    void timerCallback() override;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(PluginInstancePool)
+};
+
+} // namespace WindsynthVST::AudioGraph
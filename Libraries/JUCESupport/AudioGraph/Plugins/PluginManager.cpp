@@ -7,11 +7,29 @@
 //
 
 #include "PluginManager.hpp"
-#include <iostream>
+#include "../Core/Logger.hpp"
 #include <algorithm>
+#include <atomic>
 
 namespace WindsynthVST::AudioGraph {
 
+//==============================================================================
+// 图召回状态
+//==============================================================================
+
+struct PluginManager::RecallOperation {
+    GraphRecallRequest request;
+    GraphRecallCallback callback;
+    
+    // 与 request.plugins 一一对应
+    std::vector<NodeID> reusedNodes;                                    // uid为0表示需要新实例
+    std::vector<std::unique_ptr<juce::AudioPluginInstance>> instances;
+    
+    std::mutex mutex;                       // 保护 instances 和 errors
+    std::vector<std::string> errors;
+    std::atomic<int> pendingLoads{1};       // 额外的1在所有加载发出后释放，保证只完成一次
+};
+
 //==============================================================================
 // 自定义编辑器窗口类，支持正确的关闭行为
 //==============================================================================
@@ -27,7 +45,7 @@ public:
     }
 
     void closeButtonPressed() override {
-        // std::cout << "[PluginEditorWindow] 关闭按钮被按下，节点ID: " << pluginNodeID.uid << std::endl;
+        // WSLOG_INFO("PluginEditorWindow", "关闭按钮被按下，节点ID: " << pluginNodeID.uid);
 
         // 通知插件管理器关闭这个编辑器
         if (pluginManager) {
@@ -36,7 +54,7 @@ public:
     }
 
     void userTriedToCloseWindow() override {
-        // std::cout << "[PluginEditorWindow] 用户尝试关闭窗口，节点ID: " << pluginNodeID.uid << std::endl;
+        // WSLOG_INFO("PluginEditorWindow", "用户尝试关闭窗口，节点ID: " << pluginNodeID.uid);
         closeButtonPressed();
     }
 
@@ -52,13 +70,14 @@ private:
 //==============================================================================
 
 PluginManager::PluginManager(GraphAudioProcessor& graphProcessor, ModernPluginLoader& pluginLoader)
-    : graphProcessor(graphProcessor), pluginLoader(pluginLoader)
+    : graphProcessor(graphProcessor), pluginLoader(pluginLoader),
+      instancePool(std::make_unique<PluginInstancePool>(pluginLoader))
 {
-    std::cout << "[PluginManager] 初始化插件管理器" << std::endl;
+    WSLOG_INFO("PluginManager", "初始化插件管理器");
 }
 
 PluginManager::~PluginManager() {
-    std::cout << "[PluginManager] 析构插件管理器" << std::endl;
+    WSLOG_INFO("PluginManager", "析构插件管理器");
 }
 
 //==============================================================================
@@ -68,85 +87,284 @@ PluginManager::~PluginManager() {
 void PluginManager::loadPluginAsync(const juce::PluginDescription& description,
                                    const std::string& displayName,
                                    std::function<void(NodeID nodeID, const std::string& error)> callback) {
-    std::cout << "[PluginManager] 异步加载插件：" << description.name << std::endl;
+    loadPluginWithStateAsync(description, juce::MemoryBlock(), displayName, std::move(callback));
+}
+
+void PluginManager::loadPluginWithStateAsync(const juce::PluginDescription& description,
+                                            const juce::MemoryBlock& state,
+                                            const std::string& displayName,
+                                            std::function<void(NodeID nodeID, const std::string& error)> callback) {
+    WSLOG_INFO("PluginManager", "异步加载插件：" << description.name);
     
     std::string finalDisplayName = displayName.empty() ? description.name.toStdString() : displayName;
     
-    pluginLoader.loadPluginAsync(description, 
+    createPluginInstanceAsync(description, state,
+        [this, description, finalDisplayName, callback](std::unique_ptr<juce::AudioPluginInstance> instance,
+                                                        const std::string& error) {
+            if (instance) {
+                insertPluginInstance(std::move(instance), description, finalDisplayName, callback);
+            } else {
+                notifyPluginError(NodeID{0}, error);
+                
+                if (callback) {
+                    callback(NodeID{0}, error);
+                }
+            }
+        });
+}
+
+void PluginManager::createPluginInstanceAsync(const juce::PluginDescription& description,
+                                             const juce::MemoryBlock& state,
+                                             PluginInstanceCallback callback) {
+    // 实例池中有空闲实例时直接使用，不需要重新实例化
+    if (auto pooled = instancePool->checkout(description, state.getSize() > 0 ? &state : nullptr)) {
+        if (callback) {
+            callback(std::move(pooled), "");
+        }
+        return;
+    }
+    
+    pluginLoader.loadPluginAsync(description,
                                 graphProcessor.getConfig().sampleRate,
                                 graphProcessor.getConfig().samplesPerBlock,
-        [this, description, finalDisplayName, callback](std::unique_ptr<juce::AudioPluginInstance> instance, 
-                                                        const juce::String& error) {
+        [this, description, state, callback](std::unique_ptr<juce::AudioPluginInstance> instance,
+                                             const juce::String& error) {
             if (instance) {
-                // 添加到图中
-                NodeID nodeID = graphProcessor.addPlugin(std::move(instance), finalDisplayName);
+                // 记录刚创建时的状态，实例被回收复用时恢复到这个状态
+                instancePool->rememberDefaultState(description, *instance);
                 
-                if (nodeID.uid != 0) {
-                    handlePluginLoaded(nodeID, nullptr, finalDisplayName, description);
-                    
-                    if (callback) {
-                        callback(nodeID, "");
-                    }
-                } else {
-                    std::string errorMsg = "无法添加插件到音频图";
-                    notifyPluginError(NodeID{0}, errorMsg);
-                    
-                    if (callback) {
-                        callback(NodeID{0}, errorMsg);
+                if (state.getSize() > 0) {
+                    instance->setStateInformation(state.getData(), static_cast<int>(state.getSize()));
+                }
+            }
+            
+            if (callback) {
+                const std::string errorMsg = instance ? std::string() : error.toStdString();
+                callback(std::move(instance), errorMsg);
+            }
+        });
+}
+
+void PluginManager::recallGraphAsync(GraphRecallRequest request, GraphRecallCallback callback) {
+    WSLOG_INFO("PluginManager", "召回插件图，插件数量：" << request.plugins.size());
+    
+    auto operation = std::make_shared<RecallOperation>();
+    operation->request = std::move(request);
+    operation->callback = std::move(callback);
+    
+    const auto& plugins = operation->request.plugins;
+    operation->reusedNodes.resize(plugins.size());
+    operation->instances.resize(plugins.size());
+    
+    // 按描述把图中现有的插件分配给召回的插件，每个现有插件最多复用一次
+    {
+        std::vector<std::pair<NodeID, juce::String>> available;
+        {
+            std::lock_guard<std::mutex> lock(pluginsMutex);
+            for (const auto& pair : pluginInstances) {
+                available.emplace_back(pair.first, pair.second.description.createIdentifierString());
+            }
+        }
+        std::sort(available.begin(), available.end(),
+                  [](const auto& a, const auto& b) { return a.first.uid < b.first.uid; });
+        
+        for (size_t i = 0; i < plugins.size(); ++i) {
+            const auto identifier = plugins[i].description.createIdentifierString();
+            auto match = std::find_if(available.begin(), available.end(),
+                                      [&identifier](const auto& entry) { return entry.second == identifier; });
+            if (match != available.end()) {
+                operation->reusedNodes[i] = match->first;
+                available.erase(match);
+            }
+        }
+    }
+    
+    // 需要新实例的插件同时开始加载
+    std::vector<size_t> loads;
+    for (size_t i = 0; i < plugins.size(); ++i) {
+        if (operation->reusedNodes[i].uid == 0) {
+            loads.push_back(i);
+        }
+    }
+    
+    WSLOG_INFO("PluginManager", "复用插件：" << (plugins.size() - loads.size())
+            << "，新加载插件：" << loads.size());
+    
+    operation->pendingLoads.fetch_add(static_cast<int>(loads.size()));
+    
+    for (auto index : loads) {
+        createPluginInstanceAsync(plugins[index].description, plugins[index].state,
+            [this, operation, index](std::unique_ptr<juce::AudioPluginInstance> instance, const std::string& error) {
+                {
+                    std::lock_guard<std::mutex> lock(operation->mutex);
+                    if (instance) {
+                        operation->instances[index] = std::move(instance);
+                    } else {
+                        operation->errors.push_back(operation->request.plugins[index].description.name.toStdString()
+                                                    + ": " + error);
                     }
                 }
-            } else {
-                std::string errorMsg = error.toStdString();
-                notifyPluginError(NodeID{0}, errorMsg);
                 
-                if (callback) {
-                    callback(NodeID{0}, errorMsg);
+                if (operation->pendingLoads.fetch_sub(1) == 1) {
+                    finishRecall(operation);
                 }
-            }
-        });
+            });
+    }
+    
+    if (operation->pendingLoads.fetch_sub(1) == 1) {
+        finishRecall(operation);
+    }
 }
 
-bool PluginManager::removePlugin(NodeID nodeID) {
-    std::cout << "[PluginManager] 移除插件：" << nodeID.uid << std::endl;
+void PluginManager::finishRecall(const std::shared_ptr<RecallOperation>& operation) {
+    const auto& plugins = operation->request.plugins;
+    
+    std::vector<GraphAudioProcessor::RecallNode> recallNodes;
+    recallNodes.reserve(plugins.size());
     
     {
-        std::lock_guard<std::mutex> lock(pluginsMutex);
-        auto it = pluginInstances.find(nodeID);
-        if (it == pluginInstances.end()) {
-            std::cout << "[PluginManager] 插件不存在：" << nodeID.uid << std::endl;
-            return false;
+        std::lock_guard<std::mutex> lock(operation->mutex);
+        
+        for (size_t i = 0; i < plugins.size(); ++i) {
+            const auto& entry = plugins[i];
+            
+            GraphAudioProcessor::RecallNode recallNode;
+            recallNode.sourceUID = entry.presetNodeUID;
+            recallNode.name = entry.displayName;
+            recallNode.bypassed = entry.bypassed || !entry.enabled;
+            
+            if (operation->reusedNodes[i].uid != 0) {
+                // 复用的实例在切换前恢复状态，仍在处理音频的插件由自身保证状态恢复的线程安全
+                if (entry.state.getSize() > 0) {
+                    setPluginState(operation->reusedNodes[i], entry.state);
+                }
+                recallNode.existingNodeID = operation->reusedNodes[i];
+            } else if (operation->instances[i]) {
+                recallNode.instance = std::move(operation->instances[i]);
+            } else {
+                continue;
+            }
+            
+            recallNodes.push_back(std::move(recallNode));
         }
     }
     
-    // 从图中移除
-    bool success = graphProcessor.removeNode(nodeID);
+    std::vector<juce::AudioProcessorGraph::Node::Ptr> removedNodes;
+    auto resolvedIDs = graphProcessor.recallGraph(recallNodes, operation->request.connections,
+                                                  operation->request.ioNodes, removedNodes);
     
-    if (success) {
-        // 清理内部数据
-        {
-            std::lock_guard<std::mutex> lock(pluginsMutex);
-            pluginInstances.erase(nodeID);
+    for (auto& removedNode : removedNodes) {
+        const auto nodeID = removedNode->nodeID;
+        forgetPlugin(nodeID, std::move(removedNode));
+    }
+    
+    for (size_t i = 0; i < plugins.size(); ++i) {
+        const auto& entry = plugins[i];
+        auto resolved = resolvedIDs.find(entry.presetNodeUID);
+        if (resolved == resolvedIDs.end()) {
+            continue;
         }
         
-        {
-            std::lock_guard<std::mutex> lock(presetsMutex);
-            pluginPresets.erase(nodeID);
+        if (operation->reusedNodes[i].uid == 0) {
+            handlePluginLoaded(resolved->second, nullptr, entry.displayName, entry.description);
         }
         
-        {
-            std::lock_guard<std::mutex> lock(performanceMutex);
-            cpuUsageMap.erase(nodeID);
+        std::lock_guard<std::mutex> lock(pluginsMutex);
+        auto it = pluginInstances.find(resolved->second);
+        if (it != pluginInstances.end()) {
+            it->second.displayName = entry.displayName;
+            it->second.enabled = entry.enabled;
+            it->second.bypassed = entry.bypassed;
         }
+    }
+    
+    std::string errorMsg;
+    for (const auto& error : operation->errors) {
+        errorMsg += (errorMsg.empty() ? "" : "; ") + error;
+    }
+    if (!errorMsg.empty()) {
+        notifyPluginError(NodeID{0}, errorMsg);
+    }
+    
+    WSLOG_INFO("PluginManager", "插件图召回完成，节点数量：" << resolvedIDs.size());
+    
+    if (operation->callback) {
+        operation->callback(errorMsg.empty(), errorMsg);
+    }
+}
 
-        // 清理编辑器窗口
-        hideEditor(nodeID);
+void PluginManager::insertPluginInstance(std::unique_ptr<juce::AudioPluginInstance> instance,
+                                        const juce::PluginDescription& description,
+                                        const std::string& displayName,
+                                        const std::function<void(NodeID nodeID, const std::string& error)>& callback) {
+    // 添加到图中
+    NodeID nodeID = graphProcessor.addPlugin(std::move(instance), displayName);
+    
+    if (nodeID.uid != 0) {
+        handlePluginLoaded(nodeID, nullptr, displayName, description);
+        
+        if (callback) {
+            callback(nodeID, "");
+        }
+    } else {
+        std::string errorMsg = "无法添加插件到音频图";
+        notifyPluginError(NodeID{0}, errorMsg);
+        
+        if (callback) {
+            callback(NodeID{0}, errorMsg);
+        }
+    }
+}
 
-        notifyPluginRemoved(nodeID);
+bool PluginManager::removePlugin(NodeID nodeID) {
+    WSLOG_INFO("PluginManager", "移除插件：" << nodeID.uid);
+    
+    {
+        std::lock_guard<std::mutex> lock(pluginsMutex);
+        auto it = pluginInstances.find(nodeID);
+        if (it == pluginInstances.end()) {
+            WSLOG_INFO("PluginManager", "插件不存在：" << nodeID.uid);
+            return false;
+        }
+    }
+    
+    // 从图中移除（节点交给实例池回收）
+    auto removedNode = graphProcessor.detachNode(nodeID);
+    bool success = removedNode != nullptr;
+    
+    if (success) {
+        forgetPlugin(nodeID, std::move(removedNode));
     }
     
     return success;
 }
 
+void PluginManager::forgetPlugin(NodeID nodeID, juce::AudioProcessorGraph::Node::Ptr removedNode) {
+    // 清理内部数据
+    {
+        std::lock_guard<std::mutex> lock(pluginsMutex);
+        pluginInstances.erase(nodeID);
+    }
+    
+    {
+        std::lock_guard<std::mutex> lock(presetsMutex);
+        pluginPresets.erase(nodeID);
+    }
+    
+    {
+        std::lock_guard<std::mutex> lock(performanceMutex);
+        cpuUsageMap.erase(nodeID);
+    }
+
+    // 清理编辑器窗口
+    hideEditor(nodeID);
+
+    // 编辑器关闭后再回收，实例保持已准备状态以便下次快速插入
+    instancePool->recycle(std::move(removedNode));
+
+    notifyPluginRemoved(nodeID);
+}
+
 std::vector<PluginManager::PluginInstanceInfo> PluginManager::getAllPlugins() const {
     std::lock_guard<std::mutex> lock(pluginsMutex);
     
@@ -173,11 +391,11 @@ juce::AudioPluginInstance* PluginManager::getPluginInstance(NodeID nodeID) const
         return nullptr;
     }
     
-    return dynamic_cast<juce::AudioPluginInstance*>(node->getProcessor());
+    return getHostedPluginInstance(node->getProcessor());
 }
 
 bool PluginManager::setPluginEnabled(NodeID nodeID, bool enabled) {
-    std::cout << "[PluginManager] 设置插件启用状态：" << nodeID.uid << " -> " << enabled << std::endl;
+    WSLOG_INFO("PluginManager", "设置插件启用状态：" << nodeID.uid << " -> " << enabled);
     
     std::lock_guard<std::mutex> lock(pluginsMutex);
     auto it = pluginInstances.find(nodeID);
@@ -192,7 +410,7 @@ bool PluginManager::setPluginEnabled(NodeID nodeID, bool enabled) {
 }
 
 bool PluginManager::setPluginBypassed(NodeID nodeID, bool bypassed) {
-    std::cout << "[PluginManager] 设置插件旁路状态：" << nodeID.uid << " -> " << bypassed << std::endl;
+    WSLOG_INFO("PluginManager", "设置插件旁路状态：" << nodeID.uid << " -> " << bypassed);
     
     std::lock_guard<std::mutex> lock(pluginsMutex);
     auto it = pluginInstances.find(nodeID);
@@ -205,7 +423,7 @@ bool PluginManager::setPluginBypassed(NodeID nodeID, bool bypassed) {
 }
 
 bool PluginManager::renamePlugin(NodeID nodeID, const std::string& newName) {
-    std::cout << "[PluginManager] 重命名插件：" << nodeID.uid << " -> " << newName << std::endl;
+    WSLOG_INFO("PluginManager", "重命名插件：" << nodeID.uid << " -> " << newName);
     
     std::lock_guard<std::mutex> lock(pluginsMutex);
     auto it = pluginInstances.find(nodeID);
@@ -224,28 +442,27 @@ bool PluginManager::renamePlugin(NodeID nodeID, const std::string& newName) {
 std::vector<PluginManager::ParameterInfo> PluginManager::getPluginParameters(NodeID nodeID) const {
     std::vector<ParameterInfo> parameters;
 
-    auto* instance = getPluginInstance(nodeID);
-    if (!instance) {
+    auto metadata = getParameterMetadata(nodeID);
+    if (!metadata) {
         return parameters;
     }
 
-    // 使用现代JUCE参数API
-    auto& parameterArray = instance->getParameters();
-    parameters.reserve(parameterArray.size());
+    std::vector<float> values(metadata->size());
+    copyParameterValues(nodeID, values.data(), static_cast<int>(values.size()));
+    parameters.reserve(metadata->size());
 
-    for (int i = 0; i < parameterArray.size(); ++i) {
-        auto* param = parameterArray[i];
-        if (!param) continue;
+    for (size_t i = 0; i < metadata->size(); ++i) {
+        const auto& entry = (*metadata)[i];
 
         ParameterInfo paramInfo;
-        paramInfo.index = i;
-        paramInfo.name = param->getName(256).toStdString();
-        paramInfo.label = param->getLabel().toStdString();
-        paramInfo.value = param->getValue();
-        paramInfo.defaultValue = param->getDefaultValue();
-        paramInfo.isAutomatable = true;
-        paramInfo.isDiscrete = param->isDiscrete();
-        paramInfo.numSteps = param->getNumSteps();
+        paramInfo.index = static_cast<int>(i);
+        paramInfo.name = entry.name;
+        paramInfo.label = entry.label;
+        paramInfo.value = values[i];
+        paramInfo.defaultValue = entry.defaultValue;
+        paramInfo.isAutomatable = entry.isAutomatable;
+        paramInfo.isDiscrete = entry.isDiscrete;
+        paramInfo.numSteps = entry.numSteps;
 
         parameters.push_back(paramInfo);
     }
@@ -254,6 +471,10 @@ std::vector<PluginManager::ParameterInfo> PluginManager::getPluginParameters(Nod
 }
 
 float PluginManager::getParameterValue(NodeID nodeID, int parameterIndex) const {
+    if (auto* wrapper = getNodeWrapper(nodeID)) {
+        return wrapper->getParameterCache().getValue(parameterIndex);
+    }
+
     auto* instance = getPluginInstance(nodeID);
     if (!instance) {
         return 0.0f;
@@ -268,25 +489,60 @@ float PluginManager::getParameterValue(NodeID nodeID, int parameterIndex) const
     return param ? param->getValue() : 0.0f;
 }
 
+std::shared_ptr<const ParameterCache::MetadataList> PluginManager::getParameterMetadata(NodeID nodeID) const {
+    if (auto* wrapper = getNodeWrapper(nodeID)) {
+        return wrapper->getParameterCache().getMetadata();
+    }
+    return nullptr;
+}
+
+int PluginManager::copyParameterValues(NodeID nodeID, float* destination, int maxCount) const {
+    if (auto* wrapper = getNodeWrapper(nodeID)) {
+        return wrapper->getParameterCache().copyValues(destination, maxCount);
+    }
+    return 0;
+}
+
 bool PluginManager::setParameterValue(NodeID nodeID, int parameterIndex, float value) {
-    auto* instance = getPluginInstance(nodeID);
+    ParameterEvent event;
+    event.parameterIndex = parameterIndex;
+    event.value = value;
+    return setParameterValues(nodeID, { event }) > 0;
+}
+
+int PluginManager::setParameterValues(NodeID nodeID, const std::vector<ParameterEvent>& events) {
+    auto* node = graphProcessor.getGraph().getNodeForId(nodeID);
+    auto* instance = node != nullptr ? getHostedPluginInstance(node->getProcessor()) : nullptr;
     if (!instance) {
-        return false;
+        return 0;
     }
 
-    auto& params = instance->getParameters();
-    if (parameterIndex < 0 || parameterIndex >= params.size()) {
-        return false;
+    const int numParameters = instance->getParameters().size();
+    std::vector<ParameterEvent> validEvents;
+    validEvents.reserve(events.size());
+    for (const auto& event : events) {
+        if (event.parameterIndex >= 0 && event.parameterIndex < numParameters) {
+            validEvents.push_back(event);
+        }
     }
 
-    auto* param = params[parameterIndex];
-    if (param) {
-        param->setValue(value);
-        notifyParameterChanged(nodeID, parameterIndex, value);
-        return true;
+    int numQueued = 0;
+    if (auto* profiled = getNodeWrapper(nodeID)) {
+        numQueued = profiled->queueParameterChanges(validEvents);
+    } else {
+        for (const auto& event : validEvents) {
+            if (auto* param = instance->getParameters()[event.parameterIndex]) {
+                param->setValue(event.value);
+                numQueued++;
+            }
+        }
     }
 
-    return false;
+    for (size_t i = 0; i < static_cast<size_t>(numQueued); ++i) {
+        notifyParameterChanged(nodeID, validEvents[i].parameterIndex, validEvents[i].value);
+    }
+
+    return numQueued;
 }
 
 std::string PluginManager::getParameterText(NodeID nodeID, int parameterIndex) const {
@@ -305,7 +561,7 @@ std::string PluginManager::getParameterText(NodeID nodeID, int parameterIndex) c
 }
 
 bool PluginManager::resetParametersToDefault(NodeID nodeID) {
-    std::cout << "[PluginManager] 重置插件参数到默认值：" << nodeID.uid << std::endl;
+    WSLOG_INFO("PluginManager", "重置插件参数到默认值：" << nodeID.uid);
 
     auto* instance = getPluginInstance(nodeID);
     if (!instance) {
@@ -313,15 +569,18 @@ bool PluginManager::resetParametersToDefault(NodeID nodeID) {
     }
 
     auto& params = instance->getParameters();
+    std::vector<ParameterEvent> events;
+    events.reserve(static_cast<size_t>(params.size()));
     for (int i = 0; i < params.size(); ++i) {
-        auto* param = params[i];
-        if (param) {
-            float defaultValue = param->getDefaultValue();
-            param->setValue(defaultValue);
-            notifyParameterChanged(nodeID, i, defaultValue);
+        if (auto* param = params[i]) {
+            ParameterEvent event;
+            event.parameterIndex = i;
+            event.value = param->getDefaultValue();
+            events.push_back(event);
         }
     }
 
+    setParameterValues(nodeID, events);
     return true;
 }
 
@@ -330,16 +589,16 @@ bool PluginManager::resetParametersToDefault(NodeID nodeID) {
 //==============================================================================
 
 bool PluginManager::showEditor(NodeID nodeID) {
-    std::cout << "[PluginManager] 显示插件编辑器：" << nodeID.uid << std::endl;
+    WSLOG_INFO("PluginManager", "显示插件编辑器：" << nodeID.uid);
 
     auto* instance = getPluginInstance(nodeID);
     if (!instance) {
-        std::cout << "[PluginManager] 插件实例不存在：" << nodeID.uid << std::endl;
+        WSLOG_INFO("PluginManager", "插件实例不存在：" << nodeID.uid);
         return false;
     }
 
     if (!instance->hasEditor()) {
-        std::cout << "[PluginManager] 插件没有编辑器界面：" << nodeID.uid << std::endl;
+        WSLOG_INFO("PluginManager", "插件没有编辑器界面：" << nodeID.uid);
         return false;
     }
 
@@ -356,7 +615,7 @@ bool PluginManager::showEditor(NodeID nodeID) {
     // 创建编辑器
     auto* editor = instance->createEditor();
     if (!editor) {
-        std::cout << "[PluginManager] 无法创建编辑器：" << nodeID.uid << std::endl;
+        WSLOG_INFO("PluginManager", "无法创建编辑器：" << nodeID.uid);
         return false;
     }
 
@@ -382,14 +641,14 @@ bool PluginManager::showEditor(NodeID nodeID) {
         // 存储窗口
         editorWindows[nodeID] = std::move(window);
 
-        std::cout << "[PluginManager] 编辑器窗口已创建：" << nodeID.uid << std::endl;
+        WSLOG_INFO("PluginManager", "编辑器窗口已创建：" << nodeID.uid);
     });
 
     return true;
 }
 
 bool PluginManager::hideEditor(NodeID nodeID) {
-    // std::cout << "[PluginManager] 隐藏插件编辑器：" << nodeID.uid << std::endl;
+    // WSLOG_INFO("PluginManager", "隐藏插件编辑器：" << nodeID.uid);
 
     std::unique_ptr<juce::DocumentWindow> windowToClose;
 
@@ -412,7 +671,7 @@ bool PluginManager::hideEditor(NodeID nodeID) {
             window.reset();
         });
 
-        // std::cout << "[PluginManager] 编辑器窗口已关闭：" << nodeID.uid << std::endl;
+        // WSLOG_INFO("PluginManager", "编辑器窗口已关闭：" << nodeID.uid);
         return true;
     }
 
@@ -431,7 +690,7 @@ bool PluginManager::isEditorVisible(NodeID nodeID) const {
 //==============================================================================
 
 bool PluginManager::savePreset(NodeID nodeID, const std::string& presetName) {
-    std::cout << "[PluginManager] 保存插件预设：" << nodeID.uid << " -> " << presetName << std::endl;
+    WSLOG_INFO("PluginManager", "保存插件预设：" << nodeID.uid << " -> " << presetName);
     
     juce::MemoryBlock stateData;
     if (!getPluginState(nodeID, stateData)) {
@@ -445,7 +704,7 @@ bool PluginManager::savePreset(NodeID nodeID, const std::string& presetName) {
 }
 
 bool PluginManager::loadPreset(NodeID nodeID, const std::string& presetName) {
-    std::cout << "[PluginManager] 加载插件预设：" << nodeID.uid << " -> " << presetName << std::endl;
+    WSLOG_INFO("PluginManager", "加载插件预设：" << nodeID.uid << " -> " << presetName);
     
     std::lock_guard<std::mutex> lock(presetsMutex);
     
@@ -463,7 +722,7 @@ bool PluginManager::loadPreset(NodeID nodeID, const std::string& presetName) {
 }
 
 bool PluginManager::deletePreset(NodeID nodeID, const std::string& presetName) {
-    std::cout << "[PluginManager] 删除插件预设：" << nodeID.uid << " -> " << presetName << std::endl;
+    WSLOG_INFO("PluginManager", "删除插件预设：" << nodeID.uid << " -> " << presetName);
     
     std::lock_guard<std::mutex> lock(presetsMutex);
     
@@ -492,7 +751,7 @@ std::vector<std::string> PluginManager::getPresetNames(NodeID nodeID) const {
 }
 
 bool PluginManager::exportPreset(NodeID nodeID, const std::string& presetName, const juce::File& file) const {
-    std::cout << "[PluginManager] 导出预设：" << presetName << " 到 " << file.getFullPathName() << std::endl;
+    WSLOG_INFO("PluginManager", "导出预设：" << presetName << " 到 " << file.getFullPathName());
     
     std::lock_guard<std::mutex> lock(presetsMutex);
     
@@ -510,7 +769,7 @@ bool PluginManager::exportPreset(NodeID nodeID, const std::string& presetName, c
 }
 
 bool PluginManager::importPreset(NodeID nodeID, const std::string& presetName, const juce::File& file) {
-    std::cout << "[PluginManager] 导入预设：" << presetName << " 从 " << file.getFullPathName() << std::endl;
+    WSLOG_INFO("PluginManager", "导入预设：" << presetName << " 从 " << file.getFullPathName());
     
     if (!file.existsAsFile()) {
         return false;
@@ -548,9 +807,17 @@ bool PluginManager::setPluginState(NodeID nodeID, const juce::MemoryBlock& state
     }
 
     instance->setStateInformation(stateData.getData(), static_cast<int>(stateData.getSize()));
+    if (auto* wrapper = getNodeWrapper(nodeID)) {
+        wrapper->invalidateParameterValues();
+    }
     return true;
 }
 
+uint32_t PluginManager::getPluginStateGeneration(NodeID nodeID) const {
+    auto* wrapper = getNodeWrapper(nodeID);
+    return wrapper != nullptr ? wrapper->getStateGeneration() : 0;
+}
+
 //==============================================================================
 // 性能监控实现
 //==============================================================================
@@ -634,7 +901,7 @@ int PluginManager::getTotalLatency() const {
 
 void PluginManager::handlePluginLoaded(NodeID nodeID, std::unique_ptr<juce::AudioPluginInstance> instance,
                                       const std::string& displayName, const juce::PluginDescription& description) {
-    std::cout << "[PluginManager] 处理插件加载完成：" << displayName << std::endl;
+    WSLOG_INFO("PluginManager", "处理插件加载完成：" << displayName);
 
     // 创建插件实例信息
     PluginInstanceInfo info(nodeID, displayName, description);
@@ -673,6 +940,11 @@ void PluginManager::notifyPluginRemoved(NodeID nodeID) {
     }
 }
 
+ProfiledPluginProcessor* PluginManager::getNodeWrapper(NodeID nodeID) const {
+    auto* node = graphProcessor.getGraph().getNodeForId(nodeID);
+    return node != nullptr ? dynamic_cast<ProfiledPluginProcessor*>(node->getProcessor()) : nullptr;
+}
+
 void PluginManager::notifyParameterChanged(NodeID nodeID, int parameterIndex, float newValue) {
     if (parameterChangedCallback) {
         parameterChangedCallback(nodeID, parameterIndex, newValue);
@@ -680,7 +952,7 @@ void PluginManager::notifyParameterChanged(NodeID nodeID, int parameterIndex, fl
 }
 
 void PluginManager::notifyPluginError(NodeID nodeID, const std::string& error) {
-    std::cout << "[PluginManager] 插件错误：" << error << std::endl;
+    WSLOG_INFO("PluginManager", "插件错误：" << error);
 
     if (pluginErrorCallback) {
         pluginErrorCallback(nodeID, error);
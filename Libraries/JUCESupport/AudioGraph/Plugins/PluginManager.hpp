@@ -15,9 +15,11 @@
 #include <functional>
 #include <string>
 #include <mutex>
+#include <array>
 #include "../Core/GraphAudioProcessor.hpp"
 #include "../Core/AudioGraphTypes.hpp"
 #include "ModernPluginLoader.hpp"
+#include "PluginInstancePool.hpp"
 
 namespace WindsynthVST::AudioGraph {
 
@@ -30,6 +32,7 @@ namespace WindsynthVST::AudioGraph {
  * - 插件状态保存和恢复
  * - 插件性能监控
  * - 插件预设管理
+ * - 插件实例池（预热和复用实例，快速插入）
  */
 class PluginManager {
 public:
@@ -88,6 +91,27 @@ public:
             : name(n), data(d), createdTime(juce::Time::getCurrentTime()) {}
     };
     
+    /**
+     * 图召回中的单个插件
+     */
+    struct PluginRecallEntry {
+        juce::uint32 presetNodeUID = 0;         // 保存时的节点ID，连接按它引用插件
+        juce::PluginDescription description;
+        juce::MemoryBlock state;
+        std::string displayName;
+        bool enabled = true;
+        bool bypassed = false;
+    };
+    
+    /**
+     * 图召回请求
+     */
+    struct GraphRecallRequest {
+        std::vector<PluginRecallEntry> plugins;
+        std::vector<Connection> connections;    // 节点ID为保存时的ID
+        std::array<NodeID, 4> ioNodes;          // 保存时的I/O节点ID（音频输入、音频输出、MIDI输入、MIDI输出）
+    };
+    
     //==============================================================================
     // 回调类型定义
     //==============================================================================
@@ -96,6 +120,8 @@ public:
     using PluginRemovedCallback = std::function<void(NodeID nodeID)>;
     using ParameterChangedCallback = std::function<void(NodeID nodeID, int parameterIndex, float newValue)>;
     using PluginErrorCallback = std::function<void(NodeID nodeID, const std::string& error)>;
+    using PluginInstanceCallback = std::function<void(std::unique_ptr<juce::AudioPluginInstance> instance, const std::string& error)>;
+    using GraphRecallCallback = std::function<void(bool success, const std::string& error)>;
     
     //==============================================================================
     // 构造函数和析构函数
@@ -127,6 +153,44 @@ public:
                         const std::string& displayName = "",
                         std::function<void(NodeID nodeID, const std::string& error)> callback = nullptr);
     
+    /**
+     * 异步加载插件并恢复状态（实例池中有空闲实例时同步完成）
+     * @param description 插件描述
+     * @param state 插件状态（为空时恢复到默认状态）
+     * @param displayName 显示名称（可选）
+     * @param callback 加载完成回调
+     */
+    void loadPluginWithStateAsync(const juce::PluginDescription& description,
+                                 const juce::MemoryBlock& state,
+                                 const std::string& displayName = "",
+                                 std::function<void(NodeID nodeID, const std::string& error)> callback = nullptr);
+    
+    /**
+     * 异步创建插件实例并恢复状态，不插入图中（实例池中有空闲实例时同步完成）
+     * @param description 插件描述
+     * @param state 插件状态（为空时恢复到默认状态）
+     * @param callback 创建完成回调（消息线程）
+     */
+    void createPluginInstanceAsync(const juce::PluginDescription& description,
+                                  const juce::MemoryBlock& state,
+                                  PluginInstanceCallback callback);
+    
+    /**
+     * 异步召回整个插件图
+     *
+     * 图中描述相同的现有插件按顺序复用，其余插件同时开始实例化并恢复状态，
+     * 全部完成后一次性替换图中的节点和连接。召回时间取决于最慢的插件，而不是所有插件之和。
+     * 没有被复用的现有插件会被移除。
+     * @param request 召回请求
+     * @param callback 完成回调（消息线程），部分插件加载失败时 success 为false
+     */
+    void recallGraphAsync(GraphRecallRequest request, GraphRecallCallback callback = nullptr);
+    
+    /**
+     * 获取插件实例池
+     */
+    PluginInstancePool& getInstancePool() { return *instancePool; }
+    
     /**
      * 移除插件
      * @param nodeID 节点ID
@@ -197,6 +261,22 @@ public:
      */
     float getParameterValue(NodeID nodeID, int parameterIndex) const;
     
+    /**
+     * 获取缓存的参数元数据
+     * @param nodeID 节点ID
+     * @return 元数据快照，节点不存在时返回nullptr
+     */
+    std::shared_ptr<const ParameterCache::MetadataList> getParameterMetadata(NodeID nodeID) const;
+    
+    /**
+     * 复制节点的所有参数值（来自参数缓存，不调用插件）
+     * @param nodeID 节点ID
+     * @param destination 输出数组
+     * @param maxCount 数组容量
+     * @return 复制的参数数量
+     */
+    int copyParameterValues(NodeID nodeID, float* destination, int maxCount) const;
+    
     /**
      * 设置参数值
      * @param nodeID 节点ID
@@ -206,6 +286,14 @@ public:
      */
     bool setParameterValue(NodeID nodeID, int parameterIndex, float value);
     
+    /**
+     * 批量设置参数值（在节点的下一个处理块中按采样偏移应用）
+     * @param nodeID 节点ID
+     * @param events 参数事件，无效的参数索引会被忽略
+     * @return 成功排队的事件数量
+     */
+    int setParameterValues(NodeID nodeID, const std::vector<ParameterEvent>& events);
+    
     /**
      * 获取参数文本表示
      * @param nodeID 节点ID
@@ -319,6 +407,13 @@ public:
      */
     bool setPluginState(NodeID nodeID, const juce::MemoryBlock& stateData);
     
+    /**
+     * 获取插件状态版本（版本不变时状态没有变化）
+     * @param nodeID 节点ID
+     * @return 状态版本，无法跟踪时返回0
+     */
+    uint32_t getPluginStateGeneration(NodeID nodeID) const;
+    
     //==============================================================================
     // 性能监控
     //==============================================================================
@@ -396,6 +491,9 @@ private:
     GraphAudioProcessor& graphProcessor;
     ModernPluginLoader& pluginLoader;
     
+    // 插件实例池
+    std::unique_ptr<PluginInstancePool> instancePool;
+    
     // 插件实例管理
     mutable std::mutex pluginsMutex;
     std::unordered_map<NodeID, PluginInstanceInfo> pluginInstances;
@@ -422,11 +520,19 @@ private:
     // 内部方法
     //==============================================================================
     
+    void insertPluginInstance(std::unique_ptr<juce::AudioPluginInstance> instance,
+                              const juce::PluginDescription& description,
+                              const std::string& displayName,
+                              const std::function<void(NodeID nodeID, const std::string& error)>& callback);
+    struct RecallOperation;
+    void finishRecall(const std::shared_ptr<RecallOperation>& operation);
+    void forgetPlugin(NodeID nodeID, juce::AudioProcessorGraph::Node::Ptr removedNode);
     void handlePluginLoaded(NodeID nodeID, std::unique_ptr<juce::AudioPluginInstance> instance,
                            const std::string& displayName, const juce::PluginDescription& description);
     void notifyPluginLoaded(NodeID nodeID, const PluginInstanceInfo& info);
     void notifyPluginRemoved(NodeID nodeID);
     void notifyParameterChanged(NodeID nodeID, int parameterIndex, float newValue);
+    ProfiledPluginProcessor* getNodeWrapper(NodeID nodeID) const;
     void notifyPluginError(NodeID nodeID, const std::string& error);
     
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(PluginManager)
@@ -0,0 +1,338 @@
+//
+//  PluginScanCache.cpp
+//  WindsynthRecorder
+//
+//  Created by AI Assistant
+//  持久化的增量插件扫描缓存实现
+//
+
+#include "PluginScanCache.hpp"
+#include "../Core/Logger.hpp"
+#include <algorithm>
+
+namespace WindsynthVST::AudioGraph {
+
+//==============================================================================
+// 构造函数和析构函数
+//==============================================================================
+
+PluginScanCache::PluginScanCache(const juce::File& file)
+    : journalFile(file)
+{
+}
+
+PluginScanCache::~PluginScanCache() {
+    flush();
+}
+
+void PluginScanCache::setJournalFile(const juce::File& file) {
+    std::lock_guard<std::mutex> lock(cacheMutex);
+    journalFile = file;
+    loaded = false;
+    bundles.clear();
+    pendingRecords.clear();
+}
+
+juce::File PluginScanCache::getJournalFile() const {
+    std::lock_guard<std::mutex> lock(cacheMutex);
+    return journalFile;
+}
+
+//==============================================================================
+// 指纹
+//==============================================================================
+
+PluginScanCache::Fingerprint PluginScanCache::computeFingerprint(const juce::String& fileOrIdentifier) {
+    Fingerprint fingerprint;
+
+    // AU等格式使用的不是文件路径，只能按标识符判断
+    if (!juce::File::isAbsolutePath(fileOrIdentifier)) {
+        return fingerprint;
+    }
+
+    juce::File file(fileOrIdentifier);
+    if (!file.exists()) {
+        return fingerprint;
+    }
+
+    fingerprint.modificationTime = file.getLastModificationTime().toMilliseconds();
+
+    if (file.isDirectory()) {
+        // 插件包目录本身的时间戳在更新时不一定变化，使用包内 Info.plist 的时间戳和大小
+        auto infoPlist = file.getChildFile("Contents").getChildFile("Info.plist");
+        if (infoPlist.existsAsFile()) {
+            fingerprint.modificationTime = std::max(fingerprint.modificationTime,
+                                                    infoPlist.getLastModificationTime().toMilliseconds());
+            fingerprint.size = infoPlist.getSize();
+        }
+
+        auto manifest = file.getChildFile("Contents").getChildFile("Resources").getChildFile("moduleinfo.json");
+        if (manifest.existsAsFile()) {
+            fingerprint.manifestHash = manifest.loadFileAsString().hashCode64();
+        }
+    } else {
+        fingerprint.size = file.getSize();
+    }
+
+    return fingerprint;
+}
+
+//==============================================================================
+// 查询和记录
+//==============================================================================
+
+bool PluginScanCache::lookup(const juce::String& fileOrIdentifier,
+                             const juce::String& formatName,
+                             const Fingerprint& fingerprint,
+                             juce::Array<juce::PluginDescription>& types) {
+    std::lock_guard<std::mutex> lock(cacheMutex);
+    ensureLoadedLocked();
+
+    auto it = bundles.find(makeKey(fileOrIdentifier, formatName));
+    if (it == bundles.end() || it->second.fingerprint != fingerprint) {
+        return false;
+    }
+
+    types = it->second.types;
+    return true;
+}
+
+void PluginScanCache::record(const juce::String& fileOrIdentifier,
+                             const juce::String& formatName,
+                             const Fingerprint& fingerprint,
+                             const juce::Array<juce::PluginDescription>& types) {
+    std::lock_guard<std::mutex> lock(cacheMutex);
+    ensureLoadedLocked();
+
+    BundleRecord record;
+    record.fileOrIdentifier = fileOrIdentifier;
+    record.formatName = formatName;
+    record.fingerprint = fingerprint;
+    record.types = types;
+
+    pendingRecords.push_back(createRecordXml(record, false));
+    bundles[makeKey(fileOrIdentifier, formatName)] = std::move(record);
+}
+
+void PluginScanCache::remove(const juce::String& fileOrIdentifier, const juce::String& formatName) {
+    std::lock_guard<std::mutex> lock(cacheMutex);
+    ensureLoadedLocked();
+
+    auto it = bundles.find(makeKey(fileOrIdentifier, formatName));
+    if (it == bundles.end()) {
+        return;
+    }
+
+    pendingRecords.push_back(createRecordXml(it->second, true));
+    bundles.erase(it);
+}
+
+juce::StringArray PluginScanCache::getCachedFiles(const juce::String& formatName) {
+    std::lock_guard<std::mutex> lock(cacheMutex);
+    ensureLoadedLocked();
+
+    juce::StringArray files;
+    for (const auto& [key, record] : bundles) {
+        if (record.formatName == formatName) {
+            files.add(record.fileOrIdentifier);
+        }
+    }
+    return files;
+}
+
+juce::Array<juce::PluginDescription> PluginScanCache::getAllTypes() {
+    std::lock_guard<std::mutex> lock(cacheMutex);
+    ensureLoadedLocked();
+
+    juce::Array<juce::PluginDescription> types;
+    for (const auto& [key, record] : bundles) {
+        types.addArray(record.types);
+    }
+    return types;
+}
+
+//==============================================================================
+// 持久化
+//==============================================================================
+
+bool PluginScanCache::flush() {
+    std::lock_guard<std::mutex> lock(cacheMutex);
+
+    if (pendingRecords.empty()) {
+        return true;
+    }
+
+    journalFile.getParentDirectory().createDirectory();
+
+    // FileOutputStream 打开已存在的文件时定位到末尾，只追加新记录
+    juce::FileOutputStream output(journalFile);
+    if (!output.openedOk()) {
+        WSLOG_ERROR("PluginScanCache", "无法打开缓存文件：" << journalFile.getFullPathName());
+        return false;
+    }
+
+    const auto format = juce::XmlElement::TextFormat().singleLine().withoutHeader();
+    for (const auto& xml : pendingRecords) {
+        output << xml->toString(format) << "\n";
+    }
+    output.flush();
+
+    if (output.getStatus().failed()) {
+        WSLOG_ERROR("PluginScanCache", "写入缓存失败：" << output.getStatus().getErrorMessage());
+        return false;
+    }
+
+    WSLOG_INFO("PluginScanCache", "追加 " << pendingRecords.size() << " 条扫描记录");
+    pendingRecords.clear();
+    return true;
+}
+
+void PluginScanCache::clear() {
+    std::lock_guard<std::mutex> lock(cacheMutex);
+
+    bundles.clear();
+    pendingRecords.clear();
+    lastScan = {};
+    loaded = true;
+    journalFile.deleteFile();
+}
+
+void PluginScanCache::setLastScanCounts(int unchanged, int rescanned, int removed) {
+    std::lock_guard<std::mutex> lock(cacheMutex);
+    lastScan.lastScanUnchanged = unchanged;
+    lastScan.lastScanRescanned = rescanned;
+    lastScan.lastScanRemoved = removed;
+}
+
+PluginScanCache::Statistics PluginScanCache::getStatistics() {
+    std::lock_guard<std::mutex> lock(cacheMutex);
+    ensureLoadedLocked();
+
+    Statistics stats = lastScan;
+    stats.numBundles = static_cast<int>(bundles.size());
+    for (const auto& [key, record] : bundles) {
+        stats.numPlugins += record.types.size();
+    }
+    stats.pendingRecords = static_cast<int>(pendingRecords.size());
+    return stats;
+}
+
+//==============================================================================
+// 内部方法
+//==============================================================================
+
+juce::String PluginScanCache::makeKey(const juce::String& fileOrIdentifier, const juce::String& formatName) {
+    return formatName + "|" + fileOrIdentifier;
+}
+
+std::unique_ptr<juce::XmlElement> PluginScanCache::createRecordXml(const BundleRecord& record, bool removed) {
+    auto xml = std::make_unique<juce::XmlElement>("BUNDLE");
+    xml->setAttribute("file", record.fileOrIdentifier);
+    xml->setAttribute("format", record.formatName);
+
+    if (removed) {
+        xml->setAttribute("removed", true);
+        return xml;
+    }
+
+    xml->setAttribute("mtime", juce::String(record.fingerprint.modificationTime));
+    xml->setAttribute("size", juce::String(record.fingerprint.size));
+    xml->setAttribute("manifest", juce::String(record.fingerprint.manifestHash));
+
+    for (const auto& type : record.types) {
+        xml->addChildElement(type.createXml().release());
+    }
+    return xml;
+}
+
+void PluginScanCache::ensureLoadedLocked() {
+    if (loaded) {
+        return;
+    }
+    loaded = true;
+
+    if (!journalFile.existsAsFile()) {
+        return;
+    }
+
+    const double startTime = juce::Time::getMillisecondCounterHiRes();
+
+    juce::StringArray lines;
+    journalFile.readLines(lines);
+
+    int numRecords = 0;
+    for (const auto& line : lines) {
+        if (line.trim().isEmpty()) {
+            continue;
+        }
+
+        auto xml = juce::parseXML(line);
+        if (!xml || !xml->hasTagName("BUNDLE")) {
+            continue;     // 写入中断留下的不完整记录
+        }
+        numRecords++;
+
+        BundleRecord record;
+        record.fileOrIdentifier = xml->getStringAttribute("file");
+        record.formatName = xml->getStringAttribute("format");
+        const auto key = makeKey(record.fileOrIdentifier, record.formatName);
+
+        if (xml->getBoolAttribute("removed")) {
+            bundles.erase(key);
+            continue;
+        }
+
+        record.fingerprint.modificationTime = xml->getStringAttribute("mtime").getLargeIntValue();
+        record.fingerprint.size = xml->getStringAttribute("size").getLargeIntValue();
+        record.fingerprint.manifestHash = xml->getStringAttribute("manifest").getLargeIntValue();
+
+        for (auto* child : xml->getChildWithTagNameIterator("PLUGIN")) {
+            juce::PluginDescription description;
+            if (description.loadFromXml(*child)) {
+                record.types.add(description);
+            }
+        }
+
+        bundles[key] = std::move(record);
+    }
+
+    WSLOG_INFO("PluginScanCache", "加载 " << bundles.size() << " 个插件包记录，耗时 "
+            << juce::String(juce::Time::getMillisecondCounterHiRes() - startTime, 1) << " ms");
+
+    // 过期记录过多时重写日志
+    if (numRecords > static_cast<int>(bundles.size()) * 2 + 64) {
+        compactLocked();
+    }
+}
+
+bool PluginScanCache::compactLocked() {
+    juce::TemporaryFile tempFile(journalFile);
+
+    {
+        juce::FileOutputStream output(tempFile.getFile());
+        if (!output.openedOk()) {
+            return false;
+        }
+
+        const auto format = juce::XmlElement::TextFormat().singleLine().withoutHeader();
+        for (const auto& [key, record] : bundles) {
+            output << createRecordXml(record, false)->toString(format) << "\n";
+        }
+        output.flush();
+
+        if (output.getStatus().failed()) {
+            return false;
+        }
+    }
+
+    if (!tempFile.overwriteTargetFileWithTemporary()) {
+        return false;
+    }
+
+    // 内存中的记录已全部写入
+    pendingRecords.clear();
+    WSLOG_INFO("PluginScanCache", "已压缩缓存日志");
+    return true;
+}
+
+} // namespace WindsynthVST::AudioGraph
@@ -0,0 +1,162 @@
+//
+//  PluginScanCache.hpp
+//  WindsynthRecorder
+//
+//  Created by AI Assistant
+//  持久化的增量插件扫描缓存
+//
+
+#pragma once
+
+#include <JuceHeader.h>
+#include <map>
+#include <mutex>
+#include <vector>
+#include <cstdint>
+
+namespace WindsynthVST::AudioGraph {
+
+/**
+ * 插件扫描缓存
+ *
+ * 以插件包为单位记录扫描结果，指纹由路径、修改时间、大小和 VST3 moduleinfo.json
+ * 的哈希组成，启动时只需重新扫描新增或发生变化的插件包。
+ *
+ * 缓存以追加写入的日志文件保存（每行一条单行XML记录，后写入的记录覆盖先前的记录），
+ * 保存时只追加变化的条目而不重写整个列表；过期记录过多时在加载时压缩。
+ * 日志在第一次访问时才读取。所有方法都是线程安全的。
+ */
+class PluginScanCache {
+public:
+    /**
+     * 插件包指纹
+     */
+    struct Fingerprint {
+        juce::int64 modificationTime = 0;
+        juce::int64 size = 0;
+        juce::int64 manifestHash = 0;      // VST3 moduleinfo.json 内容哈希（没有时为0）
+
+        bool operator==(const Fingerprint& other) const {
+            return modificationTime == other.modificationTime && size == other.size
+                   && manifestHash == other.manifestHash;
+        }
+        bool operator!=(const Fingerprint& other) const { return !(*this == other); }
+    };
+
+    /**
+     * 缓存统计
+     */
+    struct Statistics {
+        int numBundles = 0;         // 缓存的插件包数量
+        int numPlugins = 0;         // 缓存的插件数量
+        int lastScanUnchanged = 0;  // 上次扫描中直接使用缓存的插件包数量
+        int lastScanRescanned = 0;  // 上次扫描中需要重新扫描的插件包数量
+        int lastScanRemoved = 0;    // 上次扫描中已不存在的插件包数量
+        int pendingRecords = 0;     // 尚未写入磁盘的记录数
+    };
+
+    /**
+     * 构造函数
+     * @param journalFile 缓存日志文件
+     */
+    explicit PluginScanCache(const juce::File& journalFile);
+    ~PluginScanCache();
+
+    /**
+     * 更换缓存日志文件（会丢弃已加载的内容，下次访问时重新加载）
+     */
+    void setJournalFile(const juce::File& file);
+
+    /**
+     * 获取缓存日志文件
+     */
+    juce::File getJournalFile() const;
+
+    /**
+     * 计算插件包的指纹
+     * @param fileOrIdentifier 插件文件路径或标识符（非文件标识符的指纹为空）
+     */
+    static Fingerprint computeFingerprint(const juce::String& fileOrIdentifier);
+
+    /**
+     * 查询插件包的缓存结果
+     * @param fileOrIdentifier 插件文件路径或标识符
+     * @param formatName 插件格式名称
+     * @param fingerprint 当前指纹
+     * @param types 指纹一致时返回缓存的插件描述
+     * @return 缓存有效时返回true
+     */
+    bool lookup(const juce::String& fileOrIdentifier,
+                const juce::String& formatName,
+                const Fingerprint& fingerprint,
+                juce::Array<juce::PluginDescription>& types);
+
+    /**
+     * 记录插件包的扫描结果
+     */
+    void record(const juce::String& fileOrIdentifier,
+                const juce::String& formatName,
+                const Fingerprint& fingerprint,
+                const juce::Array<juce::PluginDescription>& types);
+
+    /**
+     * 移除插件包记录（插件包已被删除）
+     */
+    void remove(const juce::String& fileOrIdentifier, const juce::String& formatName);
+
+    /**
+     * 获取指定格式的所有缓存插件包
+     */
+    juce::StringArray getCachedFiles(const juce::String& formatName);
+
+    /**
+     * 获取所有缓存的插件描述
+     */
+    juce::Array<juce::PluginDescription> getAllTypes();
+
+    /**
+     * 把未保存的记录追加到日志文件
+     * @return 成功返回true
+     */
+    bool flush();
+
+    /**
+     * 清空缓存并删除日志文件
+     */
+    void clear();
+
+    /**
+     * 设置上次扫描的统计
+     */
+    void setLastScanCounts(int unchanged, int rescanned, int removed);
+
+    /**
+     * 获取缓存统计
+     */
+    Statistics getStatistics();
+
+private:
+    struct BundleRecord {
+        juce::String fileOrIdentifier;
+        juce::String formatName;
+        Fingerprint fingerprint;
+        juce::Array<juce::PluginDescription> types;
+    };
+
+    mutable std::mutex cacheMutex;
+    juce::File journalFile;
+    bool loaded = false;
+    std::map<juce::String, BundleRecord> bundles;       // 键为 格式名 + "|" + 路径
+    std::vector<std::unique_ptr<juce::XmlElement>> pendingRecords;
+    Statistics lastScan;
+
+    static juce::String makeKey(const juce::String& fileOrIdentifier, const juce::String& formatName);
+    static std::unique_ptr<juce::XmlElement> createRecordXml(const BundleRecord& record, bool removed);
+
+    void ensureLoadedLocked();
+    bool compactLocked();
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(PluginScanCache)
+};
+
+} // namespace WindsynthVST::AudioGraph
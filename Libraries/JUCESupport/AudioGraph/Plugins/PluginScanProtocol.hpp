@@ -0,0 +1,98 @@
+//
+//  PluginScanProtocol.hpp
+//  WindsynthRecorder
+//
+//  Created by AI Assistant
+//  插件扫描主进程与辅助进程之间的消息格式
+//
+
+#pragma once
+
+#include <JuceHeader.h>
+
+namespace WindsynthVST::AudioGraph::PluginScanProtocol {
+
+/**
+ * 辅助进程命令行标识（ChildProcessCoordinator/ChildProcessWorker 用于识别连接）
+ */
+inline constexpr const char* commandLineUID = "windsynthpluginscanner";
+
+/**
+ * 辅助进程可执行文件名
+ */
+inline constexpr const char* workerExecutableName = "WindsynthPluginScanner";
+
+//==============================================================================
+// 消息编码（每条消息是一个UTF-8 XML元素）
+//==============================================================================
+
+inline juce::MemoryBlock toMemoryBlock(const juce::XmlElement& xml) {
+    const auto text = xml.toString(juce::XmlElement::TextFormat().singleLine().withoutHeader());
+    return juce::MemoryBlock(text.toRawUTF8(), text.getNumBytesAsUTF8());
+}
+
+/**
+ * 扫描请求：<SCAN format="VST3" file="..."/>
+ */
+inline juce::MemoryBlock createScanRequest(const juce::String& formatName, const juce::String& fileOrIdentifier) {
+    juce::XmlElement xml("SCAN");
+    xml.setAttribute("format", formatName);
+    xml.setAttribute("file", fileOrIdentifier);
+    return toMemoryBlock(xml);
+}
+
+inline bool parseScanRequest(const juce::MemoryBlock& message, juce::String& formatName, juce::String& fileOrIdentifier) {
+    auto xml = juce::parseXML(message.toString());
+    if (!xml || !xml->hasTagName("SCAN")) {
+        return false;
+    }
+
+    formatName = xml->getStringAttribute("format");
+    fileOrIdentifier = xml->getStringAttribute("file");
+    return fileOrIdentifier.isNotEmpty();
+}
+
+/**
+ * 扫描结果：<RESULT file="..." ok="1" error="..."><PLUGIN .../>...</RESULT>
+ */
+inline juce::MemoryBlock createScanResult(const juce::String& fileOrIdentifier,
+                                          bool ok,
+                                          const juce::OwnedArray<juce::PluginDescription>& types,
+                                          const juce::String& error) {
+    juce::XmlElement xml("RESULT");
+    xml.setAttribute("file", fileOrIdentifier);
+    xml.setAttribute("ok", ok);
+    if (error.isNotEmpty()) {
+        xml.setAttribute("error", error);
+    }
+
+    for (auto* type : types) {
+        xml.addChildElement(type->createXml().release());
+    }
+    return toMemoryBlock(xml);
+}
+
+inline bool parseScanResult(const juce::MemoryBlock& message,
+                            juce::String& fileOrIdentifier,
+                            bool& ok,
+                            juce::Array<juce::PluginDescription>& types,
+                            juce::String& error) {
+    auto xml = juce::parseXML(message.toString());
+    if (!xml || !xml->hasTagName("RESULT")) {
+        return false;
+    }
+
+    fileOrIdentifier = xml->getStringAttribute("file");
+    ok = xml->getBoolAttribute("ok");
+    error = xml->getStringAttribute("error");
+
+    for (auto* child : xml->getChildWithTagNameIterator("PLUGIN")) {
+        juce::PluginDescription description;
+        if (description.loadFromXml(*child)) {
+            types.add(description);
+        }
+    }
+    return true;
+}
+
+} // namespace WindsynthVST::AudioGraph::PluginScanProtocol
@@ -0,0 +1,90 @@
+//
+//  PluginScanWorker.cpp
+//  WindsynthRecorder
+//
+//  Created by AI Assistant
+//  插件扫描辅助进程实现
+//
+
+#include "PluginScanWorker.hpp"
+#include "PluginScanProtocol.hpp"
+#include <iostream>
+
+namespace WindsynthVST::AudioGraph {
+
+//==============================================================================
+// 构造函数和析构函数
+//==============================================================================
+
+PluginScanWorker::PluginScanWorker() {
+    // 与主进程的 ModernPluginLoader 使用相同的格式
+    formatManager.addDefaultFormats();
+}
+
+PluginScanWorker::~PluginScanWorker() = default;
+
+int PluginScanWorker::run(const juce::String& commandLine) {
+    PluginScanWorker worker;
+
+    if (!worker.initialiseFromCommandLine(commandLine, PluginScanProtocol::commandLineUID)) {
+        std::cerr << "[PluginScanWorker] 必须由主程序启动" << std::endl;
+        return 1;
+    }
+
+    // 很多插件要求在消息线程中实例化
+    juce::MessageManager::getInstance()->runDispatchLoop();
+    return 0;
+}
+
+//==============================================================================
+// ChildProcessWorker 接口实现
+//==============================================================================
+
+void PluginScanWorker::handleMessageFromCoordinator(const juce::MemoryBlock& message) {
+    juce::String formatName, fileOrIdentifier;
+    if (!PluginScanProtocol::parseScanRequest(message, formatName, fileOrIdentifier)) {
+        return;
+    }
+
+    juce::MessageManager::callAsync([this, formatName, fileOrIdentifier] {
+        scanFile(formatName, fileOrIdentifier);
+    });
+}
+
+void PluginScanWorker::handleConnectionMade() {
+}
+
+void PluginScanWorker::handleConnectionLost() {
+    // 主进程退出或结束了扫描
+    juce::MessageManager::getInstance()->stopDispatchLoop();
+}
+
+//==============================================================================
+// 内部方法
+//==============================================================================
+
+void PluginScanWorker::scanFile(const juce::String& formatName, const juce::String& fileOrIdentifier) {
+    juce::OwnedArray<juce::PluginDescription> found;
+
+    juce::AudioPluginFormat* format = nullptr;
+    for (auto* candidate : formatManager.getFormats()) {
+        if (candidate->getName() == formatName) {
+            format = candidate;
+            break;
+        }
+    }
+
+    if (format == nullptr) {
+        sendMessageToCoordinator(PluginScanProtocol::createScanResult(fileOrIdentifier, false, found,
+                                                                      "不支持的插件格式: " + formatName));
+        return;
+    }
+
+    format->findAllTypesForFile(found, fileOrIdentifier);
+
+    const bool ok = !found.isEmpty();
+    sendMessageToCoordinator(PluginScanProtocol::createScanResult(fileOrIdentifier, ok, found,
+                                                                  ok ? juce::String() : "未找到插件"));
+}
+
+} // namespace WindsynthVST::AudioGraph
@@ -0,0 +1,50 @@
+//
+//  PluginScanWorker.hpp
+//  WindsynthRecorder
+//
+//  Created by AI Assistant
+//  插件扫描辅助进程 - 在独立进程中实例化插件
+//
+
+#pragma once
+
+#include <JuceHeader.h>
+
+namespace WindsynthVST::AudioGraph {
+
+/**
+ * 插件扫描辅助进程
+ *
+ * 运行在 WindsynthPluginScanner 可执行文件中，由 OutOfProcessPluginScanner 启动。
+ * 每次接收一个插件文件的扫描请求，在消息线程中调用 findAllTypesForFile，
+ * 把结果发回主进程。插件崩溃或卡死只会影响这个进程。
+ */
+class PluginScanWorker : public juce::ChildProcessWorker {
+public:
+    PluginScanWorker();
+    ~PluginScanWorker() override;
+
+    /**
+     * 辅助进程入口：连接主进程并运行消息循环，直到连接断开
+     * @param commandLine 进程命令行
+     * @return 进程退出码（不是由主进程启动时返回1）
+     */
+    static int run(const juce::String& commandLine);
+
+    //==============================================================================
+    // ChildProcessWorker 接口实现
+    //==============================================================================
+
+    void handleMessageFromCoordinator(const juce::MemoryBlock& message) override;
+    void handleConnectionMade() override;
+    void handleConnectionLost() override;
+
+private:
+    juce::AudioPluginFormatManager formatManager;
+
+    void scanFile(const juce::String& formatName, const juce::String& fileOrIdentifier);
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(PluginScanWorker)
+};
+
+} // namespace WindsynthVST::AudioGraph
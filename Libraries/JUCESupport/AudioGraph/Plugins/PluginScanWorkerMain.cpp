@@ -0,0 +1,20 @@
+//
+//  PluginScanWorkerMain.cpp
+//  WindsynthRecorder
+//
+//  Created by AI Assistant
+//  插件扫描辅助进程入口
+//
+
+#include "PluginScanWorker.hpp"
+
+int main(int argc, char* argv[]) {
+    juce::ScopedJuceInitialiser_GUI juceInitialiser;
+
+    juce::StringArray arguments;
+    for (int i = 1; i < argc; ++i) {
+        arguments.add(juce::String::fromUTF8(argv[i]));
+    }
+
+    return WindsynthVST::AudioGraph::PluginScanWorker::run(arguments.joinIntoString(" "));
+}
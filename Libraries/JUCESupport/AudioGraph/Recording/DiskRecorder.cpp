@@ -0,0 +1,418 @@
+//
+//  DiskRecorder.cpp
+//  WindsynthRecorder
+//
+//  Created by AI Assistant
+//  多轨磁盘录音引擎实现
+//
+
+#include "DiskRecorder.hpp"
+#include "../Core/Logger.hpp"
+#include <algorithm>
+#include <limits>
+
+namespace WindsynthVST::AudioGraph {
+
+namespace {
+    constexpr int drainChunkSamples = 8192;
+}
+
+//==============================================================================
+// 构造函数和析构函数
+//==============================================================================
+
+DiskRecorder::DiskRecorder()
+    : juce::Thread("Disk Recorder")
+{
+    WSLOG_INFO("DiskRecorder", "构造函数");
+}
+
+DiskRecorder::~DiskRecorder() {
+    WSLOG_INFO("DiskRecorder", "析构函数");
+    stopRecording();
+}
+
+//==============================================================================
+// 录音控制
+//==============================================================================
+
+bool DiskRecorder::startRecording(const RecordingSettings& settings,
+                                  const std::vector<TrackConfig>& trackConfigs,
+                                  std::string& error) {
+    std::lock_guard<std::mutex> lock(controlMutex);
+
+    if (recording.load()) {
+        error = "已经在录音";
+        return false;
+    }
+
+    if (trackConfigs.empty()) {
+        error = "没有配置录音轨道";
+        return false;
+    }
+
+    if (settings.sampleRate <= 0.0) {
+        error = "无效的采样率";
+        return false;
+    }
+
+    juce::File outputDirectory(settings.outputDirectory);
+    if (!outputDirectory.isDirectory() && !outputDirectory.createDirectory()) {
+        error = "无法创建录音目录: " + settings.outputDirectory;
+        return false;
+    }
+
+    currentSettings = settings;
+    numPreChannels = juce::jlimit(0, Constants::MAX_AUDIO_CHANNELS, settings.numInputChannels);
+    numPostChannels = juce::jlimit(0, Constants::MAX_AUDIO_CHANNELS, settings.numOutputChannels);
+
+    WSLOG_INFO("DiskRecorder", "开始录音：" << trackConfigs.size() << " 个轨道，"
+            << settings.sampleRate << "Hz，输入 " << numPreChannels
+            << " 通道，输出 " << numPostChannels << " 通道");
+
+    // 创建轨道文件和写入器
+    const juce::String extension = settings.format == FileFormat::AIFF ? ".aiff" : ".wav";
+    trackFiles.clear();
+
+    for (const auto& config : trackConfigs) {
+        const int availableChannels = config.source == CapturePoint::PreGraph ? numPreChannels : numPostChannels;
+        if (config.numChannels <= 0 || config.firstChannel < 0 ||
+            config.firstChannel + config.numChannels > availableChannels) {
+            error = "轨道通道范围无效: " + config.name;
+            discardTracks();
+            return false;
+        }
+
+        auto track = std::make_unique<Track>();
+        track->config = config;
+
+        const juce::String baseName = juce::File::createLegalFileName(
+            juce::String(settings.takeName) + "_" + juce::String(config.name));
+        track->file = outputDirectory.getNonexistentChildFile(baseName, extension, false);
+        trackFiles.push_back(track->file.getFullPathName().toStdString());
+
+        auto writer = createWriter(track->file, config.numChannels, error);
+        if (!writer) {
+            discardTracks();
+            return false;
+        }
+
+        track->writer = std::make_unique<juce::AudioFormatWriter::ThreadedWriter>(
+            writer.release(), diskThread, std::max(4096, settings.diskBufferSamples));
+
+        const int channelOffset = config.source == CapturePoint::PreGraph ? 0 : numPreChannels;
+        for (int ch = 0; ch < config.numChannels; ++ch) {
+            track->fifoChannels.push_back(channelOffset + config.firstChannel + ch);
+        }
+        track->channelPointers.assign(static_cast<size_t>(config.numChannels), nullptr);
+
+        WSLOG_INFO("DiskRecorder", "轨道文件: " << track->file.getFullPathName());
+        tracks.push_back(std::move(track));
+    }
+
+    // 预分配采集FIFO
+    const int capacity = settings.captureBufferSamples > 0
+        ? settings.captureBufferSamples
+        : static_cast<int>(settings.sampleRate * 2.0);
+    captureFifo.setTotalSize(capacity + 1);
+    captureFifo.reset();
+    captureBuffer.setSize(std::max(1, numPreChannels + numPostChannels), capacity + 1);
+    captureBuffer.clear();
+
+    // 重置统计
+    samplesCaptured.store(0);
+    samplesWritten.store(0);
+    captureOverruns.store(0);
+    droppedSamples.store(0);
+    diskStalls.store(0);
+    samplesConsumed = 0;
+    pendingBlockValid = false;
+
+    diskThread.startThread();
+    startThread(juce::Thread::Priority::high);
+
+    recording.store(true);
+    return true;
+}
+
+void DiskRecorder::stopRecording() {
+    std::lock_guard<std::mutex> lock(controlMutex);
+
+    if (!recording.load()) {
+        return;
+    }
+
+    WSLOG_INFO("DiskRecorder", "停止录音");
+
+    // 停止采集，并等待正在进行的音频回调退出
+    recording.store(false);
+    while (activeCaptureCalls.load() > 0) {
+        juce::Thread::yield();
+    }
+
+    // 写入线程退出前会取完FIFO中剩余的数据
+    stopThread(10000);
+
+    // 销毁写入器会把磁盘缓冲区中的数据写完并关闭文件
+    closeTracks();
+    diskThread.stopThread(2000);
+
+    WSLOG_INFO("DiskRecorder", "录音已停止，写入 " << samplesWritten.load()
+            << " 采样，采集溢出 " << captureOverruns.load()
+            << " 次，磁盘等待 " << diskStalls.load() << " 次");
+}
+
+std::vector<std::string> DiskRecorder::getTrackFiles() const {
+    std::lock_guard<std::mutex> lock(controlMutex);
+
+    return trackFiles;
+}
+
+//==============================================================================
+// 穿插录音
+//==============================================================================
+
+void DiskRecorder::setPunchRange(int64_t inSample, int64_t outSample) {
+    punchInSample.store(std::max<int64_t>(0, inSample));
+    punchOutSample.store(outSample);
+    punchEnabled.store(true);
+}
+
+void DiskRecorder::clearPunchRange() {
+    punchEnabled.store(false);
+}
+
+void DiskRecorder::punchIn() {
+    setPunchRange(samplesCaptured.load(), 0);
+}
+
+void DiskRecorder::punchOut() {
+    const int64_t position = samplesCaptured.load();
+    if (!punchEnabled.load()) {
+        // 未设置区间时，从开头写入到当前位置
+        punchInSample.store(0);
+        punchEnabled.store(true);
+    }
+    punchOutSample.store(std::max(position, punchInSample.load() + 1));
+}
+
+//==============================================================================
+// 统计信息
+//==============================================================================
+
+DiskRecorder::RecordingStatistics DiskRecorder::getStatistics() const {
+    RecordingStatistics stats;
+    stats.isRecording = recording.load();
+    stats.samplesCaptured = samplesCaptured.load();
+    stats.samplesWritten = samplesWritten.load();
+    stats.captureOverruns = captureOverruns.load();
+    stats.droppedSamples = droppedSamples.load();
+    stats.diskStalls = diskStalls.load();
+    stats.punchEnabled = punchEnabled.load();
+    stats.punchInSample = punchInSample.load();
+    stats.punchOutSample = punchOutSample.load();
+
+    const int totalSize = captureFifo.getTotalSize();
+    stats.captureBufferFill = totalSize > 1
+        ? static_cast<float>(captureFifo.getNumReady()) / static_cast<float>(totalSize - 1)
+        : 0.0f;
+
+    std::lock_guard<std::mutex> lock(controlMutex);
+    stats.numTracks = static_cast<int>(tracks.size());
+    return stats;
+}
+
+//==============================================================================
+// 音频线程采集
+//==============================================================================
+
+void DiskRecorder::captureAudio(CapturePoint point,
+                                const float* const* channelData,
+                                int numChannels,
+                                int numSamples) noexcept {
+    activeCaptureCalls.fetch_add(1);
+
+    if (recording.load() && numSamples > 0) {
+        // 把一组通道复制到预留的FIFO区域，缺少的通道写入静音
+        auto copyChannels = [&](int fifoChannelOffset, int numFifoChannels) {
+            for (int ch = 0; ch < numFifoChannels; ++ch) {
+                float* destination = captureBuffer.getWritePointer(fifoChannelOffset + ch);
+                const float* source = (channelData != nullptr && ch < numChannels) ? channelData[ch] : nullptr;
+
+                if (source != nullptr) {
+                    juce::FloatVectorOperations::copy(destination + pendingStart1, source, pendingSize1);
+                    if (pendingSize2 > 0) {
+                        juce::FloatVectorOperations::copy(destination + pendingStart2, source + pendingSize1, pendingSize2);
+                    }
+                } else {
+                    juce::FloatVectorOperations::clear(destination + pendingStart1, pendingSize1);
+                    if (pendingSize2 > 0) {
+                        juce::FloatVectorOperations::clear(destination + pendingStart2, pendingSize2);
+                    }
+                }
+            }
+        };
+
+        if (point == CapturePoint::PreGraph) {
+            // 为本次回调预留FIFO空间，处理后的数据在 PostGraph 调用中写入同一区域
+            captureFifo.prepareToWrite(numSamples, pendingStart1, pendingSize1, pendingStart2, pendingSize2);
+            pendingBlockValid = (pendingSize1 + pendingSize2) == numSamples;
+            pendingSamples = numSamples;
+
+            if (pendingBlockValid) {
+                copyChannels(0, numPreChannels);
+            } else {
+                // 写入线程跟不上：丢弃整个块，绝不阻塞音频线程
+                captureOverruns.fetch_add(1, std::memory_order_relaxed);
+                droppedSamples.fetch_add(static_cast<uint64_t>(numSamples), std::memory_order_relaxed);
+            }
+        } else {
+            if (pendingBlockValid && pendingSamples == numSamples) {
+                copyChannels(numPreChannels, numPostChannels);
+                captureFifo.finishedWrite(numSamples);
+                samplesCaptured.fetch_add(numSamples, std::memory_order_relaxed);
+            }
+            pendingBlockValid = false;
+        }
+    }
+
+    activeCaptureCalls.fetch_sub(1);
+}
+
+//==============================================================================
+// 写入线程
+//==============================================================================
+
+void DiskRecorder::run() {
+    while (!threadShouldExit()) {
+        if (drainCaptureFifo() == 0) {
+            wait(2);
+        }
+    }
+
+    // 取完剩余数据
+    while (drainCaptureFifo() > 0) {
+    }
+}
+
+int DiskRecorder::drainCaptureFifo() {
+    const int numReady = captureFifo.getNumReady();
+    if (numReady <= 0) {
+        return 0;
+    }
+
+    int start1, size1, start2, size2;
+    captureFifo.prepareToRead(std::min(numReady, drainChunkSamples), start1, size1, start2, size2);
+
+    if (size1 > 0) {
+        writeRegion(start1, size1);
+    }
+    if (size2 > 0) {
+        writeRegion(start2, size2);
+    }
+
+    captureFifo.finishedRead(size1 + size2);
+    return size1 + size2;
+}
+
+void DiskRecorder::writeRegion(int fifoStart, int numSamples) {
+    const int64_t regionStart = samplesConsumed;
+    const int64_t regionEnd = regionStart + numSamples;
+    samplesConsumed = regionEnd;
+
+    // 与穿插录音区间求交集
+    int64_t writeStart = regionStart;
+    int64_t writeEnd = regionEnd;
+
+    if (punchEnabled.load()) {
+        const int64_t punchIn = punchInSample.load();
+        int64_t punchOut = punchOutSample.load();
+        if (punchOut <= punchIn) {
+            punchOut = std::numeric_limits<int64_t>::max();
+        }
+        writeStart = std::max(writeStart, punchIn);
+        writeEnd = std::min(writeEnd, punchOut);
+    }
+
+    if (writeEnd <= writeStart) {
+        return;
+    }
+
+    const int offset = fifoStart + static_cast<int>(writeStart - regionStart);
+    const int length = static_cast<int>(writeEnd - writeStart);
+
+    for (auto& track : tracks) {
+        writeTrack(*track, offset, length);
+    }
+    samplesWritten.fetch_add(length, std::memory_order_relaxed);
+}
+
+bool DiskRecorder::writeTrack(Track& track, int fifoStart, int numSamples) {
+    if (!track.writer) {
+        return false;
+    }
+
+    for (size_t i = 0; i < track.fifoChannels.size(); ++i) {
+        track.channelPointers[i] = captureBuffer.getReadPointer(track.fifoChannels[i], fifoStart);
+    }
+
+    // 磁盘缓冲区已满时等待磁盘线程；采集FIFO会继续缓冲音频线程的数据
+    while (!track.writer->write(track.channelPointers.data(), numSamples)) {
+        diskStalls.fetch_add(1, std::memory_order_relaxed);
+        juce::Thread::sleep(1);
+    }
+    return true;
+}
+
+void DiskRecorder::closeTracks() {
+    for (auto& track : tracks) {
+        track->writer.reset();
+    }
+    tracks.clear();
+}
+
+void DiskRecorder::discardTracks() {
+    // 启动失败时删除已经创建的文件（包括创建写入器失败时留下的空文件）
+    closeTracks();
+    for (const auto& path : trackFiles) {
+        juce::File(path).deleteFile();
+    }
+    trackFiles.clear();
+}
+
+std::unique_ptr<juce::AudioFormatWriter> DiskRecorder::createWriter(const juce::File& file,
+                                                                    int numChannels,
+                                                                    std::string& error) const {
+    std::unique_ptr<juce::AudioFormat> format;
+    if (currentSettings.format == FileFormat::AIFF) {
+        format = std::make_unique<juce::AiffAudioFormat>();
+    } else {
+        format = std::make_unique<juce::WavAudioFormat>();
+    }
+
+    std::unique_ptr<juce::FileOutputStream> outputStream(file.createOutputStream());
+    if (!outputStream) {
+        error = "无法创建录音文件: " + file.getFullPathName().toStdString();
+        return nullptr;
+    }
+
+    std::unique_ptr<juce::AudioFormatWriter> writer(format->createWriterFor(
+        outputStream.get(),
+        currentSettings.sampleRate,
+        static_cast<unsigned int>(numChannels),
+        currentSettings.bitDepth,
+        {},
+        0
+    ));
+
+    if (!writer) {
+        error = "无法创建录音写入器: " + file.getFullPathName().toStdString();
+        return nullptr;
+    }
+
+    // 写入器已接管输出流
+    outputStream.release();
+    return writer;
+}
+
+} // namespace WindsynthVST::AudioGraph
@@ -0,0 +1,241 @@
+//
+//  DiskRecorder.hpp
+//  WindsynthRecorder
+//
+//  Created by AI Assistant
+//  多轨磁盘录音引擎
+//
+
+#pragma once
+
+#include <JuceHeader.h>
+#include <memory>
+#include <vector>
+#include <string>
+#include <atomic>
+#include <mutex>
+#include <cstdint>
+#include "../Core/AudioGraphTypes.hpp"
+
+namespace WindsynthVST::AudioGraph {
+
+/**
+ * 多轨磁盘录音引擎
+ *
+ * 数据流：
+ * - 音频线程在设备回调中把处理前（输入）和处理后（输出）的数据写入预分配的无锁采集FIFO，
+ *   FIFO空间不足时丢弃该块并累加溢出计数，绝不阻塞
+ * - 后台线程从FIFO取出数据，按轨道和穿插录音区间分发给各轨道的 ThreadedWriter
+ * - ThreadedWriter 在独立的磁盘线程中编码并写入文件（磁盘缓冲区大小可配置）
+ *
+ * 每个轨道对应一个文件，可以选择采集点和通道范围。
+ * 穿插录音（punch in/out）以采集时间轴上的采样位置计算，精确到采样。
+ */
+class DiskRecorder : public AudioCaptureSink,
+                     private juce::Thread {
+public:
+    //==============================================================================
+    // 类型定义
+    //==============================================================================
+
+    /**
+     * 录音文件格式
+     */
+    enum class FileFormat {
+        WAV = 0,
+        AIFF = 1
+    };
+
+    /**
+     * 轨道配置
+     */
+    struct TrackConfig {
+        std::string name;
+        CapturePoint source = CapturePoint::PreGraph;
+        int firstChannel = 0;
+        int numChannels = 1;
+
+        TrackConfig() = default;
+        TrackConfig(const std::string& n, CapturePoint src, int first, int count)
+            : name(n), source(src), firstChannel(first), numChannels(count) {}
+    };
+
+    /**
+     * 录音设置
+     */
+    struct RecordingSettings {
+        std::string outputDirectory;
+        std::string takeName = "Take";
+        FileFormat format = FileFormat::WAV;
+        int bitDepth = 24;
+        double sampleRate = 0.0;            // 设备采样率
+        int numInputChannels = 0;           // 设备输入通道数（PreGraph）
+        int numOutputChannels = 0;          // 设备输出通道数（PostGraph）
+        int diskBufferSamples = 131072;     // 每个轨道的磁盘写入缓冲区（采样数）
+        int captureBufferSamples = 0;       // 采集FIFO容量（采样数），0 表示 2 秒
+    };
+
+    /**
+     * 录音统计信息
+     */
+    struct RecordingStatistics {
+        bool isRecording = false;
+        int64_t samplesCaptured = 0;        // 采集时间轴位置
+        int64_t samplesWritten = 0;         // 已写入文件的采样数（每轨）
+        uint64_t captureOverruns = 0;       // 采集FIFO溢出次数（音频线程丢块）
+        uint64_t droppedSamples = 0;        // 因溢出丢弃的采样数
+        uint64_t diskStalls = 0;            // 磁盘缓冲区已满、写入线程等待的次数
+        float captureBufferFill = 0.0f;     // 采集FIFO占用率（0-1）
+        bool punchEnabled = false;
+        int64_t punchInSample = 0;
+        int64_t punchOutSample = 0;
+        int numTracks = 0;
+    };
+
+    //==============================================================================
+    // 构造函数和析构函数
+    //==============================================================================
+
+    DiskRecorder();
+    ~DiskRecorder() override;
+
+    //==============================================================================
+    // 录音控制（消息线程）
+    //==============================================================================
+
+    /**
+     * 开始录音
+     * @param settings 录音设置
+     * @param tracks 轨道配置
+     * @param error 失败时的错误信息
+     * @return 成功返回true
+     */
+    bool startRecording(const RecordingSettings& settings,
+                        const std::vector<TrackConfig>& tracks,
+                        std::string& error);
+
+    /**
+     * 停止录音，写完所有缓冲数据并关闭文件
+     */
+    void stopRecording();
+
+    /**
+     * 是否正在录音
+     */
+    bool isRecording() const { return recording.load(); }
+
+    /**
+     * 获取当前（或最近一次）录音的轨道文件路径
+     */
+    std::vector<std::string> getTrackFiles() const;
+
+    //==============================================================================
+    // 穿插录音
+    //==============================================================================
+
+    /**
+     * 设置穿插录音区间（采集时间轴上的采样位置，out <= in 表示不限结束位置）
+     */
+    void setPunchRange(int64_t punchInSample, int64_t punchOutSample);
+
+    /**
+     * 取消穿插录音区间（写入全部采集数据）
+     */
+    void clearPunchRange();
+
+    /**
+     * 从当前位置开始写入
+     */
+    void punchIn();
+
+    /**
+     * 从当前位置停止写入
+     */
+    void punchOut();
+
+    //==============================================================================
+    // 统计信息
+    //==============================================================================
+
+    RecordingStatistics getStatistics() const;
+
+    //==============================================================================
+    // AudioCaptureSink 接口（音频线程）
+    //==============================================================================
+
+    void captureAudio(CapturePoint point,
+                      const float* const* channelData,
+                      int numChannels,
+                      int numSamples) noexcept override;
+
+private:
+    //==============================================================================
+    // 内部类型
+    //==============================================================================
+
+    struct Track {
+        TrackConfig config;
+        juce::File file;
+        std::unique_ptr<juce::AudioFormatWriter::ThreadedWriter> writer;
+        std::vector<int> fifoChannels;              // 对应采集FIFO中的通道
+        std::vector<const float*> channelPointers;  // 写入时使用的通道指针（预分配）
+    };
+
+    //==============================================================================
+    // 内部成员变量
+    //==============================================================================
+
+    mutable std::mutex controlMutex;
+    RecordingSettings currentSettings;
+    std::vector<std::unique_ptr<Track>> tracks;
+    std::vector<std::string> trackFiles;        // 最近一次录音的文件（停止后保留）
+    juce::TimeSliceThread diskThread{"Disk Recorder Writer"};
+
+    // 采集FIFO：通道 [0, numPreChannels) 为输入，其后为输出
+    juce::AbstractFifo captureFifo{1};
+    juce::AudioBuffer<float> captureBuffer;
+    int numPreChannels = 0;
+    int numPostChannels = 0;
+
+    // 音频线程写入状态（仅音频线程访问）
+    int pendingStart1 = 0, pendingSize1 = 0;
+    int pendingStart2 = 0, pendingSize2 = 0;
+    int pendingSamples = 0;
+    bool pendingBlockValid = false;
+
+    // 状态和统计
+    std::atomic<bool> recording{false};
+    std::atomic<int> activeCaptureCalls{0};
+    std::atomic<int64_t> samplesCaptured{0};
+    std::atomic<int64_t> samplesWritten{0};
+    std::atomic<uint64_t> captureOverruns{0};
+    std::atomic<uint64_t> droppedSamples{0};
+    std::atomic<uint64_t> diskStalls{0};
+
+    // 穿插录音
+    std::atomic<bool> punchEnabled{false};
+    std::atomic<int64_t> punchInSample{0};
+    std::atomic<int64_t> punchOutSample{0};
+
+    // 写入线程的时间轴位置（仅写入线程访问）
+    int64_t samplesConsumed = 0;
+
+    //==============================================================================
+    // 内部方法
+    //==============================================================================
+
+    void run() override;
+    int drainCaptureFifo();
+    void writeRegion(int fifoStart, int numSamples);
+    bool writeTrack(Track& track, int fifoStart, int numSamples);
+    void closeTracks();
+    void discardTracks();
+
+    std::unique_ptr<juce::AudioFormatWriter> createWriter(const juce::File& file,
+                                                          int numChannels,
+                                                          std::string& error) const;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(DiskRecorder)
+};
+
+} // namespace WindsynthVST::AudioGraph
@@ -0,0 +1,100 @@
+//
+//  BatchRenderMain.cpp
+//  WindsynthRecorder
+//
+//  Created by AI Assistant
+//  批量渲染入口
+//
+//  用法: WindsynthBatchRender <任务清单.json> [--report <文件>] [--jobs <数量>]
+//    --report  JSON 报告写入文件（默认输出到标准输出）
+//    --jobs    并行任务数，覆盖清单中的 maxParallelJobs
+//
+//  返回值: 0 全部成功，1 有任务失败或报告无法写入，2 参数或任务清单错误
+//
+
+#include "BatchRenderService.hpp"
+#include "AudioGraph/Core/Logger.hpp"
+#include <iostream>
+#include <thread>
+
+namespace {
+
+constexpr const char* usage = "用法: WindsynthBatchRender <任务清单.json> [--report <文件>] [--jobs <数量>]\n";
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    juce::ScopedJuceInitialiser_GUI juceInitialiser;
+
+    juce::StringArray arguments;
+    for (int i = 1; i < argc; ++i) {
+        arguments.add(juce::String::fromUTF8(argv[i]));
+    }
+
+    juce::File manifestFile;
+    juce::File reportFile;
+    int parallelJobs = 0;
+
+    for (int i = 0; i < arguments.size(); ++i) {
+        const auto& argument = arguments[i];
+        if (argument == "--report" && i + 1 < arguments.size()) {
+            reportFile = juce::File::getCurrentWorkingDirectory().getChildFile(arguments[++i]);
+        } else if (argument == "--jobs" && i + 1 < arguments.size()) {
+            parallelJobs = arguments[++i].getIntValue();
+        } else if (!argument.startsWith("--") && manifestFile == juce::File()) {
+            manifestFile = juce::File::getCurrentWorkingDirectory().getChildFile(argument);
+        } else {
+            std::cerr << "未知参数: " << argument << "\n" << usage;
+            return 2;
+        }
+    }
+
+    if (manifestFile == juce::File()) {
+        std::cerr << usage;
+        return 2;
+    }
+
+    // 只保留警告；报告写入文件时才输出任务进度，避免混入标准输出中的报告
+    auto& logger = WindsynthVST::AudioGraph::Logger::getInstance();
+    logger.setMinimumLevel(WindsynthVST::AudioGraph::LogLevel::Warning);
+    if (reportFile != juce::File()) {
+        logger.setCategoryLevel("BatchRender", WindsynthVST::AudioGraph::LogLevel::Info);
+    }
+
+    WindsynthVST::BatchRender::BatchManifest manifest;
+    std::string error;
+    if (!WindsynthVST::BatchRender::BatchManifest::load(manifestFile, manifest, error)) {
+        std::cerr << error << std::endl;
+        return 2;
+    }
+    if (parallelJobs > 0) {
+        manifest.maxParallelJobs = parallelJobs;
+    }
+
+    bool allSucceeded = false;
+    juce::String report;
+    {
+        WindsynthVST::BatchRender::BatchRenderService service(std::move(manifest));
+
+        // 插件实例在消息线程中创建：主线程运行消息循环，批量渲染在后台线程进行，结束后退出消息循环
+        std::thread renderThread([&service, &allSucceeded, &report] {
+            allSucceeded = service.run();
+            report = service.toJson();
+            juce::MessageManager::callAsync([] { juce::MessageManager::getInstance()->stopDispatchLoop(); });
+        });
+
+        juce::MessageManager::getInstance()->runDispatchLoop();
+        renderThread.join();
+    }
+
+    logger.flush();
+
+    if (reportFile == juce::File()) {
+        std::cout << report << std::endl;
+    } else if (!reportFile.replaceWithText(report)) {
+        std::cerr << "无法写入报告: " << reportFile.getFullPathName() << std::endl;
+        return 1;
+    }
+
+    return allSucceeded ? 0 : 1;
+}
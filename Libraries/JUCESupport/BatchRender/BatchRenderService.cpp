@@ -0,0 +1,543 @@
+//
+//  BatchRenderService.cpp
+//  WindsynthRecorder
+//
+//  Created by AI Assistant
+//  无界面批量渲染服务实现
+//
+
+#include "BatchRenderService.hpp"
+#include "AudioGraph/Core/GraphAudioProcessor.hpp"
+#include "AudioGraph/Core/Logger.hpp"
+#include "AudioGraph/Plugins/ModernPluginLoader.hpp"
+#include "AudioGraph/Management/PresetLibrary.hpp"
+#include "AudioGraph/Management/PresetManager.hpp"
+#include "Engine/Render/OfflineRenderEngine.hpp"
+#include <algorithm>
+#include <atomic>
+#include <mutex>
+#include <numeric>
+#include <thread>
+
+namespace WindsynthVST::BatchRender {
+
+namespace {
+
+using Engine::Render::RenderSettings;
+
+double secondsSince(juce::int64 startTicks) {
+    return juce::Time::highResolutionTicksToSeconds(juce::Time::getHighResolutionTicks() - startTicks);
+}
+
+juce::File resolvePath(const juce::File& baseDirectory, const juce::String& path) {
+    return juce::File::isAbsolutePath(path) || path.startsWithChar('~') ? juce::File(path)
+                                                                          : baseDirectory.getChildFile(path);
+}
+
+/**
+ * 把 JSON 对象中列出的字段写入渲染设置（未列出的字段保持不变）
+ */
+bool applySettings(const juce::var& object, RenderSettings& settings, std::string& error) {
+    if (object.isVoid()) {
+        return true;
+    }
+
+    auto* properties = object.getDynamicObject();
+    if (properties == nullptr) {
+        error = "settings 必须是对象";
+        return false;
+    }
+
+    for (const auto& property : properties->getProperties()) {
+        const auto key = property.name.toString();
+        const auto& value = property.value;
+
+        if (key == "sampleRate") {
+            settings.sampleRate = static_cast<int32_t>(value);
+        } else if (key == "bitDepth") {
+            settings.bitDepth = static_cast<int32_t>(value);
+        } else if (key == "numChannels") {
+            settings.numChannels = static_cast<int32_t>(value);
+        } else if (key == "format") {
+            const auto format = value.toString().toLowerCase();
+            if (format == "wav") {
+                settings.format = RenderSettings::Format::WAV;
+            } else if (format == "aiff") {
+                settings.format = RenderSettings::Format::AIFF;
+            } else {
+                error = "不支持的输出格式: " + format.toStdString();
+                return false;
+            }
+        } else if (key == "normalize") {
+            settings.normalizeOutput = static_cast<bool>(value);
+        } else if (key == "normalizationMode") {
+            const auto mode = value.toString().toLowerCase();
+            if (mode == "peak") {
+                settings.normalizationMode = RenderSettings::NormalizationMode::Peak;
+            } else if (mode == "loudness") {
+                settings.normalizationMode = RenderSettings::NormalizationMode::Loudness;
+            } else {
+                error = "不支持的归一化方式: " + mode.toStdString();
+                return false;
+            }
+        } else if (key == "targetPeakDb") {
+            settings.targetPeakDb = static_cast<float>(value);
+        } else if (key == "targetLoudnessLUFS") {
+            settings.targetLoudnessLUFS = static_cast<float>(value);
+        } else if (key == "peakCeilingDb") {
+            settings.peakCeilingDb = static_cast<float>(value);
+        } else if (key == "includePluginTails") {
+            settings.includePluginTails = static_cast<bool>(value);
+        } else if (key == "tailMode") {
+            const auto mode = value.toString().toLowerCase();
+            if (mode == "reported") {
+                settings.tailMode = RenderSettings::TailMode::ReportedLength;
+            } else if (mode == "silence") {
+                settings.tailMode = RenderSettings::TailMode::SilenceDetection;
+            } else {
+                error = "不支持的尾音方式: " + mode.toStdString();
+                return false;
+            }
+        } else if (key == "maxTailSeconds") {
+            settings.maxTailSeconds = static_cast<float>(value);
+        } else if (key == "tailSilenceThresholdDb") {
+            settings.tailSilenceThresholdDb = static_cast<float>(value);
+        } else if (key == "tailSilenceHoldMs") {
+            settings.tailSilenceHoldMs = static_cast<float>(value);
+        } else {
+            error = "未知的渲染设置: " + key.toStdString();
+            return false;
+        }
+    }
+
+    return true;
+}
+
+juce::var toVar(const RenderSettings& settings) {
+    auto object = std::make_unique<juce::DynamicObject>();
+    object->setProperty("sampleRate", settings.sampleRate);
+    object->setProperty("bitDepth", settings.bitDepth);
+    object->setProperty("numChannels", settings.numChannels);
+    object->setProperty("format", settings.format == RenderSettings::Format::AIFF ? "aiff" : "wav");
+    object->setProperty("normalize", settings.normalizeOutput);
+    if (settings.normalizeOutput) {
+        object->setProperty("normalizationMode",
+                            settings.normalizationMode == RenderSettings::NormalizationMode::Loudness ? "loudness" : "peak");
+    }
+    object->setProperty("includePluginTails", settings.includePluginTails);
+    return juce::var(object.release());
+}
+
+} // namespace
+
+//==============================================================================
+// 任务清单
+//==============================================================================
+
+bool BatchManifest::load(const juce::File& manifestFile, BatchManifest& manifest, std::string& error) {
+    if (!manifestFile.existsAsFile()) {
+        error = "任务清单不存在: " + manifestFile.getFullPathName().toStdString();
+        return false;
+    }
+
+    juce::var root;
+    const auto parseResult = juce::JSON::parse(manifestFile.loadFileAsString(), root);
+    if (parseResult.failed() || root.getDynamicObject() == nullptr) {
+        error = "无法解析任务清单: " + parseResult.getErrorMessage().toStdString();
+        return false;
+    }
+
+    const auto baseDirectory = manifestFile.getParentDirectory();
+    manifest = BatchManifest();
+
+    const auto presetLibrary = root.getProperty("presetLibrary", {}).toString();
+    manifest.presetLibraryDirectory = presetLibrary.isEmpty() ? AudioGraph::PresetManager::getDefaultPresetLibraryDirectory()
+                                                              : resolvePath(baseDirectory, presetLibrary);
+
+    const auto outputDirectoryPath = root.getProperty("outputDirectory", {}).toString();
+    const auto outputDirectory = outputDirectoryPath.isEmpty() ? baseDirectory : resolvePath(baseDirectory, outputDirectoryPath);
+
+    manifest.maxParallelJobs = static_cast<int>(root.getProperty("maxParallelJobs", 0));
+
+    const auto budgetMB = static_cast<juce::int64>(root.getProperty("clipCacheBudgetMB", 0));
+    if (budgetMB > 0) {
+        manifest.clipCacheBudgetBytes = static_cast<size_t>(budgetMB) * 1024 * 1024;
+    }
+
+    RenderSettings defaultSettings;
+    if (!applySettings(root.getProperty("settings", {}), defaultSettings, error)) {
+        return false;
+    }
+    const auto defaultPreset = root.getProperty("preset", {}).toString().toStdString();
+
+    const auto* jobs = root.getProperty("jobs", {}).getArray();
+    if (jobs == nullptr || jobs->isEmpty()) {
+        error = "任务清单没有任务";
+        return false;
+    }
+
+    for (int i = 0; i < jobs->size(); ++i) {
+        const auto& entry = jobs->getReference(i);
+        const auto input = entry.getProperty("input", {}).toString();
+        if (input.isEmpty()) {
+            error = "任务 " + std::to_string(i) + " 缺少 input";
+            return false;
+        }
+
+        BatchJob job;
+        job.inputPath = resolvePath(baseDirectory, input).getFullPathName().toStdString();
+        job.presetName = entry.hasProperty("preset") ? entry.getProperty("preset", {}).toString().toStdString()
+                                                     : defaultPreset;
+        job.settings = defaultSettings;
+        if (!applySettings(entry.getProperty("settings", {}), job.settings, error)) {
+            error = "任务 " + std::to_string(i) + ": " + error;
+            return false;
+        }
+
+        const auto output = entry.getProperty("output", {}).toString();
+        if (output.isNotEmpty()) {
+            job.outputPath = resolvePath(outputDirectory, output).getFullPathName().toStdString();
+        } else {
+            const auto extension = job.settings.format == RenderSettings::Format::AIFF ? ".aiff" : ".wav";
+            job.outputPath = outputDirectory.getChildFile(juce::File(job.inputPath).getFileNameWithoutExtension()
+                                                          + "_render" + extension).getFullPathName().toStdString();
+        }
+
+        if (job.outputPath == job.inputPath) {
+            error = "任务 " + std::to_string(i) + " 的输出会覆盖输入文件";
+            return false;
+        }
+
+        manifest.jobs.push_back(std::move(job));
+    }
+
+    return true;
+}
+
+//==============================================================================
+// 构造函数和析构函数
+//==============================================================================
+
+BatchRenderService::BatchRenderService(BatchManifest manifestToRun)
+    : manifest(std::move(manifestToRun))
+{
+    formatManager = std::make_shared<juce::AudioFormatManager>();
+    formatManager->registerBasicFormats();
+    clipCache = std::make_shared<Engine::Core::AudioClipCache>(formatManager, manifest.clipCacheBudgetBytes);
+}
+
+BatchRenderService::~BatchRenderService() = default;
+
+//==============================================================================
+// 执行
+//==============================================================================
+
+bool BatchRenderService::run() {
+    // 在消息线程中等待工作线程会使插件实例化永远无法完成
+    jassert(!juce::MessageManager::getInstance()->isThisTheMessageThread());
+
+    const auto batchStart = juce::Time::getHighResolutionTicks();
+    const auto& jobs = manifest.jobs;
+
+    reports.assign(jobs.size(), BatchJobReport());
+    for (size_t i = 0; i < jobs.size(); ++i) {
+        reports[i].job = jobs[i];
+        reports[i].result.inputPath = jobs[i].inputPath;
+        reports[i].result.outputPath = jobs[i].outputPath;
+    }
+
+    loadPresetSnapshots();
+
+    // 按预设排序，工作线程连续领取相同预设的任务时可以复用图实例
+    std::vector<size_t> order(jobs.size());
+    std::iota(order.begin(), order.end(), size_t{0});
+    std::stable_sort(order.begin(), order.end(), [&jobs](size_t a, size_t b) {
+        return jobs[a].presetName < jobs[b].presetName;
+    });
+
+    // 专用渲染机器上没有实时音频需要保留核心
+    const int maxWorkers = manifest.maxParallelJobs > 0 ? manifest.maxParallelJobs : juce::SystemStats::getNumCpus();
+    numWorkers = juce::jlimit(1, static_cast<int>(jobs.size()), maxWorkers);
+
+    WSLOG_INFO("BatchRender", "开始批量渲染，任务数: " << jobs.size() << "，工作线程: " << numWorkers
+            << "，预设数: " << presetSnapshots.size());
+
+    // 所有工作线程共享一个渲染引擎（渲染状态都在调用栈上）和已解码文件缓存
+    Engine::Render::OfflineRenderEngine renderEngine(formatManager);
+    renderEngine.setClipCache(clipCache);
+    const auto pluginFactory = createPluginFactory();
+    const int blockSize = Engine::Render::OfflineRenderEngine::Options().blockSize;
+
+    std::atomic<size_t> nextJob{0};
+    std::mutex logMutex;
+
+    auto worker = [&](int workerIndex) {
+        std::unique_ptr<AudioGraph::GraphAudioProcessor> graphInstance;
+        std::string currentPreset;
+        bool hasGraph = false;
+
+        for (;;) {
+            const size_t position = nextJob.fetch_add(1);
+            if (position >= order.size()) {
+                break;
+            }
+
+            const size_t jobIndex = order[position];
+            const auto& job = jobs[jobIndex];
+            auto& report = reports[jobIndex];
+            report.workerIndex = workerIndex;
+            report.startOffsetSeconds = secondsSince(batchStart);
+
+            std::string snapshotError;
+            const auto* snapshot = findSnapshot(job.presetName, snapshotError);
+            if (snapshot == nullptr) {
+                report.result.error = snapshotError;
+            } else {
+                // 预设变化时重建图实例
+                if (!hasGraph || currentPreset != job.presetName) {
+                    const auto setupStart = juce::Time::getHighResolutionTicks();
+                    if (graphInstance) {
+                        graphInstance->releaseResources();
+                    }
+                    graphInstance.reset();
+                    hasGraph = false;
+
+                    std::string graphError;
+                    if (snapshot->hasPlugins()) {
+                        graphInstance = Engine::Render::OfflineRenderEngine::createGraphInstance(
+                            *snapshot, pluginFactory, snapshot->config.sampleRate, blockSize, graphError);
+                    }
+
+                    if (snapshot->hasPlugins() && !graphInstance) {
+                        report.result.error = "无法创建音频图实例: " + graphError;
+                    } else {
+                        hasGraph = true;
+                        currentPreset = job.presetName;
+                    }
+                    report.graphSetupSeconds = secondsSince(setupStart);
+                }
+
+                if (hasGraph) {
+                    try {
+                        if (graphInstance) {
+                            graphInstance->reset();
+                        }
+                        juce::File(job.outputPath).getParentDirectory().createDirectory();
+                        report.result = renderEngine.renderFile(
+                            Engine::Render::RenderJob(job.inputPath, job.outputPath, job.settings),
+                            graphInstance.get(), graphInstance != nullptr, true);
+                    } catch (const std::exception& e) {
+                        report.result.error = "渲染异常: " + std::string(e.what());
+                    } catch (...) {
+                        report.result.error = "渲染异常: 未知异常";
+                    }
+                }
+            }
+
+            std::lock_guard<std::mutex> lock(logMutex);
+            if (report.result.success) {
+                WSLOG_INFO("BatchRender", "[" << (position + 1) << "/" << jobs.size() << "] 完成 "
+                        << juce::File(job.inputPath).getFileName()
+                        << "，耗时 " << juce::String(report.result.renderTimeSeconds, 2) << "s"
+                        << "，" << juce::String(report.result.realtimeFactor, 1) << "x 实时");
+            } else {
+                WSLOG_ERROR("BatchRender", "[" << (position + 1) << "/" << jobs.size() << "] 失败 "
+                        << juce::File(job.inputPath).getFileName() << ": " << report.result.error);
+            }
+        }
+
+        if (graphInstance) {
+            graphInstance->releaseResources();
+        }
+    };
+
+    std::vector<std::thread> workers;
+    workers.reserve(static_cast<size_t>(numWorkers));
+    for (int i = 0; i < numWorkers; ++i) {
+        workers.emplace_back(worker, i);
+    }
+    for (auto& thread : workers) {
+        thread.join();
+    }
+
+    wallSeconds = secondsSince(batchStart);
+
+    const int numFailed = getNumFailed();
+    WSLOG_INFO("BatchRender", "批量渲染结束，成功: " << (static_cast<int>(jobs.size()) - numFailed)
+            << "，失败: " << numFailed << "，总耗时: " << juce::String(wallSeconds, 2) << "s");
+    return numFailed == 0;
+}
+
+int BatchRenderService::getNumFailed() const {
+    return static_cast<int>(std::count_if(reports.begin(), reports.end(),
+                                          [](const BatchJobReport& report) { return !report.result.success; }));
+}
+
+//==============================================================================
+// 预设和插件
+//==============================================================================
+
+void BatchRenderService::loadPresetSnapshots() {
+    presetSnapshots.clear();
+
+    std::vector<std::string> presetNames;
+    for (const auto& job : manifest.jobs) {
+        if (!job.presetName.empty()
+            && std::find(presetNames.begin(), presetNames.end(), job.presetName) == presetNames.end()) {
+            presetNames.push_back(job.presetName);
+        }
+    }
+    if (presetNames.empty()) {
+        return;
+    }
+
+    // 预设库只在这里读取，之后工作线程只访问转换好的快照
+    AudioGraph::PresetLibrary library;
+    if (library.open(manifest.presetLibraryDirectory) < 0) {
+        WSLOG_ERROR("BatchRender", "无法打开预设库: " << manifest.presetLibraryDirectory.getFullPathName());
+    }
+
+    auto pluginLoader = AudioGraph::ModernPluginLoader::getSharedInstance();
+
+    for (const auto& presetName : presetNames) {
+        PresetSnapshot entry;
+        entry.presetName = presetName;
+
+        AudioGraph::PresetGraphState state;
+        if (!library.contains(presetName)) {
+            entry.error = "预设不存在: " + presetName;
+        } else if (!library.loadState(presetName, state)) {
+            entry.error = "无法读取预设数据: " + presetName;
+        } else if (AudioGraph::PresetManager::createGraphSnapshot(state, entry.snapshot, entry.error)) {
+            // 在分发任务前检查插件是否还在，缺少插件的预设不占用工作线程
+            for (const auto& node : entry.snapshot.nodes) {
+                if (pluginLoader && !pluginLoader->doesPluginStillExist(node.description)) {
+                    entry.error = "预设 " + presetName + " 使用的插件不存在: " + node.description.name.toStdString();
+                    break;
+                }
+            }
+        }
+
+        if (entry.error.empty()) {
+            WSLOG_INFO("BatchRender", "已加载预设: " << presetName << "，插件数: " << entry.snapshot.nodes.size());
+        } else {
+            WSLOG_ERROR("BatchRender", entry.error);
+        }
+        presetSnapshots.push_back(std::move(entry));
+    }
+}
+
+const AudioGraph::GraphSnapshot* BatchRenderService::findSnapshot(const std::string& presetName,
+                                                                  std::string& error) const {
+    // 不使用预设时只做格式转换
+    static const AudioGraph::GraphSnapshot emptySnapshot;
+    if (presetName.empty()) {
+        return &emptySnapshot;
+    }
+
+    auto it = std::find_if(presetSnapshots.begin(), presetSnapshots.end(),
+                           [&presetName](const PresetSnapshot& entry) { return entry.presetName == presetName; });
+    if (it == presetSnapshots.end()) {
+        error = "预设未加载: " + presetName;
+        return nullptr;
+    }
+    if (!it->error.empty()) {
+        error = it->error;
+        return nullptr;
+    }
+    return &it->snapshot;
+}
+
+AudioGraph::PluginInstanceFactory BatchRenderService::createPluginFactory() const {
+    auto pluginLoader = AudioGraph::ModernPluginLoader::getSharedInstance();
+
+    // 插件实例化在各工作线程间串行进行，插件格式的模块加载不保证线程安全
+    // （loadPluginSync 在消息线程以外调用时会等待消息线程完成创建）
+    auto instantiationMutex = std::make_shared<std::mutex>();
+    return [pluginLoader, instantiationMutex](const juce::PluginDescription& description, double sampleRate,
+                                              int blockSize, juce::String& error)
+        -> std::unique_ptr<juce::AudioPluginInstance> {
+        if (!pluginLoader) {
+            error = "插件加载器无效";
+            return nullptr;
+        }
+        std::lock_guard<std::mutex> lock(*instantiationMutex);
+        return pluginLoader->loadPluginSync(description, sampleRate, blockSize, error);
+    };
+}
+
+//==============================================================================
+// 报告
+//==============================================================================
+
+juce::String BatchRenderService::toJson() const {
+    auto system = std::make_unique<juce::DynamicObject>();
+    system->setProperty("os", juce::SystemStats::getOperatingSystemName());
+    system->setProperty("cpu", juce::SystemStats::getCpuModel());
+    system->setProperty("numCpus", juce::SystemStats::getNumCpus());
+    system->setProperty("host", juce::SystemStats::getComputerName());
+
+    double totalAudioSeconds = 0.0;
+    double totalRenderSeconds = 0.0;
+    juce::Array<juce::var> jobArray;
+
+    for (const auto& report : reports) {
+        const auto& result = report.result;
+        auto entry = std::make_unique<juce::DynamicObject>();
+        entry->setProperty("input", juce::String(report.job.inputPath));
+        entry->setProperty("output", juce::String(report.job.outputPath));
+        entry->setProperty("preset", juce::String(report.job.presetName));
+        entry->setProperty("settings", toVar(report.job.settings));
+        entry->setProperty("success", result.success);
+        if (!result.success) {
+            entry->setProperty("error", juce::String(result.error));
+        }
+        entry->setProperty("worker", report.workerIndex);
+        entry->setProperty("startOffsetSeconds", report.startOffsetSeconds);
+        entry->setProperty("graphSetupSeconds", report.graphSetupSeconds);
+        entry->setProperty("renderTimeSeconds", result.renderTimeSeconds);
+        entry->setProperty("audioDurationSeconds", result.audioDurationSeconds);
+        entry->setProperty("realtimeFactor", result.realtimeFactor);
+        entry->setProperty("samplesWritten", static_cast<juce::int64>(result.samplesWritten));
+        entry->setProperty("tailSamplesWritten", static_cast<juce::int64>(result.tailSamplesWritten));
+        entry->setProperty("peakLevel", result.peakLevel);
+        entry->setProperty("integratedLoudness", result.integratedLoudness);
+        entry->setProperty("appliedGain", result.appliedGain);
+        jobArray.add(juce::var(entry.release()));
+
+        if (result.success) {
+            totalAudioSeconds += result.audioDurationSeconds;
+            totalRenderSeconds += result.renderTimeSeconds;
+        }
+    }
+
+    const auto cacheStats = clipCache->getStatistics();
+    auto cache = std::make_unique<juce::DynamicObject>();
+    cache->setProperty("hits", static_cast<juce::int64>(cacheStats.hits));
+    cache->setProperty("misses", static_cast<juce::int64>(cacheStats.misses));
+    cache->setProperty("mappedOpens", static_cast<juce::int64>(cacheStats.mappedOpens));
+    cache->setProperty("evictions", static_cast<juce::int64>(cacheStats.evictions));
+    cache->setProperty("memoryBudgetBytes", static_cast<juce::int64>(cacheStats.memoryBudgetBytes));
+
+    // 总实时倍数按墙钟时间计算，反映并行后的实际吞吐量
+    auto summary = std::make_unique<juce::DynamicObject>();
+    summary->setProperty("numJobs", static_cast<int>(reports.size()));
+    summary->setProperty("numFailed", getNumFailed());
+    summary->setProperty("numWorkers", numWorkers);
+    summary->setProperty("wallSeconds", wallSeconds);
+    summary->setProperty("totalAudioSeconds", totalAudioSeconds);
+    summary->setProperty("totalRenderSeconds", totalRenderSeconds);
+    summary->setProperty("realtimeFactor", wallSeconds > 0.0 ? totalAudioSeconds / wallSeconds : 0.0);
+    summary->setProperty("clipCache", juce::var(cache.release()));
+
+    auto root = std::make_unique<juce::DynamicObject>();
+    root->setProperty("schema", "windsynth-batch-render/1");
+    root->setProperty("timestamp", juce::Time::getCurrentTime().toISO8601(true));
+    root->setProperty("system", juce::var(system.release()));
+    root->setProperty("summary", juce::var(summary.release()));
+    root->setProperty("jobs", jobArray);
+
+    return juce::JSON::toString(juce::var(root.release()));
+}
+
+} // namespace WindsynthVST::BatchRender
@@ -0,0 +1,134 @@
+//
+//  BatchRenderService.hpp
+//  WindsynthRecorder
+//
+//  Created by AI Assistant
+//  无界面批量渲染服务 - 按任务清单用预设渲染多个文件，输出每个任务的耗时统计
+//
+
+#pragma once
+
+#include <JuceHeader.h>
+#include <memory>
+#include <string>
+#include <vector>
+#include "Engine/Render/RenderTypes.hpp"
+#include "Engine/Core/AudioClipCache.hpp"
+#include "AudioGraph/Core/AudioGraphTypes.hpp"
+
+namespace WindsynthVST::BatchRender {
+
+/**
+ * 单个渲染任务
+ */
+struct BatchJob {
+    std::string inputPath;
+    std::string outputPath;
+    std::string presetName;                     // 为空时只做格式转换
+    Engine::Render::RenderSettings settings;
+};
+
+/**
+ * 任务清单（JSON）
+ *
+ * {
+ *   "presetLibrary": "Presets",            // 预设库目录（可选，默认使用应用的预设库）
+ *   "outputDirectory": "Renders",          // 未指定 output 的任务写到这里（可选，默认是清单所在目录）
+ *   "maxParallelJobs": 0,                  // 并行任务数（可选，<= 0 时使用全部CPU核心）
+ *   "clipCacheBudgetMB": 2048,             // 已解码文件缓存的内存预算（可选）
+ *   "preset": "Warm Lead",                 // 默认预设（可选）
+ *   "settings": { "sampleRate": 48000, "bitDepth": 24, "format": "wav",
+ *                 "normalize": true, "normalizationMode": "loudness", "targetLoudnessLUFS": -16 },
+ *   "jobs": [
+ *     { "input": "take1.wav" },
+ *     { "input": "take2.flac", "output": "take2_dry.aiff", "preset": "", "settings": { "format": "aiff" } }
+ *   ]
+ * }
+ *
+ * 相对路径相对于清单所在目录。任务的 settings 只覆盖列出的字段。
+ */
+struct BatchManifest {
+    juce::File presetLibraryDirectory;
+    int maxParallelJobs = 0;
+    size_t clipCacheBudgetBytes = Engine::Core::AudioClipCache::defaultMemoryBudgetBytes;
+    std::vector<BatchJob> jobs;
+
+    /**
+     * 读取任务清单
+     * @return 格式错误时返回false并设置error
+     */
+    static bool load(const juce::File& manifestFile, BatchManifest& manifest, std::string& error);
+};
+
+/**
+ * 单个任务的执行报告
+ */
+struct BatchJobReport {
+    BatchJob job;
+    Engine::Render::RenderResult result;
+    int workerIndex = -1;
+    double startOffsetSeconds = 0.0;    // 相对批量开始的时间
+    double graphSetupSeconds = 0.0;     // 为该任务重建音频图的耗时（与上一个任务预设相同时为0）
+};
+
+/**
+ * 批量渲染服务
+ *
+ * 不打开音频设备：预设从预设库读取并转换为图快照，
+ * 工作线程（数量按CPU核心数）各自依次领取任务，在独立的图实例上离线渲染。
+ * 插件实例化会转到消息线程执行，run() 期间消息线程必须在运行消息循环。
+ * 任务按预设排序后分发，同一工作线程连续处理相同预设时复用图实例。
+ * 所有任务共享进程级插件目录和一个已解码文件缓存，同一输入文件只解码一次。
+ */
+class BatchRenderService {
+public:
+    explicit BatchRenderService(BatchManifest manifest);
+    ~BatchRenderService();
+
+    /**
+     * 执行所有任务（阻塞直到全部完成；不能在消息线程调用）
+     * @return 有任务失败时返回false
+     */
+    bool run();
+
+    const std::vector<BatchJobReport>& getReports() const { return reports; }
+
+    int getNumFailed() const;
+
+    /**
+     * 生成 JSON 报告（系统信息、汇总统计和每个任务的耗时及实时倍数）
+     */
+    juce::String toJson() const;
+
+private:
+    //==============================================================================
+    // 内部方法
+    //==============================================================================
+
+    void loadPresetSnapshots();
+    const AudioGraph::GraphSnapshot* findSnapshot(const std::string& presetName, std::string& error) const;
+    AudioGraph::PluginInstanceFactory createPluginFactory() const;
+
+    //==============================================================================
+    // 内部成员变量
+    //==============================================================================
+
+    struct PresetSnapshot {
+        std::string presetName;
+        AudioGraph::GraphSnapshot snapshot;
+        std::string error;
+    };
+
+    BatchManifest manifest;
+    std::shared_ptr<juce::AudioFormatManager> formatManager;
+    std::shared_ptr<Engine::Core::AudioClipCache> clipCache;
+    std::vector<PresetSnapshot> presetSnapshots;
+    std::vector<BatchJobReport> reports;
+
+    int numWorkers = 0;
+    double wallSeconds = 0.0;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(BatchRenderService)
+};
+
+} // namespace WindsynthVST::BatchRender
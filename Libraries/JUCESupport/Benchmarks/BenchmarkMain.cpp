@@ -0,0 +1,73 @@
+//
+//  BenchmarkMain.cpp
+//  WindsynthRecorder
+//
+//  Created by AI Assistant
+//  基准测试入口
+//
+//  用法: WindsynthVSTCore_Bench [--output <文件>] [--filter <名称>] [--quick] [--scan]
+//    --output  JSON 报告写入文件（默认输出到标准输出）
+//    --filter  只运行名称包含该字符串的测试，例如 graph.parallel
+//    --quick   缩短测量时间
+//    --scan    同时测量系统插件目录的扫描时间（结果依赖本机安装的插件）
+//
+
+#include "BenchmarkSuite.hpp"
+#include "AudioGraph/Core/Logger.hpp"
+#include <iostream>
+
+int main(int argc, char* argv[]) {
+    juce::ScopedJuceInitialiser_GUI juceInitialiser;
+
+    juce::StringArray arguments;
+    for (int i = 1; i < argc; ++i) {
+        arguments.add(juce::String::fromUTF8(argv[i]));
+    }
+
+    WindsynthVST::Benchmarks::BenchmarkSuite::Options options;
+    juce::File outputFile;
+
+    for (int i = 0; i < arguments.size(); ++i) {
+        const auto& argument = arguments[i];
+        if (argument == "--output" && i + 1 < arguments.size()) {
+            outputFile = juce::File::getCurrentWorkingDirectory().getChildFile(arguments[++i]);
+        } else if (argument == "--filter" && i + 1 < arguments.size()) {
+            options.filter = arguments[++i];
+        } else if (argument == "--quick") {
+            options.quick = true;
+        } else if (argument == "--scan") {
+            options.includePluginScan = true;
+        } else {
+            std::cerr << "未知参数: " << argument << "\n"
+                      << "用法: WindsynthVSTCore_Bench [--output <文件>] [--filter <名称>] [--quick] [--scan]\n";
+            return 2;
+        }
+    }
+
+    // 引擎日志会干扰计时，只保留警告；报告写入文件时才输出测试进度，避免混入标准输出中的报告
+    auto& logger = WindsynthVST::AudioGraph::Logger::getInstance();
+    logger.setMinimumLevel(WindsynthVST::AudioGraph::LogLevel::Warning);
+    if (outputFile != juce::File()) {
+        logger.setCategoryLevel("Bench", WindsynthVST::AudioGraph::LogLevel::Info);
+    }
+
+    juce::String report;
+    {
+        WindsynthVST::Benchmarks::BenchmarkSuite suite(options);
+        suite.runAll();
+        report = suite.toJson();
+    }
+
+    logger.flush();
+
+    if (outputFile == juce::File()) {
+        std::cout << report << std::endl;
+        return 0;
+    }
+
+    if (!outputFile.replaceWithText(report)) {
+        std::cerr << "无法写入报告: " << outputFile.getFullPathName() << std::endl;
+        return 1;
+    }
+    return 0;
+}
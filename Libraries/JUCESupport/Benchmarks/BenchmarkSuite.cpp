@@ -0,0 +1,710 @@
+//
+//  BenchmarkSuite.cpp
+//  WindsynthRecorder
+//
+//  Created by AI Assistant
+//  无界面基准测试套件实现
+//
+
+#include "BenchmarkSuite.hpp"
+#include "SyntheticPlugin.hpp"
+#include "AudioGraph/Core/GraphAudioProcessor.hpp"
+#include "AudioGraph/Core/LevelAnalysis.hpp"
+#include "AudioGraph/Core/Logger.hpp"
+#include "AudioGraph/Plugins/ModernPluginLoader.hpp"
+#include "AudioGraph/Plugins/PluginScanCache.hpp"
+#include "AudioGraph/Management/PresetLibrary.hpp"
+#include "Engine/Render/OfflineRenderEngine.hpp"
+#include "Engine/Render/LoudnessMeter.hpp"
+#include <algorithm>
+#include <atomic>
+#include <numeric>
+
+namespace WindsynthVST::Benchmarks {
+
+namespace {
+
+constexpr double benchmarkSampleRate = 48000.0;
+constexpr int syntheticStages = 4;          // 每个合成插件的滤波器级数
+constexpr int warmupBlocks = 32;
+constexpr juce::uint32 pluginNodeBaseUID = 1000;
+
+/**
+ * 耗时分布（微秒）
+ */
+struct TimingSummary {
+    double meanUs = 0.0;
+    double medianUs = 0.0;
+    double p99Us = 0.0;
+    double maxUs = 0.0;
+};
+
+TimingSummary summarise(std::vector<double> samplesUs) {
+    TimingSummary summary;
+    if (samplesUs.empty()) {
+        return summary;
+    }
+
+    std::sort(samplesUs.begin(), samplesUs.end());
+    const auto count = samplesUs.size();
+    summary.meanUs = std::accumulate(samplesUs.begin(), samplesUs.end(), 0.0) / static_cast<double>(count);
+    summary.medianUs = samplesUs[count / 2];
+    summary.p99Us = samplesUs[std::min(count - 1, static_cast<size_t>(static_cast<double>(count) * 0.99))];
+    summary.maxUs = samplesUs.back();
+    return summary;
+}
+
+double elapsedUs(juce::int64 startTicks) {
+    const auto ticks = juce::Time::getHighResolutionTicks() - startTicks;
+    return juce::Time::highResolutionTicksToSeconds(ticks) * 1.0e6;
+}
+
+void fillWithNoise(juce::AudioBuffer<float>& buffer, juce::Random& random, float gain = 0.25f) {
+    for (int channel = 0; channel < buffer.getNumChannels(); ++channel) {
+        auto* data = buffer.getWritePointer(channel);
+        for (int i = 0; i < buffer.getNumSamples(); ++i) {
+            data[i] = (random.nextFloat() * 2.0f - 1.0f) * gain;
+        }
+    }
+}
+
+/**
+ * 构造合成插件图的快照
+ * @param branches false 时串联（输入 -> 1 -> 2 ... -> 输出），true 时所有节点并联在输入和输出之间
+ */
+AudioGraph::GraphSnapshot makeGraphSnapshot(int numNodes, bool branches, const AudioGraph::GraphConfig& config) {
+    using AudioGraph::NodeID;
+
+    AudioGraph::GraphSnapshot snapshot;
+    snapshot.config = config;
+    snapshot.audioInputNodeID = NodeID{1};
+    snapshot.audioOutputNodeID = NodeID{2};
+    snapshot.midiInputNodeID = NodeID{3};
+    snapshot.midiOutputNodeID = NodeID{4};
+
+    auto connectStereo = [&snapshot](NodeID source, NodeID destination) {
+        for (int channel = 0; channel < 2; ++channel) {
+            snapshot.connections.push_back({ { source, channel }, { destination, channel } });
+        }
+    };
+
+    NodeID previous = snapshot.audioInputNodeID;
+    for (int i = 0; i < numNodes; ++i) {
+        AudioGraph::GraphSnapshot::NodeSnapshot node;
+        node.nodeUID = pluginNodeBaseUID + static_cast<juce::uint32>(i);
+        node.name = "Synthetic " + std::to_string(i + 1);
+        node.description = SyntheticPlugin::makeDescription(syntheticStages);
+        snapshot.nodes.push_back(std::move(node));
+
+        const NodeID nodeID{ pluginNodeBaseUID + static_cast<juce::uint32>(i) };
+        if (branches) {
+            connectStereo(snapshot.audioInputNodeID, nodeID);
+            connectStereo(nodeID, snapshot.audioOutputNodeID);
+        } else {
+            connectStereo(previous, nodeID);
+            previous = nodeID;
+        }
+    }
+
+    if (!branches) {
+        connectStereo(previous, snapshot.audioOutputNodeID);
+    }
+    return snapshot;
+}
+
+juce::var toVar(const juce::NamedValueSet& values) {
+    auto object = std::make_unique<juce::DynamicObject>();
+    for (const auto& value : values) {
+        object->setProperty(value.name, value.value);
+    }
+    return juce::var(object.release());
+}
+
+} // namespace
+
+//==============================================================================
+// 构造函数和析构函数
+//==============================================================================
+
+BenchmarkSuite::BenchmarkSuite(const Options& opts)
+    : options(opts)
+{
+    auto baseDirectory = options.workDirectory != juce::File()
+                             ? options.workDirectory
+                             : juce::File::getSpecialLocation(juce::File::tempDirectory);
+    workDirectory = baseDirectory.getNonexistentChildFile("WindsynthBench", "");
+    workDirectory.createDirectory();
+}
+
+BenchmarkSuite::~BenchmarkSuite() {
+    workDirectory.deleteRecursively();
+}
+
+//==============================================================================
+// 运行
+//==============================================================================
+
+void BenchmarkSuite::runAll() {
+    runGraphBenchmarks();
+    runRenderBenchmarks();
+    runMeteringBenchmarks();
+    runPluginListBenchmarks();
+    if (options.includePluginScan) {
+        runPluginScanBenchmark();
+    }
+    runPresetBenchmarks();
+}
+
+bool BenchmarkSuite::shouldRun(const juce::String& name) const {
+    return options.filter.isEmpty() || name.contains(options.filter);
+}
+
+void BenchmarkSuite::addResult(BenchmarkResult result) {
+    WSLOG_INFO("Bench", "完成 " << result.name);
+    results.push_back(std::move(result));
+}
+
+//==============================================================================
+// 音频图
+//==============================================================================
+
+void BenchmarkSuite::runGraphBenchmarks() {
+    const std::vector<int> nodeCounts = { 1, 8, 32 };
+    const std::vector<int> blockSizes = { 64, 256, 1024 };
+    const double measureSeconds = options.quick ? 0.5 : 5.0;
+
+    struct Variant {
+        const char* name;
+        bool branches;
+        bool parallelScheduler;
+    };
+    const Variant variants[] = {
+        { "graph.serial", false, false },
+        { "graph.parallel", true, false },
+        { "graph.parallel", true, true },
+    };
+
+    for (const auto& variant : variants) {
+        if (!shouldRun(variant.name)) {
+            continue;
+        }
+
+        for (int numNodes : nodeCounts) {
+            for (int blockSize : blockSizes) {
+                AudioGraph::GraphConfig config;
+                config.sampleRate = benchmarkSampleRate;
+                config.samplesPerBlock = blockSize;
+                config.numInputChannels = 2;
+                config.numOutputChannels = 2;
+
+                AudioGraph::GraphAudioProcessor graph;
+                graph.configure(config);
+
+                std::string error;
+                if (!graph.restoreGraphSnapshot(makeGraphSnapshot(numNodes, variant.branches, config),
+                                                SyntheticPlugin::makeFactory(), error)) {
+                    WSLOG_ERROR("Bench", variant.name << " 构建图失败: " << error);
+                    continue;
+                }
+
+                graph.prepareToPlay(benchmarkSampleRate, blockSize);
+                if (variant.parallelScheduler) {
+                    graph.setParallelProcessingEnabled(true);
+                }
+
+                juce::AudioBuffer<float> buffer(2, blockSize);
+                juce::MidiBuffer midi;
+                juce::Random random(numNodes * 31 + blockSize);
+
+                const int numBlocks = juce::jmax(200, static_cast<int>(measureSeconds * benchmarkSampleRate / blockSize));
+                std::vector<double> blockTimesUs;
+                blockTimesUs.reserve(static_cast<size_t>(numBlocks));
+
+                for (int block = 0; block < warmupBlocks + numBlocks; ++block) {
+                    fillWithNoise(buffer, random);
+                    midi.clear();
+
+                    const auto start = juce::Time::getHighResolutionTicks();
+                    graph.processBlock(buffer, midi);
+                    const double us = elapsedUs(start);
+
+                    if (block >= warmupBlocks) {
+                        blockTimesUs.push_back(us);
+                    }
+                }
+
+                graph.setParallelProcessingEnabled(false);
+                graph.releaseResources();
+
+                const auto timing = summarise(std::move(blockTimesUs));
+                const double blockDurationUs = blockSize / benchmarkSampleRate * 1.0e6;
+
+                BenchmarkResult result;
+                result.name = variant.name;
+                result.parameters.set("nodes", numNodes);
+                result.parameters.set("blockSize", blockSize);
+                result.parameters.set("sampleRate", benchmarkSampleRate);
+                result.parameters.set("stagesPerNode", syntheticStages);
+                result.parameters.set("parallelScheduler", variant.parallelScheduler);
+                result.parameters.set("blocks", numBlocks);
+                result.metrics.set("meanUs", timing.meanUs);
+                result.metrics.set("medianUs", timing.medianUs);
+                result.metrics.set("p99Us", timing.p99Us);
+                result.metrics.set("maxUs", timing.maxUs);
+                result.metrics.set("budgetPercent", timing.meanUs / blockDurationUs * 100.0);
+                result.metrics.set("p99BudgetPercent", timing.p99Us / blockDurationUs * 100.0);
+                result.metrics.set("realtimeFactor", timing.meanUs > 0.0 ? blockDurationUs / timing.meanUs : 0.0);
+                addResult(std::move(result));
+            }
+        }
+    }
+}
+
+//==============================================================================
+// 离线渲染
+//==============================================================================
+
+juce::File BenchmarkSuite::createNoiseFile(double seconds, double sampleRate) {
+    auto file = workDirectory.getChildFile("noise_" + juce::String(static_cast<int>(seconds)) + "s.wav");
+    if (file.existsAsFile()) {
+        return file;
+    }
+
+    juce::WavAudioFormat wavFormat;
+    std::unique_ptr<juce::FileOutputStream> outputStream(file.createOutputStream());
+    if (!outputStream) {
+        return {};
+    }
+
+    std::unique_ptr<juce::AudioFormatWriter> writer(wavFormat.createWriterFor(
+        outputStream.get(), sampleRate, 2, 24, {}, 0));
+    if (!writer) {
+        return {};
+    }
+
+    // 写入器已接管输出流
+    outputStream.release();
+
+    constexpr int chunkSize = 8192;
+    juce::AudioBuffer<float> chunk(2, chunkSize);
+    juce::Random random(42);
+    auto remaining = static_cast<juce::int64>(seconds * sampleRate);
+
+    while (remaining > 0) {
+        const int numSamples = static_cast<int>(juce::jmin<juce::int64>(chunkSize, remaining));
+        fillWithNoise(chunk, random);
+        writer->writeFromAudioSampleBuffer(chunk, 0, numSamples);
+        remaining -= numSamples;
+    }
+
+    return file;
+}
+
+void BenchmarkSuite::runRenderBenchmarks() {
+    if (!shouldRun("render.")) {
+        return;
+    }
+
+    const double inputSeconds = options.quick ? 10.0 : 120.0;
+    auto inputFile = createNoiseFile(inputSeconds, benchmarkSampleRate);
+    if (!inputFile.existsAsFile()) {
+        WSLOG_ERROR("Bench", "无法创建测试音频文件");
+        return;
+    }
+
+    auto formatManager = std::make_shared<juce::AudioFormatManager>();
+    formatManager->registerBasicFormats();
+
+    struct Variant {
+        const char* name;
+        int numNodes;
+        bool normalize;
+    };
+    const Variant variants[] = {
+        { "render.convert", 0, false },
+        { "render.graph", 8, false },
+        { "render.graphNormalize", 8, true },
+    };
+
+    for (const auto& variant : variants) {
+        if (!shouldRun(variant.name)) {
+            continue;
+        }
+
+        Engine::Render::RenderSettings settings;
+        settings.sampleRate = static_cast<int32_t>(benchmarkSampleRate);
+        settings.bitDepth = 24;
+        settings.numChannels = 2;
+        settings.normalizeOutput = variant.normalize;
+        settings.normalizationMode = Engine::Render::RenderSettings::NormalizationMode::Loudness;
+
+        Engine::Render::RenderJob job(inputFile.getFullPathName().toStdString(),
+                                      workDirectory.getChildFile(juce::String(variant.name) + ".wav")
+                                          .getFullPathName().toStdString(),
+                                      settings);
+
+        std::unique_ptr<AudioGraph::GraphAudioProcessor> graph;
+        Engine::Render::OfflineRenderEngine engine(formatManager);
+        const Engine::Render::OfflineRenderEngine::Options engineOptions{};
+
+        if (variant.numNodes > 0) {
+            AudioGraph::GraphConfig config;
+            config.sampleRate = benchmarkSampleRate;
+            config.samplesPerBlock = engineOptions.blockSize;
+            config.numInputChannels = 2;
+            config.numOutputChannels = 2;
+
+            std::string error;
+            graph = Engine::Render::OfflineRenderEngine::createGraphInstance(
+                makeGraphSnapshot(variant.numNodes, false, config), SyntheticPlugin::makeFactory(),
+                benchmarkSampleRate, engineOptions.blockSize, error);
+            if (!graph) {
+                WSLOG_ERROR("Bench", variant.name << " 构建图失败: " << error);
+                continue;
+            }
+        }
+
+        auto renderResult = engine.renderFile(job, graph.get(), graph != nullptr, graph != nullptr);
+        if (!renderResult.success) {
+            WSLOG_ERROR("Bench", variant.name << " 渲染失败: " << renderResult.error);
+            continue;
+        }
+
+        BenchmarkResult result;
+        result.name = variant.name;
+        result.parameters.set("nodes", variant.numNodes);
+        result.parameters.set("normalize", variant.normalize);
+        result.parameters.set("inputSeconds", inputSeconds);
+        result.parameters.set("blockSize", engineOptions.blockSize);
+        result.metrics.set("renderSeconds", renderResult.renderTimeSeconds);
+        result.metrics.set("audioSeconds", renderResult.audioDurationSeconds);
+        result.metrics.set("realtimeFactor", renderResult.realtimeFactor);
+        addResult(std::move(result));
+
+        juce::File(juce::String(job.outputPath)).deleteFile();
+    }
+}
+
+//==============================================================================
+// 电平测量
+//==============================================================================
+
+void BenchmarkSuite::runMeteringBenchmarks() {
+    const int blockSize = 512;
+    const int numBlocks = options.quick ? 2000 : 20000;
+
+    juce::AudioBuffer<float> buffer(2, blockSize);
+    juce::Random random(7);
+    fillWithNoise(buffer, random);
+
+    if (shouldRun("metering.levels")) {
+        volatile float sink = 0.0f;     // 防止编译器省略计算
+
+        const auto start = juce::Time::getHighResolutionTicks();
+        for (int block = 0; block < numBlocks; ++block) {
+            for (int channel = 0; channel < buffer.getNumChannels(); ++channel) {
+                auto levels = AudioGraph::LevelAnalysis::analyseChannel(buffer.getReadPointer(channel), blockSize);
+                sink = sink + levels.peak + levels.rms;
+            }
+        }
+        const double totalUs = elapsedUs(start);
+
+        BenchmarkResult result;
+        result.name = "metering.levels";
+        result.parameters.set("blockSize", blockSize);
+        result.parameters.set("channels", buffer.getNumChannels());
+        result.parameters.set("blocks", numBlocks);
+        result.metrics.set("usPerBlock", totalUs / numBlocks);
+        result.metrics.set("nsPerSample", totalUs * 1000.0 / (static_cast<double>(numBlocks) * blockSize * buffer.getNumChannels()));
+        addResult(std::move(result));
+    }
+
+    if (shouldRun("metering.loudness")) {
+        Engine::Render::LoudnessMeter meter;
+        meter.prepare(benchmarkSampleRate, buffer.getNumChannels());
+
+        const auto start = juce::Time::getHighResolutionTicks();
+        for (int block = 0; block < numBlocks; ++block) {
+            meter.process(buffer, buffer.getNumChannels(), blockSize);
+        }
+        const double processUs = elapsedUs(start);
+
+        const auto integrateStart = juce::Time::getHighResolutionTicks();
+        const double loudness = meter.getIntegratedLoudness();
+        const double integrateUs = elapsedUs(integrateStart);
+
+        BenchmarkResult result;
+        result.name = "metering.loudness";
+        result.parameters.set("blockSize", blockSize);
+        result.parameters.set("channels", buffer.getNumChannels());
+        result.parameters.set("blocks", numBlocks);
+        result.metrics.set("usPerBlock", processUs / numBlocks);
+        result.metrics.set("nsPerSample", processUs * 1000.0 / (static_cast<double>(numBlocks) * blockSize * buffer.getNumChannels()));
+        result.metrics.set("integrateUs", integrateUs);
+        result.metrics.set("integratedLufs", loudness);
+        addResult(std::move(result));
+    }
+}
+
+//==============================================================================
+// 插件列表
+//==============================================================================
+
+void BenchmarkSuite::runPluginListBenchmarks() {
+    const std::vector<int> listSizes = options.quick ? std::vector<int>{ 100 } : std::vector<int>{ 100, 1000, 5000 };
+
+    if (shouldRun("plugins.list")) {
+        for (int listSize : listSizes) {
+            auto listFile = workDirectory.getChildFile("plugins_" + juce::String(listSize) + ".xml");
+            {
+                juce::KnownPluginList list;
+                for (int i = 0; i < listSize; ++i) {
+                    auto description = SyntheticPlugin::makeDescription(i + 1);
+                    description.fileOrIdentifier = "/Library/Audio/Plug-Ins/VST3/Synthetic" + juce::String(i) + ".vst3";
+                    description.pluginFormatName = "VST3";
+                    list.addType(description);
+                }
+                if (auto xml = list.createXml()) {
+                    xml->writeTo(listFile);
+                }
+            }
+
+            AudioGraph::ModernPluginLoader loader;
+            loader.setScanCacheFile(workDirectory.getChildFile("PluginScanCache.journal"));
+
+            const auto loadStart = juce::Time::getHighResolutionTicks();
+            const bool loaded = loader.loadPluginList(listFile);
+            const double loadUs = elapsedUs(loadStart);
+
+            const auto saveStart = juce::Time::getHighResolutionTicks();
+            loader.savePluginList(workDirectory.getChildFile("plugins_saved.xml"));
+            const double saveUs = elapsedUs(saveStart);
+
+            BenchmarkResult result;
+            result.name = "plugins.list";
+            result.parameters.set("plugins", listSize);
+            result.metrics.set("loaded", loaded);
+            result.metrics.set("loadMs", loadUs / 1000.0);
+            result.metrics.set("saveMs", saveUs / 1000.0);
+            addResult(std::move(result));
+        }
+    }
+
+    if (shouldRun("plugins.scanCache")) {
+        for (int listSize : listSizes) {
+            auto journalFile = workDirectory.getChildFile("scan_" + juce::String(listSize) + ".journal");
+            {
+                AudioGraph::PluginScanCache cache(journalFile);
+                for (int i = 0; i < listSize; ++i) {
+                    auto description = SyntheticPlugin::makeDescription(i + 1);
+                    AudioGraph::PluginScanCache::Fingerprint fingerprint;
+                    fingerprint.modificationTime = 1000 + i;
+                    fingerprint.size = 4096;
+                    cache.record(description.fileOrIdentifier, description.pluginFormatName, fingerprint, { description });
+                }
+                cache.flush();
+            }
+
+            // 新实例第一次查询时加载日志
+            AudioGraph::PluginScanCache cache(journalFile);
+            int hits = 0;
+
+            const auto start = juce::Time::getHighResolutionTicks();
+            for (int i = 0; i < listSize; ++i) {
+                auto description = SyntheticPlugin::makeDescription(i + 1);
+                AudioGraph::PluginScanCache::Fingerprint fingerprint;
+                fingerprint.modificationTime = 1000 + i;
+                fingerprint.size = 4096;
+
+                juce::Array<juce::PluginDescription> types;
+                if (cache.lookup(description.fileOrIdentifier, description.pluginFormatName, fingerprint, types)) {
+                    ++hits;
+                }
+            }
+            const double lookupUs = elapsedUs(start);
+
+            BenchmarkResult result;
+            result.name = "plugins.scanCache";
+            result.parameters.set("bundles", listSize);
+            result.metrics.set("hits", hits);
+            result.metrics.set("loadAndLookupMs", lookupUs / 1000.0);
+            result.metrics.set("journalBytes", journalFile.getSize());
+            addResult(std::move(result));
+        }
+    }
+}
+
+void BenchmarkSuite::runPluginScanBenchmark() {
+    if (!shouldRun("plugins.scan")) {
+        return;
+    }
+
+    AudioGraph::ModernPluginLoader loader;
+    loader.setScanCacheFile(workDirectory.getChildFile("SystemScanCache.journal"));
+    loader.setDeadMansPedalFile(workDirectory.getChildFile("CrashedPlugins.txt"));
+
+    const int numFormats = loader.getSupportedFormats().size();
+    std::atomic<int> completedFormats{0};
+    juce::WaitableEvent scanFinished;
+
+    // 每种格式扫描完成时回调一次（在扫描线程中调用）
+    loader.setScanCompleteCallback([&completedFormats, &scanFinished, numFormats](int) {
+        if (completedFormats.fetch_add(1) + 1 >= numFormats) {
+            scanFinished.signal();
+        }
+    });
+
+    constexpr int scanTimeoutMs = 10 * 60 * 1000;
+
+    // 第一遍没有缓存，第二遍应全部命中增量扫描缓存
+    for (const char* pass : { "cold", "warm" }) {
+        completedFormats.store(0);
+        scanFinished.reset();
+
+        const auto start = juce::Time::getHighResolutionTicks();
+        loader.scanDefaultPathsFastAsync(false);
+        const bool finished = scanFinished.wait(scanTimeoutMs);
+        const double scanUs = elapsedUs(start);
+
+        if (!finished) {
+            loader.stopScanning();
+        }
+
+        const auto cacheStats = loader.getScanCacheStatistics();
+
+        BenchmarkResult result;
+        result.name = "plugins.scan";
+        result.parameters.set("pass", pass);
+        result.parameters.set("formats", numFormats);
+        result.metrics.set("finished", finished);
+        result.metrics.set("scanMs", scanUs / 1000.0);
+        result.metrics.set("plugins", loader.getNumKnownPlugins());
+        result.metrics.set("bundlesUnchanged", cacheStats.lastScanUnchanged);
+        result.metrics.set("bundlesRescanned", cacheStats.lastScanRescanned);
+        addResult(std::move(result));
+
+        if (!finished) {
+            break;
+        }
+
+        // 清空列表（保留扫描缓存），让第二遍重新填充
+        loader.clearPluginList();
+    }
+}
+
+//==============================================================================
+// 预设
+//==============================================================================
+
+void BenchmarkSuite::runPresetBenchmarks() {
+    if (!shouldRun("presets")) {
+        return;
+    }
+
+    const int numPresets = options.quick ? 50 : 500;
+    const int stateBytes = 256 * 1024;
+    auto presetDirectory = workDirectory.getChildFile("Presets");
+    presetDirectory.createDirectory();
+
+    // 写入预设
+    double storeUs = 0.0;
+    {
+        AudioGraph::PresetLibrary library;
+        library.open(presetDirectory);
+
+        juce::Random random(11);
+        for (int i = 0; i < numPresets; ++i) {
+            AudioGraph::PresetMetadata info;
+            info.name = "Preset " + std::to_string(i);
+            info.description = "Synthetic preset for benchmarking";
+            info.category = (i % 2 == 0) ? "Lead" : "Pad";
+            info.tags = { "bench", "synthetic" };
+
+            AudioGraph::PresetGraphState state;
+            state.graphData.setSize(1024);
+            state.pluginStates.setSize(static_cast<size_t>(stateBytes));
+            auto* bytes = static_cast<juce::uint8*>(state.pluginStates.getData());
+            for (int b = 0; b < stateBytes; ++b) {
+                // 半随机数据，接近真实插件状态的可压缩程度
+                bytes[b] = static_cast<juce::uint8>((b & 1) != 0 ? random.nextInt(256) : b >> 8);
+            }
+
+            const auto start = juce::Time::getHighResolutionTicks();
+            library.store(info, state);
+            storeUs += elapsedUs(start);
+        }
+    }
+
+    // 打开预设库（只读取元数据）
+    AudioGraph::PresetLibrary library;
+    const auto openStart = juce::Time::getHighResolutionTicks();
+    const int numOpened = library.open(presetDirectory);
+    const double openUs = elapsedUs(openStart);
+
+    // 加载状态
+    std::vector<double> loadTimesUs;
+    loadTimesUs.reserve(static_cast<size_t>(numPresets));
+    for (const auto& name : library.getAllNames()) {
+        AudioGraph::PresetGraphState state;
+        const auto start = juce::Time::getHighResolutionTicks();
+        library.loadState(name, state);
+        loadTimesUs.push_back(elapsedUs(start));
+    }
+    const auto loadTiming = summarise(std::move(loadTimesUs));
+
+    const auto searchStart = juce::Time::getHighResolutionTicks();
+    const auto matches = library.search("pre");
+    const double searchUs = elapsedUs(searchStart);
+
+    BenchmarkResult result;
+    result.name = "presets";
+    result.parameters.set("presets", numPresets);
+    result.parameters.set("stateBytes", stateBytes);
+    result.metrics.set("opened", numOpened);
+    result.metrics.set("storeMsPerPreset", storeUs / 1000.0 / numPresets);
+    result.metrics.set("openMs", openUs / 1000.0);
+    result.metrics.set("loadMeanUs", loadTiming.meanUs);
+    result.metrics.set("loadP99Us", loadTiming.p99Us);
+    result.metrics.set("searchUs", searchUs);
+    result.metrics.set("searchMatches", static_cast<int>(matches.size()));
+    addResult(std::move(result));
+}
+
+//==============================================================================
+// 报告
+//==============================================================================
+
+juce::String BenchmarkSuite::toJson() const {
+    auto system = std::make_unique<juce::DynamicObject>();
+    system->setProperty("os", juce::SystemStats::getOperatingSystemName());
+    system->setProperty("cpu", juce::SystemStats::getCpuModel());
+    system->setProperty("numCpus", juce::SystemStats::getNumCpus());
+    system->setProperty("numPhysicalCpus", juce::SystemStats::getNumPhysicalCpus());
+    system->setProperty("cpuSpeedMHz", juce::SystemStats::getCpuSpeedInMegahertz());
+    system->setProperty("juceVersion", juce::SystemStats::getJUCEVersion());
+#if JUCE_DEBUG
+    system->setProperty("build", "Debug");
+#else
+    system->setProperty("build", "Release");
+#endif
+
+    juce::Array<juce::var> resultArray;
+    for (const auto& result : results) {
+        auto entry = std::make_unique<juce::DynamicObject>();
+        entry->setProperty("name", juce::String(result.name));
+        entry->setProperty("parameters", toVar(result.parameters));
+        entry->setProperty("metrics", toVar(result.metrics));
+        resultArray.add(juce::var(entry.release()));
+    }
+
+    auto report = std::make_unique<juce::DynamicObject>();
+    report->setProperty("schema", "windsynth-bench/1");
+    report->setProperty("timestamp", juce::Time::getCurrentTime().toISO8601(true));
+    report->setProperty("quick", options.quick);
+    report->setProperty("system", juce::var(system.release()));
+    report->setProperty("results", resultArray);
+
+    return juce::JSON::toString(juce::var(report.release()));
+}
+
+} // namespace WindsynthVST::Benchmarks
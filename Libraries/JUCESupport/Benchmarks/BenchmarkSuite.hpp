@@ -0,0 +1,83 @@
+//
+//  BenchmarkSuite.hpp
+//  WindsynthRecorder
+//
+//  Created by AI Assistant
+//  无界面基准测试套件 - 音频图、离线渲染、电平测量、插件列表和预设
+//
+
+#pragma once
+
+#include <JuceHeader.h>
+#include <string>
+#include <vector>
+
+namespace WindsynthVST::Benchmarks {
+
+/**
+ * 单项基准测试结果
+ */
+struct BenchmarkResult {
+    std::string name;                   // 例如 "graph.serial"
+    juce::NamedValueSet parameters;     // 测试参数（节点数、块大小等）
+    juce::NamedValueSet metrics;        // 测量结果（单位写在名称后缀中，如 meanUs、realtimeFactor）
+};
+
+/**
+ * 基准测试套件
+ *
+ * 使用合成插件驱动音频图和引擎组件，不需要音频设备、消息循环或第三方插件，
+ * 结果以 JSON 输出，便于在不同提交之间比较，发现性能回退。
+ */
+class BenchmarkSuite {
+public:
+    struct Options {
+        juce::String filter;                // 只运行名称包含该字符串的测试（为空时全部运行）
+        bool quick = false;                 // 缩短测量时间（用于冒烟测试）
+        bool includePluginScan = false;     // 扫描系统插件目录（结果依赖本机安装的插件）
+        juce::File workDirectory;           // 临时文件目录（为空时使用系统临时目录）
+    };
+
+    explicit BenchmarkSuite(const Options& options);
+    ~BenchmarkSuite();
+
+    /**
+     * 运行所有（匹配过滤条件的）测试
+     */
+    void runAll();
+
+    const std::vector<BenchmarkResult>& getResults() const { return results; }
+
+    /**
+     * 生成 JSON 报告（包含系统信息和所有结果）
+     */
+    juce::String toJson() const;
+
+private:
+    //==============================================================================
+    // 测试
+    //==============================================================================
+
+    void runGraphBenchmarks();
+    void runRenderBenchmarks();
+    void runMeteringBenchmarks();
+    void runPluginListBenchmarks();
+    void runPluginScanBenchmark();
+    void runPresetBenchmarks();
+
+    //==============================================================================
+    // 内部方法
+    //==============================================================================
+
+    bool shouldRun(const juce::String& name) const;
+    void addResult(BenchmarkResult result);
+    juce::File createNoiseFile(double seconds, double sampleRate);
+
+    Options options;
+    juce::File workDirectory;
+    std::vector<BenchmarkResult> results;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(BenchmarkSuite)
+};
+
+} // namespace WindsynthVST::Benchmarks
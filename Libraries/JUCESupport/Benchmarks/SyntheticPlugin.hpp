@@ -0,0 +1,170 @@
+//
+//  SyntheticPlugin.hpp
+//  WindsynthRecorder
+//
+//  Created by AI Assistant
+//  基准测试用的合成插件 - 处理量可配置的级联滤波器
+//
+
+#pragma once
+
+#include <JuceHeader.h>
+#include <vector>
+#include "AudioGraph/Core/AudioGraphTypes.hpp"
+
+namespace WindsynthVST::Benchmarks {
+
+/**
+ * 合成插件
+ *
+ * 每个通道运行若干级二阶低通滤波器，处理量与级数成正比，不依赖任何外部插件。
+ * 状态数据是指定大小的确定性伪随机数据，用于测量预设和快照的读写开销。
+ * 插件描述的 fileOrIdentifier 记录级数和状态大小，makeFactory() 据此重建实例。
+ */
+class SyntheticPlugin : public juce::AudioPluginInstance {
+public:
+    static constexpr const char* formatName = "Synthetic";
+
+    SyntheticPlugin(int numStages, int stateSize)
+        : AudioPluginInstance(BusesProperties()
+                                  .withInput("Input", juce::AudioChannelSet::stereo(), true)
+                                  .withOutput("Output", juce::AudioChannelSet::stereo(), true)),
+          numStages(juce::jmax(1, numStages)),
+          stateSize(juce::jmax(0, stateSize))
+    {
+    }
+
+    /**
+     * 创建插件描述
+     */
+    static juce::PluginDescription makeDescription(int numStages, int stateSize = 0) {
+        juce::PluginDescription description;
+        description.name = "Synthetic x" + juce::String(numStages);
+        description.descriptiveName = description.name;
+        description.pluginFormatName = formatName;
+        description.category = "Effect";
+        description.manufacturerName = "WindsynthRecorder";
+        description.version = "1.0";
+        description.fileOrIdentifier = "synthetic:" + juce::String(numStages) + ":" + juce::String(stateSize);
+        description.uniqueId = numStages * 7919 + stateSize;
+        description.deprecatedUid = description.uniqueId;
+        description.numInputChannels = 2;
+        description.numOutputChannels = 2;
+        return description;
+    }
+
+    /**
+     * 创建插件实例工厂（用于从图快照重建图）
+     */
+    static AudioGraph::PluginInstanceFactory makeFactory() {
+        return [](const juce::PluginDescription& description, double, int, juce::String& error)
+            -> std::unique_ptr<juce::AudioPluginInstance> {
+            if (description.pluginFormatName != formatName) {
+                error = "不是合成插件：" + description.name;
+                return nullptr;
+            }
+
+            auto tokens = juce::StringArray::fromTokens(description.fileOrIdentifier, ":", "");
+            const int stages = tokens.size() > 1 ? tokens[1].getIntValue() : 1;
+            const int bytes = tokens.size() > 2 ? tokens[2].getIntValue() : 0;
+            return std::make_unique<SyntheticPlugin>(stages, bytes);
+        };
+    }
+
+    //==============================================================================
+    // AudioPluginInstance
+    //==============================================================================
+
+    void fillInPluginDescription(juce::PluginDescription& description) const override {
+        description = makeDescription(numStages, stateSize);
+    }
+
+    const juce::String getName() const override { return "Synthetic x" + juce::String(numStages); }
+
+    void prepareToPlay(double, int) override {
+        // 截止频率为采样率 1/8 的巴特沃斯低通（Q = 1/√2），与采样率无关
+        const double omega = juce::MathConstants<double>::twoPi * 0.125;
+        const double alpha = std::sin(omega) / juce::MathConstants<double>::sqrt2;
+        const double cosOmega = std::cos(omega);
+        const double a0 = 1.0 + alpha;
+
+        b0 = static_cast<float>((1.0 - cosOmega) * 0.5 / a0);
+        b1 = static_cast<float>((1.0 - cosOmega) / a0);
+        b2 = b0;
+        a1 = static_cast<float>(-2.0 * cosOmega / a0);
+        a2 = static_cast<float>((1.0 - alpha) / a0);
+
+        filterState.assign(static_cast<size_t>(numStages * getTotalNumOutputChannels() * 4), 0.0f);
+    }
+
+    void releaseResources() override {}
+
+    void processBlock(juce::AudioBuffer<float>& buffer, juce::MidiBuffer&) override {
+        const int numChannels = juce::jmin(buffer.getNumChannels(), getTotalNumOutputChannels());
+        const int numSamples = buffer.getNumSamples();
+        if (filterState.empty()) {
+            return;
+        }
+
+        for (int channel = 0; channel < numChannels; ++channel) {
+            float* data = buffer.getWritePointer(channel);
+            for (int stage = 0; stage < numStages; ++stage) {
+                float* state = filterState.data() + (channel * numStages + stage) * 4;
+                float x1 = state[0], x2 = state[1], y1 = state[2], y2 = state[3];
+
+                for (int i = 0; i < numSamples; ++i) {
+                    const float x = data[i];
+                    const float y = b0 * x + b1 * x1 + b2 * x2 - a1 * y1 - a2 * y2;
+                    x2 = x1;
+                    x1 = x;
+                    y2 = y1;
+                    y1 = y;
+                    data[i] = y;
+                }
+
+                state[0] = x1;
+                state[1] = x2;
+                state[2] = y1;
+                state[3] = y2;
+            }
+        }
+    }
+
+    bool isBusesLayoutSupported(const BusesLayout& layouts) const override {
+        return layouts.getMainInputChannelSet() == layouts.getMainOutputChannelSet();
+    }
+
+    double getTailLengthSeconds() const override { return 0.0; }
+    bool acceptsMidi() const override { return false; }
+    bool producesMidi() const override { return false; }
+    bool hasEditor() const override { return false; }
+    juce::AudioProcessorEditor* createEditor() override { return nullptr; }
+
+    int getNumPrograms() override { return 1; }
+    int getCurrentProgram() override { return 0; }
+    void setCurrentProgram(int) override {}
+    const juce::String getProgramName(int) override { return {}; }
+    void changeProgramName(int, const juce::String&) override {}
+
+    void getStateInformation(juce::MemoryBlock& destData) override {
+        destData.setSize(static_cast<size_t>(stateSize));
+        auto* bytes = static_cast<juce::uint8*>(destData.getData());
+        juce::Random random(numStages);
+        for (int i = 0; i < stateSize; ++i) {
+            bytes[i] = static_cast<juce::uint8>(random.nextInt(256));
+        }
+    }
+
+    void setStateInformation(const void*, int) override {}
+
+private:
+    const int numStages;
+    const int stateSize;
+
+    float b0 = 1.0f, b1 = 0.0f, b2 = 0.0f, a1 = 0.0f, a2 = 0.0f;
+    std::vector<float> filterState;     // 每个通道每一级：x1, x2, y1, y2
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(SyntheticPlugin)
+};
+
+} // namespace WindsynthVST::Benchmarks
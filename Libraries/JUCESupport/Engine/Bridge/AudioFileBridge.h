@@ -15,6 +15,80 @@
 extern "C" {
 #endif
 
+//==============================================================================
+// 音频文件相关类型定义
+//==============================================================================
+
+/**
+ * 流式播放统计结构（C兼容）
+ */
+typedef struct {
+    bool memoryMapped;          // 是否使用内存映射读取
+    bool fromClipCache;         // 是否从片段缓存读取已解码数据
+    int readAheadSamples;       // 预读缓冲区大小
+    int64_t bufferedSamples;    // 当前已预读的采样数
+    uint64_t underruns;         // 预读数据不足的音频块数
+    uint64_t underrunSamples;   // 因预读不足输出静音的采样数
+} PlaybackStreamStats_C;
+
+/**
+ * 音频片段缓存统计结构（C兼容）
+ */
+typedef struct {
+    uint64_t hits;
+    uint64_t misses;
+    uint64_t mappedOpens;       // 内存映射打开次数（未压缩文件）
+    uint64_t evictions;
+    uint64_t memoryUsedBytes;
+    uint64_t memoryBudgetBytes;
+    int numEntries;
+} ClipCacheStats_C;
+
+/**
+ * 波形峰值缓存状态
+ */
+typedef enum {
+    WaveformPeakState_None = 0,
+    WaveformPeakState_Building = 1,
+    WaveformPeakState_Ready = 2,
+    WaveformPeakState_Failed = 3
+} WaveformPeakState_C;
+
+/**
+ * 单个波形峰值（与峰值附属文件中的存储格式一致）
+ */
+typedef struct {
+    float minValue;
+    float maxValue;
+    float rms;
+} WaveformPeak_C;
+
+/**
+ * 波形峰值状态结构（C兼容）
+ */
+typedef struct {
+    WaveformPeakState_C state;
+    float progress;             // 生成进度（0-1）
+    int numChannels;
+    int numLevels;
+    double sampleRate;
+    int64_t lengthInSamples;
+} WaveformPeakStatus_C;
+
+/**
+ * 波形峰值范围（C兼容，peaks 直接指向内存映射的峰值数据）
+ * 必须调用 Engine_ReleaseWaveformPeaks 释放，释放前数据一直有效
+ */
+typedef struct {
+    const WaveformPeak_C* peaks;    // 按帧交错：peaks[frame * numChannels + channel]
+    int numPeaks;                   // 帧数
+    int numChannels;
+    int samplesPerPeak;
+    int64_t firstSample;            // peaks[0] 对应的源文件采样位置
+    double sampleRate;
+    void* token;                    // 持有映射的内部句柄
+} WaveformPeakRange_C;
+
 //==============================================================================
 // 音频文件处理
 //==============================================================================
@@ -82,6 +156,87 @@ bool Engine_HasAudioFile(EngineHandle handle);
  */
 bool Engine_IsPlaying(EngineHandle handle);
 
+//==============================================================================
+// 流式播放
+//==============================================================================
+
+/**
+ * 设置播放预读缓冲区大小（下次加载文件时生效）
+ * @param handle 引擎句柄
+ * @param numSamples 预读采样数
+ */
+void Engine_SetPlaybackReadAhead(EngineHandle handle, int numSamples);
+
+/**
+ * 获取流式播放统计
+ * @param handle 引擎句柄
+ * @param stats 输出统计信息
+ * @return 成功返回true
+ */
+bool Engine_GetPlaybackStreamStats(EngineHandle handle, PlaybackStreamStats_C* stats);
+
+/**
+ * 清零播放欠载计数
+ * @param handle 引擎句柄
+ */
+void Engine_ResetPlaybackStreamStats(EngineHandle handle);
+
+//==============================================================================
+// 音频片段缓存
+//==============================================================================
+
+/**
+ * 获取音频片段缓存统计
+ * @param handle 引擎句柄
+ * @param stats 输出统计信息
+ * @return 成功返回true
+ */
+bool Engine_GetClipCacheStats(EngineHandle handle, ClipCacheStats_C* stats);
+
+/**
+ * 设置音频片段缓存的内存预算
+ * @param handle 引擎句柄
+ * @param budgetBytes 内存预算（字节）
+ */
+void Engine_SetClipCacheBudget(EngineHandle handle, uint64_t budgetBytes);
+
+/**
+ * 清空音频片段缓存
+ * @param handle 引擎句柄
+ */
+void Engine_ClearClipCache(EngineHandle handle);
+
+//==============================================================================
+// 波形峰值
+//==============================================================================
+
+/**
+ * 获取当前音频文件的波形峰值状态（加载文件时自动在后台生成）
+ * @param handle 引擎句柄
+ * @param status 输出状态
+ * @return 成功返回true
+ */
+bool Engine_GetWaveformPeakStatus(EngineHandle handle, WaveformPeakStatus_C* status);
+
+/**
+ * 获取当前音频文件指定时间范围的波形峰值（零拷贝）
+ * 选择峰值数不超过 maxPeaks 的最细一级
+ * @param handle 引擎句柄
+ * @param startSeconds 开始时间
+ * @param endSeconds 结束时间
+ * @param maxPeaks 最多需要的峰值数（通常是显示宽度的像素数）
+ * @param range 输出峰值范围
+ * @return 峰值已就绪返回true
+ */
+bool Engine_AcquireWaveformPeaks(EngineHandle handle, double startSeconds, double endSeconds,
+                                 int maxPeaks, WaveformPeakRange_C* range);
+
+/**
+ * 释放波形峰值范围
+ * @param range Engine_AcquireWaveformPeaks 返回的范围
+ */
+void Engine_ReleaseWaveformPeaks(WaveformPeakRange_C* range);
+
 #ifdef __cplusplus
 }
 #endif
@@ -8,7 +8,30 @@
 
 #include "AudioFileBridge.h"
 #include "BridgeInternal.h"
-#include <iostream>
+#include "AudioGraph/Core/Logger.hpp"
+
+static_assert(sizeof(WaveformPeak_C) == sizeof(Core::WaveformPeakCache::Peak), "峰值结构必须与附属文件格式一致");
+
+namespace {
+
+/**
+ * 当前加载的音频文件和峰值缓存（没有加载文件时返回false）
+ */
+bool getCurrentPeakSource(BridgeContext* context, std::shared_ptr<Core::WaveformPeakCache>& peakCache,
+                          juce::File& file) {
+    auto audioManager = context->engine->getAudioFileManager();
+    auto engineContext = context->engine->getContext();
+    if (!audioManager || !engineContext) return false;
+
+    const auto filePath = audioManager->getCurrentFilePath();
+    peakCache = engineContext->getPeakCache();
+    if (filePath.empty() || !peakCache) return false;
+
+    file = juce::File(filePath);
+    return true;
+}
+
+} // namespace
 
 //==============================================================================
 // 音频文件处理实现
@@ -23,7 +46,7 @@ bool Engine_LoadAudioFile(EngineHandle handle, const char* filePath) {
 
         return context->engine->loadAudioFile(std::string(filePath));
     } catch (const std::exception& e) {
-        std::cerr << "[AudioFileBridge] 加载音频文件失败: " << e.what() << std::endl;
+        WSLOG_ERROR("AudioFileBridge", "加载音频文件失败: " << e.what());
         return false;
     }
 }
@@ -37,7 +60,7 @@ bool Engine_Play(EngineHandle handle) {
 
         return context->engine->play();
     } catch (const std::exception& e) {
-        std::cerr << "[AudioFileBridge] 播放失败: " << e.what() << std::endl;
+        WSLOG_ERROR("AudioFileBridge", "播放失败: " << e.what());
         return false;
     }
 }
@@ -51,7 +74,7 @@ void Engine_Pause(EngineHandle handle) {
             context->engine->pause();
         }
     } catch (const std::exception& e) {
-        std::cerr << "[AudioFileBridge] 暂停失败: " << e.what() << std::endl;
+        WSLOG_ERROR("AudioFileBridge", "暂停失败: " << e.what());
     }
 }
 
@@ -64,7 +87,7 @@ void Engine_StopPlayback(EngineHandle handle) {
             context->engine->stopPlayback();
         }
     } catch (const std::exception& e) {
-        std::cerr << "[AudioFileBridge] 停止播放失败: " << e.what() << std::endl;
+        WSLOG_ERROR("AudioFileBridge", "停止播放失败: " << e.what());
     }
 }
 
@@ -77,7 +100,7 @@ bool Engine_SeekTo(EngineHandle handle, double timeInSeconds) {
 
         return context->engine->seekTo(timeInSeconds);
     } catch (const std::exception& e) {
-        std::cerr << "[AudioFileBridge] 跳转失败: " << e.what() << std::endl;
+        WSLOG_ERROR("AudioFileBridge", "跳转失败: " << e.what());
         return false;
     }
 }
@@ -91,7 +114,7 @@ double Engine_GetCurrentTime(EngineHandle handle) {
 
         return context->engine->getCurrentTime();
     } catch (const std::exception& e) {
-        std::cerr << "[AudioFileBridge] 获取当前时间失败: " << e.what() << std::endl;
+        WSLOG_ERROR("AudioFileBridge", "获取当前时间失败: " << e.what());
         return 0.0;
     }
 }
@@ -105,7 +128,7 @@ double Engine_GetDuration(EngineHandle handle) {
 
         return context->engine->getDuration();
     } catch (const std::exception& e) {
-        std::cerr << "[AudioFileBridge] 获取时长失败: " << e.what() << std::endl;
+        WSLOG_ERROR("AudioFileBridge", "获取时长失败: " << e.what());
         return 0.0;
     }
 }
@@ -120,7 +143,7 @@ bool Engine_HasAudioFile(EngineHandle handle) {
         auto audioManager = context->engine->getAudioFileManager();
         return audioManager ? audioManager->hasAudioFile() : false;
     } catch (const std::exception& e) {
-        std::cerr << "[AudioFileBridge] 检查音频文件状态失败: " << e.what() << std::endl;
+        WSLOG_ERROR("AudioFileBridge", "检查音频文件状态失败: " << e.what());
         return false;
     }
 }
@@ -135,7 +158,201 @@ bool Engine_IsPlaying(EngineHandle handle) {
         auto audioManager = context->engine->getAudioFileManager();
         return audioManager ? audioManager->isPlaying() : false;
     } catch (const std::exception& e) {
-        std::cerr << "[AudioFileBridge] 检查播放状态失败: " << e.what() << std::endl;
+        WSLOG_ERROR("AudioFileBridge", "检查播放状态失败: " << e.what());
         return false;
     }
 }
+
+//==============================================================================
+// 流式播放实现
+//==============================================================================
+
+void Engine_SetPlaybackReadAhead(EngineHandle handle, int numSamples) {
+    if (!handle) return;
+
+    try {
+        auto context = getContext(handle);
+        if (!context->engine) return;
+
+        if (auto audioManager = context->engine->getAudioFileManager()) {
+            audioManager->setReadAheadSamples(numSamples);
+        }
+    } catch (const std::exception& e) {
+        WSLOG_ERROR("AudioFileBridge", "设置预读大小失败: " << e.what());
+    }
+}
+
+bool Engine_GetPlaybackStreamStats(EngineHandle handle, PlaybackStreamStats_C* stats) {
+    if (!handle || !stats) return false;
+
+    try {
+        auto context = getContext(handle);
+        if (!context->engine) return false;
+
+        auto audioManager = context->engine->getAudioFileManager();
+        if (!audioManager) return false;
+
+        const auto cppStats = audioManager->getStreamingStats();
+        stats->memoryMapped = cppStats.memoryMapped;
+        stats->fromClipCache = cppStats.fromClipCache;
+        stats->readAheadSamples = cppStats.readAheadSamples;
+        stats->bufferedSamples = cppStats.bufferedSamples;
+        stats->underruns = cppStats.underruns;
+        stats->underrunSamples = cppStats.underrunSamples;
+        return true;
+    } catch (const std::exception& e) {
+        WSLOG_ERROR("AudioFileBridge", "获取流式播放统计失败: " << e.what());
+        return false;
+    }
+}
+
+void Engine_ResetPlaybackStreamStats(EngineHandle handle) {
+    if (!handle) return;
+
+    try {
+        auto context = getContext(handle);
+        if (!context->engine) return;
+
+        if (auto audioManager = context->engine->getAudioFileManager()) {
+            audioManager->resetStreamingStats();
+        }
+    } catch (const std::exception& e) {
+        WSLOG_ERROR("AudioFileBridge", "重置流式播放统计失败: " << e.what());
+    }
+}
+
+//==============================================================================
+// 音频片段缓存实现
+//==============================================================================
+
+bool Engine_GetClipCacheStats(EngineHandle handle, ClipCacheStats_C* stats) {
+    if (!handle || !stats) return false;
+
+    try {
+        auto context = getContext(handle);
+        if (!context->engine) return false;
+
+        auto engineContext = context->engine->getContext();
+        if (!engineContext) return false;
+
+        auto clipCache = engineContext->getClipCache();
+        if (!clipCache) return false;
+
+        const auto cppStats = clipCache->getStatistics();
+        stats->hits = cppStats.hits;
+        stats->misses = cppStats.misses;
+        stats->mappedOpens = cppStats.mappedOpens;
+        stats->evictions = cppStats.evictions;
+        stats->memoryUsedBytes = static_cast<uint64_t>(cppStats.memoryUsedBytes);
+        stats->memoryBudgetBytes = static_cast<uint64_t>(cppStats.memoryBudgetBytes);
+        stats->numEntries = cppStats.numEntries;
+        return true;
+    } catch (const std::exception& e) {
+        WSLOG_ERROR("AudioFileBridge", "获取片段缓存统计失败: " << e.what());
+        return false;
+    }
+}
+
+void Engine_SetClipCacheBudget(EngineHandle handle, uint64_t budgetBytes) {
+    if (!handle) return;
+
+    try {
+        auto context = getContext(handle);
+        if (!context->engine) return;
+
+        auto engineContext = context->engine->getContext();
+        if (!engineContext) return;
+
+        if (auto clipCache = engineContext->getClipCache()) {
+            clipCache->setMemoryBudget(static_cast<size_t>(budgetBytes));
+        }
+    } catch (const std::exception& e) {
+        WSLOG_ERROR("AudioFileBridge", "设置片段缓存预算失败: " << e.what());
+    }
+}
+
+void Engine_ClearClipCache(EngineHandle handle) {
+    if (!handle) return;
+
+    try {
+        auto context = getContext(handle);
+        if (!context->engine) return;
+
+        auto engineContext = context->engine->getContext();
+        if (!engineContext) return;
+
+        if (auto clipCache = engineContext->getClipCache()) {
+            clipCache->clear();
+        }
+    } catch (const std::exception& e) {
+        WSLOG_ERROR("AudioFileBridge", "清空片段缓存失败: " << e.what());
+    }
+}
+
+//==============================================================================
+// 波形峰值实现
+//==============================================================================
+
+bool Engine_GetWaveformPeakStatus(EngineHandle handle, WaveformPeakStatus_C* status) {
+    if (!handle || !status) return false;
+
+    try {
+        auto context = getContext(handle);
+        if (!context->engine) return false;
+
+        std::shared_ptr<Core::WaveformPeakCache> peakCache;
+        juce::File file;
+        if (!getCurrentPeakSource(context, peakCache, file)) return false;
+
+        const auto cppStatus = peakCache->getStatus(file);
+        status->state = static_cast<WaveformPeakState_C>(cppStatus.state);
+        status->progress = cppStatus.progress;
+        status->numChannels = cppStatus.numChannels;
+        status->numLevels = cppStatus.numLevels;
+        status->sampleRate = cppStatus.sampleRate;
+        status->lengthInSamples = cppStatus.lengthInSamples;
+        return true;
+    } catch (const std::exception& e) {
+        WSLOG_ERROR("AudioFileBridge", "获取波形峰值状态失败: " << e.what());
+        return false;
+    }
+}
+
+bool Engine_AcquireWaveformPeaks(EngineHandle handle, double startSeconds, double endSeconds,
+                                 int maxPeaks, WaveformPeakRange_C* range) {
+    if (!range) return false;
+    *range = WaveformPeakRange_C{};
+    if (!handle) return false;
+
+    try {
+        auto context = getContext(handle);
+        if (!context->engine) return false;
+
+        std::shared_ptr<Core::WaveformPeakCache> peakCache;
+        juce::File file;
+        if (!getCurrentPeakSource(context, peakCache, file)) return false;
+
+        auto cppRange = peakCache->getPeaks(file, startSeconds, endSeconds, maxPeaks);
+        if (!cppRange.table || cppRange.numPeaks <= 0) return false;
+
+        range->peaks = reinterpret_cast<const WaveformPeak_C*>(cppRange.peaks);
+        range->numPeaks = cppRange.numPeaks;
+        range->numChannels = cppRange.numChannels;
+        range->samplesPerPeak = cppRange.samplesPerPeak;
+        range->firstSample = cppRange.firstSample;
+        range->sampleRate = cppRange.sampleRate;
+        range->token = new std::shared_ptr<const Core::WaveformPeakCache::PeakTable>(std::move(cppRange.table));
+        return true;
+    } catch (const std::exception& e) {
+        WSLOG_ERROR("AudioFileBridge", "获取波形峰值失败: " << e.what());
+        *range = WaveformPeakRange_C{};
+        return false;
+    }
+}
+
+void Engine_ReleaseWaveformPeaks(WaveformPeakRange_C* range) {
+    if (!range) return;
+
+    delete static_cast<std::shared_ptr<const Core::WaveformPeakCache::PeakTable>*>(range->token);
+    *range = WaveformPeakRange_C{};
+}
@@ -31,6 +31,9 @@ struct BridgeContext {
 
     EngineErrorCallback errorCallback = nullptr;
     void* errorUserData = nullptr;
+
+    // 在共享插件加载器上注册的扫描监听（0 表示没有）
+    int pluginScanListenerID = 0;
     
     BridgeContext() {
         engine = std::make_unique<WindsynthEngineFacade>();
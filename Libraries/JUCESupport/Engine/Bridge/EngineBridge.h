@@ -68,6 +68,61 @@ typedef struct {
     int totalConnections;
 } EngineStatistics_C;
 
+/**
+ * 回调耗时百分位（C兼容）
+ */
+typedef struct {
+    double p50Ms;
+    double p95Ms;
+    double p99Ms;
+    double p999Ms;
+    double maxMs;
+    uint64_t blocks;
+    uint64_t deadlineMisses;
+    uint64_t nearMisses;
+} LatencyPercentiles_C;
+
+/**
+ * 音频回调性能统计（C兼容）
+ */
+typedef struct {
+    double averageProcessingTimeMs;
+    double cpuUsagePercent;
+    double bufferDurationMs;
+    LatencyPercentiles_C overall;
+    LatencyPercentiles_C currentWindow;
+    LatencyPercentiles_C lastWindow;
+    uint64_t completedWindows;
+    int64_t deviceXruns;
+    uint64_t droppedStatsSamples;
+    uint64_t realtimeViolations;
+} PerformanceStats_C;
+
+/**
+ * 电平快照中的最大通道数
+ */
+#define ENGINE_METER_MAX_CHANNELS 32
+
+/**
+ * 电平和性能快照（C兼容）
+ * 一次调用取得UI刷新所需的全部实时数据，电平为线性值
+ */
+typedef struct {
+    int32_t numInputChannels;
+    int32_t numOutputChannels;
+    float inputLevels[ENGINE_METER_MAX_CHANNELS];
+    float inputPeaks[ENGINE_METER_MAX_CHANNELS];
+    float outputLevels[ENGINE_METER_MAX_CHANNELS];
+    float outputPeaks[ENGINE_METER_MAX_CHANNELS];
+    bool inputClipping;
+    bool outputClipping;
+    double cpuUsagePercent;
+    double processingTimeMs;
+    int64_t xrunCount;
+    uint64_t blockCount;
+    double timestamp;
+} EngineMeterSnapshot_C;
+
 /**
  * 离线渲染设置结构（C兼容）
  */
@@ -78,8 +133,77 @@ typedef struct {
     bool normalizeOutput;
     bool includePluginTails;
     int32_t format;
+    int32_t normalizationMode;      // 0 = 峰值, 1 = 积分响度（EBU R128）
+    float targetPeakDb;
+    float targetLoudnessLUFS;
+    float peakCeilingDb;
+    int32_t tailMode;               // 0 = 图报告的尾音长度, 1 = 静音检测
+    float maxTailSeconds;
+    float tailSilenceThresholdDb;
+    float tailSilenceHoldMs;
 } RenderSettings_C;
 
+/**
+ * 渲染结果结构（C兼容）
+ */
+typedef struct {
+    bool success;
+    int64_t samplesWritten;
+    double renderTimeSeconds;
+    double audioDurationSeconds;
+    double realtimeFactor;
+    float peakLevel;
+    double integratedLoudness;
+    float appliedGain;
+    char errorMessage[256];
+} RenderResult_C;
+
+/**
+ * 录音轨道配置（C兼容）
+ */
+typedef struct {
+    char name[128];
+    int32_t source;                 // 0 = 处理前（设备输入）, 1 = 处理后（图输出）
+    int32_t firstChannel;
+    int32_t numChannels;
+} RecordingTrack_C;
+
+/**
+ * 录音设置（C兼容）
+ */
+typedef struct {
+    int32_t format;                 // 0 = WAV, 1 = AIFF
+    int32_t bitDepth;
+    int32_t diskBufferSamples;      // 每轨磁盘缓冲区（采样数，<= 0 使用默认值）
+    int32_t captureBufferSamples;   // 采集FIFO容量（采样数，<= 0 表示 2 秒）
+} RecordingSettings_C;
+
+/**
+ * 录音统计信息（C兼容）
+ */
+typedef struct {
+    bool isRecording;
+    int64_t samplesCaptured;
+    int64_t samplesWritten;
+    uint64_t captureOverruns;
+    uint64_t droppedSamples;
+    uint64_t diskStalls;
+    float captureBufferFill;
+    bool punchEnabled;
+    int64_t punchInSample;
+    int64_t punchOutSample;
+    int32_t numTracks;
+} RecordingStats_C;
+
+/**
+ * MIDI输入设备信息（C兼容）
+ */
+typedef struct {
+    char name[256];
+    char identifier[256];
+    bool enabled;
+} MidiInputDevice_C;
+
 /**
  * 回调函数类型定义
  */
@@ -167,6 +291,21 @@ bool Engine_UpdateConfiguration(EngineHandle handle, const EngineConfig_C* confi
  */
 bool Engine_GetStatistics(EngineHandle handle, EngineStatistics_C* statistics);
 
+/**
+ * 获取音频回调性能统计（包括耗时百分位和截止时间超时次数）
+ * @param handle 引擎句柄
+ * @param stats 输出统计
+ * @return 成功返回true
+ */
+bool Engine_GetPerformanceStats(EngineHandle handle, PerformanceStats_C* stats);
+
+/**
+ * 重置性能统计
+ * @param handle 引擎句柄
+ * @param windowOnly 为true时只结束当前统计窗口
+ */
+void Engine_ResetPerformanceStats(EngineHandle handle, bool windowOnly);
+
 /**
  * 获取输出电平
  * @param handle 引擎句柄
@@ -181,6 +320,14 @@ double Engine_GetOutputLevel(EngineHandle handle);
  */
 double Engine_GetInputLevel(EngineHandle handle);
 
+/**
+ * 获取电平和性能快照（不与音频线程竞争锁，适合UI定时器高频调用）
+ * @param handle 引擎句柄
+ * @param snapshot 输出快照
+ * @return 成功返回true
+ */
+bool Engine_GetMeterSnapshot(EngineHandle handle, EngineMeterSnapshot_C* snapshot);
+
 /**
  * 渲染进度回调函数类型
  */
@@ -203,6 +350,150 @@ bool Engine_RenderToFile(EngineHandle handle,
                         RenderProgressCallback progressCallback,
                         void* userData);
 
+/**
+ * 批量渲染进度回调函数类型（可能从多个工作线程同时调用）
+ */
+typedef void (*BatchRenderProgressCallback)(int32_t jobIndex, float progress, const char* message, void* userData);
+
+/**
+ * 并行批量渲染多个文件
+ * 每个工作线程使用当前音频图的独立副本，实时音频处理不受影响
+ * @param handle 引擎句柄
+ * @param inputPaths 输入文件路径数组
+ * @param outputPaths 输出文件路径数组
+ * @param numJobs 任务数量
+ * @param settings 渲染设置（所有任务共用）
+ * @param maxParallelJobs 最大并行任务数（<= 0 时自动选择）
+ * @param progressCallback 进度回调函数（可选）
+ * @param userData 用户数据
+ * @param results 渲染结果数组（可为NULL，长度至少为numJobs）
+ * @return 成功渲染的任务数量，参数无效时返回-1
+ */
+int32_t Engine_RenderBatch(EngineHandle handle,
+                           const char* const* inputPaths,
+                           const char* const* outputPaths,
+                           int32_t numJobs,
+                           const RenderSettings_C* settings,
+                           int32_t maxParallelJobs,
+                           BatchRenderProgressCallback progressCallback,
+                           void* userData,
+                           RenderResult_C* results);
+
+/**
+ * 后台渲染完成回调函数类型（在渲染线程中调用，取消的任务也会回调）
+ */
+typedef void (*RenderCompletionCallback)(int32_t jobID, const RenderResult_C* result, void* userData);
+
+/**
+ * 在后台渲染到文件（排队执行，实时音频处理和监听不中断）
+ * 渲染使用调用时音频图的快照，渲染线程根据实时回调负载自动让出CPU
+ * @param handle 引擎句柄
+ * @param inputPath 输入文件路径
+ * @param outputPath 输出文件路径
+ * @param settings 渲染设置
+ * @param progressCallback 进度回调函数（可选，在渲染线程中调用）
+ * @param completionCallback 完成回调函数（可选）
+ * @param userData 用户数据
+ * @return 任务ID，失败时返回0
+ */
+int32_t Engine_RenderToFileAsync(EngineHandle handle,
+                                 const char* inputPath,
+                                 const char* outputPath,
+                                 const RenderSettings_C* settings,
+                                 RenderProgressCallback progressCallback,
+                                 RenderCompletionCallback completionCallback,
+                                 void* userData);
+
+/**
+ * 取消后台渲染任务
+ * @param handle 引擎句柄
+ * @param jobID 任务ID
+ * @return 找到任务时返回true
+ */
+bool Engine_CancelRender(EngineHandle handle, int32_t jobID);
+
+/**
+ * 获取后台渲染中排队和正在进行的任务数量
+ * @param handle 引擎句柄
+ */
+int32_t Engine_GetActiveRenderCount(EngineHandle handle);
+
+//==============================================================================
+// 多轨录音
+//==============================================================================
+
+/**
+ * 开始多轨录音（每个轨道写入一个文件）
+ * @param handle 引擎句柄
+ * @param outputDirectory 录音目录
+ * @param takeName 录音名称（文件名前缀）
+ * @param settings 录音设置（可为NULL，使用默认值）
+ * @param tracks 轨道配置数组
+ * @param numTracks 轨道数量
+ * @return 成功返回true
+ */
+bool Engine_StartRecording(EngineHandle handle,
+                           const char* outputDirectory,
+                           const char* takeName,
+                           const RecordingSettings_C* settings,
+                           const RecordingTrack_C* tracks,
+                           int32_t numTracks);
+
+/**
+ * 停止录音，写完缓冲数据并关闭文件
+ */
+void Engine_StopRecording(EngineHandle handle);
+
+/**
+ * 是否正在录音
+ */
+bool Engine_IsRecording(EngineHandle handle);
+
+/**
+ * 从当前位置开始写入（穿插录音）
+ */
+void Engine_PunchIn(EngineHandle handle);
+
+/**
+ * 从当前位置停止写入（穿插录音）
+ */
+void Engine_PunchOut(EngineHandle handle);
+
+/**
+ * 设置穿插录音区间（采集时间轴上的采样位置，out <= in 表示不限结束位置）
+ */
+void Engine_SetPunchRange(EngineHandle handle, int64_t punchInSample, int64_t punchOutSample);
+
+/**
+ * 取消穿插录音区间
+ */
+void Engine_ClearPunchRange(EngineHandle handle);
+
+/**
+ * 获取录音统计信息（包括采集溢出和磁盘等待计数）
+ * @return 成功返回true
+ */
+bool Engine_GetRecordingStats(EngineHandle handle, RecordingStats_C* stats);
+
+//==============================================================================
+// MIDI输入
+//==============================================================================
+
+/**
+ * 获取可用的MIDI输入设备
+ * @param devices 输出数组（可为NULL，只返回数量）
+ * @param maxDevices 数组容量
+ * @return 设备总数
+ */
+int32_t Engine_GetMidiInputDevices(EngineHandle handle, MidiInputDevice_C* devices, int32_t maxDevices);
+
+/**
+ * 启用或禁用MIDI输入设备（启用的设备消息送入音频图的MIDI输入节点）
+ * @param identifier 设备标识
+ * @return 成功返回true
+ */
+bool Engine_SetMidiInputDeviceEnabled(EngineHandle handle, const char* identifier, bool enabled);
+
 //==============================================================================
 // 回调设置
 //==============================================================================
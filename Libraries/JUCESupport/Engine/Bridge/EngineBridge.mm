@@ -7,8 +7,9 @@
 //
 
 #include "BridgeInternal.h"
+#include "AudioGraph/Core/Logger.hpp"
 #include <string>
-#include <iostream>
+#include <algorithm>
 
 //==============================================================================
 // 辅助函数
@@ -55,6 +56,57 @@ static void convertEngineConfigToC(const Core::EngineConfig& cppConfig, EngineCo
     config->audioDeviceName[sizeof(config->audioDeviceName) - 1] = '\0';
 }
 
+/**
+ * 转换渲染设置（C 到 C++），格式不受支持时返回false
+ */
+static bool convertRenderSettings(const RenderSettings_C* settings, WindsynthEngineFacade::RenderSettings& cppSettings) {
+    cppSettings.sampleRate = settings->sampleRate;
+    cppSettings.bitDepth = settings->bitDepth;
+    cppSettings.numChannels = settings->numChannels;
+    cppSettings.normalizeOutput = settings->normalizeOutput;
+    cppSettings.includePluginTails = settings->includePluginTails;
+
+    // 转换格式枚举
+    if (settings->format == 0) {
+        cppSettings.format = WindsynthEngineFacade::RenderSettings::Format::WAV;
+    } else if (settings->format == 1) {
+        cppSettings.format = WindsynthEngineFacade::RenderSettings::Format::AIFF;
+    } else {
+        return false;
+    }
+
+    cppSettings.normalizationMode = settings->normalizationMode == 1
+        ? WindsynthEngineFacade::RenderSettings::NormalizationMode::Loudness
+        : WindsynthEngineFacade::RenderSettings::NormalizationMode::Peak;
+    cppSettings.targetPeakDb = settings->targetPeakDb;
+    cppSettings.targetLoudnessLUFS = settings->targetLoudnessLUFS;
+    cppSettings.peakCeilingDb = settings->peakCeilingDb;
+
+    cppSettings.tailMode = settings->tailMode == 0
+        ? WindsynthEngineFacade::RenderSettings::TailMode::ReportedLength
+        : WindsynthEngineFacade::RenderSettings::TailMode::SilenceDetection;
+    cppSettings.maxTailSeconds = settings->maxTailSeconds;
+    cppSettings.tailSilenceThresholdDb = settings->tailSilenceThresholdDb;
+    cppSettings.tailSilenceHoldMs = settings->tailSilenceHoldMs;
+    return true;
+}
+
+/**
+ * 转换渲染结果（C++ 到 C）
+ */
+static void convertRenderResultToC(const Render::RenderResult& result, RenderResult_C& out) {
+    out.success = result.success;
+    out.samplesWritten = result.samplesWritten;
+    out.renderTimeSeconds = result.renderTimeSeconds;
+    out.audioDurationSeconds = result.audioDurationSeconds;
+    out.realtimeFactor = result.realtimeFactor;
+    out.peakLevel = result.peakLevel;
+    out.integratedLoudness = result.integratedLoudness;
+    out.appliedGain = result.appliedGain;
+    strncpy(out.errorMessage, result.error.c_str(), sizeof(out.errorMessage) - 1);
+    out.errorMessage[sizeof(out.errorMessage) - 1] = '\0';
+}
+
 /**
  * 获取桥接层上下文
  */
@@ -69,10 +121,10 @@ BridgeContext* getContext(EngineHandle handle) {
 EngineHandle Engine_Create(void) {
     try {
         auto context = new BridgeContext();
-        std::cout << "[EngineBridge] 引擎实例创建成功" << std::endl;
+        WSLOG_INFO("EngineBridge", "引擎实例创建成功");
         return static_cast<EngineHandle>(context);
     } catch (const std::exception& e) {
-        std::cerr << "[EngineBridge] 创建引擎失败: " << e.what() << std::endl;
+        WSLOG_ERROR("EngineBridge", "创建引擎失败: " << e.what());
         return nullptr;
     }
 }
@@ -83,12 +135,21 @@ void Engine_Destroy(EngineHandle handle) {
     try {
         auto context = getContext(handle);
         if (context->engine) {
+            // 共享插件加载器比引擎活得久，先移除指向本实例回调的扫描监听
+            if (context->pluginScanListenerID != 0) {
+                auto engineContext = context->engine->getContext();
+                auto pluginLoader = engineContext ? engineContext->getPluginLoader() : nullptr;
+                if (pluginLoader) {
+                    pluginLoader->removeScanListener(context->pluginScanListenerID);
+                }
+                context->pluginScanListenerID = 0;
+            }
             context->engine->shutdown();
         }
         delete context;
-        std::cout << "[EngineBridge] 引擎实例销毁完成" << std::endl;
+        WSLOG_INFO("EngineBridge", "引擎实例销毁完成");
     } catch (const std::exception& e) {
-        std::cerr << "[EngineBridge] 销毁引擎时出错: " << e.what() << std::endl;
+        WSLOG_ERROR("EngineBridge", "销毁引擎时出错: " << e.what());
     }
 }
 
@@ -102,7 +163,7 @@ bool Engine_Initialize(EngineHandle handle, const EngineConfig_C* config) {
         auto cppConfig = convertEngineConfig(config);
         return context->engine->initialize(cppConfig);
     } catch (const std::exception& e) {
-        std::cerr << "[EngineBridge] 初始化引擎失败: " << e.what() << std::endl;
+        WSLOG_ERROR("EngineBridge", "初始化引擎失败: " << e.what());
         return false;
     }
 }
@@ -116,7 +177,7 @@ bool Engine_Start(EngineHandle handle) {
 
         return context->engine->start();
     } catch (const std::exception& e) {
-        std::cerr << "[EngineBridge] 启动引擎失败: " << e.what() << std::endl;
+        WSLOG_ERROR("EngineBridge", "启动引擎失败: " << e.what());
         return false;
     }
 }
@@ -130,7 +191,7 @@ void Engine_Stop(EngineHandle handle) {
             context->engine->stop();
         }
     } catch (const std::exception& e) {
-        std::cerr << "[EngineBridge] 停止引擎时出错: " << e.what() << std::endl;
+        WSLOG_ERROR("EngineBridge", "停止引擎时出错: " << e.what());
     }
 }
 
@@ -143,7 +204,7 @@ void Engine_Shutdown(EngineHandle handle) {
             context->engine->shutdown();
         }
     } catch (const std::exception& e) {
-        std::cerr << "[EngineBridge] 关闭引擎时出错: " << e.what() << std::endl;
+        WSLOG_ERROR("EngineBridge", "关闭引擎时出错: " << e.what());
     }
 }
 
@@ -156,7 +217,7 @@ EngineState_C Engine_GetState(EngineHandle handle) {
 
         return convertEngineState(context->engine->getState());
     } catch (const std::exception& e) {
-        std::cerr << "[EngineBridge] 获取引擎状态失败: " << e.what() << std::endl;
+        WSLOG_ERROR("EngineBridge", "获取引擎状态失败: " << e.what());
         return EngineState_Error;
     }
 }
@@ -170,7 +231,7 @@ bool Engine_IsRunning(EngineHandle handle) {
 
         return context->engine->isRunning();
     } catch (const std::exception& e) {
-        std::cerr << "[EngineBridge] 检查运行状态失败: " << e.what() << std::endl;
+        WSLOG_ERROR("EngineBridge", "检查运行状态失败: " << e.what());
         return false;
     }
 }
@@ -186,7 +247,7 @@ bool Engine_GetConfiguration(EngineHandle handle, EngineConfig_C* config) {
         convertEngineConfigToC(cppConfig, config);
         return true;
     } catch (const std::exception& e) {
-        std::cerr << "[EngineBridge] 获取配置失败: " << e.what() << std::endl;
+        WSLOG_ERROR("EngineBridge", "获取配置失败: " << e.what());
         return false;
     }
 }
@@ -201,7 +262,7 @@ bool Engine_UpdateConfiguration(EngineHandle handle, const EngineConfig_C* confi
         auto cppConfig = convertEngineConfig(config);
         return context->engine->updateConfiguration(cppConfig);
     } catch (const std::exception& e) {
-        std::cerr << "[EngineBridge] 更新配置失败: " << e.what() << std::endl;
+        WSLOG_ERROR("EngineBridge", "更新配置失败: " << e.what());
         return false;
     }
 }
@@ -228,7 +289,7 @@ void Engine_SetStateCallback(EngineHandle handle,
             });
         }
     } catch (const std::exception& e) {
-        std::cerr << "[EngineBridge] 设置状态回调失败: " << e.what() << std::endl;
+        WSLOG_ERROR("EngineBridge", "设置状态回调失败: " << e.what());
     }
 }
 
@@ -250,7 +311,7 @@ void Engine_SetErrorCallback(EngineHandle handle,
             });
         }
     } catch (const std::exception& e) {
-        std::cerr << "[EngineBridge] 设置错误回调失败: " << e.what() << std::endl;
+        WSLOG_ERROR("EngineBridge", "设置错误回调失败: " << e.what());
     }
 }
 
@@ -258,6 +319,22 @@ void Engine_SetErrorCallback(EngineHandle handle,
 // 统计信息实现
 //==============================================================================
 
+/**
+ * 计算多个通道的平均电平（dB）
+ */
+static double averageLevelDb(const float* levels, int numChannels) {
+    if (numChannels <= 0) {
+        return -96.0;
+    }
+
+    float total = 0.0f;
+    for (int ch = 0; ch < numChannels; ++ch) {
+        total += levels[ch];
+    }
+    const float average = total / numChannels;
+    return average > 0.0f ? 20.0 * std::log10(average) : -96.0;
+}
+
 bool Engine_GetStatistics(EngineHandle handle, EngineStatistics_C* statistics) {
     if (!handle || !statistics) return false;
 
@@ -280,36 +357,16 @@ bool Engine_GetStatistics(EngineHandle handle, EngineStatistics_C* statistics) {
         statistics->cpuUsage = perfStats.cpuUsagePercent;
         statistics->memoryUsage = static_cast<double>(perfStats.memoryUsageBytes) / (1024.0 * 1024.0); // 转换为MB
 
-        // 获取音频电平
+        // 获取音频电平和xrun计数（无锁快照）
         if (ioManager) {
-            auto levels = ioManager->getCurrentLevels();
-
-            // 计算输入电平平均值
-            if (!levels.inputLevels.empty()) {
-                float totalInput = 0.0f;
-                for (float level : levels.inputLevels) {
-                    totalInput += level;
-                }
-                float avgInput = totalInput / levels.inputLevels.size();
-                statistics->inputLevel = avgInput > 0.0f ? 20.0 * std::log10(avgInput) : -96.0;
-            } else {
-                statistics->inputLevel = -96.0;
-            }
-
-            // 计算输出电平平均值
-            if (!levels.outputLevels.empty()) {
-                float totalOutput = 0.0f;
-                for (float level : levels.outputLevels) {
-                    totalOutput += level;
-                }
-                float avgOutput = totalOutput / levels.outputLevels.size();
-                statistics->outputLevel = avgOutput > 0.0f ? 20.0 * std::log10(avgOutput) : -96.0;
-            } else {
-                statistics->outputLevel = -96.0;
-            }
+            const auto snapshot = ioManager->getMeterSnapshot();
+            statistics->inputLevel = averageLevelDb(snapshot.inputLevels.data(), snapshot.numInputChannels);
+            statistics->outputLevel = averageLevelDb(snapshot.outputLevels.data(), snapshot.numOutputChannels);
+            statistics->dropouts = static_cast<int>(snapshot.block.xrunCount);
         } else {
             statistics->inputLevel = -96.0;
             statistics->outputLevel = -96.0;
+            statistics->dropouts = 0;
         }
 
         // 获取延迟信息
@@ -327,16 +384,78 @@ bool Engine_GetStatistics(EngineHandle handle, EngineStatistics_C* statistics) {
             statistics->totalConnections = 0;
         }
 
-        // 暂时设置为0，需要实际的dropout检测
-        statistics->dropouts = 0;
+        return true;
+    } catch (const std::exception& e) {
+        WSLOG_ERROR("EngineBridge", "获取统计信息失败: " << e.what());
+        return false;
+    }
+}
 
+static void convertLatencyPercentiles(const WindsynthVST::AudioGraph::LatencyPercentiles& source,
+                                      LatencyPercentiles_C& target) {
+    target.p50Ms = source.p50Ms;
+    target.p95Ms = source.p95Ms;
+    target.p99Ms = source.p99Ms;
+    target.p999Ms = source.p999Ms;
+    target.maxMs = source.maxMs;
+    target.blocks = source.blocks;
+    target.deadlineMisses = source.deadlineMisses;
+    target.nearMisses = source.nearMisses;
+}
+
+bool Engine_GetPerformanceStats(EngineHandle handle, PerformanceStats_C* stats) {
+    if (!handle || !stats) return false;
+
+    try {
+        auto context = getContext(handle);
+        if (!context->engine) return false;
+
+        auto engineContext = context->engine->getContext();
+        if (!engineContext) return false;
+
+        auto graphProcessor = engineContext->getGraphProcessor();
+        if (!graphProcessor) return false;
+
+        const auto perfStats = graphProcessor->getPerformanceStats();
+        stats->averageProcessingTimeMs = perfStats.averageProcessingTimeMs;
+        stats->cpuUsagePercent = perfStats.cpuUsagePercent;
+        stats->bufferDurationMs = perfStats.bufferDurationMs;
+        convertLatencyPercentiles(perfStats.overall, stats->overall);
+        convertLatencyPercentiles(perfStats.currentWindow, stats->currentWindow);
+        convertLatencyPercentiles(perfStats.lastWindow, stats->lastWindow);
+        stats->completedWindows = perfStats.completedWindows;
+        stats->deviceXruns = perfStats.deviceXruns;
+        stats->droppedStatsSamples = perfStats.droppedStatsSamples;
+        stats->realtimeViolations = perfStats.realtimeViolations;
         return true;
     } catch (const std::exception& e) {
-        std::cerr << "[EngineBridge] 获取统计信息失败: " << e.what() << std::endl;
+        WSLOG_ERROR("EngineBridge", "获取性能统计失败: " << e.what());
         return false;
     }
 }
 
+void Engine_ResetPerformanceStats(EngineHandle handle, bool windowOnly) {
+    if (!handle) return;
+
+    try {
+        auto context = getContext(handle);
+        if (!context->engine) return;
+
+        auto engineContext = context->engine->getContext();
+        if (!engineContext) return;
+
+        if (auto graphProcessor = engineContext->getGraphProcessor()) {
+            if (windowOnly) {
+                graphProcessor->resetPerformanceWindow();
+            } else {
+                graphProcessor->resetPerformanceStats();
+            }
+        }
+    } catch (const std::exception& e) {
+        WSLOG_ERROR("EngineBridge", "重置性能统计失败: " << e.what());
+    }
+}
+
 //==============================================================================
 // 音频电平和渲染实现
 //==============================================================================
@@ -355,24 +474,11 @@ double Engine_GetOutputLevel(EngineHandle handle) {
         auto ioManager = engineContext->getIOManager();
         if (!ioManager) return 0.0;
 
-        // 获取当前音频电平
-        auto levels = ioManager->getCurrentLevels();
-
         // 计算输出电平的平均值（转换为dB）
-        if (!levels.outputLevels.empty()) {
-            float totalLevel = 0.0f;
-            for (float level : levels.outputLevels) {
-                totalLevel += level;
-            }
-            float avgLevel = totalLevel / levels.outputLevels.size();
-
-            // 转换为dB（避免log(0)）
-            return avgLevel > 0.0f ? 20.0 * std::log10(avgLevel) : -96.0;
-        }
-
-        return -96.0; // 静音电平
+        const auto snapshot = ioManager->getMeterSnapshot();
+        return averageLevelDb(snapshot.outputLevels.data(), snapshot.numOutputChannels);
     } catch (const std::exception& e) {
-        std::cerr << "[EngineBridge] 获取输出电平失败: " << e.what() << std::endl;
+        WSLOG_ERROR("EngineBridge", "获取输出电平失败: " << e.what());
         return 0.0;
     }
 }
@@ -391,25 +497,49 @@ double Engine_GetInputLevel(EngineHandle handle) {
         auto ioManager = engineContext->getIOManager();
         if (!ioManager) return 0.0;
 
-        // 获取当前音频电平
-        auto levels = ioManager->getCurrentLevels();
-
         // 计算输入电平的平均值（转换为dB）
-        if (!levels.inputLevels.empty()) {
-            float totalLevel = 0.0f;
-            for (float level : levels.inputLevels) {
-                totalLevel += level;
-            }
-            float avgLevel = totalLevel / levels.inputLevels.size();
+        const auto snapshot = ioManager->getMeterSnapshot();
+        return averageLevelDb(snapshot.inputLevels.data(), snapshot.numInputChannels);
+    } catch (const std::exception& e) {
+        WSLOG_ERROR("EngineBridge", "获取输入电平失败: " << e.what());
+        return 0.0;
+    }
+}
 
-            // 转换为dB（避免log(0)）
-            return avgLevel > 0.0f ? 20.0 * std::log10(avgLevel) : -96.0;
-        }
+bool Engine_GetMeterSnapshot(EngineHandle handle, EngineMeterSnapshot_C* snapshot) {
+    if (!handle || !snapshot) return false;
+
+    try {
+        auto context = getContext(handle);
+        if (!context->engine) return false;
 
-        return -96.0; // 静音电平
+        auto engineContext = context->engine->getContext();
+        if (!engineContext) return false;
+
+        auto ioManager = engineContext->getIOManager();
+        if (!ioManager) return false;
+
+        const auto cppSnapshot = ioManager->getMeterSnapshot();
+        static_assert(ENGINE_METER_MAX_CHANNELS == WindsynthVST::AudioGraph::Constants::MAX_AUDIO_CHANNELS,
+                      "快照通道数必须与音频图最大通道数一致");
+
+        snapshot->numInputChannels = cppSnapshot.numInputChannels;
+        snapshot->numOutputChannels = cppSnapshot.numOutputChannels;
+        std::copy(cppSnapshot.inputLevels.begin(), cppSnapshot.inputLevels.end(), snapshot->inputLevels);
+        std::copy(cppSnapshot.inputPeaks.begin(), cppSnapshot.inputPeaks.end(), snapshot->inputPeaks);
+        std::copy(cppSnapshot.outputLevels.begin(), cppSnapshot.outputLevels.end(), snapshot->outputLevels);
+        std::copy(cppSnapshot.outputPeaks.begin(), cppSnapshot.outputPeaks.end(), snapshot->outputPeaks);
+        snapshot->inputClipping = cppSnapshot.inputClipping;
+        snapshot->outputClipping = cppSnapshot.outputClipping;
+        snapshot->cpuUsagePercent = cppSnapshot.block.cpuUsagePercent;
+        snapshot->processingTimeMs = cppSnapshot.block.processingTimeMs;
+        snapshot->xrunCount = cppSnapshot.block.xrunCount;
+        snapshot->blockCount = cppSnapshot.block.blockCount;
+        snapshot->timestamp = cppSnapshot.timestamp;
+        return true;
     } catch (const std::exception& e) {
-        std::cerr << "[EngineBridge] 获取输入电平失败: " << e.what() << std::endl;
-        return 0.0;
+        WSLOG_ERROR("EngineBridge", "获取电平快照失败: " << e.what());
+        return false;
     }
 }
 
@@ -420,36 +550,25 @@ bool Engine_RenderToFile(EngineHandle handle,
                         RenderProgressCallback progressCallback,
                         void* userData) {
     if (!handle || !inputPath || !outputPath || !settings) {
-        std::cerr << "[Engine_RenderToFile] 无效的参数" << std::endl;
+        WSLOG_ERROR("Engine_RenderToFile", "无效的参数");
         return false;
     }
 
     try {
         auto context = getContext(handle);
         if (!context || !context->engine) {
-            std::cerr << "[Engine_RenderToFile] 无效的引擎上下文" << std::endl;
+            WSLOG_ERROR("Engine_RenderToFile", "无效的引擎上下文");
             return false;
         }
 
-        std::cout << "[Engine_RenderToFile] 开始离线渲染" << std::endl;
-        std::cout << "输入文件: " << inputPath << std::endl;
-        std::cout << "输出文件: " << outputPath << std::endl;
+        WSLOG_INFO("Engine_RenderToFile", "开始离线渲染");
+        WSLOG_INFO("Engine_RenderToFile", "输入文件: " << inputPath);
+        WSLOG_INFO("Engine_RenderToFile", "输出文件: " << outputPath);
 
         // 转换 C 结构到 C++ 结构
         WindsynthEngineFacade::RenderSettings cppSettings;
-        cppSettings.sampleRate = settings->sampleRate;
-        cppSettings.bitDepth = settings->bitDepth;
-        cppSettings.numChannels = settings->numChannels;
-        cppSettings.normalizeOutput = settings->normalizeOutput;
-        cppSettings.includePluginTails = settings->includePluginTails;
-
-        // 转换格式枚举
-        if (settings->format == 0) {
-            cppSettings.format = WindsynthEngineFacade::RenderSettings::Format::WAV;
-        } else if (settings->format == 1) {
-            cppSettings.format = WindsynthEngineFacade::RenderSettings::Format::AIFF;
-        } else {
-            std::cerr << "[Engine_RenderToFile] 不支持的音频格式: " << settings->format << std::endl;
+        if (!convertRenderSettings(settings, cppSettings)) {
+            WSLOG_ERROR("Engine_RenderToFile", "不支持的音频格式: " << settings->format);
             return false;
         }
 
@@ -468,18 +587,365 @@ bool Engine_RenderToFile(EngineHandle handle,
                                                    cppProgressCallback);
 
         if (result) {
-            std::cout << "[Engine_RenderToFile] 离线渲染成功完成" << std::endl;
+            WSLOG_INFO("Engine_RenderToFile", "离线渲染成功完成");
         } else {
-            std::cout << "[Engine_RenderToFile] 离线渲染失败" << std::endl;
+            WSLOG_WARNING("Engine_RenderToFile", "离线渲染失败");
         }
 
         return result;
 
     } catch (const std::exception& e) {
-        std::cerr << "[Engine_RenderToFile] 异常: " << e.what() << std::endl;
+        WSLOG_ERROR("Engine_RenderToFile", "异常: " << e.what());
         return false;
     } catch (...) {
-        std::cerr << "[Engine_RenderToFile] 未知异常" << std::endl;
+        WSLOG_ERROR("Engine_RenderToFile", "未知异常");
+        return false;
+    }
+}
+
+int32_t Engine_RenderBatch(EngineHandle handle,
+                           const char* const* inputPaths,
+                           const char* const* outputPaths,
+                           int32_t numJobs,
+                           const RenderSettings_C* settings,
+                           int32_t maxParallelJobs,
+                           BatchRenderProgressCallback progressCallback,
+                           void* userData,
+                           RenderResult_C* results) {
+    if (!handle || !inputPaths || !outputPaths || !settings || numJobs < 0) {
+        WSLOG_ERROR("Engine_RenderBatch", "无效的参数");
+        return -1;
+    }
+
+    try {
+        auto context = getContext(handle);
+        if (!context || !context->engine) {
+            WSLOG_ERROR("Engine_RenderBatch", "无效的引擎上下文");
+            return -1;
+        }
+
+        WindsynthEngineFacade::RenderSettings cppSettings;
+        if (!convertRenderSettings(settings, cppSettings)) {
+            WSLOG_ERROR("Engine_RenderBatch", "不支持的音频格式: " << settings->format);
+            return -1;
+        }
+
+        std::vector<Render::RenderJob> jobs;
+        jobs.reserve(static_cast<size_t>(numJobs));
+        for (int32_t i = 0; i < numJobs; ++i) {
+            if (!inputPaths[i] || !outputPaths[i]) {
+                WSLOG_ERROR("Engine_RenderBatch", "任务 " << i << " 的路径无效");
+                return -1;
+            }
+            jobs.emplace_back(std::string(inputPaths[i]), std::string(outputPaths[i]), cppSettings);
+        }
+
+        // 创建进度回调包装器
+        Render::BatchRenderProgressCallback cppProgressCallback = nullptr;
+        if (progressCallback) {
+            cppProgressCallback = [progressCallback, userData](int jobIndex, float progress, const std::string& message) {
+                progressCallback(static_cast<int32_t>(jobIndex), progress, message.c_str(), userData);
+            };
+        }
+
+        auto cppResults = context->engine->renderBatch(jobs, maxParallelJobs, cppProgressCallback);
+
+        int32_t succeeded = 0;
+        for (size_t i = 0; i < cppResults.size(); ++i) {
+            const auto& result = cppResults[i];
+            if (result.success) {
+                ++succeeded;
+            }
+
+            if (results) {
+                convertRenderResultToC(result, results[i]);
+            }
+        }
+
+        WSLOG_INFO("Engine_RenderBatch", "批量渲染完成，成功: " << succeeded << "/" << numJobs);
+        return succeeded;
+
+    } catch (const std::exception& e) {
+        WSLOG_ERROR("Engine_RenderBatch", "异常: " << e.what());
+        return -1;
+    } catch (...) {
+        WSLOG_ERROR("Engine_RenderBatch", "未知异常");
+        return -1;
+    }
+}
+
+int32_t Engine_RenderToFileAsync(EngineHandle handle,
+                                 const char* inputPath,
+                                 const char* outputPath,
+                                 const RenderSettings_C* settings,
+                                 RenderProgressCallback progressCallback,
+                                 RenderCompletionCallback completionCallback,
+                                 void* userData) {
+    if (!handle || !inputPath || !outputPath || !settings) {
+        WSLOG_ERROR("Engine_RenderToFileAsync", "无效的参数");
+        return 0;
+    }
+
+    try {
+        auto context = getContext(handle);
+        if (!context || !context->engine) {
+            WSLOG_ERROR("Engine_RenderToFileAsync", "无效的引擎上下文");
+            return 0;
+        }
+
+        WindsynthEngineFacade::RenderSettings cppSettings;
+        if (!convertRenderSettings(settings, cppSettings)) {
+            WSLOG_ERROR("Engine_RenderToFileAsync", "不支持的音频格式: " << settings->format);
+            return 0;
+        }
+
+        WindsynthEngineFacade::RenderProgressCallback cppProgressCallback = nullptr;
+        if (progressCallback) {
+            cppProgressCallback = [progressCallback, userData](float progress, const std::string& message) {
+                progressCallback(progress, message.c_str(), userData);
+            };
+        }
+
+        WindsynthEngineFacade::RenderCompletionCallback cppCompletionCallback = nullptr;
+        if (completionCallback) {
+            cppCompletionCallback = [completionCallback, userData](int32_t jobID, const Render::RenderResult& result) {
+                RenderResult_C cResult{};
+                convertRenderResultToC(result, cResult);
+                completionCallback(jobID, &cResult, userData);
+            };
+        }
+
+        return context->engine->renderToFileAsync(std::string(inputPath), std::string(outputPath), cppSettings,
+                                                  cppProgressCallback, cppCompletionCallback);
+
+    } catch (const std::exception& e) {
+        WSLOG_ERROR("Engine_RenderToFileAsync", "异常: " << e.what());
+        return 0;
+    } catch (...) {
+        WSLOG_ERROR("Engine_RenderToFileAsync", "未知异常");
+        return 0;
+    }
+}
+
+bool Engine_CancelRender(EngineHandle handle, int32_t jobID) {
+    if (!handle) return false;
+
+    auto context = getContext(handle);
+    if (!context || !context->engine) return false;
+
+    return context->engine->cancelRender(jobID);
+}
+
+int32_t Engine_GetActiveRenderCount(EngineHandle handle) {
+    if (!handle) return 0;
+
+    auto context = getContext(handle);
+    if (!context || !context->engine) return 0;
+
+    return context->engine->getNumActiveRenders();
+}
+
+//==============================================================================
+// 多轨录音
+//==============================================================================
+
+bool Engine_StartRecording(EngineHandle handle,
+                           const char* outputDirectory,
+                           const char* takeName,
+                           const RecordingSettings_C* settings,
+                           const RecordingTrack_C* tracks,
+                           int32_t numTracks) {
+    if (!handle || !outputDirectory || !tracks || numTracks <= 0) return false;
+
+    try {
+        auto context = getContext(handle);
+        if (!context->engine) return false;
+
+        WindsynthEngineFacade::RecordingSettings cppSettings;
+        cppSettings.outputDirectory = outputDirectory;
+        if (takeName && takeName[0] != '\0') {
+            cppSettings.takeName = takeName;
+        }
+        if (settings) {
+            cppSettings.format = settings->format == 1
+                ? WindsynthVST::AudioGraph::DiskRecorder::FileFormat::AIFF
+                : WindsynthVST::AudioGraph::DiskRecorder::FileFormat::WAV;
+            if (settings->bitDepth > 0) {
+                cppSettings.bitDepth = settings->bitDepth;
+            }
+            if (settings->diskBufferSamples > 0) {
+                cppSettings.diskBufferSamples = settings->diskBufferSamples;
+            }
+            if (settings->captureBufferSamples > 0) {
+                cppSettings.captureBufferSamples = settings->captureBufferSamples;
+            }
+        }
+
+        std::vector<WindsynthEngineFacade::RecordingTrack> cppTracks;
+        cppTracks.reserve(static_cast<size_t>(numTracks));
+        for (int32_t i = 0; i < numTracks; ++i) {
+            const auto& track = tracks[i];
+            cppTracks.emplace_back(std::string(track.name, strnlen(track.name, sizeof(track.name))),
+                                   track.source == 1 ? WindsynthVST::AudioGraph::CapturePoint::PostGraph
+                                                     : WindsynthVST::AudioGraph::CapturePoint::PreGraph,
+                                   track.firstChannel,
+                                   track.numChannels);
+        }
+
+        return context->engine->startRecording(cppSettings, cppTracks);
+
+    } catch (const std::exception& e) {
+        WSLOG_ERROR("Engine_StartRecording", "异常: " << e.what());
+        return false;
+    }
+}
+
+void Engine_StopRecording(EngineHandle handle) {
+    if (!handle) return;
+
+    try {
+        auto context = getContext(handle);
+        if (context->engine) {
+            context->engine->stopRecording();
+        }
+    } catch (const std::exception& e) {
+        WSLOG_ERROR("Engine_StopRecording", "异常: " << e.what());
+    }
+}
+
+bool Engine_IsRecording(EngineHandle handle) {
+    if (!handle) return false;
+
+    try {
+        auto context = getContext(handle);
+        return context->engine && context->engine->isRecording();
+    } catch (const std::exception& e) {
+        WSLOG_ERROR("Engine_IsRecording", "异常: " << e.what());
+        return false;
+    }
+}
+
+void Engine_PunchIn(EngineHandle handle) {
+    if (!handle) return;
+
+    try {
+        auto context = getContext(handle);
+        if (context->engine) {
+            context->engine->punchIn();
+        }
+    } catch (const std::exception& e) {
+        WSLOG_ERROR("Engine_PunchIn", "异常: " << e.what());
+    }
+}
+
+void Engine_PunchOut(EngineHandle handle) {
+    if (!handle) return;
+
+    try {
+        auto context = getContext(handle);
+        if (context->engine) {
+            context->engine->punchOut();
+        }
+    } catch (const std::exception& e) {
+        WSLOG_ERROR("Engine_PunchOut", "异常: " << e.what());
+    }
+}
+
+void Engine_SetPunchRange(EngineHandle handle, int64_t punchInSample, int64_t punchOutSample) {
+    if (!handle) return;
+
+    try {
+        auto context = getContext(handle);
+        if (context->engine) {
+            context->engine->setPunchRange(punchInSample, punchOutSample);
+        }
+    } catch (const std::exception& e) {
+        WSLOG_ERROR("Engine_SetPunchRange", "异常: " << e.what());
+    }
+}
+
+void Engine_ClearPunchRange(EngineHandle handle) {
+    if (!handle) return;
+
+    try {
+        auto context = getContext(handle);
+        if (context->engine) {
+            context->engine->clearPunchRange();
+        }
+    } catch (const std::exception& e) {
+        WSLOG_ERROR("Engine_ClearPunchRange", "异常: " << e.what());
+    }
+}
+
+bool Engine_GetRecordingStats(EngineHandle handle, RecordingStats_C* stats) {
+    if (!handle || !stats) return false;
+
+    try {
+        auto context = getContext(handle);
+        if (!context->engine) return false;
+
+        const auto cppStats = context->engine->getRecordingStatistics();
+        stats->isRecording = cppStats.isRecording;
+        stats->samplesCaptured = cppStats.samplesCaptured;
+        stats->samplesWritten = cppStats.samplesWritten;
+        stats->captureOverruns = cppStats.captureOverruns;
+        stats->droppedSamples = cppStats.droppedSamples;
+        stats->diskStalls = cppStats.diskStalls;
+        stats->captureBufferFill = cppStats.captureBufferFill;
+        stats->punchEnabled = cppStats.punchEnabled;
+        stats->punchInSample = cppStats.punchInSample;
+        stats->punchOutSample = cppStats.punchOutSample;
+        stats->numTracks = cppStats.numTracks;
+        return true;
+
+    } catch (const std::exception& e) {
+        WSLOG_ERROR("Engine_GetRecordingStats", "异常: " << e.what());
+        return false;
+    }
+}
+
+//==============================================================================
+// MIDI输入实现
+//==============================================================================
+
+int32_t Engine_GetMidiInputDevices(EngineHandle handle, MidiInputDevice_C* devices, int32_t maxDevices) {
+    if (!handle) return 0;
+
+    try {
+        auto context = getContext(handle);
+        if (!context->engine) return 0;
+
+        const auto cppDevices = context->engine->getMidiInputDevices();
+        if (devices) {
+            const int32_t count = std::min(maxDevices, static_cast<int32_t>(cppDevices.size()));
+            for (int32_t i = 0; i < count; ++i) {
+                const auto& device = cppDevices[static_cast<size_t>(i)];
+                strncpy(devices[i].name, device.name.c_str(), sizeof(devices[i].name) - 1);
+                devices[i].name[sizeof(devices[i].name) - 1] = '\0';
+                strncpy(devices[i].identifier, device.identifier.c_str(), sizeof(devices[i].identifier) - 1);
+                devices[i].identifier[sizeof(devices[i].identifier) - 1] = '\0';
+                devices[i].enabled = device.enabled;
+            }
+        }
+        return static_cast<int32_t>(cppDevices.size());
+
+    } catch (const std::exception& e) {
+        WSLOG_ERROR("Engine_GetMidiInputDevices", "异常: " << e.what());
+        return 0;
+    }
+}
+
+bool Engine_SetMidiInputDeviceEnabled(EngineHandle handle, const char* identifier, bool enabled) {
+    if (!handle || !identifier) return false;
+
+    try {
+        auto context = getContext(handle);
+        if (!context->engine) return false;
+
+        return context->engine->setMidiInputDeviceEnabled(identifier, enabled);
+
+    } catch (const std::exception& e) {
+        WSLOG_ERROR("Engine_SetMidiInputDeviceEnabled", "异常: " << e.what());
         return false;
     }
 }
@@ -34,6 +34,16 @@ typedef struct {
     char units[32];
 } ParameterInfo_C;
 
+/**
+ * 参数变化（C兼容）
+ */
+typedef struct {
+    int parameterIndex;
+    float value;            // 参数值（0.0-1.0）
+    int sampleOffset;       // 相对于节点下一个处理块的采样偏移
+    int rampSamples;        // 大于0时线性过渡到目标值
+} ParameterChange_C;
+
 //==============================================================================
 // 参数控制
 //==============================================================================
@@ -51,6 +61,19 @@ bool Engine_SetNodeParameter(EngineHandle handle,
                              int parameterIndex,
                              float value);
 
+/**
+ * 批量设置节点参数（一次调用排队多个参数变化，在音频线程中按采样偏移应用）
+ * @param handle 引擎句柄
+ * @param nodeID 节点ID
+ * @param changes 参数变化数组
+ * @param count 数组长度
+ * @return 成功排队的参数变化数量
+ */
+int Engine_SetNodeParameters(EngineHandle handle,
+                             uint32_t nodeID,
+                             const ParameterChange_C* changes,
+                             int count);
+
 /**
  * 获取节点参数
  * @param handle 引擎句柄
@@ -70,6 +93,19 @@ float Engine_GetNodeParameter(EngineHandle handle,
  */
 int Engine_GetNodeParameterCount(EngineHandle handle, uint32_t nodeID);
 
+/**
+ * 读取节点的所有参数值（来自参数缓存，一次复制，适合界面定时刷新）
+ * @param handle 引擎句柄
+ * @param nodeID 节点ID
+ * @param values 输出数组，按参数索引排列
+ * @param maxCount 数组容量
+ * @return 实际复制的参数数量
+ */
+int Engine_GetNodeParameterValues(EngineHandle handle,
+                                  uint32_t nodeID,
+                                  float* values,
+                                  int maxCount);
+
 /**
  * 获取节点参数信息
  * @param handle 引擎句柄
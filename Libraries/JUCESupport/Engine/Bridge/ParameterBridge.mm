@@ -8,7 +8,7 @@
 
 #include "ParameterBridge.h"
 #include "BridgeInternal.h"
-#include <iostream>
+#include "AudioGraph/Core/Logger.hpp"
 
 //==============================================================================
 // 参数控制实现
@@ -47,11 +47,39 @@ bool Engine_SetNodeParameter(EngineHandle handle,
 
         return context->engine->setNodeParameter(nodeID, parameterIndex, value);
     } catch (const std::exception& e) {
-        std::cerr << "[ParameterBridge] 设置节点参数失败: " << e.what() << std::endl;
+        WSLOG_ERROR("ParameterBridge", "设置节点参数失败: " << e.what());
         return false;
     }
 }
 
+int Engine_SetNodeParameters(EngineHandle handle,
+                             uint32_t nodeID,
+                             const ParameterChange_C* changes,
+                             int count) {
+    if (!handle || !changes || count <= 0) return 0;
+
+    try {
+        auto context = getContext(handle);
+        if (!context->engine) return 0;
+
+        std::vector<Interfaces::ParameterChange> cppChanges;
+        cppChanges.reserve(static_cast<size_t>(count));
+        for (int i = 0; i < count; ++i) {
+            Interfaces::ParameterChange change;
+            change.parameterIndex = changes[i].parameterIndex;
+            change.value = changes[i].value;
+            change.sampleOffset = changes[i].sampleOffset;
+            change.rampSamples = changes[i].rampSamples;
+            cppChanges.push_back(change);
+        }
+
+        return context->engine->setNodeParameters(nodeID, cppChanges);
+    } catch (const std::exception& e) {
+        WSLOG_ERROR("ParameterBridge", "批量设置节点参数失败: " << e.what());
+        return 0;
+    }
+}
+
 float Engine_GetNodeParameter(EngineHandle handle,
                                        uint32_t nodeID,
                                        int parameterIndex) {
@@ -63,7 +91,7 @@ float Engine_GetNodeParameter(EngineHandle handle,
 
         return context->engine->getNodeParameter(nodeID, parameterIndex);
     } catch (const std::exception& e) {
-        std::cerr << "[ParameterBridge] 获取节点参数失败: " << e.what() << std::endl;
+        WSLOG_ERROR("ParameterBridge", "获取节点参数失败: " << e.what());
         return -1.0f;
     }
 }
@@ -77,7 +105,7 @@ int Engine_GetNodeParameterCount(EngineHandle handle, uint32_t nodeID) {
 
         return context->engine->getNodeParameterCount(nodeID);
     } catch (const std::exception& e) {
-        std::cerr << "[ParameterBridge] 获取节点参数数量失败: " << e.what() << std::endl;
+        WSLOG_ERROR("ParameterBridge", "获取节点参数数量失败: " << e.what());
         return 0;
     }
 }
@@ -100,7 +128,7 @@ bool Engine_GetNodeParameterInfo(EngineHandle handle,
         convertParameterInfo(cppInfo.value(), info);
         return true;
     } catch (const std::exception& e) {
-        std::cerr << "[ParameterBridge] 获取节点参数信息失败: " << e.what() << std::endl;
+        WSLOG_ERROR("ParameterBridge", "获取节点参数信息失败: " << e.what());
         return false;
     }
 }
@@ -119,7 +147,7 @@ bool Engine_ResetNodeParameter(EngineHandle handle,
 
         return paramController->resetNodeParameter(nodeID, parameterIndex);
     } catch (const std::exception& e) {
-        std::cerr << "[ParameterBridge] 重置节点参数失败: " << e.what() << std::endl;
+        WSLOG_ERROR("ParameterBridge", "重置节点参数失败: " << e.what());
         return false;
     }
 }
@@ -146,7 +174,27 @@ int Engine_GetAllParameterInfo(EngineHandle handle,
 
         return count;
     } catch (const std::exception& e) {
-        std::cerr << "[ParameterBridge] 获取所有参数信息失败: " << e.what() << std::endl;
+        WSLOG_ERROR("ParameterBridge", "获取所有参数信息失败: " << e.what());
+        return 0;
+    }
+}
+
+int Engine_GetNodeParameterValues(EngineHandle handle,
+                                  uint32_t nodeID,
+                                  float* values,
+                                  int maxCount) {
+    if (!handle || !values || maxCount <= 0) return 0;
+
+    try {
+        auto context = getContext(handle);
+        if (!context->engine) return 0;
+
+        auto paramController = context->engine->getParameterController();
+        if (!paramController) return 0;
+
+        return paramController->getNodeParameterValues(nodeID, values, maxCount);
+    } catch (const std::exception& e) {
+        WSLOG_ERROR("ParameterBridge", "读取节点参数值失败: " << e.what());
         return 0;
     }
 }
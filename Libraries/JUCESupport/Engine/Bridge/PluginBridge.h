@@ -43,8 +43,75 @@ typedef struct {
     bool isBypassed;
     int numInputChannels;
     int numOutputChannels;
+    bool sleepWhenSilent;   // 启用静音休眠
+    bool isSleeping;        // 当前处于休眠状态
 } NodeInfo_C;
 
+/**
+ * 节点处理耗时统计结构（C兼容）
+ */
+typedef struct {
+    uint32_t nodeID;
+    char name[256];
+    double averageTimeMs;
+    double peakTimeMs;
+    double lastTimeMs;
+    double budgetPercent;       // 平均耗时占块时长的百分比
+    double peakBudgetPercent;   // 峰值耗时占块时长的百分比
+    uint64_t blocks;
+} NodeProfile_C;
+
+/**
+ * 插件扫描缓存统计结构（C兼容）
+ */
+typedef struct {
+    int numBundles;             // 缓存的插件包数量
+    int numPlugins;             // 缓存的插件数量
+    int lastScanUnchanged;      // 上次扫描中直接使用缓存的插件包数量
+    int lastScanRescanned;      // 上次扫描中重新扫描的插件包数量
+    int lastScanRemoved;        // 上次扫描中已不存在的插件包数量
+} PluginScanCacheStats_C;
+
+/**
+ * 插件实例池统计结构（C兼容）
+ */
+typedef struct {
+    int idleInstances;          // 可立即取用的实例
+    int retiringInstances;      // 等待渲染序列释放的实例
+    int pendingPrewarms;        // 正在后台创建的实例
+    uint64_t hits;
+    uint64_t misses;
+    uint64_t prewarmed;
+    uint64_t recycled;
+    uint64_t evictions;
+} PluginPoolStats_C;
+
+/**
+ * 并行处理统计（C兼容）
+ */
+typedef struct {
+    bool enabled;
+    bool planIsParallel;
+    int numWorkers;
+    int numNodes;
+    int maxParallelWidth;
+    uint64_t parallelBlocks;
+    uint64_t serialBlocks;
+    uint64_t stolenTasks;
+} ParallelProcessingStats_C;
+
+/**
+ * 图延迟信息（C兼容，单位为采样）
+ */
+typedef struct {
+    int graphLatencySamples;
+    int compensationSamples;
+    int inputDeviceLatencySamples;
+    int outputDeviceLatencySamples;
+    int roundTripLatencySamples;
+    double sampleRate;
+} GraphLatencyInfo_C;
+
 /**
  * 简化插件信息结构（C兼容）- 与 SimplePluginInfo 对应
  */
@@ -101,6 +168,76 @@ void Engine_StopPluginScan(EngineHandle handle);
  */
 bool Engine_IsScanning(EngineHandle handle);
 
+/**
+ * 获取插件扫描缓存统计
+ * @param handle 引擎句柄
+ * @param stats 输出统计信息
+ * @return 成功返回true
+ */
+bool Engine_GetPluginScanCacheStats(EngineHandle handle, PluginScanCacheStats_C* stats);
+
+/**
+ * 清空插件扫描缓存（下次扫描时重新扫描所有插件）
+ * @param handle 引擎句柄
+ */
+void Engine_ClearPluginScanCache(EngineHandle handle);
+
+/**
+ * 启用或禁用多进程插件扫描（默认启用）
+ * @param handle 引擎句柄
+ * @param enabled 是否在辅助进程中扫描
+ */
+void Engine_SetOutOfProcessPluginScanning(EngineHandle handle, bool enabled);
+
+/**
+ * 设置插件扫描辅助进程的路径（默认为应用包内的 WindsynthPluginScanner）
+ * @param handle 引擎句柄
+ * @param executablePath 可执行文件路径
+ */
+void Engine_SetPluginScanWorkerPath(EngineHandle handle, const char* executablePath);
+
+/**
+ * 设置单个插件的扫描超时时间，超时的插件会被加入黑名单
+ * @param handle 引擎句柄
+ * @param timeoutMs 超时时间（毫秒）
+ */
+void Engine_SetPluginScanTimeout(EngineHandle handle, int timeoutMs);
+
+//==============================================================================
+// 插件实例池
+//==============================================================================
+
+/**
+ * 设置插件实例池的空闲实例上限（0表示禁用）
+ * @param handle 引擎句柄
+ * @param maxIdleInstances 空闲实例上限
+ */
+void Engine_SetPluginPoolSize(EngineHandle handle, int maxIdleInstances);
+
+/**
+ * 设置预热插件列表，列表中的插件会在后台预先实例化
+ * @param handle 引擎句柄
+ * @param identifiers 插件标识符数组
+ * @param count 数组长度
+ * @param instancesPerPlugin 每个插件保持的空闲实例数
+ * @return 找到的插件数量
+ */
+int Engine_SetPluginPrewarmList(EngineHandle handle, const char** identifiers, int count, int instancesPerPlugin);
+
+/**
+ * 获取插件实例池统计
+ * @param handle 引擎句柄
+ * @param stats 输出统计信息
+ * @return 成功返回true
+ */
+bool Engine_GetPluginPoolStats(EngineHandle handle, PluginPoolStats_C* stats);
+
+/**
+ * 销毁插件实例池中的所有空闲实例
+ * @param handle 引擎句柄
+ */
+void Engine_ClearPluginPool(EngineHandle handle);
+
 /**
  * 获取可用插件数量
  * @param handle 引擎句柄
@@ -200,6 +337,15 @@ bool Engine_GetLoadedNodeInfo(EngineHandle handle,
  */
 bool Engine_SetNodeBypassed(EngineHandle handle, uint32_t nodeID, bool bypassed);
 
+/**
+ * 设置节点静音休眠（输入和输出静音超过插件尾音长度后跳过处理，信号恢复时自动唤醒）
+ * @param handle 引擎句柄
+ * @param nodeID 节点ID
+ * @param sleepWhenSilent 是否启用
+ * @return 成功返回true
+ */
+bool Engine_SetNodeSleepWhenSilent(EngineHandle handle, uint32_t nodeID, bool sleepWhenSilent);
+
 /**
  * 设置节点启用状态
  * @param handle 引擎句柄
@@ -268,6 +414,24 @@ bool Engine_SwapNodes(EngineHandle handle, uint32_t nodeID1, uint32_t nodeID2);
  */
 int Engine_CreateProcessingChain(EngineHandle handle, const uint32_t* nodeIDs, int count);
 
+/**
+ * 冻结节点或处理链（按当前加载的音频文件离线渲染，并用播放节点替换这些节点，同步执行）
+ * @param handle 引擎句柄
+ * @param nodeIDs 节点ID数组
+ * @param count 节点数量
+ * @param unloadPlugins 是否卸载被冻结的插件实例（解冻时重新加载）
+ * @return 播放节点ID，失败时返回0
+ */
+uint32_t Engine_FreezeNodes(EngineHandle handle, const uint32_t* nodeIDs, int count, bool unloadPlugins);
+
+/**
+ * 解冻：恢复被冻结的节点和连接
+ * @param handle 引擎句柄
+ * @param playerNodeID 冻结时返回的播放节点ID
+ * @return 成功返回true
+ */
+bool Engine_UnfreezeNodes(EngineHandle handle, uint32_t playerNodeID);
+
 /**
  * 自动连接到输入输出
  * @param handle 引擎句柄
@@ -276,6 +440,68 @@ int Engine_CreateProcessingChain(EngineHandle handle, const uint32_t* nodeIDs, i
  */
 bool Engine_AutoConnectToIO(EngineHandle handle, uint32_t nodeID);
 
+//==============================================================================
+// 图拓扑切换
+//==============================================================================
+
+/**
+ * 设置图拓扑切换时淡出和淡入各自的时长（默认5ms，0表示直接切换）
+ * @param handle 引擎句柄
+ * @param milliseconds 时长（毫秒）
+ */
+void Engine_SetGraphSwapFadeTime(EngineHandle handle, double milliseconds);
+
+/**
+ * 启用或禁用独立分支的并行处理（默认禁用）
+ * @param handle 引擎句柄
+ * @param enabled 是否启用
+ * @param numWorkers 工作线程数量（0表示按CPU核心数自动选择）
+ */
+void Engine_SetParallelProcessing(EngineHandle handle, bool enabled, int numWorkers);
+
+/**
+ * 获取并行处理统计
+ * @param handle 引擎句柄
+ * @param stats 输出统计信息
+ * @return 成功返回true
+ */
+bool Engine_GetParallelProcessingStats(EngineHandle handle, ParallelProcessingStats_C* stats);
+
+/**
+ * 获取图延迟（沿最长路径）和包含设备延迟的往返延迟
+ * 录制输入信号时应按往返延迟对齐
+ * @param handle 引擎句柄
+ * @param info 输出延迟信息
+ * @return 成功返回true
+ */
+bool Engine_GetLatencyInfo(EngineHandle handle, GraphLatencyInfo_C* info);
+
+//==============================================================================
+// 节点耗时统计
+//==============================================================================
+
+/**
+ * 启用或禁用节点耗时统计（默认禁用）
+ * @param handle 引擎句柄
+ * @param enabled 是否启用
+ */
+void Engine_SetNodeProfilingEnabled(EngineHandle handle, bool enabled);
+
+/**
+ * 获取插件节点的处理耗时统计
+ * @param handle 引擎句柄
+ * @param profiles 输出统计数组
+ * @param maxCount 数组最大容量
+ * @return 实际返回的节点数量
+ */
+int Engine_GetNodeProfiles(EngineHandle handle, NodeProfile_C* profiles, int maxCount);
+
+/**
+ * 清零所有节点的处理耗时统计
+ * @param handle 引擎句柄
+ */
+void Engine_ResetNodeProfiles(EngineHandle handle);
+
 #ifdef __cplusplus
 }
 #endif
@@ -8,7 +8,7 @@
 
 #include "PluginBridge.h"
 #include "BridgeInternal.h"
-#include <iostream>
+#include "AudioGraph/Core/Logger.hpp"
 #include <memory>
 
 // 使用命名空间别名简化代码
@@ -59,6 +59,8 @@ static void convertNodeInfo(const Interfaces::SimpleNodeInfo& cppInfo, NodeInfo_
     cInfo->isBypassed = cppInfo.isBypassed;
     cInfo->numInputChannels = cppInfo.numInputChannels;
     cInfo->numOutputChannels = cppInfo.numOutputChannels;
+    cInfo->sleepWhenSilent = cppInfo.sleepWhenSilent;
+    cInfo->isSleeping = cppInfo.isSleeping;
 }
 
 int Engine_GetAvailablePluginCount(EngineHandle handle) {
@@ -71,7 +73,7 @@ int Engine_GetAvailablePluginCount(EngineHandle handle) {
         auto plugins = context->engine->getAvailablePlugins();
         return static_cast<int>(plugins.size());
     } catch (const std::exception& e) {
-        std::cerr << "[PluginBridge] 获取插件数量失败: " << e.what() << std::endl;
+        WSLOG_ERROR("PluginBridge", "获取插件数量失败: " << e.what());
         return 0;
     }
 }
@@ -94,7 +96,7 @@ int Engine_GetAvailablePlugins(EngineHandle handle,
 
         return count;
     } catch (const std::exception& e) {
-        std::cerr << "[PluginBridge] 获取插件列表失败: " << e.what() << std::endl;
+        WSLOG_ERROR("PluginBridge", "获取插件列表失败: " << e.what());
         return 0;
     }
 }
@@ -116,7 +118,7 @@ bool Engine_GetAvailablePluginInfo(EngineHandle handle,
         convertPluginInfo(cppPlugins[index], pluginInfo);
         return true;
     } catch (const std::exception& e) {
-        std::cerr << "[PluginBridge] 获取插件信息失败: " << e.what() << std::endl;
+        WSLOG_ERROR("PluginBridge", "获取插件信息失败: " << e.what());
         return false;
     }
 }
@@ -155,7 +157,7 @@ void Engine_LoadPluginAsync(EngineHandle handle,
                 }
             });
     } catch (const std::exception& e) {
-        std::cerr << "[PluginBridge] 异步加载插件失败: " << e.what() << std::endl;
+        WSLOG_ERROR("PluginBridge", "异步加载插件失败: " << e.what());
         if (callback) {
             callback(0, false, e.what(), userData);
         }
@@ -171,7 +173,7 @@ bool Engine_RemoveNode(EngineHandle handle, uint32_t nodeID) {
 
         return context->engine->removeNode(nodeID);
     } catch (const std::exception& e) {
-        std::cerr << "[PluginBridge] 移除节点失败: " << e.what() << std::endl;
+        WSLOG_ERROR("PluginBridge", "移除节点失败: " << e.what());
         return false;
     }
 }
@@ -186,7 +188,7 @@ int Engine_GetLoadedNodeCount(EngineHandle handle) {
         auto nodes = context->engine->getLoadedNodes();
         return static_cast<int>(nodes.size());
     } catch (const std::exception& e) {
-        std::cerr << "[PluginBridge] 获取节点数量失败: " << e.what() << std::endl;
+        WSLOG_ERROR("PluginBridge", "获取节点数量失败: " << e.what());
         return 0;
     }
 }
@@ -209,7 +211,7 @@ int Engine_GetLoadedNodes(EngineHandle handle,
 
         return count;
     } catch (const std::exception& e) {
-        std::cerr << "[PluginBridge] 获取节点列表失败: " << e.what() << std::endl;
+        WSLOG_ERROR("PluginBridge", "获取节点列表失败: " << e.what());
         return 0;
     }
 }
@@ -231,7 +233,7 @@ bool Engine_GetLoadedNodeInfo(EngineHandle handle,
         convertNodeInfo(cppNodes[index], nodeInfo);
         return true;
     } catch (const std::exception& e) {
-        std::cerr << "[PluginBridge] 获取节点信息失败: " << e.what() << std::endl;
+        WSLOG_ERROR("PluginBridge", "获取节点信息失败: " << e.what());
         return false;
     }
 }
@@ -245,7 +247,21 @@ bool Engine_SetNodeBypassed(EngineHandle handle, uint32_t nodeID, bool bypassed)
 
         return context->engine->setNodeBypassed(nodeID, bypassed);
     } catch (const std::exception& e) {
-        std::cerr << "[PluginBridge] 设置节点旁路状态失败: " << e.what() << std::endl;
+        WSLOG_ERROR("PluginBridge", "设置节点旁路状态失败: " << e.what());
+        return false;
+    }
+}
+
+bool Engine_SetNodeSleepWhenSilent(EngineHandle handle, uint32_t nodeID, bool sleepWhenSilent) {
+    if (!handle) return false;
+
+    try {
+        auto context = getContext(handle);
+        if (!context->engine) return false;
+
+        return context->engine->setNodeSleepWhenSilent(nodeID, sleepWhenSilent);
+    } catch (const std::exception& e) {
+        WSLOG_ERROR("PluginBridge", "设置节点静音休眠失败: " << e.what());
         return false;
     }
 }
@@ -259,7 +275,7 @@ bool Engine_SetNodeEnabled(EngineHandle handle, uint32_t nodeID, bool enabled) {
 
         return context->engine->setNodeEnabled(nodeID, enabled);
     } catch (const std::exception& e) {
-        std::cerr << "[PluginBridge] 设置节点启用状态失败: " << e.what() << std::endl;
+        WSLOG_ERROR("PluginBridge", "设置节点启用状态失败: " << e.what());
         return false;
     }
 }
@@ -301,25 +317,35 @@ void Engine_ScanPluginsAsync(EngineHandle handle,
             return;
         }
 
-        // 设置进度回调
+        // 加载器由所有引擎共享，每个引擎只替换自己的监听；其他引擎已发起扫描时直接收到同一次扫描的进度
+        if (context->pluginScanListenerID != 0) {
+            pluginLoader->removeScanListener(context->pluginScanListenerID);
+            context->pluginScanListenerID = 0;
+        }
+
+        WindsynthVST::AudioGraph::ModernPluginLoader::ScanProgressCallback progress;
         if (progressCallback) {
-            pluginLoader->setScanProgressCallback([progressCallback, userData](float progress, const juce::String& currentFile) {
-                progressCallback(progress, currentFile.toRawUTF8(), userData);
-            });
+            progress = [progressCallback, userData](float value, const juce::String& currentFile) {
+                progressCallback(value, currentFile.toRawUTF8(), userData);
+            };
         }
 
-        // 设置完成回调
+        WindsynthVST::AudioGraph::ModernPluginLoader::ScanCompleteCallback complete;
         if (completionCallback) {
-            pluginLoader->setScanCompleteCallback([completionCallback, userData](int foundPlugins) {
+            complete = [completionCallback, userData](int foundPlugins) {
                 completionCallback(foundPlugins, userData);
-            });
+            };
         }
 
-        // 开始异步扫描
+        if (progress || complete) {
+            context->pluginScanListenerID = pluginLoader->addScanListener(std::move(progress), std::move(complete));
+        }
+
+        // 开始异步扫描（已有扫描在进行中时不会重复启动）
         pluginLoader->scanDefaultPathsAsync(rescanExisting);
 
     } catch (const std::exception& e) {
-        std::cerr << "[PluginBridge] 异步扫描插件失败: " << e.what() << std::endl;
+        WSLOG_ERROR("PluginBridge", "异步扫描插件失败: " << e.what());
         if (completionCallback) {
             completionCallback(0, userData);
         }
@@ -344,7 +370,7 @@ void Engine_StopPluginScan(EngineHandle handle) {
         pluginLoader->stopScanning();
 
     } catch (const std::exception& e) {
-        std::cerr << "[PluginBridge] 停止插件扫描失败: " << e.what() << std::endl;
+        WSLOG_ERROR("PluginBridge", "停止插件扫描失败: " << e.what());
     }
 }
 
@@ -366,11 +392,228 @@ bool Engine_IsScanning(EngineHandle handle) {
         return pluginLoader->isScanning();
 
     } catch (const std::exception& e) {
-        std::cerr << "[PluginBridge] 检查扫描状态失败: " << e.what() << std::endl;
+        WSLOG_ERROR("PluginBridge", "检查扫描状态失败: " << e.what());
+        return false;
+    }
+}
+
+bool Engine_GetPluginScanCacheStats(EngineHandle handle, PluginScanCacheStats_C* stats) {
+    if (!handle || !stats) return false;
+
+    try {
+        auto context = getContext(handle);
+        if (!context->engine) return false;
+
+        auto engineContext = context->engine->getContext();
+        if (!engineContext) return false;
+
+        auto pluginLoader = engineContext->getPluginLoader();
+        if (!pluginLoader) return false;
+
+        auto cacheStats = pluginLoader->getScanCacheStatistics();
+        stats->numBundles = cacheStats.numBundles;
+        stats->numPlugins = cacheStats.numPlugins;
+        stats->lastScanUnchanged = cacheStats.lastScanUnchanged;
+        stats->lastScanRescanned = cacheStats.lastScanRescanned;
+        stats->lastScanRemoved = cacheStats.lastScanRemoved;
+        return true;
+
+    } catch (const std::exception& e) {
+        WSLOG_ERROR("PluginBridge", "获取扫描缓存统计失败: " << e.what());
+        return false;
+    }
+}
+
+void Engine_ClearPluginScanCache(EngineHandle handle) {
+    if (!handle) return;
+
+    try {
+        auto context = getContext(handle);
+        if (!context->engine) return;
+
+        auto engineContext = context->engine->getContext();
+        if (!engineContext) return;
+
+        auto pluginLoader = engineContext->getPluginLoader();
+        if (!pluginLoader) return;
+
+        pluginLoader->clearScanCache();
+
+    } catch (const std::exception& e) {
+        WSLOG_ERROR("PluginBridge", "清空扫描缓存失败: " << e.what());
+    }
+}
+
+void Engine_SetOutOfProcessPluginScanning(EngineHandle handle, bool enabled) {
+    if (!handle) return;
+
+    try {
+        auto context = getContext(handle);
+        if (!context->engine) return;
+
+        auto engineContext = context->engine->getContext();
+        if (!engineContext) return;
+
+        auto pluginLoader = engineContext->getPluginLoader();
+        if (!pluginLoader) return;
+
+        pluginLoader->setOutOfProcessScanningEnabled(enabled);
+
+    } catch (const std::exception& e) {
+        WSLOG_ERROR("PluginBridge", "设置多进程扫描失败: " << e.what());
+    }
+}
+
+void Engine_SetPluginScanWorkerPath(EngineHandle handle, const char* executablePath) {
+    if (!handle || !executablePath) return;
+
+    try {
+        auto context = getContext(handle);
+        if (!context->engine) return;
+
+        auto engineContext = context->engine->getContext();
+        if (!engineContext) return;
+
+        auto pluginLoader = engineContext->getPluginLoader();
+        if (!pluginLoader) return;
+
+        pluginLoader->setScanWorkerExecutable(juce::File(juce::String::fromUTF8(executablePath)));
+
+    } catch (const std::exception& e) {
+        WSLOG_ERROR("PluginBridge", "设置扫描辅助进程失败: " << e.what());
+    }
+}
+
+void Engine_SetPluginScanTimeout(EngineHandle handle, int timeoutMs) {
+    if (!handle) return;
+
+    try {
+        auto context = getContext(handle);
+        if (!context->engine) return;
+
+        auto engineContext = context->engine->getContext();
+        if (!engineContext) return;
+
+        auto pluginLoader = engineContext->getPluginLoader();
+        if (!pluginLoader) return;
+
+        pluginLoader->setPluginScanTimeout(timeoutMs);
+
+    } catch (const std::exception& e) {
+        WSLOG_ERROR("PluginBridge", "设置扫描超时失败: " << e.what());
+    }
+}
+
+void Engine_SetPluginPoolSize(EngineHandle handle, int maxIdleInstances) {
+    if (!handle) return;
+
+    try {
+        auto context = getContext(handle);
+        if (!context->engine) return;
+
+        auto engineContext = context->engine->getContext();
+        if (!engineContext) return;
+
+        auto pluginManager = engineContext->getPluginManager();
+        if (!pluginManager) return;
+
+        pluginManager->getInstancePool().setMaxIdleInstances(maxIdleInstances);
+
+    } catch (const std::exception& e) {
+        WSLOG_ERROR("PluginBridge", "设置实例池大小失败: " << e.what());
+    }
+}
+
+int Engine_SetPluginPrewarmList(EngineHandle handle, const char** identifiers, int count, int instancesPerPlugin) {
+    if (!handle || (count > 0 && !identifiers)) return 0;
+
+    try {
+        auto context = getContext(handle);
+        if (!context->engine) return 0;
+
+        auto engineContext = context->engine->getContext();
+        if (!engineContext) return 0;
+
+        auto pluginLoader = engineContext->getPluginLoader();
+        auto pluginManager = engineContext->getPluginManager();
+        auto graphProcessor = engineContext->getGraphProcessor();
+        if (!pluginLoader || !pluginManager || !graphProcessor) return 0;
+
+        juce::StringArray wanted;
+        for (int i = 0; i < count; ++i) {
+            if (identifiers[i]) {
+                wanted.add(juce::String::fromUTF8(identifiers[i]));
+            }
+        }
+
+        juce::Array<juce::PluginDescription> descriptions;
+        for (const auto& plugin : pluginLoader->getKnownPlugins()) {
+            if (wanted.contains(plugin.createIdentifierString())) {
+                descriptions.add(plugin);
+            }
+        }
+
+        const auto& config = graphProcessor->getConfig();
+        pluginManager->getInstancePool().setPrewarmList(descriptions, instancesPerPlugin,
+                                                        config.sampleRate, config.samplesPerBlock);
+        return descriptions.size();
+
+    } catch (const std::exception& e) {
+        WSLOG_ERROR("PluginBridge", "设置预热插件列表失败: " << e.what());
+        return 0;
+    }
+}
+
+bool Engine_GetPluginPoolStats(EngineHandle handle, PluginPoolStats_C* stats) {
+    if (!handle || !stats) return false;
+
+    try {
+        auto context = getContext(handle);
+        if (!context->engine) return false;
+
+        auto engineContext = context->engine->getContext();
+        if (!engineContext) return false;
+
+        auto pluginManager = engineContext->getPluginManager();
+        if (!pluginManager) return false;
+
+        auto poolStats = pluginManager->getInstancePool().getStatistics();
+        stats->idleInstances = poolStats.idleInstances;
+        stats->retiringInstances = poolStats.retiringInstances;
+        stats->pendingPrewarms = poolStats.pendingPrewarms;
+        stats->hits = poolStats.hits;
+        stats->misses = poolStats.misses;
+        stats->prewarmed = poolStats.prewarmed;
+        stats->recycled = poolStats.recycled;
+        stats->evictions = poolStats.evictions;
+        return true;
+
+    } catch (const std::exception& e) {
+        WSLOG_ERROR("PluginBridge", "获取实例池统计失败: " << e.what());
         return false;
     }
 }
 
+void Engine_ClearPluginPool(EngineHandle handle) {
+    if (!handle) return;
+
+    try {
+        auto context = getContext(handle);
+        if (!context->engine) return;
+
+        auto engineContext = context->engine->getContext();
+        if (!engineContext) return;
+
+        auto pluginManager = engineContext->getPluginManager();
+        if (!pluginManager) return;
+
+        pluginManager->getInstancePool().clear();
+
+    } catch (const std::exception& e) {
+        WSLOG_ERROR("PluginBridge", "清空实例池失败: " << e.what());
+    }
+}
+
 void Engine_LoadPluginByIdentifier(EngineHandle handle,
                                   const char* pluginIdentifier,
                                   PluginLoadCallback callback,
@@ -402,7 +645,7 @@ void Engine_LoadPluginByIdentifier(EngineHandle handle,
             });
 
     } catch (const std::exception& e) {
-        std::cerr << "[PluginBridge] 通过标识符加载插件失败: " << e.what() << std::endl;
+        WSLOG_ERROR("PluginBridge", "通过标识符加载插件失败: " << e.what());
         if (callback) {
             callback(0, false, e.what(), userData);
         }
@@ -435,7 +678,7 @@ bool Engine_NodeHasEditor(EngineHandle handle, uint32_t nodeID) {
         return instance && instance->hasEditor();
 
     } catch (const std::exception& e) {
-        std::cerr << "[PluginBridge] 检查节点编辑器失败: " << e.what() << std::endl;
+        WSLOG_ERROR("PluginBridge", "检查节点编辑器失败: " << e.what());
         return false;
     }
 }
@@ -461,7 +704,7 @@ bool Engine_ShowNodeEditor(EngineHandle handle, uint32_t nodeID) {
         return pluginManager->showEditor(graphNodeID);
 
     } catch (const std::exception& e) {
-        std::cerr << "[PluginBridge] 显示节点编辑器失败: " << e.what() << std::endl;
+        WSLOG_ERROR("PluginBridge", "显示节点编辑器失败: " << e.what());
         return false;
     }
 }
@@ -487,7 +730,7 @@ bool Engine_HideNodeEditor(EngineHandle handle, uint32_t nodeID) {
         return pluginManager->hideEditor(graphNodeID);
 
     } catch (const std::exception& e) {
-        std::cerr << "[PluginBridge] 隐藏节点编辑器失败: " << e.what() << std::endl;
+        WSLOG_ERROR("PluginBridge", "隐藏节点编辑器失败: " << e.what());
         return false;
     }
 }
@@ -513,7 +756,7 @@ bool Engine_IsNodeEditorVisible(EngineHandle handle, uint32_t nodeID) {
         return pluginManager->isEditorVisible(graphNodeID);
 
     } catch (const std::exception& e) {
-        std::cerr << "[PluginBridge] 检查节点编辑器可见性失败: " << e.what() << std::endl;
+        WSLOG_ERROR("PluginBridge", "检查节点编辑器可见性失败: " << e.what());
         return false;
     }
 }
@@ -539,7 +782,7 @@ bool Engine_MoveNode(EngineHandle handle, uint32_t nodeID, int newPosition) {
         return graphManager->moveNode(graphNodeID, newPosition);
 
     } catch (const std::exception& e) {
-        std::cerr << "[PluginBridge] 移动节点失败: " << e.what() << std::endl;
+        WSLOG_ERROR("PluginBridge", "移动节点失败: " << e.what());
         return false;
     }
 }
@@ -568,7 +811,7 @@ bool Engine_SwapNodes(EngineHandle handle, uint32_t nodeID1, uint32_t nodeID2) {
         return graphManager->reorganizeNodes(nodeIDs, "swap");
 
     } catch (const std::exception& e) {
-        std::cerr << "[PluginBridge] 交换节点失败: " << e.what() << std::endl;
+        WSLOG_ERROR("PluginBridge", "交换节点失败: " << e.what());
         return false;
     }
 }
@@ -601,11 +844,42 @@ int Engine_CreateProcessingChain(EngineHandle handle, const uint32_t* nodeIDs, i
         return graphManager->createProcessingChain(graphNodeIDs, true);
 
     } catch (const std::exception& e) {
-        std::cerr << "[PluginBridge] 创建处理链失败: " << e.what() << std::endl;
+        WSLOG_ERROR("PluginBridge", "创建处理链失败: " << e.what());
         return 0;
     }
 }
 
+uint32_t Engine_FreezeNodes(EngineHandle handle, const uint32_t* nodeIDs, int count, bool unloadPlugins) {
+    if (!handle || !nodeIDs || count <= 0) return 0;
+
+    try {
+        auto context = getContext(handle);
+        if (!context->engine) return 0;
+
+        WindsynthEngineFacade::FreezeOptions options;
+        options.unloadPlugins = unloadPlugins;
+
+        return context->engine->freezeNodes(std::vector<uint32_t>(nodeIDs, nodeIDs + count), options);
+    } catch (const std::exception& e) {
+        WSLOG_ERROR("PluginBridge", "冻结节点失败: " << e.what());
+        return 0;
+    }
+}
+
+bool Engine_UnfreezeNodes(EngineHandle handle, uint32_t playerNodeID) {
+    if (!handle) return false;
+
+    try {
+        auto context = getContext(handle);
+        if (!context->engine) return false;
+
+        return context->engine->unfreezeNodes(playerNodeID);
+    } catch (const std::exception& e) {
+        WSLOG_ERROR("PluginBridge", "解冻节点失败: " << e.what());
+        return false;
+    }
+}
+
 bool Engine_AutoConnectToIO(EngineHandle handle, uint32_t nodeID) {
     if (!handle) return false;
 
@@ -628,14 +902,191 @@ bool Engine_AutoConnectToIO(EngineHandle handle, uint32_t nodeID) {
         NodeID graphNodeID;
         graphNodeID.uid = nodeID;
 
-        // 自动连接到输入和输出
+        // 自动连接到输入和输出（作为一次拓扑切换提交）
+        WindsynthVST::AudioGraph::GraphAudioProcessor::ScopedTopologyChange topologyChange(*graphProcessor);
         int inputConnections = graphManager->autoConnectNodes(audioInputID, graphNodeID, true, false);
         int outputConnections = graphManager->autoConnectNodes(graphNodeID, audioOutputID, true, false);
 
         return (inputConnections + outputConnections) > 0;
 
     } catch (const std::exception& e) {
-        std::cerr << "[PluginBridge] 自动连接到IO失败: " << e.what() << std::endl;
+        WSLOG_ERROR("PluginBridge", "自动连接到IO失败: " << e.what());
         return false;
     }
 }
+
+//==============================================================================
+// 图拓扑切换实现
+//==============================================================================
+
+void Engine_SetGraphSwapFadeTime(EngineHandle handle, double milliseconds) {
+    if (!handle) return;
+
+    try {
+        auto context = getContext(handle);
+        if (!context->engine) return;
+
+        auto engineContext = context->engine->getContext();
+        if (!engineContext) return;
+
+        if (auto graphProcessor = engineContext->getGraphProcessor()) {
+            graphProcessor->setTopologyFadeMs(milliseconds);
+        }
+    } catch (const std::exception& e) {
+        WSLOG_ERROR("PluginBridge", "设置拓扑切换淡入淡出时间失败: " << e.what());
+    }
+}
+
+void Engine_SetParallelProcessing(EngineHandle handle, bool enabled, int numWorkers) {
+    if (!handle) return;
+
+    try {
+        auto context = getContext(handle);
+        if (!context->engine) return;
+
+        auto engineContext = context->engine->getContext();
+        if (!engineContext) return;
+
+        if (auto graphProcessor = engineContext->getGraphProcessor()) {
+            graphProcessor->setParallelProcessingEnabled(enabled, numWorkers);
+        }
+    } catch (const std::exception& e) {
+        WSLOG_ERROR("PluginBridge", "设置并行处理失败: " << e.what());
+    }
+}
+
+bool Engine_GetParallelProcessingStats(EngineHandle handle, ParallelProcessingStats_C* stats) {
+    if (!handle || !stats) return false;
+
+    try {
+        auto context = getContext(handle);
+        if (!context->engine) return false;
+
+        auto engineContext = context->engine->getContext();
+        if (!engineContext) return false;
+
+        auto graphProcessor = engineContext->getGraphProcessor();
+        if (!graphProcessor) return false;
+
+        auto parallelStats = graphProcessor->getParallelProcessingStats();
+        stats->enabled = parallelStats.enabled;
+        stats->planIsParallel = parallelStats.planIsParallel;
+        stats->numWorkers = parallelStats.numWorkers;
+        stats->numNodes = parallelStats.numNodes;
+        stats->maxParallelWidth = parallelStats.maxParallelWidth;
+        stats->parallelBlocks = parallelStats.parallelBlocks;
+        stats->serialBlocks = parallelStats.serialBlocks;
+        stats->stolenTasks = parallelStats.stolenTasks;
+        return true;
+
+    } catch (const std::exception& e) {
+        WSLOG_ERROR("PluginBridge", "获取并行处理统计失败: " << e.what());
+        return false;
+    }
+}
+
+bool Engine_GetLatencyInfo(EngineHandle handle, GraphLatencyInfo_C* info) {
+    if (!handle || !info) return false;
+
+    try {
+        auto context = getContext(handle);
+        if (!context->engine) return false;
+
+        auto engineContext = context->engine->getContext();
+        if (!engineContext) return false;
+
+        auto graphProcessor = engineContext->getGraphProcessor();
+        if (!graphProcessor) return false;
+
+        auto report = graphProcessor->getLatencyReport();
+        info->graphLatencySamples = report.graphLatencySamples;
+        info->compensationSamples = report.compensationSamples;
+        info->inputDeviceLatencySamples = report.inputDeviceLatencySamples;
+        info->outputDeviceLatencySamples = report.outputDeviceLatencySamples;
+        info->roundTripLatencySamples = report.roundTripLatencySamples;
+        info->sampleRate = report.sampleRate;
+        return true;
+
+    } catch (const std::exception& e) {
+        WSLOG_ERROR("PluginBridge", "获取延迟信息失败: " << e.what());
+        return false;
+    }
+}
+
+//==============================================================================
+// 节点耗时统计实现
+//==============================================================================
+
+void Engine_SetNodeProfilingEnabled(EngineHandle handle, bool enabled) {
+    if (!handle) return;
+
+    try {
+        auto context = getContext(handle);
+        if (!context->engine) return;
+
+        auto engineContext = context->engine->getContext();
+        if (!engineContext) return;
+
+        if (auto graphProcessor = engineContext->getGraphProcessor()) {
+            graphProcessor->setNodeProfilingEnabled(enabled);
+        }
+    } catch (const std::exception& e) {
+        WSLOG_ERROR("PluginBridge", "设置节点耗时统计失败: " << e.what());
+    }
+}
+
+int Engine_GetNodeProfiles(EngineHandle handle, NodeProfile_C* profiles, int maxCount) {
+    if (!handle || !profiles || maxCount <= 0) return 0;
+
+    try {
+        auto context = getContext(handle);
+        if (!context->engine) return 0;
+
+        auto engineContext = context->engine->getContext();
+        if (!engineContext) return 0;
+
+        auto graphProcessor = engineContext->getGraphProcessor();
+        if (!graphProcessor) return 0;
+
+        const auto cppProfiles = graphProcessor->getNodeProfiles();
+        int count = std::min(static_cast<int>(cppProfiles.size()), maxCount);
+
+        for (int i = 0; i < count; ++i) {
+            const auto& cppProfile = cppProfiles[static_cast<size_t>(i)];
+            auto& cProfile = profiles[i];
+
+            cProfile.nodeID = cppProfile.nodeID.uid;
+            strncpy(cProfile.name, cppProfile.name.c_str(), sizeof(cProfile.name) - 1);
+            cProfile.name[sizeof(cProfile.name) - 1] = '\0';
+            cProfile.averageTimeMs = cppProfile.averageTimeMs;
+            cProfile.peakTimeMs = cppProfile.peakTimeMs;
+            cProfile.lastTimeMs = cppProfile.lastTimeMs;
+            cProfile.budgetPercent = cppProfile.budgetPercent;
+            cProfile.peakBudgetPercent = cppProfile.peakBudgetPercent;
+            cProfile.blocks = cppProfile.blocks;
+        }
+
+        return count;
+    } catch (const std::exception& e) {
+        WSLOG_ERROR("PluginBridge", "获取节点耗时统计失败: " << e.what());
+        return 0;
+    }
+}
+
+void Engine_ResetNodeProfiles(EngineHandle handle) {
+    if (!handle) return;
+
+    try {
+        auto context = getContext(handle);
+        if (!context->engine) return;
+
+        auto engineContext = context->engine->getContext();
+        if (!engineContext) return;
+
+        if (auto graphProcessor = engineContext->getGraphProcessor()) {
+            graphProcessor->resetNodeProfiles();
+        }
+    } catch (const std::exception& e) {
+        WSLOG_ERROR("PluginBridge", "重置节点耗时统计失败: " << e.what());
+    }
+}
@@ -0,0 +1,304 @@
+//
+//  AudioClipCache.cpp
+//  WindsynthRecorder
+//
+//  Created by AI Assistant
+//  共享的已解码音频缓存实现
+//
+
+#include "AudioClipCache.hpp"
+#include "AudioGraph/Core/Logger.hpp"
+#include <algorithm>
+#include <limits>
+#include <new>
+
+namespace WindsynthVST::Engine::Core {
+
+//==============================================================================
+// 缓存数据读取器
+//==============================================================================
+
+/**
+ * 从已解码的缓存数据读取，持有数据引用直到读取器销毁
+ */
+class AudioClipCache::CachedClipReader : public juce::AudioFormatReader {
+public:
+    explicit CachedClipReader(std::shared_ptr<const DecodedClip> clipToRead)
+        : AudioFormatReader(nullptr, clipToRead->formatName),
+          clip(std::move(clipToRead))
+    {
+        sampleRate = clip->sampleRate;
+        bitsPerSample = clip->bitsPerSample;
+        lengthInSamples = clip->samples.getNumSamples();
+        numChannels = static_cast<unsigned int>(clip->samples.getNumChannels());
+        usesFloatingPointData = true;
+        metadataValues = clip->metadata;
+    }
+
+    bool readSamples(int* const* destChannels, int numDestChannels, int startOffsetInDestBuffer,
+                     juce::int64 startSampleInFile, int numSamples) override {
+        clearSamplesBeyondAvailableLength(destChannels, numDestChannels, startOffsetInDestBuffer,
+                                          startSampleInFile, numSamples, lengthInSamples);
+        if (numSamples <= 0) {
+            return true;
+        }
+
+        for (int channel = 0; channel < numDestChannels; ++channel) {
+            auto* dest = reinterpret_cast<float*>(destChannels[channel]);
+            if (dest == nullptr) {
+                continue;
+            }
+
+            if (channel < static_cast<int>(numChannels)) {
+                juce::FloatVectorOperations::copy(dest + startOffsetInDestBuffer,
+                                                  clip->samples.getReadPointer(channel, static_cast<int>(startSampleInFile)),
+                                                  numSamples);
+            } else {
+                juce::FloatVectorOperations::clear(dest + startOffsetInDestBuffer, numSamples);
+            }
+        }
+        return true;
+    }
+
+private:
+    std::shared_ptr<const DecodedClip> clip;
+};
+
+//==============================================================================
+// 构造函数和析构函数
+//==============================================================================
+
+AudioClipCache::AudioClipCache(std::shared_ptr<juce::AudioFormatManager> formatManager,
+                               size_t memoryBudgetBytes)
+    : formatManager(std::move(formatManager)),
+      memoryBudget(memoryBudgetBytes)
+{
+}
+
+AudioClipCache::~AudioClipCache() = default;
+
+//==============================================================================
+// 读取器创建
+//==============================================================================
+
+std::unique_ptr<juce::AudioFormatReader> AudioClipCache::createReader(const juce::File& file,
+                                                                      ReaderSource* source) {
+    if (!formatManager || !file.existsAsFile()) {
+        return nullptr;
+    }
+
+    // 未压缩格式直接内存映射（只有WAV/AIFF等支持映射的格式会返回映射读取器）
+    if (auto* format = formatManager->findFormatForFileExtension(file.getFileExtension())) {
+        std::unique_ptr<juce::MemoryMappedAudioFormatReader> mappedReader(format->createMemoryMappedReader(file));
+        if (mappedReader && mappedReader->mapEntireFile()) {
+            {
+                std::lock_guard<std::mutex> lock(cacheMutex);
+                stats.mappedOpens++;
+            }
+            if (source != nullptr) {
+                *source = ReaderSource::MemoryMapped;
+            }
+            return mappedReader;
+        }
+    }
+
+    const auto key = file.getFullPathName().toStdString();
+    const auto modificationTime = file.getLastModificationTime().toMilliseconds();
+    const auto fileSize = file.getSize();
+
+    std::promise<std::shared_ptr<const DecodedClip>> decodePromise;
+    std::shared_future<std::shared_ptr<const DecodedClip>> pendingResult;
+    uint64_t decodeID = 0;
+    size_t budget = 0;
+    {
+        std::lock_guard<std::mutex> lock(cacheMutex);
+
+        if (auto clip = findClip(key, modificationTime, fileSize)) {
+            if (source != nullptr) {
+                *source = ReaderSource::Cached;
+            }
+            return std::make_unique<CachedClipReader>(std::move(clip));
+        }
+
+        // 同一版本的文件正在被其他线程解码时等待它的结果，否则由本线程解码
+        auto pending = pendingDecodes.find(key);
+        if (pending != pendingDecodes.end() && pending->second.modificationTime == modificationTime
+            && pending->second.fileSize == fileSize) {
+            pendingResult = pending->second.result;
+        } else {
+            decodeID = nextDecodeID++;
+            pendingDecodes[key] = PendingDecode{decodeID, modificationTime, fileSize, decodePromise.get_future().share()};
+            budget = memoryBudget;
+        }
+    }
+
+    if (decodeID == 0) {
+        if (auto clip = pendingResult.get()) {
+            if (source != nullptr) {
+                *source = ReaderSource::Cached;
+            }
+            return std::make_unique<CachedClipReader>(std::move(clip));
+        }
+
+        // 第一个请求没有缓存该文件（文件过大或解码失败），各自使用普通读取器
+        if (source != nullptr) {
+            *source = ReaderSource::Streamed;
+        }
+        return std::unique_ptr<juce::AudioFormatReader>(formatManager->createReaderFor(file));
+    }
+
+    std::unique_ptr<juce::AudioFormatReader> reader(formatManager->createReaderFor(file));
+    std::shared_ptr<const DecodedClip> clip;
+
+    // 解码后超过预算一半的文件不缓存，避免一个文件挤掉所有条目
+    if (reader && reader->lengthInSamples > 0 && reader->lengthInSamples <= std::numeric_limits<int>::max()) {
+        const auto decodedBytes = static_cast<size_t>(reader->numChannels) * static_cast<size_t>(reader->lengthInSamples)
+                                  * sizeof(float);
+        if (decodedBytes <= budget / 2) {
+            try {
+                clip = decode(*reader, modificationTime, fileSize);
+            } catch (const std::bad_alloc&) {
+                WSLOG_WARNING("AudioClipCache", "内存不足，不缓存: " << file.getFileName());
+            }
+        }
+    }
+
+    // 无论是否缓存都要结束等待，否则后来的调用会一直阻塞
+    {
+        std::lock_guard<std::mutex> lock(cacheMutex);
+        if (clip) {
+            insertClip(key, clip);
+        }
+        auto pending = pendingDecodes.find(key);
+        if (pending != pendingDecodes.end() && pending->second.decodeID == decodeID) {
+            pendingDecodes.erase(pending);
+        }
+    }
+    decodePromise.set_value(clip);
+
+    if (!clip) {
+        if (source != nullptr) {
+            *source = ReaderSource::Streamed;
+        }
+        return reader;
+    }
+
+    if (source != nullptr) {
+        *source = ReaderSource::Cached;
+    }
+    return std::make_unique<CachedClipReader>(std::move(clip));
+}
+
+std::shared_ptr<const AudioClipCache::DecodedClip> AudioClipCache::decode(juce::AudioFormatReader& reader,
+                                                                          juce::int64 modificationTime,
+                                                                          juce::int64 fileSize) {
+    auto clip = std::make_shared<DecodedClip>();
+
+    const int length = static_cast<int>(reader.lengthInSamples);
+    const int channels = static_cast<int>(reader.numChannels);
+
+    clip->samples.setSize(channels, length);
+    if (!reader.read(&clip->samples, 0, length, 0, true, true)) {
+        WSLOG_ERROR("AudioClipCache", "解码失败: " << reader.getFormatName());
+        return nullptr;
+    }
+
+    clip->sampleRate = reader.sampleRate;
+    clip->bitsPerSample = reader.bitsPerSample;
+    clip->formatName = reader.getFormatName();
+    clip->metadata = reader.metadataValues;
+    clip->modificationTime = modificationTime;
+    clip->fileSize = fileSize;
+    return clip;
+}
+
+//==============================================================================
+// 缓存管理
+//==============================================================================
+
+std::shared_ptr<const AudioClipCache::DecodedClip> AudioClipCache::findClip(const std::string& key,
+                                                                            juce::int64 modificationTime,
+                                                                            juce::int64 fileSize) {
+    auto it = entries.find(key);
+    if (it == entries.end()) {
+        stats.misses++;
+        return nullptr;
+    }
+
+    // 文件已被修改，旧数据失效
+    if (it->second.clip->modificationTime != modificationTime || it->second.clip->fileSize != fileSize) {
+        removeEntry(it);
+        stats.misses++;
+        return nullptr;
+    }
+
+    lruOrder.splice(lruOrder.begin(), lruOrder, it->second.lruPosition);
+    stats.hits++;
+    return it->second.clip;
+}
+
+void AudioClipCache::insertClip(const std::string& key, std::shared_ptr<const DecodedClip> clip) {
+    // 文件在解码期间被修改时，新版本的解码可能先完成，保留后插入的数据
+    auto existing = entries.find(key);
+    if (existing != entries.end()) {
+        removeEntry(existing);
+    }
+
+    lruOrder.push_front(key);
+    memoryUsed += clip->getSizeInBytes();
+    entries[key] = Entry{std::move(clip), lruOrder.begin()};
+
+    evictToBudget();
+}
+
+void AudioClipCache::removeEntry(std::unordered_map<std::string, Entry>::iterator it) {
+    memoryUsed -= it->second.clip->getSizeInBytes();
+    lruOrder.erase(it->second.lruPosition);
+    entries.erase(it);
+}
+
+void AudioClipCache::evictToBudget() {
+    while (memoryUsed > memoryBudget && !lruOrder.empty()) {
+        auto it = entries.find(lruOrder.back());
+        if (it == entries.end()) {
+            lruOrder.pop_back();
+            continue;
+        }
+        removeEntry(it);
+        stats.evictions++;
+    }
+}
+
+void AudioClipCache::setMemoryBudget(size_t bytes) {
+    std::lock_guard<std::mutex> lock(cacheMutex);
+    memoryBudget = bytes;
+    evictToBudget();
+}
+
+void AudioClipCache::invalidate(const juce::File& file) {
+    std::lock_guard<std::mutex> lock(cacheMutex);
+
+    auto it = entries.find(file.getFullPathName().toStdString());
+    if (it != entries.end()) {
+        removeEntry(it);
+    }
+}
+
+void AudioClipCache::clear() {
+    std::lock_guard<std::mutex> lock(cacheMutex);
+    entries.clear();
+    lruOrder.clear();
+    memoryUsed = 0;
+}
+
+AudioClipCache::Statistics AudioClipCache::getStatistics() const {
+    std::lock_guard<std::mutex> lock(cacheMutex);
+
+    Statistics result = stats;
+    result.memoryUsedBytes = memoryUsed;
+    result.memoryBudgetBytes = memoryBudget;
+    result.numEntries = static_cast<int>(entries.size());
+    return result;
+}
+
+} // namespace WindsynthVST::Engine::Core
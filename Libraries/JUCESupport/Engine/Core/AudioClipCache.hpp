@@ -0,0 +1,159 @@
+//
+//  AudioClipCache.hpp
+//  WindsynthRecorder
+//
+//  Created by AI Assistant
+//  共享的已解码音频缓存（播放和离线渲染共用）
+//
+
+#pragma once
+
+#include <JuceHeader.h>
+#include <memory>
+#include <string>
+#include <list>
+#include <unordered_map>
+#include <mutex>
+#include <future>
+#include <cstdint>
+
+namespace WindsynthVST::Engine::Core {
+
+/**
+ * 音频片段缓存
+ *
+ * 同一个源文件会被反复播放和渲染，为避免每次重新打开和解码：
+ * - 未压缩格式（WAV/AIFF）直接内存映射，由系统页缓存负责复用
+ * - 压缩格式（FLAC/MP3等）完整解码为32位浮点后放入LRU缓存，受内存预算限制
+ *
+ * 缓存以路径和修改时间为键，文件被修改后自动失效。
+ * 多个线程同时请求同一个未缓存的文件时只解码一次，后来的调用等待第一个解码完成。
+ * 返回的读取器持有缓存数据的引用，条目被淘汰时正在使用的读取器不受影响。
+ * 所有方法都是线程安全的，但可能执行磁盘读取和解码，不能在音频线程中调用。
+ */
+class AudioClipCache {
+public:
+    /**
+     * 读取器的数据来源
+     */
+    enum class ReaderSource {
+        MemoryMapped,   // 内存映射的未压缩文件
+        Cached,         // 缓存中已解码的数据
+        Streamed        // 普通读取器（文件过大或不支持缓存）
+    };
+
+    /**
+     * 缓存统计
+     */
+    struct Statistics {
+        uint64_t hits = 0;
+        uint64_t misses = 0;
+        uint64_t mappedOpens = 0;
+        uint64_t evictions = 0;
+        size_t memoryUsedBytes = 0;
+        size_t memoryBudgetBytes = 0;
+        int numEntries = 0;
+    };
+
+    static constexpr size_t defaultMemoryBudgetBytes = 512 * 1024 * 1024;
+
+    /**
+     * 构造函数
+     * @param formatManager 音频格式管理器
+     * @param memoryBudgetBytes 已解码数据的内存预算
+     */
+    explicit AudioClipCache(std::shared_ptr<juce::AudioFormatManager> formatManager,
+                            size_t memoryBudgetBytes = defaultMemoryBudgetBytes);
+    ~AudioClipCache();
+
+    /**
+     * 为文件创建读取器（优先使用内存映射或缓存数据）
+     * @param file 音频文件
+     * @param source 可选，返回读取器的数据来源
+     * @return 无法读取时返回nullptr
+     */
+    std::unique_ptr<juce::AudioFormatReader> createReader(const juce::File& file,
+                                                          ReaderSource* source = nullptr);
+
+    /**
+     * 设置内存预算（超出时立即淘汰最久未使用的条目）
+     */
+    void setMemoryBudget(size_t bytes);
+
+    /**
+     * 移除指定文件的缓存
+     */
+    void invalidate(const juce::File& file);
+
+    /**
+     * 清空缓存
+     */
+    void clear();
+
+    /**
+     * 获取缓存统计
+     */
+    Statistics getStatistics() const;
+
+private:
+    /**
+     * 已解码的音频数据（只读，由缓存和读取器共享）
+     */
+    struct DecodedClip {
+        juce::AudioBuffer<float> samples;
+        double sampleRate = 0.0;
+        unsigned int bitsPerSample = 0;
+        juce::String formatName;
+        juce::StringPairArray metadata;
+        juce::int64 modificationTime = 0;
+        juce::int64 fileSize = 0;
+
+        size_t getSizeInBytes() const {
+            return static_cast<size_t>(samples.getNumChannels()) * static_cast<size_t>(samples.getNumSamples())
+                   * sizeof(float);
+        }
+    };
+
+    class CachedClipReader;
+
+    struct Entry {
+        std::shared_ptr<const DecodedClip> clip;
+        std::list<std::string>::iterator lruPosition;
+    };
+
+    /**
+     * 正在解码的文件（结果为空表示文件不缓存或解码失败）
+     */
+    struct PendingDecode {
+        uint64_t decodeID = 0;
+        juce::int64 modificationTime = 0;
+        juce::int64 fileSize = 0;
+        std::shared_future<std::shared_ptr<const DecodedClip>> result;
+    };
+
+    std::shared_ptr<juce::AudioFormatManager> formatManager;
+
+    mutable std::mutex cacheMutex;
+    std::unordered_map<std::string, Entry> entries;
+    std::list<std::string> lruOrder;            // 最近使用的在前
+    std::unordered_map<std::string, PendingDecode> pendingDecodes;
+    uint64_t nextDecodeID = 1;
+    size_t memoryBudget;
+    size_t memoryUsed = 0;
+    Statistics stats;
+
+    // 以下方法要求调用方持有 cacheMutex
+    std::shared_ptr<const DecodedClip> findClip(const std::string& key, juce::int64 modificationTime,
+                                                juce::int64 fileSize);
+    void insertClip(const std::string& key, std::shared_ptr<const DecodedClip> clip);
+    void removeEntry(std::unordered_map<std::string, Entry>::iterator it);
+    void evictToBudget();
+
+    static std::shared_ptr<const DecodedClip> decode(juce::AudioFormatReader& reader,
+                                                     juce::int64 modificationTime,
+                                                     juce::int64 fileSize);
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(AudioClipCache)
+};
+
+} // namespace WindsynthVST::Engine::Core
@@ -7,7 +7,7 @@
 //
 
 #include "EngineContext.hpp"
-#include <iostream>
+#include "AudioGraph/Core/Logger.hpp"
 
 namespace WindsynthVST::Engine::Core {
 
@@ -16,11 +16,11 @@ namespace WindsynthVST::Engine::Core {
 //==============================================================================
 
 EngineContext::EngineContext() {
-    std::cout << "[EngineContext] 构造函数" << std::endl;
+    WSLOG_INFO("EngineContext", "构造函数");
 }
 
 EngineContext::~EngineContext() {
-    std::cout << "[EngineContext] 析构函数" << std::endl;
+    WSLOG_INFO("EngineContext", "析构函数");
     shutdown();
 }
 
@@ -29,32 +29,41 @@ EngineContext::~EngineContext() {
 //==============================================================================
 
 bool EngineContext::initialize() {
-    std::cout << "[EngineContext] 初始化共享上下文" << std::endl;
+    WSLOG_INFO("EngineContext", "初始化共享上下文");
     
     if (initialized.load()) {
-        std::cout << "[EngineContext] 上下文已经初始化" << std::endl;
+        WSLOG_INFO("EngineContext", "上下文已经初始化");
         return true;
     }
     
     try {
-        // 创建核心组件
+        // 创建核心组件（分发器最先创建、最后销毁，电平和性能回调不在音频线程中执行）
+        notificationDispatcher = std::make_shared<AudioGraph::NotificationDispatcher>();
         graphProcessor = std::make_shared<AudioGraph::GraphAudioProcessor>();
-        pluginLoader = std::make_shared<AudioGraph::ModernPluginLoader>();
+        graphProcessor->setNotificationDispatcher(notificationDispatcher.get());
+        // 插件目录和扫描由进程内所有引擎共享
+        pluginLoader = AudioGraph::ModernPluginLoader::getSharedInstance();
         pluginManager = std::make_shared<AudioGraph::PluginManager>(*graphProcessor, *pluginLoader);
         graphManager = std::make_shared<AudioGraph::GraphManager>(*graphProcessor);
         ioManager = std::make_shared<AudioGraph::AudioIOManager>(*graphProcessor);
+        ioManager->setNotificationDispatcher(notificationDispatcher.get());
+        ioManager->enableLevelMonitoring(true);
         presetManager = std::make_shared<AudioGraph::PresetManager>(*graphProcessor, *pluginManager);
+        diskRecorder = std::make_shared<AudioGraph::DiskRecorder>();
+        graphProcessor->addCaptureSink(diskRecorder.get());
         
         // 创建音频格式管理器
         formatManager = std::make_shared<juce::AudioFormatManager>();
         formatManager->registerBasicFormats();
+        clipCache = std::make_shared<AudioClipCache>(formatManager);
+        peakCache = std::make_shared<WaveformPeakCache>(clipCache, WaveformPeakCache::getDefaultCacheDirectory());
         
         initialized.store(true);
-        std::cout << "[EngineContext] 共享上下文初始化完成" << std::endl;
+        WSLOG_INFO("EngineContext", "共享上下文初始化完成");
         return true;
         
     } catch (const std::exception& e) {
-        std::cerr << "[EngineContext] 初始化失败: " << e.what() << std::endl;
+        WSLOG_ERROR("EngineContext", "初始化失败: " << e.what());
         return false;
     }
 }
@@ -64,23 +73,42 @@ void EngineContext::shutdown() {
         return;
     }
     
-    std::cout << "[EngineContext] 关闭共享上下文" << std::endl;
+    WSLOG_INFO("EngineContext", "关闭共享上下文");
     
     try {
         // 按依赖顺序清理组件
+        if (diskRecorder) {
+            diskRecorder->stopRecording();
+        }
         presetManager.reset();
+        if (ioManager) {
+            ioManager->setNotificationDispatcher(nullptr);
+        }
         ioManager.reset();
+        if (graphProcessor) {
+            graphProcessor->removeCaptureSink(diskRecorder.get());
+        }
+        diskRecorder.reset();
         graphManager.reset();
         pluginManager.reset();
         pluginLoader.reset();
+        if (graphProcessor) {
+            graphProcessor->setNotificationDispatcher(nullptr);
+        }
         graphProcessor.reset();
+        notificationDispatcher.reset();
+        peakCache.reset();
+        clipCache.reset();
         formatManager.reset();
         
         initialized.store(false);
-        std::cout << "[EngineContext] 共享上下文已关闭" << std::endl;
+        WSLOG_INFO("EngineContext", "共享上下文已关闭");
+        
+        // 确保关闭过程中的日志在进程退出前输出
+        AudioGraph::Logger::getInstance().flush();
         
     } catch (const std::exception& e) {
-        std::cerr << "[EngineContext] 关闭时出错: " << e.what() << std::endl;
+        WSLOG_ERROR("EngineContext", "关闭时出错: " << e.what());
     }
 }
 
@@ -20,6 +20,10 @@
 #include "AudioGraph/Plugins/ModernPluginLoader.hpp"
 #include "AudioGraph/Management/AudioIOManager.hpp"
 #include "AudioGraph/Management/PresetManager.hpp"
+#include "AudioGraph/Recording/DiskRecorder.hpp"
+#include "AudioGraph/Core/NotificationDispatcher.hpp"
+#include "AudioClipCache.hpp"
+#include "WaveformPeakCache.hpp"
 
 namespace WindsynthVST::Engine::Core {
 
@@ -92,6 +96,17 @@ public:
         return presetManager;
     }
     
+    std::shared_ptr<AudioGraph::DiskRecorder> getDiskRecorder() const {
+        return diskRecorder;
+    }
+
+    /**
+     * 通知分发器（电平、性能等音频线程事件在其分发线程中回调）
+     */
+    std::shared_ptr<AudioGraph::NotificationDispatcher> getNotificationDispatcher() const {
+        return notificationDispatcher;
+    }
+    
     //==============================================================================
     // 状态管理
     //==============================================================================
@@ -130,6 +145,14 @@ public:
         return formatManager;
     }
     
+    std::shared_ptr<AudioClipCache> getClipCache() const {
+        return clipCache;
+    }
+    
+    std::shared_ptr<WaveformPeakCache> getPeakCache() const {
+        return peakCache;
+    }
+    
     //==============================================================================
     // 初始化和清理
     //==============================================================================
@@ -149,12 +172,16 @@ private:
     std::shared_ptr<AudioGraph::ModernPluginLoader> pluginLoader;
     std::shared_ptr<AudioGraph::AudioIOManager> ioManager;
     std::shared_ptr<AudioGraph::PresetManager> presetManager;
+    std::shared_ptr<AudioGraph::DiskRecorder> diskRecorder;
+    std::shared_ptr<AudioGraph::NotificationDispatcher> notificationDispatcher;
     
     //==============================================================================
     // 音频格式管理
     //==============================================================================
     
     std::shared_ptr<juce::AudioFormatManager> formatManager;
+    std::shared_ptr<AudioClipCache> clipCache;     // 播放和离线渲染共享的已解码音频缓存
+    std::shared_ptr<WaveformPeakCache> peakCache;  // 加载文件的波形峰值（生成时通过片段缓存读取）
     
     //==============================================================================
     // 状态管理
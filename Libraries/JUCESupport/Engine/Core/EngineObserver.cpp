@@ -7,8 +7,8 @@
 //
 
 #include "EngineObserver.hpp"
+#include "AudioGraph/Core/Logger.hpp"
 #include <algorithm>
-#include <iostream>
 
 namespace WindsynthVST::Engine::Core {
 
@@ -17,35 +17,39 @@ namespace WindsynthVST::Engine::Core {
 //==============================================================================
 
 void EngineNotifier::addStateObserver(std::shared_ptr<IEngineStateObserver> observer) {
-    std::lock_guard<std::mutex> lock(observerMutex);
-    stateObservers.push_back(observer);
+    updateObservers([&observer](ObserverList& list) {
+        list.stateObservers.push_back(observer);
+    });
 }
 
 void EngineNotifier::removeStateObserver(std::shared_ptr<IEngineStateObserver> observer) {
-    std::lock_guard<std::mutex> lock(observerMutex);
-    stateObservers.erase(
-        std::remove_if(stateObservers.begin(), stateObservers.end(),
-            [&observer](const std::weak_ptr<IEngineStateObserver>& weak) {
-                return weak.expired() || weak.lock() == observer;
-            }),
-        stateObservers.end()
-    );
+    updateObservers([&observer](ObserverList& list) {
+        list.stateObservers.erase(
+            std::remove_if(list.stateObservers.begin(), list.stateObservers.end(),
+                [&observer](const std::weak_ptr<IEngineStateObserver>& weak) {
+                    return weak.lock() == observer;
+                }),
+            list.stateObservers.end()
+        );
+    });
 }
 
 void EngineNotifier::addErrorObserver(std::shared_ptr<IEngineErrorObserver> observer) {
-    std::lock_guard<std::mutex> lock(observerMutex);
-    errorObservers.push_back(observer);
+    updateObservers([&observer](ObserverList& list) {
+        list.errorObservers.push_back(observer);
+    });
 }
 
 void EngineNotifier::removeErrorObserver(std::shared_ptr<IEngineErrorObserver> observer) {
-    std::lock_guard<std::mutex> lock(observerMutex);
-    errorObservers.erase(
-        std::remove_if(errorObservers.begin(), errorObservers.end(),
-            [&observer](const std::weak_ptr<IEngineErrorObserver>& weak) {
-                return weak.expired() || weak.lock() == observer;
-            }),
-        errorObservers.end()
-    );
+    updateObservers([&observer](ObserverList& list) {
+        list.errorObservers.erase(
+            std::remove_if(list.errorObservers.begin(), list.errorObservers.end(),
+                [&observer](const std::weak_ptr<IEngineErrorObserver>& weak) {
+                    return weak.lock() == observer;
+                }),
+            list.errorObservers.end()
+        );
+    });
 }
 
 //==============================================================================
@@ -53,59 +57,49 @@ void EngineNotifier::removeErrorObserver(std::shared_ptr<IEngineErrorObserver> o
 //==============================================================================
 
 void EngineNotifier::notifyStateChanged(EngineState oldState, EngineState newState, const std::string& message) {
-    std::lock_guard<std::mutex> lock(observerMutex);
+    const auto list = getObservers();
     
-    // 通知所有状态观察者
-    for (auto it = stateObservers.begin(); it != stateObservers.end();) {
-        if (auto observer = it->lock()) {
+    // 通知所有状态观察者（过期的观察者在下次修改列表时清理）
+    for (const auto& weak : list->stateObservers) {
+        if (auto observer = weak.lock()) {
             try {
                 observer->onStateChanged(oldState, newState, message);
-                ++it;
             } catch (const std::exception& e) {
-                std::cerr << "[EngineNotifier] 状态观察者异常: " << e.what() << std::endl;
-                ++it;
+                WSLOG_ERROR("EngineNotifier", "状态观察者异常: " << e.what());
             }
-        } else {
-            // 移除过期的观察者
-            it = stateObservers.erase(it);
         }
     }
     
     // 向后兼容的回调
-    if (stateCallback) {
+    if (list->stateCallback) {
         try {
-            stateCallback(newState, message);
+            list->stateCallback(newState, message);
         } catch (const std::exception& e) {
-            std::cerr << "[EngineNotifier] 状态回调异常: " << e.what() << std::endl;
+            WSLOG_ERROR("EngineNotifier", "状态回调异常: " << e.what());
         }
     }
 }
 
 void EngineNotifier::notifyError(const std::string& error, int severity) {
-    std::lock_guard<std::mutex> lock(observerMutex);
+    const auto list = getObservers();
     
     // 通知所有错误观察者
-    for (auto it = errorObservers.begin(); it != errorObservers.end();) {
-        if (auto observer = it->lock()) {
+    for (const auto& weak : list->errorObservers) {
+        if (auto observer = weak.lock()) {
             try {
                 observer->onError(error, severity);
-                ++it;
             } catch (const std::exception& e) {
-                std::cerr << "[EngineNotifier] 错误观察者异常: " << e.what() << std::endl;
-                ++it;
+                WSLOG_ERROR("EngineNotifier", "错误观察者异常: " << e.what());
             }
-        } else {
-            // 移除过期的观察者
-            it = errorObservers.erase(it);
         }
     }
     
     // 向后兼容的回调
-    if (errorCallback) {
+    if (list->errorCallback) {
         try {
-            errorCallback(error);
+            list->errorCallback(error);
         } catch (const std::exception& e) {
-            std::cerr << "[EngineNotifier] 错误回调异常: " << e.what() << std::endl;
+            WSLOG_ERROR("EngineNotifier", "错误回调异常: " << e.what());
         }
     }
 }
@@ -115,39 +109,49 @@ void EngineNotifier::notifyError(const std::string& error, int severity) {
 //==============================================================================
 
 void EngineNotifier::setStateCallback(StateCallback callback) {
-    std::lock_guard<std::mutex> lock(observerMutex);
-    stateCallback = std::move(callback);
+    updateObservers([&callback](ObserverList& list) {
+        list.stateCallback = std::move(callback);
+    });
 }
 
 void EngineNotifier::setErrorCallback(ErrorCallback callback) {
-    std::lock_guard<std::mutex> lock(observerMutex);
-    errorCallback = std::move(callback);
+    updateObservers([&callback](ObserverList& list) {
+        list.errorCallback = std::move(callback);
+    });
 }
 
 //==============================================================================
 // 内部方法
 //==============================================================================
 
-void EngineNotifier::cleanupExpiredObservers() {
+template <typename Modifier>
+void EngineNotifier::updateObservers(Modifier&& modifier) {
     std::lock_guard<std::mutex> lock(observerMutex);
     
-    // 清理过期的状态观察者
-    stateObservers.erase(
-        std::remove_if(stateObservers.begin(), stateObservers.end(),
+    auto list = std::make_shared<ObserverList>(*getObservers());
+    
+    // 清理过期的观察者
+    list->stateObservers.erase(
+        std::remove_if(list->stateObservers.begin(), list->stateObservers.end(),
             [](const std::weak_ptr<IEngineStateObserver>& weak) {
                 return weak.expired();
             }),
-        stateObservers.end()
+        list->stateObservers.end()
     );
-    
-    // 清理过期的错误观察者
-    errorObservers.erase(
-        std::remove_if(errorObservers.begin(), errorObservers.end(),
+    list->errorObservers.erase(
+        std::remove_if(list->errorObservers.begin(), list->errorObservers.end(),
             [](const std::weak_ptr<IEngineErrorObserver>& weak) {
                 return weak.expired();
             }),
-        errorObservers.end()
+        list->errorObservers.end()
     );
+    
+    modifier(*list);
+    std::atomic_store(&observers, std::shared_ptr<const ObserverList>(std::move(list)));
+}
+
+std::shared_ptr<const EngineNotifier::ObserverList> EngineNotifier::getObservers() const {
+    return std::atomic_load(&observers);
 }
 
 } // namespace WindsynthVST::Engine::Core
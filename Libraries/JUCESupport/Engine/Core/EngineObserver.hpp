@@ -50,7 +50,8 @@ public:
 /**
  * 引擎事件通知器
  * 
- * 管理观察者的注册和通知
+ * 管理观察者的注册和通知。观察者列表写时复制：注册和移除时加锁生成新列表（顺带清理
+ * 已失效的观察者），通知时只原子读取当前列表，不加锁，观察者回调中可以再注册或移除。
  */
 class EngineNotifier {
 public:
@@ -111,26 +112,32 @@ public:
 
 private:
     //==============================================================================
-    // 观察者列表
+    // 观察者列表（发布后不再修改）
     //==============================================================================
     
-    std::vector<std::weak_ptr<IEngineStateObserver>> stateObservers;
-    std::vector<std::weak_ptr<IEngineErrorObserver>> errorObservers;
+    struct ObserverList {
+        std::vector<std::weak_ptr<IEngineStateObserver>> stateObservers;
+        std::vector<std::weak_ptr<IEngineErrorObserver>> errorObservers;
+        
+        // 向后兼容的回调
+        StateCallback stateCallback;
+        ErrorCallback errorCallback;
+    };
     
-    mutable std::mutex observerMutex;
-    
-    //==============================================================================
-    // 向后兼容的回调
-    //==============================================================================
-    
-    StateCallback stateCallback;
-    ErrorCallback errorCallback;
+    std::shared_ptr<const ObserverList> observers = std::make_shared<const ObserverList>();
+    mutable std::mutex observerMutex;      // 只在修改列表时持有
     
     //==============================================================================
     // 内部方法
     //==============================================================================
     
-    void cleanupExpiredObservers();
+    /**
+     * 复制当前列表、清理过期观察者、应用修改后发布（调用者不持有 observerMutex）
+     */
+    template <typename Modifier>
+    void updateObservers(Modifier&& modifier);
+    
+    std::shared_ptr<const ObserverList> getObservers() const;
 };
 
 /**
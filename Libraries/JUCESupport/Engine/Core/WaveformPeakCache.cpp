@@ -0,0 +1,505 @@
+//
+//  WaveformPeakCache.cpp
+//  WindsynthRecorder
+//
+//  Created by AI Assistant
+//  多分辨率波形峰值缓存实现
+//
+
+#include "WaveformPeakCache.hpp"
+#include "AudioGraph/Core/Logger.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+namespace WindsynthVST::Engine::Core {
+
+namespace {
+
+constexpr char sidecarMagic[4] = {'W', 'S', 'P', 'K'};
+constexpr uint32_t sidecarVersion = 1;
+constexpr const char* sidecarExtension = ".wspk";
+constexpr int buildBlockSamples = WaveformPeakCache::baseSamplesPerPeak * 128;
+constexpr juce::int64 dataAlignment = 16;
+constexpr uint32_t maxSidecarChannels = 64;
+
+/**
+ * 附属文件头（本机字节序），后跟 numLevels 个级别描述，再后是各级按帧交错的峰值数据
+ */
+struct SidecarHeader {
+    char magic[4];
+    uint32_t version;
+    uint32_t numChannels;
+    uint32_t numLevels;
+    double sampleRate;
+    int64_t lengthInSamples;
+    int64_t sourceModificationTime;
+    int64_t sourceFileSize;
+};
+
+struct SidecarLevel {
+    uint32_t samplesPerPeak;
+    uint32_t reserved;
+    int64_t numPeaks;
+    int64_t dataOffset;
+};
+
+static_assert(sizeof(WaveformPeakCache::Peak) == 3 * sizeof(float), "峰值结构必须紧凑排列");
+
+juce::int64 alignOffset(juce::int64 offset) {
+    return (offset + dataAlignment - 1) / dataAlignment * dataAlignment;
+}
+
+} // namespace
+
+//==============================================================================
+// 内存映射的峰值金字塔
+//==============================================================================
+
+std::unique_ptr<WaveformPeakCache::PeakTable> WaveformPeakCache::PeakTable::open(const juce::File& sidecarFile,
+                                                                                 juce::int64 sourceModificationTime,
+                                                                                 juce::int64 sourceFileSize) {
+    auto mapped = std::make_unique<juce::MemoryMappedFile>(sidecarFile, juce::MemoryMappedFile::readOnly);
+    const auto* base = static_cast<const char*>(mapped->getData());
+    const auto fileSize = static_cast<juce::int64>(mapped->getSize());
+
+    if (base == nullptr || fileSize < static_cast<juce::int64>(sizeof(SidecarHeader))) {
+        return nullptr;
+    }
+
+    SidecarHeader header;
+    std::memcpy(&header, base, sizeof(header));
+
+    if (std::memcmp(header.magic, sidecarMagic, sizeof(sidecarMagic)) != 0
+        || header.version != sidecarVersion
+        || header.numChannels == 0 || header.numChannels > maxSidecarChannels
+        || header.numLevels == 0 || header.numLevels > static_cast<uint32_t>(maxLevels)
+        || header.sampleRate <= 0.0 || header.lengthInSamples <= 0
+        || header.sourceModificationTime != sourceModificationTime
+        || header.sourceFileSize != sourceFileSize) {
+        return nullptr;
+    }
+
+    const auto levelTableEnd = static_cast<juce::int64>(sizeof(SidecarHeader) + header.numLevels * sizeof(SidecarLevel));
+    if (levelTableEnd > fileSize) {
+        return nullptr;
+    }
+
+    std::unique_ptr<PeakTable> table(new PeakTable());
+    const auto frameBytes = static_cast<juce::int64>(header.numChannels * sizeof(Peak));
+
+    for (uint32_t i = 0; i < header.numLevels; ++i) {
+        SidecarLevel level;
+        std::memcpy(&level, base + sizeof(SidecarHeader) + i * sizeof(SidecarLevel), sizeof(level));
+
+        // 偏移和长度都必须落在文件内（先比较帧数，避免乘法溢出）
+        if (level.samplesPerPeak == 0 || level.numPeaks <= 0
+            || level.dataOffset < levelTableEnd || level.dataOffset % dataAlignment != 0
+            || level.numPeaks > (fileSize - level.dataOffset) / frameBytes) {
+            return nullptr;
+        }
+
+        table->levels.push_back({reinterpret_cast<const Peak*>(base + level.dataOffset),
+                                 level.numPeaks, static_cast<int>(level.samplesPerPeak)});
+    }
+
+    table->mappedFile = std::move(mapped);
+    table->numChannels = static_cast<int>(header.numChannels);
+    table->sampleRate = header.sampleRate;
+    table->lengthInSamples = header.lengthInSamples;
+    table->sourceModificationTime = header.sourceModificationTime;
+    table->sourceFileSize = header.sourceFileSize;
+    return table;
+}
+
+//==============================================================================
+// 构造函数和析构函数
+//==============================================================================
+
+WaveformPeakCache::WaveformPeakCache(std::shared_ptr<AudioClipCache> clipCache, const juce::File& cacheDirectory)
+    : juce::Thread("Waveform Peak Builder"),
+      clipCache(std::move(clipCache)),
+      cacheDirectory(cacheDirectory)
+{
+    startThread(juce::Thread::Priority::low);
+}
+
+WaveformPeakCache::~WaveformPeakCache() {
+    stopThread(4000);
+}
+
+juce::File WaveformPeakCache::getDefaultCacheDirectory() {
+    return juce::File::getSpecialLocation(juce::File::userApplicationDataDirectory)
+        .getChildFile("WindsynthRecorder")
+        .getChildFile("PeakCache");
+}
+
+//==============================================================================
+// 请求和查询
+//==============================================================================
+
+void WaveformPeakCache::request(const juce::File& file) {
+    if (!file.existsAsFile()) {
+        return;
+    }
+
+    const auto key = makeKey(file);
+    {
+        std::lock_guard<std::mutex> lock(entriesMutex);
+        auto it = entries.find(key);
+        if (it != entries.end()) {
+            const auto& entry = it->second;
+            if (entry.state == State::Building) {
+                return;
+            }
+            if (entry.state == State::Ready && entry.table
+                && entry.table->getSourceModificationTime() == file.getLastModificationTime().toMilliseconds()
+                && entry.table->getSourceFileSize() == file.getSize()) {
+                return;
+            }
+        }
+    }
+
+    // 映射已有的附属文件只需读取文件头，可以在调用线程中完成
+    if (auto table = openSidecar(file)) {
+        WSLOG_INFO("WaveformPeakCache", "已映射峰值附属文件: " << file.getFileName()
+                << "，级别数: " << table->getNumLevels());
+        finish(key, std::move(table));
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(entriesMutex);
+        auto& entry = entries[key];
+        entry.state = State::Building;
+        entry.progress = 0.0f;
+        entry.table.reset();
+        pendingBuilds.push_back(file);
+    }
+    notify();
+}
+
+WaveformPeakCache::Status WaveformPeakCache::getStatus(const juce::File& file) const {
+    Status status;
+
+    std::lock_guard<std::mutex> lock(entriesMutex);
+    auto it = entries.find(makeKey(file));
+    if (it == entries.end()) {
+        return status;
+    }
+
+    status.state = it->second.state;
+    status.progress = it->second.progress;
+    if (const auto& table = it->second.table) {
+        status.numChannels = table->getNumChannels();
+        status.numLevels = table->getNumLevels();
+        status.sampleRate = table->getSampleRate();
+        status.lengthInSamples = table->getLengthInSamples();
+    }
+    return status;
+}
+
+WaveformPeakCache::PeakRange WaveformPeakCache::getPeaks(const juce::File& file, double startSeconds,
+                                                         double endSeconds, int maxPeaks) const {
+    PeakRange range;
+
+    std::shared_ptr<const PeakTable> table;
+    {
+        std::lock_guard<std::mutex> lock(entriesMutex);
+        auto it = entries.find(makeKey(file));
+        if (it == entries.end() || it->second.state != State::Ready) {
+            return range;
+        }
+        table = it->second.table;
+    }
+
+    if (!table || maxPeaks <= 0 || !(endSeconds > startSeconds)) {
+        return range;
+    }
+
+    const double sampleRate = table->getSampleRate();
+    const auto startSample = juce::jmax(static_cast<juce::int64>(0),
+                                        static_cast<juce::int64>(std::floor(startSeconds * sampleRate)));
+    const auto endSample = juce::jmin(table->getLengthInSamples(),
+                                      static_cast<juce::int64>(std::ceil(endSeconds * sampleRate)));
+    if (endSample <= startSample) {
+        return range;
+    }
+
+    // 峰值数不超过 maxPeaks 的最细一级，都超过时使用最粗的一级
+    int levelIndex = table->getNumLevels() - 1;
+    for (int i = 0; i < table->getNumLevels(); ++i) {
+        const auto samplesPerPeak = static_cast<juce::int64>(table->getLevel(i).samplesPerPeak);
+        if ((endSample - startSample + samplesPerPeak - 1) / samplesPerPeak <= maxPeaks) {
+            levelIndex = i;
+            break;
+        }
+    }
+
+    const auto& level = table->getLevel(levelIndex);
+    const auto samplesPerPeak = static_cast<juce::int64>(level.samplesPerPeak);
+    const auto firstPeak = juce::jmin(level.numPeaks, startSample / samplesPerPeak);
+    const auto lastPeak = juce::jmin(level.numPeaks, (endSample + samplesPerPeak - 1) / samplesPerPeak);
+
+    range.peaks = level.peaks + firstPeak * table->getNumChannels();
+    range.numPeaks = static_cast<int>(lastPeak - firstPeak);
+    range.numChannels = table->getNumChannels();
+    range.samplesPerPeak = level.samplesPerPeak;
+    range.firstSample = firstPeak * samplesPerPeak;
+    range.sampleRate = sampleRate;
+    range.table = std::move(table);
+    return range;
+}
+
+void WaveformPeakCache::invalidate(const juce::File& file) {
+    const auto key = makeKey(file);
+    {
+        std::lock_guard<std::mutex> lock(entriesMutex);
+        entries.erase(key);
+        pendingBuilds.erase(std::remove(pendingBuilds.begin(), pendingBuilds.end(), file), pendingBuilds.end());
+    }
+
+    // 仍被查询结果持有的映射不受删除影响
+    getSiblingSidecar(file).deleteFile();
+    if (auto cacheSidecar = getCacheSidecar(file); cacheSidecar != juce::File()) {
+        cacheSidecar.deleteFile();
+    }
+}
+
+//==============================================================================
+// 后台生成
+//==============================================================================
+
+void WaveformPeakCache::run() {
+    while (!threadShouldExit()) {
+        juce::File file;
+        {
+            std::lock_guard<std::mutex> lock(entriesMutex);
+            if (!pendingBuilds.empty()) {
+                file = pendingBuilds.front();
+                pendingBuilds.pop_front();
+            }
+        }
+
+        if (file == juce::File()) {
+            wait(-1);
+            continue;
+        }
+
+        build(file);
+    }
+}
+
+void WaveformPeakCache::build(const juce::File& file) {
+    const auto key = makeKey(file);
+    const auto startTime = juce::Time::getMillisecondCounterHiRes();
+
+    // 通过片段缓存读取：WAV/AIFF 内存映射，压缩文件复用播放时解码的数据
+    auto reader = clipCache ? clipCache->createReader(file) : nullptr;
+    if (!reader || reader->lengthInSamples <= 0 || reader->numChannels == 0
+        || reader->numChannels > maxSidecarChannels) {
+        WSLOG_WARNING("WaveformPeakCache", "无法读取音频文件，跳过峰值生成: " << file.getFullPathName());
+        finish(key, nullptr);
+        return;
+    }
+
+    const int numChannels = static_cast<int>(reader->numChannels);
+    const auto length = reader->lengthInSamples;
+    const auto numBasePeaks = (length + baseSamplesPerPeak - 1) / baseSamplesPerPeak;
+
+    std::vector<std::vector<Peak>> levels(1);
+    std::vector<int> levelSamplesPerPeak{baseSamplesPerPeak};
+    levels[0].resize(static_cast<size_t>(numBasePeaks * numChannels));
+
+    // 最细一级直接从采样计算（块长度是峰值长度的整数倍，只有最后一个峰值可能不完整）
+    juce::AudioBuffer<float> buffer(numChannels, buildBlockSamples);
+    for (juce::int64 position = 0; position < length; position += buildBlockSamples) {
+        if (threadShouldExit()) {
+            return;
+        }
+
+        const int numSamples = static_cast<int>(juce::jmin(static_cast<juce::int64>(buildBlockSamples), length - position));
+        reader->read(&buffer, 0, numSamples, position, true, true);
+
+        const auto firstPeak = position / baseSamplesPerPeak;
+        for (int channel = 0; channel < numChannels; ++channel) {
+            for (int offset = 0; offset < numSamples; offset += baseSamplesPerPeak) {
+                const int count = juce::jmin(baseSamplesPerPeak, numSamples - offset);
+                const auto range = buffer.findMinMax(channel, offset, count);
+
+                auto& peak = levels[0][static_cast<size_t>((firstPeak + offset / baseSamplesPerPeak) * numChannels + channel)];
+                peak.minValue = range.getStart();
+                peak.maxValue = range.getEnd();
+                peak.rms = buffer.getRMSLevel(channel, offset, count);
+            }
+        }
+
+        setProgress(key, static_cast<float>(position + numSamples) / static_cast<float>(length));
+    }
+
+    // 更粗的级别由上一级合并，RMS 按能量平均
+    while (static_cast<int>(levels.size()) < maxLevels
+           && static_cast<juce::int64>(levels.back().size()) / numChannels > minPeaksPerLevel) {
+        const auto& lower = levels.back();
+        const auto lowerPeaks = static_cast<juce::int64>(lower.size()) / numChannels;
+        const auto numPeaks = (lowerPeaks + levelFactor - 1) / levelFactor;
+
+        std::vector<Peak> upper(static_cast<size_t>(numPeaks * numChannels));
+        for (juce::int64 frame = 0; frame < numPeaks; ++frame) {
+            const auto first = frame * levelFactor;
+            const auto last = juce::jmin(first + levelFactor, lowerPeaks);
+
+            for (int channel = 0; channel < numChannels; ++channel) {
+                const auto& head = lower[static_cast<size_t>(first * numChannels + channel)];
+                float minValue = head.minValue;
+                float maxValue = head.maxValue;
+                double energy = 0.0;
+
+                for (auto i = first; i < last; ++i) {
+                    const auto& peak = lower[static_cast<size_t>(i * numChannels + channel)];
+                    minValue = juce::jmin(minValue, peak.minValue);
+                    maxValue = juce::jmax(maxValue, peak.maxValue);
+                    energy += static_cast<double>(peak.rms) * peak.rms;
+                }
+
+                auto& merged = upper[static_cast<size_t>(frame * numChannels + channel)];
+                merged.minValue = minValue;
+                merged.maxValue = maxValue;
+                merged.rms = static_cast<float>(std::sqrt(energy / static_cast<double>(last - first)));
+            }
+        }
+
+        levelSamplesPerPeak.push_back(levelSamplesPerPeak.back() * levelFactor);
+        levels.push_back(std::move(upper));
+    }
+
+    // 优先写在源文件旁边，目录不可写时放到缓存目录
+    const auto modificationTime = file.getLastModificationTime().toMilliseconds();
+    const auto fileSize = file.getSize();
+    std::shared_ptr<const PeakTable> table;
+
+    for (const auto& sidecar : {getSiblingSidecar(file), getCacheSidecar(file)}) {
+        if (sidecar == juce::File()) {
+            continue;
+        }
+        if (writeSidecar(sidecar, file, *reader, levels, levelSamplesPerPeak)) {
+            table = PeakTable::open(sidecar, modificationTime, fileSize);
+            if (table) {
+                break;
+            }
+        }
+    }
+
+    if (table) {
+        WSLOG_INFO("WaveformPeakCache", "峰值生成完成: " << file.getFileName()
+                << "，级别数: " << table->getNumLevels()
+                << "，耗时: " << juce::roundToInt(juce::Time::getMillisecondCounterHiRes() - startTime) << "ms");
+    } else {
+        WSLOG_WARNING("WaveformPeakCache", "无法写入峰值附属文件: " << file.getFullPathName());
+    }
+
+    finish(key, std::move(table));
+}
+
+std::shared_ptr<const WaveformPeakCache::PeakTable> WaveformPeakCache::openSidecar(const juce::File& file) const {
+    const auto modificationTime = file.getLastModificationTime().toMilliseconds();
+    const auto fileSize = file.getSize();
+
+    for (const auto& sidecar : {getSiblingSidecar(file), getCacheSidecar(file)}) {
+        if (sidecar != juce::File() && sidecar.existsAsFile()) {
+            if (auto table = PeakTable::open(sidecar, modificationTime, fileSize)) {
+                return table;
+            }
+        }
+    }
+    return nullptr;
+}
+
+bool WaveformPeakCache::writeSidecar(const juce::File& sidecarFile, const juce::File& source,
+                                     const juce::AudioFormatReader& reader,
+                                     const std::vector<std::vector<Peak>>& levels,
+                                     const std::vector<int>& levelSamplesPerPeak) const {
+    const auto directory = sidecarFile.getParentDirectory();
+    if (!directory.createDirectory().wasOk() || !directory.hasWriteAccess()) {
+        return false;
+    }
+
+    const auto numChannels = static_cast<juce::int64>(reader.numChannels);
+
+    // 先写临时文件再替换，生成中断不会留下不完整的附属文件
+    juce::TemporaryFile temporary(sidecarFile);
+    {
+        juce::FileOutputStream stream(temporary.getFile());
+        if (!stream.openedOk()) {
+            return false;
+        }
+
+        SidecarHeader header{};
+        std::memcpy(header.magic, sidecarMagic, sizeof(sidecarMagic));
+        header.version = sidecarVersion;
+        header.numChannels = reader.numChannels;
+        header.numLevels = static_cast<uint32_t>(levels.size());
+        header.sampleRate = reader.sampleRate;
+        header.lengthInSamples = reader.lengthInSamples;
+        header.sourceModificationTime = source.getLastModificationTime().toMilliseconds();
+        header.sourceFileSize = source.getSize();
+        stream.write(&header, sizeof(header));
+
+        auto dataOffset = alignOffset(static_cast<juce::int64>(sizeof(SidecarHeader) + levels.size() * sizeof(SidecarLevel)));
+        std::vector<juce::int64> offsets;
+        for (size_t i = 0; i < levels.size(); ++i) {
+            SidecarLevel level{};
+            level.samplesPerPeak = static_cast<uint32_t>(levelSamplesPerPeak[i]);
+            level.numPeaks = static_cast<int64_t>(levels[i].size()) / numChannels;
+            level.dataOffset = dataOffset;
+            stream.write(&level, sizeof(level));
+
+            offsets.push_back(dataOffset);
+            dataOffset = alignOffset(dataOffset + static_cast<juce::int64>(levels[i].size() * sizeof(Peak)));
+        }
+
+        for (size_t i = 0; i < levels.size(); ++i) {
+            stream.writeRepeatedByte(0, static_cast<size_t>(offsets[i] - stream.getPosition()));
+            stream.write(levels[i].data(), levels[i].size() * sizeof(Peak));
+        }
+
+        stream.flush();
+        if (stream.getStatus().failed()) {
+            return false;
+        }
+    }
+
+    return temporary.overwriteTargetFileWithTemporary();
+}
+
+juce::File WaveformPeakCache::getSiblingSidecar(const juce::File& file) const {
+    return file.getSiblingFile(file.getFileName() + sidecarExtension);
+}
+
+juce::File WaveformPeakCache::getCacheSidecar(const juce::File& file) const {
+    if (cacheDirectory == juce::File()) {
+        return {};
+    }
+
+    // 不同目录下的同名文件用路径哈希区分
+    return cacheDirectory.getChildFile(juce::String::toHexString(file.getFullPathName().hashCode64())
+                                       + "_" + file.getFileName() + sidecarExtension);
+}
+
+void WaveformPeakCache::setProgress(const std::string& key, float progress) {
+    std::lock_guard<std::mutex> lock(entriesMutex);
+    auto it = entries.find(key);
+    if (it != entries.end()) {
+        it->second.progress = progress;
+    }
+}
+
+void WaveformPeakCache::finish(const std::string& key, std::shared_ptr<const PeakTable> table) {
+    std::lock_guard<std::mutex> lock(entriesMutex);
+    auto& entry = entries[key];
+    entry.state = table ? State::Ready : State::Failed;
+    entry.progress = table ? 1.0f : 0.0f;
+    entry.table = std::move(table);
+}
+
+} // namespace WindsynthVST::Engine::Core
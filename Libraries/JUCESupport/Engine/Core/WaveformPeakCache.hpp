@@ -0,0 +1,217 @@
+//
+//  WaveformPeakCache.hpp
+//  WindsynthRecorder
+//
+//  Created by AI Assistant
+//  多分辨率波形峰值缓存 - 后台生成峰值金字塔，写入附属文件并内存映射
+//
+
+#pragma once
+
+#include <JuceHeader.h>
+#include <memory>
+#include <string>
+#include <vector>
+#include <deque>
+#include <unordered_map>
+#include <mutex>
+#include <cstdint>
+#include "AudioClipCache.hpp"
+
+namespace WindsynthVST::Engine::Core {
+
+/**
+ * 波形峰值缓存
+ *
+ * 为加载的音频文件生成多级峰值金字塔（每个峰值保存最小值、最大值和RMS），
+ * 最细一级每 baseSamplesPerPeak 个采样一个峰值，往上每级合并 levelFactor 个峰值。
+ * 生成在后台线程中进行，通过 AudioClipCache 读取源文件（压缩文件复用播放时已解码的数据），
+ * 结果写入附属文件（源文件旁的 .wspk，不可写时放到缓存目录），然后内存映射。
+ * 之后再加载同一文件时直接映射附属文件，不再读取源文件。
+ *
+ * 附属文件记录源文件的修改时间和大小，不一致时重新生成。
+ * 查询返回指向映射数据的指针，不复制峰值；返回的 PeakRange 持有映射，销毁前数据一直有效。
+ */
+class WaveformPeakCache : private juce::Thread {
+public:
+    //==============================================================================
+    // 类型定义
+    //==============================================================================
+
+    /**
+     * 单个峰值（附属文件中的存储格式）
+     */
+    struct Peak {
+        float minValue = 0.0f;
+        float maxValue = 0.0f;
+        float rms = 0.0f;
+    };
+
+    enum class State {
+        None,       // 没有请求过
+        Building,   // 正在后台生成
+        Ready,      // 可以查询
+        Failed      // 无法读取源文件或写入附属文件
+    };
+
+    /**
+     * 峰值缓存状态
+     */
+    struct Status {
+        State state = State::None;
+        float progress = 0.0f;          // 生成进度（0-1）
+        int numChannels = 0;
+        int numLevels = 0;
+        double sampleRate = 0.0;
+        juce::int64 lengthInSamples = 0;
+    };
+
+    class PeakTable;
+
+    /**
+     * 查询结果（零拷贝，peaks 指向内存映射的附属文件）
+     */
+    struct PeakRange {
+        std::shared_ptr<const PeakTable> table;     // 持有映射
+        const Peak* peaks = nullptr;                // 按帧交错：peaks[frame * numChannels + channel]
+        int numPeaks = 0;                           // 帧数
+        int numChannels = 0;
+        int samplesPerPeak = 0;
+        juce::int64 firstSample = 0;                // peaks[0] 对应的源文件采样位置
+        double sampleRate = 0.0;
+    };
+
+    static constexpr int baseSamplesPerPeak = 512;
+    static constexpr int levelFactor = 4;
+    static constexpr int maxLevels = 12;
+    static constexpr juce::int64 minPeaksPerLevel = 256;   // 峰值数少于此值时不再生成更粗的一级
+
+    //==============================================================================
+    // 构造函数和析构函数
+    //==============================================================================
+
+    /**
+     * 构造函数（启动生成线程）
+     * @param clipCache 读取源文件使用的片段缓存
+     * @param cacheDirectory 源文件目录不可写时存放附属文件的目录
+     */
+    WaveformPeakCache(std::shared_ptr<AudioClipCache> clipCache, const juce::File& cacheDirectory);
+
+    /**
+     * 析构函数（停止生成线程，未完成的生成被放弃）
+     */
+    ~WaveformPeakCache() override;
+
+    static juce::File getDefaultCacheDirectory();
+
+    //==============================================================================
+    // 请求和查询
+    //==============================================================================
+
+    /**
+     * 请求文件的峰值（立即返回）
+     * 有效的附属文件直接映射，否则加入后台生成队列
+     */
+    void request(const juce::File& file);
+
+    Status getStatus(const juce::File& file) const;
+
+    /**
+     * 查询时间范围内的峰值
+     * 选择峰值数不超过 maxPeaks 的最细一级；峰值未就绪时返回空结果
+     * @param file 音频文件
+     * @param startSeconds 开始时间
+     * @param endSeconds 结束时间
+     * @param maxPeaks 最多需要的峰值数（通常是显示宽度的像素数）
+     */
+    PeakRange getPeaks(const juce::File& file, double startSeconds, double endSeconds, int maxPeaks) const;
+
+    /**
+     * 移除文件的峰值和附属文件（源文件被外部修改时下次请求也会自动重新生成）
+     */
+    void invalidate(const juce::File& file);
+
+private:
+    //==============================================================================
+    // 内部类型
+    //==============================================================================
+
+    struct Entry {
+        State state = State::None;
+        float progress = 0.0f;
+        std::shared_ptr<const PeakTable> table;
+    };
+
+    //==============================================================================
+    // 内部方法
+    //==============================================================================
+
+    // juce::Thread
+    void run() override;
+
+    void build(const juce::File& file);
+    std::shared_ptr<const PeakTable> openSidecar(const juce::File& file) const;
+    bool writeSidecar(const juce::File& sidecarFile, const juce::File& source,
+                      const juce::AudioFormatReader& reader,
+                      const std::vector<std::vector<Peak>>& levels, const std::vector<int>& levelSamplesPerPeak) const;
+    juce::File getSiblingSidecar(const juce::File& file) const;
+    juce::File getCacheSidecar(const juce::File& file) const;
+    void setProgress(const std::string& key, float progress);
+    void finish(const std::string& key, std::shared_ptr<const PeakTable> table);
+
+    static std::string makeKey(const juce::File& file) { return file.getFullPathName().toStdString(); }
+
+    //==============================================================================
+    // 内部成员变量
+    //==============================================================================
+
+    std::shared_ptr<AudioClipCache> clipCache;
+    juce::File cacheDirectory;
+
+    mutable std::mutex entriesMutex;
+    std::unordered_map<std::string, Entry> entries;     // 以源文件完整路径为键
+    std::deque<juce::File> pendingBuilds;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(WaveformPeakCache)
+};
+
+/**
+ * 内存映射的峰值金字塔（只读）
+ */
+class WaveformPeakCache::PeakTable {
+public:
+    struct Level {
+        const Peak* peaks = nullptr;
+        juce::int64 numPeaks = 0;
+        int samplesPerPeak = 0;
+    };
+
+    /**
+     * 映射并校验附属文件，格式无效或不属于该源文件时返回nullptr
+     */
+    static std::unique_ptr<PeakTable> open(const juce::File& sidecarFile, juce::int64 sourceModificationTime,
+                                           juce::int64 sourceFileSize);
+
+    int getNumChannels() const noexcept { return numChannels; }
+    int getNumLevels() const noexcept { return static_cast<int>(levels.size()); }
+    const Level& getLevel(int index) const noexcept { return levels[static_cast<size_t>(index)]; }
+    double getSampleRate() const noexcept { return sampleRate; }
+    juce::int64 getLengthInSamples() const noexcept { return lengthInSamples; }
+    juce::int64 getSourceModificationTime() const noexcept { return sourceModificationTime; }
+    juce::int64 getSourceFileSize() const noexcept { return sourceFileSize; }
+
+private:
+    PeakTable() = default;
+
+    std::unique_ptr<juce::MemoryMappedFile> mappedFile;
+    std::vector<Level> levels;
+    int numChannels = 0;
+    double sampleRate = 0.0;
+    juce::int64 lengthInSamples = 0;
+    juce::int64 sourceModificationTime = 0;
+    juce::int64 sourceFileSize = 0;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(PeakTable)
+};
+
+} // namespace WindsynthVST::Engine::Core
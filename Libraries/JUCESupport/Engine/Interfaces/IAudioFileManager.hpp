@@ -9,9 +9,22 @@
 #pragma once
 
 #include <string>
+#include <cstdint>
 
 namespace WindsynthVST::Engine::Interfaces {
 
+/**
+ * 流式播放统计
+ */
+struct PlaybackStreamingStats {
+    bool memoryMapped = false;          // 是否使用内存映射读取（WAV/AIFF）
+    bool fromClipCache = false;         // 是否从片段缓存读取已解码数据
+    int readAheadSamples = 0;           // 预读缓冲区大小
+    int64_t bufferedSamples = 0;        // 当前已预读的采样数
+    uint64_t underruns = 0;             // 预读数据不足的音频块数
+    uint64_t underrunSamples = 0;       // 因预读不足输出静音的采样数
+};
+
 /**
  * 音频文件管理接口
  * 
@@ -69,11 +82,38 @@ public:
      */
     virtual bool hasAudioFile() const = 0;
     
+    /**
+     * 获取当前加载的音频文件路径
+     * @return 没有文件时返回空字符串
+     */
+    virtual std::string getCurrentFilePath() const = 0;
+    
     /**
      * 检查是否正在播放
      * @return 正在播放返回true
      */
     virtual bool isPlaying() const = 0;
+    
+    /**
+     * 设置预读缓冲区大小（下次加载文件时生效）
+     * @param numSamples 采样数
+     */
+    virtual void setReadAheadSamples(int numSamples) = 0;
+    
+    /**
+     * 获取预读缓冲区大小
+     */
+    virtual int getReadAheadSamples() const = 0;
+    
+    /**
+     * 获取流式播放统计
+     */
+    virtual PlaybackStreamingStats getStreamingStats() const = 0;
+    
+    /**
+     * 清零欠载计数
+     */
+    virtual void resetStreamingStats() = 0;
 };
 
 } // namespace WindsynthVST::Engine::Interfaces
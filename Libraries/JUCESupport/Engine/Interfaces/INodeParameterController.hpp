@@ -10,6 +10,8 @@
 
 #include <optional>
 #include <string>
+#include <vector>
+#include <cstdint>
 
 namespace WindsynthVST::Engine::Interfaces {
 
@@ -28,6 +30,16 @@ struct ParameterInfo {
     std::string units;
 };
 
+/**
+ * 参数变化（批量设置使用）
+ */
+struct ParameterChange {
+    int parameterIndex = -1;
+    float value = 0.0f;         // 参数值（0.0-1.0）
+    int sampleOffset = 0;       // 相对于节点下一个处理块的采样偏移
+    int rampSamples = 0;        // 大于0时线性过渡到目标值
+};
+
 /**
  * 节点参数控制接口
  * 
@@ -46,6 +58,14 @@ public:
      */
     virtual bool setNodeParameter(uint32_t nodeID, int parameterIndex, float value) = 0;
     
+    /**
+     * 批量设置节点参数（在音频线程中按采样偏移应用）
+     * @param nodeID 节点ID
+     * @param changes 参数变化
+     * @return 成功排队的参数变化数量
+     */
+    virtual int setNodeParameters(uint32_t nodeID, const std::vector<ParameterChange>& changes) = 0;
+    
     /**
      * 获取节点参数
      * @param nodeID 节点ID
@@ -61,6 +81,15 @@ public:
      */
     virtual int getNodeParameterCount(uint32_t nodeID) const = 0;
     
+    /**
+     * 读取节点的所有参数值（来自参数缓存，一次复制）
+     * @param nodeID 节点ID
+     * @param values 输出数组
+     * @param maxCount 数组容量
+     * @return 复制的参数数量
+     */
+    virtual int getNodeParameterValues(uint32_t nodeID, float* values, int maxCount) const = 0;
+    
     /**
      * 获取节点参数信息
      * @param nodeID 节点ID
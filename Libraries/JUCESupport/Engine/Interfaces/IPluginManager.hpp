@@ -38,6 +38,8 @@ struct SimpleNodeInfo {
     bool isBypassed = false;
     int numInputChannels = 0;
     int numOutputChannels = 0;
+    bool sleepWhenSilent = false;
+    bool isSleeping = false;
 };
 
 /**
@@ -7,7 +7,8 @@
 //
 
 #include "AudioFileManager.hpp"
-#include <iostream>
+#include "AudioGraph/Core/Logger.hpp"
+#include <algorithm>
 
 namespace WindsynthVST::Engine::Managers {
 
@@ -19,13 +20,15 @@ AudioFileManager::AudioFileManager(std::shared_ptr<Core::EngineContext> context,
                                  std::shared_ptr<Core::EngineNotifier> notifier)
     : context_(std::move(context))
     , notifier_(std::move(notifier)) {
-    std::cout << "[AudioFileManager] 构造函数" << std::endl;
+    WSLOG_INFO("AudioFileManager", "构造函数");
+    diskThread_.startThread(juce::Thread::Priority::high);
     setupTransportSource();
 }
 
 AudioFileManager::~AudioFileManager() {
-    std::cout << "[AudioFileManager] 析构函数" << std::endl;
+    WSLOG_INFO("AudioFileManager", "析构函数");
     cleanupCurrentFile();
+    diskThread_.stopThread(2000);
 }
 
 //==============================================================================
@@ -33,7 +36,7 @@ AudioFileManager::~AudioFileManager() {
 //==============================================================================
 
 bool AudioFileManager::loadAudioFile(const std::string& filePath) {
-    std::cout << "[AudioFileManager] 加载音频文件: " << filePath << std::endl;
+    WSLOG_INFO("AudioFileManager", "加载音频文件: " << filePath);
     
     if (!context_ || !context_->isInitialized()) {
         notifyError("引擎上下文未初始化");
@@ -56,25 +59,30 @@ bool AudioFileManager::loadAudioFile(const std::string& filePath) {
         // 清理当前文件
         cleanupCurrentFile();
         
-        // 创建音频格式读取器
-        auto formatManager = context_->getFormatManager();
-        if (!formatManager) {
-            notifyError("音频格式管理器无效");
+        // 通过共享片段缓存创建读取器（未压缩文件内存映射，压缩文件使用已解码的缓存数据）
+        auto clipCache = context_->getClipCache();
+        if (!clipCache) {
+            notifyError("音频片段缓存无效");
             return false;
         }
         
-        auto reader = formatManager->createReaderFor(audioFile);
+        auto readerSource = Core::AudioClipCache::ReaderSource::Streamed;
+        auto reader = clipCache->createReader(audioFile, &readerSource);
         if (!reader) {
             notifyError("无法读取音频文件: " + filePath);
             return false;
         }
         
-        // 创建新的音频格式读取器源
-        readerSource_ = std::make_unique<juce::AudioFormatReaderSource>(reader, true);
+        // 创建流式播放源，磁盘读取和解码在预读线程中完成
+        const double sourceSampleRate = reader->sampleRate;
+        streamingSource_ = std::make_unique<StreamingAudioSource>(std::move(reader), diskThread_,
+                                                                  readAheadSamples_.load());
+        memoryMapped_ = readerSource == Core::AudioClipCache::ReaderSource::MemoryMapped;
+        fromClipCache_ = readerSource == Core::AudioClipCache::ReaderSource::Cached;
         
-        // 设置新源到传输源
+        // 设置新源到传输源（预读已由流式播放源完成，传输源不再额外缓冲）
         if (transportSource_) {
-            transportSource_->setSource(readerSource_.get(), 0, nullptr, reader->sampleRate);
+            transportSource_->setSource(streamingSource_.get(), 0, nullptr, sourceSampleRate);
         }
         
         // 将transportSource设置到GraphAudioProcessor中
@@ -83,8 +91,15 @@ bool AudioFileManager::loadAudioFile(const std::string& filePath) {
             graphProcessor->setTransportSource(transportSource_.get());
         }
         
+        // 波形峰值在后台生成（已有附属文件时直接映射）
+        if (auto peakCache = context_->getPeakCache()) {
+            peakCache->request(audioFile);
+        }
+        
+        currentFilePath_ = filePath;
         hasFile_.store(true);
-        std::cout << "[AudioFileManager] 音频文件加载成功" << std::endl;
+        WSLOG_INFO("AudioFileManager", "音频文件加载成功（预读 " << readAheadSamples_.load() << " 采样"
+                << (memoryMapped_ ? "，内存映射" : "") << (fromClipCache_ ? "，已缓存" : "") << "）");
         return true;
         
     } catch (const std::exception& e) {
@@ -95,7 +110,7 @@ bool AudioFileManager::loadAudioFile(const std::string& filePath) {
 }
 
 bool AudioFileManager::play() {
-    std::cout << "[AudioFileManager] 开始播放" << std::endl;
+    WSLOG_INFO("AudioFileManager", "开始播放");
     
     if (!hasFile_.load()) {
         notifyError("没有加载音频文件");
@@ -119,7 +134,7 @@ bool AudioFileManager::play() {
 }
 
 void AudioFileManager::pause() {
-    std::cout << "[AudioFileManager] 暂停播放" << std::endl;
+    WSLOG_INFO("AudioFileManager", "暂停播放");
     
     if (transportSource_) {
         transportSource_->stop();
@@ -128,7 +143,7 @@ void AudioFileManager::pause() {
 }
 
 void AudioFileManager::stopPlayback() {
-    std::cout << "[AudioFileManager] 停止播放" << std::endl;
+    WSLOG_INFO("AudioFileManager", "停止播放");
     
     if (transportSource_) {
         transportSource_->stop();
@@ -171,10 +186,45 @@ bool AudioFileManager::hasAudioFile() const {
     return hasFile_.load();
 }
 
+std::string AudioFileManager::getCurrentFilePath() const {
+    return hasFile_.load() ? currentFilePath_ : std::string();
+}
+
 bool AudioFileManager::isPlaying() const {
     return isPlaying_.load();
 }
 
+void AudioFileManager::setReadAheadSamples(int numSamples) {
+    readAheadSamples_.store(juce::jlimit(minReadAheadSamples, maxReadAheadSamples, numSamples));
+}
+
+int AudioFileManager::getReadAheadSamples() const {
+    return readAheadSamples_.load();
+}
+
+Interfaces::PlaybackStreamingStats AudioFileManager::getStreamingStats() const {
+    Interfaces::PlaybackStreamingStats stats;
+    stats.readAheadSamples = readAheadSamples_.load();
+    
+    if (streamingSource_ && hasFile_.load()) {
+        const auto sourceStats = streamingSource_->getStatistics();
+        stats.memoryMapped = memoryMapped_;
+        stats.fromClipCache = fromClipCache_;
+        stats.readAheadSamples = sourceStats.readAheadSamples;
+        stats.bufferedSamples = sourceStats.bufferedSamples;
+        stats.underruns = sourceStats.underruns;
+        stats.underrunSamples = sourceStats.underrunSamples;
+    }
+    
+    return stats;
+}
+
+void AudioFileManager::resetStreamingStats() {
+    if (streamingSource_) {
+        streamingSource_->resetStatistics();
+    }
+}
+
 //==============================================================================
 // 内部方法
 //==============================================================================
@@ -183,7 +233,7 @@ void AudioFileManager::notifyError(const std::string& error) {
     if (notifier_) {
         notifier_->notifyError(error);
     }
-    std::cerr << "[AudioFileManager] 错误: " << error << std::endl;
+    WSLOG_ERROR("AudioFileManager", "错误: " << error);
 }
 
 void AudioFileManager::setupTransportSource() {
@@ -195,7 +245,10 @@ void AudioFileManager::cleanupCurrentFile() {
         transportSource_->setSource(nullptr);
     }
     
-    readerSource_.reset();
+    streamingSource_.reset();
+    currentFilePath_.clear();
+    memoryMapped_ = false;
+    fromClipCache_ = false;
     hasFile_.store(false);
     isPlaying_.store(false);
 }
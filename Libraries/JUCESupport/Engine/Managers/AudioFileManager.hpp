@@ -11,6 +11,7 @@
 #include "../Interfaces/IAudioFileManager.hpp"
 #include "../Core/EngineContext.hpp"
 #include "../Core/EngineObserver.hpp"
+#include "StreamingAudioSource.hpp"
 #include <JuceHeader.h>
 #include <memory>
 #include <atomic>
@@ -51,7 +52,20 @@ public:
     double getCurrentTime() const override;
     double getDuration() const override;
     bool hasAudioFile() const override;
+    std::string getCurrentFilePath() const override;
     bool isPlaying() const override;
+    void setReadAheadSamples(int numSamples) override;
+    int getReadAheadSamples() const override;
+    Interfaces::PlaybackStreamingStats getStreamingStats() const override;
+    void resetStreamingStats() override;
+    
+    //==============================================================================
+    // 常量
+    //==============================================================================
+    
+    static constexpr int defaultReadAheadSamples = 65536;
+    static constexpr int minReadAheadSamples = 4096;
+    static constexpr int maxReadAheadSamples = 1048576;
 
 private:
     //==============================================================================
@@ -61,13 +75,20 @@ private:
     std::shared_ptr<Core::EngineContext> context_;
     std::shared_ptr<Core::EngineNotifier> notifier_;
     
+    // 磁盘预读线程（必须比使用它的流式播放源活得更久）
+    juce::TimeSliceThread diskThread_{"Playback Disk Reader"};
+    
     // 音频文件相关组件
     std::unique_ptr<juce::AudioTransportSource> transportSource_;
-    std::unique_ptr<juce::AudioFormatReaderSource> readerSource_;
+    std::unique_ptr<StreamingAudioSource> streamingSource_;
     
     // 状态管理
     std::atomic<bool> hasFile_{false};
     std::atomic<bool> isPlaying_{false};
+    std::atomic<int> readAheadSamples_{defaultReadAheadSamples};
+    std::string currentFilePath_;
+    bool memoryMapped_ = false;
+    bool fromClipCache_ = false;
     
     //==============================================================================
     // 内部方法
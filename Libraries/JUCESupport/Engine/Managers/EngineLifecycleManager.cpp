@@ -7,7 +7,7 @@
 //
 
 #include "EngineLifecycleManager.hpp"
-#include <iostream>
+#include "AudioGraph/Core/Logger.hpp"
 #include <thread>
 #include <chrono>
 
@@ -21,11 +21,11 @@ EngineLifecycleManager::EngineLifecycleManager(std::shared_ptr<Core::EngineConte
                                              std::shared_ptr<Core::EngineNotifier> notifier)
     : context_(std::move(context))
     , notifier_(std::move(notifier)) {
-    std::cout << "[EngineLifecycleManager] 构造函数" << std::endl;
+    WSLOG_INFO("EngineLifecycleManager", "构造函数");
 }
 
 EngineLifecycleManager::~EngineLifecycleManager() {
-    std::cout << "[EngineLifecycleManager] 析构函数" << std::endl;
+    WSLOG_INFO("EngineLifecycleManager", "析构函数");
     shutdown();
 }
 
@@ -34,7 +34,7 @@ EngineLifecycleManager::~EngineLifecycleManager() {
 //==============================================================================
 
 bool EngineLifecycleManager::initialize(const Core::EngineConfig& config) {
-    std::cout << "[EngineLifecycleManager] 初始化引擎" << std::endl;
+    WSLOG_INFO("EngineLifecycleManager", "初始化引擎");
     
     if (!context_) {
         notifyError("引擎上下文无效");
@@ -85,7 +85,7 @@ bool EngineLifecycleManager::initialize(const Core::EngineConfig& config) {
 }
 
 bool EngineLifecycleManager::start() {
-    std::cout << "[EngineLifecycleManager] 启动音频处理" << std::endl;
+    WSLOG_INFO("EngineLifecycleManager", "启动音频处理");
     
     if (!context_) {
         notifyError("引擎上下文无效");
@@ -114,7 +114,7 @@ bool EngineLifecycleManager::start() {
 }
 
 void EngineLifecycleManager::stop() {
-    std::cout << "[EngineLifecycleManager] 停止音频处理" << std::endl;
+    WSLOG_INFO("EngineLifecycleManager", "停止音频处理");
     
     if (!context_ || context_->getState() == Core::EngineState::Stopped) {
         return;
@@ -134,7 +134,7 @@ void EngineLifecycleManager::stop() {
 }
 
 void EngineLifecycleManager::shutdown() {
-    std::cout << "[EngineLifecycleManager] 关闭引擎" << std::endl;
+    WSLOG_INFO("EngineLifecycleManager", "关闭引擎");
     
     if (!context_) {
         return;
@@ -144,7 +144,7 @@ void EngineLifecycleManager::shutdown() {
     
     try {
         context_->shutdown();
-        std::cout << "[EngineLifecycleManager] 引擎关闭完成" << std::endl;
+        WSLOG_INFO("EngineLifecycleManager", "引擎关闭完成");
         
     } catch (const std::exception& e) {
         std::string error = "关闭引擎时出错: " + std::string(e.what());
@@ -179,7 +179,7 @@ void EngineLifecycleManager::notifyError(const std::string& error) {
     if (notifier_) {
         notifier_->notifyError(error);
     }
-    std::cerr << "[EngineLifecycleManager] 错误: " << error << std::endl;
+    WSLOG_ERROR("EngineLifecycleManager", "错误: " << error);
 }
 
 bool EngineLifecycleManager::configureAudioIO(const Core::EngineConfig& config) {
@@ -7,7 +7,7 @@
 //
 
 #include "NodeParameterController.hpp"
-#include <iostream>
+#include "AudioGraph/Core/Logger.hpp"
 
 namespace WindsynthVST::Engine::Managers {
 
@@ -19,11 +19,11 @@ NodeParameterController::NodeParameterController(std::shared_ptr<Core::EngineCon
                                                std::shared_ptr<Core::EngineNotifier> notifier)
     : context_(std::move(context))
     , notifier_(std::move(notifier)) {
-    std::cout << "[NodeParameterController] 构造函数" << std::endl;
+    WSLOG_INFO("NodeParameterController", "构造函数");
 }
 
 NodeParameterController::~NodeParameterController() {
-    std::cout << "[NodeParameterController] 析构函数" << std::endl;
+    WSLOG_INFO("NodeParameterController", "析构函数");
 }
 
 //==============================================================================
@@ -48,42 +48,78 @@ bool NodeParameterController::setNodeParameter(uint32_t nodeID, int parameterInd
             return false;
         }
         
-        auto* param = instance->getParameters()[parameterIndex];
-        if (param) {
-            param->setValueNotifyingHost(value);
-            return true;
-        }
-        
-        return false;
+        return setNodeParameters(nodeID, { { parameterIndex, value } }) > 0;
     } catch (const std::exception& e) {
         notifyError("设置节点参数失败: " + std::string(e.what()));
         return false;
     }
 }
 
+int NodeParameterController::setNodeParameters(uint32_t nodeID, const std::vector<Interfaces::ParameterChange>& changes) {
+    if (!context_ || !context_->isInitialized()) {
+        notifyError("引擎上下文未初始化");
+        return 0;
+    }
+    
+    auto pluginManager = context_->getPluginManager();
+    if (!pluginManager) {
+        return 0;
+    }
+    
+    try {
+        // 记录撤销历史（连续拖动同一参数时合并为一步）
+        if (auto graphManager = context_->getGraphManager()) {
+            for (const auto& change : changes) {
+                const float oldValue = pluginManager->getParameterValue(convertToNodeID(nodeID), change.parameterIndex);
+                graphManager->recordPropertyChange(convertToNodeID(nodeID),
+                                                   "parameter:" + std::to_string(change.parameterIndex),
+                                                   oldValue, change.value);
+            }
+        }
+        
+        // 参数变化交给节点的自动化队列，由音频线程应用
+        std::vector<AudioGraph::ParameterEvent> events;
+        events.reserve(changes.size());
+        for (const auto& change : changes) {
+            AudioGraph::ParameterEvent event;
+            event.parameterIndex = change.parameterIndex;
+            event.value = change.value;
+            event.sampleOffset = change.sampleOffset;
+            event.rampSamples = change.rampSamples;
+            events.push_back(event);
+        }
+        
+        const int numQueued = pluginManager->setParameterValues(convertToNodeID(nodeID), events);
+        if (numQueued < static_cast<int>(changes.size())) {
+            WSLOG_ERROR("NodeParameterController", "警告：" << (static_cast<int>(changes.size()) - numQueued)
+                    << " 个参数变化未能排队");
+        }
+        return numQueued;
+    } catch (const std::exception& e) {
+        notifyError("批量设置节点参数失败: " + std::string(e.what()));
+        return 0;
+    }
+}
+
 float NodeParameterController::getNodeParameter(uint32_t nodeID, int parameterIndex) const {
     if (!context_ || !context_->isInitialized()) {
         return -1.0f;
     }
     
     try {
-        auto* instance = getPluginInstance(nodeID);
-        if (!instance) {
+        auto pluginManager = context_->getPluginManager();
+        if (!pluginManager) {
             return -1.0f;
         }
         
-        if (!isValidParameterIndex(instance, parameterIndex)) {
+        auto metadata = pluginManager->getParameterMetadata(convertToNodeID(nodeID));
+        if (!metadata || parameterIndex < 0 || parameterIndex >= static_cast<int>(metadata->size())) {
             return -1.0f;
         }
         
-        auto* param = instance->getParameters()[parameterIndex];
-        if (param) {
-            return param->getValue();
-        }
-        
-        return -1.0f;
+        return pluginManager->getParameterValue(convertToNodeID(nodeID), parameterIndex);
     } catch (const std::exception& e) {
-        std::cerr << "[NodeParameterController] 获取节点参数失败: " << e.what() << std::endl;
+        WSLOG_ERROR("NodeParameterController", "获取节点参数失败: " << e.what());
         return -1.0f;
     }
 }
@@ -94,51 +130,48 @@ int NodeParameterController::getNodeParameterCount(uint32_t nodeID) const {
     }
     
     try {
-        auto* instance = getPluginInstance(nodeID);
-        if (instance) {
-            return static_cast<int>(instance->getParameters().size());
+        auto pluginManager = context_->getPluginManager();
+        if (!pluginManager) {
+            return 0;
         }
-        return 0;
+        
+        auto metadata = pluginManager->getParameterMetadata(convertToNodeID(nodeID));
+        return metadata ? static_cast<int>(metadata->size()) : 0;
     } catch (const std::exception& e) {
-        std::cerr << "[NodeParameterController] 获取节点参数数量失败: " << e.what() << std::endl;
+        WSLOG_ERROR("NodeParameterController", "获取节点参数数量失败: " << e.what());
         return 0;
     }
 }
 
+int NodeParameterController::getNodeParameterValues(uint32_t nodeID, float* values, int maxCount) const {
+    if (!context_ || !context_->isInitialized() || !values || maxCount <= 0) {
+        return 0;
+    }
+    
+    auto pluginManager = context_->getPluginManager();
+    return pluginManager ? pluginManager->copyParameterValues(convertToNodeID(nodeID), values, maxCount) : 0;
+}
+
 std::optional<Interfaces::ParameterInfo> NodeParameterController::getNodeParameterInfo(uint32_t nodeID, int parameterIndex) const {
     if (!context_ || !context_->isInitialized()) {
         return std::nullopt;
     }
     
     try {
-        auto* instance = getPluginInstance(nodeID);
-        if (!instance) {
+        auto pluginManager = context_->getPluginManager();
+        if (!pluginManager) {
             return std::nullopt;
         }
         
-        if (!isValidParameterIndex(instance, parameterIndex)) {
+        auto metadata = pluginManager->getParameterMetadata(convertToNodeID(nodeID));
+        if (!metadata || parameterIndex < 0 || parameterIndex >= static_cast<int>(metadata->size())) {
             return std::nullopt;
         }
         
-        auto* param = instance->getParameters()[parameterIndex];
-        if (!param) {
-            return std::nullopt;
-        }
-        
-        Interfaces::ParameterInfo info;
-        info.name = param->getName(256).toStdString();
-        info.label = param->getLabel().toStdString();
-        info.minValue = 0.0f;
-        info.maxValue = 1.0f;
-        info.defaultValue = param->getDefaultValue();
-        info.currentValue = param->getValue();
-        info.isDiscrete = param->isDiscrete();
-        info.numSteps = param->getNumSteps();
-        info.units = param->getLabel().toStdString();
-        
-        return info;
+        return makeParameterInfo((*metadata)[static_cast<size_t>(parameterIndex)],
+                                 pluginManager->getParameterValue(convertToNodeID(nodeID), parameterIndex));
     } catch (const std::exception& e) {
-        std::cerr << "[NodeParameterController] 获取节点参数信息失败: " << e.what() << std::endl;
+        WSLOG_ERROR("NodeParameterController", "获取节点参数信息失败: " << e.what());
         return std::nullopt;
     }
 }
@@ -195,34 +228,27 @@ std::vector<Interfaces::ParameterInfo> NodeParameterController::getAllParameterI
     }
     
     try {
-        auto* instance = getPluginInstance(nodeID);
-        if (!instance) {
+        auto pluginManager = context_->getPluginManager();
+        if (!pluginManager) {
             return result;
         }
         
-        const auto& parameters = instance->getParameters();
-        result.reserve(parameters.size());
+        // 元数据和参数值都来自缓存，不调用插件
+        auto metadata = pluginManager->getParameterMetadata(convertToNodeID(nodeID));
+        if (!metadata) {
+            return result;
+        }
         
-        for (size_t i = 0; i < parameters.size(); ++i) {
-            auto* param = parameters[i];
-            if (param) {
-                Interfaces::ParameterInfo info;
-                info.name = param->getName(256).toStdString();
-                info.label = param->getLabel().toStdString();
-                info.minValue = 0.0f;
-                info.maxValue = 1.0f;
-                info.defaultValue = param->getDefaultValue();
-                info.currentValue = param->getValue();
-                info.isDiscrete = param->isDiscrete();
-                info.numSteps = param->getNumSteps();
-                info.units = param->getLabel().toStdString();
-                
-                result.push_back(info);
-            }
+        std::vector<float> values(metadata->size());
+        pluginManager->copyParameterValues(convertToNodeID(nodeID), values.data(), static_cast<int>(values.size()));
+        
+        result.reserve(metadata->size());
+        for (size_t i = 0; i < metadata->size(); ++i) {
+            result.push_back(makeParameterInfo((*metadata)[i], values[i]));
         }
         
     } catch (const std::exception& e) {
-        std::cerr << "[NodeParameterController] 获取所有参数信息失败: " << e.what() << std::endl;
+        WSLOG_ERROR("NodeParameterController", "获取所有参数信息失败: " << e.what());
     }
     
     return result;
@@ -236,7 +262,22 @@ void NodeParameterController::notifyError(const std::string& error) {
     if (notifier_) {
         notifier_->notifyError(error);
     }
-    std::cerr << "[NodeParameterController] 错误: " << error << std::endl;
+    WSLOG_ERROR("NodeParameterController", "错误: " << error);
+}
+
+Interfaces::ParameterInfo NodeParameterController::makeParameterInfo(const AudioGraph::ParameterMetadata& metadata,
+                                                                    float value) {
+    Interfaces::ParameterInfo info;
+    info.name = metadata.name;
+    info.label = metadata.label;
+    info.minValue = 0.0f;
+    info.maxValue = 1.0f;
+    info.defaultValue = metadata.defaultValue;
+    info.currentValue = value;
+    info.isDiscrete = metadata.isDiscrete;
+    info.numSteps = metadata.numSteps;
+    info.units = metadata.label;
+    return info;
 }
 
 AudioGraph::NodeID NodeParameterController::convertToNodeID(uint32_t nodeID) const {
@@ -43,8 +43,10 @@ public:
     //==============================================================================
     
     bool setNodeParameter(uint32_t nodeID, int parameterIndex, float value) override;
+    int setNodeParameters(uint32_t nodeID, const std::vector<Interfaces::ParameterChange>& changes) override;
     float getNodeParameter(uint32_t nodeID, int parameterIndex) const override;
     int getNodeParameterCount(uint32_t nodeID) const override;
+    int getNodeParameterValues(uint32_t nodeID, float* values, int maxCount) const override;
     std::optional<Interfaces::ParameterInfo> getNodeParameterInfo(uint32_t nodeID, int parameterIndex) const override;
     bool resetNodeParameter(uint32_t nodeID, int parameterIndex = -1) override;
     std::vector<Interfaces::ParameterInfo> getAllParameterInfo(uint32_t nodeID) const override;
@@ -63,6 +65,7 @@ private:
     
     void notifyError(const std::string& error);
     AudioGraph::NodeID convertToNodeID(uint32_t nodeID) const;
+    static Interfaces::ParameterInfo makeParameterInfo(const AudioGraph::ParameterMetadata& metadata, float value);
     juce::AudioProcessor* getPluginInstance(uint32_t nodeID) const;
     bool isValidParameterIndex(juce::AudioProcessor* instance, int parameterIndex) const;
     
@@ -0,0 +1,152 @@
+//
+//  StreamingAudioSource.cpp
+//  WindsynthRecorder
+//
+//  Created by AI Assistant
+//  后台预读的音频文件流式播放源实现
+//
+
+#include "StreamingAudioSource.hpp"
+#include <algorithm>
+
+namespace WindsynthVST::Engine::Managers {
+
+//==============================================================================
+// ReadRangeTracker（由磁盘线程调用）
+//==============================================================================
+
+void StreamingAudioSource::ReadRangeTracker::prepareToPlay(int samplesPerBlockExpected, double sampleRate) {
+    source.prepareToPlay(samplesPerBlockExpected, sampleRate);
+}
+
+void StreamingAudioSource::ReadRangeTracker::releaseResources() {
+    source.releaseResources();
+}
+
+void StreamingAudioSource::ReadRangeTracker::getNextAudioBlock(const juce::AudioSourceChannelInfo& info) {
+    source.getNextAudioBlock(info);
+    readEnd.store(source.getNextReadPosition(), std::memory_order_release);
+}
+
+void StreamingAudioSource::ReadRangeTracker::setNextReadPosition(juce::int64 newPosition) {
+    source.setNextReadPosition(newPosition);
+
+    // 不连续的读取意味着预读缓冲区被重新填充
+    if (newPosition != readEnd.load(std::memory_order_relaxed)) {
+        readStart.store(newPosition, std::memory_order_relaxed);
+        readEnd.store(newPosition, std::memory_order_release);
+    }
+}
+
+juce::int64 StreamingAudioSource::ReadRangeTracker::getNextReadPosition() const {
+    return source.getNextReadPosition();
+}
+
+juce::int64 StreamingAudioSource::ReadRangeTracker::getTotalLength() const {
+    return source.getTotalLength();
+}
+
+bool StreamingAudioSource::ReadRangeTracker::isLooping() const {
+    return source.isLooping();
+}
+
+void StreamingAudioSource::ReadRangeTracker::setLooping(bool shouldLoop) {
+    source.setLooping(shouldLoop);
+}
+
+//==============================================================================
+// 构造函数和析构函数
+//==============================================================================
+
+StreamingAudioSource::StreamingAudioSource(std::unique_ptr<juce::AudioFormatReader> reader,
+                                           juce::TimeSliceThread& diskThread,
+                                           int readAhead)
+    : readerSource(reader.get(), true),
+      tracker(readerSource),
+      bufferingSource(&tracker, diskThread, false, std::max(readAhead, 1024),
+                      std::max(1, static_cast<int>(reader->numChannels))),
+      sourceSampleRate(reader->sampleRate),
+      readAheadSamples(std::max(readAhead, 1024))
+{
+    // 读取器的所有权已经交给readerSource
+    reader.release();
+}
+
+StreamingAudioSource::~StreamingAudioSource() = default;
+
+//==============================================================================
+// 统计
+//==============================================================================
+
+StreamingAudioSource::Statistics StreamingAudioSource::getStatistics() const noexcept {
+    Statistics stats;
+    stats.readAheadSamples = readAheadSamples;
+    stats.bufferedSamples = std::max<juce::int64>(0, tracker.getReadEnd() - bufferingSource.getNextReadPosition());
+    stats.underruns = underruns.load(std::memory_order_relaxed);
+    stats.underrunSamples = underrunSamples.load(std::memory_order_relaxed);
+    return stats;
+}
+
+void StreamingAudioSource::resetStatistics() noexcept {
+    underruns.store(0, std::memory_order_relaxed);
+    underrunSamples.store(0, std::memory_order_relaxed);
+}
+
+//==============================================================================
+// PositionableAudioSource 接口实现
+//==============================================================================
+
+void StreamingAudioSource::prepareToPlay(int samplesPerBlockExpected, double sampleRate) {
+    bufferingSource.prepareToPlay(samplesPerBlockExpected, sampleRate);
+}
+
+void StreamingAudioSource::releaseResources() {
+    bufferingSource.releaseResources();
+}
+
+void StreamingAudioSource::getNextAudioBlock(const juce::AudioSourceChannelInfo& info) {
+    // 在取数据之前检查预读区间是否覆盖本块（文件结尾之后的部分不算欠载）
+    const auto start = bufferingSource.getNextReadPosition();
+    const auto end = std::min<juce::int64>(start + info.numSamples, getTotalLength());
+
+    if (end > start) {
+        const auto readStart = tracker.getReadStart();
+        const auto readEnd = tracker.getReadEnd();
+
+        juce::int64 missing = 0;
+        if (start < readStart || start >= readEnd) {
+            missing = end - start;
+        } else if (end > readEnd) {
+            missing = end - readEnd;
+        }
+
+        if (missing > 0) {
+            underruns.fetch_add(1, std::memory_order_relaxed);
+            underrunSamples.fetch_add(static_cast<uint64_t>(missing), std::memory_order_relaxed);
+        }
+    }
+
+    bufferingSource.getNextAudioBlock(info);
+}
+
+void StreamingAudioSource::setNextReadPosition(juce::int64 newPosition) {
+    bufferingSource.setNextReadPosition(newPosition);
+}
+
+juce::int64 StreamingAudioSource::getNextReadPosition() const {
+    return bufferingSource.getNextReadPosition();
+}
+
+juce::int64 StreamingAudioSource::getTotalLength() const {
+    return bufferingSource.getTotalLength();
+}
+
+bool StreamingAudioSource::isLooping() const {
+    return bufferingSource.isLooping();
+}
+
+void StreamingAudioSource::setLooping(bool shouldLoop) {
+    readerSource.setLooping(shouldLoop);
+}
+
+} // namespace WindsynthVST::Engine::Managers
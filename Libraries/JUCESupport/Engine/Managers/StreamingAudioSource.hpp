@@ -0,0 +1,114 @@
+//
+//  StreamingAudioSource.hpp
+//  WindsynthRecorder
+//
+//  Created by AI Assistant
+//  后台预读的音频文件流式播放源
+//
+
+#pragma once
+
+#include <JuceHeader.h>
+#include <memory>
+#include <atomic>
+#include <cstdint>
+
+namespace WindsynthVST::Engine::Managers {
+
+/**
+ * 流式播放源
+ *
+ * 由磁盘线程提前读取并解码音频文件，音频回调只从预读缓冲区拷贝数据，
+ * 不再在音频线程中访问磁盘。预读数据不足时输出静音并记录欠载次数。
+ */
+class StreamingAudioSource : public juce::PositionableAudioSource {
+public:
+    /**
+     * 流式播放统计
+     */
+    struct Statistics {
+        int readAheadSamples = 0;       // 预读缓冲区大小
+        int64_t bufferedSamples = 0;    // 当前播放位置之后已读取的采样数
+        uint64_t underruns = 0;         // 预读数据不足的音频块数
+        uint64_t underrunSamples = 0;   // 因预读不足输出静音的采样数
+    };
+
+    /**
+     * 构造函数
+     * @param reader 音频文件读取器（由本对象持有）
+     * @param diskThread 执行预读的磁盘线程
+     * @param readAheadSamples 预读缓冲区大小（采样数）
+     */
+    StreamingAudioSource(std::unique_ptr<juce::AudioFormatReader> reader,
+                         juce::TimeSliceThread& diskThread,
+                         int readAheadSamples);
+    ~StreamingAudioSource() override;
+
+    /**
+     * 获取源文件采样率
+     */
+    double getSourceSampleRate() const noexcept { return sourceSampleRate; }
+
+    /**
+     * 获取流式播放统计（任意线程）
+     */
+    Statistics getStatistics() const noexcept;
+
+    /**
+     * 清零欠载计数（任意线程）
+     */
+    void resetStatistics() noexcept;
+
+    //==============================================================================
+    // PositionableAudioSource 接口
+    //==============================================================================
+
+    void prepareToPlay(int samplesPerBlockExpected, double sampleRate) override;
+    void releaseResources() override;
+    void getNextAudioBlock(const juce::AudioSourceChannelInfo& info) override;
+    void setNextReadPosition(juce::int64 newPosition) override;
+    juce::int64 getNextReadPosition() const override;
+    juce::int64 getTotalLength() const override;
+    bool isLooping() const override;
+    void setLooping(bool shouldLoop) override;
+
+private:
+    /**
+     * 位于读取器与预读缓冲之间，记录磁盘线程已读取的连续区间
+     */
+    class ReadRangeTracker : public juce::PositionableAudioSource {
+    public:
+        explicit ReadRangeTracker(juce::PositionableAudioSource& source) : source(source) {}
+
+        void prepareToPlay(int samplesPerBlockExpected, double sampleRate) override;
+        void releaseResources() override;
+        void getNextAudioBlock(const juce::AudioSourceChannelInfo& info) override;
+        void setNextReadPosition(juce::int64 newPosition) override;
+        juce::int64 getNextReadPosition() const override;
+        juce::int64 getTotalLength() const override;
+        bool isLooping() const override;
+        void setLooping(bool shouldLoop) override;
+
+        juce::int64 getReadStart() const noexcept { return readStart.load(std::memory_order_acquire); }
+        juce::int64 getReadEnd() const noexcept { return readEnd.load(std::memory_order_acquire); }
+
+    private:
+        juce::PositionableAudioSource& source;
+        std::atomic<juce::int64> readStart{0};
+        std::atomic<juce::int64> readEnd{0};
+    };
+
+    juce::AudioFormatReaderSource readerSource;
+    ReadRangeTracker tracker;
+    juce::BufferingAudioSource bufferingSource;
+
+    const double sourceSampleRate;
+    const int readAheadSamples;
+
+    std::atomic<uint64_t> underruns{0};
+    std::atomic<uint64_t> underrunSamples{0};
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(StreamingAudioSource)
+};
+
+} // namespace WindsynthVST::Engine::Managers
@@ -0,0 +1,285 @@
+//
+//  BackgroundRenderQueue.cpp
+//  WindsynthRecorder
+//
+//  Created by AI Assistant
+//  后台离线渲染队列实现
+//
+
+#include "BackgroundRenderQueue.hpp"
+#include "AudioGraph/Core/GraphAudioProcessor.hpp"
+#include "AudioGraph/Core/Logger.hpp"
+#include <algorithm>
+
+namespace WindsynthVST::Engine::Render {
+
+namespace {
+
+constexpr int idleWaitMs = 500;
+constexpr int shutdownWarningIntervalMs = 5000;
+
+} // namespace
+
+//==============================================================================
+// 构造函数和析构函数
+//==============================================================================
+
+BackgroundRenderQueue::BackgroundRenderQueue(std::shared_ptr<juce::AudioFormatManager> formatManager,
+                                             AudioGraph::PluginInstanceFactory pluginFactory)
+    : juce::Thread("Background Render"),
+      formatManager(std::move(formatManager)),
+      pluginFactory(std::move(pluginFactory))
+{
+    startThread(juce::Thread::Priority::low);
+}
+
+BackgroundRenderQueue::~BackgroundRenderQueue() {
+    // 插件实例化和渲染循环都会检查退出标志，等待线程自行结束，不强制终止
+    cancelAll();
+    signalThreadShouldExit();
+    jobAvailable.signal();
+
+    while (!waitForThreadToExit(shutdownWarningIntervalMs)) {
+        WSLOG_WARNING("BackgroundRenderQueue", "等待渲染线程退出，任务 " << currentJobID.load());
+    }
+}
+
+//==============================================================================
+// 配置
+//==============================================================================
+
+void BackgroundRenderQueue::setClipCache(std::shared_ptr<Core::AudioClipCache> cache) {
+    std::lock_guard<std::mutex> lock(queueMutex);
+    clipCache = std::move(cache);
+}
+
+void BackgroundRenderQueue::setGovernor(RealtimeLoadProvider provider, const GovernorSettings& settings) {
+    std::lock_guard<std::mutex> lock(queueMutex);
+    loadProvider = std::move(provider);
+    governorSettings = settings;
+}
+
+//==============================================================================
+// 任务管理
+//==============================================================================
+
+BackgroundRenderQueue::JobID BackgroundRenderQueue::enqueue(const RenderJob& job,
+                                                            AudioGraph::GraphSnapshot snapshot,
+                                                            RenderProgressCallback progressCallback,
+                                                            CompletionCallback completionCallback) {
+    PendingJob pendingJob;
+    pendingJob.job = job;
+    pendingJob.snapshot = std::move(snapshot);
+    pendingJob.progressCallback = std::move(progressCallback);
+    pendingJob.completionCallback = std::move(completionCallback);
+
+    JobID jobID = 0;
+    {
+        std::lock_guard<std::mutex> lock(queueMutex);
+        jobID = nextJobID++;
+        pendingJob.jobID = jobID;
+        pendingJobs.push_back(std::move(pendingJob));
+    }
+
+    WSLOG_INFO("BackgroundRenderQueue", "添加渲染任务 " << jobID << ": " << job.inputPath << " -> " << job.outputPath);
+    jobAvailable.signal();
+    return jobID;
+}
+
+bool BackgroundRenderQueue::cancel(JobID jobID) {
+    PendingJob removedJob;
+    {
+        std::lock_guard<std::mutex> lock(queueMutex);
+
+        auto it = std::find_if(pendingJobs.begin(), pendingJobs.end(),
+                               [jobID](const PendingJob& pendingJob) { return pendingJob.jobID == jobID; });
+        if (it == pendingJobs.end()) {
+            if (currentJobID.load() != jobID) {
+                return false;
+            }
+
+            // 正在渲染：引擎尚未创建时由渲染线程在开始前检查
+            currentJobCancelled = true;
+            if (activeEngine != nullptr) {
+                activeEngine->cancel();
+            }
+            WSLOG_INFO("BackgroundRenderQueue", "取消正在渲染的任务 " << jobID);
+            return true;
+        }
+
+        removedJob = std::move(*it);
+        pendingJobs.erase(it);
+    }
+
+    WSLOG_INFO("BackgroundRenderQueue", "取消排队中的任务 " << jobID);
+    completeCancelled(removedJob);
+    return true;
+}
+
+void BackgroundRenderQueue::cancelAll() {
+    std::deque<PendingJob> removedJobs;
+    {
+        std::lock_guard<std::mutex> lock(queueMutex);
+        removedJobs.swap(pendingJobs);
+
+        if (currentJobID.load() != 0) {
+            currentJobCancelled = true;
+            if (activeEngine != nullptr) {
+                activeEngine->cancel();
+            }
+        }
+    }
+
+    for (const auto& pendingJob : removedJobs) {
+        completeCancelled(pendingJob);
+    }
+}
+
+int BackgroundRenderQueue::getNumPendingJobs() const {
+    std::lock_guard<std::mutex> lock(queueMutex);
+    return static_cast<int>(pendingJobs.size());
+}
+
+void BackgroundRenderQueue::completeCancelled(const PendingJob& pendingJob) {
+    if (!pendingJob.completionCallback) {
+        return;
+    }
+
+    RenderResult result;
+    result.inputPath = pendingJob.job.inputPath;
+    result.outputPath = pendingJob.job.outputPath;
+    result.cancelled = true;
+    result.error = "渲染已取消";
+    pendingJob.completionCallback(pendingJob.jobID, result);
+}
+
+//==============================================================================
+// 渲染线程
+//==============================================================================
+
+void BackgroundRenderQueue::run() {
+    while (!threadShouldExit()) {
+        PendingJob pendingJob;
+        bool hasJob = false;
+        {
+            std::lock_guard<std::mutex> lock(queueMutex);
+            if (!pendingJobs.empty()) {
+                pendingJob = std::move(pendingJobs.front());
+                pendingJobs.pop_front();
+                currentJobID.store(pendingJob.jobID);
+                currentJobCancelled = false;
+                hasJob = true;
+            }
+        }
+
+        if (!hasJob) {
+            jobAvailable.wait(idleWaitMs);
+            continue;
+        }
+
+        RenderResult result;
+        try {
+            result = renderJob(pendingJob);
+        } catch (const std::exception& e) {
+            result.inputPath = pendingJob.job.inputPath;
+            result.outputPath = pendingJob.job.outputPath;
+            result.error = "渲染异常: " + std::string(e.what());
+        } catch (...) {
+            result.inputPath = pendingJob.job.inputPath;
+            result.outputPath = pendingJob.job.outputPath;
+            result.error = "渲染异常: 未知异常";
+        }
+
+        currentJobID.store(0);
+
+        WSLOG_INFO("BackgroundRenderQueue", "渲染任务 " << pendingJob.jobID << " 结束: "
+                << (result.success ? "成功" : result.error));
+
+        if (pendingJob.completionCallback) {
+            pendingJob.completionCallback(pendingJob.jobID, result);
+        }
+    }
+}
+
+RenderResult BackgroundRenderQueue::renderJob(const PendingJob& pendingJob) {
+    OfflineRenderEngine::Options options;
+    options.writerPriority = juce::Thread::Priority::low;
+    OfflineRenderEngine engine(formatManager, options);
+
+    RealtimeLoadProvider provider;
+    GovernorSettings settings;
+    {
+        std::lock_guard<std::mutex> lock(queueMutex);
+        engine.setClipCache(clipCache);
+        provider = loadProvider;
+        settings = governorSettings;
+        activeEngine = &engine;
+        if (currentJobCancelled) {
+            engine.cancel();
+        }
+    }
+
+    if (provider) {
+        lastThrottleTicks = 0;
+        engine.setThrottleCallback([this, provider, settings] { throttle(provider, settings); });
+    }
+
+    RenderResult result;
+    result.inputPath = pendingJob.job.inputPath;
+    result.outputPath = pendingJob.job.outputPath;
+
+    // 没有插件时只做格式转换
+    std::unique_ptr<AudioGraph::GraphAudioProcessor> renderGraph;
+    if (pendingJob.snapshot.hasPlugins() && !engine.isCancelled()) {
+        std::string graphError;
+        renderGraph = OfflineRenderEngine::createGraphInstance(pendingJob.snapshot, pluginFactory,
+                                                               pendingJob.snapshot.config.sampleRate,
+                                                               options.blockSize, graphError,
+                                                               [this, &engine] {
+                                                                   return engine.isCancelled() || threadShouldExit();
+                                                               });
+        if (!renderGraph) {
+            result.error = "无法创建音频图实例: " + graphError;
+        }
+    }
+
+    if (engine.isCancelled()) {
+        result.cancelled = true;
+        result.error = "渲染已取消";
+    } else if (result.error.empty()) {
+        result = engine.renderFile(pendingJob.job, renderGraph.get(), renderGraph != nullptr, true,
+                                   pendingJob.progressCallback);
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(queueMutex);
+        activeEngine = nullptr;
+    }
+
+    if (renderGraph) {
+        renderGraph->releaseResources();
+    }
+
+    return result;
+}
+
+void BackgroundRenderQueue::throttle(const RealtimeLoadProvider& provider, const GovernorSettings& settings) {
+    const auto now = juce::Time::getHighResolutionTicks();
+    const double workMs = lastThrottleTicks > 0
+        ? juce::Time::highResolutionTicksToSeconds(now - lastThrottleTicks) * 1000.0
+        : 0.0;
+
+    const float load = provider();
+    if (load > settings.maxRealtimeLoad) {
+        // 超出上限越多，休眠时间相对刚完成的渲染块耗时越长
+        const float headroom = std::max(0.05f, 1.0f - settings.maxRealtimeLoad);
+        const float excess = (load - settings.maxRealtimeLoad) / headroom;
+        const int sleepMs = juce::jlimit(1, std::max(1, settings.maxSleepMs),
+                                         juce::roundToInt(workMs * (1.0 + 4.0 * excess)));
+        juce::Thread::sleep(sleepMs);
+    }
+
+    lastThrottleTicks = juce::Time::getHighResolutionTicks();
+}
+
+} // namespace WindsynthVST::Engine::Render
@@ -0,0 +1,172 @@
+//
+//  BackgroundRenderQueue.hpp
+//  WindsynthRecorder
+//
+//  Created by AI Assistant
+//  后台离线渲染队列 - 实时监听不中断
+//
+
+#pragma once
+
+#include <JuceHeader.h>
+#include <memory>
+#include <deque>
+#include <mutex>
+#include <atomic>
+#include <functional>
+#include "OfflineRenderEngine.hpp"
+#include "RenderTypes.hpp"
+#include "AudioGraph/Core/AudioGraphTypes.hpp"
+
+namespace WindsynthVST::Engine::Render {
+
+/**
+ * 后台渲染队列
+ *
+ * 渲染任务在低优先级工作线程中依次执行，每个任务使用从图快照（插件状态来自
+ * getStateInformation）重建的独立图实例，实时图和音频设备保持运行，监听不中断。
+ *
+ * 调速器在每个渲染块之后读取实时回调的负载：负载超过上限时按超出程度休眠，
+ * 让出CPU给音频设备回调；负载较低时渲染全速进行。
+ */
+class BackgroundRenderQueue : private juce::Thread {
+public:
+    //==============================================================================
+    // 类型定义
+    //==============================================================================
+
+    using JobID = int32_t;
+
+    /**
+     * 任务完成回调（在渲染线程中调用；排队中被取消的任务在调用 cancel 的线程中回调）
+     */
+    using CompletionCallback = std::function<void(JobID jobID, const RenderResult& result)>;
+
+    /**
+     * 实时负载查询（返回 0.0-1.0+，任意线程可调用）
+     */
+    using RealtimeLoadProvider = std::function<float()>;
+
+    /**
+     * 调速器设置
+     */
+    struct GovernorSettings {
+        float maxRealtimeLoad = 0.6f;   // 实时回调负载超过该值时渲染线程开始让出CPU
+        int maxSleepMs = 50;            // 每个渲染块之后的最长休眠时间
+    };
+
+    //==============================================================================
+    // 构造函数和析构函数
+    //==============================================================================
+
+    /**
+     * 构造函数
+     * @param formatManager 音频格式管理器
+     * @param pluginFactory 插件实例工厂（在渲染线程中调用，需要等待时应在
+     *                      juce::Thread::currentThreadShouldExit() 返回true后放弃）
+     */
+    BackgroundRenderQueue(std::shared_ptr<juce::AudioFormatManager> formatManager,
+                          AudioGraph::PluginInstanceFactory pluginFactory);
+
+    /**
+     * 析构函数（取消所有任务并等待渲染线程退出，不强制终止线程）
+     */
+    ~BackgroundRenderQueue() override;
+
+    //==============================================================================
+    // 配置
+    //==============================================================================
+
+    void setClipCache(std::shared_ptr<Core::AudioClipCache> cache);
+
+    /**
+     * 设置实时负载查询和调速器参数（未设置时不做节流）
+     */
+    void setGovernor(RealtimeLoadProvider loadProvider, const GovernorSettings& settings = GovernorSettings());
+
+    //==============================================================================
+    // 任务管理
+    //==============================================================================
+
+    /**
+     * 添加渲染任务
+     * @param job 渲染任务
+     * @param snapshot 渲染使用的图快照（没有插件时只做格式转换）
+     * @param progressCallback 进度回调（在渲染线程中调用）
+     * @param completionCallback 完成回调（在渲染线程中调用）
+     * @return 任务ID（大于0）
+     */
+    JobID enqueue(const RenderJob& job,
+                  AudioGraph::GraphSnapshot snapshot,
+                  RenderProgressCallback progressCallback = nullptr,
+                  CompletionCallback completionCallback = nullptr);
+
+    /**
+     * 取消任务（排队中的任务直接移除，正在渲染的任务尽快停止）
+     * @return 找到任务时返回true
+     */
+    bool cancel(JobID jobID);
+
+    /**
+     * 取消所有任务
+     */
+    void cancelAll();
+
+    /**
+     * 排队中（尚未开始）的任务数量
+     */
+    int getNumPendingJobs() const;
+
+    /**
+     * 正在渲染的任务ID（没有时返回0）
+     */
+    JobID getCurrentJobID() const { return currentJobID.load(); }
+
+private:
+    //==============================================================================
+    // 内部类型
+    //==============================================================================
+
+    struct PendingJob {
+        JobID jobID = 0;
+        RenderJob job;
+        AudioGraph::GraphSnapshot snapshot;
+        RenderProgressCallback progressCallback;
+        CompletionCallback completionCallback;
+    };
+
+    //==============================================================================
+    // 内部方法
+    //==============================================================================
+
+    void run() override;
+    RenderResult renderJob(const PendingJob& pendingJob);
+    void throttle(const RealtimeLoadProvider& provider, const GovernorSettings& settings);
+    static void completeCancelled(const PendingJob& pendingJob);
+
+    //==============================================================================
+    // 内部成员变量
+    //==============================================================================
+
+    std::shared_ptr<juce::AudioFormatManager> formatManager;
+    AudioGraph::PluginInstanceFactory pluginFactory;
+
+    mutable std::mutex queueMutex;
+    std::deque<PendingJob> pendingJobs;
+    JobID nextJobID = 1;
+    std::shared_ptr<Core::AudioClipCache> clipCache;
+    RealtimeLoadProvider loadProvider;
+    GovernorSettings governorSettings;
+    OfflineRenderEngine* activeEngine = nullptr;    // 正在渲染的引擎（受 queueMutex 保护）
+    bool currentJobCancelled = false;
+
+    std::atomic<JobID> currentJobID{0};
+    juce::WaitableEvent jobAvailable;
+
+    // 调速器状态（仅渲染线程访问）
+    juce::int64 lastThrottleTicks = 0;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(BackgroundRenderQueue)
+};
+
+} // namespace WindsynthVST::Engine::Render
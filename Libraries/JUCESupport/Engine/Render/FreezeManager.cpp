@@ -0,0 +1,331 @@
+//
+//  FreezeManager.cpp
+//  WindsynthRecorder
+//
+//  Created by AI Assistant
+//  节点冻结管理器实现
+//
+
+#include "FreezeManager.hpp"
+#include "OfflineRenderEngine.hpp"
+#include "AudioGraph/Core/FrozenChainProcessor.hpp"
+#include "AudioGraph/Core/Logger.hpp"
+#include <algorithm>
+#include <set>
+
+namespace WindsynthVST::Engine::Render {
+
+namespace {
+
+constexpr const char* renderDirectoryName = "WindsynthFreeze";
+
+} // namespace
+
+//==============================================================================
+// 构造函数和析构函数
+//==============================================================================
+
+FreezeManager::FreezeManager(std::shared_ptr<juce::AudioFormatManager> formatManager,
+                             AudioGraph::PluginInstanceFactory pluginFactory)
+    : formatManager(std::move(formatManager)),
+      pluginFactory(std::move(pluginFactory))
+{
+}
+
+FreezeManager::~FreezeManager() {
+    std::lock_guard<std::mutex> lock(chainsMutex);
+    for (auto& frozenChain : frozenChains) {
+        frozenChain.renderFile.deleteFile();
+    }
+}
+
+void FreezeManager::setClipCache(std::shared_ptr<Core::AudioClipCache> cache) {
+    std::lock_guard<std::mutex> lock(chainsMutex);
+    clipCache = std::move(cache);
+}
+
+//==============================================================================
+// 冻结和解冻
+//==============================================================================
+
+AudioGraph::NodeID FreezeManager::freeze(AudioGraph::GraphAudioProcessor& graph,
+                                         const std::vector<AudioGraph::NodeID>& nodeIDs,
+                                         const std::string& inputPath,
+                                         const FreezeOptions& options,
+                                         const RenderProgressCallback& progressCallback,
+                                         std::string& error) {
+    std::lock_guard<std::mutex> operationLock(operationMutex);
+
+    if (nodeIDs.empty()) {
+        error = "没有要冻结的节点";
+        return AudioGraph::NodeID{0};
+    }
+
+    // 只能冻结插件节点（已冻结的播放节点和I/O节点不在快照中）
+    auto subgraph = graph.createSubgraphSnapshot(nodeIDs);
+    const std::set<juce::uint32> requestedUIDs = [&nodeIDs] {
+        std::set<juce::uint32> uids;
+        for (auto nodeID : nodeIDs) {
+            uids.insert(nodeID.uid);
+        }
+        return uids;
+    }();
+    if (subgraph.nodes.size() != requestedUIDs.size()) {
+        error = "只能冻结插件节点";
+        return AudioGraph::NodeID{0};
+    }
+
+    AudioGraph::GraphSnapshot renderSnapshot;
+    if (!createRenderSnapshot(subgraph, renderSnapshot, error)) {
+        return AudioGraph::NodeID{0};
+    }
+
+    // 播放节点按音频图的采样位置读取，渲染结果必须与音频图采样率一致
+    if (!formatManager) {
+        error = "音频格式管理器无效";
+        return AudioGraph::NodeID{0};
+    }
+    {
+        std::unique_ptr<juce::AudioFormatReader> reader(formatManager->createReaderFor(juce::File(inputPath)));
+        if (!reader) {
+            error = "无法读取音频文件: " + inputPath;
+            return AudioGraph::NodeID{0};
+        }
+        if (reader->sampleRate != graph.getConfig().sampleRate) {
+            error = "音频文件采样率与音频图不一致，无法冻结";
+            return AudioGraph::NodeID{0};
+        }
+    }
+
+    std::string chainName;
+    for (const auto& nodeSnapshot : subgraph.nodes) {
+        chainName += (chainName.empty() ? "" : " > ") + nodeSnapshot.name;
+    }
+    WSLOG_INFO("FreezeManager", "冻结节点: " << chainName);
+
+    // 在独立的图实例上渲染，实时图继续运行
+    const int blockSize = OfflineRenderEngine::Options().blockSize;
+
+    std::string graphError;
+    auto renderGraph = OfflineRenderEngine::createGraphInstance(renderSnapshot, pluginFactory,
+                                                                renderSnapshot.config.sampleRate,
+                                                                blockSize, graphError);
+    if (!renderGraph) {
+        error = "无法创建音频图实例: " + graphError;
+        return AudioGraph::NodeID{0};
+    }
+    const int latencySamples = renderGraph->getGraphLatencySamples();
+
+    RenderSettings settings;
+    settings.sampleRate = static_cast<int32_t>(renderSnapshot.config.sampleRate);
+    settings.numChannels = std::max(1, renderSnapshot.config.numOutputChannels);
+    settings.bitDepth = 32;
+    settings.format = RenderSettings::Format::WAV;
+
+    const auto renderFile = createRenderFile(options);
+
+    RenderResult result;
+    {
+        OfflineRenderEngine renderEngine(formatManager);
+        {
+            std::lock_guard<std::mutex> lock(chainsMutex);
+            renderEngine.setClipCache(clipCache);
+        }
+        result = renderEngine.renderFile(RenderJob(inputPath, renderFile.getFullPathName().toStdString(), settings),
+                                         renderGraph.get(), true, true, progressCallback);
+    }
+    renderGraph->releaseResources();
+    renderGraph.reset();
+
+    if (!result.success) {
+        renderFile.deleteFile();
+        error = "冻结渲染失败: " + result.error;
+        return AudioGraph::NodeID{0};
+    }
+
+    juce::String readerError;
+    auto reader = AudioGraph::FrozenChainProcessor::openRenderFile(renderFile, readerError);
+    if (!reader) {
+        renderFile.deleteFile();
+        error = readerError.toStdString();
+        return AudioGraph::NodeID{0};
+    }
+    const double durationSeconds = static_cast<double>(reader->lengthInSamples) / reader->sampleRate;
+
+    auto player = std::make_unique<AudioGraph::FrozenChainProcessor>(std::move(reader), graph.getTimelinePosition(),
+                                                                      latencySamples, "Frozen: " + chainName);
+
+    std::vector<juce::AudioProcessorGraph::Node::Ptr> removedNodes;
+    const auto playerNodeID = graph.replaceNodes(nodeIDs, std::move(player), removedNodes);
+    if (playerNodeID.uid == 0) {
+        renderFile.deleteFile();
+        error = "无法替换冻结节点: " + graph.getLastError();
+        return AudioGraph::NodeID{0};
+    }
+
+    // 卸载时插件实例在渲染序列释放节点后销毁
+    if (options.unloadPlugins) {
+        removedNodes.clear();
+    }
+
+    FrozenChain frozenChain;
+    frozenChain.info.playerNodeID = playerNodeID.uid;
+    for (const auto& nodeSnapshot : subgraph.nodes) {
+        frozenChain.info.frozenNodeIDs.push_back(nodeSnapshot.nodeUID);
+    }
+    frozenChain.info.name = chainName;
+    frozenChain.info.renderFilePath = renderFile.getFullPathName().toStdString();
+    frozenChain.info.durationSeconds = durationSeconds;
+    frozenChain.info.latencySamples = latencySamples;
+    frozenChain.info.pluginsUnloaded = options.unloadPlugins;
+    frozenChain.subgraph = std::move(subgraph);
+    frozenChain.retainedNodes = std::move(removedNodes);
+    frozenChain.renderFile = renderFile;
+
+    {
+        std::lock_guard<std::mutex> lock(chainsMutex);
+        frozenChains.push_back(std::move(frozenChain));
+    }
+
+    WSLOG_INFO("FreezeManager", "冻结完成，播放节点: " << playerNodeID.uid << ", 时长: " << durationSeconds
+            << " 秒" << (options.unloadPlugins ? "，插件已卸载" : ""));
+    return playerNodeID;
+}
+
+bool FreezeManager::unfreeze(AudioGraph::GraphAudioProcessor& graph, AudioGraph::NodeID playerNodeID, std::string& error) {
+    std::lock_guard<std::mutex> operationLock(operationMutex);
+
+    FrozenChain frozenChain;
+    {
+        std::lock_guard<std::mutex> lock(chainsMutex);
+        auto it = std::find_if(frozenChains.begin(), frozenChains.end(), [playerNodeID](const FrozenChain& chain) {
+            return chain.info.playerNodeID == playerNodeID.uid;
+        });
+        if (it == frozenChains.end()) {
+            error = "不是冻结播放节点";
+            return false;
+        }
+
+        frozenChain = std::move(*it);
+        frozenChains.erase(it);
+    }
+
+    // 音频图被整体替换（例如加载预设）后播放节点已不存在，只清理冻结记录
+    if (graph.getGraph().getNodeForId(playerNodeID) == nullptr) {
+        frozenChain.renderFile.deleteFile();
+        error = "冻结播放节点已不在音频图中";
+        return false;
+    }
+
+    if (!graph.restoreReplacedNodes(playerNodeID, frozenChain.subgraph, frozenChain.retainedNodes,
+                                    pluginFactory, error)) {
+        std::lock_guard<std::mutex> lock(chainsMutex);
+        frozenChains.push_back(std::move(frozenChain));
+        return false;
+    }
+
+    // 播放节点的内存映射在渲染序列释放节点后解除，删除文件不影响正在进行的读取
+    frozenChain.renderFile.deleteFile();
+    WSLOG_INFO("FreezeManager", "已解冻: " << frozenChain.info.name);
+    return true;
+}
+
+bool FreezeManager::isFrozen(AudioGraph::NodeID playerNodeID) const {
+    std::lock_guard<std::mutex> lock(chainsMutex);
+    return std::any_of(frozenChains.begin(), frozenChains.end(), [playerNodeID](const FrozenChain& chain) {
+        return chain.info.playerNodeID == playerNodeID.uid;
+    });
+}
+
+std::vector<FreezeManager::FrozenChainInfo> FreezeManager::getFrozenChains() const {
+    std::lock_guard<std::mutex> lock(chainsMutex);
+
+    std::vector<FrozenChainInfo> infos;
+    infos.reserve(frozenChains.size());
+    for (const auto& frozenChain : frozenChains) {
+        infos.push_back(frozenChain.info);
+    }
+    return infos;
+}
+
+void FreezeManager::expandFrozenChains(const AudioGraph::GraphAudioProcessor& graph,
+                                       AudioGraph::GraphSnapshot& snapshot) const {
+    std::lock_guard<std::mutex> lock(chainsMutex);
+
+    for (const auto& frozenChain : frozenChains) {
+        const auto playerUID = frozenChain.info.playerNodeID;
+        if (graph.getGraph().getNodeForId(AudioGraph::NodeID{playerUID}) == nullptr) {
+            continue;
+        }
+
+        auto& connections = snapshot.connections;
+        connections.erase(std::remove_if(connections.begin(), connections.end(),
+                                         [playerUID](const AudioGraph::Connection& connection) {
+                                             return connection.source.nodeID.uid == playerUID ||
+                                                    connection.destination.nodeID.uid == playerUID;
+                                         }),
+                          connections.end());
+
+        snapshot.nodes.insert(snapshot.nodes.end(), frozenChain.subgraph.nodes.begin(),
+                              frozenChain.subgraph.nodes.end());
+        connections.insert(connections.end(), frozenChain.subgraph.connections.begin(),
+                           frozenChain.subgraph.connections.end());
+    }
+}
+
+//==============================================================================
+// 内部方法
+//==============================================================================
+
+bool FreezeManager::createRenderSnapshot(const AudioGraph::GraphSnapshot& subgraph,
+                                         AudioGraph::GraphSnapshot& renderSnapshot,
+                                         std::string& error) {
+    renderSnapshot = subgraph;
+    renderSnapshot.connections.clear();
+
+    std::set<juce::uint32> nodeUIDs;
+    for (const auto& nodeSnapshot : subgraph.nodes) {
+        nodeUIDs.insert(nodeSnapshot.nodeUID);
+    }
+
+    for (const auto& connection : subgraph.connections) {
+        AudioGraph::Connection mapped = connection;
+
+        // 上游插件（或已冻结的播放节点）的处理无法从文件重现，冻结后它们的输出也无处可接
+        if (nodeUIDs.count(connection.source.nodeID.uid) == 0 &&
+            connection.source.nodeID != subgraph.audioInputNodeID &&
+            connection.source.nodeID != subgraph.midiInputNodeID) {
+            error = "冻结的节点有来自其他节点的输入，请把上游插件一起冻结";
+            return false;
+        }
+
+        // 外部输出接到I/O输出，通道号保持不变，播放节点按同样的通道接回原目标
+        if (nodeUIDs.count(connection.destination.nodeID.uid) == 0) {
+            mapped.destination.nodeID = connection.source.isMIDI() ? subgraph.midiOutputNodeID
+                                                                   : subgraph.audioOutputNodeID;
+            if (!connection.source.isMIDI()) {
+                mapped.destination.channelIndex = connection.source.channelIndex;
+            }
+        }
+
+        if (std::find(renderSnapshot.connections.begin(), renderSnapshot.connections.end(), mapped) ==
+            renderSnapshot.connections.end()) {
+            renderSnapshot.connections.push_back(mapped);
+        }
+    }
+
+    return true;
+}
+
+juce::File FreezeManager::createRenderFile(const FreezeOptions& options) const {
+    auto directory = options.cacheDirectory != juce::File()
+        ? options.cacheDirectory
+        : juce::File::getSpecialLocation(juce::File::tempDirectory).getChildFile(renderDirectoryName);
+
+    if (!directory.exists()) {
+        directory.createDirectory();
+    }
+    return directory.getNonexistentChildFile("Freeze", ".wav");
+}
+
+} // namespace WindsynthVST::Engine::Render
@@ -0,0 +1,167 @@
+//
+//  FreezeManager.hpp
+//  WindsynthRecorder
+//
+//  Created by AI Assistant
+//  节点冻结管理器 - 把插件子图预渲染为文件并用播放节点替换
+//
+
+#pragma once
+
+#include <JuceHeader.h>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+#include "RenderTypes.hpp"
+#include "../Core/AudioClipCache.hpp"
+#include "AudioGraph/Core/GraphAudioProcessor.hpp"
+#include "AudioGraph/Core/AudioGraphTypes.hpp"
+
+namespace WindsynthVST::Engine::Render {
+
+/**
+ * 节点冻结管理器
+ *
+ * 冻结：把选中的插件节点（单个节点或 createProcessingChain 建立的处理链）连同它们之间的连接
+ * 复制到独立的图实例，外部输入接到音频输入、外部输出接到音频输出，用离线渲染引擎
+ * 以当前加载的音频文件为输入渲染成32位浮点WAV。然后在一次拓扑切换中用冻结播放节点
+ * 替换这些节点，播放节点按文件播放位置读取内存映射的渲染结果。
+ *
+ * 被替换的插件实例默认保留（状态完整，解冻时直接放回）；选择卸载时释放插件，
+ * 解冻时用插件工厂按快照重建。离线渲染完整图时冻结的节点按快照展开，渲染结果不受影响。
+ */
+class FreezeManager {
+public:
+    //==============================================================================
+    // 类型定义
+    //==============================================================================
+
+    /**
+     * 冻结选项
+     */
+    struct FreezeOptions {
+        bool unloadPlugins = false;     // 卸载被冻结的插件实例
+        juce::File cacheDirectory;      // 渲染文件目录（为空时使用临时目录）
+    };
+
+    /**
+     * 冻结信息
+     */
+    struct FrozenChainInfo {
+        uint32_t playerNodeID = 0;
+        std::vector<uint32_t> frozenNodeIDs;
+        std::string name;
+        std::string renderFilePath;
+        double durationSeconds = 0.0;
+        int latencySamples = 0;
+        bool pluginsUnloaded = false;
+    };
+
+    //==============================================================================
+    // 构造函数和析构函数
+    //==============================================================================
+
+    /**
+     * 构造函数
+     * @param formatManager 音频格式管理器
+     * @param pluginFactory 插件实例工厂（渲染和解冻时调用）
+     */
+    FreezeManager(std::shared_ptr<juce::AudioFormatManager> formatManager,
+                  AudioGraph::PluginInstanceFactory pluginFactory);
+
+    /**
+     * 析构函数（删除仍处于冻结状态的渲染文件）
+     */
+    ~FreezeManager();
+
+    void setClipCache(std::shared_ptr<Core::AudioClipCache> cache);
+
+    //==============================================================================
+    // 冻结和解冻
+    //==============================================================================
+
+    /**
+     * 冻结插件节点（同步渲染，应在消息线程或后台线程调用）
+     * 音频文件的采样率必须与音频图一致；被冻结节点的输入只能来自音频图输入，上游插件需要一起冻结
+     * @param graph 实时音频图
+     * @param nodeIDs 被冻结的插件节点
+     * @param inputPath 音频文件（当前加载的文件）
+     * @param options 冻结选项
+     * @param progressCallback 渲染进度回调
+     * @param error 失败时的错误信息
+     * @return 播放节点ID，失败时返回0
+     */
+    AudioGraph::NodeID freeze(AudioGraph::GraphAudioProcessor& graph,
+                              const std::vector<AudioGraph::NodeID>& nodeIDs,
+                              const std::string& inputPath,
+                              const FreezeOptions& options,
+                              const RenderProgressCallback& progressCallback,
+                              std::string& error);
+
+    /**
+     * 解冻：恢复原来的插件节点和连接，删除渲染文件
+     * @param graph 实时音频图
+     * @param playerNodeID 冻结时返回的播放节点ID
+     * @param error 失败时的错误信息
+     */
+    bool unfreeze(AudioGraph::GraphAudioProcessor& graph, AudioGraph::NodeID playerNodeID, std::string& error);
+
+    /**
+     * 是否是冻结播放节点
+     */
+    bool isFrozen(AudioGraph::NodeID playerNodeID) const;
+
+    /**
+     * 获取所有冻结信息
+     */
+    std::vector<FrozenChainInfo> getFrozenChains() const;
+
+    /**
+     * 把图快照中的冻结播放节点展开为被冻结的插件节点和连接（用于离线渲染完整图）
+     */
+    void expandFrozenChains(const AudioGraph::GraphAudioProcessor& graph, AudioGraph::GraphSnapshot& snapshot) const;
+
+private:
+    //==============================================================================
+    // 内部类型
+    //==============================================================================
+
+    struct FrozenChain {
+        FrozenChainInfo info;
+        AudioGraph::GraphSnapshot subgraph;                                 // 被冻结节点的快照和连接
+        std::vector<juce::AudioProcessorGraph::Node::Ptr> retainedNodes;   // 保留的插件节点（卸载时为空）
+        juce::File renderFile;
+    };
+
+    //==============================================================================
+    // 内部方法
+    //==============================================================================
+
+    /**
+     * 生成渲染用的图快照：外部输出映射到I/O输出节点
+     * 渲染只能读取音频文件，冻结节点的输入必须直接来自音频图的I/O输入节点
+     * @return 有输入来自冻结范围外的其他节点时返回false并设置error
+     */
+    static bool createRenderSnapshot(const AudioGraph::GraphSnapshot& subgraph,
+                                     AudioGraph::GraphSnapshot& renderSnapshot,
+                                     std::string& error);
+
+    juce::File createRenderFile(const FreezeOptions& options) const;
+
+    //==============================================================================
+    // 内部成员变量
+    //==============================================================================
+
+    std::shared_ptr<juce::AudioFormatManager> formatManager;
+    AudioGraph::PluginInstanceFactory pluginFactory;
+    std::shared_ptr<Core::AudioClipCache> clipCache;
+
+    std::mutex operationMutex;          // 冻结和解冻依次进行（冻结渲染期间持有）
+    mutable std::mutex chainsMutex;     // 保护冻结记录，查询不必等待渲染
+    std::vector<FrozenChain> frozenChains;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(FreezeManager)
+};
+
+} // namespace WindsynthVST::Engine::Render
@@ -0,0 +1,202 @@
+//
+//  LoudnessMeter.cpp
+//  WindsynthRecorder
+//
+//  Created by AI Assistant
+//  EBU R128 / ITU-R BS.1770 积分响度测量实现
+//
+
+#include "LoudnessMeter.hpp"
+#include <cmath>
+#include <limits>
+#include <algorithm>
+
+namespace WindsynthVST::Engine::Render {
+
+namespace {
+    constexpr double absoluteGateLUFS = -70.0;
+    constexpr double relativeGateLU = -10.0;
+    constexpr double loudnessOffset = -0.691;
+
+    double powerToLoudness(double power) {
+        return power > 0.0 ? loudnessOffset + 10.0 * std::log10(power)
+                           : -std::numeric_limits<double>::infinity();
+    }
+
+    double loudnessToPower(double loudness) {
+        return std::pow(10.0, (loudness - loudnessOffset) / 10.0);
+    }
+
+    /**
+     * 平方和（四路累加，便于编译器向量化）
+     */
+    double sumOfSquares(const float* data, int numSamples) {
+        float acc0 = 0.0f, acc1 = 0.0f, acc2 = 0.0f, acc3 = 0.0f;
+        int i = 0;
+        for (; i + 4 <= numSamples; i += 4) {
+            acc0 += data[i] * data[i];
+            acc1 += data[i + 1] * data[i + 1];
+            acc2 += data[i + 2] * data[i + 2];
+            acc3 += data[i + 3] * data[i + 3];
+        }
+        double sum = static_cast<double>(acc0) + acc1 + acc2 + acc3;
+        for (; i < numSamples; ++i) {
+            sum += static_cast<double>(data[i]) * data[i];
+        }
+        return sum;
+    }
+}
+
+//==============================================================================
+// 准备和重置
+//==============================================================================
+
+void LoudnessMeter::prepare(double sampleRate, int channels, int64_t expectedLengthSamples) {
+    numChannels = std::max(1, channels);
+    segmentLength = std::max(1, static_cast<int>(std::round(sampleRate * 0.1)));
+
+    // BS.1770 K 加权第一级：高架滤波器
+    {
+        const double f0 = 1681.974450955533;
+        const double gainDb = 3.999843853973347;
+        const double q = 0.7071752369554196;
+        const double k = std::tan(juce::MathConstants<double>::pi * f0 / sampleRate);
+        const double vh = std::pow(10.0, gainDb / 20.0);
+        const double vb = std::pow(vh, 0.4996667741545416);
+        const double a0 = 1.0 + k / q + k * k;
+
+        shelfFilter.b0 = (vh + vb * k / q + k * k) / a0;
+        shelfFilter.b1 = 2.0 * (k * k - vh) / a0;
+        shelfFilter.b2 = (vh - vb * k / q + k * k) / a0;
+        shelfFilter.a1 = 2.0 * (k * k - 1.0) / a0;
+        shelfFilter.a2 = (1.0 - k / q + k * k) / a0;
+    }
+
+    // 第二级：高通滤波器
+    {
+        const double f0 = 38.13547087602444;
+        const double q = 0.5003270373238773;
+        const double k = std::tan(juce::MathConstants<double>::pi * f0 / sampleRate);
+        const double a0 = 1.0 + k / q + k * k;
+
+        highPassFilter.b0 = 1.0;
+        highPassFilter.b1 = -2.0;
+        highPassFilter.b2 = 1.0;
+        highPassFilter.a1 = 2.0 * (k * k - 1.0) / a0;
+        highPassFilter.a2 = (1.0 - k / q + k * k) / a0;
+    }
+
+    channelStates.assign(static_cast<size_t>(numChannels), {});
+    filteredScratch.assign(static_cast<size_t>(segmentLength), 0.0f);
+
+    segmentPowers.clear();
+    if (expectedLengthSamples > 0) {
+        segmentPowers.reserve(static_cast<size_t>(expectedLengthSamples / segmentLength + 64));
+    }
+
+    reset();
+}
+
+void LoudnessMeter::reset() {
+    for (auto& states : channelStates) {
+        states = {};
+    }
+    samplesInSegment = 0;
+    segmentSumOfSquares = 0.0;
+    segmentPowers.clear();
+}
+
+//==============================================================================
+// 测量
+//==============================================================================
+
+void LoudnessMeter::process(const juce::AudioBuffer<float>& buffer, int channelsToMeasure, int numSamples) {
+    if (segmentLength == 0) {
+        return;
+    }
+
+    const int channels = std::min({ channelsToMeasure, numChannels, buffer.getNumChannels() });
+    int position = 0;
+
+    // 按 100ms 段边界分割，使每段的均方值可以独立记录
+    while (position < numSamples) {
+        const int samplesThisSegment = std::min(numSamples - position, segmentLength - samplesInSegment);
+
+        for (int channel = 0; channel < channels; ++channel) {
+            segmentSumOfSquares += filterAndSumSquares(buffer.getReadPointer(channel, position),
+                                                       channel, samplesThisSegment);
+        }
+
+        samplesInSegment += samplesThisSegment;
+        position += samplesThisSegment;
+
+        if (samplesInSegment == segmentLength) {
+            segmentPowers.push_back(segmentSumOfSquares / segmentLength);
+            segmentSumOfSquares = 0.0;
+            samplesInSegment = 0;
+        }
+    }
+}
+
+double LoudnessMeter::filterAndSumSquares(const float* input, int channel, int numSamples) {
+    auto& states = channelStates[static_cast<size_t>(channel)];
+    auto& shelf = states[0];
+    auto& highPass = states[1];
+    float* output = filteredScratch.data();
+
+    for (int i = 0; i < numSamples; ++i) {
+        const double x = input[i];
+
+        const double y1 = shelfFilter.b0 * x + shelf.z1;
+        shelf.z1 = shelfFilter.b1 * x - shelfFilter.a1 * y1 + shelf.z2;
+        shelf.z2 = shelfFilter.b2 * x - shelfFilter.a2 * y1;
+
+        const double y2 = highPassFilter.b0 * y1 + highPass.z1;
+        highPass.z1 = highPassFilter.b1 * y1 - highPassFilter.a1 * y2 + highPass.z2;
+        highPass.z2 = highPassFilter.b2 * y1 - highPassFilter.a2 * y2;
+
+        output[i] = static_cast<float>(y2);
+    }
+
+    return sumOfSquares(output, numSamples);
+}
+
+double LoudnessMeter::getIntegratedLoudness() const {
+    if (segmentPowers.size() < 4) {
+        return -std::numeric_limits<double>::infinity();
+    }
+
+    // 400ms 门限块（4 个 100ms 段，步长 100ms）
+    const size_t numBlocks = segmentPowers.size() - 3;
+    std::vector<double> blockPowers(numBlocks);
+    for (size_t i = 0; i < numBlocks; ++i) {
+        blockPowers[i] = (segmentPowers[i] + segmentPowers[i + 1] +
+                          segmentPowers[i + 2] + segmentPowers[i + 3]) * 0.25;
+    }
+
+    auto gatedMean = [&blockPowers](double threshold) {
+        double sum = 0.0;
+        size_t count = 0;
+        for (double power : blockPowers) {
+            if (power > threshold) {
+                sum += power;
+                ++count;
+            }
+        }
+        return count > 0 ? sum / static_cast<double>(count) : 0.0;
+    };
+
+    // 绝对门限
+    const double absoluteThreshold = loudnessToPower(absoluteGateLUFS);
+    const double absoluteMean = gatedMean(absoluteThreshold);
+    if (absoluteMean <= 0.0) {
+        return -std::numeric_limits<double>::infinity();
+    }
+
+    // 相对门限
+    const double relativeThreshold = std::max(absoluteThreshold,
+                                              absoluteMean * std::pow(10.0, relativeGateLU / 10.0));
+    return powerToLoudness(gatedMean(relativeThreshold));
+}
+
+} // namespace WindsynthVST::Engine::Render
@@ -0,0 +1,89 @@
+//
+//  LoudnessMeter.hpp
+//  WindsynthRecorder
+//
+//  Created by AI Assistant
+//  EBU R128 / ITU-R BS.1770 积分响度测量
+//
+
+#pragma once
+
+#include <JuceHeader.h>
+#include <array>
+#include <vector>
+#include <cstdint>
+
+namespace WindsynthVST::Engine::Render {
+
+/**
+ * 积分响度测量器（EBU R128 / ITU-R BS.1770）
+ *
+ * - K 加权滤波（高架 + 高通两级双二阶滤波器，按采样率计算系数）
+ * - 以 100ms 为单位累积均方值，组成 400ms、75% 重叠的门限块
+ * - 绝对门限 -70 LUFS，相对门限 -10 LU
+ *
+ * 门限计算在块功率数组上整体进行，测量过程中不分配内存（预留容量足够时）。
+ * 所有声道权重均为 1.0，适用于单声道和立体声。
+ */
+class LoudnessMeter {
+public:
+    LoudnessMeter() = default;
+
+    /**
+     * 准备测量
+     * @param sampleRate 采样率
+     * @param numChannels 声道数
+     * @param expectedLengthSamples 预计测量长度（用于预留内存，可为0）
+     */
+    void prepare(double sampleRate, int numChannels, int64_t expectedLengthSamples = 0);
+
+    /**
+     * 重置测量状态
+     */
+    void reset();
+
+    /**
+     * 累积一段音频
+     * @param buffer 音频缓冲区
+     * @param numChannels 参与测量的声道数
+     * @param numSamples 采样数
+     */
+    void process(const juce::AudioBuffer<float>& buffer, int numChannels, int numSamples);
+
+    /**
+     * 获取积分响度
+     * @return LUFS，信号全部低于门限时返回负无穷
+     */
+    double getIntegratedLoudness() const;
+
+private:
+    /**
+     * 双二阶滤波器系数（a0 已归一化）
+     */
+    struct BiquadCoefficients {
+        double b0 = 1.0, b1 = 0.0, b2 = 0.0;
+        double a1 = 0.0, a2 = 0.0;
+    };
+
+    /**
+     * 转置直接II型滤波器状态
+     */
+    struct BiquadState {
+        double z1 = 0.0, z2 = 0.0;
+    };
+
+    BiquadCoefficients shelfFilter;
+    BiquadCoefficients highPassFilter;
+    std::vector<std::array<BiquadState, 2>> channelStates;
+    std::vector<float> filteredScratch;
+
+    int numChannels = 0;
+    int segmentLength = 0;          // 100ms 对应的采样数
+    int samplesInSegment = 0;
+    double segmentSumOfSquares = 0.0;
+    std::vector<double> segmentPowers;
+
+    double filterAndSumSquares(const float* input, int channel, int numSamples);
+};
+
+} // namespace WindsynthVST::Engine::Render
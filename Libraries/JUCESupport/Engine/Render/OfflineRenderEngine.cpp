@@ -0,0 +1,916 @@
+//
+//  OfflineRenderEngine.cpp
+//  WindsynthRecorder
+//
+//  Created by AI Assistant
+//  多线程流水线离线渲染引擎实现
+//
+
+#include "OfflineRenderEngine.hpp"
+#include "LoudnessMeter.hpp"
+#include "AudioGraph/Core/Logger.hpp"
+#include <algorithm>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <deque>
+#include <cmath>
+
+namespace WindsynthVST::Engine::Render {
+
+//==============================================================================
+// 内部流水线组件
+//==============================================================================
+
+namespace {
+
+    /**
+     * 有界阻塞队列（仅用于离线渲染的非实时线程之间）
+     */
+    template <typename T>
+    class BoundedQueue {
+    public:
+        explicit BoundedQueue(size_t capacity) : capacity(capacity) {}
+
+        /** 写入元素，队列满时阻塞；队列关闭后返回false */
+        bool push(T item) {
+            std::unique_lock<std::mutex> lock(mutex);
+            notFull.wait(lock, [this] { return closed || items.size() < capacity; });
+            if (closed) {
+                return false;
+            }
+            items.push_back(std::move(item));
+            notEmpty.notify_one();
+            return true;
+        }
+
+        /** 读取元素，队列空时阻塞；队列关闭且为空时返回false */
+        bool pop(T& item) {
+            std::unique_lock<std::mutex> lock(mutex);
+            notEmpty.wait(lock, [this] { return closed || !items.empty(); });
+            if (items.empty()) {
+                return false;
+            }
+            item = std::move(items.front());
+            items.pop_front();
+            notFull.notify_one();
+            return true;
+        }
+
+        /** 关闭队列，唤醒所有等待的线程 */
+        void close() {
+            std::lock_guard<std::mutex> lock(mutex);
+            closed = true;
+            notEmpty.notify_all();
+            notFull.notify_all();
+        }
+
+    private:
+        const size_t capacity;
+        std::deque<T> items;
+        bool closed = false;
+        std::mutex mutex;
+        std::condition_variable notEmpty;
+        std::condition_variable notFull;
+    };
+
+    /**
+     * 预分配的音频块
+     */
+    struct AudioBlock {
+        juce::AudioBuffer<float> buffer;
+        int numSamples = 0;
+    };
+
+    /**
+     * 将音频块写入异步写入器，写入缓冲区满时等待写入线程腾出空间
+     */
+    bool writeToThreadedWriter(juce::AudioFormatWriter::ThreadedWriter& writer,
+                               const juce::AudioBuffer<float>& buffer,
+                               int numSamples,
+                               const std::atomic<bool>& cancelled) {
+        while (!writer.write(buffer.getArrayOfReadPointers(), numSamples)) {
+            if (cancelled.load()) {
+                return false;
+            }
+            juce::Thread::sleep(1);
+        }
+        return true;
+    }
+
+    /**
+     * 重分块FIFO：把任意长度的输入整理成固定长度的块送入音频图
+     *
+     * 输出比输入延迟一个块，调用方丢弃开头 getLatency() 个采样，并在输入结束后补零冲刷。
+     */
+    class ReblockingFifo {
+    public:
+        ReblockingFifo(int numChannels, int blockSize)
+            : blockSize(std::max(1, blockSize)),
+              input(numChannels, this->blockSize),
+              output(numChannels, this->blockSize)
+        {
+            input.clear();
+            output.clear();
+        }
+
+        int getLatency() const { return blockSize; }
+
+        /** 原地处理：写入 numSamples 个输入采样，同时取出相同数量的（延迟的）输出采样 */
+        void process(AudioGraph::GraphAudioProcessor& processor,
+                     juce::AudioBuffer<float>& buffer,
+                     int numSamples,
+                     juce::MidiBuffer& midiBuffer) {
+            const int numChannels = std::min(buffer.getNumChannels(), input.getNumChannels());
+            int offset = 0;
+
+            while (offset < numSamples) {
+                const int samplesThisPass = std::min(numSamples - offset, blockSize - position);
+                for (int channel = 0; channel < numChannels; ++channel) {
+                    input.copyFrom(channel, position, buffer, channel, offset, samplesThisPass);
+                    buffer.copyFrom(channel, offset, output, channel, position, samplesThisPass);
+                }
+
+                position += samplesThisPass;
+                offset += samplesThisPass;
+
+                if (position == blockSize) {
+                    midiBuffer.clear();
+                    processor.processBlock(input, midiBuffer);
+                    std::swap(input, output);
+                    position = 0;
+                }
+            }
+        }
+
+    private:
+        const int blockSize;
+        int position = 0;
+        juce::AudioBuffer<float> input;     // 正在填充的输入块
+        juce::AudioBuffer<float> output;    // 上一个处理完成的块
+    };
+
+    float getPeakLevel(const juce::AudioBuffer<float>& buffer, int numChannels, int numSamples) {
+        float peak = 0.0f;
+        for (int channel = 0; channel < numChannels; ++channel) {
+            peak = std::max(peak, buffer.getMagnitude(channel, 0, numSamples));
+        }
+        return peak;
+    }
+
+} // namespace
+
+//==============================================================================
+// 构造函数和析构函数
+//==============================================================================
+
+OfflineRenderEngine::OfflineRenderEngine(std::shared_ptr<juce::AudioFormatManager> formatManager,
+                                         const Options& options)
+    : formatManager(std::move(formatManager)), options(options)
+{
+    this->options.blockSize = juce::jlimit(minBlockSize, maxBlockSize, this->options.blockSize);
+    this->options.readAheadBlocks = std::max(2, this->options.readAheadBlocks);
+    this->options.writeBufferSamples = std::max(this->options.blockSize * 2, this->options.writeBufferSamples);
+}
+
+OfflineRenderEngine::~OfflineRenderEngine() = default;
+
+//==============================================================================
+// 单文件渲染
+//==============================================================================
+
+RenderResult OfflineRenderEngine::renderFile(const RenderJob& job,
+                                             AudioGraph::GraphAudioProcessor* processor,
+                                             bool processThroughGraph,
+                                             bool prepareProcessor,
+                                             const RenderProgressCallback& progressCallback) {
+    RenderResult result;
+    result.inputPath = job.inputPath;
+    result.outputPath = job.outputPath;
+
+    const auto& settings = job.settings;
+    const double startTime = juce::Time::getMillisecondCounterHiRes();
+
+    WSLOG_INFO("OfflineRenderEngine", "开始渲染: " << job.inputPath << " -> " << job.outputPath);
+
+    // 检查输入文件是否存在
+    juce::File inputFile(job.inputPath);
+    if (!inputFile.existsAsFile()) {
+        result.error = "输入文件不存在: " + job.inputPath;
+        return result;
+    }
+
+    // 检查输出目录是否存在
+    juce::File outputFile(job.outputPath);
+    juce::File outputDir = outputFile.getParentDirectory();
+    if (!outputDir.exists()) {
+        outputDir.createDirectory();
+    }
+
+    if (!formatManager) {
+        result.error = "音频格式管理器无效";
+        return result;
+    }
+
+    // 创建输入文件读取器（有片段缓存时优先使用内存映射或已解码的数据）
+    std::unique_ptr<juce::AudioFormatReader> reader(clipCache ? clipCache->createReader(inputFile)
+                                                              : std::unique_ptr<juce::AudioFormatReader>(formatManager->createReaderFor(inputFile)));
+    if (!reader) {
+        result.error = "无法读取输入文件: " + job.inputPath;
+        return result;
+    }
+
+    // 使用原始音频的采样率
+    const double renderSampleRate = reader->sampleRate;
+    result.sampleRate = renderSampleRate;
+
+    // 获取音频信息
+    const int64_t totalSamples = reader->lengthInSamples;
+    const int readerChannels = static_cast<int>(reader->numChannels);
+    const int numChannels = std::min(readerChannels, settings.numChannels);
+    const int renderChannels = std::max(numChannels, settings.numChannels);
+    const int blockSize = options.blockSize;
+
+    // 归一化时第一遍写入32位浮点临时文件，第二遍再施加增益并转换为目标格式，
+    // 这样不需要再次通过插件链处理
+    const bool twoPassNormalization = settings.normalizeOutput;
+    const bool measureLoudness = twoPassNormalization &&
+        settings.normalizationMode == RenderSettings::NormalizationMode::Loudness;
+    juce::File spillFile;
+
+    std::unique_ptr<juce::AudioFormatWriter> writer;
+    if (twoPassNormalization) {
+        spillFile = juce::File::getSpecialLocation(juce::File::tempDirectory)
+                        .getNonexistentChildFile("WindsynthRender", ".wav");
+        writer = createWriter(spillFile, RenderSettings::Format::WAV, renderSampleRate,
+                              renderChannels, 32, result.error);
+    } else {
+        writer = createWriter(outputFile, settings.format, renderSampleRate,
+                              settings.numChannels, settings.bitDepth, result.error);
+    }
+
+    if (!writer) {
+        return result;
+    }
+
+    LoudnessMeter loudnessMeter;
+    if (measureLoudness) {
+        loudnessMeter.prepare(renderSampleRate, renderChannels, totalSamples);
+    }
+
+    WSLOG_INFO("OfflineRenderEngine", "渲染配置 - 采样率: " << renderSampleRate
+            << "Hz, 总样本数: " << totalSamples
+            << ", 输入声道: " << numChannels
+            << ", 输出声道: " << renderChannels
+            << ", 块大小: " << blockSize);
+
+    if (processor == nullptr) {
+        processThroughGraph = false;
+    }
+
+    // 独立的图实例按输入文件重新准备；共享的实时图只在未就绪时准备
+    if (processor != nullptr) {
+        const auto& graphConfig = processor->getConfig();
+        const bool configMismatch = graphConfig.sampleRate != renderSampleRate ||
+                                    graphConfig.samplesPerBlock != blockSize;
+        if (!processor->isGraphReady() || (prepareProcessor && configMismatch)) {
+            processor->prepareToPlay(renderSampleRate, blockSize);
+        }
+    }
+
+    WSLOG_INFO("OfflineRenderEngine", "VST处理模式: " << (processThroughGraph ? "启用" : "禁用"));
+
+    // 异步写入阶段
+    juce::TimeSliceThread writerThread("Offline Render Writer");
+    writerThread.startThread(options.writerPriority);
+    auto threadedWriter = std::make_unique<juce::AudioFormatWriter::ThreadedWriter>(
+        writer.release(), writerThread, options.writeBufferSamples);
+
+    // 预分配音频块池
+    std::vector<std::unique_ptr<AudioBlock>> blockPool;
+    BoundedQueue<AudioBlock*> freeBlocks(static_cast<size_t>(options.readAheadBlocks));
+    BoundedQueue<AudioBlock*> filledBlocks(static_cast<size_t>(options.readAheadBlocks));
+
+    for (int i = 0; i < options.readAheadBlocks; ++i) {
+        auto block = std::make_unique<AudioBlock>();
+        block->buffer.setSize(renderChannels, blockSize);
+        freeBlocks.push(block.get());
+        blockPool.push_back(std::move(block));
+    }
+
+    // 解码阶段：预读输入文件
+    std::atomic<bool> readFailed{false};
+    std::thread readerThread([&] {
+        int64_t readPosition = 0;
+
+        while (readPosition < totalSamples && !cancelled.load()) {
+            AudioBlock* block = nullptr;
+            if (!freeBlocks.pop(block)) {
+                break;
+            }
+
+            const int samplesToRead = static_cast<int>(std::min(static_cast<int64_t>(blockSize),
+                                                                totalSamples - readPosition));
+            block->buffer.setSize(renderChannels, samplesToRead, false, false, true);
+
+            if (!reader->read(&block->buffer, 0, samplesToRead, readPosition, true, true)) {
+                WSLOG_WARNING("OfflineRenderEngine", "警告：读取音频数据失败，位置: " << readPosition);
+                readFailed.store(true);
+                break;
+            }
+
+            // 声道转换：多出的输出声道复制输入的最后一个声道
+            for (int channel = readerChannels; channel < renderChannels; ++channel) {
+                block->buffer.copyFrom(channel, 0, block->buffer, readerChannels - 1, 0, samplesToRead);
+            }
+
+            block->numSamples = samplesToRead;
+            readPosition += samplesToRead;
+
+            if (!filledBlocks.push(block)) {
+                break;
+            }
+        }
+
+        filledBlocks.close();
+    });
+
+    // 处理阶段：在调用线程中原地处理音频块
+    juce::MidiBuffer midiBuffer;
+    midiBuffer.ensureSize(AudioGraph::Constants::MIDI_BUFFER_RESERVE_BYTES);
+
+    // 固定块处理时输出延迟一个图块长，开头的延迟不写入输出
+    std::unique_ptr<ReblockingFifo> reblockingFifo;
+    int samplesToDiscard = 0;
+    if (processThroughGraph && options.fixedSizeBlocks) {
+        reblockingFifo = std::make_unique<ReblockingFifo>(renderChannels, processor->getConfig().samplesPerBlock);
+        samplesToDiscard = reblockingFifo->getLatency();
+    }
+
+    auto runGraph = [&](juce::AudioBuffer<float>& buffer, int numSamples) {
+        if (reblockingFifo) {
+            reblockingFifo->process(*processor, buffer, numSamples, midiBuffer);
+        } else {
+            processThroughGraphInChunks(*processor, buffer, numSamples, midiBuffer);
+        }
+    };
+
+    int64_t samplesProcessed = 0;
+    int64_t samplesConsumed = 0;
+    float maxLevel = 0.0f;
+    const float firstPassProgressScale = twoPassNormalization ? 0.9f : 1.0f;
+    int lastReportedPercent = -1;
+    bool writeFailed = false;
+
+    // 测量并写入处理后的采样（跳过重分块FIFO的延迟）
+    auto emitProcessed = [&](juce::AudioBuffer<float>& buffer, int numSamples) {
+        const int discarded = std::min(samplesToDiscard, numSamples);
+        samplesToDiscard -= discarded;
+
+        const int samplesToWrite = numSamples - discarded;
+        if (samplesToWrite <= 0) {
+            return true;
+        }
+
+        // 引用原缓冲区的一段，不复制数据
+        juce::AudioBuffer<float> output(buffer.getArrayOfWritePointers(), renderChannels, discarded, samplesToWrite);
+
+        // 测量所有输出声道：单声道输入渲染为立体声时，插件可能在新增的声道上产生内容
+        maxLevel = std::max(maxLevel, getPeakLevel(output, renderChannels, samplesToWrite));
+        if (measureLoudness) {
+            loudnessMeter.process(output, renderChannels, samplesToWrite);
+        }
+
+        samplesProcessed += samplesToWrite;
+        return writeToThreadedWriter(*threadedWriter, output, samplesToWrite, cancelled);
+    };
+
+    AudioBlock* block = nullptr;
+    while (filledBlocks.pop(block)) {
+        const int numSamples = block->numSamples;
+
+        if (processThroughGraph) {
+            try {
+                runGraph(block->buffer, numSamples);
+            } catch (const std::exception& e) {
+                // 如果VST处理失败，继续使用原始音频
+                WSLOG_WARNING("OfflineRenderEngine", "VST处理异常: " << e.what());
+            }
+        }
+
+        if (!emitProcessed(block->buffer, numSamples)) {
+            writeFailed = true;
+        }
+
+        samplesConsumed += numSamples;
+        freeBlocks.push(block);
+
+        if (writeFailed || cancelled.load()) {
+            break;
+        }
+
+        if (throttleCallback) {
+            throttleCallback();
+        }
+
+        // 更新进度
+        if (progressCallback && totalSamples > 0) {
+            float progress = static_cast<float>(samplesConsumed) / static_cast<float>(totalSamples);
+            int percent = static_cast<int>(progress * 100);
+            if (percent != lastReportedPercent) {
+                lastReportedPercent = percent;
+                progressCallback(progress * firstPassProgressScale, "处理中... " + std::to_string(percent) + "%");
+            }
+        }
+    }
+
+    // 停止解码阶段
+    freeBlocks.close();
+    filledBlocks.close();
+    readerThread.join();
+
+    // 补零冲刷重分块FIFO中剩余的一个块，使输出与输入等长
+    if (reblockingFifo && !cancelled.load() && !writeFailed && !readFailed.load()) {
+        auto& flushBuffer = blockPool.front()->buffer;
+        int samplesToFlush = reblockingFifo->getLatency();
+
+        while (samplesToFlush > 0 && !writeFailed) {
+            const int samplesThisPass = std::min(samplesToFlush, blockSize);
+            flushBuffer.setSize(renderChannels, samplesThisPass, false, false, true);
+            flushBuffer.clear();
+
+            try {
+                runGraph(flushBuffer, samplesThisPass);
+            } catch (const std::exception& e) {
+                WSLOG_WARNING("OfflineRenderEngine", "VST处理异常: " << e.what());
+            }
+
+            writeFailed = !emitProcessed(flushBuffer, samplesThisPass);
+            samplesToFlush -= samplesThisPass;
+        }
+    }
+
+    WSLOG_INFO("OfflineRenderEngine", "音频处理完成，最大电平: " << maxLevel);
+
+    // 处理插件尾音（如果启用）
+    if (settings.includePluginTails && processor != nullptr && processor->isGraphReady() &&
+        !cancelled.load() && !writeFailed) {
+        WSLOG_INFO("OfflineRenderEngine", "处理插件尾音");
+
+        // 计算尾音长度上限（使用渲染采样率）
+        const bool detectSilence = settings.tailMode == RenderSettings::TailMode::SilenceDetection;
+        const double maxTailSeconds = std::max(0.0, static_cast<double>(settings.maxTailSeconds));
+        double tailSeconds = maxTailSeconds;
+        if (!detectSilence) {
+            // 图报告的尾音长度（无限尾音的插件会被上限截断）
+            tailSeconds = juce::jlimit(0.0, maxTailSeconds, processor->getTailLengthSeconds());
+        }
+
+        const int64_t tailSamples = static_cast<int64_t>(renderSampleRate * tailSeconds);
+        const float silenceThreshold = juce::Decibels::decibelsToGain(settings.tailSilenceThresholdDb);
+        const int silenceHoldSamples = std::max(1, static_cast<int>(renderSampleRate * settings.tailSilenceHoldMs / 1000.0));
+        int64_t tailSamplesProcessed = 0;
+        int64_t tailSamplesWritten = 0;
+        auto& tailBuffer = blockPool.front()->buffer;
+
+        // 低于门限的块先暂存：尾音恢复时补写，静音持续够长时直接丢弃，文件结尾不会带着判定用的静音
+        juce::AudioBuffer<float> heldSilence;
+        int heldSamples = 0;
+        if (detectSilence) {
+            heldSilence.setSize(renderChannels, silenceHoldSamples + blockSize);
+        }
+
+        WSLOG_INFO("OfflineRenderEngine", "尾音模式: " << (detectSilence ? "静音检测" : "图报告长度")
+                << "，最长 " << tailSeconds << " 秒");
+
+        while (tailSamplesProcessed < tailSamples && !cancelled.load()) {
+            const int samplesToProcess = static_cast<int>(std::min(static_cast<int64_t>(blockSize),
+                                                                   tailSamples - tailSamplesProcessed));
+
+            // 静音输入
+            tailBuffer.setSize(renderChannels, samplesToProcess, false, false, true);
+            tailBuffer.clear();
+
+            try {
+                runGraph(tailBuffer, samplesToProcess);
+            } catch (const std::exception& e) {
+                WSLOG_WARNING("OfflineRenderEngine", "插件尾音处理异常: " << e.what());
+                break; // 如果尾音处理失败，停止尾音渲染
+            }
+
+            tailSamplesProcessed += samplesToProcess;
+
+            if (throttleCallback) {
+                throttleCallback();
+            }
+
+            if (detectSilence) {
+                if (getPeakLevel(tailBuffer, renderChannels, samplesToProcess) < silenceThreshold) {
+                    for (int channel = 0; channel < renderChannels; ++channel) {
+                        heldSilence.copyFrom(channel, heldSamples, tailBuffer, channel, 0, samplesToProcess);
+                    }
+                    heldSamples += samplesToProcess;
+
+                    // 输出低于门限持续 tailSilenceHoldMs 时认为尾音已结束
+                    if (heldSamples >= silenceHoldSamples) {
+                        break;
+                    }
+                    continue;
+                }
+
+                if (heldSamples > 0) {
+                    if (!emitProcessed(heldSilence, heldSamples)) {
+                        writeFailed = true;
+                        break;
+                    }
+                    tailSamplesWritten += heldSamples;
+                    heldSamples = 0;
+                }
+            }
+
+            if (!emitProcessed(tailBuffer, samplesToProcess)) {
+                writeFailed = true;
+                break;
+            }
+            tailSamplesWritten += samplesToProcess;
+        }
+
+        // 达到尾音上限或取消时仍暂存的块都低于门限，同样丢弃
+        result.tailSamplesWritten = tailSamplesWritten;
+        WSLOG_INFO("OfflineRenderEngine", "尾音处理完成，长度: "
+                << static_cast<double>(tailSamplesWritten) / renderSampleRate << " 秒");
+    }
+
+    // 销毁写入器会等待剩余数据写入磁盘并关闭文件
+    threadedWriter.reset();
+    writerThread.stopThread(1000);
+
+    result.peakLevel = maxLevel;
+
+    // 第二遍：从临时文件施加归一化增益并写入目标格式
+    if (twoPassNormalization) {
+        if (measureLoudness) {
+            result.integratedLoudness = loudnessMeter.getIntegratedLoudness();
+        }
+        result.appliedGain = computeNormalizationGain(settings, maxLevel, result.integratedLoudness);
+
+        if (!cancelled.load() && !readFailed.load() && !writeFailed) {
+            WSLOG_INFO("OfflineRenderEngine", "应用归一化，峰值: " << maxLevel
+                    << "，积分响度: " << result.integratedLoudness
+                    << " LUFS，增益: " << juce::Decibels::gainToDecibels(result.appliedGain) << " dB");
+
+            if (!writeNormalizedOutput(spillFile, outputFile, settings, renderSampleRate,
+                                       result.appliedGain, progressCallback, result.error)) {
+                writeFailed = true;
+            }
+        }
+
+        spillFile.deleteFile();
+    }
+
+    result.samplesWritten = samplesProcessed;
+    result.renderTimeSeconds = (juce::Time::getMillisecondCounterHiRes() - startTime) / 1000.0;
+    result.audioDurationSeconds = renderSampleRate > 0.0 ? static_cast<double>(samplesProcessed) / renderSampleRate : 0.0;
+    result.realtimeFactor = result.renderTimeSeconds > 0.0 ? result.audioDurationSeconds / result.renderTimeSeconds : 0.0;
+
+    if (cancelled.load()) {
+        result.cancelled = true;
+        result.error = "渲染已取消";
+        outputFile.deleteFile();
+    } else if (readFailed.load()) {
+        result.error = "读取音频数据失败: " + job.inputPath;
+    } else if (writeFailed) {
+        if (result.error.empty()) {
+            result.error = "写入音频数据失败: " + job.outputPath;
+        }
+    } else {
+        result.success = true;
+    }
+
+    WSLOG_INFO("OfflineRenderEngine", "渲染结束: " << (result.success ? "成功" : result.error)
+            << "，耗时 " << result.renderTimeSeconds << " 秒，"
+            << result.realtimeFactor << " 倍实时");
+
+    return result;
+}
+
+//==============================================================================
+// 批量渲染
+//==============================================================================
+
+std::vector<RenderResult> OfflineRenderEngine::renderBatch(const std::vector<RenderJob>& jobs,
+                                                           const AudioGraph::GraphSnapshot& snapshot,
+                                                           const AudioGraph::PluginInstanceFactory& pluginFactory,
+                                                           int maxParallelJobs,
+                                                           const BatchRenderProgressCallback& progressCallback) {
+    std::vector<RenderResult> results(jobs.size());
+    if (jobs.empty()) {
+        return results;
+    }
+
+    if (maxParallelJobs <= 0) {
+        maxParallelJobs = getRecommendedParallelJobs();
+    }
+    const int numWorkers = std::min(maxParallelJobs, static_cast<int>(jobs.size()));
+
+    WSLOG_INFO("OfflineRenderEngine", "开始批量渲染，任务数: " << jobs.size()
+            << "，并行数: " << numWorkers);
+
+    std::atomic<size_t> nextJobIndex{0};
+
+    // 每个工作线程持有独立的图实例，依次领取任务
+    auto worker = [&] {
+        std::unique_ptr<AudioGraph::GraphAudioProcessor> graphInstance;
+        std::string graphError;
+
+        if (snapshot.hasPlugins()) {
+            graphInstance = createGraphInstance(snapshot, pluginFactory,
+                                                snapshot.config.sampleRate, options.blockSize, graphError);
+        }
+
+        for (;;) {
+            const size_t jobIndex = nextJobIndex.fetch_add(1);
+            if (jobIndex >= jobs.size()) {
+                break;
+            }
+
+            const auto& job = jobs[jobIndex];
+            auto& result = results[jobIndex];
+
+            if (cancelled.load()) {
+                result.inputPath = job.inputPath;
+                result.outputPath = job.outputPath;
+                result.cancelled = true;
+                result.error = "渲染已取消";
+                continue;
+            }
+
+            if (snapshot.hasPlugins() && !graphInstance) {
+                result.inputPath = job.inputPath;
+                result.outputPath = job.outputPath;
+                result.error = "无法创建音频图实例: " + graphError;
+                continue;
+            }
+
+            RenderProgressCallback jobProgress;
+            if (progressCallback) {
+                jobProgress = [&progressCallback, jobIndex](float progress, const std::string& message) {
+                    progressCallback(static_cast<int>(jobIndex), progress, message);
+                };
+            }
+
+            try {
+                if (graphInstance) {
+                    graphInstance->reset();
+                }
+                result = renderFile(job, graphInstance.get(), graphInstance != nullptr, true, jobProgress);
+            } catch (const std::exception& e) {
+                result.inputPath = job.inputPath;
+                result.outputPath = job.outputPath;
+                result.error = "渲染异常: " + std::string(e.what());
+            } catch (...) {
+                result.inputPath = job.inputPath;
+                result.outputPath = job.outputPath;
+                result.error = "渲染异常: 未知异常";
+            }
+
+            if (progressCallback) {
+                progressCallback(static_cast<int>(jobIndex), 1.0f, result.success ? "渲染完成" : result.error);
+            }
+        }
+
+        if (graphInstance) {
+            graphInstance->releaseResources();
+        }
+    };
+
+    std::vector<std::thread> workers;
+    workers.reserve(static_cast<size_t>(numWorkers));
+    for (int i = 0; i < numWorkers; ++i) {
+        workers.emplace_back(worker);
+    }
+    for (auto& thread : workers) {
+        thread.join();
+    }
+
+    int succeeded = 0;
+    for (const auto& result : results) {
+        if (result.success) {
+            ++succeeded;
+        }
+    }
+    WSLOG_INFO("OfflineRenderEngine", "批量渲染完成，成功: " << succeeded << "/" << results.size());
+
+    return results;
+}
+
+int OfflineRenderEngine::getRecommendedParallelJobs() {
+    // 保留一个核心给实时音频和UI
+    return std::max(1, juce::SystemStats::getNumCpus() - 1);
+}
+
+//==============================================================================
+// 图实例
+//==============================================================================
+
+std::unique_ptr<AudioGraph::GraphAudioProcessor> OfflineRenderEngine::createGraphInstance(
+    const AudioGraph::GraphSnapshot& snapshot,
+    const AudioGraph::PluginInstanceFactory& pluginFactory,
+    double sampleRate,
+    int blockSize,
+    std::string& error,
+    const CancellationCheck& shouldCancel) {
+    auto graphInstance = std::make_unique<AudioGraph::GraphAudioProcessor>();
+
+    AudioGraph::GraphConfig config = snapshot.config;
+    config.sampleRate = sampleRate;
+    config.samplesPerBlock = blockSize;
+    graphInstance->configure(config);
+
+    // 插件逐个实例化，每个之前检查取消（实例化可能要等待消息线程）
+    AudioGraph::PluginInstanceFactory factory = pluginFactory;
+    if (shouldCancel && pluginFactory) {
+        factory = [&pluginFactory, &shouldCancel](const juce::PluginDescription& description, double rate,
+                                                  int size, juce::String& pluginError)
+            -> std::unique_ptr<juce::AudioPluginInstance> {
+            if (shouldCancel()) {
+                pluginError = "已取消";
+                return nullptr;
+            }
+            return pluginFactory(description, rate, size, pluginError);
+        };
+    }
+
+    if (!graphInstance->restoreGraphSnapshot(snapshot, factory, error)) {
+        return nullptr;
+    }
+
+    graphInstance->setNonRealtime(true);
+    graphInstance->prepareToPlay(sampleRate, blockSize);
+    return graphInstance;
+}
+
+//==============================================================================
+// 内部方法
+//==============================================================================
+
+std::unique_ptr<juce::AudioFormatWriter> OfflineRenderEngine::createWriter(const juce::File& outputFile,
+                                                                           RenderSettings::Format fileFormat,
+                                                                           double sampleRate,
+                                                                           int numChannels,
+                                                                           int bitDepth,
+                                                                           std::string& error) {
+    std::unique_ptr<juce::AudioFormat> format;
+    if (fileFormat == RenderSettings::Format::AIFF) {
+        format = std::make_unique<juce::AiffAudioFormat>();
+    } else {
+        format = std::make_unique<juce::WavAudioFormat>();
+    }
+
+    std::unique_ptr<juce::FileOutputStream> outputStream(outputFile.createOutputStream());
+    if (!outputStream) {
+        error = "无法创建输出文件: " + outputFile.getFullPathName().toStdString();
+        return nullptr;
+    }
+
+    // 覆盖已有文件，而不是追加到末尾
+    outputStream->setPosition(0);
+    outputStream->truncate();
+
+    std::unique_ptr<juce::AudioFormatWriter> writer(format->createWriterFor(
+        outputStream.get(),
+        sampleRate,
+        static_cast<unsigned int>(numChannels),
+        bitDepth,
+        {},
+        0
+    ));
+
+    if (!writer) {
+        error = "无法创建音频写入器";
+        return nullptr;
+    }
+
+    // 写入器已接管输出流
+    outputStream.release();
+    return writer;
+}
+
+float OfflineRenderEngine::computeNormalizationGain(const RenderSettings& settings,
+                                                    float peakLevel,
+                                                    double integratedLoudness) {
+    // 未检测到音频信号时不施加增益
+    if (peakLevel <= 0.0001f) {
+        return 1.0f;
+    }
+
+    if (settings.normalizationMode == RenderSettings::NormalizationMode::Loudness) {
+        if (!std::isfinite(integratedLoudness)) {
+            return 1.0f;
+        }
+
+        float gain = juce::Decibels::decibelsToGain(static_cast<float>(settings.targetLoudnessLUFS - integratedLoudness));
+
+        // 限制增益，避免峰值超过上限
+        const float ceiling = juce::Decibels::decibelsToGain(settings.peakCeilingDb);
+        if (peakLevel * gain > ceiling) {
+            gain = ceiling / peakLevel;
+        }
+        return gain;
+    }
+
+    return juce::Decibels::decibelsToGain(settings.targetPeakDb) / peakLevel;
+}
+
+bool OfflineRenderEngine::writeNormalizedOutput(const juce::File& spillFile,
+                                                const juce::File& outputFile,
+                                                const RenderSettings& settings,
+                                                double sampleRate,
+                                                float gain,
+                                                const RenderProgressCallback& progressCallback,
+                                                std::string& error) {
+    // 临时文件是未压缩的浮点WAV，直接内存映射读取
+    juce::WavAudioFormat wavFormat;
+    std::unique_ptr<juce::MemoryMappedAudioFormatReader> reader(wavFormat.createMemoryMappedReader(spillFile));
+    if (!reader || !reader->mapEntireFile()) {
+        error = "无法读取渲染临时文件";
+        return false;
+    }
+
+    auto writer = createWriter(outputFile, settings.format, sampleRate,
+                               settings.numChannels, settings.bitDepth, error);
+    if (!writer) {
+        return false;
+    }
+
+    juce::TimeSliceThread writerThread("Offline Render Writer");
+    writerThread.startThread(options.writerPriority);
+    auto threadedWriter = std::make_unique<juce::AudioFormatWriter::ThreadedWriter>(
+        writer.release(), writerThread, options.writeBufferSamples);
+
+    const int64_t totalSamples = reader->lengthInSamples;
+    const int blockSize = options.blockSize;
+    juce::AudioBuffer<float> buffer(static_cast<int>(reader->numChannels), blockSize);
+
+    bool success = true;
+    int lastReportedPercent = -1;
+
+    for (int64_t position = 0; position < totalSamples; position += blockSize) {
+        if (cancelled.load()) {
+            success = false;
+            break;
+        }
+
+        const int numSamples = static_cast<int>(std::min(static_cast<int64_t>(blockSize), totalSamples - position));
+        reader->read(&buffer, 0, numSamples, position, true, true);
+        buffer.applyGain(0, numSamples, gain);
+
+        if (!writeToThreadedWriter(*threadedWriter, buffer, numSamples, cancelled)) {
+            success = false;
+            break;
+        }
+
+        if (progressCallback && totalSamples > 0) {
+            float progress = static_cast<float>(position + numSamples) / static_cast<float>(totalSamples);
+            int percent = static_cast<int>(progress * 100);
+            if (percent != lastReportedPercent) {
+                lastReportedPercent = percent;
+                progressCallback(0.9f + progress * 0.1f, "归一化中... " + std::to_string(percent) + "%");
+            }
+        }
+
+        if (throttleCallback) {
+            throttleCallback();
+        }
+    }
+
+    threadedWriter.reset();
+    writerThread.stopThread(1000);
+
+    if (!success && error.empty()) {
+        error = cancelled.load() ? "渲染已取消" : "写入音频数据失败: " + outputFile.getFullPathName().toStdString();
+    }
+    return success;
+}
+
+void OfflineRenderEngine::processThroughGraphInChunks(AudioGraph::GraphAudioProcessor& processor,
+                                                      juce::AudioBuffer<float>& buffer,
+                                                      int numSamples,
+                                                      juce::MidiBuffer& midiBuffer) {
+    // 按图准备时的块大小分段处理，避免超出图的预分配容量
+    const int chunkSize = processor.getConfig().samplesPerBlock > 0
+        ? processor.getConfig().samplesPerBlock
+        : numSamples;
+
+    for (int offset = 0; offset < numSamples; offset += chunkSize) {
+        const int samplesThisChunk = std::min(chunkSize, numSamples - offset);
+
+        // 引用原缓冲区的一段，不复制数据
+        juce::AudioBuffer<float> chunk(buffer.getArrayOfWritePointers(), buffer.getNumChannels(),
+                                       offset, samplesThisChunk);
+        midiBuffer.clear();
+        processor.processBlock(chunk, midiBuffer);
+    }
+}
+
+} // namespace WindsynthVST::Engine::Render
@@ -0,0 +1,199 @@
+//
+//  OfflineRenderEngine.hpp
+//  WindsynthRecorder
+//
+//  Created by AI Assistant
+//  多线程流水线离线渲染引擎
+//
+
+#pragma once
+
+#include <JuceHeader.h>
+#include <memory>
+#include <string>
+#include <vector>
+#include <atomic>
+#include <functional>
+#include "RenderTypes.hpp"
+#include "../Core/AudioClipCache.hpp"
+#include "AudioGraph/Core/GraphAudioProcessor.hpp"
+#include "AudioGraph/Core/AudioGraphTypes.hpp"
+
+namespace WindsynthVST::Engine::Render {
+
+/**
+ * 离线渲染引擎
+ *
+ * 渲染过程分为三个并行阶段，阶段之间通过有界队列连接：
+ * - 解码线程：预读输入文件到预分配的音频块中
+ * - 处理阶段：在调用线程中通过音频图处理音频块（原地处理，无额外拷贝）
+ * - 写入线程：ThreadedWriter 在后台编码并写入磁盘
+ *
+ * 独立的图实例以较大的块（默认8192采样）在非实时模式下处理，实时音频设备的缓冲区大小不影响离线渲染；
+ * 要求固定块长的插件可通过重分块FIFO驱动，FIFO 引入的一个块的延迟在内部补偿。
+ *
+ * 启用归一化时采用两遍处理：第一遍把处理结果写入32位浮点临时文件并测量
+ * 峰值/积分响度，第二遍内存映射临时文件、施加增益并写入目标格式，插件链只运行一次。
+ *
+ * 批量渲染时，每个工作线程使用从图快照重建的独立图实例，
+ * 多个文件可并行渲染，吞吐量随CPU核心数扩展。
+ */
+class OfflineRenderEngine {
+public:
+    //==============================================================================
+    // 类型定义
+    //==============================================================================
+
+    /**
+     * 引擎选项
+     */
+    struct Options {
+        int blockSize = 8192;               // 解码/处理/写入块大小（采样数），独立图实例按此大小准备
+        int readAheadBlocks = 8;            // 预读队列容量（块数）
+        int writeBufferSamples = 65536;     // 异步写入缓冲区大小（采样数）
+        bool fixedSizeBlocks = false;       // 经重分块FIFO始终以完整的块驱动音频图（用于要求固定块长的插件）
+        juce::Thread::Priority writerPriority = juce::Thread::Priority::normal;    // 写入线程优先级
+    };
+
+    /**
+     * 节流回调：每处理完一个块在处理线程中调用一次，可在其中休眠以让出CPU
+     */
+    using ThrottleCallback = std::function<void()>;
+
+    /**
+     * 取消检查：返回true时停止创建图实例
+     */
+    using CancellationCheck = std::function<bool()>;
+
+    static constexpr int minBlockSize = 64;
+    static constexpr int maxBlockSize = 16384;
+
+    //==============================================================================
+    // 构造函数和析构函数
+    //==============================================================================
+
+    /**
+     * 构造函数
+     * @param formatManager 音频格式管理器（用于创建输入文件读取器）
+     * @param options 引擎选项
+     */
+    explicit OfflineRenderEngine(std::shared_ptr<juce::AudioFormatManager> formatManager,
+                                 const Options& options = Options());
+
+    ~OfflineRenderEngine();
+
+    /**
+     * 设置共享片段缓存（设置后输入文件通过缓存读取，重复渲染同一文件时无需重新解码）
+     */
+    void setClipCache(std::shared_ptr<Core::AudioClipCache> cache) { clipCache = std::move(cache); }
+
+    /**
+     * 设置节流回调（后台渲染时用于避免与实时音频回调争抢CPU）
+     */
+    void setThrottleCallback(ThrottleCallback callback) { throttleCallback = std::move(callback); }
+
+    //==============================================================================
+    // 渲染接口
+    //==============================================================================
+
+    /**
+     * 渲染单个文件
+     * @param job 渲染任务
+     * @param processor 用于处理的音频图（可为空，此时只做格式转换）
+     * @param processThroughGraph 是否通过音频图处理
+     * @param prepareProcessor 是否按输入文件采样率重新准备音频图（仅用于独立的图实例）
+     * @param progressCallback 进度回调（在调用线程中调用）
+     * @return 渲染结果
+     */
+    RenderResult renderFile(const RenderJob& job,
+                            AudioGraph::GraphAudioProcessor* processor,
+                            bool processThroughGraph,
+                            bool prepareProcessor,
+                            const RenderProgressCallback& progressCallback = nullptr);
+
+    /**
+     * 并行批量渲染
+     * @param jobs 渲染任务列表
+     * @param snapshot 图快照（每个工作线程据此重建独立的图实例）
+     * @param pluginFactory 插件实例工厂
+     * @param maxParallelJobs 最大并行任务数（<= 0 时自动选择）
+     * @param progressCallback 进度回调（可能从多个工作线程同时调用）
+     * @return 与任务列表顺序一致的渲染结果
+     */
+    std::vector<RenderResult> renderBatch(const std::vector<RenderJob>& jobs,
+                                          const AudioGraph::GraphSnapshot& snapshot,
+                                          const AudioGraph::PluginInstanceFactory& pluginFactory,
+                                          int maxParallelJobs = 0,
+                                          const BatchRenderProgressCallback& progressCallback = nullptr);
+
+    /**
+     * 取消正在进行的渲染
+     */
+    void cancel() { cancelled.store(true); }
+
+    /**
+     * 是否已请求取消
+     */
+    bool isCancelled() const { return cancelled.load(); }
+
+    /**
+     * 获取推荐的并行任务数
+     */
+    static int getRecommendedParallelJobs();
+
+    /**
+     * 从图快照创建独立的图实例
+     * @param shouldCancel 每个插件实例化之前检查，返回true时停止创建
+     * @return 失败或取消时返回nullptr并设置error
+     */
+    static std::unique_ptr<AudioGraph::GraphAudioProcessor> createGraphInstance(
+        const AudioGraph::GraphSnapshot& snapshot,
+        const AudioGraph::PluginInstanceFactory& pluginFactory,
+        double sampleRate,
+        int blockSize,
+        std::string& error,
+        const CancellationCheck& shouldCancel = nullptr);
+
+private:
+    //==============================================================================
+    // 内部成员变量
+    //==============================================================================
+
+    std::shared_ptr<juce::AudioFormatManager> formatManager;
+    std::shared_ptr<Core::AudioClipCache> clipCache;
+    ThrottleCallback throttleCallback;
+    Options options;
+    std::atomic<bool> cancelled{false};
+
+    //==============================================================================
+    // 内部方法
+    //==============================================================================
+
+    static std::unique_ptr<juce::AudioFormatWriter> createWriter(const juce::File& outputFile,
+                                                                 RenderSettings::Format fileFormat,
+                                                                 double sampleRate,
+                                                                 int numChannels,
+                                                                 int bitDepth,
+                                                                 std::string& error);
+
+    static float computeNormalizationGain(const RenderSettings& settings,
+                                          float peakLevel,
+                                          double integratedLoudness);
+
+    bool writeNormalizedOutput(const juce::File& spillFile,
+                               const juce::File& outputFile,
+                               const RenderSettings& settings,
+                               double sampleRate,
+                               float gain,
+                               const RenderProgressCallback& progressCallback,
+                               std::string& error);
+
+    static void processThroughGraphInChunks(AudioGraph::GraphAudioProcessor& processor,
+                                            juce::AudioBuffer<float>& buffer,
+                                            int numSamples,
+                                            juce::MidiBuffer& midiBuffer);
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(OfflineRenderEngine)
+};
+
+} // namespace WindsynthVST::Engine::Render
@@ -0,0 +1,112 @@
+//
+//  RenderTypes.hpp
+//  WindsynthRecorder
+//
+//  Created by AI Assistant
+//  离线渲染相关类型定义
+//
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <functional>
+
+namespace WindsynthVST::Engine::Render {
+
+//==============================================================================
+// 渲染设置
+//==============================================================================
+
+/**
+ * 离线渲染设置结构
+ */
+struct RenderSettings {
+    int32_t sampleRate = 44100;
+    int32_t bitDepth = 24;
+    int32_t numChannels = 2;
+    bool normalizeOutput = false;
+    bool includePluginTails = false;
+
+    enum class Format {
+        WAV = 0,
+        AIFF = 1
+    };
+    Format format = Format::WAV;
+
+    /**
+     * 归一化方式（normalizeOutput 为 true 时生效）
+     */
+    enum class NormalizationMode {
+        Peak = 0,       // 峰值归一化到 targetPeakDb
+        Loudness = 1    // EBU R128 积分响度归一化到 targetLoudnessLUFS
+    };
+    NormalizationMode normalizationMode = NormalizationMode::Peak;
+    float targetPeakDb = -0.45f;            // 峰值目标（约等于 0.95 线性）
+    float targetLoudnessLUFS = -23.0f;      // 响度目标（EBU R128 广播标准）
+    float peakCeilingDb = -1.0f;            // 响度归一化时允许的最大峰值
+
+    /**
+     * 尾音结束方式（includePluginTails 为 true 时生效）
+     */
+    enum class TailMode {
+        ReportedLength = 0,     // 使用音频图报告的尾音长度
+        SilenceDetection = 1    // 输出低于门限持续 tailSilenceHoldMs 时结束（这段静音不写入文件）
+    };
+    TailMode tailMode = TailMode::SilenceDetection;
+    float maxTailSeconds = 30.0f;           // 尾音长度上限
+    float tailSilenceThresholdDb = -90.0f;  // 静音门限
+    float tailSilenceHoldMs = 500.0f;       // 判定为静音所需的持续时间（毫秒）
+};
+
+/**
+ * 渲染任务
+ */
+struct RenderJob {
+    std::string inputPath;
+    std::string outputPath;
+    RenderSettings settings;
+
+    RenderJob() = default;
+    RenderJob(const std::string& input, const std::string& output, const RenderSettings& s)
+        : inputPath(input), outputPath(output), settings(s) {}
+};
+
+/**
+ * 渲染结果
+ */
+struct RenderResult {
+    std::string inputPath;
+    std::string outputPath;
+    bool success = false;
+    bool cancelled = false;
+    std::string error;
+
+    int64_t samplesWritten = 0;
+    int64_t tailSamplesWritten = 0;
+    double sampleRate = 0.0;
+    float peakLevel = 0.0f;             // 归一化前的峰值
+    double integratedLoudness = 0.0;    // 归一化前的积分响度（LUFS，仅响度模式测量）
+    float appliedGain = 1.0f;           // 归一化增益
+
+    double renderTimeSeconds = 0.0;     // 实际耗时
+    double audioDurationSeconds = 0.0;  // 输出音频时长
+    double realtimeFactor = 0.0;        // 音频时长 / 实际耗时
+};
+
+//==============================================================================
+// 回调类型
+//==============================================================================
+
+/**
+ * 渲染进度回调类型
+ */
+using RenderProgressCallback = std::function<void(float progress, const std::string& message)>;
+
+/**
+ * 批量渲染进度回调类型（可能从多个工作线程同时调用）
+ */
+using BatchRenderProgressCallback = std::function<void(int jobIndex, float progress, const std::string& message)>;
+
+} // namespace WindsynthVST::Engine::Render
@@ -7,10 +7,11 @@
 //
 
 #include "WindsynthEngineFacade.hpp"
-#include <iostream>
+#include "AudioGraph/Core/Logger.hpp"
 #include <thread>
 #include <chrono>
 #include <iomanip>
+#include <mutex>
 
 namespace WindsynthVST::Engine {
 
@@ -19,7 +20,7 @@ namespace WindsynthVST::Engine {
 //==============================================================================
 
 WindsynthEngineFacade::WindsynthEngineFacade() {
-    std::cout << "[WindsynthEngineFacade] 构造函数" << std::endl;
+    WSLOG_INFO("WindsynthEngineFacade", "构造函数");
 
     // 创建核心组件
     context_ = std::make_shared<Core::EngineContext>();
@@ -30,7 +31,7 @@ WindsynthEngineFacade::WindsynthEngineFacade() {
 }
 
 WindsynthEngineFacade::~WindsynthEngineFacade() {
-    std::cout << "[WindsynthEngineFacade] 析构函数" << std::endl;
+    WSLOG_INFO("WindsynthEngineFacade", "析构函数");
     shutdown();
 }
 
@@ -53,6 +54,24 @@ void WindsynthEngineFacade::stop() {
 }
 
 void WindsynthEngineFacade::shutdown() {
+    // 先停止后台渲染，渲染线程可能仍在使用插件加载器
+    // （在锁外销毁队列，完成回调中可以继续调用门面的渲染接口）。
+    // 渲染线程在等待消息线程创建插件时会检查退出标志，这里在消息线程中等待不会死锁
+    std::unique_ptr<Render::BackgroundRenderQueue> renderQueue;
+    {
+        std::lock_guard<std::mutex> lock(renderQueueMutex_);
+        renderQueue = std::move(renderQueue_);
+    }
+    renderQueue.reset();
+
+    // 保留的冻结插件实例在插件加载器关闭前释放
+    std::shared_ptr<Render::FreezeManager> freezeManager;
+    {
+        std::lock_guard<std::mutex> lock(freezeManagerMutex_);
+        freezeManager = std::move(freezeManager_);
+    }
+    freezeManager.reset();
+
     if (lifecycleManager_) {
         lifecycleManager_->shutdown();
     }
@@ -110,9 +129,9 @@ bool WindsynthEngineFacade::renderToFile(const std::string& inputPath,
                                         const std::string& outputPath,
                                         const RenderSettings& settings,
                                         RenderProgressCallback progressCallback) {
-    std::cout << "[WindsynthEngineFacade] 开始执行离线渲染" << std::endl;
-    std::cout << "输入文件: " << inputPath << std::endl;
-    std::cout << "输出文件: " << outputPath << std::endl;
+    WSLOG_INFO("WindsynthEngineFacade", "开始执行离线渲染");
+    WSLOG_INFO("WindsynthEngineFacade", "输入文件: " << inputPath);
+    WSLOG_INFO("WindsynthEngineFacade", "输出文件: " << outputPath);
 
     if (!context_ || !context_->isInitialized()) {
         if (notifier_) {
@@ -121,367 +140,421 @@ bool WindsynthEngineFacade::renderToFile(const std::string& inputPath,
         return false;
     }
 
-    // 完全停止实时音频处理以避免冲突
-    bool wasRunning = isRunning();
-    std::shared_ptr<AudioGraph::AudioIOManager> ioManager = nullptr;
-
-    if (wasRunning) {
-        std::cout << "[WindsynthEngineFacade] 完全停止实时音频处理" << std::endl;
-        stop();  // 完全停止引擎
-        std::this_thread::sleep_for(std::chrono::milliseconds(100)); // 等待停止完成
-    }
-
-    // 关键：断开音频设备连接以防止离线渲染时播放声音
-    ioManager = context_->getIOManager();
-    if (ioManager) {
-        std::cout << "[WindsynthEngineFacade] 断开音频设备连接" << std::endl;
-        auto deviceManager = ioManager->getDeviceManager();
-        auto graphProcessor = context_->getGraphProcessor();
-        if (deviceManager && graphProcessor) {
-            deviceManager->removeAudioCallback(graphProcessor.get());
-        }
-    }
+    // 在从快照重建的独立图实例上渲染：按渲染块大小、非实时模式准备，
+    // 实时图的缓冲区大小和设备连接都不受影响
+    auto snapshot = createRenderSnapshot();
 
+    Render::RenderResult result;
     try {
-        // 检查输入文件是否存在
-        juce::File inputFile(inputPath);
-        if (!inputFile.existsAsFile()) {
-            if (notifier_) {
-                notifier_->notifyError("输入文件不存在: " + inputPath);
+        Render::OfflineRenderEngine renderEngine(context_->getFormatManager());
+        renderEngine.setClipCache(context_->getClipCache());
+
+        // 没有插件时只做格式转换
+        std::unique_ptr<AudioGraph::GraphAudioProcessor> renderGraph;
+        if (snapshot.hasPlugins()) {
+            std::string graphError;
+            renderGraph = Render::OfflineRenderEngine::createGraphInstance(
+                snapshot, createRenderPluginFactory(), snapshot.config.sampleRate,
+                Render::OfflineRenderEngine::Options().blockSize, graphError);
+
+            if (!renderGraph) {
+                result.error = "无法创建音频图实例: " + graphError;
             }
-            return false;
         }
 
-        // 检查输出目录是否存在
-        juce::File outputFile(outputPath);
-        juce::File outputDir = outputFile.getParentDirectory();
-        if (!outputDir.exists()) {
-            outputDir.createDirectory();
+        if (result.error.empty()) {
+            result = renderEngine.renderFile(Render::RenderJob(inputPath, outputPath, settings),
+                                             renderGraph.get(), renderGraph != nullptr, true,
+                                             progressCallback);
         }
 
-        // 获取音频格式管理器
-        auto formatManager = context_->getFormatManager();
-        if (!formatManager) {
-            if (notifier_) {
-                notifier_->notifyError("音频格式管理器无效");
-            }
-            return false;
+        if (renderGraph) {
+            renderGraph->releaseResources();
         }
+    } catch (const std::exception& e) {
+        WSLOG_WARNING("WindsynthEngineFacade", "离线渲染异常: " << e.what());
+        result.success = false;
+        result.error = "执行离线渲染失败: " + std::string(e.what());
+    } catch (...) {
+        WSLOG_WARNING("WindsynthEngineFacade", "离线渲染未知异常");
+        result.success = false;
+        result.error = "执行离线渲染失败: 未知异常";
+    }
 
-        // 创建输入文件读取器
-        auto reader = formatManager->createReaderFor(inputFile);
-        if (!reader) {
-            if (notifier_) {
-                notifier_->notifyError("无法读取输入文件: " + inputPath);
-            }
-            return false;
+    if (!result.success) {
+        if (notifier_) {
+            notifier_->notifyError(result.error);
         }
+        return false;
+    }
 
-        // 获取图形处理器
-        auto graphProcessor = context_->getGraphProcessor();
+    if (progressCallback) {
+        progressCallback(1.0f, "渲染完成");
+    }
 
-        // 创建输出文件写入器
-        std::unique_ptr<juce::AudioFormatWriter> writer;
+    WSLOG_INFO("WindsynthEngineFacade", "离线渲染执行完成");
+    return true;
+}
 
-        // 使用原始音频的采样率
-        double renderSampleRate = reader->sampleRate;
+std::vector<Render::RenderResult> WindsynthEngineFacade::renderBatch(const std::vector<Render::RenderJob>& jobs,
+                                                                    int maxParallelJobs,
+                                                                    Render::BatchRenderProgressCallback progressCallback) {
+    WSLOG_INFO("WindsynthEngineFacade", "开始批量离线渲染，任务数: " << jobs.size());
 
-        if (settings.format == RenderSettings::Format::WAV) {
-            juce::WavAudioFormat wavFormat;
-            auto outputStream = outputFile.createOutputStream();
-            if (!outputStream) {
-                if (notifier_) {
-                    notifier_->notifyError("无法创建输出文件: " + outputPath);
-                }
-                return false;
-            }
+    if (!context_ || !context_->isInitialized()) {
+        if (notifier_) {
+            notifier_->notifyError("引擎上下文未初始化");
+        }
+        return std::vector<Render::RenderResult>(jobs.size());
+    }
 
-            writer.reset(wavFormat.createWriterFor(
-                outputStream.release(),
-                renderSampleRate,
-                static_cast<unsigned int>(settings.numChannels),
-                settings.bitDepth,
-                {},
-                0
-            ));
-        } else if (settings.format == RenderSettings::Format::AIFF) {
-            juce::AiffAudioFormat aiffFormat;
-            auto outputStream = outputFile.createOutputStream();
-            if (!outputStream) {
-                if (notifier_) {
-                    notifier_->notifyError("无法创建输出文件: " + outputPath);
-                }
-                return false;
-            }
+    // 批量渲染在独立的图实例上进行，实时音频处理无需停止
+    auto snapshot = createRenderSnapshot();
 
-            writer.reset(aiffFormat.createWriterFor(
-                outputStream.release(),
-                renderSampleRate,
-                static_cast<unsigned int>(settings.numChannels),
-                settings.bitDepth,
-                {},
-                0
-            ));
+    std::vector<Render::RenderResult> results;
+    try {
+        Render::OfflineRenderEngine renderEngine(context_->getFormatManager());
+        renderEngine.setClipCache(context_->getClipCache());
+        results = renderEngine.renderBatch(jobs, snapshot, createRenderPluginFactory(), maxParallelJobs, progressCallback);
+    } catch (const std::exception& e) {
+        if (notifier_) {
+            notifier_->notifyError("批量离线渲染失败: " + std::string(e.what()));
         }
+        return std::vector<Render::RenderResult>(jobs.size());
+    }
 
-        if (!writer) {
-            if (notifier_) {
-                notifier_->notifyError("无法创建音频写入器");
-            }
-            return false;
+    for (const auto& result : results) {
+        if (!result.success && notifier_) {
+            notifier_->notifyError("渲染失败: " + result.inputPath + " - " + result.error);
         }
+    }
 
-        // 获取音频信息
-        const int64_t totalSamples = reader->lengthInSamples;
-        const int numChannels = std::min(static_cast<int>(reader->numChannels), settings.numChannels);
-        const int bufferSize = 4096; // 使用较大的缓冲区以提高效率
-
-        std::cout << "[WindsynthEngineFacade] 音频信息 - 总样本数: " << totalSamples
-                  << ", 声道数: " << numChannels << ", 缓冲区大小: " << bufferSize << std::endl;
-
-        // 使用原始音频的采样率和声道配置
-        int renderChannels = std::max(numChannels, settings.numChannels);
-
-        std::cout << "[WindsynthEngineFacade] 渲染配置 - 采样率: " << renderSampleRate
-                  << "Hz, 输入声道: " << numChannels
-                  << ", 输出声道: " << renderChannels << std::endl;
-
-        // 简化处理：如果没有VST插件，直接进行音频格式转换
-        bool hasVSTProcessing = (graphProcessor && graphProcessor->getAllNodes().size() > 4); // 超过基本I/O节点
-
-        std::cout << "[WindsynthEngineFacade] VST处理模式: " << (hasVSTProcessing ? "启用" : "禁用") << std::endl;
-
-        // 创建音频缓冲区 - 支持声道转换
-        juce::AudioBuffer<float> inputBuffer(numChannels, bufferSize);
-        juce::AudioBuffer<float> outputBuffer(renderChannels, bufferSize);  // 使用渲染声道数
-        juce::MidiBuffer midiBuffer;
-
-        // 确保缓冲区初始化为零
-        inputBuffer.clear();
-        outputBuffer.clear();
-
-        int64_t samplesProcessed = 0;
-        float maxLevel = 0.0f; // 用于正常化
-
-        // 第一遍：处理音频并找到最大电平（如果需要正常化）
-        std::cout << "[WindsynthEngineFacade] 开始音频处理循环" << std::endl;
-
-        while (samplesProcessed < totalSamples) {
-            const int samplesToRead = static_cast<int>(std::min(static_cast<int64_t>(bufferSize),
-                                                               totalSamples - samplesProcessed));
+    return results;
+}
 
-            // 清空缓冲区
-            inputBuffer.clear();
-            outputBuffer.clear();
-            midiBuffer.clear();
+WindsynthEngineFacade::RenderJobID WindsynthEngineFacade::renderToFileAsync(const std::string& inputPath,
+                                                                         const std::string& outputPath,
+                                                                         const RenderSettings& settings,
+                                                                         RenderProgressCallback progressCallback,
+                                                                         RenderCompletionCallback completionCallback) {
+    if (!context_ || !context_->isInitialized()) {
+        if (notifier_) {
+            notifier_->notifyError("引擎上下文未初始化");
+        }
+        return 0;
+    }
 
-            // 读取音频数据到输入缓冲区
-            if (!reader->read(&inputBuffer, 0, samplesToRead, samplesProcessed, true, true)) {
-                std::cout << "[WindsynthEngineFacade] 警告：读取音频数据失败，位置: " << samplesProcessed << std::endl;
-                break;
-            }
+    auto graphProcessor = context_->getGraphProcessor();
+    auto snapshot = createRenderSnapshot();
+
+    std::lock_guard<std::mutex> lock(renderQueueMutex_);
+    if (!renderQueue_) {
+        renderQueue_ = std::make_unique<Render::BackgroundRenderQueue>(context_->getFormatManager(),
+                                                                       createRenderPluginFactory());
+        renderQueue_->setClipCache(context_->getClipCache());
+
+        // 调速器读取实时图的负载（实时图销毁后不再节流）
+        std::weak_ptr<AudioGraph::GraphAudioProcessor> weakGraph = graphProcessor;
+        renderQueue_->setGovernor([weakGraph]() -> float {
+            auto graph = weakGraph.lock();
+            return graph ? graph->getRealtimeLoad() : 0.0f;
+        });
+    }
 
-            // 安全地设置输出缓冲区大小
-            outputBuffer.setSize(renderChannels, samplesToRead, false, true, true);
+    // 失败的任务通过通知器报告错误
+    auto notifier = notifier_;
+    auto onComplete = [notifier, completionCallback](RenderJobID jobID, const Render::RenderResult& result) {
+        if (!result.success && !result.cancelled && notifier) {
+            notifier->notifyError("渲染失败: " + result.inputPath + " - " + result.error);
+        }
+        if (completionCallback) {
+            completionCallback(jobID, result);
+        }
+    };
 
-            // 复制音频数据并处理声道转换
-            for (int channel = 0; channel < renderChannels; ++channel) {
-                int sourceChannel = std::min(channel, inputBuffer.getNumChannels() - 1);
-                outputBuffer.copyFrom(channel, 0, inputBuffer, sourceChannel, 0, samplesToRead);
-            }
+    return renderQueue_->enqueue(Render::RenderJob(inputPath, outputPath, settings), std::move(snapshot),
+                                 std::move(progressCallback), std::move(onComplete));
+}
 
-            // 只有在确实有VST插件时才进行处理
-            if (hasVSTProcessing && graphProcessor) {
-                try {
-                    // 创建独立的处理缓冲区，避免与主缓冲区冲突
-                    juce::AudioBuffer<float> vstBuffer(renderChannels, samplesToRead);
-                    vstBuffer.makeCopyOf(outputBuffer);
+bool WindsynthEngineFacade::cancelRender(RenderJobID jobID) {
+    std::lock_guard<std::mutex> lock(renderQueueMutex_);
+    return renderQueue_ ? renderQueue_->cancel(jobID) : false;
+}
 
-                    midiBuffer.clear();
+int WindsynthEngineFacade::getNumActiveRenders() const {
+    std::lock_guard<std::mutex> lock(renderQueueMutex_);
+    if (!renderQueue_) {
+        return 0;
+    }
+    return renderQueue_->getNumPendingJobs() + (renderQueue_->getCurrentJobID() != 0 ? 1 : 0);
+}
 
-                    // 临时重新配置处理器（如果需要）
-                    if (!graphProcessor->isGraphReady()) {
-                        graphProcessor->prepareToPlay(renderSampleRate, bufferSize);
-                    }
+//==============================================================================
+// 节点冻结功能（委托给 FreezeManager）
+//==============================================================================
 
-                    // 处理VST效果
-                    graphProcessor->processBlock(vstBuffer, midiBuffer);
+uint32_t WindsynthEngineFacade::freezeNodes(const std::vector<uint32_t>& nodeIDs,
+                                            const FreezeOptions& options,
+                                            RenderProgressCallback progressCallback) {
+    if (!context_ || !context_->isInitialized()) {
+        if (notifier_) {
+            notifier_->notifyError("引擎上下文未初始化");
+        }
+        return 0;
+    }
 
-                    // 复制处理结果回输出缓冲区
-                    outputBuffer.makeCopyOf(vstBuffer);
+    auto graphProcessor = context_->getGraphProcessor();
+    const auto inputPath = audioFileManager_ ? audioFileManager_->getCurrentFilePath() : std::string();
+    if (!graphProcessor || inputPath.empty()) {
+        if (notifier_) {
+            notifier_->notifyError("冻结需要先加载音频文件");
+        }
+        return 0;
+    }
 
-                } catch (const std::exception& e) {
-                    std::cout << "[WindsynthEngineFacade] VST处理异常: " << e.what() << std::endl;
-                    // 如果VST处理失败，继续使用原始音频
-                }
-            }
+    std::vector<AudioGraph::NodeID> graphNodeIDs;
+    graphNodeIDs.reserve(nodeIDs.size());
+    for (auto nodeID : nodeIDs) {
+        AudioGraph::NodeID graphNodeID;
+        graphNodeID.uid = nodeID;
+        graphNodeIDs.push_back(graphNodeID);
+    }
 
-            // 如果需要正常化，记录最大电平
-            if (settings.normalizeOutput) {
-                for (int channel = 0; channel < numChannels; ++channel) {
-                    const float* channelData = outputBuffer.getReadPointer(channel);
-                    for (int sample = 0; sample < samplesToRead; ++sample) {
-                        maxLevel = std::max(maxLevel, std::abs(channelData[sample]));
-                    }
-                }
-            }
+    std::string error;
+    AudioGraph::NodeID playerNodeID;
+    try {
+        playerNodeID = getFreezeManager()->freeze(*graphProcessor, graphNodeIDs, inputPath, options,
+                                                  progressCallback, error);
+    } catch (const std::exception& e) {
+        error = "冻结节点失败: " + std::string(e.what());
+    }
 
-            // 写入处理后的音频
-            writer->writeFromAudioSampleBuffer(outputBuffer, 0, samplesToRead);
+    if (playerNodeID.uid == 0) {
+        if (notifier_) {
+            notifier_->notifyError(error);
+        }
+        return 0;
+    }
 
-            samplesProcessed += samplesToRead;
+    if (progressCallback) {
+        progressCallback(1.0f, "冻结完成");
+    }
+    return playerNodeID.uid;
+}
 
-            // 更新进度
-            if (progressCallback) {
-                float progress = static_cast<float>(samplesProcessed) / static_cast<float>(totalSamples);
-                std::string message = "处理中... " + std::to_string(static_cast<int>(progress * 100)) + "%";
-                progressCallback(progress, message);
-            }
+bool WindsynthEngineFacade::unfreezeNodes(uint32_t playerNodeID) {
+    if (!context_ || !context_->isInitialized()) {
+        return false;
+    }
 
-            // 每处理一定数量的样本输出一次日志
-            if (samplesProcessed % (bufferSize * 100) == 0) {
-                float progress = static_cast<float>(samplesProcessed) / static_cast<float>(totalSamples) * 100.0f;
-                std::cout << "[WindsynthEngineFacade] 处理进度: " << std::fixed << std::setprecision(1)
-                          << progress << "%" << std::endl;
-            }
-        }
+    auto graphProcessor = context_->getGraphProcessor();
+    if (!graphProcessor) {
+        return false;
+    }
 
-        std::cout << "[WindsynthEngineFacade] 音频处理完成，最大电平: " << maxLevel << std::endl;
+    AudioGraph::NodeID graphNodeID;
+    graphNodeID.uid = playerNodeID;
 
-        // 如果需要正常化且检测到音频信号
-        if (settings.normalizeOutput && maxLevel > 0.0001f) {
-            std::cout << "[WindsynthEngineFacade] 应用正常化，目标电平: 0.95" << std::endl;
-            // 注意：这里简化处理，实际应用中可能需要重新处理整个文件
-            // 或者在处理过程中应用增益
+    std::string error;
+    try {
+        if (getFreezeManager()->unfreeze(*graphProcessor, graphNodeID, error)) {
+            return true;
         }
+    } catch (const std::exception& e) {
+        error = "解冻节点失败: " + std::string(e.what());
+    }
 
-        // 处理插件尾音（如果启用）
-        if (settings.includePluginTails && graphProcessor && graphProcessor->isGraphReady()) {
-            std::cout << "[WindsynthEngineFacade] 处理插件尾音" << std::endl;
-
-            // 计算尾音长度（使用渲染采样率）
-            const int tailSamples = static_cast<int>(renderSampleRate * 3.0); // 3秒尾音
-            int tailSamplesProcessed = 0;
-
-            while (tailSamplesProcessed < tailSamples) {
-                const int samplesToProcess = std::min(bufferSize, tailSamples - tailSamplesProcessed);
+    if (notifier_) {
+        notifier_->notifyError(error);
+    }
+    return false;
+}
 
-                // 确保缓冲区大小正确
-                outputBuffer.setSize(renderChannels, samplesToProcess, false, false, true);
+std::vector<WindsynthEngineFacade::FrozenChainInfo> WindsynthEngineFacade::getFrozenChains() const {
+    std::lock_guard<std::mutex> lock(freezeManagerMutex_);
+    return freezeManager_ ? freezeManager_->getFrozenChains() : std::vector<FrozenChainInfo>();
+}
 
-                // 清空缓冲区（静音输入）
-                outputBuffer.clear();
-                midiBuffer.clear();
+std::shared_ptr<Render::FreezeManager> WindsynthEngineFacade::getFreezeManager() {
+    std::lock_guard<std::mutex> lock(freezeManagerMutex_);
+    if (!freezeManager_) {
+        freezeManager_ = std::make_shared<Render::FreezeManager>(context_->getFormatManager(),
+                                                                 createRenderPluginFactory());
+        freezeManager_->setClipCache(context_->getClipCache());
+    }
+    return freezeManager_;
+}
 
-                try {
-                    // 使用主处理器处理静音以获取插件尾音
-                    graphProcessor->processBlock(outputBuffer, midiBuffer);
+AudioGraph::GraphSnapshot WindsynthEngineFacade::createRenderSnapshot() const {
+    auto graphProcessor = context_ ? context_->getGraphProcessor() : nullptr;
 
-                    // 写入尾音
-                    writer->writeFromAudioSampleBuffer(outputBuffer, 0, samplesToProcess);
-                } catch (const std::exception& e) {
-                    std::cout << "[WindsynthEngineFacade] 插件尾音处理异常: " << e.what() << std::endl;
-                    break; // 如果尾音处理失败，停止尾音渲染
-                }
+    AudioGraph::GraphSnapshot snapshot;
+    if (graphProcessor) {
+        snapshot = graphProcessor->createGraphSnapshot();
 
-                tailSamplesProcessed += samplesToProcess;
-            }
+        std::lock_guard<std::mutex> lock(freezeManagerMutex_);
+        if (freezeManager_) {
+            freezeManager_->expandFrozenChains(*graphProcessor, snapshot);
         }
+    }
+    return snapshot;
+}
 
-        // 渲染完成后的清理工作
-        std::cout << "[WindsynthEngineFacade] 离线渲染完成，开始清理" << std::endl;
+AudioGraph::PluginInstanceFactory WindsynthEngineFacade::createRenderPluginFactory() const {
+    auto pluginLoader = context_ ? context_->getPluginLoader() : nullptr;
 
-        // 完成渲染
-        writer.reset(); // 确保文件被正确关闭
+    // 插件实例化在各工作线程间串行进行，插件格式的模块加载不保证线程安全
+    auto instantiationMutex = std::make_shared<std::mutex>();
+    return [pluginLoader, instantiationMutex](const juce::PluginDescription& description, double sampleRate,
+                                              int blockSize, juce::String& error)
+        -> std::unique_ptr<juce::AudioPluginInstance> {
+        if (!pluginLoader) {
+            error = "插件加载器无效";
+            return nullptr;
+        }
+        std::lock_guard<std::mutex> lock(*instantiationMutex);
+
+        if (juce::MessageManager::existsAndIsCurrentThread()) {
+            return pluginLoader->loadPluginSync(description, sampleRate, blockSize, error);
+        }
+
+        // 其他线程中异步创建并分段等待：关闭时消息线程在等待渲染线程退出，渲染线程
+        // 不能一直等待消息线程完成创建。放弃等待后，迟到的实例随回调状态一起释放
+        struct PendingInstance {
+            juce::WaitableEvent created;
+            std::unique_ptr<juce::AudioPluginInstance> instance;
+            juce::String error;
+        };
+        auto pending = std::make_shared<PendingInstance>();
+        pluginLoader->loadPluginAsync(description, sampleRate, blockSize,
+            [pending](std::unique_ptr<juce::AudioPluginInstance> instance, const juce::String& loadError) {
+                pending->instance = std::move(instance);
+                pending->error = loadError;
+                pending->created.signal();
+            });
 
-        // 恢复音频设备连接和实时音频处理（如果之前在运行）
-        if (ioManager) {
-            std::cout << "[WindsynthEngineFacade] 重新连接音频设备" << std::endl;
-            auto deviceManager = ioManager->getDeviceManager();
-            auto graphProcessor = context_->getGraphProcessor();
-            if (deviceManager && graphProcessor) {
-                deviceManager->addAudioCallback(graphProcessor.get());
+        constexpr int pollIntervalMs = 50;
+        while (!pending->created.wait(pollIntervalMs)) {
+            if (juce::Thread::currentThreadShouldExit()) {
+                error = "渲染线程正在退出，停止创建插件：" + description.name;
+                return nullptr;
             }
         }
 
-        if (wasRunning) {
-            std::cout << "[WindsynthEngineFacade] 重新启动实时音频处理" << std::endl;
-            // 重新启动引擎
-            start();
-        }
+        error = pending->error;
+        return std::move(pending->instance);
+    };
+}
+
+//==============================================================================
+// 多轨录音功能（委托给 DiskRecorder）
+//==============================================================================
 
-        if (progressCallback) {
-            progressCallback(1.0f, "渲染完成");
+bool WindsynthEngineFacade::startRecording(const RecordingSettings& settings,
+                                           const std::vector<RecordingTrack>& tracks) {
+    if (!context_ || !context_->isInitialized()) {
+        if (notifier_) {
+            notifier_->notifyError("引擎上下文未初始化");
         }
+        return false;
+    }
 
-        std::cout << "[WindsynthEngineFacade] 离线渲染执行完成" << std::endl;
-        return true;
+    auto recorder = context_->getDiskRecorder();
+    if (!recorder) {
+        return false;
+    }
 
-    } catch (const std::exception& e) {
-        // 异常情况下也要恢复音频设备连接和实时音频处理
-        std::cout << "[WindsynthEngineFacade] 离线渲染异常: " << e.what() << std::endl;
-
-        // 异常情况下也要恢复音频设备连接
-        if (ioManager) {
-            std::cout << "[WindsynthEngineFacade] 异常情况下重新连接音频设备" << std::endl;
-            try {
-                auto deviceManager = ioManager->getDeviceManager();
-                auto graphProcessor = context_->getGraphProcessor();
-                if (deviceManager && graphProcessor) {
-                    deviceManager->addAudioCallback(graphProcessor.get());
-                }
-            } catch (...) {
-                std::cout << "[WindsynthEngineFacade] 重新连接音频设备失败" << std::endl;
+    // 未指定时使用当前音频设备的采样率和通道数
+    RecordingSettings resolvedSettings = settings;
+    auto ioManager = context_->getIOManager();
+    auto* deviceManager = ioManager ? ioManager->getDeviceManager() : nullptr;
+    if (deviceManager) {
+        if (auto* device = deviceManager->getCurrentAudioDevice()) {
+            if (resolvedSettings.sampleRate <= 0.0) {
+                resolvedSettings.sampleRate = device->getCurrentSampleRate();
             }
-        }
-
-        if (wasRunning) {
-            std::cout << "[WindsynthEngineFacade] 异常情况下重新启动实时音频处理" << std::endl;
-            try {
-                start();
-            } catch (...) {
-                std::cout << "[WindsynthEngineFacade] 重新启动失败" << std::endl;
+            if (resolvedSettings.numInputChannels <= 0) {
+                resolvedSettings.numInputChannels = device->getActiveInputChannels().countNumberOfSetBits();
+            }
+            if (resolvedSettings.numOutputChannels <= 0) {
+                resolvedSettings.numOutputChannels = device->getActiveOutputChannels().countNumberOfSetBits();
             }
         }
+    }
 
+    std::string error;
+    if (!recorder->startRecording(resolvedSettings, tracks, error)) {
         if (notifier_) {
-            notifier_->notifyError("执行离线渲染失败: " + std::string(e.what()));
+            notifier_->notifyError("开始录音失败: " + error);
         }
         return false;
-    } catch (...) {
-        // 异常情况下也要恢复音频设备连接和实时音频处理
-        std::cout << "[WindsynthEngineFacade] 离线渲染未知异常" << std::endl;
-
-        // 异常情况下也要恢复音频设备连接
-        if (ioManager) {
-            std::cout << "[WindsynthEngineFacade] 异常情况下重新连接音频设备" << std::endl;
-            try {
-                auto deviceManager = ioManager->getDeviceManager();
-                auto graphProcessor = context_->getGraphProcessor();
-                if (deviceManager && graphProcessor) {
-                    deviceManager->addAudioCallback(graphProcessor.get());
-                }
-            } catch (...) {
-                std::cout << "[WindsynthEngineFacade] 重新连接音频设备失败" << std::endl;
-            }
-        }
+    }
 
-        if (wasRunning) {
-            std::cout << "[WindsynthEngineFacade] 异常情况下重新启动实时音频处理" << std::endl;
-            try {
-                start();
-            } catch (...) {
-                std::cout << "[WindsynthEngineFacade] 重新启动失败" << std::endl;
-            }
-        }
+    return true;
+}
 
-        if (notifier_) {
-            notifier_->notifyError("执行离线渲染失败: 未知异常");
-        }
-        return false;
+void WindsynthEngineFacade::stopRecording() {
+    if (context_ && context_->getDiskRecorder()) {
+        context_->getDiskRecorder()->stopRecording();
     }
 }
 
+bool WindsynthEngineFacade::isRecording() const {
+    return context_ && context_->getDiskRecorder() && context_->getDiskRecorder()->isRecording();
+}
+
+std::vector<std::string> WindsynthEngineFacade::getRecordingFiles() const {
+    if (context_ && context_->getDiskRecorder()) {
+        return context_->getDiskRecorder()->getTrackFiles();
+    }
+    return {};
+}
+
+void WindsynthEngineFacade::setPunchRange(int64_t punchInSample, int64_t punchOutSample) {
+    if (context_ && context_->getDiskRecorder()) {
+        context_->getDiskRecorder()->setPunchRange(punchInSample, punchOutSample);
+    }
+}
+
+void WindsynthEngineFacade::clearPunchRange() {
+    if (context_ && context_->getDiskRecorder()) {
+        context_->getDiskRecorder()->clearPunchRange();
+    }
+}
+
+void WindsynthEngineFacade::punchIn() {
+    if (context_ && context_->getDiskRecorder()) {
+        context_->getDiskRecorder()->punchIn();
+    }
+}
+
+void WindsynthEngineFacade::punchOut() {
+    if (context_ && context_->getDiskRecorder()) {
+        context_->getDiskRecorder()->punchOut();
+    }
+}
+
+WindsynthEngineFacade::RecordingStatistics WindsynthEngineFacade::getRecordingStatistics() const {
+    if (context_ && context_->getDiskRecorder()) {
+        return context_->getDiskRecorder()->getStatistics();
+    }
+    return {};
+}
+
+//==============================================================================
+// MIDI输入（委托给 AudioIOManager）
+//==============================================================================
+
+std::vector<WindsynthEngineFacade::MidiInputDeviceInfo> WindsynthEngineFacade::getMidiInputDevices() const {
+    auto ioManager = context_ ? context_->getIOManager() : nullptr;
+    return ioManager ? ioManager->getMidiInputDevices() : std::vector<MidiInputDeviceInfo>();
+}
+
+bool WindsynthEngineFacade::setMidiInputDeviceEnabled(const std::string& identifier, bool enabled) {
+    auto ioManager = context_ ? context_->getIOManager() : nullptr;
+    return ioManager ? ioManager->setMidiInputDeviceEnabled(identifier, enabled) : false;
+}
+
 //==============================================================================
 // 节点参数控制（委托给 NodeParameterController）
 //==============================================================================
@@ -490,6 +563,10 @@ bool WindsynthEngineFacade::setNodeParameter(uint32_t nodeID, int parameterIndex
     return parameterController_ ? parameterController_->setNodeParameter(nodeID, parameterIndex, value) : false;
 }
 
+int WindsynthEngineFacade::setNodeParameters(uint32_t nodeID, const std::vector<Interfaces::ParameterChange>& changes) {
+    return parameterController_ ? parameterController_->setNodeParameters(nodeID, changes) : 0;
+}
+
 float WindsynthEngineFacade::getNodeParameter(uint32_t nodeID, int parameterIndex) const {
     return parameterController_ ? parameterController_->getNodeParameter(nodeID, parameterIndex) : -1.0f;
 }
@@ -535,7 +612,7 @@ std::vector<Interfaces::SimplePluginInfo> WindsynthEngineFacade::getAvailablePlu
         }
         
     } catch (const std::exception& e) {
-        std::cerr << "[WindsynthEngineFacade] 获取插件列表失败: " << e.what() << std::endl;
+        WSLOG_ERROR("WindsynthEngineFacade", "获取插件列表失败: " << e.what());
     }
     
     return result;
@@ -647,17 +724,42 @@ std::vector<Interfaces::SimpleNodeInfo> WindsynthEngineFacade::getLoadedNodes()
             info.isBypassed = node.bypassed;
             info.numInputChannels = node.numInputChannels;
             info.numOutputChannels = node.numOutputChannels;
+            info.sleepWhenSilent = node.sleepWhenSilent;
+            info.isSleeping = node.sleeping;
             
             result.push_back(info);
         }
         
     } catch (const std::exception& e) {
-        std::cerr << "[WindsynthEngineFacade] 获取节点列表失败: " << e.what() << std::endl;
+        WSLOG_ERROR("WindsynthEngineFacade", "获取节点列表失败: " << e.what());
     }
     
     return result;
 }
 
+bool WindsynthEngineFacade::setNodeSleepWhenSilent(uint32_t nodeID, bool sleepWhenSilent) {
+    if (!context_ || !context_->isInitialized()) {
+        return false;
+    }
+    
+    try {
+        auto graphProcessor = context_->getGraphProcessor();
+        if (!graphProcessor) {
+            return false;
+        }
+        
+        AudioGraph::NodeID graphNodeID;
+        graphNodeID.uid = nodeID;
+        
+        return graphProcessor->setNodeSleepWhenSilent(graphNodeID, sleepWhenSilent);
+    } catch (const std::exception& e) {
+        if (notifier_) {
+            notifier_->notifyError("设置节点静音休眠失败: " + std::string(e.what()));
+        }
+        return false;
+    }
+}
+
 bool WindsynthEngineFacade::setNodeBypassed(uint32_t nodeID, bool bypassed) {
     if (!context_ || !context_->isInitialized()) {
         return false;
@@ -763,14 +865,14 @@ bool WindsynthEngineFacade::updateConfiguration(const Core::EngineConfig& config
 //==============================================================================
 
 void WindsynthEngineFacade::initializeManagers() {
-    std::cout << "[WindsynthEngineFacade] 初始化管理器" << std::endl;
+    WSLOG_INFO("WindsynthEngineFacade", "初始化管理器");
 
     // 创建管理器实例
     lifecycleManager_ = std::make_shared<Managers::EngineLifecycleManager>(context_, notifier_);
     audioFileManager_ = std::make_shared<Managers::AudioFileManager>(context_, notifier_);
     parameterController_ = std::make_shared<Managers::NodeParameterController>(context_, notifier_);
 
-    std::cout << "[WindsynthEngineFacade] 管理器初始化完成" << std::endl;
+    WSLOG_INFO("WindsynthEngineFacade", "管理器初始化完成");
 }
 
 } // namespace WindsynthVST::Engine
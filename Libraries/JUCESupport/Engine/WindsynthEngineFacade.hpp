@@ -13,6 +13,7 @@
 #include <string>
 #include <vector>
 #include <functional>
+#include <mutex>
 
 // 核心组件
 #include "Core/EngineContext.hpp"
@@ -29,6 +30,11 @@
 #include "Managers/AudioFileManager.hpp"
 #include "Managers/NodeParameterController.hpp"
 
+// 离线渲染
+#include "Render/OfflineRenderEngine.hpp"
+#include "Render/BackgroundRenderQueue.hpp"
+#include "Render/FreezeManager.hpp"
+
 namespace WindsynthVST::Engine {
 
 /**
@@ -90,6 +96,7 @@ public:
     //==============================================================================
     
     bool setNodeParameter(uint32_t nodeID, int parameterIndex, float value);
+    int setNodeParameters(uint32_t nodeID, const std::vector<Interfaces::ParameterChange>& changes);
     float getNodeParameter(uint32_t nodeID, int parameterIndex) const;
     int getNodeParameterCount(uint32_t nodeID) const;
     std::optional<Interfaces::ParameterInfo> getNodeParameterInfo(uint32_t nodeID, int parameterIndex) const;
@@ -106,6 +113,7 @@ public:
     std::vector<Interfaces::SimpleNodeInfo> getLoadedNodes() const;
     bool setNodeBypassed(uint32_t nodeID, bool bypassed);
     bool setNodeEnabled(uint32_t nodeID, bool enabled);
+    bool setNodeSleepWhenSilent(uint32_t nodeID, bool sleepWhenSilent);
     
     //==============================================================================
     // 离线渲染功能
@@ -114,24 +122,12 @@ public:
     /**
      * 离线渲染设置结构
      */
-    struct RenderSettings {
-        int32_t sampleRate = 44100;
-        int32_t bitDepth = 24;
-        int32_t numChannels = 2;
-        bool normalizeOutput = false;
-        bool includePluginTails = false;
-
-        enum class Format {
-            WAV = 0,
-            AIFF = 1
-        };
-        Format format = Format::WAV;
-    };
+    using RenderSettings = Render::RenderSettings;
 
     /**
      * 渲染进度回调类型
      */
-    using RenderProgressCallback = std::function<void(float progress, const std::string& message)>;
+    using RenderProgressCallback = Render::RenderProgressCallback;
 
     /**
      * 离线渲染音频文件
@@ -146,6 +142,124 @@ public:
                      const RenderSettings& settings,
                      RenderProgressCallback progressCallback = nullptr);
 
+    /**
+     * 并行批量离线渲染
+     *
+     * 每个工作线程使用从当前音频图快照重建的独立图实例，
+     * 实时音频处理在渲染期间保持运行。
+     * @param jobs 渲染任务列表
+     * @param maxParallelJobs 最大并行任务数（<= 0 时按CPU核心数自动选择）
+     * @param progressCallback 进度回调（可能从多个工作线程同时调用）
+     * @return 与任务列表顺序一致的渲染结果
+     */
+    std::vector<Render::RenderResult> renderBatch(const std::vector<Render::RenderJob>& jobs,
+                                                  int maxParallelJobs = 0,
+                                                  Render::BatchRenderProgressCallback progressCallback = nullptr);
+
+    /**
+     * 后台渲染任务ID与完成回调
+     */
+    using RenderJobID = Render::BackgroundRenderQueue::JobID;
+    using RenderCompletionCallback = Render::BackgroundRenderQueue::CompletionCallback;
+
+    /**
+     * 在后台离线渲染（排队执行，实时监听不中断）
+     *
+     * 渲染使用当前音频图的快照，之后对实时图的修改不影响已排队的任务；
+     * 渲染线程根据实时回调的负载自动让出CPU。
+     * @param progressCallback 进度回调（在渲染线程中调用）
+     * @param completionCallback 完成回调（在渲染线程中调用）
+     * @return 任务ID，失败时返回0
+     */
+    RenderJobID renderToFileAsync(const std::string& inputPath,
+                                  const std::string& outputPath,
+                                  const RenderSettings& settings,
+                                  RenderProgressCallback progressCallback = nullptr,
+                                  RenderCompletionCallback completionCallback = nullptr);
+
+    /**
+     * 取消后台渲染任务
+     * @return 找到任务时返回true
+     */
+    bool cancelRender(RenderJobID jobID);
+
+    /**
+     * 后台渲染中排队和正在进行的任务数量
+     */
+    int getNumActiveRenders() const;
+
+    //==============================================================================
+    // 节点冻结
+    //==============================================================================
+
+    using FreezeOptions = Render::FreezeManager::FreezeOptions;
+    using FrozenChainInfo = Render::FreezeManager::FrozenChainInfo;
+
+    /**
+     * 冻结插件节点或处理链：按当前加载的音频文件离线渲染这些节点，并用播放节点替换它们
+     * @param nodeIDs 被冻结的插件节点
+     * @param options 冻结选项
+     * @param progressCallback 渲染进度回调
+     * @return 播放节点ID，失败时返回0
+     */
+    uint32_t freezeNodes(const std::vector<uint32_t>& nodeIDs,
+                         const FreezeOptions& options = FreezeOptions(),
+                         RenderProgressCallback progressCallback = nullptr);
+
+    /**
+     * 解冻：恢复被冻结的插件节点
+     * @param playerNodeID 冻结时返回的播放节点ID
+     */
+    bool unfreezeNodes(uint32_t playerNodeID);
+
+    /**
+     * 获取所有冻结信息
+     */
+    std::vector<FrozenChainInfo> getFrozenChains() const;
+
+    //==============================================================================
+    // 多轨录音功能
+    //==============================================================================
+
+    using RecordingSettings = AudioGraph::DiskRecorder::RecordingSettings;
+    using RecordingTrack = AudioGraph::DiskRecorder::TrackConfig;
+    using RecordingStatistics = AudioGraph::DiskRecorder::RecordingStatistics;
+
+    /**
+     * 开始多轨录音
+     * 采样率和通道数为 0 时使用当前音频设备的设置
+     * @param settings 录音设置
+     * @param tracks 轨道配置（每个轨道一个文件）
+     * @return 成功返回true
+     */
+    bool startRecording(const RecordingSettings& settings, const std::vector<RecordingTrack>& tracks);
+    void stopRecording();
+    bool isRecording() const;
+    std::vector<std::string> getRecordingFiles() const;
+
+    void setPunchRange(int64_t punchInSample, int64_t punchOutSample);
+    void clearPunchRange();
+    void punchIn();
+    void punchOut();
+
+    RecordingStatistics getRecordingStatistics() const;
+
+    //==============================================================================
+    // MIDI输入
+    //==============================================================================
+
+    using MidiInputDeviceInfo = AudioGraph::AudioIOManager::MidiInputDeviceInfo;
+
+    /**
+     * 获取可用的MIDI输入设备
+     */
+    std::vector<MidiInputDeviceInfo> getMidiInputDevices() const;
+
+    /**
+     * 启用或禁用MIDI输入设备（启用的设备消息送入音频图的MIDI输入节点）
+     */
+    bool setMidiInputDeviceEnabled(const std::string& identifier, bool enabled);
+
     //==============================================================================
     // 事件回调设置（向后兼容）
     //==============================================================================
@@ -200,12 +314,35 @@ private:
     std::shared_ptr<Interfaces::INodeParameterController> parameterController_;
     // 注意：插件管理器直接使用 AudioGraph::PluginManager
     
+    // 后台渲染队列（第一次使用时创建）
+    std::unique_ptr<Render::BackgroundRenderQueue> renderQueue_;
+    mutable std::mutex renderQueueMutex_;
+    
+    // 节点冻结（第一次使用时创建）
+    std::shared_ptr<Render::FreezeManager> freezeManager_;
+    mutable std::mutex freezeManagerMutex_;
+    
     //==============================================================================
     // 初始化方法
     //==============================================================================
     
     void initializeManagers();
     
+    /**
+     * 创建离线渲染用的插件实例工厂（通过插件加载器同步实例化）
+     */
+    AudioGraph::PluginInstanceFactory createRenderPluginFactory() const;
+    
+    /**
+     * 获取节点冻结管理器（不存在时创建）
+     */
+    std::shared_ptr<Render::FreezeManager> getFreezeManager();
+    
+    /**
+     * 捕获用于离线渲染的图快照（冻结的节点按原插件展开）
+     */
+    AudioGraph::GraphSnapshot createRenderSnapshot() const;
+    
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(WindsynthEngineFacade)
 };
 
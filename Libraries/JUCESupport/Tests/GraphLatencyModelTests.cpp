@@ -0,0 +1,117 @@
+//
+//  GraphLatencyModelTests.cpp
+//  WindsynthRecorder
+//
+//  Created by AI Assistant
+//  音频图延迟模型测试
+//
+
+#include "AudioGraph/Core/GraphLatencyModel.hpp"
+#include "Benchmarks/SyntheticPlugin.hpp"
+
+namespace WindsynthVST::Tests {
+
+class GraphLatencyModelTests : public juce::UnitTest {
+public:
+    GraphLatencyModelTests() : juce::UnitTest("GraphLatencyModel", "AudioGraph") {}
+
+    void runTest() override {
+        using IOProcessor = juce::AudioProcessorGraph::AudioGraphIOProcessor;
+
+        // 输入 → A(100) → 输出，输入 → B(0) → 输出，输入 → C(50) 不到达输出
+        juce::AudioProcessorGraph graph;
+        graph.setPlayConfigDetails(2, 2, 44100.0, 512);
+
+        const auto input = addNode(graph, std::make_unique<IOProcessor>(IOProcessor::audioInputNode));
+        const auto output = addNode(graph, std::make_unique<IOProcessor>(IOProcessor::audioOutputNode));
+        const auto a = addPlugin(graph, 100);
+        const auto b = addPlugin(graph, 0);
+        const auto c = addPlugin(graph, 50);
+
+        connect(graph, input, a);
+        connect(graph, input, b);
+        connect(graph, input, c);
+        connect(graph, a, output);
+        connect(graph, b, output);
+
+        AudioGraph::GraphLatencyModel model;
+        model.rebuild(graph, output);
+
+        beginTest("较短的路径在汇入节点处补偿差值");
+        {
+            expectEquals(model.getGraphLatencySamples(), 100);
+            expectEquals(model.getCompensationSamples(audioConnection(a, output)), 0);
+            expectEquals(model.getCompensationSamples(audioConnection(b, output)), 100);
+            expectEquals(model.getCompensationSamples(audioConnection(input, a)), 0);
+            expectEquals(model.getTotalCompensationSamples(), 100);
+
+            const auto latency = model.getNodeLatency(a);
+            expectEquals(latency.pluginLatency, 100);
+            expectEquals(latency.inputLatency, 0);
+            expectEquals(latency.outputLatency, 100);
+        }
+
+        beginTest("不到达输出的路径不计入图延迟");
+        {
+            expectEquals(model.getNodeLatency(c).outputLatency, 50);
+            expect(model.setNodeLatency(c, 500));
+            expectEquals(model.getGraphLatencySamples(), 100);
+            expectEquals(model.getTotalCompensationSamples(), 100);
+        }
+
+        beginTest("插件延迟变化后重新计算下游补偿");
+        {
+            expect(model.setNodeLatency(b, 30));
+            expectEquals(model.getGraphLatencySamples(), 100);
+            expectEquals(model.getCompensationSamples(audioConnection(b, output)), 70);
+            expectEquals(model.getTotalCompensationSamples(), 70);
+
+            // 最长路径变化时图延迟跟随，补偿转移到另一条路径
+            expect(model.setNodeLatency(b, 160));
+            expectEquals(model.getGraphLatencySamples(), 160);
+            expectEquals(model.getCompensationSamples(audioConnection(a, output)), 60);
+            expectEquals(model.getCompensationSamples(audioConnection(b, output)), 0);
+        }
+
+        beginTest("延迟未变化或节点未知时返回false");
+        {
+            expect(!model.setNodeLatency(a, 100));
+            expect(!model.setNodeLatency(AudioGraph::NodeID(9999), 10));
+            expectEquals(model.getCompensationSamples(audioConnection(AudioGraph::NodeID(9999), output)), 0);
+        }
+
+        beginTest("MIDI连接不参与补偿");
+        {
+            const AudioGraph::Connection midi { { b, juce::AudioProcessorGraph::midiChannelIndex },
+                                                { output, juce::AudioProcessorGraph::midiChannelIndex } };
+            expectEquals(model.getCompensationSamples(midi), 0);
+        }
+    }
+
+private:
+    static AudioGraph::NodeID addNode(juce::AudioProcessorGraph& graph, std::unique_ptr<juce::AudioProcessor> processor) {
+        return graph.addNode(std::move(processor), {}, juce::AudioProcessorGraph::UpdateKind::none)->nodeID;
+    }
+
+    static AudioGraph::NodeID addPlugin(juce::AudioProcessorGraph& graph, int latencySamples) {
+        auto plugin = std::make_unique<Benchmarks::SyntheticPlugin>(1, 0);
+        plugin->setLatencySamples(latencySamples);
+        return addNode(graph, std::move(plugin));
+    }
+
+    static AudioGraph::Connection audioConnection(AudioGraph::NodeID source, AudioGraph::NodeID destination,
+                                                  int channel = 0) {
+        return { { source, channel }, { destination, channel } };
+    }
+
+    void connect(juce::AudioProcessorGraph& graph, AudioGraph::NodeID source, AudioGraph::NodeID destination) {
+        for (int channel = 0; channel < 2; ++channel) {
+            expect(graph.addConnection(audioConnection(source, destination, channel),
+                                       juce::AudioProcessorGraph::UpdateKind::none));
+        }
+    }
+};
+
+static GraphLatencyModelTests graphLatencyModelTests;
+
+} // namespace WindsynthVST::Tests
@@ -0,0 +1,111 @@
+//
+//  GraphManagerTests.cpp
+//  WindsynthRecorder
+//
+//  Created by AI Assistant
+//  撤销历史的合并和内存预算测试
+//
+
+#include "AudioGraph/Management/GraphManager.hpp"
+
+namespace WindsynthVST::Tests {
+
+class GraphManagerTests : public juce::UnitTest {
+public:
+    GraphManagerTests() : juce::UnitTest("GraphManager", "AudioGraph") {}
+
+    void runTest() override {
+        AudioGraph::GraphAudioProcessor graphProcessor;
+        graphProcessor.configure(AudioGraph::GraphConfig());
+        AudioGraph::GraphManager manager(graphProcessor);
+
+        // 图中没有这个节点，撤销/重做只改变历史，不修改图
+        const AudioGraph::NodeID node(1000);
+
+        beginTest("连续修改同一属性合并为一步");
+        {
+            manager.recordPropertyChange(node, "parameter:0", 0.0, 0.1);
+            const size_t bytes = manager.getUndoHistoryBytes();
+            manager.recordPropertyChange(node, "parameter:0", 0.1, 0.2);
+            manager.recordPropertyChange(node, "parameter:0", 0.2, 0.3);
+            expectEquals(static_cast<int>(manager.getUndoHistoryBytes()), static_cast<int>(bytes));
+
+            expectEquals(countUndoSteps(manager), 1);
+            expect(manager.canRedo());
+            expectEquals(static_cast<int>(manager.getUndoHistoryBytes()), static_cast<int>(bytes),
+                         "撤销只是把记录移到重做栈");
+            manager.clearUndoHistory();
+            expectEquals(static_cast<int>(manager.getUndoHistoryBytes()), 0);
+        }
+
+        beginTest("不同属性分别记录，撤销后的新修改不合并到已撤销的步骤");
+        {
+            manager.recordPropertyChange(node, "parameter:0", 0.0, 0.5);
+            manager.recordPropertyChange(node, "parameter:1", 0.0, 0.5);
+            expect(manager.undo());
+
+            manager.recordPropertyChange(node, "parameter:0", 0.5, 0.6);
+            expect(!manager.canRedo(), "新的修改清除重做栈");
+            expectEquals(countUndoSteps(manager), 2);
+            manager.clearUndoHistory();
+        }
+
+        beginTest("批量操作中的连续修改合并后作为一步记录");
+        {
+            int numSubOperations = -1;
+            manager.setGraphChangeCallback([&numSubOperations](const AudioGraph::GraphManager::GraphOperation& operation) {
+                if (operation.type == AudioGraph::GraphManager::OperationType::BatchOperation) {
+                    numSubOperations = static_cast<int>(operation.batchOperations.size());
+                }
+            });
+
+            manager.beginBatchOperation("batch");
+            manager.recordPropertyChange(node, "parameter:0", 0.0, 0.1);
+            manager.recordPropertyChange(node, "parameter:0", 0.1, 0.2);
+            manager.recordPropertyChange(node, "parameter:1", 0.0, 0.1);
+            manager.endBatchOperation();
+            manager.setGraphChangeCallback(nullptr);
+
+            expectEquals(numSubOperations, 2);
+            expectEquals(countUndoSteps(manager), 1);
+            manager.clearUndoHistory();
+        }
+
+        beginTest("超出内存预算时丢弃最早的记录");
+        {
+            // 与 GraphManager::MAX_UNDO_BYTES 一致
+            constexpr size_t budget = 4 * 1024 * 1024;
+            const juce::var largeValue(juce::String::repeatedString("x", 64 * 1024));
+
+            for (int i = 0; i < 100; ++i) {
+                manager.recordPropertyChange(node, "parameter:" + std::to_string(i), largeValue, largeValue);
+            }
+            expect(manager.getUndoHistoryBytes() <= budget);
+
+            const int numSteps = countUndoSteps(manager);
+            expect(numSteps > 1 && numSteps < 100);
+            expect(manager.getUndoHistoryBytes() <= budget, "重做栈同样计入预算");
+            manager.clearUndoHistory();
+
+            // 单步超出预算时仍然保留最新的一步
+            const juce::var hugeValue(juce::String::repeatedString("x", static_cast<int>(budget)));
+            manager.recordPropertyChange(node, "parameter:0", hugeValue, hugeValue);
+            expect(manager.canUndo());
+            expect(manager.getUndoHistoryBytes() > budget);
+            manager.clearUndoHistory();
+        }
+    }
+
+private:
+    static int countUndoSteps(AudioGraph::GraphManager& manager) {
+        int numSteps = 0;
+        while (manager.undo()) {
+            numSteps++;
+        }
+        return numSteps;
+    }
+};
+
+static GraphManagerTests graphManagerTests;
+
+} // namespace WindsynthVST::Tests
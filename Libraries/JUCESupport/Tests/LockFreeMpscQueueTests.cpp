@@ -0,0 +1,125 @@
+//
+//  LockFreeMpscQueueTests.cpp
+//  WindsynthRecorder
+//
+//  Created by AI Assistant
+//  多生产者单消费者无锁队列测试
+//
+
+#include "AudioGraph/Core/LockFreeMpscQueue.hpp"
+#include <thread>
+#include <vector>
+
+namespace WindsynthVST::Tests {
+
+class LockFreeMpscQueueTests : public juce::UnitTest {
+public:
+    LockFreeMpscQueueTests() : juce::UnitTest("LockFreeMpscQueue", "AudioGraph") {}
+
+    void runTest() override {
+        beginTest("先进先出，空队列读取失败");
+        {
+            AudioGraph::LockFreeMpscQueue<int, 8> queue;
+            int value = -1;
+            expect(!queue.pop(value));
+
+            for (int i = 0; i < 5; ++i) {
+                expect(queue.push(i));
+            }
+            for (int i = 0; i < 5; ++i) {
+                expect(queue.pop(value));
+                expectEquals(value, i);
+            }
+            expect(!queue.pop(value));
+        }
+
+        beginTest("队列满时丢弃并计数，读取后可以继续写入");
+        {
+            AudioGraph::LockFreeMpscQueue<int, 4> queue;
+            for (int i = 0; i < queue.getCapacity(); ++i) {
+                expect(queue.push(i));
+            }
+            expect(!queue.push(100));
+            expect(!queue.push(101));
+            expectEquals(static_cast<int>(queue.getDroppedCount()), 2);
+
+            // 多次绕回，确认槽序号按圈推进
+            int value = -1;
+            for (int i = queue.getCapacity(); i < 64; ++i) {
+                expect(queue.pop(value));
+                expectEquals(value, i - queue.getCapacity());
+                expect(queue.push(i));
+            }
+            expectEquals(static_cast<int>(queue.getDroppedCount()), 2);
+        }
+
+        beginTest("drain 按上限取出，剩余元素保留");
+        {
+            AudioGraph::LockFreeMpscQueue<int, 16> queue;
+            for (int i = 0; i < 10; ++i) {
+                queue.push(i);
+            }
+
+            int expected = 0;
+            auto check = [this, &expected](const int& value) { expectEquals(value, expected++); };
+            expectEquals(queue.drain(check, 4), 4);
+            expectEquals(queue.drain(check), 6);
+            expectEquals(queue.drain(check), 0);
+        }
+
+        beginTest("多个生产者并发写入，每个生产者的顺序保持不变");
+        {
+            constexpr int numProducers = 4;
+            constexpr int itemsPerProducer = 50000;
+
+            AudioGraph::LockFreeMpscQueue<uint32_t, 256> queue;
+            std::vector<std::thread> producers;
+
+            for (int producer = 0; producer < numProducers; ++producer) {
+                producers.emplace_back([&queue, producer] {
+                    for (uint32_t i = 0; i < static_cast<uint32_t>(itemsPerProducer); ++i) {
+                        const uint32_t item = (static_cast<uint32_t>(producer) << 24) | i;
+                        while (!queue.push(item)) {
+                            std::this_thread::yield();
+                        }
+                    }
+                });
+            }
+
+            std::vector<uint32_t> nextExpected(numProducers, 0);
+            int numReceived = 0;
+            bool inOrder = true;
+            uint32_t item = 0;
+
+            while (numReceived < numProducers * itemsPerProducer) {
+                if (!queue.pop(item)) {
+                    std::this_thread::yield();
+                    continue;
+                }
+
+                const auto producer = static_cast<size_t>(item >> 24);
+                const uint32_t sequence = item & 0xffffffu;
+                if (producer >= nextExpected.size() || sequence != nextExpected[producer]) {
+                    inOrder = false;
+                } else {
+                    ++nextExpected[producer];
+                }
+                ++numReceived;
+            }
+
+            for (auto& thread : producers) {
+                thread.join();
+            }
+
+            expect(inOrder, "生产者内的顺序被打乱或收到无效元素");
+            expect(!queue.pop(item), "全部取出后队列应为空");
+            for (const auto count : nextExpected) {
+                expectEquals(static_cast<int>(count), itemsPerProducer);
+            }
+        }
+    }
+};
+
+static LockFreeMpscQueueTests lockFreeMpscQueueTests;
+
+} // namespace WindsynthVST::Tests
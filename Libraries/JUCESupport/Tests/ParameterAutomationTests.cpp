@@ -0,0 +1,203 @@
+//
+//  ParameterAutomationTests.cpp
+//  WindsynthRecorder
+//
+//  Created by AI Assistant
+//  参数自动化队列测试
+//
+
+#include "AudioGraph/Core/ParameterAutomation.hpp"
+
+namespace WindsynthVST::Tests {
+
+namespace {
+
+/**
+ * 只有两个归一化参数的处理器
+ */
+class ParameterProcessor : public juce::AudioProcessor {
+public:
+    ParameterProcessor() {
+        addParameter(new juce::AudioParameterFloat(juce::ParameterID { "first", 1 }, "First", 0.0f, 1.0f, 0.0f));
+        addParameter(new juce::AudioParameterFloat(juce::ParameterID { "second", 1 }, "Second", 0.0f, 1.0f, 0.0f));
+    }
+
+    float getValue(int index) const { return getParameters()[index]->getValue(); }
+
+    const juce::String getName() const override { return "Parameters"; }
+    void prepareToPlay(double, int) override {}
+    void releaseResources() override {}
+    void processBlock(juce::AudioBuffer<float>&, juce::MidiBuffer&) override {}
+    double getTailLengthSeconds() const override { return 0.0; }
+    bool acceptsMidi() const override { return false; }
+    bool producesMidi() const override { return false; }
+    bool hasEditor() const override { return false; }
+    juce::AudioProcessorEditor* createEditor() override { return nullptr; }
+    int getNumPrograms() override { return 1; }
+    int getCurrentProgram() override { return 0; }
+    void setCurrentProgram(int) override {}
+    const juce::String getProgramName(int) override { return {}; }
+    void changeProgramName(int, const juce::String&) override {}
+    void getStateInformation(juce::MemoryBlock&) override {}
+    void setStateInformation(const void*, int) override {}
+};
+
+AudioGraph::ParameterEvent makeEvent(int parameterIndex, float value, int sampleOffset, int rampSamples = 0) {
+    AudioGraph::ParameterEvent event;
+    event.parameterIndex = parameterIndex;
+    event.value = value;
+    event.sampleOffset = sampleOffset;
+    event.rampSamples = rampSamples;
+    return event;
+}
+
+} // namespace
+
+class ParameterAutomationTests : public juce::UnitTest {
+public:
+    ParameterAutomationTests() : juce::UnitTest("ParameterAutomation", "AudioGraph") {}
+
+    void runTest() override {
+        constexpr float tolerance = 1.0e-6f;
+
+        beginTest("事件偏移处切分子块");
+        {
+            ParameterProcessor processor;
+            AudioGraph::ParameterAutomation automation;
+            expectEquals(automation.push({ makeEvent(0, 0.25f, 100) }), 1);
+
+            expect(automation.beginBlock(512));
+            expectEquals(automation.applyEvents(processor, 0), 100);
+            expectWithinAbsoluteError(processor.getValue(0), 0.0f, tolerance);
+            expectEquals(automation.applyEvents(processor, 100), 512);
+            expectWithinAbsoluteError(processor.getValue(0), 0.25f, tolerance);
+            automation.endBlock(512);
+
+            const auto stats = automation.getStatistics();
+            expectEquals(static_cast<int>(stats.appliedEvents), 1);
+            expectEquals(static_cast<int>(stats.subBlocks), 2);
+
+            expect(!automation.beginBlock(512), "没有事件和过渡时不需要切分");
+        }
+
+        beginTest("子块不短于最小长度，更近的事件推迟");
+        {
+            ParameterProcessor processor;
+            AudioGraph::ParameterAutomation automation;
+            automation.push({ makeEvent(0, 0.5f, 0), makeEvent(1, 0.5f, 5) });
+
+            expect(automation.beginBlock(512));
+            expectEquals(automation.applyEvents(processor, 0), AudioGraph::Constants::PARAMETER_MIN_SUBBLOCK_SAMPLES);
+            expectWithinAbsoluteError(processor.getValue(0), 0.5f, tolerance);
+            expectWithinAbsoluteError(processor.getValue(1), 0.0f, tolerance);
+
+            expectEquals(automation.applyEvents(processor, AudioGraph::Constants::PARAMETER_MIN_SUBBLOCK_SAMPLES), 512);
+            expectWithinAbsoluteError(processor.getValue(1), 0.5f, tolerance);
+            automation.endBlock(512);
+        }
+
+        beginTest("超出当前块的事件保留到后续块");
+        {
+            ParameterProcessor processor;
+            AudioGraph::ParameterAutomation automation;
+            automation.push({ makeEvent(0, 0.75f, 700) });
+
+            expect(!automation.beginBlock(512));
+            expectWithinAbsoluteError(processor.getValue(0), 0.0f, tolerance);
+
+            expect(automation.beginBlock(512));
+            expectEquals(automation.applyEvents(processor, 0), 188);
+            expectEquals(automation.applyEvents(processor, 188), 512);
+            expectWithinAbsoluteError(processor.getValue(0), 0.75f, tolerance);
+            automation.endBlock(512);
+        }
+
+        beginTest("过渡按固定步长线性更新并到达目标值");
+        {
+            ParameterProcessor processor;
+            AudioGraph::ParameterAutomation automation;
+            automation.push({ makeEvent(0, 1.0f, 0, 64) });
+
+            expect(automation.beginBlock(512));
+            expectEquals(automation.applyEvents(processor, 0), AudioGraph::Constants::PARAMETER_RAMP_STEP_SAMPLES);
+            expectWithinAbsoluteError(processor.getValue(0), 0.0f, tolerance);
+            expectEquals(automation.applyEvents(processor, 32), 64);
+            expectWithinAbsoluteError(processor.getValue(0), 0.5f, tolerance);
+            expectEquals(automation.applyEvents(processor, 64), 512);
+            expectWithinAbsoluteError(processor.getValue(0), 1.0f, tolerance);
+            automation.endBlock(512);
+
+            expect(!automation.beginBlock(512), "过渡完成后不再切分");
+        }
+
+        beginTest("过渡跨越多个块");
+        {
+            ParameterProcessor processor;
+            AudioGraph::ParameterAutomation automation;
+            automation.push({ makeEvent(0, 1.0f, 0, 64) });
+
+            expect(automation.beginBlock(48));
+            expectEquals(automation.applyEvents(processor, 0), 32);
+            expectEquals(automation.applyEvents(processor, 32), 48);
+            expectWithinAbsoluteError(processor.getValue(0), 0.5f, tolerance);
+            automation.endBlock(48);
+
+            expect(automation.beginBlock(48), "进行中的过渡需要继续切分");
+            expectEquals(automation.applyEvents(processor, 0), 32);
+            expectWithinAbsoluteError(processor.getValue(0), 0.75f, tolerance);
+            expectEquals(automation.applyEvents(processor, 32), 48);
+            expectWithinAbsoluteError(processor.getValue(0), 1.0f, tolerance);
+            automation.endBlock(48);
+
+            expect(!automation.beginBlock(48));
+        }
+
+        beginTest("flush 立即应用事件并完成过渡");
+        {
+            ParameterProcessor processor;
+            AudioGraph::ParameterAutomation automation;
+            automation.push({ makeEvent(1, 0.6f, 0, 1000) });
+
+            expect(automation.beginBlock(512));
+            automation.applyEvents(processor, 0);
+            automation.endBlock(512);
+
+            automation.push({ makeEvent(0, 0.3f, 5000) });
+            automation.flush(processor);
+            expectWithinAbsoluteError(processor.getValue(0), 0.3f, tolerance);
+            expectWithinAbsoluteError(processor.getValue(1), 0.6f, tolerance);
+            expect(!automation.beginBlock(512));
+        }
+
+        beginTest("参数值限制在 0-1，无效参数索引被忽略");
+        {
+            ParameterProcessor processor;
+            AudioGraph::ParameterAutomation automation;
+            automation.push({ makeEvent(0, 1.5f, 0), makeEvent(7, 0.5f, 0), makeEvent(-1, 0.5f, 0) });
+
+            expect(automation.beginBlock(512));
+            automation.applyEvents(processor, 0);
+            automation.endBlock(512);
+            expectWithinAbsoluteError(processor.getValue(0), 1.0f, tolerance);
+            expectWithinAbsoluteError(processor.getValue(1), 0.0f, tolerance);
+        }
+
+        beginTest("队列满时丢弃事件并计数");
+        {
+            AudioGraph::ParameterAutomation automation(4);
+            std::vector<AudioGraph::ParameterEvent> events;
+            for (int i = 0; i < 6; ++i) {
+                events.push_back(makeEvent(0, 0.1f * static_cast<float>(i), i * 32));
+            }
+
+            expectEquals(automation.push(events), 4);
+            const auto stats = automation.getStatistics();
+            expectEquals(static_cast<int>(stats.queuedEvents), 4);
+            expectEquals(static_cast<int>(stats.droppedEvents), 2);
+        }
+    }
+};
+
+static ParameterAutomationTests parameterAutomationTests;
+
+} // namespace WindsynthVST::Tests
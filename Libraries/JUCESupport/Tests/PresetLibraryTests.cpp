@@ -0,0 +1,165 @@
+//
+//  PresetLibraryTests.cpp
+//  WindsynthRecorder
+//
+//  Created by AI Assistant
+//  预设库容器格式测试
+//
+
+#include "AudioGraph/Management/PresetLibrary.hpp"
+#include <cstring>
+
+namespace WindsynthVST::Tests {
+
+class PresetLibraryTests : public juce::UnitTest {
+public:
+    PresetLibraryTests() : juce::UnitTest("PresetLibrary", "AudioGraph") {}
+
+    void runTest() override {
+        const auto directory = juce::File::getSpecialLocation(juce::File::tempDirectory)
+                                   .getNonexistentChildFile("WindsynthPresetLibraryTests", "", false);
+
+        AudioGraph::PresetMetadata info("Warm Lead", "Breath controlled lead", "Lead");
+        info.author = "Tests";
+        info.version = "1.0";
+        info.tags = { "lead", "warm" };
+
+        const auto state = makeState();
+
+        beginTest("写入后重新打开，元数据和状态数据保持一致");
+        {
+            AudioGraph::PresetLibrary library;
+            expectEquals(library.open(directory), 0);
+            expect(library.store(info, state));
+        }
+        {
+            AudioGraph::PresetLibrary library;
+            expectEquals(library.open(directory), 1);
+
+            const auto* metadata = library.getMetadata(info.name);
+            expect(metadata != nullptr);
+            if (metadata != nullptr) {
+                expect(metadata->description == info.description);
+                expect(metadata->category == info.category);
+                expect(metadata->author == info.author);
+                expectEquals(metadata->version, info.version);
+                expect(metadata->tags == info.tags);
+                expectEquals(metadata->createdTime.toMilliseconds(), info.createdTime.toMilliseconds());
+            }
+
+            AudioGraph::PresetGraphState loaded;
+            expect(library.loadState(info.name, loaded));
+            expect(loaded.graphData == state.graphData);
+            expect(loaded.pluginStates == state.pluginStates);
+            expect(loaded.connections == state.connections);
+            expect(loaded.ioConfig == state.ioConfig);
+            expect(loaded.config == state.config);
+        }
+
+        const auto file = findPresetFile(directory);
+
+        beginTest("可压缩的数据块以压缩形式保存");
+        {
+            expect(file.existsAsFile());
+            expect(file.getSize() < static_cast<juce::int64>(state.graphData.getSize()));
+        }
+
+        juce::MemoryBlock original;
+        expect(file.loadFileAsData(original));
+
+        beginTest("数据块解压长度不符时拒绝读取状态");
+        {
+            juce::MemoryBlock corrupted(original);
+            const auto offset = findChunk(corrupted, "GRPH");
+            expect(offset >= 0);
+
+            // 原始长度字段位于 ID、标志和存储长度之后
+            if (offset >= 0) {
+                auto* rawSize = static_cast<char*>(corrupted.getData()) + offset + 16;
+                const auto size = juce::ByteOrder::swapIfBigEndian(juce::ByteOrder::littleEndianInt64(rawSize) + 1);
+                std::memcpy(rawSize, &size, sizeof(size));
+            }
+            expect(file.replaceWithData(corrupted.getData(), corrupted.getSize()));
+
+            AudioGraph::PresetLibrary library;
+            expectEquals(library.open(directory), 1, "元数据块完好时仍然列出预设");
+
+            AudioGraph::PresetGraphState loaded;
+            expect(!library.loadState(info.name, loaded));
+
+            AudioGraph::PresetMetadata fileInfo;
+            expect(!AudioGraph::PresetLibrary::readPresetFile(file, fileInfo, loaded));
+        }
+
+        beginTest("截断的文件拒绝读取状态");
+        {
+            expect(file.replaceWithData(original.getData(), original.getSize() - 4));
+
+            AudioGraph::PresetMetadata fileInfo;
+            AudioGraph::PresetGraphState loaded;
+            expect(!AudioGraph::PresetLibrary::readPresetFile(file, fileInfo, loaded));
+        }
+
+        beginTest("魔数错误的文件被跳过");
+        {
+            juce::MemoryBlock corrupted(original);
+            static_cast<char*>(corrupted.getData())[0] = 'X';
+            expect(file.replaceWithData(corrupted.getData(), corrupted.getSize()));
+
+            AudioGraph::PresetMetadata fileInfo;
+            expect(!AudioGraph::PresetLibrary::readPresetMetadata(file, fileInfo));
+
+            AudioGraph::PresetLibrary library;
+            expectEquals(library.open(directory), 0);
+        }
+
+        directory.deleteRecursively();
+    }
+
+private:
+    static AudioGraph::PresetGraphState makeState() {
+        AudioGraph::PresetGraphState state;
+
+        // 重复的图数据可以压缩，插件状态是伪随机数据
+        juce::MemoryOutputStream graphData(state.graphData, false);
+        for (int i = 0; i < 2048; ++i) {
+            graphData.writeInt(i % 16);
+        }
+        graphData.flush();
+
+        state.pluginStates.setSize(1000);
+        juce::Random random(42);
+        for (size_t i = 0; i < state.pluginStates.getSize(); ++i) {
+            state.pluginStates[i] = static_cast<char>(random.nextInt(256));
+        }
+
+        state.connections.append("connections", 11);
+        state.ioConfig.append("io", 2);
+
+        state.config.sampleRate = 48000.0;
+        state.config.samplesPerBlock = 256;
+        state.config.numInputChannels = 2;
+        state.config.enableMidi = false;
+        return state;
+    }
+
+    static juce::File findPresetFile(const juce::File& directory) {
+        const auto files = directory.findChildFiles(juce::File::findFiles, false,
+                                                    juce::String("*") + AudioGraph::PresetLibrary::fileExtension);
+        return files.isEmpty() ? juce::File() : files.getFirst();
+    }
+
+    static int findChunk(const juce::MemoryBlock& data, const char* chunkID) {
+        const auto* bytes = static_cast<const char*>(data.getData());
+        for (size_t i = 0; i + 4 <= data.getSize(); ++i) {
+            if (std::memcmp(bytes + i, chunkID, 4) == 0) {
+                return static_cast<int>(i);
+            }
+        }
+        return -1;
+    }
+};
+
+static PresetLibraryTests presetLibraryTests;
+
+} // namespace WindsynthVST::Tests
@@ -0,0 +1,145 @@
+//
+//  SnapshotStoreTests.cpp
+//  WindsynthRecorder
+//
+//  Created by AI Assistant
+//  快照存储去重和引用计数测试
+//
+
+#include "AudioGraph/Management/SnapshotStore.hpp"
+
+namespace WindsynthVST::Tests {
+
+class SnapshotStoreTests : public juce::UnitTest {
+public:
+    SnapshotStoreTests() : juce::UnitTest("SnapshotStore", "AudioGraph") {}
+
+    void runTest() override {
+        using Streams = AudioGraph::SnapshotStore::Streams;
+
+        // 1MB 伪随机数据按内容切分成 9 个数据块，小数据流是 1 个数据块
+        const auto state = makeData(1, 1 << 20);
+        const auto connections = makeData(2, 1000);
+        const juce::int64 snapshotSize = static_cast<juce::int64>(state.getSize() + connections.getSize());
+
+        // 前面插入 100 字节后只有第一个数据块变化
+        juce::MemoryBlock shifted;
+        for (int i = 0; i < 100; ++i) {
+            const auto byte = static_cast<juce::uint8>(i);
+            shifted.append(&byte, 1);
+        }
+        shifted.append(state.getData(), state.getSize());
+
+        beginTest("相同的数据流只保存一次");
+        {
+            AudioGraph::SnapshotStore store;
+            store.add("a", "undo", "A", { state, connections });
+            expect(store.waitUntilIdle(10000));
+
+            auto stats = store.getStatistics();
+            expectEquals(stats.numSnapshots, 1);
+            expectEquals(stats.numChunks, 10);
+            expectEquals(stats.uniqueBytes, snapshotSize);
+
+            store.add("b", "undo", "B", { state, connections });
+            expect(store.waitUntilIdle(10000));
+
+            stats = store.getStatistics();
+            expectEquals(stats.numSnapshots, 2);
+            expectEquals(stats.numChunks, 10);
+            expectEquals(stats.logicalBytes, snapshotSize * 2);
+            expectEquals(stats.uniqueBytes, snapshotSize);
+
+            beginTest("插入数据后块边界重新对齐，只增加变化的数据块");
+            store.add("c", "backup", "C", { shifted, connections });
+            expect(store.waitUntilIdle(10000));
+            expectEquals(store.getStatistics().numChunks, 11);
+
+            Streams streams;
+            expect(store.get("c", streams));
+            expectEquals(static_cast<int>(streams.size()), 2);
+            if (streams.size() == 2) {
+                expect(streams[0] == shifted);
+                expect(streams[1] == connections);
+            }
+            expectEquals(static_cast<int>(store.getSnapshots("backup").size()), 1);
+
+            beginTest("删除快照只释放不再被引用的数据块");
+            expect(store.remove("a"));
+            expectEquals(store.getStatistics().numChunks, 11);
+            expect(store.get("b", streams));
+            expect(streams.size() == 2 && streams[0] == state);
+
+            expect(store.remove("b"));
+            expectEquals(store.getStatistics().numChunks, 10);
+            expect(!store.remove("b"));
+            expect(!store.contains("b"));
+
+            // 替换快照时释放旧数据块
+            store.add("c", "backup", "C", { connections });
+            expect(store.waitUntilIdle(10000));
+            stats = store.getStatistics();
+            expectEquals(stats.numChunks, 1);
+            expectEquals(stats.uniqueBytes, static_cast<juce::int64>(connections.getSize()));
+
+            expect(store.remove("c"));
+            stats = store.getStatistics();
+            expectEquals(stats.numSnapshots, 0);
+            expectEquals(stats.numChunks, 0);
+            expectEquals(stats.uniqueBytes, static_cast<juce::int64>(0));
+        }
+
+        beginTest("保存到目录后重新加载，引用计数和数据块文件保持一致");
+        {
+            const auto directory = juce::File::getSpecialLocation(juce::File::tempDirectory)
+                                       .getNonexistentChildFile("WindsynthSnapshotStoreTests", "", false);
+            const auto chunkDirectory = directory.getChildFile("chunks");
+
+            {
+                AudioGraph::SnapshotStore store(directory);
+                store.add("a", "undo", "A", { state, connections });
+                store.add("b", "undo", "B", { state, connections });
+                expect(store.waitUntilIdle(10000));
+                expectEquals(chunkDirectory.getNumberOfChildFiles(juce::File::findFiles), 10);
+            }
+
+            {
+                AudioGraph::SnapshotStore store(directory);
+                expect(store.contains("a") && store.contains("b"));
+                expectEquals(store.getStatistics().numChunks, 10);
+
+                Streams streams;
+                expect(store.get("a", streams));
+                expect(streams.size() == 2 && streams[0] == state && streams[1] == connections);
+
+                expect(store.remove("a"));
+                expectEquals(chunkDirectory.getNumberOfChildFiles(juce::File::findFiles), 10);
+                expect(store.remove("b"));
+                expectEquals(chunkDirectory.getNumberOfChildFiles(juce::File::findFiles), 0);
+            }
+
+            directory.deleteRecursively();
+        }
+    }
+
+private:
+    /**
+     * 确定性的伪随机数据（xorshift64）
+     */
+    static juce::MemoryBlock makeData(uint64_t seed, size_t size) {
+        juce::MemoryBlock data(size);
+        auto* bytes = static_cast<juce::uint8*>(data.getData());
+        uint64_t x = seed;
+        for (size_t i = 0; i < size; ++i) {
+            x ^= x << 13;
+            x ^= x >> 7;
+            x ^= x << 17;
+            bytes[i] = static_cast<juce::uint8>(x);
+        }
+        return data;
+    }
+};
+
+static SnapshotStoreTests snapshotStoreTests;
+
+} // namespace WindsynthVST::Tests
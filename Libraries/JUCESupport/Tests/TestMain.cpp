@@ -0,0 +1,51 @@
+//
+//  TestMain.cpp
+//  WindsynthRecorder
+//
+//  Created by AI Assistant
+//  单元测试入口
+//
+//  用法: WindsynthVSTCore_Tests [--category <分类>]
+//
+
+#include <JuceHeader.h>
+#include "AudioGraph/Core/Logger.hpp"
+#include <iostream>
+
+int main(int argc, char* argv[]) {
+    juce::ScopedJuceInitialiser_GUI juceInitialiser;
+
+    juce::StringArray arguments;
+    for (int i = 1; i < argc; ++i) {
+        arguments.add(juce::String::fromUTF8(argv[i]));
+    }
+
+    juce::String category;
+    for (int i = 0; i < arguments.size(); ++i) {
+        if (arguments[i] == "--category" && i + 1 < arguments.size()) {
+            category = arguments[++i];
+        } else {
+            std::cerr << "未知参数: " << arguments[i] << "\n"
+                      << "用法: WindsynthVSTCore_Tests [--category <分类>]\n";
+            return 2;
+        }
+    }
+
+    WindsynthVST::AudioGraph::Logger::getInstance().setMinimumLevel(WindsynthVST::AudioGraph::LogLevel::Warning);
+
+    juce::UnitTestRunner runner;
+    runner.setAssertOnFailure(false);
+    if (category.isEmpty()) {
+        runner.runAllTests();
+    } else {
+        runner.runTestsInCategory(category);
+    }
+
+    int numFailures = 0;
+    for (int i = 0; i < runner.getNumResults(); ++i) {
+        numFailures += runner.getResult(i)->failures;
+    }
+
+    WindsynthVST::AudioGraph::Logger::getInstance().flush();
+    return numFailures > 0 ? 1 : 0;
+}
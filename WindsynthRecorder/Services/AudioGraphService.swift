@@ -565,6 +565,28 @@ class AudioGraphService: ObservableObject {
         return success
     }
 
+    /// 批量设置节点参数（一次桥接调用，在音频线程中应用）
+    /// - Parameter rampSamples: 大于0时每个参数线性过渡到目标值
+    /// - Returns: 成功排队的参数数量
+    func setNodeParameters(nodeID: UInt32, values: [(parameterIndex: Int, value: Float)], rampSamples: Int = 0) -> Int {
+        guard let handle = engineHandle else {
+            errorMessage = "Audio engine not initialized"
+            return 0
+        }
+
+        let changes = values.map {
+            ParameterChange_C(parameterIndex: Int32($0.parameterIndex), value: $0.value,
+                              sampleOffset: 0, rampSamples: Int32(rampSamples))
+        }
+        let queued = Int(Engine_SetNodeParameters(handle, nodeID, changes, Int32(changes.count)))
+
+        if queued < changes.count {
+            logger.error("部分节点参数设置失败", details: "节点ID: \(nodeID), 成功: \(queued)/\(changes.count)")
+        }
+
+        return queued
+    }
+
     /// 获取节点参数
     func getNodeParameter(nodeID: UInt32, parameterIndex: Int) -> Float? {
         guard let handle = engineHandle else {
@@ -584,6 +606,20 @@ class AudioGraphService: ObservableObject {
         return Int(Engine_GetNodeParameterCount(handle, nodeID))
     }
 
+    /// 读取节点的所有参数值（一次桥接调用，来自参数缓存）
+    func getNodeParameterValues(nodeID: UInt32) -> [Float] {
+        guard let handle = engineHandle else {
+            return []
+        }
+
+        let count = Int(Engine_GetNodeParameterCount(handle, nodeID))
+        guard count > 0 else { return [] }
+
+        var values = [Float](repeating: 0, count: count)
+        let copied = Int(Engine_GetNodeParameterValues(handle, nodeID, &values, Int32(count)))
+        return Array(values.prefix(copied))
+    }
+
     /// 获取节点参数信息
     func getNodeParameterInfo(nodeID: UInt32, parameterIndex: Int) -> ParameterInfo? {
         guard let handle = engineHandle else {
@@ -1033,6 +1069,16 @@ extension AudioGraphService {
         return Engine_GetInputLevel(handle)
     }
 
+    /// 便捷方法：一次获取全部电平和性能数据（无锁快照，适合高频UI刷新）
+    func getMeterSnapshot() -> EngineMeterSnapshot_C? {
+        guard let handle = engineHandle else {
+            return nil
+        }
+
+        var snapshot = EngineMeterSnapshot_C()
+        return Engine_GetMeterSnapshot(handle, &snapshot) ? snapshot : nil
+    }
+
     //==============================================================================
     // MARK: - 离线音频渲染
     //==============================================================================
@@ -1045,6 +1091,38 @@ extension AudioGraphService {
         var normalizeOutput: Bool = false
         var includePluginTails: Bool = false
         var format: AudioFormat = .wav
+        var normalizationMode: NormalizationMode = .peak
+        var targetPeakDb: Float = -0.45
+        var targetLoudnessLUFS: Float = -23.0
+        var peakCeilingDb: Float = -1.0
+        var tailMode: TailMode = .silenceDetection
+        var maxTailSeconds: Float = 30.0
+        var tailSilenceThresholdDb: Float = -90.0
+        var tailSilenceHoldMs: Float = 500.0
+
+        enum TailMode: Int, CaseIterable {
+            case reportedLength = 0
+            case silenceDetection = 1
+
+            var displayName: String {
+                switch self {
+                case .reportedLength: return "插件报告长度"
+                case .silenceDetection: return "静音检测"
+                }
+            }
+        }
+
+        enum NormalizationMode: Int, CaseIterable {
+            case peak = 0
+            case loudness = 1
+
+            var displayName: String {
+                switch self {
+                case .peak: return "峰值"
+                case .loudness: return "响度 (LUFS)"
+                }
+            }
+        }
 
         enum AudioFormat: Int, CaseIterable {
             case wav = 0
@@ -1073,7 +1151,15 @@ extension AudioGraphService {
                 numChannels: Int32(numChannels),
                 normalizeOutput: normalizeOutput,
                 includePluginTails: includePluginTails,
-                format: Int32(format.rawValue)
+                format: Int32(format.rawValue),
+                normalizationMode: Int32(normalizationMode.rawValue),
+                targetPeakDb: targetPeakDb,
+                targetLoudnessLUFS: targetLoudnessLUFS,
+                peakCeilingDb: peakCeilingDb,
+                tailMode: Int32(tailMode.rawValue),
+                maxTailSeconds: maxTailSeconds,
+                tailSilenceThresholdDb: tailSilenceThresholdDb,
+                tailSilenceHoldMs: tailSilenceHoldMs
             )
         }
     }